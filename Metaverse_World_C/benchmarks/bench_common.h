@@ -0,0 +1,36 @@
+/*
+ * Metaverse World System - Benchmark Helpers
+ * Shared timing and scene utilities for the benchmark programs
+ */
+
+#ifndef METAVERSE_BENCH_COMMON_H
+#define METAVERSE_BENCH_COMMON_H
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Monotonic wall-clock time in seconds
+ */
+static inline double bench_now(void) {
+#ifdef _WIN32
+    return (double)clock() / CLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * @brief Uniform random value in [low, high) from a caller-owned seed
+ *
+ * Scenes built from the same seed are identical, so runs of different
+ * configurations simulate the same bodies.
+ */
+static inline float bench_random(uint32_t* state, float low, float high) {
+    *state = *state * 1664525u + 1013904223u;
+    return low + (high - low) * (float)(*state >> 8) / 16777216.0f;
+}
+
+#endif // METAVERSE_BENCH_COMMON_H
@@ -0,0 +1,218 @@
+/*
+ * Metaverse World System - Broad Phase Benchmark
+ * Checks that brute force, sweep-and-prune and the AABB tree report the
+ * same pairs (including after bodies leave the world), then compares
+ * physics_world_update step time and collision_checks at 1k, 10k and 50k
+ * bodies with the all-pairs loop the world used before
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_broad_phase.c src/physics.c src/broad_phase.c \
+ *        src/constraint_solver.c src/thread_pool.c src/world.c -o benchmark_broad_phase -lm -pthread
+ * Usage: ./benchmark_broad_phase [largest body count, default 50000]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/physics.h"
+#include "bench_common.h"
+
+#define BP_BENCH_RADIUS 0.5f
+#define BP_BENCH_VOLUME_PER_BODY 4.0f   // Cube volume per body (m³): a few contacts per body
+#define BP_BENCH_SPEED 2.0f             // Maximum initial speed per axis (m/s)
+#define BP_BENCH_SEED 12345u
+
+// Every algorithm times the same steps so the last step simulates the same state
+static const int body_counts[] = { 1000, 10000, 50000 };
+static const int timed_steps[] = { 100, 10, 3 };
+#define BP_BENCH_SIZES (int)(sizeof(body_counts) / sizeof(body_counts[0]))
+
+static const BroadPhaseType types[] = {
+    BROAD_PHASE_BRUTE_FORCE, BROAD_PHASE_SWEEP_AND_PRUNE, BROAD_PHASE_AABB_TREE
+};
+#define BP_BENCH_TYPES (int)(sizeof(types) / sizeof(types[0]))
+
+// Narrow phase hits of the current step, counted through on_collision
+static int collisions = 0;
+
+static void count_collision(CollisionManifold* manifold) {
+    (void)manifold;
+    collisions++;
+}
+
+// ============================================================================
+// Scene
+// ============================================================================
+
+/**
+ * Spheres scattered through a cube sized for constant density, drifting
+ * without gravity so the distribution (and the pair count) stays steady
+ */
+static PhysicsWorld* create_scene(int count, BroadPhaseType type) {
+    PhysicsWorld* world = physics_world_create(vector3_create(0, 0, 0), count, count);
+    if (!world) return NULL;
+    if (!physics_world_set_broad_phase(world, type)) {
+        physics_world_destroy(world);
+        return NULL;
+    }
+    world->on_collision = count_collision;
+
+    float side = cbrtf(count * BP_BENCH_VOLUME_PER_BODY);
+    uint32_t seed = BP_BENCH_SEED;
+
+    for (int i = 0; i < count; i++) {
+        Vector3 position = vector3_create(bench_random(&seed, 0, side), bench_random(&seed, 0, side),
+                                          bench_random(&seed, 0, side));
+        RigidBody* body = rigid_body_create(1.0f, position, quaternion_identity());
+        Collider* collider = collider_create_sphere(BP_BENCH_RADIUS);
+        if (!body || !collider) {
+            rigid_body_destroy(body);
+            collider_destroy(collider);
+            physics_world_destroy(world);
+            return NULL;
+        }
+
+        body->collider = collider;
+        collider->body = body;
+        body->linear_damping = 0.0f;
+        body->linear_velocity = vector3_create(bench_random(&seed, -BP_BENCH_SPEED, BP_BENCH_SPEED),
+                                               bench_random(&seed, -BP_BENCH_SPEED, BP_BENCH_SPEED),
+                                               bench_random(&seed, -BP_BENCH_SPEED, BP_BENCH_SPEED));
+        physics_world_add_body(world, body);
+    }
+
+    return world;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+/**
+ * Every algorithm must report exactly the pairs brute force reports: same
+ * collision_checks and the same narrow phase hits, step after step. The
+ * solver is switched off (no iterations, no warm start): sequential
+ * impulses depend on contact order, which differs between algorithms,
+ * and the next step's pairs would depend on it.
+ */
+static bool check_pairs(int count, int steps, int removed_stride) {
+    int checks[BP_BENCH_TYPES][8];
+    int hits[BP_BENCH_TYPES][8];
+
+    for (int t = 0; t < BP_BENCH_TYPES; t++) {
+        PhysicsWorld* world = create_scene(count, types[t]);
+        if (!world) return false;
+        world->max_iterations = 0;
+        world->warm_starting = false;
+
+        for (int step = 0; step < steps; step++) {
+            // Bodies leaving the world halfway through exercise proxy removal and reuse
+            if (removed_stride > 0 && step == steps / 2) {
+                for (int i = world->body_count - 1; i >= 0; i -= removed_stride) {
+                    RigidBody* body = world->bodies[i];
+                    physics_world_remove_body(world, body);
+                    rigid_body_destroy(body);
+                }
+            }
+
+            collisions = 0;
+            physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+            checks[t][step] = world->collision_checks;
+            hits[t][step] = collisions;
+        }
+        physics_world_destroy(world);
+    }
+
+    bool ok = true;
+    for (int t = 1; t < BP_BENCH_TYPES; t++) {
+        for (int step = 0; step < steps; step++) {
+            if (checks[t][step] != checks[0][step] || hits[t][step] != hits[0][step]) {
+                printf("  %-16s step %d: %d checks / %d hits, brute force %d / %d\n",
+                       broad_phase_type_name(types[t]), step, checks[t][step], hits[t][step],
+                       checks[0][step], hits[0][step]);
+                ok = false;
+            }
+        }
+    }
+
+    printf("%-46s %s\n", removed_stride > 0 ? "pairs match brute force after removals" : "pairs match brute force",
+           ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+typedef struct {
+    double step_ms;                 // Mean physics_world_update time
+    int collision_checks;           // Narrow phase tests of the last step
+    uint64_t bounds_tests;          // Broad phase AABB tests of the last step
+    double reinserts;               // Tree leaves reinserted per step
+} StepResult;
+
+static bool time_steps(int count, BroadPhaseType type, int steps, StepResult* result) {
+    PhysicsWorld* world = create_scene(count, type);
+    if (!world) return false;
+
+    // First step registers every body with the broad phase
+    physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+    uint64_t reinserts_start = world->broad_phase->reinserts;
+
+    double start = bench_now();
+    for (int step = 0; step < steps; step++) {
+        physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+    }
+    double elapsed = bench_now() - start;
+
+    result->step_ms = elapsed * 1e3 / steps;
+    result->collision_checks = world->collision_checks;
+    result->bounds_tests = world->broad_phase->bounds_tests;
+    result->reinserts = (double)(world->broad_phase->reinserts - reinserts_start) / steps;
+
+    physics_world_destroy(world);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int largest = argc > 1 ? atoi(argv[1]) : body_counts[BP_BENCH_SIZES - 1];
+
+    printf("Broad phase benchmark (spheres r=%.1f, %.0f m³ per body, no gravity)\n\n",
+           BP_BENCH_RADIUS, BP_BENCH_VOLUME_PER_BODY);
+
+    bool ok = true;
+    ok &= check_pairs(500, 8, 0);
+    ok &= check_pairs(500, 8, 3);
+    printf("\n");
+
+    for (int s = 0; s < BP_BENCH_SIZES; s++) {
+        int count = body_counts[s];
+        if (count > largest) break;
+
+        // Before the broad phase every pair went to physics_check_collision
+        long long all_pairs = (long long)count * (count - 1) / 2;
+        printf("%d bodies (all-pairs loop: collision_checks = %lld)\n", count, all_pairs);
+        printf("  %-16s %10s %9s %16s %14s %12s\n",
+               "broad phase", "step ms", "speedup", "collision_checks", "bounds tests", "reinserts");
+
+        double brute_ms = 0.0;
+        for (int t = 0; t < BP_BENCH_TYPES; t++) {
+            StepResult result;
+            if (!time_steps(count, types[t], timed_steps[s], &result)) {
+                printf("  %-16s failed to build the scene\n", broad_phase_type_name(types[t]));
+                ok = false;
+                continue;
+            }
+            if (types[t] == BROAD_PHASE_BRUTE_FORCE) brute_ms = result.step_ms;
+
+            printf("  %-16s %10.3f %8.1fx %16d %14llu %12.1f\n", broad_phase_type_name(types[t]),
+                   result.step_ms, brute_ms > 0 ? brute_ms / result.step_ms : 0.0, result.collision_checks,
+                   (unsigned long long)result.bounds_tests, result.reinserts);
+        }
+        printf("\n");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,288 @@
+/*
+ * Metaverse World System - Body Integration Benchmark
+ * Checks every integrator kernel against the per-body pointer loops the
+ * world used before the structure-of-arrays body store, checks that
+ * RigidBody handles survive swap-removal and that their fields follow the
+ * store after a step, then compares integration throughput at 100k bodies
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_integration.c src/physics.c src/broad_phase.c \
+ *        src/constraint_solver.c src/thread_pool.c src/world.c -o benchmark_integration -lm -pthread
+ * Usage: ./benchmark_integration [bodies, default 100000] [steps, default 200]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/physics.h"
+#include "bench_common.h"
+
+#define INT_BENCH_SEED 2024u
+#define INT_BENCH_KINEMATIC_EVERY 10    // Every n-th body is kinematic
+#define INT_BENCH_TOLERANCE 1e-4f       // FMA and separate multiply-add round differently
+
+// ============================================================================
+// Reference
+// ============================================================================
+
+/**
+ * The gravity, velocity and position loops of physics_world_update before
+ * the body store: three passes over RigidBody pointers, by-value vector
+ * math and a time(NULL) call per body
+ */
+static void integrate_pointer_loops(RigidBody** bodies, int count, Vector3 gravity, float delta_time) {
+    for (int i = 0; i < count; i++) {
+        RigidBody* body = bodies[i];
+        if (body && !body->kinematic) {
+            body->force_accumulator = vector3_add(body->force_accumulator,
+                vector3_multiply(gravity, body->mass));
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        RigidBody* body = bodies[i];
+        if (body && !body->kinematic) {
+            Vector3 acceleration = vector3_multiply(body->force_accumulator, 1.0f / body->mass);
+            body->linear_velocity = vector3_add(body->linear_velocity,
+                vector3_multiply(acceleration, delta_time));
+            body->linear_velocity = vector3_multiply(body->linear_velocity,
+                1.0f - body->linear_damping * delta_time);
+            body->force_accumulator = vector3_create(0, 0, 0);
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        RigidBody* body = bodies[i];
+        if (body && !body->kinematic) {
+            body->position = vector3_add(body->position,
+                vector3_multiply(body->linear_velocity, delta_time));
+            body->last_updated = (uint64_t)time(NULL);
+        }
+    }
+}
+
+// ============================================================================
+// Scene
+// ============================================================================
+
+static RigidBody* create_body(uint32_t* seed, int index) {
+    Vector3 position = vector3_create(bench_random(seed, -100, 100), bench_random(seed, 0, 100),
+                                      bench_random(seed, -100, 100));
+    RigidBody* body = rigid_body_create(bench_random(seed, 0.5f, 5.0f), position, quaternion_identity());
+    if (!body) return NULL;
+
+    body->linear_velocity = vector3_create(bench_random(seed, -5, 5), bench_random(seed, -5, 5),
+                                           bench_random(seed, -5, 5));
+    body->linear_damping = bench_random(seed, 0.0f, 0.5f);
+    body->kinematic = index % INT_BENCH_KINEMATIC_EVERY == 0;
+    return body;
+}
+
+// Same bodies, loose (pointer loops) and in a world (body store)
+static bool create_scenes(int count, RigidBody*** loose, PhysicsWorld** world) {
+    *loose = (RigidBody**)malloc((size_t)count * sizeof(RigidBody*));
+    *world = physics_world_create(vector3_create(0, PHYSICS_GRAVITY_DEFAULT, 0), count, 1);
+    if (!*loose || !*world) return false;
+
+    uint32_t seed_loose = INT_BENCH_SEED;
+    uint32_t seed_world = INT_BENCH_SEED;
+    for (int i = 0; i < count; i++) {
+        (*loose)[i] = create_body(&seed_loose, i);
+        RigidBody* body = create_body(&seed_world, i);
+        if (!(*loose)[i] || !body || !physics_world_add_body(*world, body)) return false;
+    }
+    return true;
+}
+
+static void destroy_loose(RigidBody** loose, int count) {
+    if (!loose) return;
+    for (int i = 0; i < count; i++) rigid_body_destroy(loose[i]);
+    free(loose);
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+static bool check_kernels(void) {
+    // An odd count exercises every kernel's tail
+    const int count = 1003;
+    const int steps = 50;
+    bool ok = true;
+
+    for (int k = PHYSICS_KERNEL_SCALAR; k <= PHYSICS_KERNEL_AVX512; k++) {
+        if (!physics_set_kernel((PhysicsKernel)k)) {
+            printf("%-46s skipped (CPU)\n", physics_kernel_name((PhysicsKernel)k));
+            continue;
+        }
+
+        RigidBody** loose = NULL;
+        PhysicsWorld* world = NULL;
+        if (!create_scenes(count, &loose, &world)) {
+            printf("%-46s FAIL (allocation)\n", physics_kernel_name((PhysicsKernel)k));
+            ok = false;
+        } else {
+            for (int step = 0; step < steps; step++) {
+                integrate_pointer_loops(loose, count, world->gravity, PHYSICS_FIXED_TIMESTEP);
+                physics_world_integrate(world, PHYSICS_FIXED_TIMESTEP);
+            }
+
+            float max_error = 0.0f;
+            for (int i = 0; i < count; i++) {
+                Vector3 dp = vector3_subtract(rigid_body_get_position(world->bodies[i]), loose[i]->position);
+                Vector3 dv = vector3_subtract(rigid_body_get_velocity(world->bodies[i]), loose[i]->linear_velocity);
+                max_error = fmaxf(max_error, fmaxf(vector3_magnitude(dp), vector3_magnitude(dv)));
+            }
+
+            char label[64];
+            snprintf(label, sizeof(label), "%s matches pointer loops", physics_kernel_name((PhysicsKernel)k));
+            bool pass = max_error <= INT_BENCH_TOLERANCE;
+            printf("%-46s %s (max error %.2e)\n", label, pass ? "PASS" : "FAIL", max_error);
+            ok &= pass;
+        }
+
+        destroy_loose(loose, count);
+        physics_world_destroy(world);
+    }
+
+    physics_set_kernel(physics_get_kernel());
+    return ok;
+}
+
+static bool check_handles(void) {
+    const int count = 1000;
+    PhysicsWorld* world = physics_world_create(vector3_create(0, 0, 0), count, 1);
+    RigidBody** handles = (RigidBody**)malloc(count * sizeof(RigidBody*));
+    bool ok = world && handles;
+
+    for (int i = 0; ok && i < count; i++) {
+        handles[i] = rigid_body_create(1.0f, vector3_create((float)i, 0, 0), quaternion_identity());
+        ok = handles[i] && physics_world_add_body(world, handles[i]);
+    }
+
+    // Remove every seventh body; the rest must keep their state and a consistent slot
+    for (int i = 0; ok && i < count; i += 7) {
+        ok = physics_world_remove_body(world, handles[i]) &&
+             rigid_body_get_position(handles[i]).x == (float)i && handles[i]->world == NULL;
+        rigid_body_destroy(handles[i]);
+        handles[i] = NULL;
+    }
+    for (int i = 0; ok && i < count; i++) {
+        if (!handles[i]) continue;
+        ok = rigid_body_get_position(handles[i]).x == (float)i &&
+             world->bodies[handles[i]->store_index] == handles[i];
+    }
+    ok = ok && world->body_count == count - (count + 6) / 7 && world->store.count == world->body_count;
+
+    printf("%-46s %s\n", "handles stay valid across swap-removal", ok ? "PASS" : "FAIL");
+
+    physics_world_destroy(world);
+    free(handles);
+    return ok;
+}
+
+static bool check_fields(void) {
+    const int count = 100;
+    PhysicsWorld* world = physics_world_create(vector3_create(0, PHYSICS_GRAVITY_DEFAULT, 0), count, 1);
+    bool ok = world != NULL;
+
+    for (int i = 0; ok && i < count; i++) {
+        RigidBody* body = rigid_body_create(1.0f, vector3_create((float)i * 3.0f, 0, 0), quaternion_identity());
+        ok = body && physics_world_add_body(world, body);
+        if (!ok) {
+            rigid_body_destroy(body);
+        } else {
+            rigid_body_set_velocity(body, vector3_create(0, (float)i * 0.1f, 0));
+        }
+    }
+
+    // After a step the fields of every body agree with the store without a sync
+    for (int step = 0; ok && step < 10; step++) physics_world_step(world, PHYSICS_FIXED_TIMESTEP);
+    for (int i = 0; ok && i < world->body_count; i++) {
+        RigidBody* body = world->bodies[i];
+        ok = vector3_distance(body->position, rigid_body_get_position(body)) == 0.0f &&
+             vector3_distance(body->linear_velocity, rigid_body_get_velocity(body)) == 0.0f &&
+             body->position.y != 0.0f;
+    }
+
+    printf("%-46s %s\n", "body fields follow the store after a step", ok ? "PASS" : "FAIL");
+
+    physics_world_destroy(world);
+    return ok;
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+static void report(const char* name, double seconds, int count, int steps, double baseline) {
+    double per_step = seconds / steps;
+    printf("  %-22s %10.3f %14.1f %9.1fx\n", name, per_step * 1e3, count / per_step / 1e6,
+           baseline > 0 ? baseline / per_step : 1.0);
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    int steps = argc > 2 ? atoi(argv[2]) : 200;
+    if (count < 1 || steps < 1) {
+        fprintf(stderr, "Usage: %s [bodies] [steps]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Body integration benchmark (%d bodies, %d steps, 1 in %d kinematic)\n\n",
+           count, steps, INT_BENCH_KINEMATIC_EVERY);
+
+    bool ok = true;
+    ok &= check_kernels();
+    ok &= check_handles();
+    ok &= check_fields();
+    printf("\n");
+
+    RigidBody** loose = NULL;
+    PhysicsWorld* world = NULL;
+    if (!create_scenes(count, &loose, &world)) {
+        fprintf(stderr, "Failed to create %d bodies\n", count);
+        destroy_loose(loose, count);
+        physics_world_destroy(world);
+        return 1;
+    }
+
+    printf("  %-22s %10s %14s %10s\n", "integrator", "ms/step", "Mbodies/s", "speedup");
+
+    integrate_pointer_loops(loose, count, world->gravity, PHYSICS_FIXED_TIMESTEP);
+    double start = bench_now();
+    for (int step = 0; step < steps; step++) {
+        integrate_pointer_loops(loose, count, world->gravity, PHYSICS_FIXED_TIMESTEP);
+    }
+    double baseline = (bench_now() - start) / steps;
+    report("pointer loops (before)", baseline * steps, count, steps, baseline);
+
+    PhysicsKernel best = physics_get_kernel();
+    for (int k = PHYSICS_KERNEL_SCALAR; k <= (int)best; k++) {
+        physics_set_kernel((PhysicsKernel)k);
+        physics_world_integrate(world, PHYSICS_FIXED_TIMESTEP);
+
+        start = bench_now();
+        for (int step = 0; step < steps; step++) {
+            physics_world_integrate(world, PHYSICS_FIXED_TIMESTEP);
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "body store %s", physics_kernel_name((PhysicsKernel)k));
+        report(name, bench_now() - start, count, steps, baseline);
+    }
+    physics_set_kernel(best);
+
+    // The whole step, for scale: without colliders it is integration plus per-body bookkeeping
+    start = bench_now();
+    for (int step = 0; step < steps; step++) {
+        physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+    }
+    report("physics_world_update", bench_now() - start, count, steps, baseline);
+
+    destroy_loose(loose, count);
+    physics_world_destroy(world);
+    return ok ? 0 : 1;
+}
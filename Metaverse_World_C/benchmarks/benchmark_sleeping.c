@@ -0,0 +1,295 @@
+/*
+ * Metaverse World System - Sleeping Benchmark
+ * Checks that resting islands fall asleep, that contacts, impulses and
+ * body removal wake exactly the island involved, and that a woken island
+ * has all of its contacts in the step that wakes it, then compares the
+ * step time of a settled 50k-body scene with sleeping on and off
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_sleeping.c src/physics.c src/broad_phase.c \
+ *        src/constraint_solver.c src/thread_pool.c src/world.c -o benchmark_sleeping -lm -pthread
+ * Usage: ./benchmark_sleeping [columns of 10 boxes, default 5000] [steps, default 50]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/physics.h"
+#include "bench_common.h"
+
+#define SLEEP_BENCH_HEIGHT 10           // Boxes per column
+#define SLEEP_BENCH_HALF 0.5f           // Box half extent (m)
+#define SLEEP_BENCH_SPACING 1.5f        // Distance between columns (m)
+#define SLEEP_BENCH_SETTLE_STEPS 180    // Steps before timing (3 s)
+#define SLEEP_BENCH_MIN_SPEEDUP 10.0    // Settled step with sleeping vs without
+#define SLEEP_BENCH_SEED 4242u
+
+// ============================================================================
+// Scene
+// ============================================================================
+
+/**
+ * Columns of boxes on a kinematic ground slab. Sleeping and waking
+ * reorder world->bodies, so the scene keeps its own handles: box l of
+ * column c is boxes[c * SLEEP_BENCH_HEIGHT + l].
+ */
+typedef struct {
+    PhysicsWorld* world;
+    RigidBody** boxes;
+    int columns;
+} SleepScene;
+
+static RigidBody* add_box(PhysicsWorld* world, Vector3 position, Vector3 half, bool kinematic) {
+    RigidBody* body = rigid_body_create(1.0f, position, quaternion_identity());
+    Collider* collider = collider_create_box(half);
+    if (!body || !collider) {
+        rigid_body_destroy(body);
+        collider_destroy(collider);
+        return NULL;
+    }
+
+    body->collider = collider;
+    collider->body = body;
+    body->kinematic = kinematic;
+    if (!physics_world_add_body(world, body)) {
+        rigid_body_destroy(body);
+        return NULL;
+    }
+    return body;
+}
+
+static void destroy_scene(SleepScene* scene) {
+    physics_world_destroy(scene->world);
+    free(scene->boxes);
+    memset(scene, 0, sizeof(SleepScene));
+}
+
+// Room for a few extra bodies dropped onto the scene
+static bool create_scene(SleepScene* scene, int columns, bool allow_sleeping) {
+    int bodies = columns * SLEEP_BENCH_HEIGHT + 1;
+    memset(scene, 0, sizeof(SleepScene));
+    scene->columns = columns;
+    scene->world = physics_world_create(vector3_create(0, PHYSICS_GRAVITY_DEFAULT, 0), bodies + 8, bodies + 8);
+    scene->boxes = (RigidBody**)malloc((size_t)columns * SLEEP_BENCH_HEIGHT * sizeof(RigidBody*));
+    if (!scene->world || !scene->boxes) {
+        destroy_scene(scene);
+        return false;
+    }
+    scene->world->allow_sleeping = allow_sleeping;
+
+    int side = (int)ceilf(sqrtf((float)columns));
+    float extent = side * SLEEP_BENCH_SPACING;
+    if (!add_box(scene->world, vector3_create(extent * 0.5f, -SLEEP_BENCH_HALF, extent * 0.5f),
+                 vector3_create(extent, SLEEP_BENCH_HALF, extent), true)) {
+        destroy_scene(scene);
+        return false;
+    }
+
+    uint32_t seed = SLEEP_BENCH_SEED;
+    Vector3 half = vector3_create(SLEEP_BENCH_HALF, SLEEP_BENCH_HALF, SLEEP_BENCH_HALF);
+    for (int c = 0; c < columns; c++) {
+        float x = (c % side + 0.5f) * SLEEP_BENCH_SPACING;
+        float z = (c / side + 0.5f) * SLEEP_BENCH_SPACING;
+        for (int level = 0; level < SLEEP_BENCH_HEIGHT; level++) {
+            Vector3 position = vector3_create(x + bench_random(&seed, -0.05f, 0.05f),
+                                              SLEEP_BENCH_HALF * (2 * level + 1),
+                                              z + bench_random(&seed, -0.05f, 0.05f));
+            RigidBody* box = add_box(scene->world, position, half, false);
+            if (!box) {
+                destroy_scene(scene);
+                return false;
+            }
+            scene->boxes[c * SLEEP_BENCH_HEIGHT + level] = box;
+        }
+    }
+    return true;
+}
+
+// Step until every body sleeps; returns the steps taken or -1
+static int settle(PhysicsWorld* world, int max_steps) {
+    for (int step = 0; step < max_steps; step++) {
+        if (world->store.awake_count == 0) return step;
+        physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+    }
+    return world->store.awake_count == 0 ? max_steps : -1;
+}
+
+// Contacts of this step that touch a column: ground, stacked pairs and anything on top
+static int column_contacts(const SleepScene* scene, int column) {
+    const PhysicsWorld* world = scene->world;
+    int contacts = 0;
+    for (int i = 0; i < world->manifold_count; i++) {
+        for (int level = 0; level < SLEEP_BENCH_HEIGHT; level++) {
+            const RigidBody* box = scene->boxes[column * SLEEP_BENCH_HEIGHT + level];
+            if (world->manifolds[i].body_a == box || world->manifolds[i].body_b == box) {
+                contacts++;
+                break;
+            }
+        }
+    }
+    return contacts;
+}
+
+static bool column_awake(const SleepScene* scene, int column) {
+    for (int level = 0; level < SLEEP_BENCH_HEIGHT; level++) {
+        if (scene->boxes[column * SLEEP_BENCH_HEIGHT + level]->sleeping) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+static bool report_check(const char* name, bool pass, const char* detail) {
+    printf("%-46s %s%s\n", name, pass ? "PASS" : "FAIL", detail);
+    return pass;
+}
+
+static bool check_wake(void) {
+    const int columns = 16;
+    SleepScene scene;
+    if (!create_scene(&scene, columns, true)) return report_check("wake checks", false, " (allocation)");
+    PhysicsWorld* world = scene.world;
+    bool ok = true;
+    char detail[64];
+
+    int steps = settle(world, SLEEP_BENCH_SETTLE_STEPS);
+    snprintf(detail, sizeof(detail), " (%d steps)", steps);
+    ok &= report_check("resting columns fall asleep", steps >= 0, detail);
+
+    // An impulse wakes its column, which is one island, and nothing else
+    RigidBody* pushed = scene.boxes[3 * SLEEP_BENCH_HEIGHT + 4];
+    rigid_body_apply_impulse(pushed, vector3_create(0.1f, 0, 0), rigid_body_get_position(pushed));
+    ok &= report_check("impulse wakes exactly its island",
+                       column_awake(&scene, 3) && world->store.awake_count == SLEEP_BENCH_HEIGHT, "");
+    ok &= report_check("woken column settles again", settle(world, SLEEP_BENCH_SETTLE_STEPS) >= 0, "");
+
+    // A box dropped onto a sleeping column wakes it through the contact
+    Vector3 top = rigid_body_get_position(scene.boxes[5 * SLEEP_BENCH_HEIGHT + SLEEP_BENCH_HEIGHT - 1]);
+    RigidBody* dropped = add_box(world, vector3_add(top, vector3_create(0, 2.0f, 0)),
+                                 vector3_create(SLEEP_BENCH_HALF, SLEEP_BENCH_HALF, SLEEP_BENCH_HALF), false);
+    bool woke = false;
+    for (int step = 0; dropped && step < 60 && !woke; step++) {
+        physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+        woke = column_awake(&scene, 5);
+    }
+    ok &= report_check("falling box wakes the column it lands on",
+                       woke && world->store.awake_count == SLEEP_BENCH_HEIGHT + 1, "");
+    ok &= report_check("column with the extra box settles again", settle(world, SLEEP_BENCH_SETTLE_STEPS) >= 0, "");
+
+    // Removing the bottom box wakes the column, and the boxes above fall
+    RigidBody* bottom = scene.boxes[7 * SLEEP_BENCH_HEIGHT];
+    RigidBody* above = scene.boxes[7 * SLEEP_BENCH_HEIGHT + SLEEP_BENCH_HEIGHT - 1];
+    float before = rigid_body_get_position(above).y;
+    physics_world_remove_body(world, bottom);
+    rigid_body_destroy(bottom);
+    scene.boxes[7 * SLEEP_BENCH_HEIGHT] = NULL;
+    for (int step = 0; step < 30; step++) physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+    float fell = before - rigid_body_get_position(above).y;
+    snprintf(detail, sizeof(detail), " (top box fell %.2f m)", fell);
+    ok &= report_check("removing a support wakes the boxes above", fell > 0.5f, detail);
+
+    destroy_scene(&scene);
+    return ok;
+}
+
+/**
+ * The step in which a falling box wakes a column must already solve every
+ * contact of the column, not only the new one: the pair pass skipped the
+ * column's own pairs while it slept
+ */
+static bool check_wake_contacts(BroadPhaseType type) {
+    const int columns = 4;
+    SleepScene scene;
+    char label[64];
+    snprintf(label, sizeof(label), "woken island keeps contacts (%s)", broad_phase_type_name(type));
+    if (!create_scene(&scene, columns, true) || !physics_world_set_broad_phase(scene.world, type)) {
+        destroy_scene(&scene);
+        return report_check(label, false, " (allocation)");
+    }
+
+    bool ok = settle(scene.world, SLEEP_BENCH_SETTLE_STEPS) >= 0;
+    Vector3 top = rigid_body_get_position(scene.boxes[SLEEP_BENCH_HEIGHT - 1]);
+    ok = ok && add_box(scene.world, vector3_add(top, vector3_create(0, 2.0f, 0)),
+                       vector3_create(SLEEP_BENCH_HALF, SLEEP_BENCH_HALF, SLEEP_BENCH_HALF), false);
+
+    bool woke = false;
+    for (int step = 0; ok && step < 60 && !woke; step++) {
+        physics_world_update(scene.world, PHYSICS_FIXED_TIMESTEP);
+        woke = column_awake(&scene, 0);
+    }
+
+    // Ground, the stacked pairs and the new box
+    int contacts = woke ? column_contacts(&scene, 0) : 0;
+    char detail[64];
+    snprintf(detail, sizeof(detail), " (%d of %d)", contacts, SLEEP_BENCH_HEIGHT + 1);
+    destroy_scene(&scene);
+    return report_check(label, ok && contacts == SLEEP_BENCH_HEIGHT + 1, detail);
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+// Settled step time; sleeping scenes must be fully asleep when timing starts
+static double time_settled(int columns, int steps, bool allow_sleeping, int* awake, bool* ok) {
+    SleepScene scene;
+    if (!create_scene(&scene, columns, allow_sleeping)) {
+        *ok = false;
+        return 0.0;
+    }
+
+    for (int step = 0; step < SLEEP_BENCH_SETTLE_STEPS; step++) {
+        physics_world_update(scene.world, PHYSICS_FIXED_TIMESTEP);
+    }
+
+    double start = bench_now();
+    for (int step = 0; step < steps; step++) {
+        physics_world_update(scene.world, PHYSICS_FIXED_TIMESTEP);
+    }
+    double step_ms = (bench_now() - start) * 1e3 / steps;
+
+    *awake = scene.world->store.awake_count;
+    if (allow_sleeping && *awake != 0) *ok = false;
+    destroy_scene(&scene);
+    return step_ms;
+}
+
+int main(int argc, char* argv[]) {
+    int columns = argc > 1 ? atoi(argv[1]) : 5000;
+    int steps = argc > 2 ? atoi(argv[2]) : 50;
+    if (columns < 1 || steps < 1) {
+        fprintf(stderr, "Usage: %s [columns] [steps]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Sleeping benchmark (sleep below %.2f m/s for %.1f s)\n\n",
+           PHYSICS_SLEEP_VELOCITY, PHYSICS_SLEEP_TIME);
+
+    bool ok = check_wake();
+    ok &= check_wake_contacts(BROAD_PHASE_AABB_TREE);
+    ok &= check_wake_contacts(BROAD_PHASE_SWEEP_AND_PRUNE);
+    ok &= check_wake_contacts(BROAD_PHASE_BRUTE_FORCE);
+    printf("\n");
+
+    printf("Settled scene: %d columns x %d boxes (%d bodies), %d settle steps, %d timed steps\n",
+           columns, SLEEP_BENCH_HEIGHT, columns * SLEEP_BENCH_HEIGHT + 1, SLEEP_BENCH_SETTLE_STEPS, steps);
+    printf("  %-10s %10s %12s %9s\n", "sleeping", "step ms", "awake bodies", "speedup");
+
+    int awake_off = 0, awake_on = 0;
+    bool timing_ok = true;
+    double off_ms = time_settled(columns, steps, false, &awake_off, &timing_ok);
+    printf("  %-10s %10.3f %12d %8.1fx\n", "off", off_ms, awake_off, 1.0);
+    double on_ms = time_settled(columns, steps, true, &awake_on, &timing_ok);
+    double speedup = on_ms > 0.0 ? off_ms / on_ms : 0.0;
+    printf("  %-10s %10.3f %12d %8.1fx\n\n", "on", on_ms, awake_on, speedup);
+
+    char label[64];
+    snprintf(label, sizeof(label), "settled step at least %.0fx faster asleep", SLEEP_BENCH_MIN_SPEEDUP);
+    ok &= report_check(label, timing_ok && speedup >= SLEEP_BENCH_MIN_SPEEDUP, "");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,308 @@
+/*
+ * Metaverse World System - Constraint Solver Benchmark
+ * Measures stacking stability of a box column against solver iterations
+ * with and without warm starting, checks joints and that island-parallel
+ * solving matches serial solving bit for bit, then times large piles of
+ * box columns across solver thread counts
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_solver.c src/physics.c src/broad_phase.c \
+ *        src/constraint_solver.c src/thread_pool.c src/world.c -o benchmark_solver -lm -pthread
+ * Usage: ./benchmark_solver [columns in the timed pile, default 1000] [steps, default 100]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/physics.h"
+#include "../headers/thread_pool.h"
+#include "bench_common.h"
+
+#define SOLVER_BENCH_HEIGHT 10          // Boxes per column
+#define SOLVER_BENCH_HALF 0.5f          // Box half extent (m)
+#define SOLVER_BENCH_SPACING 1.5f       // Distance between columns (m)
+#define SOLVER_BENCH_SETTLE_STEPS 300   // Steps before measuring (5 s)
+#define SOLVER_BENCH_SEED 777u
+
+// Stacking pass limits with the default iterations and warm starting
+#define SOLVER_BENCH_MAX_SINK 0.25f     // Top box below its resting height (m)
+#define SOLVER_BENCH_MAX_SPEED 0.05f    // Fastest box after settling (m/s)
+#define SOLVER_BENCH_WARM_SLACK 0.005f  // Warm start may trail cold start by this much (m, m/s)
+
+static const int thread_counts[] = { 1, 2, 4, 8 };
+#define SOLVER_BENCH_THREAD_COUNTS (int)(sizeof(thread_counts) / sizeof(thread_counts[0]))
+
+// ============================================================================
+// Scene
+// ============================================================================
+
+static RigidBody* add_box(PhysicsWorld* world, Vector3 position, Vector3 half, bool kinematic) {
+    RigidBody* body = rigid_body_create(1.0f, position, quaternion_identity());
+    Collider* collider = collider_create_box(half);
+    if (!body || !collider) {
+        rigid_body_destroy(body);
+        collider_destroy(collider);
+        return NULL;
+    }
+
+    body->collider = collider;
+    collider->body = body;
+    body->kinematic = kinematic;
+    if (!physics_world_add_body(world, body)) {
+        rigid_body_destroy(body);
+        return NULL;
+    }
+    return body;
+}
+
+/**
+ * Columns of boxes resting on a kinematic ground slab, laid out on a
+ * square grid. Boxes start touching, with a small random sideways offset
+ * so friction has something to hold. Sleeping is off: resting columns
+ * would stop reaching the solver this benchmark measures.
+ */
+static PhysicsWorld* create_pile(int columns, int iterations, bool warm_starting) {
+    int bodies = columns * SOLVER_BENCH_HEIGHT + 1;
+    PhysicsWorld* world = physics_world_create(vector3_create(0, PHYSICS_GRAVITY_DEFAULT, 0), bodies, bodies);
+    if (!world) return NULL;
+    world->max_iterations = iterations;
+    world->warm_starting = warm_starting;
+    world->allow_sleeping = false;
+
+    int side = (int)ceilf(sqrtf((float)columns));
+    float extent = side * SOLVER_BENCH_SPACING;
+    if (!add_box(world, vector3_create(extent * 0.5f, -SOLVER_BENCH_HALF, extent * 0.5f),
+                 vector3_create(extent, SOLVER_BENCH_HALF, extent), true)) {
+        physics_world_destroy(world);
+        return NULL;
+    }
+
+    uint32_t seed = SOLVER_BENCH_SEED;
+    Vector3 half = vector3_create(SOLVER_BENCH_HALF, SOLVER_BENCH_HALF, SOLVER_BENCH_HALF);
+    for (int c = 0; c < columns; c++) {
+        float x = (c % side + 0.5f) * SOLVER_BENCH_SPACING;
+        float z = (c / side + 0.5f) * SOLVER_BENCH_SPACING;
+        for (int level = 0; level < SOLVER_BENCH_HEIGHT; level++) {
+            Vector3 position = vector3_create(x + bench_random(&seed, -0.05f, 0.05f),
+                                              SOLVER_BENCH_HALF * (2 * level + 1),
+                                              z + bench_random(&seed, -0.05f, 0.05f));
+            if (!add_box(world, position, half, false)) {
+                physics_world_destroy(world);
+                return NULL;
+            }
+        }
+    }
+    return world;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+typedef struct {
+    float sink;                     // Top box below its resting height
+    float penetration;              // Deepest contact in the last step
+    float speed;                    // Fastest box in the last step
+    float drift;                    // Largest sideways movement
+} StackResult;
+
+static bool measure_stack(int iterations, bool warm_starting, StackResult* result) {
+    PhysicsWorld* world = create_pile(1, iterations, warm_starting);
+    if (!world) return false;
+
+    Vector3 start[SOLVER_BENCH_HEIGHT + 1];
+    for (int i = 0; i < world->body_count; i++) start[i] = rigid_body_get_position(world->bodies[i]);
+
+    for (int step = 0; step < SOLVER_BENCH_SETTLE_STEPS; step++) {
+        physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+    }
+
+    memset(result, 0, sizeof(StackResult));
+    for (int i = 1; i < world->body_count; i++) {
+        Vector3 position = rigid_body_get_position(world->bodies[i]);
+        result->speed = fmaxf(result->speed, vector3_magnitude(rigid_body_get_velocity(world->bodies[i])));
+        result->drift = fmaxf(result->drift, hypotf(position.x - start[i].x, position.z - start[i].z));
+        if (i == world->body_count - 1) result->sink = start[i].y - position.y;
+    }
+    for (int m = 0; m < world->manifold_count; m++) {
+        result->penetration = fmaxf(result->penetration, world->manifolds[m].contacts[0].penetration);
+    }
+
+    physics_world_destroy(world);
+    return true;
+}
+
+static bool check_stacking(void) {
+    static const int iteration_counts[] = { 1, 4, PHYSICS_MAX_ITERATIONS, 20 };
+    bool rests = true;
+    bool warm_helps = true;
+
+    printf("Column of %d boxes after %.0f s\n", SOLVER_BENCH_HEIGHT,
+           SOLVER_BENCH_SETTLE_STEPS * PHYSICS_FIXED_TIMESTEP);
+    printf("  %10s %12s %10s %14s %12s %10s\n",
+           "iterations", "warm start", "sink (m)", "penetration", "speed (m/s)", "drift (m)");
+
+    for (int i = 0; i < (int)(sizeof(iteration_counts) / sizeof(iteration_counts[0])); i++) {
+        StackResult results[2];
+        for (int warm = 1; warm >= 0; warm--) {
+            StackResult* result = &results[warm];
+            if (!measure_stack(iteration_counts[i], warm, result)) return false;
+            printf("  %10d %12s %10.4f %14.4f %12.4f %10.4f\n", iteration_counts[i], warm ? "on" : "off",
+                   result->sink, result->penetration, result->speed, result->drift);
+        }
+
+        if (iteration_counts[i] == PHYSICS_MAX_ITERATIONS) {
+            rests = results[1].sink < SOLVER_BENCH_MAX_SINK && results[1].speed < SOLVER_BENCH_MAX_SPEED;
+        }
+        // A column pushed up is as wrong as one that sank
+        warm_helps &= fabsf(results[1].sink) <= fabsf(results[0].sink) + SOLVER_BENCH_WARM_SLACK &&
+                      results[1].speed <= results[0].speed + SOLVER_BENCH_WARM_SLACK;
+    }
+
+    printf("%-46s %s\n", "column rests with default iterations", rests ? "PASS" : "FAIL");
+    printf("%-46s %s\n\n", "warm start no worse than cold at any count", warm_helps ? "PASS" : "FAIL");
+    return rests && warm_helps;
+}
+
+/**
+ * A chain of spheres hanging from a kinematic anchor by hinge joints must
+ * keep its links together; a joint with a low break force must break
+ * under the chain's weight
+ */
+static bool check_joints(void) {
+    const int links = 8;
+    PhysicsWorld* world = physics_world_create(vector3_create(0, PHYSICS_GRAVITY_DEFAULT, 0), links + 1, links + 1);
+    Joint* joints[8];
+    int joint_count = 0;
+    bool ok = world != NULL;
+    if (ok) world->allow_sleeping = false;
+
+    RigidBody* previous = NULL;
+    for (int i = 0; ok && i <= links; i++) {
+        // Links hang sideways so they swing down before settling
+        RigidBody* body = rigid_body_create(1.0f, vector3_create((float)i, 10.0f, 0), quaternion_identity());
+        ok = body && physics_world_add_body(world, body);
+        if (!ok) {
+            rigid_body_destroy(body);
+            break;
+        }
+        rigid_body_set_kinematic(body, i == 0);
+
+        if (previous) {
+            Joint* joint = joint_create_hinge(previous, body, vector3_create(i - 0.5f, 10.0f, 0),
+                                              vector3_create(0, 0, 1));
+            ok = joint != NULL;
+            if (ok) joints[joint_count++] = joint;
+            ok = ok && physics_world_add_joint(world, joint);
+        }
+        previous = body;
+    }
+
+    float max_gap = 0.0f;
+    for (int step = 0; ok && step < SOLVER_BENCH_SETTLE_STEPS; step++) {
+        physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+    }
+    for (int i = 0; ok && i < links; i++) {
+        Joint* joint = joints[i];
+        Vector3 anchor_a = vector3_add(rigid_body_get_position(joint->body_a), joint->anchor_a);
+        Vector3 anchor_b = vector3_add(rigid_body_get_position(joint->body_b), joint->anchor_b);
+        max_gap = fmaxf(max_gap, vector3_distance(anchor_a, anchor_b));
+    }
+    bool chain_ok = ok && max_gap < 0.05f && world->island_count == 1;
+    printf("%-46s %s (largest anchor gap %.4f m)\n", "hinge chain holds together", chain_ok ? "PASS" : "FAIL", max_gap);
+
+    // The top joint carries the whole chain: about links * m * g
+    bool break_ok = false;
+    if (ok) {
+        joint_set_break_forces(joints[0], 0.5f * links * 9.81f, 0.0f);
+        for (int step = 0; step < 10; step++) {
+            physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+        }
+        break_ok = joint_is_broken(joints[0]) && !joint_is_broken(joints[1]);
+    }
+    printf("%-46s %s\n\n", "overloaded joint breaks", break_ok ? "PASS" : "FAIL");
+
+    for (int i = 0; i < joint_count; i++) joint_destroy(joints[i]);
+    physics_world_destroy(world);
+    return chain_ok && break_ok;
+}
+
+// Islands are independent, so the thread count must not change a single bit
+static bool check_threads(void) {
+    const int columns = 64;
+    const int steps = 60;
+    PhysicsWorld* serial = create_pile(columns, PHYSICS_MAX_ITERATIONS, true);
+    PhysicsWorld* parallel = create_pile(columns, PHYSICS_MAX_ITERATIONS, true);
+    bool ok = serial && parallel && physics_world_set_threads(parallel, 4);
+
+    for (int step = 0; ok && step < steps; step++) {
+        physics_world_update(serial, PHYSICS_FIXED_TIMESTEP);
+        physics_world_update(parallel, PHYSICS_FIXED_TIMESTEP);
+    }
+    for (int i = 0; ok && i < serial->body_count; i++) {
+        Vector3 a = rigid_body_get_position(serial->bodies[i]);
+        Vector3 b = rigid_body_get_position(parallel->bodies[i]);
+        ok = a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+    ok = ok && serial->island_count == columns && parallel->island_count == columns;
+
+    printf("%-46s %s\n\n", "4 threads match 1 thread exactly", ok ? "PASS" : "FAIL");
+    physics_world_destroy(serial);
+    physics_world_destroy(parallel);
+    return ok;
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+    int columns = argc > 1 ? atoi(argv[1]) : 1000;
+    int steps = argc > 2 ? atoi(argv[2]) : 100;
+    if (columns < 1 || steps < 1) {
+        fprintf(stderr, "Usage: %s [columns] [steps]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Constraint solver benchmark (%d iterations by default, %d hardware threads)\n\n",
+           PHYSICS_MAX_ITERATIONS, thread_pool_hardware_threads());
+
+    bool ok = true;
+    ok &= check_stacking();
+    ok &= check_joints();
+    ok &= check_threads();
+
+    printf("Pile of %d columns x %d boxes, settled for %d steps, then %d timed steps\n",
+           columns, SOLVER_BENCH_HEIGHT, SOLVER_BENCH_SETTLE_STEPS / 3, steps);
+    printf("  %8s %10s %9s %10s %12s\n", "threads", "step ms", "speedup", "islands", "constraints");
+
+    double serial_ms = 0.0;
+    for (int t = 0; t < SOLVER_BENCH_THREAD_COUNTS; t++) {
+        PhysicsWorld* world = create_pile(columns, PHYSICS_MAX_ITERATIONS, true);
+        if (!world || !physics_world_set_threads(world, thread_counts[t])) {
+            printf("  %8d failed to build the scene\n", thread_counts[t]);
+            physics_world_destroy(world);
+            ok = false;
+            continue;
+        }
+
+        for (int step = 0; step < SOLVER_BENCH_SETTLE_STEPS / 3; step++) {
+            physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+        }
+
+        double start = bench_now();
+        for (int step = 0; step < steps; step++) {
+            physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+        }
+        double step_ms = (bench_now() - start) * 1e3 / steps;
+        if (t == 0) serial_ms = step_ms;
+
+        printf("  %8d %10.3f %8.2fx %10d %12d\n", thread_counts[t], step_ms, serial_ms / step_ms,
+               world->island_count, world->constraints_solved);
+        physics_world_destroy(world);
+    }
+
+    return ok ? 0 : 1;
+}
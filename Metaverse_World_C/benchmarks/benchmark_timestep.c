@@ -0,0 +1,287 @@
+/*
+ * Metaverse World System - Fixed Timestep Benchmark
+ * Checks that accumulator-driven updates give the same simulation at any
+ * frame rate, that a long frame runs at most max_substeps steps, and that
+ * interpolated positions trail the simulation smoothly, then compares the
+ * per-frame cost of fixed steps against one variable step per frame
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_timestep.c src/physics.c src/broad_phase.c \
+ *        src/constraint_solver.c src/thread_pool.c src/world.c -o benchmark_timestep -lm -pthread
+ * Usage: ./benchmark_timestep [columns of 10 boxes, default 200] [simulated seconds, default 2]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/physics.h"
+#include "bench_common.h"
+
+#define STEP_BENCH_HEIGHT 10            // Boxes per column
+#define STEP_BENCH_HALF 0.5f            // Box half extent (m)
+#define STEP_BENCH_SPACING 1.5f         // Distance between columns (m)
+#define STEP_BENCH_DROP 2.0f            // Columns start above the ground (m)
+#define STEP_BENCH_SEED 99u
+
+static const float frame_rates[] = { 30.0f, 60.0f, 144.0f };
+#define STEP_BENCH_FRAME_RATES (int)(sizeof(frame_rates) / sizeof(frame_rates[0]))
+
+// ============================================================================
+// Scene
+// ============================================================================
+
+static RigidBody* add_box(PhysicsWorld* world, Vector3 position, Vector3 half, bool kinematic) {
+    RigidBody* body = rigid_body_create(1.0f, position, quaternion_identity());
+    Collider* collider = collider_create_box(half);
+    if (!body || !collider) {
+        rigid_body_destroy(body);
+        collider_destroy(collider);
+        return NULL;
+    }
+
+    body->collider = collider;
+    collider->body = body;
+    body->kinematic = kinematic;
+    if (!physics_world_add_body(world, body)) {
+        rigid_body_destroy(body);
+        return NULL;
+    }
+    return body;
+}
+
+/**
+ * Columns of boxes dropped onto a kinematic ground slab. Sleeping is off
+ * so every frame does the same work. Bodies are added in a fixed order;
+ * handles[i] is the i-th body added (the ground first).
+ */
+static PhysicsWorld* create_scene(int columns, RigidBody** handles) {
+    int bodies = columns * STEP_BENCH_HEIGHT + 1;
+    PhysicsWorld* world = physics_world_create(vector3_create(0, PHYSICS_GRAVITY_DEFAULT, 0), bodies, bodies);
+    if (!world) return NULL;
+    world->allow_sleeping = false;
+
+    int side = (int)ceilf(sqrtf((float)columns));
+    float extent = side * STEP_BENCH_SPACING;
+    handles[0] = add_box(world, vector3_create(extent * 0.5f, -STEP_BENCH_HALF, extent * 0.5f),
+                         vector3_create(extent, STEP_BENCH_HALF, extent), true);
+    if (!handles[0]) {
+        physics_world_destroy(world);
+        return NULL;
+    }
+
+    uint32_t seed = STEP_BENCH_SEED;
+    Vector3 half = vector3_create(STEP_BENCH_HALF, STEP_BENCH_HALF, STEP_BENCH_HALF);
+    for (int c = 0; c < columns; c++) {
+        float x = (c % side + 0.5f) * STEP_BENCH_SPACING;
+        float z = (c / side + 0.5f) * STEP_BENCH_SPACING;
+        for (int level = 0; level < STEP_BENCH_HEIGHT; level++) {
+            Vector3 position = vector3_create(x + bench_random(&seed, -0.05f, 0.05f),
+                                              STEP_BENCH_DROP + STEP_BENCH_HALF * (2 * level + 1),
+                                              z + bench_random(&seed, -0.05f, 0.05f));
+            RigidBody* box = add_box(world, position, half, false);
+            if (!box) {
+                physics_world_destroy(world);
+                return NULL;
+            }
+            handles[1 + c * STEP_BENCH_HEIGHT + level] = box;
+        }
+    }
+    return world;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+static bool report_check(const char* name, bool pass, const char* detail) {
+    printf("%-46s %s%s\n", name, pass ? "PASS" : "FAIL", detail);
+    return pass;
+}
+
+/**
+ * Jittery frames through the accumulator must reproduce plain fixed steps
+ * bit for bit: the frame rate only decides when steps run, not what they do
+ */
+static bool check_frame_rate_independence(void) {
+    const int columns = 16;
+    const int bodies = columns * STEP_BENCH_HEIGHT + 1;
+    RigidBody** framed_handles = (RigidBody**)malloc(bodies * sizeof(RigidBody*));
+    RigidBody** stepped_handles = (RigidBody**)malloc(bodies * sizeof(RigidBody*));
+    PhysicsWorld* framed = framed_handles ? create_scene(columns, framed_handles) : NULL;
+    PhysicsWorld* stepped = stepped_handles ? create_scene(columns, stepped_handles) : NULL;
+    bool ok = framed && stepped;
+
+    uint32_t seed = STEP_BENCH_SEED;
+    int steps = 0;
+    for (int frame = 0; ok && frame < 300; frame++) {
+        physics_world_update(framed, bench_random(&seed, 0.004f, 0.030f));
+        for (int s = 0; s < framed->substeps; s++) {
+            physics_world_step(stepped, stepped->fixed_timestep);
+        }
+        steps += framed->substeps;
+    }
+
+    for (int i = 0; ok && i < bodies; i++) {
+        Vector3 a = rigid_body_get_position(framed_handles[i]);
+        Vector3 b = rigid_body_get_position(stepped_handles[i]);
+        ok = a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    char detail[64];
+    snprintf(detail, sizeof(detail), " (%d steps in 300 frames)", steps);
+    report_check("jittery frames match plain fixed steps", ok, detail);
+
+    physics_world_destroy(framed);
+    physics_world_destroy(stepped);
+    free(framed_handles);
+    free(stepped_handles);
+    return ok;
+}
+
+// A one-second hitch runs max_substeps steps and drops the rest
+static bool check_catch_up_cap(void) {
+    PhysicsWorld* world = physics_world_create(vector3_create(0, PHYSICS_GRAVITY_DEFAULT, 0), 1, 1);
+    RigidBody* body = rigid_body_create(1.0f, vector3_create(0, 0, 0), quaternion_identity());
+    bool ok = world && body && physics_world_add_body(world, body);
+    if (!ok) rigid_body_destroy(body);
+
+    int hitch_steps = 0, next_steps = 0;
+    if (ok) {
+        physics_world_update(world, 1.0f);
+        hitch_steps = world->substeps;
+        ok = hitch_steps == world->max_substeps && world->accumulator < world->fixed_timestep;
+
+        physics_world_update(world, PHYSICS_FIXED_TIMESTEP);
+        next_steps = world->substeps;
+        ok = ok && next_steps <= 1;
+    }
+
+    char detail[64];
+    snprintf(detail, sizeof(detail), " (%d steps, then %d)", hitch_steps, next_steps);
+    report_check("a 1 s frame runs at most max_substeps", ok, detail);
+
+    physics_world_destroy(world);
+    return ok;
+}
+
+/**
+ * A body drifting at constant velocity: the interpolated position must be
+ * where it was exactly one fixed step before the frame time, at any alpha
+ */
+static bool check_interpolation(void) {
+    const Vector3 velocity = { 3.0f, 0.0f, -1.0f };
+    PhysicsWorld* world = physics_world_create(vector3_create(0, 0, 0), 1, 1);
+    RigidBody* body = rigid_body_create(1.0f, vector3_create(0, 0, 0), quaternion_identity());
+    bool ok = world && body && physics_world_add_body(world, body);
+    if (!ok) rigid_body_destroy(body);
+
+    double time = 0.0;
+    float max_error = 0.0f;
+    uint32_t seed = STEP_BENCH_SEED;
+    if (ok) {
+        rigid_body_set_damping(body, 0.0f, 0.0f);
+        rigid_body_set_velocity(body, velocity);
+        world->allow_sleeping = false;
+
+        for (int frame = 0; frame < 200; frame++) {
+            float frame_time = bench_random(&seed, 0.004f, 0.030f);
+            physics_world_update(world, frame_time);
+            time += frame_time;
+            if (time < world->fixed_timestep) continue;
+
+            float rendered = (float)(time - world->fixed_timestep);
+            Vector3 expected = vector3_multiply(velocity, rendered);
+            Vector3 actual = rigid_body_get_interpolated_position(body, world->interpolation_alpha);
+            max_error = fmaxf(max_error, vector3_distance(expected, actual));
+
+            Matrix4x4 transform = rigid_body_get_interpolated_transform(body, world->interpolation_alpha);
+            ok = ok && transform.m[0][3] == actual.x && transform.m[1][3] == actual.y &&
+                 transform.m[2][3] == actual.z && transform.m[0][0] == 1.0f && transform.m[3][3] == 1.0f;
+        }
+        ok = ok && max_error < 1e-3f;
+    }
+
+    char detail[64];
+    snprintf(detail, sizeof(detail), " (max error %.2e m)", max_error);
+    report_check("interpolation trails the simulation one step", ok, detail);
+
+    physics_world_destroy(world);
+    return ok;
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+typedef struct {
+    int frames;
+    int steps;
+    double total_ms;
+    double worst_ms;
+} FrameStats;
+
+// Simulate a few seconds at a frame rate, one fixed-step update or one variable step per frame
+static bool run_frames(int columns, float frame_rate, float seconds, bool fixed, FrameStats* stats) {
+    RigidBody** handles = (RigidBody**)malloc(((size_t)columns * STEP_BENCH_HEIGHT + 1) * sizeof(RigidBody*));
+    PhysicsWorld* world = handles ? create_scene(columns, handles) : NULL;
+    free(handles);
+    if (!world) return false;
+
+    memset(stats, 0, sizeof(FrameStats));
+    stats->frames = (int)(seconds * frame_rate);
+    for (int frame = 0; frame < stats->frames; frame++) {
+        double start = bench_now();
+        if (fixed) {
+            physics_world_update(world, 1.0f / frame_rate);
+            stats->steps += world->substeps;
+        } else {
+            physics_world_step(world, 1.0f / frame_rate);
+            stats->steps++;
+        }
+        double ms = (bench_now() - start) * 1e3;
+        stats->total_ms += ms;
+        if (ms > stats->worst_ms) stats->worst_ms = ms;
+    }
+
+    physics_world_destroy(world);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int columns = argc > 1 ? atoi(argv[1]) : 200;
+    float seconds = argc > 2 ? (float)atof(argv[2]) : 2.0f;
+    if (columns < 1 || seconds <= 0.0f) {
+        fprintf(stderr, "Usage: %s [columns] [seconds]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Fixed timestep benchmark (step %.4f s, at most %d per update)\n\n",
+           PHYSICS_FIXED_TIMESTEP, PHYSICS_MAX_SUBSTEPS);
+
+    bool ok = true;
+    ok &= check_frame_rate_independence();
+    ok &= check_catch_up_cap();
+    ok &= check_interpolation();
+    printf("\n");
+
+    printf("%d columns x %d boxes dropped, %.1f simulated seconds\n", columns, STEP_BENCH_HEIGHT, seconds);
+    printf("  %-10s %8s %8s %8s %12s %12s %10s\n",
+           "stepping", "fps", "frames", "steps", "ms/frame", "worst ms", "ms/step");
+
+    for (int mode = 0; mode < 2; mode++) {
+        for (int r = 0; r < STEP_BENCH_FRAME_RATES; r++) {
+            FrameStats stats;
+            if (!run_frames(columns, frame_rates[r], seconds, mode == 0, &stats)) {
+                printf("  failed to build the scene\n");
+                return 1;
+            }
+            printf("  %-10s %8.0f %8d %8d %12.3f %12.3f %10.3f\n", mode == 0 ? "fixed" : "variable",
+                   frame_rates[r], stats.frames, stats.steps, stats.total_ms / stats.frames, stats.worst_ms,
+                   stats.total_ms / stats.steps);
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -93,7 +93,7 @@ check_executable() {
         echo -e "${RED}Error: $METAVERSE_WORLD not found!${NC}"
         echo "Please compile the system first:"
         echo "  cd Metaverse_World_C"
-        echo "  gcc -Wall -Wextra -O2 -I headers/ src/*.c -o metaverse_world.exe -lm"
+        echo "  gcc -Wall -Wextra -O2 -I headers/ src/*.c -o metaverse_world.exe -lm -pthread"
         exit 1
     fi
 }
@@ -0,0 +1,243 @@
+/*
+ * Metaverse World System - Broad Phase Collision Header
+ * Pluggable broad phase for the physics world: brute force pair testing,
+ * incremental sweep-and-prune and a dynamic AABB tree with fat bounds
+ */
+
+#ifndef METAVERSE_BROAD_PHASE_H
+#define METAVERSE_BROAD_PHASE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "world.h"
+
+// ============================================================================
+// Broad Phase Constants and Configuration
+// ============================================================================
+
+#define BROAD_PHASE_NULL_PROXY -1       // Proxy id of an object not in the broad phase
+#define BROAD_PHASE_NULL_NODE -1        // Missing tree node
+#define BROAD_PHASE_DEFAULT_MARGIN 0.1f // Fat bounds margin of tree leaves (m)
+#define BROAD_PHASE_DISPLACEMENT_SCALE 2.0f // Fat bounds stretch along the predicted displacement
+
+/**
+ * @brief Axis-aligned bounding box in world space
+ */
+typedef struct {
+    Vector3 min;                    // Minimum corner
+    Vector3 max;                    // Maximum corner
+} AABB;
+
+/**
+ * @brief Broad phase algorithms
+ */
+typedef enum {
+    BROAD_PHASE_BRUTE_FORCE,        // Test every pair (O(n²), reference)
+    BROAD_PHASE_SWEEP_AND_PRUNE,    // Sorted interval sweep along one axis, re-sorted incrementally
+    BROAD_PHASE_AABB_TREE           // Dynamic bounding volume tree over fat bounds
+} BroadPhaseType;
+
+/**
+ * @brief Called once per overlapping pair
+ * @param user_a User data of the first proxy
+ * @param user_b User data of the second proxy
+ * @param context Caller context passed to broad_phase_find_pairs
+ */
+typedef void (*BroadPhasePairCallback)(void* user_a, void* user_b, void* context);
+
+/**
+ * @brief Object tracked by the broad phase
+ */
+typedef struct {
+    AABB bounds;                    // Tight bounds (what pairs are reported for)
+    AABB fat_bounds;                // Enlarged bounds stored in the tree
+    void* user_data;                // Owner (a RigidBody in the physics world)
+    int node;                       // Tree leaf holding the proxy
+    int next_free;                  // Next free proxy while unused
+    bool active;                    // Whether the proxy is in use
+    bool sleeping;                  // Pairs of two sleeping proxies are not reported
+    bool listed;                    // In the proxy list of a running broad_phase_find_pairs_of
+} BroadPhaseProxy;
+
+/**
+ * @brief Sweep-and-prune entry: a proxy's interval on the sort axis
+ *
+ * Carries a copy of the bounds so the sweep reads the sorted array
+ * sequentially instead of chasing proxies.
+ */
+typedef struct {
+    float min;                      // Interval start (sort key)
+    float max;                      // Interval end
+    AABB bounds;                    // Proxy bounds
+    int proxy;                      // Proxy id
+    bool sleeping;                  // Proxy is sleeping
+} BroadPhaseInterval;
+
+/**
+ * @brief Dynamic AABB tree node
+ */
+typedef struct {
+    AABB bounds;                    // Union of the children (fat bounds at leaves)
+    int parent;                     // Parent node (next free node while unused)
+    int left;                       // First child (BROAD_PHASE_NULL_NODE at leaves)
+    int right;                      // Second child
+    int height;                     // Leaves are 0
+    int proxy;                      // Proxy of a leaf
+    bool awake;                     // Some leaf below is not sleeping (sleeping subtrees are skipped)
+} BroadPhaseNode;
+
+/**
+ * @brief Broad phase state
+ */
+typedef struct {
+    BroadPhaseType type;            // Algorithm
+    float margin;                   // Fat bounds margin
+
+    // Proxies
+    BroadPhaseProxy* proxies;       // Proxy pool
+    int proxy_count;                // Proxies ever allocated (pool high-water mark)
+    int proxy_capacity;             // Pool capacity
+    int free_proxy;                 // Head of the free proxy list
+    int active_count;               // Proxies in use
+
+    // Sweep and prune
+    BroadPhaseInterval* intervals;  // Intervals sorted by start
+    int interval_count;             // Number of intervals
+    int interval_capacity;          // Interval capacity
+    int sort_axis;                  // Sort axis (0 = x, 1 = y, 2 = z)
+
+    // Dynamic AABB tree
+    BroadPhaseNode* nodes;          // Node pool
+    int node_capacity;              // Node pool capacity
+    int free_node;                  // Head of the free node list
+    int root;                       // Root node
+    int* stack;                     // Traversal stack
+    int stack_capacity;             // Traversal stack capacity
+
+    // Statistics
+    uint64_t bounds_tests;          // AABB overlap tests of the last query
+    int pair_count;                 // Overlapping pairs reported by the last query
+    uint64_t reinserts;             // Tree leaves that left their fat bounds (since creation)
+} BroadPhase;
+
+// ============================================================================
+// Broad Phase Functions
+// ============================================================================
+
+/**
+ * @brief Create broad phase
+ * @param type Algorithm
+ * @param margin Fat bounds margin (tree only)
+ * @return Pointer to created broad phase or NULL on failure
+ */
+BroadPhase* broad_phase_create(BroadPhaseType type, float margin);
+
+/**
+ * @brief Destroy broad phase
+ * @param broad_phase Broad phase to destroy
+ */
+void broad_phase_destroy(BroadPhase* broad_phase);
+
+/**
+ * @brief Start tracking an object
+ * @param broad_phase Target broad phase
+ * @param bounds Object bounds
+ * @param user_data Owner reported with each pair
+ * @return Proxy id or BROAD_PHASE_NULL_PROXY on failure
+ */
+int broad_phase_create_proxy(BroadPhase* broad_phase, AABB bounds, void* user_data);
+
+/**
+ * @brief Stop tracking an object
+ * @param broad_phase Target broad phase
+ * @param proxy Proxy id
+ */
+void broad_phase_destroy_proxy(BroadPhase* broad_phase, int proxy);
+
+/**
+ * @brief Update an object's bounds
+ *
+ * The tree only reinserts the leaf when the new bounds leave its fat
+ * bounds; the new fat bounds are stretched along displacement so a body
+ * moving steadily stays in its leaf for several steps.
+ *
+ * @param broad_phase Target broad phase
+ * @param proxy Proxy id
+ * @param bounds New bounds
+ * @param displacement Predicted movement over the next step
+ * @return True if the tree leaf was reinserted
+ */
+bool broad_phase_move_proxy(BroadPhase* broad_phase, int proxy, AABB bounds, Vector3 displacement);
+
+/**
+ * @brief Mark a proxy as sleeping or awake
+ *
+ * Pairs of two sleeping proxies are not reported. The tree skips subtrees
+ * without awake leaves, so a query costs time in proportion to the awake
+ * proxies; sweep-and-prune and brute force still visit every proxy.
+ *
+ * @param broad_phase Target broad phase
+ * @param proxy Proxy id
+ * @param sleeping Whether the proxy sleeps
+ */
+void broad_phase_set_proxy_sleeping(BroadPhase* broad_phase, int proxy, bool sleeping);
+
+/**
+ * @brief Report every pair of proxies whose bounds overlap, once each
+ * @param broad_phase Broad phase to query
+ * @param callback Called with the user data of both proxies
+ * @param context Passed through to callback
+ * @return Number of pairs reported
+ */
+int broad_phase_find_pairs(BroadPhase* broad_phase, BroadPhasePairCallback callback, void* context);
+
+/**
+ * @brief Report the pairs a list of just-woken proxies missed
+ *
+ * broad_phase_find_pairs skips pairs of two sleeping proxies, so after it
+ * wakes some of them the caller asks here for their pairs with each other
+ * and with proxies that still sleep; pairs with proxies that were already
+ * awake were reported by the full query. Costs one bounds query per listed
+ * proxy (a tree descent, or a pass over the proxies for the other
+ * algorithms). Tests and pairs add to the statistics of the last query.
+ *
+ * @param broad_phase Broad phase to query
+ * @param proxies Proxy ids (awake)
+ * @param count Number of proxy ids
+ * @param callback Called with the user data of both proxies
+ * @param context Passed through to callback
+ * @return Number of pairs reported
+ */
+int broad_phase_find_pairs_of(BroadPhase* broad_phase, const int* proxies, int count,
+                              BroadPhasePairCallback callback, void* context);
+
+/**
+ * @brief Name of an algorithm
+ */
+const char* broad_phase_type_name(BroadPhaseType type);
+
+// ============================================================================
+// Bounding Box Utilities
+// ============================================================================
+
+/**
+ * @brief Check if two boxes overlap (touching counts)
+ */
+bool aabb_overlaps(AABB a, AABB b);
+
+/**
+ * @brief Check if outer fully contains inner
+ */
+bool aabb_contains(AABB outer, AABB inner);
+
+/**
+ * @brief Smallest box containing both boxes
+ */
+AABB aabb_union(AABB a, AABB b);
+
+/**
+ * @brief Surface area of a box
+ */
+float aabb_surface_area(AABB box);
+
+#endif // METAVERSE_BROAD_PHASE_H
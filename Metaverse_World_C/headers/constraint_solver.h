@@ -0,0 +1,151 @@
+/*
+ * Metaverse World System - Constraint Solver Header
+ * Island detection and a warm-started sequential-impulse solver for
+ * contacts and joints, with independent islands solved in parallel
+ */
+
+#ifndef METAVERSE_CONSTRAINT_SOLVER_H
+#define METAVERSE_CONSTRAINT_SOLVER_H
+
+#include <stdbool.h>
+#include "physics.h"
+#include "thread_pool.h"
+
+// ============================================================================
+// Solver Constants and Configuration
+// ============================================================================
+
+#define SOLVER_BAUMGARTE 0.2f               // Fraction of position error corrected per step
+#define SOLVER_PENETRATION_SLOP 0.01f       // Penetration left uncorrected so contacts persist (m)
+#define SOLVER_RESTITUTION_THRESHOLD 1.0f   // Approach speed below which contacts do not bounce (m/s)
+#define SOLVER_WARM_START_FACTOR 0.7f       // Fraction of last step's contact impulse reapplied
+#define SOLVER_TASKS_PER_THREAD 4           // Island batches per thread (load balance)
+
+/**
+ * @brief Contact prepared for solving
+ *
+ * Bodies do not rotate in this engine, so every direction has the same
+ * effective mass and friction acts on the whole tangential velocity.
+ */
+typedef struct {
+    int body_a;                     // Store slot of the first body
+    int body_b;                     // Store slot of the second body
+    Vector3 normal;                 // Contact normal (from a to b)
+    float mass;                     // Effective mass 1 / (1/m_a + 1/m_b)
+    float bias;                     // Target separating velocity (penetration recovery, restitution)
+    float friction;                 // Friction coefficient
+    float restitution;              // Bounciness
+    ContactPoint* contact;          // Persistent contact holding the accumulated impulses
+} ContactConstraint;
+
+/**
+ * @brief Joint prepared for solving: keeps the two anchor points together
+ */
+typedef struct {
+    int body_a;                     // Store slot of the first body
+    int body_b;                     // Store slot of the second body
+    float mass;                     // Effective mass
+    Vector3 bias;                   // Velocity that closes the anchor gap
+    Joint* joint;                   // Joint holding the accumulated impulse
+} JointConstraint;
+
+/**
+ * @brief Set of dynamic bodies connected by contacts or joints
+ *
+ * Kinematic and sleeping bodies never join islands: the solver does not
+ * move them, so islands touching the same kinematic body stay
+ * independent. Bodies without contacts or joints are not in any island.
+ */
+typedef struct {
+    int body_start;                 // First entry in island_bodies
+    int body_count;                 // Dynamic bodies
+    int contact_start;              // First contact constraint
+    int contact_count;              // Contact constraints
+    int joint_start;                // First joint constraint
+    int joint_count;                // Joint constraints
+} PhysicsIsland;
+
+/**
+ * @brief Solver state, reused between steps
+ */
+struct ConstraintSolver {
+    ThreadPool* pool;               // Worker pool (NULL = solve on the caller)
+
+    // Constraints grouped by island
+    ContactConstraint* contacts;    // Contact constraints
+    ContactConstraint* scratch;     // Ungrouped contacts while grouping
+    int contact_count;              // Number of contact constraints
+    int contact_capacity;           // Contact capacity
+    JointConstraint* joints;        // Joint constraints
+    JointConstraint* joint_scratch; // Ungrouped joints while grouping
+    int joint_count;                // Number of joint constraints
+    int joint_capacity;             // Joint capacity
+
+    // Islands
+    PhysicsIsland* islands;         // Islands of the last solve (valid until the next)
+    int island_count;               // Number of islands
+    int* island_bodies;             // Store slots grouped by island
+    int* parent;                    // Union-find parent of each store slot (itself outside islands)
+    int* island_of;                 // Island of each store slot in the last solve (-1 = none)
+    int* touched;                   // Constrained dynamic slots, in the order they were reached
+    int touched_count;              // Number of touched slots
+    int slot_capacity;              // Capacity of the per-slot arrays
+
+    // Parallel batches
+    int* task_islands;              // First island of each task (task_count + 1 entries)
+    int task_count;                 // Number of tasks
+};
+
+// ============================================================================
+// Solver Functions
+// ============================================================================
+
+/**
+ * @brief Create constraint solver
+ * @param num_threads Threads solving islands, including the caller (1 = serial, 0 = all cores)
+ * @return Pointer to created solver or NULL on failure
+ */
+ConstraintSolver* constraint_solver_create(int num_threads);
+
+/**
+ * @brief Destroy constraint solver
+ * @param solver Solver to destroy
+ */
+void constraint_solver_destroy(ConstraintSolver* solver);
+
+/**
+ * @brief Change the number of solver threads
+ * @param solver Target solver
+ * @param num_threads Threads including the caller (1 = serial, 0 = all cores)
+ * @return False if the worker pool could not be created (the solver stays serial)
+ */
+bool constraint_solver_set_threads(ConstraintSolver* solver, int num_threads);
+
+/**
+ * @brief Number of threads solving islands
+ */
+int constraint_solver_threads(ConstraintSolver* solver);
+
+/**
+ * @brief Solve the world's contacts and joints for one step
+ *
+ * Runs after velocities are integrated and before positions are:
+ * groups bodies into islands, applies last step's impulses (when
+ * world->warm_starting is set; contacts reapply SOLVER_WARM_START_FACTOR
+ * of theirs) and runs world->max_iterations sequential-impulse
+ * iterations per island. Accumulated impulses are written back to the
+ * contacts and joints for the next step, contacts without the share that
+ * corrected penetration or restitution. Bodies past
+ * store->awake_count are asleep and treated as static; the world wakes
+ * any sleeping island a contact or joint connects to an awake body first.
+ * The islands stay readable until the next solve, so the world can put
+ * resting ones to sleep.
+ *
+ * @param solver Solver
+ * @param world World whose manifolds and joints are solved
+ * @param delta_time Time step
+ * @return False if scratch memory could not be allocated (nothing was solved)
+ */
+bool constraint_solver_solve(ConstraintSolver* solver, PhysicsWorld* world, float delta_time);
+
+#endif // METAVERSE_CONSTRAINT_SOLVER_H
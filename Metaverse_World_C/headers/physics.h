@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "world.h"
+#include "broad_phase.h"
 
 // Forward declarations
 typedef struct RigidBody RigidBody;
@@ -17,6 +18,7 @@ typedef struct Collider Collider;
 typedef struct PhysicsWorld PhysicsWorld;
 typedef struct RaycastHit RaycastHit;
 typedef struct Joint Joint;
+typedef struct ConstraintSolver ConstraintSolver;
 
 // ============================================================================
 // Physics Constants and Configuration
@@ -26,8 +28,11 @@ typedef struct Joint Joint;
 #define PHYSICS_MAX_BODIES 10000
 #define PHYSICS_MAX_COLLIDERS 50000
 #define PHYSICS_MAX_CONSTRAINTS 1000
-#define PHYSICS_FIXED_TIMESTEP 1.0f/60.0f
+#define PHYSICS_FIXED_TIMESTEP (1.0f / 60.0f)
+#define PHYSICS_MAX_SUBSTEPS 4              // Fixed steps one update may run (caps catch-up)
 #define PHYSICS_MAX_ITERATIONS 10
+#define PHYSICS_SLEEP_VELOCITY 0.05f        // Speed below which a body counts as resting (m/s)
+#define PHYSICS_SLEEP_TIME 0.5f             // Rest before an island falls asleep (s)
 
 /**
  * @brief Physics material properties
@@ -67,7 +72,9 @@ struct RigidBody {
     Matrix4x4 inertia_tensor;       // Moment of inertia tensor
     PhysicsMaterial material;       // Material properties
 
-    // State
+    // State (position, linear_velocity and force_accumulator live in the world's
+    // body store while the body is in a world: every step copies them back here,
+    // but write them through the rigid_body_* functions or the step overwrites them)
     Vector3 position;               // Current position
     Quaternion rotation;            // Current rotation
     Vector3 linear_velocity;        // Linear velocity (m/s)
@@ -80,7 +87,9 @@ struct RigidBody {
     // Collision
     Collider* collider;             // Collision shape
     bool kinematic;                 // Whether body is kinematic (unaffected by forces)
-    bool sleeping;                  // Whether body is sleeping (optimization)
+    bool sleeping;                  // Whether body is sleeping (not integrated, collided or solved)
+    RigidBody* sleep_next;          // Next body of the island it fell asleep with (circular, NULL while awake)
+    bool wake_queued;               // Island touched during this step's pair pass, woken after it
 
     // Simulation properties
     float linear_damping;           // Linear velocity damping
@@ -92,8 +101,13 @@ struct RigidBody {
     int joint_count;                // Number of joints
 
     // Performance
-    uint64_t last_updated;          // Last simulation update
+    uint64_t last_updated;          // Last time the fields above were synced from the world
     bool needs_update;              // Whether body needs physics update
+    int broad_phase_proxy;          // Broad phase proxy (BROAD_PHASE_NULL_PROXY outside a world)
+
+    // World storage
+    PhysicsWorld* world;            // World holding the body (NULL outside a world)
+    int store_index;                // Slot in the world's body store
 };
 
 /**
@@ -164,7 +178,8 @@ typedef struct {
     Vector3 point;                  // Contact point in world space
     Vector3 normal;                 // Contact normal
     float penetration;              // Penetration depth
-    float impulse;                  // Applied impulse
+    float impulse;                  // Normal impulse less position correction (warm starts the next step)
+    Vector3 friction_impulse;       // Accumulated friction impulse (tangent plane)
 } ContactPoint;
 
 /**
@@ -262,15 +277,62 @@ struct Joint {
     Vector3 anchor_b;               // Anchor point on body B
 
     // Joint properties
-    bool enabled;                   // Whether joint is active
+    bool enabled;                   // Whether joint is active (cleared when it breaks)
     float break_force;              // Force required to break joint
     float break_torque;             // Torque required to break joint
+
+    // Solver state
+    Vector3 impulse;                // Accumulated constraint impulse (warm starts the next step)
+    PhysicsWorld* world;            // World solving the joint (NULL outside a world)
 };
 
 // ============================================================================
 // Physics World and Simulation
 // ============================================================================
 
+/**
+ * @brief Structure-of-arrays storage of the integrated body state
+ *
+ * Slot i belongs to the world's bodies[i]. Slots stay dense: removing a
+ * body moves the last slot into its place and updates that body's
+ * store_index, so RigidBody* handles stay valid. Kinematic bodies have
+ * zero inverse mass, gravity scale, damping and motion, which keeps the
+ * integrator free of per-body branches. Awake bodies occupy the first
+ * awake_count slots; falling asleep and waking swap a body across that
+ * boundary, so the integrator only runs over [0, awake_count).
+ */
+typedef struct {
+    float* position_x;              // Position
+    float* position_y;
+    float* position_z;
+    float* velocity_x;              // Linear velocity
+    float* velocity_y;
+    float* velocity_z;
+    float* force_x;                 // Accumulated force (cleared every step)
+    float* force_y;
+    float* force_z;
+    float* inverse_mass;            // 1 / mass
+    float* gravity_scale;           // Gravity multiplier
+    float* damping;                 // Linear damping
+    float* motion;                  // 1 if the integrator moves the body, else 0
+    float* sleep_time;              // Time spent below PHYSICS_SLEEP_VELOCITY (s)
+    float* previous_x;              // Position before the last step (interpolation)
+    float* previous_y;
+    float* previous_z;
+    int count;                      // Occupied slots (== body_count)
+    int awake_count;                // Awake slots, all before the sleeping ones
+    int capacity;                   // Allocated slots (== max_bodies)
+} RigidBodyStore;
+
+/**
+ * @brief Instruction set used by the body integrator
+ */
+typedef enum {
+    PHYSICS_KERNEL_SCALAR,          // Portable C, one body at a time
+    PHYSICS_KERNEL_AVX2,            // AVX2 + FMA, 8 bodies
+    PHYSICS_KERNEL_AVX512           // AVX-512F, 16 bodies
+} PhysicsKernel;
+
 /**
  * @brief Physics simulation world
  */
@@ -279,6 +341,7 @@ struct PhysicsWorld {
     RigidBody** bodies;             // Array of rigid bodies
     int body_count;                 // Number of bodies
     int max_bodies;                 // Maximum bodies
+    RigidBodyStore store;           // Integrated state of bodies[i] in slot i
 
     Collider** colliders;           // Array of colliders
     int collider_count;             // Number of colliders
@@ -287,21 +350,47 @@ struct PhysicsWorld {
     // Simulation settings
     Vector3 gravity;                // Gravity vector
     float fixed_timestep;           // Fixed simulation timestep
+    int max_substeps;               // Fixed steps one update may run; older frame time is dropped
+    float accumulator;              // Frame time not simulated yet (below fixed_timestep after an update)
     int max_iterations;             // Maximum solver iterations
     bool paused;                    // Whether simulation is paused
+    bool allow_sleeping;            // Put resting islands to sleep (clearing it wakes every body)
 
-    // Collision detection
-    CollisionManifold* manifolds;   // Collision manifolds
+    // Collision detection (manifolds persist per body pair: each step looks up
+    // last step's manifold of the same pair to warm start the solver)
+    CollisionManifold* manifolds;   // Collision manifolds of this step
+    ContactPoint* contact_points;   // Contact storage, one per manifold
     int manifold_count;             // Number of manifolds
-    int max_manifolds;              // Maximum manifolds
+    int max_manifolds;              // Manifold capacity (grows as needed)
+    CollisionManifold* previous_manifolds;    // Last step's manifolds
+    ContactPoint* previous_contact_points;    // Last step's contacts
+    int previous_manifold_count;    // Number of last step's manifolds
+    int* manifold_table;            // Body pair -> last step's manifold (open addressing)
+    int manifold_table_size;        // Table slots (power of two)
+
+    // Sleeping islands touched by the pair pass wake after it, so the broad
+    // phase never sees its sleeping flags change mid-query
+    RigidBody** wake_queue;         // One body per island to wake
+    int wake_count;                 // Queued islands
+    int* woken_proxies;             // Broad phase proxies of the bodies woken by the last drain
+
+    // Constraint solving
+    Joint** joints;                 // Joints solved with the contacts
+    int joint_count;                // Number of joints
+    int max_joints;                 // Joint capacity (grows as needed)
+    ConstraintSolver* solver;       // Island solver and its worker pool
+    bool warm_starting;             // Start from last step's impulses
 
     // Performance metrics
     float simulation_time;          // Time spent in simulation
-    int collision_checks;           // Number of collision checks
+    int collision_checks;           // Narrow phase tests (pairs the broad phase reported)
     int constraints_solved;         // Number of constraints solved
+    int island_count;               // Islands of dynamic bodies in the last step
+    int substeps;                   // Fixed steps run by the last update
+    float interpolation_alpha;      // accumulator / fixed_timestep after the last update
 
     // Broad phase acceleration
-    void* broad_phase;              // Broad phase collision detection
+    BroadPhase* broad_phase;        // Broad phase collision detection
     void* narrow_phase;             // Narrow phase collision detection
 
     // Callbacks
@@ -329,14 +418,112 @@ PhysicsWorld* physics_world_create(Vector3 gravity, int max_bodies, int max_coll
 void physics_world_destroy(PhysicsWorld* world);
 
 /**
- * @brief Update physics simulation
+ * @brief Advance physics simulation by a frame's worth of time
+ *
+ * Frame time is added to world->accumulator and simulated in fixed steps
+ * of world->fixed_timestep: zero or more per call, so the result does not
+ * depend on the frame rate. At most world->max_substeps steps run per
+ * call; frame time beyond that (a hitch) is dropped rather than caught up
+ * later. The time left over sets world->interpolation_alpha for
+ * rigid_body_get_interpolated_position and friends.
+ *
+ * Islands whose bodies have all moved slower than PHYSICS_SLEEP_VELOCITY
+ * for PHYSICS_SLEEP_TIME fall asleep: they are skipped by the integrator,
+ * the broad phase and the solver until an awake body touches them, a
+ * joint connects them to an awake body, or a force, impulse, velocity or
+ * position is applied to one of their bodies.
+ *
  * @param world Physics world to update
  * @param delta_time Time elapsed since last update
  */
 void physics_world_update(PhysicsWorld* world, float delta_time);
 
+/**
+ * @brief Run one simulation step of the given length
+ *
+ * The step physics_world_update runs per fixed timestep, for callers that
+ * drive the clock themselves (e.g. a server tick). Ignores paused and the
+ * accumulator; positions before the step are kept for interpolation.
+ * The bodies that moved get position, velocity and force copied back
+ * from the body store into their fields.
+ *
+ * @param world Physics world to step
+ * @param delta_time Step length (s)
+ */
+void physics_world_step(PhysicsWorld* world, float delta_time);
+
+/**
+ * @brief Integrate gravity, forces and damping into velocities and positions
+ *
+ * The integration part of physics_world_update, run over the awake slots
+ * of the body store with the widest available kernel. Clears the
+ * accumulated forces. The
+ * update runs the constraint solver between the velocity and position
+ * halves; this function runs both halves back to back.
+ *
+ * @param world Physics world to integrate
+ * @param delta_time Time step
+ */
+void physics_world_integrate(PhysicsWorld* world, float delta_time);
+
+/**
+ * @brief Copy position, velocity and force from the body store into every body's fields
+ *
+ * Steps already do this for the bodies they move; needed after
+ * physics_world_integrate, which leaves the fields alone.
+ *
+ * @param world Physics world to sync
+ */
+void physics_world_sync_bodies(PhysicsWorld* world);
+
+/**
+ * @brief Kernel selected for this CPU (the widest supported)
+ */
+PhysicsKernel physics_get_kernel(void);
+
+/**
+ * @brief Force an integrator kernel (accuracy testing and benchmarking)
+ * @return False if the CPU does not support it
+ */
+bool physics_set_kernel(PhysicsKernel kernel);
+
+/**
+ * @brief Printable kernel name
+ */
+const char* physics_kernel_name(PhysicsKernel kernel);
+
+/**
+ * @brief Switch the broad phase algorithm
+ *
+ * Bodies are woken and re-registered with the new broad phase on the
+ * next update.
+ *
+ * @param world Target physics world
+ * @param type Broad phase algorithm (the default is BROAD_PHASE_AABB_TREE)
+ * @return True if switched successfully
+ */
+bool physics_world_set_broad_phase(PhysicsWorld* world, BroadPhaseType type);
+
+/**
+ * @brief Set the number of threads solving islands
+ *
+ * Islands (groups of bodies connected by contacts or joints) are solved
+ * independently; with more than one thread they are spread over a worker
+ * pool owned by the world.
+ *
+ * @param world Target physics world
+ * @param num_threads Threads including the caller (1 = serial, the default; 0 = all cores)
+ * @return False if the worker pool could not be created (the solver stays serial)
+ */
+bool physics_world_set_threads(PhysicsWorld* world, int num_threads);
+
 /**
  * @brief Add rigid body to physics world
+ *
+ * The body's position, velocity and force move into the world's body
+ * store; physics_world_remove_body copies them back. Bodies enter the
+ * world awake.
+ *
  * @param world Target physics world
  * @param body Rigid body to add
  * @return Success status
@@ -345,12 +532,31 @@ bool physics_world_add_body(PhysicsWorld* world, RigidBody* body);
 
 /**
  * @brief Remove rigid body from physics world
+ *
+ * Wakes the island the body was sleeping in, so bodies resting on it fall.
+ *
  * @param world Target physics world
  * @param body Rigid body to remove
  * @return Success status
  */
 bool physics_world_remove_body(PhysicsWorld* world, RigidBody* body);
 
+/**
+ * @brief Add joint to physics world so the solver enforces it (wakes both bodies)
+ * @param world Target physics world
+ * @param joint Joint to add (both bodies should be in the world)
+ * @return Success status
+ */
+bool physics_world_add_joint(PhysicsWorld* world, Joint* joint);
+
+/**
+ * @brief Remove joint from physics world (wakes both bodies)
+ * @param world Target physics world
+ * @param joint Joint to remove
+ * @return Success status
+ */
+bool physics_world_remove_joint(PhysicsWorld* world, Joint* joint);
+
 /**
  * @brief Add collider to physics world
  * @param world Target physics world
@@ -381,6 +587,11 @@ bool physics_world_raycast(PhysicsWorld* world, Vector3 origin, Vector3 directio
 
 /**
  * @brief Check collision between two colliders
+ *
+ * Handles sphere-sphere, sphere-box and box-box pairs. Bodies do not
+ * rotate, so boxes are axis-aligned. The contact normal points from
+ * collider_a to collider_b.
+ *
  * @param collider_a First collider
  * @param collider_b Second collider
  * @param manifold Output collision manifold
@@ -432,7 +643,7 @@ void rigid_body_apply_impulse(RigidBody* body, Vector3 impulse, Vector3 world_po
 void rigid_body_apply_torque(RigidBody* body, Vector3 torque);
 
 /**
- * @brief Set rigid body position
+ * @brief Set rigid body position (teleports: interpolation does not blend across it)
  * @param body Target rigid body
  * @param position New position
  */
@@ -448,18 +659,108 @@ void rigid_body_set_rotation(RigidBody* body, Quaternion rotation);
 /**
  * @brief Get rigid body transform matrix
  * @param body Target rigid body
- * @return Transform matrix
+ * @return Rotation and position, row-major with the translation in the last column
  */
 Matrix4x4 rigid_body_get_transform(RigidBody* body);
 
 /**
- * @brief Put rigid body to sleep (optimization)
+ * @brief Get rigid body position between the last two steps
+ *
+ * Rendering and network sync read this with world->interpolation_alpha:
+ * it trails the simulation by at most one fixed step but moves smoothly
+ * whatever the frame rate.
+ *
+ * @param body Rigid body
+ * @param alpha Blend from the position before the last step (0) to the current one (1)
+ * @return Interpolated position (the position itself outside a world)
+ */
+Vector3 rigid_body_get_interpolated_position(RigidBody* body, float alpha);
+
+/**
+ * @brief Get rigid body transform matrix between the last two steps
+ *
+ * Bodies do not rotate, so only the translation is interpolated.
+ *
+ * @param body Target rigid body
+ * @param alpha Blend from the position before the last step (0) to the current one (1)
+ * @return Transform matrix laid out as rigid_body_get_transform
+ */
+Matrix4x4 rigid_body_get_interpolated_transform(RigidBody* body, float alpha);
+
+/**
+ * @brief Get rigid body position
+ * @param body Rigid body
+ * @return Current position (from the body store while in a world)
+ */
+Vector3 rigid_body_get_position(RigidBody* body);
+
+/**
+ * @brief Get rigid body linear velocity
+ * @param body Rigid body
+ * @return Current linear velocity
+ */
+Vector3 rigid_body_get_velocity(RigidBody* body);
+
+/**
+ * @brief Set rigid body linear velocity
+ * @param body Target rigid body
+ * @param velocity New linear velocity
+ */
+void rigid_body_set_velocity(RigidBody* body, Vector3 velocity);
+
+/**
+ * @brief Set rigid body mass
+ * @param body Target rigid body
+ * @param mass New mass in kg (must be positive)
+ */
+void rigid_body_set_mass(RigidBody* body, float mass);
+
+/**
+ * @brief Make rigid body kinematic (unaffected by forces) or dynamic
+ * @param body Target rigid body
+ * @param kinematic Whether the body is kinematic
+ */
+void rigid_body_set_kinematic(RigidBody* body, bool kinematic);
+
+/**
+ * @brief Set rigid body damping
+ * @param body Target rigid body
+ * @param linear_damping Linear velocity damping
+ * @param angular_damping Angular velocity damping
+ */
+void rigid_body_set_damping(RigidBody* body, float linear_damping, float angular_damping);
+
+/**
+ * @brief Set rigid body gravity multiplier
+ * @param body Target rigid body
+ * @param gravity_scale Gravity multiplier
+ */
+void rigid_body_set_gravity_scale(RigidBody* body, float gravity_scale);
+
+/**
+ * @brief Get rigid body's world-space bounds
+ * @param body Rigid body
+ * @return Collider bounds moved to the body position (empty box at the position without a collider)
+ */
+AABB rigid_body_get_bounds(RigidBody* body);
+
+/**
+ * @brief Put rigid body to sleep
+ *
+ * Clears its velocity. In a world the body stops being integrated,
+ * collided and solved until it is woken; the world also puts resting
+ * islands to sleep on its own (see physics_world_update).
+ *
  * @param body Target rigid body
  */
 void rigid_body_sleep(RigidBody* body);
 
 /**
- * @brief Wake up rigid body
+ * @brief Wake up rigid body, together with the island it fell asleep with
+ *
+ * Applying a force or impulse, or setting a velocity or position, wakes
+ * the body as well.
+ *
  * @param body Target rigid body
  */
 void rigid_body_wake(RigidBody* body);
@@ -523,6 +824,10 @@ void collider_get_bounds(Collider* collider, Vector3* min, Vector3* max);
 // Joint Functions
 // ============================================================================
 
+// Bodies do not rotate, so every joint type below is solved as a point
+// constraint that keeps the two anchors together; axes and angle limits
+// are stored for when angular motion is simulated.
+
 /**
  * @brief Create fixed joint
  * @param body_a First body
@@ -0,0 +1,60 @@
+/*
+ * Metaverse World System - Thread Pool Header
+ * Persistent worker pool used by the physics solver to process
+ * independent simulation islands in parallel
+ */
+
+#ifndef METAVERSE_THREAD_POOL_H
+#define METAVERSE_THREAD_POOL_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Opaque persistent thread pool
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief Parallel task body
+ * @param context User context shared by all tasks
+ * @param index Task index in [0, count)
+ * @param thread_id Executing thread in [0, thread_pool_size)
+ */
+typedef void (*ThreadPoolTask)(void* context, int index, int thread_id);
+
+/**
+ * @brief Create a thread pool
+ * @param num_threads Total threads including the caller (0 = all cores)
+ * @return Created pool or NULL on failure
+ */
+ThreadPool* thread_pool_create(int num_threads);
+
+/**
+ * @brief Stop workers and destroy the pool
+ * @param pool Pool to destroy
+ */
+void thread_pool_destroy(ThreadPool* pool);
+
+/**
+ * @brief Get number of threads (workers plus the calling thread)
+ * @param pool Thread pool (NULL counts as one thread)
+ * @return Thread count
+ */
+int thread_pool_size(ThreadPool* pool);
+
+/**
+ * @brief Run task(context, i, thread) for every i in [0, count) and wait
+ * @param pool Thread pool (NULL runs serially on the caller)
+ * @param count Number of tasks
+ * @param task Task body
+ * @param context User context passed to every task
+ */
+void thread_pool_parallel_for(ThreadPool* pool, int count, ThreadPoolTask task, void* context);
+
+/**
+ * @brief Get number of online CPU cores
+ * @return Core count (at least 1)
+ */
+int thread_pool_hardware_threads(void);
+
+#endif // METAVERSE_THREAD_POOL_H
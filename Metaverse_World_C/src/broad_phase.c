@@ -0,0 +1,778 @@
+/*
+ * Metaverse World System - Broad Phase Collision Implementation
+ * Brute force, incremental sweep-and-prune and dynamic AABB tree
+ * pair finding over world-space bounding boxes
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/broad_phase.h"
+
+#define BROAD_PHASE_INITIAL_CAPACITY 64
+#define BROAD_PHASE_AXIS_SWITCH_RATIO 2.0f // Spread another axis needs before re-sorting along it
+
+// ============================================================================
+// Bounding Box Utilities
+// ============================================================================
+
+bool aabb_overlaps(AABB a, AABB b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+bool aabb_contains(AABB outer, AABB inner) {
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+           outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+AABB aabb_union(AABB a, AABB b) {
+    AABB result;
+    result.min = vector3_create(fminf(a.min.x, b.min.x), fminf(a.min.y, b.min.y), fminf(a.min.z, b.min.z));
+    result.max = vector3_create(fmaxf(a.max.x, b.max.x), fmaxf(a.max.y, b.max.y), fmaxf(a.max.z, b.max.z));
+    return result;
+}
+
+float aabb_surface_area(AABB box) {
+    float dx = box.max.x - box.min.x;
+    float dy = box.max.y - box.min.y;
+    float dz = box.max.z - box.min.z;
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+static float axis_component(Vector3 v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+// Grow a box by margin, then stretch it along the predicted displacement
+static AABB fatten_bounds(AABB bounds, float margin, Vector3 displacement) {
+    AABB fat;
+    fat.min = vector3_create(bounds.min.x - margin, bounds.min.y - margin, bounds.min.z - margin);
+    fat.max = vector3_create(bounds.max.x + margin, bounds.max.y + margin, bounds.max.z + margin);
+
+    Vector3 d = vector3_multiply(displacement, BROAD_PHASE_DISPLACEMENT_SCALE);
+    if (d.x < 0) fat.min.x += d.x; else fat.max.x += d.x;
+    if (d.y < 0) fat.min.y += d.y; else fat.max.y += d.y;
+    if (d.z < 0) fat.min.z += d.z; else fat.max.z += d.z;
+
+    return fat;
+}
+
+// ============================================================================
+// Dynamic AABB Tree
+// ============================================================================
+
+static bool tree_is_leaf(const BroadPhaseNode* node) {
+    return node->left == BROAD_PHASE_NULL_NODE;
+}
+
+static int tree_allocate_node(BroadPhase* broad_phase) {
+    if (broad_phase->free_node == BROAD_PHASE_NULL_NODE) {
+        int old_capacity = broad_phase->node_capacity;
+        int new_capacity = old_capacity > 0 ? old_capacity * 2 : BROAD_PHASE_INITIAL_CAPACITY;
+        BroadPhaseNode* nodes = (BroadPhaseNode*)realloc(broad_phase->nodes,
+            (size_t)new_capacity * sizeof(BroadPhaseNode));
+        if (!nodes) return BROAD_PHASE_NULL_NODE;
+
+        // Chain the new nodes into the free list
+        for (int i = old_capacity; i < new_capacity; i++) {
+            nodes[i].parent = i + 1 < new_capacity ? i + 1 : BROAD_PHASE_NULL_NODE;
+            nodes[i].height = -1;
+        }
+        broad_phase->nodes = nodes;
+        broad_phase->node_capacity = new_capacity;
+        broad_phase->free_node = old_capacity;
+    }
+
+    int index = broad_phase->free_node;
+    BroadPhaseNode* node = &broad_phase->nodes[index];
+    broad_phase->free_node = node->parent;
+
+    node->parent = BROAD_PHASE_NULL_NODE;
+    node->left = BROAD_PHASE_NULL_NODE;
+    node->right = BROAD_PHASE_NULL_NODE;
+    node->height = 0;
+    node->proxy = BROAD_PHASE_NULL_PROXY;
+    node->awake = true;
+    return index;
+}
+
+static void tree_free_node(BroadPhase* broad_phase, int index) {
+    broad_phase->nodes[index].parent = broad_phase->free_node;
+    broad_phase->nodes[index].height = -1;
+    broad_phase->free_node = index;
+}
+
+static void tree_refit(BroadPhaseNode* nodes, int index) {
+    BroadPhaseNode* node = &nodes[index];
+    BroadPhaseNode* left = &nodes[node->left];
+    BroadPhaseNode* right = &nodes[node->right];
+    node->height = 1 + (left->height > right->height ? left->height : right->height);
+    node->bounds = aabb_union(left->bounds, right->bounds);
+    node->awake = left->awake || right->awake;
+}
+
+// Replace child old_child of parent (or the root) with new_child
+static void tree_replace_child(BroadPhase* broad_phase, int parent, int old_child, int new_child) {
+    if (parent == BROAD_PHASE_NULL_NODE) {
+        broad_phase->root = new_child;
+    } else if (broad_phase->nodes[parent].left == old_child) {
+        broad_phase->nodes[parent].left = new_child;
+    } else {
+        broad_phase->nodes[parent].right = new_child;
+    }
+}
+
+/**
+ * Rotate the taller grandchild of node a up if the children's heights
+ * differ by more than one. Returns the node now at a's place.
+ */
+static int tree_balance(BroadPhase* broad_phase, int ia) {
+    BroadPhaseNode* nodes = broad_phase->nodes;
+    BroadPhaseNode* a = &nodes[ia];
+    if (tree_is_leaf(a) || a->height < 2) return ia;
+
+    int ib = a->left;
+    int ic = a->right;
+    BroadPhaseNode* b = &nodes[ib];
+    BroadPhaseNode* c = &nodes[ic];
+    int balance = c->height - b->height;
+
+    if (balance > 1) {
+        // Rotate c up
+        int i_f = c->left;
+        int i_g = c->right;
+        BroadPhaseNode* f = &nodes[i_f];
+        BroadPhaseNode* g = &nodes[i_g];
+
+        c->left = ia;
+        c->parent = a->parent;
+        a->parent = ic;
+        tree_replace_child(broad_phase, c->parent, ia, ic);
+
+        if (f->height > g->height) {
+            c->right = i_f;
+            a->right = i_g;
+            g->parent = ia;
+        } else {
+            c->right = i_g;
+            a->right = i_f;
+            f->parent = ia;
+        }
+        tree_refit(nodes, ia);
+        tree_refit(nodes, ic);
+        return ic;
+    }
+
+    if (balance < -1) {
+        // Rotate b up
+        int id = b->left;
+        int ie = b->right;
+        BroadPhaseNode* d = &nodes[id];
+        BroadPhaseNode* e = &nodes[ie];
+
+        b->left = ia;
+        b->parent = a->parent;
+        a->parent = ib;
+        tree_replace_child(broad_phase, b->parent, ia, ib);
+
+        if (d->height > e->height) {
+            b->right = id;
+            a->left = ie;
+            e->parent = ia;
+        } else {
+            b->right = ie;
+            a->left = id;
+            d->parent = ia;
+        }
+        tree_refit(nodes, ia);
+        tree_refit(nodes, ib);
+        return ib;
+    }
+
+    return ia;
+}
+
+// Refit and rebalance from index up to the root
+static void tree_fix_upwards(BroadPhase* broad_phase, int index) {
+    while (index != BROAD_PHASE_NULL_NODE) {
+        index = tree_balance(broad_phase, index);
+        tree_refit(broad_phase->nodes, index);
+        index = broad_phase->nodes[index].parent;
+    }
+}
+
+// Cost of descending into child when inserting leaf_bounds (surface area heuristic)
+static float tree_descend_cost(const BroadPhaseNode* child, AABB leaf_bounds, float inheritance_cost) {
+    float area = aabb_surface_area(aabb_union(leaf_bounds, child->bounds));
+    if (!tree_is_leaf(child)) {
+        area -= aabb_surface_area(child->bounds);
+    }
+    return area + inheritance_cost;
+}
+
+static bool tree_insert_leaf(BroadPhase* broad_phase, int leaf) {
+    if (broad_phase->root == BROAD_PHASE_NULL_NODE) {
+        broad_phase->root = leaf;
+        broad_phase->nodes[leaf].parent = BROAD_PHASE_NULL_NODE;
+        return true;
+    }
+
+    // Allocate the new parent first; the pool may move
+    int new_parent = tree_allocate_node(broad_phase);
+    if (new_parent == BROAD_PHASE_NULL_NODE) return false;
+    BroadPhaseNode* nodes = broad_phase->nodes;
+
+    // Find the cheapest sibling
+    AABB leaf_bounds = nodes[leaf].bounds;
+    int index = broad_phase->root;
+    while (!tree_is_leaf(&nodes[index])) {
+        float area = aabb_surface_area(nodes[index].bounds);
+        float combined_area = aabb_surface_area(aabb_union(nodes[index].bounds, leaf_bounds));
+
+        // Cost of pairing the leaf with this node, and the minimum cost pushed down to children
+        float cost = 2.0f * combined_area;
+        float inheritance_cost = 2.0f * (combined_area - area);
+
+        float cost_left = tree_descend_cost(&nodes[nodes[index].left], leaf_bounds, inheritance_cost);
+        float cost_right = tree_descend_cost(&nodes[nodes[index].right], leaf_bounds, inheritance_cost);
+
+        if (cost < cost_left && cost < cost_right) break;
+        index = cost_left < cost_right ? nodes[index].left : nodes[index].right;
+    }
+
+    // Join the sibling and the leaf under the new parent
+    int sibling = index;
+    int old_parent = nodes[sibling].parent;
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].bounds = aabb_union(leaf_bounds, nodes[sibling].bounds);
+    nodes[new_parent].height = nodes[sibling].height + 1;
+    nodes[new_parent].left = sibling;
+    nodes[new_parent].right = leaf;
+    tree_replace_child(broad_phase, old_parent, sibling, new_parent);
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    tree_fix_upwards(broad_phase, new_parent);
+    return true;
+}
+
+static void tree_remove_leaf(BroadPhase* broad_phase, int leaf) {
+    if (leaf == broad_phase->root) {
+        broad_phase->root = BROAD_PHASE_NULL_NODE;
+        return;
+    }
+
+    BroadPhaseNode* nodes = broad_phase->nodes;
+    int parent = nodes[leaf].parent;
+    int grand_parent = nodes[parent].parent;
+    int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    // The sibling takes the parent's place
+    tree_replace_child(broad_phase, grand_parent, parent, sibling);
+    nodes[sibling].parent = grand_parent;
+    tree_free_node(broad_phase, parent);
+
+    tree_fix_upwards(broad_phase, grand_parent);
+}
+
+static bool tree_reserve_stack(BroadPhase* broad_phase, int size) {
+    if (size <= broad_phase->stack_capacity) return true;
+
+    int capacity = broad_phase->stack_capacity > 0 ? broad_phase->stack_capacity : BROAD_PHASE_INITIAL_CAPACITY;
+    while (capacity < size) capacity *= 2;
+
+    int* stack = (int*)realloc(broad_phase->stack, (size_t)capacity * sizeof(int));
+    if (!stack) return false;
+    broad_phase->stack = stack;
+    broad_phase->stack_capacity = capacity;
+    return true;
+}
+
+static int tree_find_pairs(BroadPhase* broad_phase, BroadPhasePairCallback callback, void* context) {
+    int pairs = 0;
+    uint64_t tests = 0;
+
+    // Descend the tree against itself; entries are node pairs and (n, n) stands for every pair inside n
+    int top = 0;
+    if (!tree_reserve_stack(broad_phase, 2)) return 0;
+    broad_phase->stack[top++] = broad_phase->root;
+    broad_phase->stack[top++] = broad_phase->root;
+
+    while (top > 0) {
+        if (!tree_reserve_stack(broad_phase, top + 6)) break;
+        int* stack = broad_phase->stack;
+        const BroadPhaseNode* nodes = broad_phase->nodes;
+
+        int ib = stack[--top];
+        int ia = stack[--top];
+        const BroadPhaseNode* a = &nodes[ia];
+        const BroadPhaseNode* b = &nodes[ib];
+
+        // Nothing awake on either side: every pair in here sleeps
+        if (!a->awake && !b->awake) continue;
+
+        if (ia == ib) {
+            if (tree_is_leaf(a)) continue;
+            stack[top++] = a->left;  stack[top++] = a->left;
+            stack[top++] = a->right; stack[top++] = a->right;
+            stack[top++] = a->left;  stack[top++] = a->right;
+            continue;
+        }
+
+        tests++;
+        if (!aabb_overlaps(a->bounds, b->bounds)) continue;
+
+        if (tree_is_leaf(a) && tree_is_leaf(b)) {
+            // Fat leaves overlap; report only if the tight bounds do too
+            const BroadPhaseProxy* proxy_a = &broad_phase->proxies[a->proxy];
+            const BroadPhaseProxy* proxy_b = &broad_phase->proxies[b->proxy];
+            tests++;
+            if (aabb_overlaps(proxy_a->bounds, proxy_b->bounds)) {
+                callback(proxy_a->user_data, proxy_b->user_data, context);
+                pairs++;
+            }
+        } else if (tree_is_leaf(b) || (!tree_is_leaf(a) && a->height >= b->height)) {
+            // Split the taller subtree
+            stack[top++] = a->left;  stack[top++] = ib;
+            stack[top++] = a->right; stack[top++] = ib;
+        } else {
+            stack[top++] = ia; stack[top++] = b->left;
+            stack[top++] = ia; stack[top++] = b->right;
+        }
+    }
+
+    broad_phase->bounds_tests = tests;
+    return pairs;
+}
+
+/**
+ * Report the pairs of one listed proxy whose partner sleeps or comes later
+ * in the list (the caller unlists each proxy once it is done)
+ */
+static int tree_find_pairs_of(BroadPhase* broad_phase, int proxy_id, BroadPhasePairCallback callback,
+                              void* context) {
+    const BroadPhaseProxy* proxy = &broad_phase->proxies[proxy_id];
+    int pairs = 0;
+    uint64_t tests = 0;
+
+    int top = 0;
+    if (!tree_reserve_stack(broad_phase, 1)) return 0;
+    broad_phase->stack[top++] = broad_phase->root;
+
+    while (top > 0) {
+        if (!tree_reserve_stack(broad_phase, top + 2)) break;
+        const BroadPhaseNode* node = &broad_phase->nodes[broad_phase->stack[--top]];
+
+        tests++;
+        if (!aabb_overlaps(node->bounds, proxy->bounds)) continue;
+
+        if (!tree_is_leaf(node)) {
+            broad_phase->stack[top++] = node->left;
+            broad_phase->stack[top++] = node->right;
+            continue;
+        }
+
+        const BroadPhaseProxy* other = &broad_phase->proxies[node->proxy];
+        if (node->proxy == proxy_id || (!other->sleeping && !other->listed)) continue;
+        tests++;
+        if (aabb_overlaps(proxy->bounds, other->bounds)) {
+            callback(proxy->user_data, other->user_data, context);
+            pairs++;
+        }
+    }
+
+    broad_phase->bounds_tests += tests;
+    return pairs;
+}
+
+// ============================================================================
+// Sweep and Prune
+// ============================================================================
+
+static int compare_intervals(const void* a, const void* b) {
+    float min_a = ((const BroadPhaseInterval*)a)->min;
+    float min_b = ((const BroadPhaseInterval*)b)->min;
+    return (min_a > min_b) - (min_a < min_b);
+}
+
+// Sort along the axis with the widest spread of centers, switching only when clearly better
+static bool sap_choose_axis(BroadPhase* broad_phase) {
+    int count = broad_phase->interval_count;
+    if (count < 2) return false;
+
+    double sum[3] = {0, 0, 0};
+    double sum_squares[3] = {0, 0, 0};
+    for (int i = 0; i < count; i++) {
+        const AABB* bounds = &broad_phase->proxies[broad_phase->intervals[i].proxy].bounds;
+        double center[3] = {
+            0.5 * (bounds->min.x + bounds->max.x),
+            0.5 * (bounds->min.y + bounds->max.y),
+            0.5 * (bounds->min.z + bounds->max.z)
+        };
+        for (int axis = 0; axis < 3; axis++) {
+            sum[axis] += center[axis];
+            sum_squares[axis] += center[axis] * center[axis];
+        }
+    }
+
+    double variance[3];
+    int best = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        variance[axis] = sum_squares[axis] - sum[axis] * sum[axis] / count;
+        if (variance[axis] > variance[best]) best = axis;
+    }
+
+    if (best != broad_phase->sort_axis &&
+        variance[best] > BROAD_PHASE_AXIS_SWITCH_RATIO * variance[broad_phase->sort_axis]) {
+        broad_phase->sort_axis = best;
+        return true;
+    }
+    return false;
+}
+
+static int sap_find_pairs(BroadPhase* broad_phase, BroadPhasePairCallback callback, void* context) {
+    BroadPhaseInterval* intervals = broad_phase->intervals;
+    int count = broad_phase->interval_count;
+    bool axis_changed = sap_choose_axis(broad_phase);
+    int axis = broad_phase->sort_axis;
+
+    // Refresh the intervals from the current bounds
+    for (int i = 0; i < count; i++) {
+        intervals[i].bounds = broad_phase->proxies[intervals[i].proxy].bounds;
+        intervals[i].sleeping = broad_phase->proxies[intervals[i].proxy].sleeping;
+        intervals[i].min = axis_component(intervals[i].bounds.min, axis);
+        intervals[i].max = axis_component(intervals[i].bounds.max, axis);
+    }
+
+    if (axis_changed) {
+        qsort(intervals, (size_t)count, sizeof(BroadPhaseInterval), compare_intervals);
+    } else {
+        // Bodies move little per step, so last step's order is nearly sorted
+        for (int i = 1; i < count; i++) {
+            BroadPhaseInterval key = intervals[i];
+            int j = i - 1;
+            while (j >= 0 && intervals[j].min > key.min) {
+                intervals[j + 1] = intervals[j];
+                j--;
+            }
+            intervals[j + 1] = key;
+        }
+    }
+
+    // Sweep: each interval against the following ones that start before it ends
+    int pairs = 0;
+    uint64_t tests = 0;
+    for (int i = 0; i < count; i++) {
+        const BroadPhaseInterval* a = &intervals[i];
+
+        for (int j = i + 1; j < count && intervals[j].min <= a->max; j++) {
+            if (a->sleeping && intervals[j].sleeping) continue;
+            tests++;
+            if (aabb_overlaps(a->bounds, intervals[j].bounds)) {
+                callback(broad_phase->proxies[a->proxy].user_data,
+                         broad_phase->proxies[intervals[j].proxy].user_data, context);
+                pairs++;
+            }
+        }
+    }
+
+    broad_phase->bounds_tests = tests;
+    return pairs;
+}
+
+// ============================================================================
+// Brute Force
+// ============================================================================
+
+static int brute_force_find_pairs(BroadPhase* broad_phase, BroadPhasePairCallback callback, void* context) {
+    int pairs = 0;
+    uint64_t tests = 0;
+
+    for (int i = 0; i < broad_phase->proxy_count; i++) {
+        const BroadPhaseProxy* proxy_a = &broad_phase->proxies[i];
+        if (!proxy_a->active) continue;
+
+        for (int j = i + 1; j < broad_phase->proxy_count; j++) {
+            const BroadPhaseProxy* proxy_b = &broad_phase->proxies[j];
+            if (!proxy_b->active || (proxy_a->sleeping && proxy_b->sleeping)) continue;
+
+            tests++;
+            if (aabb_overlaps(proxy_a->bounds, proxy_b->bounds)) {
+                callback(proxy_a->user_data, proxy_b->user_data, context);
+                pairs++;
+            }
+        }
+    }
+
+    broad_phase->bounds_tests = tests;
+    return pairs;
+}
+
+// Same as tree_find_pairs_of, testing every proxy (sweep-and-prune and brute force)
+static int scan_find_pairs_of(BroadPhase* broad_phase, int proxy_id, BroadPhasePairCallback callback,
+                              void* context) {
+    const BroadPhaseProxy* proxy = &broad_phase->proxies[proxy_id];
+    int pairs = 0;
+    uint64_t tests = 0;
+
+    for (int i = 0; i < broad_phase->proxy_count; i++) {
+        const BroadPhaseProxy* other = &broad_phase->proxies[i];
+        if (i == proxy_id || !other->active || (!other->sleeping && !other->listed)) continue;
+
+        tests++;
+        if (aabb_overlaps(proxy->bounds, other->bounds)) {
+            callback(proxy->user_data, other->user_data, context);
+            pairs++;
+        }
+    }
+
+    broad_phase->bounds_tests += tests;
+    return pairs;
+}
+
+// ============================================================================
+// Broad Phase Implementation
+// ============================================================================
+
+BroadPhase* broad_phase_create(BroadPhaseType type, float margin) {
+    BroadPhase* broad_phase = (BroadPhase*)calloc(1, sizeof(BroadPhase));
+    if (!broad_phase) return NULL;
+
+    broad_phase->type = type;
+    broad_phase->margin = margin;
+
+    broad_phase->free_proxy = BROAD_PHASE_NULL_PROXY;
+    broad_phase->free_node = BROAD_PHASE_NULL_NODE;
+    broad_phase->root = BROAD_PHASE_NULL_NODE;
+    broad_phase->sort_axis = 0;
+
+    return broad_phase;
+}
+
+void broad_phase_destroy(BroadPhase* broad_phase) {
+    if (!broad_phase) return;
+
+    free(broad_phase->proxies);
+    free(broad_phase->intervals);
+    free(broad_phase->nodes);
+    free(broad_phase->stack);
+    free(broad_phase);
+}
+
+int broad_phase_create_proxy(BroadPhase* broad_phase, AABB bounds, void* user_data) {
+    if (!broad_phase) return BROAD_PHASE_NULL_PROXY;
+
+    // Make room for the sweep-and-prune interval up front so failure leaves no trace
+    if (broad_phase->type == BROAD_PHASE_SWEEP_AND_PRUNE &&
+        broad_phase->interval_count == broad_phase->interval_capacity) {
+        int capacity = broad_phase->interval_capacity > 0 ? broad_phase->interval_capacity * 2
+                                                          : BROAD_PHASE_INITIAL_CAPACITY;
+        BroadPhaseInterval* intervals = (BroadPhaseInterval*)realloc(broad_phase->intervals,
+            (size_t)capacity * sizeof(BroadPhaseInterval));
+        if (!intervals) return BROAD_PHASE_NULL_PROXY;
+        broad_phase->intervals = intervals;
+        broad_phase->interval_capacity = capacity;
+    }
+
+    int id;
+    if (broad_phase->free_proxy != BROAD_PHASE_NULL_PROXY) {
+        id = broad_phase->free_proxy;
+        broad_phase->free_proxy = broad_phase->proxies[id].next_free;
+    } else {
+        if (broad_phase->proxy_count == broad_phase->proxy_capacity) {
+            int capacity = broad_phase->proxy_capacity > 0 ? broad_phase->proxy_capacity * 2
+                                                           : BROAD_PHASE_INITIAL_CAPACITY;
+            BroadPhaseProxy* proxies = (BroadPhaseProxy*)realloc(broad_phase->proxies,
+                (size_t)capacity * sizeof(BroadPhaseProxy));
+            if (!proxies) return BROAD_PHASE_NULL_PROXY;
+            broad_phase->proxies = proxies;
+            broad_phase->proxy_capacity = capacity;
+        }
+        id = broad_phase->proxy_count++;
+    }
+
+    BroadPhaseProxy* proxy = &broad_phase->proxies[id];
+    proxy->bounds = bounds;
+    proxy->fat_bounds = fatten_bounds(bounds, broad_phase->margin, vector3_create(0, 0, 0));
+    proxy->user_data = user_data;
+    proxy->node = BROAD_PHASE_NULL_NODE;
+    proxy->next_free = BROAD_PHASE_NULL_PROXY;
+    proxy->active = true;
+    proxy->sleeping = false;
+    proxy->listed = false;
+
+    switch (broad_phase->type) {
+        case BROAD_PHASE_SWEEP_AND_PRUNE: {
+            // Appended unsorted; the next query's insertion sort moves it into place
+            BroadPhaseInterval* interval = &broad_phase->intervals[broad_phase->interval_count++];
+            interval->min = axis_component(bounds.min, broad_phase->sort_axis);
+            interval->max = axis_component(bounds.max, broad_phase->sort_axis);
+            interval->bounds = bounds;
+            interval->proxy = id;
+            interval->sleeping = false;
+            break;
+        }
+        case BROAD_PHASE_AABB_TREE: {
+            int leaf = tree_allocate_node(broad_phase);
+            if (leaf == BROAD_PHASE_NULL_NODE) {
+                proxy->active = false;
+                proxy->next_free = broad_phase->free_proxy;
+                broad_phase->free_proxy = id;
+                return BROAD_PHASE_NULL_PROXY;
+            }
+            broad_phase->nodes[leaf].bounds = proxy->fat_bounds;
+            broad_phase->nodes[leaf].proxy = id;
+            if (!tree_insert_leaf(broad_phase, leaf)) {
+                tree_free_node(broad_phase, leaf);
+                proxy->active = false;
+                proxy->next_free = broad_phase->free_proxy;
+                broad_phase->free_proxy = id;
+                return BROAD_PHASE_NULL_PROXY;
+            }
+            proxy->node = leaf;
+            break;
+        }
+        default:
+            break;
+    }
+
+    broad_phase->active_count++;
+    return id;
+}
+
+void broad_phase_destroy_proxy(BroadPhase* broad_phase, int proxy_id) {
+    if (!broad_phase || proxy_id < 0 || proxy_id >= broad_phase->proxy_count) return;
+
+    BroadPhaseProxy* proxy = &broad_phase->proxies[proxy_id];
+    if (!proxy->active) return;
+
+    switch (broad_phase->type) {
+        case BROAD_PHASE_SWEEP_AND_PRUNE: {
+            for (int i = 0; i < broad_phase->interval_count; i++) {
+                if (broad_phase->intervals[i].proxy == proxy_id) {
+                    memmove(&broad_phase->intervals[i], &broad_phase->intervals[i + 1],
+                            (size_t)(broad_phase->interval_count - i - 1) * sizeof(BroadPhaseInterval));
+                    broad_phase->interval_count--;
+                    break;
+                }
+            }
+            break;
+        }
+        case BROAD_PHASE_AABB_TREE:
+            tree_remove_leaf(broad_phase, proxy->node);
+            tree_free_node(broad_phase, proxy->node);
+            proxy->node = BROAD_PHASE_NULL_NODE;
+            break;
+        default:
+            break;
+    }
+
+    proxy->active = false;
+    proxy->user_data = NULL;
+    proxy->next_free = broad_phase->free_proxy;
+    broad_phase->free_proxy = proxy_id;
+    broad_phase->active_count--;
+}
+
+bool broad_phase_move_proxy(BroadPhase* broad_phase, int proxy_id, AABB bounds, Vector3 displacement) {
+    if (!broad_phase || proxy_id < 0 || proxy_id >= broad_phase->proxy_count) return false;
+
+    BroadPhaseProxy* proxy = &broad_phase->proxies[proxy_id];
+    if (!proxy->active) return false;
+
+    proxy->bounds = bounds;
+    if (broad_phase->type != BROAD_PHASE_AABB_TREE) {
+        proxy->fat_bounds = bounds;
+        return false;
+    }
+
+    // Still inside the fat bounds: the tree is unchanged
+    if (aabb_contains(proxy->fat_bounds, bounds)) return false;
+
+    tree_remove_leaf(broad_phase, proxy->node);
+    proxy->fat_bounds = fatten_bounds(bounds, broad_phase->margin, displacement);
+    broad_phase->nodes[proxy->node].bounds = proxy->fat_bounds;
+
+    // The removed leaf freed a parent node, so reinsertion cannot run out of nodes
+    tree_insert_leaf(broad_phase, proxy->node);
+    broad_phase->reinserts++;
+    return true;
+}
+
+void broad_phase_set_proxy_sleeping(BroadPhase* broad_phase, int proxy_id, bool sleeping) {
+    if (!broad_phase || proxy_id < 0 || proxy_id >= broad_phase->proxy_count) return;
+
+    BroadPhaseProxy* proxy = &broad_phase->proxies[proxy_id];
+    if (!proxy->active || proxy->sleeping == sleeping) return;
+    proxy->sleeping = sleeping;
+
+    if (broad_phase->type != BROAD_PHASE_AABB_TREE) return;
+
+    // Update the leaf, then the ancestors until one already agrees
+    BroadPhaseNode* nodes = broad_phase->nodes;
+    nodes[proxy->node].awake = !sleeping;
+    for (int index = nodes[proxy->node].parent; index != BROAD_PHASE_NULL_NODE; index = nodes[index].parent) {
+        bool awake = nodes[nodes[index].left].awake || nodes[nodes[index].right].awake;
+        if (nodes[index].awake == awake) break;
+        nodes[index].awake = awake;
+    }
+}
+
+int broad_phase_find_pairs(BroadPhase* broad_phase, BroadPhasePairCallback callback, void* context) {
+    if (!broad_phase || !callback) return 0;
+
+    broad_phase->bounds_tests = 0;
+    int pairs = 0;
+
+    switch (broad_phase->type) {
+        case BROAD_PHASE_BRUTE_FORCE:
+            pairs = brute_force_find_pairs(broad_phase, callback, context);
+            break;
+        case BROAD_PHASE_SWEEP_AND_PRUNE:
+            pairs = sap_find_pairs(broad_phase, callback, context);
+            break;
+        case BROAD_PHASE_AABB_TREE:
+            if (broad_phase->root != BROAD_PHASE_NULL_NODE) {
+                pairs = tree_find_pairs(broad_phase, callback, context);
+            }
+            break;
+    }
+
+    broad_phase->pair_count = pairs;
+    return pairs;
+}
+
+int broad_phase_find_pairs_of(BroadPhase* broad_phase, const int* proxies, int count,
+                              BroadPhasePairCallback callback, void* context) {
+    if (!broad_phase || !proxies || !callback) return 0;
+
+    for (int i = 0; i < count; i++) {
+        broad_phase->proxies[proxies[i]].listed = true;
+    }
+
+    // Unlisting each proxy after its query reports a pair of two listed proxies once
+    int pairs = 0;
+    for (int i = 0; i < count; i++) {
+        if (broad_phase->type == BROAD_PHASE_AABB_TREE) {
+            pairs += tree_find_pairs_of(broad_phase, proxies[i], callback, context);
+        } else {
+            pairs += scan_find_pairs_of(broad_phase, proxies[i], callback, context);
+        }
+        broad_phase->proxies[proxies[i]].listed = false;
+    }
+
+    broad_phase->pair_count += pairs;
+    return pairs;
+}
+
+const char* broad_phase_type_name(BroadPhaseType type) {
+    switch (type) {
+        case BROAD_PHASE_BRUTE_FORCE: return "brute force";
+        case BROAD_PHASE_SWEEP_AND_PRUNE: return "sweep and prune";
+        case BROAD_PHASE_AABB_TREE: return "AABB tree";
+    }
+    return "unknown";
+}
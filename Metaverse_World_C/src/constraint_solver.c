@@ -0,0 +1,503 @@
+/*
+ * Metaverse World System - Constraint Solver Implementation
+ * Union-find island detection and a warm-started sequential-impulse
+ * solver, with islands batched over a thread pool
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/constraint_solver.h"
+
+/**
+ * Shared by the island tasks of one solve. Every dynamic body belongs to
+ * exactly one island and the solver never writes to bodies without
+ * inverse mass, so tasks touch disjoint store slots.
+ */
+typedef struct {
+    ConstraintSolver* solver;
+    RigidBodyStore* store;
+    float delta_time;
+    int iterations;
+    bool warm_starting;
+} SolveContext;
+
+// ============================================================================
+// Scratch Memory
+// ============================================================================
+
+static bool solver_reserve_slots(ConstraintSolver* solver, int count) {
+    if (count <= solver->slot_capacity) return true;
+
+    int capacity = solver->slot_capacity * 2 > count ? solver->slot_capacity * 2 : count;
+    int* parent = (int*)realloc(solver->parent, capacity * sizeof(int));
+    if (parent) solver->parent = parent;
+    int* island_of = (int*)realloc(solver->island_of, capacity * sizeof(int));
+    if (island_of) solver->island_of = island_of;
+    int* island_bodies = (int*)realloc(solver->island_bodies, capacity * sizeof(int));
+    if (island_bodies) solver->island_bodies = island_bodies;
+    PhysicsIsland* islands = (PhysicsIsland*)realloc(solver->islands, capacity * sizeof(PhysicsIsland));
+    if (islands) solver->islands = islands;
+    int* touched = (int*)realloc(solver->touched, capacity * sizeof(int));
+    if (touched) solver->touched = touched;
+    int* task_islands = (int*)realloc(solver->task_islands, (capacity + 1) * sizeof(int));
+    if (task_islands) solver->task_islands = task_islands;
+
+    if (!parent || !island_of || !island_bodies || !islands || !touched || !task_islands) return false;
+
+    // New slots start as their own islands, unassigned
+    for (int slot = solver->slot_capacity; slot < capacity; slot++) {
+        parent[slot] = slot;
+        island_of[slot] = -1;
+    }
+    solver->slot_capacity = capacity;
+    return true;
+}
+
+static bool solver_reserve_contacts(ConstraintSolver* solver, int count) {
+    if (count <= solver->contact_capacity) return true;
+
+    int capacity = solver->contact_capacity * 2 > count ? solver->contact_capacity * 2 : count;
+    ContactConstraint* contacts = (ContactConstraint*)realloc(solver->contacts,
+        capacity * sizeof(ContactConstraint));
+    if (contacts) solver->contacts = contacts;
+    ContactConstraint* scratch = (ContactConstraint*)realloc(solver->scratch,
+        capacity * sizeof(ContactConstraint));
+    if (scratch) solver->scratch = scratch;
+
+    if (!contacts || !scratch) return false;
+    solver->contact_capacity = capacity;
+    return true;
+}
+
+static bool solver_reserve_joints(ConstraintSolver* solver, int count) {
+    if (count <= solver->joint_capacity) return true;
+
+    int capacity = solver->joint_capacity * 2 > count ? solver->joint_capacity * 2 : count;
+    JointConstraint* joints = (JointConstraint*)realloc(solver->joints, capacity * sizeof(JointConstraint));
+    if (joints) solver->joints = joints;
+    JointConstraint* scratch = (JointConstraint*)realloc(solver->joint_scratch,
+        capacity * sizeof(JointConstraint));
+    if (scratch) solver->joint_scratch = scratch;
+
+    if (!joints || !scratch) return false;
+    solver->joint_capacity = capacity;
+    return true;
+}
+
+// ============================================================================
+// Island Detection
+// ============================================================================
+
+static int island_find(int* parent, int slot) {
+    while (parent[slot] != slot) {
+        parent[slot] = parent[parent[slot]];
+        slot = parent[slot];
+    }
+    return slot;
+}
+
+static void island_union(int* parent, int a, int b) {
+    a = island_find(parent, a);
+    b = island_find(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
+}
+
+// Awake bodies with mass; sleeping bodies act as static (the world wakes them before they are pushed)
+static bool solver_is_dynamic(const RigidBodyStore* store, int slot) {
+    return slot < store->awake_count && store->inverse_mass[slot] > 0.0f;
+}
+
+// Island of a dynamic body, creating it and listing the body on first visit
+static int island_assign(ConstraintSolver* solver, int slot) {
+    if (solver->island_of[slot] >= 0) return solver->island_of[slot];
+
+    int root = island_find(solver->parent, slot);
+    if (solver->island_of[root] < 0) {
+        solver->island_of[root] = solver->island_count;
+        memset(&solver->islands[solver->island_count], 0, sizeof(PhysicsIsland));
+        solver->islands[solver->island_count].body_count = 1;
+        solver->touched[solver->touched_count++] = root;
+        solver->island_count++;
+    }
+    if (slot != root) {
+        solver->island_of[slot] = solver->island_of[root];
+        solver->islands[solver->island_of[root]].body_count++;
+        solver->touched[solver->touched_count++] = slot;
+    }
+    return solver->island_of[slot];
+}
+
+// Island of a constraint: its dynamic bodies' island
+static int island_of_pair(ConstraintSolver* solver, const RigidBodyStore* store, int a, int b) {
+    int island = -1;
+    if (solver_is_dynamic(store, a)) island = island_assign(solver, a);
+    if (solver_is_dynamic(store, b)) island = island_assign(solver, b);
+    return island;
+}
+
+// Forget the last solve's islands, touching only the slots it assigned
+static void solver_reset_islands(ConstraintSolver* solver) {
+    for (int i = 0; i < solver->touched_count; i++) {
+        solver->island_of[solver->touched[i]] = -1;
+        solver->parent[solver->touched[i]] = solver->touched[i];
+    }
+    solver->island_count = 0;
+    solver->touched_count = 0;
+}
+
+/**
+ * Group the constrained bodies into islands and sort the gathered
+ * constraints (in the scratch arrays) by island with a counting sort.
+ * Work is proportional to the constraints, not the bodies.
+ */
+static void solver_build_islands(ConstraintSolver* solver, const RigidBodyStore* store) {
+    for (int i = 0; i < solver->contact_count; i++) {
+        ContactConstraint* constraint = &solver->scratch[i];
+        solver->islands[island_of_pair(solver, store, constraint->body_a, constraint->body_b)].contact_count++;
+    }
+    for (int i = 0; i < solver->joint_count; i++) {
+        JointConstraint* constraint = &solver->joint_scratch[i];
+        solver->islands[island_of_pair(solver, store, constraint->body_a, constraint->body_b)].joint_count++;
+    }
+
+    // Prefix sums give each island its ranges; the counts restart as fill cursors
+    int bodies = 0, contacts = 0, joints = 0;
+    for (int i = 0; i < solver->island_count; i++) {
+        PhysicsIsland* island = &solver->islands[i];
+        island->body_start = bodies;
+        island->contact_start = contacts;
+        island->joint_start = joints;
+        bodies += island->body_count;
+        contacts += island->contact_count;
+        joints += island->joint_count;
+        island->body_count = 0;
+        island->contact_count = 0;
+        island->joint_count = 0;
+    }
+
+    for (int i = 0; i < solver->touched_count; i++) {
+        int slot = solver->touched[i];
+        PhysicsIsland* island = &solver->islands[solver->island_of[slot]];
+        solver->island_bodies[island->body_start + island->body_count++] = slot;
+    }
+    for (int i = 0; i < solver->contact_count; i++) {
+        ContactConstraint* constraint = &solver->scratch[i];
+        PhysicsIsland* island = &solver->islands[island_of_pair(solver, store, constraint->body_a,
+                                                                constraint->body_b)];
+        solver->contacts[island->contact_start + island->contact_count++] = *constraint;
+    }
+    for (int i = 0; i < solver->joint_count; i++) {
+        JointConstraint* constraint = &solver->joint_scratch[i];
+        PhysicsIsland* island = &solver->islands[island_of_pair(solver, store, constraint->body_a,
+                                                                constraint->body_b)];
+        solver->joints[island->joint_start + island->joint_count++] = *constraint;
+    }
+}
+
+// Batch consecutive islands into tasks of similar constraint counts
+static void solver_build_tasks(ConstraintSolver* solver) {
+    int threads = thread_pool_size(solver->pool);
+    int total = solver->contact_count + solver->joint_count;
+    int target = threads > 1 ? total / (threads * SOLVER_TASKS_PER_THREAD) + 1 : total + 1;
+
+    int work = 0;
+    solver->task_count = 0;
+    solver->task_islands[0] = 0;
+    for (int i = 0; i < solver->island_count; i++) {
+        work += solver->islands[i].contact_count + solver->islands[i].joint_count;
+        if (work >= target) {
+            solver->task_islands[++solver->task_count] = i + 1;
+            work = 0;
+        }
+    }
+    if (solver->task_islands[solver->task_count] < solver->island_count) {
+        solver->task_islands[++solver->task_count] = solver->island_count;
+    }
+}
+
+// ============================================================================
+// Sequential Impulses
+// ============================================================================
+
+static Vector3 body_velocity(const RigidBodyStore* store, int slot) {
+    return vector3_create(store->velocity_x[slot], store->velocity_y[slot], store->velocity_z[slot]);
+}
+
+// Apply impulse * sign to a body (bodies without inverse mass are shared between islands: never written)
+static void body_apply_impulse(RigidBodyStore* store, int slot, Vector3 impulse, float sign) {
+    float scale = store->inverse_mass[slot] * sign;
+    if (scale == 0.0f) return;
+
+    store->velocity_x[slot] += impulse.x * scale;
+    store->velocity_y[slot] += impulse.y * scale;
+    store->velocity_z[slot] += impulse.z * scale;
+}
+
+static void apply_pair_impulse(RigidBodyStore* store, int a, int b, Vector3 impulse) {
+    body_apply_impulse(store, a, impulse, -1.0f);
+    body_apply_impulse(store, b, impulse, 1.0f);
+}
+
+static void prepare_contact(const SolveContext* ctx, ContactConstraint* constraint) {
+    RigidBodyStore* store = ctx->store;
+    ContactPoint* contact = constraint->contact;
+    int a = constraint->body_a;
+    int b = constraint->body_b;
+
+    constraint->normal = contact->normal;
+    constraint->mass = 1.0f / (store->inverse_mass[a] + store->inverse_mass[b]);
+
+    // Push out the penetration beyond the slop over a few steps, and bounce fast approaches
+    float approach = vector3_dot(vector3_subtract(body_velocity(store, b), body_velocity(store, a)),
+                                 constraint->normal);
+    constraint->bias = SOLVER_BAUMGARTE / ctx->delta_time *
+                       fmaxf(contact->penetration - SOLVER_PENETRATION_SLOP, 0.0f);
+    if (approach < -SOLVER_RESTITUTION_THRESHOLD) {
+        constraint->bias = fmaxf(constraint->bias, -constraint->restitution * approach);
+    }
+}
+
+static void warm_start_contact(const SolveContext* ctx, ContactConstraint* constraint) {
+    ContactPoint* contact = constraint->contact;
+
+    if (ctx->warm_starting) {
+        // A damped guess: the full cached impulse overshoots when few iterations follow
+        contact->impulse *= SOLVER_WARM_START_FACTOR;
+        contact->friction_impulse = vector3_multiply(contact->friction_impulse, SOLVER_WARM_START_FACTOR);
+        apply_pair_impulse(ctx->store, constraint->body_a, constraint->body_b,
+                           vector3_add(vector3_multiply(constraint->normal, contact->impulse),
+                                       contact->friction_impulse));
+    } else {
+        contact->impulse = 0.0f;
+        contact->friction_impulse = vector3_create(0, 0, 0);
+    }
+}
+
+static void solve_contact(const SolveContext* ctx, ContactConstraint* constraint) {
+    RigidBodyStore* store = ctx->store;
+    ContactPoint* contact = constraint->contact;
+    int a = constraint->body_a;
+    int b = constraint->body_b;
+    Vector3 normal = constraint->normal;
+
+    // Friction: cancel tangential velocity within the cone set by the normal impulse
+    Vector3 relative = vector3_subtract(body_velocity(store, b), body_velocity(store, a));
+    Vector3 tangent_velocity = vector3_subtract(relative, vector3_multiply(normal, vector3_dot(relative, normal)));
+    Vector3 friction = vector3_subtract(contact->friction_impulse,
+                                        vector3_multiply(tangent_velocity, constraint->mass));
+    float max_friction = constraint->friction * contact->impulse;
+    float magnitude = vector3_magnitude(friction);
+    if (magnitude > max_friction) {
+        friction = magnitude > 0.0f ? vector3_multiply(friction, max_friction / magnitude)
+                                    : vector3_create(0, 0, 0);
+    }
+    apply_pair_impulse(store, a, b, vector3_subtract(friction, contact->friction_impulse));
+    contact->friction_impulse = friction;
+
+    // Normal: the accumulated impulse may only push
+    relative = vector3_subtract(body_velocity(store, b), body_velocity(store, a));
+    float lambda = (constraint->bias - vector3_dot(relative, normal)) * constraint->mass;
+    float accumulated = fmaxf(contact->impulse + lambda, 0.0f);
+    apply_pair_impulse(store, a, b, vector3_multiply(normal, accumulated - contact->impulse));
+    contact->impulse = accumulated;
+}
+
+static void store_contact(ContactConstraint* constraint) {
+    // Only the impulse that held the bodies apart is worth reapplying; the part that
+    // pushed out penetration or bounced would add the same correction again next step
+    ContactPoint* contact = constraint->contact;
+    contact->impulse = fmaxf(contact->impulse - constraint->bias * constraint->mass, 0.0f);
+}
+
+static void prepare_joint(const SolveContext* ctx, JointConstraint* constraint) {
+    RigidBodyStore* store = ctx->store;
+    Joint* joint = constraint->joint;
+    int a = constraint->body_a;
+    int b = constraint->body_b;
+
+    Vector3 anchor_a = vector3_add(vector3_create(store->position_x[a], store->position_y[a],
+                                                  store->position_z[a]), joint->anchor_a);
+    Vector3 anchor_b = vector3_add(vector3_create(store->position_x[b], store->position_y[b],
+                                                  store->position_z[b]), joint->anchor_b);
+
+    constraint->mass = 1.0f / (store->inverse_mass[a] + store->inverse_mass[b]);
+    constraint->bias = vector3_multiply(vector3_subtract(anchor_a, anchor_b), SOLVER_BAUMGARTE / ctx->delta_time);
+
+    if (ctx->warm_starting) {
+        apply_pair_impulse(store, a, b, joint->impulse);
+    } else {
+        joint->impulse = vector3_create(0, 0, 0);
+    }
+}
+
+static void solve_joint(const SolveContext* ctx, JointConstraint* constraint) {
+    RigidBodyStore* store = ctx->store;
+    int a = constraint->body_a;
+    int b = constraint->body_b;
+
+    Vector3 relative = vector3_subtract(body_velocity(store, b), body_velocity(store, a));
+    Vector3 lambda = vector3_multiply(vector3_subtract(constraint->bias, relative), constraint->mass);
+    apply_pair_impulse(store, a, b, lambda);
+    constraint->joint->impulse = vector3_add(constraint->joint->impulse, lambda);
+}
+
+static void solve_island(const SolveContext* ctx, const PhysicsIsland* island) {
+    ContactConstraint* contacts = ctx->solver->contacts + island->contact_start;
+    JointConstraint* joints = ctx->solver->joints + island->joint_start;
+
+    // Approach speeds are measured before any warm start impulse changes them
+    for (int i = 0; i < island->joint_count; i++) prepare_joint(ctx, &joints[i]);
+    for (int i = 0; i < island->contact_count; i++) prepare_contact(ctx, &contacts[i]);
+    for (int i = 0; i < island->contact_count; i++) warm_start_contact(ctx, &contacts[i]);
+
+    for (int iteration = 0; iteration < ctx->iterations; iteration++) {
+        for (int i = 0; i < island->joint_count; i++) solve_joint(ctx, &joints[i]);
+        for (int i = 0; i < island->contact_count; i++) solve_contact(ctx, &contacts[i]);
+    }
+
+    for (int i = 0; i < island->contact_count; i++) store_contact(&contacts[i]);
+
+    // Joints break once the force they had to apply exceeds their limit
+    for (int i = 0; i < island->joint_count; i++) {
+        Joint* joint = joints[i].joint;
+        if (vector3_magnitude(joint->impulse) > joint->break_force * ctx->delta_time) {
+            joint->enabled = false;
+            joint->impulse = vector3_create(0, 0, 0);
+        }
+    }
+}
+
+static void solve_island_task(void* context, int index, int thread_id) {
+    (void)thread_id;
+    const SolveContext* ctx = (const SolveContext*)context;
+    ConstraintSolver* solver = ctx->solver;
+
+    for (int i = solver->task_islands[index]; i < solver->task_islands[index + 1]; i++) {
+        solve_island(ctx, &solver->islands[i]);
+    }
+}
+
+// ============================================================================
+// Solver Interface
+// ============================================================================
+
+ConstraintSolver* constraint_solver_create(int num_threads) {
+    ConstraintSolver* solver = (ConstraintSolver*)calloc(1, sizeof(ConstraintSolver));
+    if (!solver) return NULL;
+
+    if (!constraint_solver_set_threads(solver, num_threads)) {
+        constraint_solver_destroy(solver);
+        return NULL;
+    }
+    return solver;
+}
+
+void constraint_solver_destroy(ConstraintSolver* solver) {
+    if (!solver) return;
+
+    thread_pool_destroy(solver->pool);
+    free(solver->contacts);
+    free(solver->scratch);
+    free(solver->joints);
+    free(solver->joint_scratch);
+    free(solver->islands);
+    free(solver->island_bodies);
+    free(solver->parent);
+    free(solver->island_of);
+    free(solver->touched);
+    free(solver->task_islands);
+    free(solver);
+}
+
+bool constraint_solver_set_threads(ConstraintSolver* solver, int num_threads) {
+    if (!solver) return false;
+
+    if (num_threads <= 0) num_threads = thread_pool_hardware_threads();
+    if (num_threads == thread_pool_size(solver->pool)) return true;
+
+    thread_pool_destroy(solver->pool);
+    solver->pool = NULL;
+    if (num_threads == 1) return true;
+
+    solver->pool = thread_pool_create(num_threads);
+    return solver->pool != NULL;
+}
+
+int constraint_solver_threads(ConstraintSolver* solver) {
+    return solver ? thread_pool_size(solver->pool) : 1;
+}
+
+bool constraint_solver_solve(ConstraintSolver* solver, PhysicsWorld* world, float delta_time) {
+    if (!solver || !world || delta_time <= 0.0f) return false;
+
+    RigidBodyStore* store = &world->store;
+    if (!solver_reserve_slots(solver, store->count) ||
+        !solver_reserve_contacts(solver, world->manifold_count) ||
+        !solver_reserve_joints(solver, world->joint_count)) {
+        return false;
+    }
+    solver_reset_islands(solver);
+
+    // Gather contacts between bodies the solver can move; only dynamic pairs join islands
+    solver->contact_count = 0;
+    for (int i = 0; i < world->manifold_count; i++) {
+        CollisionManifold* manifold = &world->manifolds[i];
+        int a = manifold->body_a->store_index;
+        int b = manifold->body_b->store_index;
+        bool dynamic_a = solver_is_dynamic(store, a);
+        bool dynamic_b = solver_is_dynamic(store, b);
+        if (!dynamic_a && !dynamic_b) continue;
+
+        const PhysicsMaterial* material_a = &manifold->body_a->collider->material;
+        const PhysicsMaterial* material_b = &manifold->body_b->collider->material;
+        for (int c = 0; c < manifold->contact_count; c++) {
+            ContactConstraint* constraint = &solver->scratch[solver->contact_count++];
+            constraint->body_a = a;
+            constraint->body_b = b;
+            constraint->friction = sqrtf(material_a->dynamic_friction * material_b->dynamic_friction);
+            constraint->restitution = fmaxf(material_a->restitution, material_b->restitution);
+            constraint->contact = &manifold->contacts[c];
+        }
+        if (dynamic_a && dynamic_b) island_union(solver->parent, a, b);
+        manifold->resolved = true;
+    }
+
+    // Joints between two bodies of this world, at least one of them dynamic
+    solver->joint_count = 0;
+    for (int i = 0; i < world->joint_count; i++) {
+        Joint* joint = world->joints[i];
+        if (!joint->enabled || !joint->body_a || !joint->body_b ||
+            joint->body_a->world != world || joint->body_b->world != world) {
+            continue;
+        }
+
+        int a = joint->body_a->store_index;
+        int b = joint->body_b->store_index;
+        bool dynamic_a = solver_is_dynamic(store, a);
+        bool dynamic_b = solver_is_dynamic(store, b);
+        if (!dynamic_a && !dynamic_b) continue;
+
+        JointConstraint* constraint = &solver->joint_scratch[solver->joint_count++];
+        constraint->body_a = a;
+        constraint->body_b = b;
+        constraint->joint = joint;
+        if (dynamic_a && dynamic_b) island_union(solver->parent, a, b);
+    }
+
+    solver_build_islands(solver, store);
+    solver_build_tasks(solver);
+
+    SolveContext ctx;
+    ctx.solver = solver;
+    ctx.store = store;
+    ctx.delta_time = delta_time;
+    ctx.iterations = world->max_iterations;
+    ctx.warm_starting = world->warm_starting;
+    thread_pool_parallel_for(solver->pool, solver->task_count, solve_island_task, &ctx);
+
+    world->constraints_solved = solver->contact_count + solver->joint_count;
+    world->island_count = solver->island_count;
+    return true;
+}
@@ -8,7 +8,500 @@
 #include <string.h>
 #include <math.h>
 #include <float.h>
+#include <time.h>
 #include "../headers/physics.h"
+#include "../headers/constraint_solver.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PHYSICS_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define PHYSICS_STORE_ARRAYS 17     // Float arrays in a RigidBodyStore
+#define PHYSICS_WARM_START_COSINE 0.95f // Contacts whose normal turned further start cold
+
+// ============================================================================
+// Body Store
+// ============================================================================
+
+static bool store_init(RigidBodyStore* store, int capacity) {
+    memset(store, 0, sizeof(RigidBodyStore));
+
+    // One block, one array after another
+    float* block = (float*)calloc((size_t)PHYSICS_STORE_ARRAYS * capacity, sizeof(float));
+    if (!block) return false;
+
+    float** arrays[PHYSICS_STORE_ARRAYS] = {
+        &store->position_x, &store->position_y, &store->position_z,
+        &store->velocity_x, &store->velocity_y, &store->velocity_z,
+        &store->force_x, &store->force_y, &store->force_z,
+        &store->inverse_mass, &store->gravity_scale, &store->damping, &store->motion,
+        &store->sleep_time, &store->previous_x, &store->previous_y, &store->previous_z
+    };
+    for (int a = 0; a < PHYSICS_STORE_ARRAYS; a++) {
+        *arrays[a] = block + (size_t)a * capacity;
+    }
+
+    store->capacity = capacity;
+    return true;
+}
+
+static void store_free(RigidBodyStore* store) {
+    free(store->position_x);
+    memset(store, 0, sizeof(RigidBodyStore));
+}
+
+// Derive the integrator parameters of a slot from the body's properties
+static void store_write_properties(RigidBodyStore* store, int slot, const RigidBody* body) {
+    bool dynamic = !body->kinematic;
+    store->inverse_mass[slot] = dynamic && body->mass > 0.0f ? 1.0f / body->mass : 0.0f;
+    store->gravity_scale[slot] = dynamic ? body->gravity_scale : 0.0f;
+    store->damping[slot] = dynamic ? body->linear_damping : 0.0f;
+    store->motion[slot] = dynamic ? 1.0f : 0.0f;
+}
+
+static void store_write_state(RigidBodyStore* store, int slot, const RigidBody* body) {
+    store->position_x[slot] = body->position.x;
+    store->position_y[slot] = body->position.y;
+    store->position_z[slot] = body->position.z;
+    store->velocity_x[slot] = body->linear_velocity.x;
+    store->velocity_y[slot] = body->linear_velocity.y;
+    store->velocity_z[slot] = body->linear_velocity.z;
+    store->force_x[slot] = body->force_accumulator.x;
+    store->force_y[slot] = body->force_accumulator.y;
+    store->force_z[slot] = body->force_accumulator.z;
+}
+
+static void store_read_state(const RigidBodyStore* store, int slot, RigidBody* body) {
+    body->position = vector3_create(store->position_x[slot], store->position_y[slot], store->position_z[slot]);
+    body->linear_velocity = vector3_create(store->velocity_x[slot], store->velocity_y[slot],
+                                           store->velocity_z[slot]);
+    body->force_accumulator = vector3_create(store->force_x[slot], store->force_y[slot], store->force_z[slot]);
+}
+
+static void store_get_arrays(RigidBodyStore* store, float* arrays[PHYSICS_STORE_ARRAYS]) {
+    float* list[PHYSICS_STORE_ARRAYS] = {
+        store->position_x, store->position_y, store->position_z,
+        store->velocity_x, store->velocity_y, store->velocity_z,
+        store->force_x, store->force_y, store->force_z,
+        store->inverse_mass, store->gravity_scale, store->damping, store->motion,
+        store->sleep_time, store->previous_x, store->previous_y, store->previous_z
+    };
+    memcpy(arrays, list, sizeof(list));
+}
+
+static void store_move_slot(RigidBodyStore* store, int to, int from) {
+    float* arrays[PHYSICS_STORE_ARRAYS];
+    store_get_arrays(store, arrays);
+    for (int a = 0; a < PHYSICS_STORE_ARRAYS; a++) {
+        arrays[a][to] = arrays[a][from];
+    }
+}
+
+static void store_swap_slots(RigidBodyStore* store, int a, int b) {
+    float* arrays[PHYSICS_STORE_ARRAYS];
+    store_get_arrays(store, arrays);
+    for (int k = 0; k < PHYSICS_STORE_ARRAYS; k++) {
+        float value = arrays[k][a];
+        arrays[k][a] = arrays[k][b];
+        arrays[k][b] = value;
+    }
+}
+
+static Vector3 store_position(const RigidBodyStore* store, int slot) {
+    return vector3_create(store->position_x[slot], store->position_y[slot], store->position_z[slot]);
+}
+
+static Vector3 store_velocity(const RigidBodyStore* store, int slot) {
+    return vector3_create(store->velocity_x[slot], store->velocity_y[slot], store->velocity_z[slot]);
+}
+
+static void store_set_position(RigidBodyStore* store, int slot, Vector3 position) {
+    store->position_x[slot] = position.x;
+    store->position_y[slot] = position.y;
+    store->position_z[slot] = position.z;
+}
+
+// Interpolation starts from where the body is now
+static void store_snap_previous(RigidBodyStore* store, int slot) {
+    store->previous_x[slot] = store->position_x[slot];
+    store->previous_y[slot] = store->position_y[slot];
+    store->previous_z[slot] = store->position_z[slot];
+}
+
+static void store_set_velocity(RigidBodyStore* store, int slot, Vector3 velocity) {
+    store->velocity_x[slot] = velocity.x;
+    store->velocity_y[slot] = velocity.y;
+    store->velocity_z[slot] = velocity.z;
+}
+
+// ============================================================================
+// Integrator Kernels
+// ============================================================================
+
+/**
+ * Per body: v = (v + (F / m + g * gravity_scale) * dt) * (1 - damping * dt),
+ * F = 0, then after the constraint solver p += v * dt * motion. Same
+ * arithmetic as the original per-body loops (gravity was added as g * m
+ * and divided back out).
+ */
+typedef void (*VelocityKernel)(RigidBodyStore* store, int begin, int end, Vector3 gravity, float dt);
+typedef void (*PositionKernel)(RigidBodyStore* store, int begin, int end, float dt);
+
+static void integrate_velocity_scalar(RigidBodyStore* store, int begin, int end, Vector3 gravity, float dt) {
+    for (int i = begin; i < end; i++) {
+        float inverse_mass = store->inverse_mass[i];
+        float gravity_scale = store->gravity_scale[i];
+        float keep = 1.0f - store->damping[i] * dt;
+
+        store->velocity_x[i] = (store->velocity_x[i] + (store->force_x[i] * inverse_mass + gravity.x * gravity_scale) * dt) * keep;
+        store->velocity_y[i] = (store->velocity_y[i] + (store->force_y[i] * inverse_mass + gravity.y * gravity_scale) * dt) * keep;
+        store->velocity_z[i] = (store->velocity_z[i] + (store->force_z[i] * inverse_mass + gravity.z * gravity_scale) * dt) * keep;
+        store->force_x[i] = 0.0f;
+        store->force_y[i] = 0.0f;
+        store->force_z[i] = 0.0f;
+    }
+}
+
+static void integrate_position_scalar(RigidBodyStore* store, int begin, int end, float dt) {
+    for (int i = begin; i < end; i++) {
+        float step = store->motion[i] * dt;
+        store->position_x[i] += store->velocity_x[i] * step;
+        store->position_y[i] += store->velocity_y[i] * step;
+        store->position_z[i] += store->velocity_z[i] * step;
+    }
+}
+
+#ifdef PHYSICS_HAVE_X86
+
+#define AVX512_TAIL_MASK(n, i) \
+    (((n) - (i) >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << ((n) - (i))) - 1))
+
+__attribute__((target("avx512f")))
+static void integrate_velocity_avx512(RigidBodyStore* store, int begin, int end, Vector3 gravity, float dt) {
+    const __m512 dt_v = _mm512_set1_ps(dt);
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 g[3] = { _mm512_set1_ps(gravity.x), _mm512_set1_ps(gravity.y), _mm512_set1_ps(gravity.z) };
+    float* velocity[3] = { store->velocity_x, store->velocity_y, store->velocity_z };
+    float* force[3] = { store->force_x, store->force_y, store->force_z };
+
+    for (int i = begin; i < end; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(end, i);
+        __m512 inverse_mass = _mm512_maskz_loadu_ps(k, store->inverse_mass + i);
+        __m512 gravity_scale = _mm512_maskz_loadu_ps(k, store->gravity_scale + i);
+        __m512 keep = _mm512_fnmadd_ps(_mm512_maskz_loadu_ps(k, store->damping + i), dt_v, one);
+
+        for (int axis = 0; axis < 3; axis++) {
+            __m512 acceleration = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, force[axis] + i), inverse_mass,
+                                                  _mm512_mul_ps(g[axis], gravity_scale));
+            __m512 v = _mm512_fmadd_ps(acceleration, dt_v, _mm512_maskz_loadu_ps(k, velocity[axis] + i));
+            _mm512_mask_storeu_ps(velocity[axis] + i, k, _mm512_mul_ps(v, keep));
+            _mm512_mask_storeu_ps(force[axis] + i, k, zero);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+static void integrate_position_avx512(RigidBodyStore* store, int begin, int end, float dt) {
+    const __m512 dt_v = _mm512_set1_ps(dt);
+    float* velocity[3] = { store->velocity_x, store->velocity_y, store->velocity_z };
+    float* position[3] = { store->position_x, store->position_y, store->position_z };
+
+    for (int i = begin; i < end; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(end, i);
+        __m512 step = _mm512_mul_ps(_mm512_maskz_loadu_ps(k, store->motion + i), dt_v);
+
+        for (int axis = 0; axis < 3; axis++) {
+            _mm512_mask_storeu_ps(position[axis] + i, k,
+                _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, velocity[axis] + i), step,
+                                _mm512_maskz_loadu_ps(k, position[axis] + i)));
+        }
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void integrate_velocity_avx2(RigidBodyStore* store, int begin, int end, Vector3 gravity, float dt) {
+    const __m256 dt_v = _mm256_set1_ps(dt);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 g[3] = { _mm256_set1_ps(gravity.x), _mm256_set1_ps(gravity.y), _mm256_set1_ps(gravity.z) };
+    float* velocity[3] = { store->velocity_x, store->velocity_y, store->velocity_z };
+    float* force[3] = { store->force_x, store->force_y, store->force_z };
+
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 inverse_mass = _mm256_loadu_ps(store->inverse_mass + i);
+        __m256 gravity_scale = _mm256_loadu_ps(store->gravity_scale + i);
+        __m256 keep = _mm256_fnmadd_ps(_mm256_loadu_ps(store->damping + i), dt_v, one);
+
+        for (int axis = 0; axis < 3; axis++) {
+            __m256 acceleration = _mm256_fmadd_ps(_mm256_loadu_ps(force[axis] + i), inverse_mass,
+                                                  _mm256_mul_ps(g[axis], gravity_scale));
+            __m256 v = _mm256_fmadd_ps(acceleration, dt_v, _mm256_loadu_ps(velocity[axis] + i));
+            _mm256_storeu_ps(velocity[axis] + i, _mm256_mul_ps(v, keep));
+            _mm256_storeu_ps(force[axis] + i, zero);
+        }
+    }
+
+    integrate_velocity_scalar(store, i, end, gravity, dt);
+}
+
+__attribute__((target("avx2,fma")))
+static void integrate_position_avx2(RigidBodyStore* store, int begin, int end, float dt) {
+    const __m256 dt_v = _mm256_set1_ps(dt);
+    float* velocity[3] = { store->velocity_x, store->velocity_y, store->velocity_z };
+    float* position[3] = { store->position_x, store->position_y, store->position_z };
+
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 step = _mm256_mul_ps(_mm256_loadu_ps(store->motion + i), dt_v);
+
+        for (int axis = 0; axis < 3; axis++) {
+            _mm256_storeu_ps(position[axis] + i, _mm256_fmadd_ps(_mm256_loadu_ps(velocity[axis] + i), step,
+                                                                 _mm256_loadu_ps(position[axis] + i)));
+        }
+    }
+
+    integrate_position_scalar(store, i, end, dt);
+}
+
+#endif
+
+static int physics_kernel_override = -1;
+
+PhysicsKernel physics_get_kernel(void) {
+    if (physics_kernel_override >= 0) return (PhysicsKernel)physics_kernel_override;
+
+#ifdef PHYSICS_HAVE_X86
+    static int level = -1;
+    if (level < 0) {
+        __builtin_cpu_init();
+        level = __builtin_cpu_supports("avx512f") ? PHYSICS_KERNEL_AVX512
+              : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? PHYSICS_KERNEL_AVX2
+              : PHYSICS_KERNEL_SCALAR;
+    }
+    return (PhysicsKernel)level;
+#else
+    return PHYSICS_KERNEL_SCALAR;
+#endif
+}
+
+bool physics_set_kernel(PhysicsKernel kernel) {
+    physics_kernel_override = -1;
+    if (kernel > physics_get_kernel()) return false;
+
+    physics_kernel_override = (int)kernel;
+    return true;
+}
+
+const char* physics_kernel_name(PhysicsKernel kernel) {
+    switch (kernel) {
+        case PHYSICS_KERNEL_SCALAR: return "scalar";
+        case PHYSICS_KERNEL_AVX2: return "avx2";
+        case PHYSICS_KERNEL_AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+static VelocityKernel physics_select_velocity_kernel(void) {
+#ifdef PHYSICS_HAVE_X86
+    switch (physics_get_kernel()) {
+        case PHYSICS_KERNEL_AVX512: return integrate_velocity_avx512;
+        case PHYSICS_KERNEL_AVX2: return integrate_velocity_avx2;
+        default: break;
+    }
+#endif
+    return integrate_velocity_scalar;
+}
+
+static PositionKernel physics_select_position_kernel(void) {
+#ifdef PHYSICS_HAVE_X86
+    switch (physics_get_kernel()) {
+        case PHYSICS_KERNEL_AVX512: return integrate_position_avx512;
+        case PHYSICS_KERNEL_AVX2: return integrate_position_avx2;
+        default: break;
+    }
+#endif
+    return integrate_position_scalar;
+}
+
+// ============================================================================
+// Sleeping Islands
+// ============================================================================
+
+static void physics_world_narrow_phase(void* user_a, void* user_b, void* context);
+
+// Exchange two store slots together with the bodies that own them
+static void physics_world_swap_slots(PhysicsWorld* world, int a, int b) {
+    if (a == b) return;
+
+    store_swap_slots(&world->store, a, b);
+    RigidBody* body = world->bodies[a];
+    world->bodies[a] = world->bodies[b];
+    world->bodies[b] = body;
+    world->bodies[a]->store_index = a;
+    world->bodies[b]->store_index = b;
+}
+
+// Put one awake body to sleep: it stops, and its slot moves to the end of the awake range
+static void physics_world_deactivate(PhysicsWorld* world, RigidBody* body) {
+    RigidBodyStore* store = &world->store;
+    int slot = body->store_index;
+
+    store_set_velocity(store, slot, vector3_create(0, 0, 0));
+    store_snap_previous(store, slot);
+    store->force_x[slot] = 0.0f;
+    store->force_y[slot] = 0.0f;
+    store->force_z[slot] = 0.0f;
+    body->sleeping = true;
+    if (body->broad_phase_proxy != BROAD_PHASE_NULL_PROXY) {
+        broad_phase_set_proxy_sleeping(world->broad_phase, body->broad_phase_proxy, true);
+    }
+
+    physics_world_swap_slots(world, slot, --store->awake_count);
+}
+
+// Wake every body of the circle a sleeping body belongs to
+static void physics_world_wake_island(PhysicsWorld* world, RigidBody* body) {
+    RigidBodyStore* store = &world->store;
+    RigidBody* next = body;
+
+    do {
+        RigidBody* current = next;
+        next = current->sleep_next;
+        current->sleep_next = NULL;
+        current->sleeping = false;
+        current->wake_queued = false;
+        if (current->broad_phase_proxy != BROAD_PHASE_NULL_PROXY) {
+            broad_phase_set_proxy_sleeping(world->broad_phase, current->broad_phase_proxy, false);
+        }
+
+        physics_world_swap_slots(world, current->store_index, store->awake_count++);
+        store->sleep_time[current->store_index] = 0.0f;
+    } while (next && next != body);
+}
+
+static void physics_world_wake_all(PhysicsWorld* world) {
+    while (world->store.awake_count < world->store.count) {
+        physics_world_wake_island(world, world->bodies[world->store.awake_count]);
+    }
+}
+
+/**
+ * A contact or joint between an awake and a sleeping body wakes the
+ * sleeping island. Sleeping kinematic bodies stay asleep: the solver
+ * never moves them, so they act the same either way. The island is only
+ * queued here; physics_world_wake_queued wakes it once the pair pass is over.
+ */
+static void physics_world_wake_pair(PhysicsWorld* world, RigidBody* body_a, RigidBody* body_b) {
+    if (body_a->sleeping == body_b->sleeping) return;
+
+    RigidBody* sleeper = body_a->sleeping ? body_a : body_b;
+    if (sleeper->kinematic || sleeper->wake_queued) return;
+
+    RigidBody* body = sleeper;
+    do {
+        body->wake_queued = true;
+        body = body->sleep_next;
+    } while (body && body != sleeper);
+    world->wake_queue[world->wake_count++] = sleeper;
+}
+
+static void physics_world_wake_joints(PhysicsWorld* world) {
+    for (int i = 0; i < world->joint_count; i++) {
+        Joint* joint = world->joints[i];
+        if (joint->enabled && joint->body_a && joint->body_b &&
+            joint->body_a->world == world && joint->body_b->world == world) {
+            physics_world_wake_pair(world, joint->body_a, joint->body_b);
+        }
+    }
+}
+
+/**
+ * Wake the queued islands, then find the contacts the pair pass skipped
+ * because both bodies slept: inside the woken islands and between them and
+ * islands still asleep. Those contacts queue more islands in turn, so keep
+ * going until a round wakes nothing.
+ */
+static void physics_world_wake_queued(PhysicsWorld* world) {
+    RigidBodyStore* store = &world->store;
+
+    while (world->wake_count > 0) {
+        // Woken bodies join the end of the awake range
+        int first = store->awake_count;
+        for (int i = 0; i < world->wake_count; i++) {
+            physics_world_wake_island(world, world->wake_queue[i]);
+        }
+        world->wake_count = 0;
+
+        int proxy_count = 0;
+        for (int i = first; i < store->awake_count; i++) {
+            if (world->bodies[i]->broad_phase_proxy != BROAD_PHASE_NULL_PROXY) {
+                world->woken_proxies[proxy_count++] = world->bodies[i]->broad_phase_proxy;
+            }
+        }
+        broad_phase_find_pairs_of(world->broad_phase, world->woken_proxies, proxy_count,
+                                  physics_world_narrow_phase, world);
+        physics_world_wake_joints(world);
+    }
+}
+
+/**
+ * Advance the rest timers of the awake bodies, then put every island whose
+ * bodies have all rested PHYSICS_SLEEP_TIME to sleep. Islands are the ones
+ * the solver just built; bodies in no island sleep on their own.
+ */
+static void physics_world_update_sleep(PhysicsWorld* world, float delta_time) {
+    RigidBodyStore* store = &world->store;
+    ConstraintSolver* solver = world->solver;
+    const float threshold = PHYSICS_SLEEP_VELOCITY * PHYSICS_SLEEP_VELOCITY;
+    int falling_asleep = 0;
+
+    // Link the bodies that fall asleep into circles while the slots still match the solve
+    for (int i = 0; i < store->awake_count; i++) {
+        float speed = store->velocity_x[i] * store->velocity_x[i] + store->velocity_y[i] * store->velocity_y[i] +
+                      store->velocity_z[i] * store->velocity_z[i];
+        store->sleep_time[i] = speed < threshold ? store->sleep_time[i] + delta_time : 0.0f;
+
+        if (store->sleep_time[i] >= PHYSICS_SLEEP_TIME && solver->island_of[i] < 0) {
+            world->bodies[i]->sleep_next = world->bodies[i];
+            falling_asleep++;
+        }
+    }
+
+    for (int i = 0; i < solver->island_count; i++) {
+        const PhysicsIsland* island = &solver->islands[i];
+        const int* slots = solver->island_bodies + island->body_start;
+
+        bool resting = true;
+        for (int k = 0; k < island->body_count && resting; k++) {
+            resting = store->sleep_time[slots[k]] >= PHYSICS_SLEEP_TIME;
+        }
+        if (!resting) continue;
+
+        for (int k = 0; k < island->body_count; k++) {
+            world->bodies[slots[k]]->sleep_next = world->bodies[slots[(k + 1) % island->body_count]];
+        }
+        falling_asleep += island->body_count;
+    }
+
+    if (falling_asleep == 0) return;
+
+    // Deactivating moves the last awake body into the slot, so look at it again
+    for (int i = 0; i < store->awake_count;) {
+        RigidBody* body = world->bodies[i];
+        if (body->sleep_next) {
+            physics_world_deactivate(world, body);
+        } else {
+            i++;
+        }
+    }
+}
 
 // ============================================================================
 // Physics World Implementation
@@ -21,25 +514,47 @@ PhysicsWorld* physics_world_create(Vector3 gravity, int max_bodies, int max_coll
     // Initialize properties
     world->gravity = gravity;
     world->fixed_timestep = PHYSICS_FIXED_TIMESTEP;
+    world->max_substeps = PHYSICS_MAX_SUBSTEPS;
+    world->accumulator = 0.0f;
     world->max_iterations = PHYSICS_MAX_ITERATIONS;
     world->paused = false;
+    world->allow_sleeping = true;
 
     // Allocate body arrays
     world->bodies = (RigidBody**)malloc(max_bodies * sizeof(RigidBody*));
     world->max_bodies = max_bodies;
     world->body_count = 0;
+    bool store_ok = store_init(&world->store, max_bodies);
 
     world->colliders = (Collider**)malloc(max_colliders * sizeof(Collider*));
     world->max_colliders = max_colliders;
     world->collider_count = 0;
 
-    // Initialize collision manifolds
+    // Initialize collision manifolds (current and previous step)
     world->manifolds = (CollisionManifold*)malloc(PHYSICS_MAX_CONSTRAINTS * sizeof(CollisionManifold));
+    world->contact_points = (ContactPoint*)malloc(PHYSICS_MAX_CONSTRAINTS * sizeof(ContactPoint));
+    world->previous_manifolds = (CollisionManifold*)malloc(PHYSICS_MAX_CONSTRAINTS * sizeof(CollisionManifold));
+    world->previous_contact_points = (ContactPoint*)malloc(PHYSICS_MAX_CONSTRAINTS * sizeof(ContactPoint));
     world->max_manifolds = PHYSICS_MAX_CONSTRAINTS;
     world->manifold_count = 0;
-
-    // Initialize broad phase (simplified)
-    world->broad_phase = NULL;
+    world->previous_manifold_count = 0;
+    world->manifold_table = NULL;
+    world->manifold_table_size = 0;
+
+    // Initialize the wake queue (at most one entry per body)
+    world->wake_queue = (RigidBody**)malloc(max_bodies * sizeof(RigidBody*));
+    world->wake_count = 0;
+    world->woken_proxies = (int*)malloc(max_bodies * sizeof(int));
+
+    // Initialize constraint solving
+    world->joints = NULL;
+    world->joint_count = 0;
+    world->max_joints = 0;
+    world->solver = constraint_solver_create(1);
+    world->warm_starting = true;
+
+    // Initialize broad phase
+    world->broad_phase = broad_phase_create(BROAD_PHASE_AABB_TREE, BROAD_PHASE_DEFAULT_MARGIN);
     world->narrow_phase = NULL;
 
     // Initialize callbacks
@@ -50,8 +565,13 @@ PhysicsWorld* physics_world_create(Vector3 gravity, int max_bodies, int max_coll
     world->simulation_time = 0.0f;
     world->collision_checks = 0;
     world->constraints_solved = 0;
+    world->island_count = 0;
+    world->substeps = 0;
+    world->interpolation_alpha = 0.0f;
 
-    if (!world->bodies || !world->colliders || !world->manifolds) {
+    if (!world->bodies || !store_ok || !world->colliders || !world->manifolds || !world->contact_points ||
+        !world->previous_manifolds || !world->previous_contact_points || !world->wake_queue ||
+        !world->woken_proxies || !world->broad_phase || !world->solver) {
         physics_world_destroy(world);
         return NULL;
     }
@@ -69,10 +589,12 @@ void physics_world_destroy(PhysicsWorld* world) {
     // Destroy all bodies
     for (int i = 0; i < world->body_count; i++) {
         if (world->bodies[i]) {
+            world->bodies[i]->world = NULL;
             rigid_body_destroy(world->bodies[i]);
         }
     }
     free(world->bodies);
+    store_free(&world->store);
 
     // Destroy all colliders
     for (int i = 0; i < world->collider_count; i++) {
@@ -82,150 +604,396 @@ void physics_world_destroy(PhysicsWorld* world) {
     }
     free(world->colliders);
 
+    // Joints stay with their owner; they just leave the world
+    for (int i = 0; i < world->joint_count; i++) {
+        world->joints[i]->world = NULL;
+    }
+    free(world->joints);
+
     // Free manifolds
     free(world->manifolds);
+    free(world->contact_points);
+    free(world->previous_manifolds);
+    free(world->previous_contact_points);
+    free(world->manifold_table);
+    free(world->wake_queue);
+    free(world->woken_proxies);
+
+    broad_phase_destroy(world->broad_phase);
+    constraint_solver_destroy(world->solver);
 
     free(world);
 }
 
-void physics_world_update(PhysicsWorld* world, float delta_time) {
-    if (!world || world->paused) return;
-
-    // Clamp delta time to prevent large jumps
-    if (delta_time > 1.0f / 30.0f) {
-        delta_time = 1.0f / 30.0f;
-    }
+// Keep each body's broad phase proxy in step with its collider and position
+static void physics_world_sync_broad_phase(PhysicsWorld* world, float delta_time) {
+    BroadPhase* broad_phase = world->broad_phase;
 
-    // Apply gravity to all bodies
-    for (int i = 0; i < world->body_count; i++) {
+    // Sleeping bodies do not move
+    for (int i = 0; i < world->store.awake_count; i++) {
         RigidBody* body = world->bodies[i];
-        if (body && !body->kinematic) {
-            body->force_accumulator = vector3_add(body->force_accumulator,
-                vector3_multiply(world->gravity, body->mass));
+        if (!body) continue;
+
+        if (!body->collider) {
+            if (body->broad_phase_proxy != BROAD_PHASE_NULL_PROXY) {
+                broad_phase_destroy_proxy(broad_phase, body->broad_phase_proxy);
+                body->broad_phase_proxy = BROAD_PHASE_NULL_PROXY;
+            }
+            continue;
+        }
+
+        AABB bounds = rigid_body_get_bounds(body);
+        if (body->broad_phase_proxy == BROAD_PHASE_NULL_PROXY) {
+            body->broad_phase_proxy = broad_phase_create_proxy(broad_phase, bounds, body);
+        } else {
+            broad_phase_move_proxy(broad_phase, body->broad_phase_proxy, bounds,
+                vector3_multiply(store_velocity(&world->store, i), delta_time));
         }
     }
+}
 
-    // Integrate forces and update velocities
-    for (int i = 0; i < world->body_count; i++) {
-        RigidBody* body = world->bodies[i];
-        if (body && !body->kinematic) {
-            // F = ma => a = F/m
-            Vector3 acceleration = vector3_multiply(body->force_accumulator, 1.0f / body->mass);
+// Grow both manifold buffers; contacts move with them
+static bool physics_world_reserve_manifolds(PhysicsWorld* world, int count) {
+    if (count <= world->max_manifolds) return true;
+
+    int capacity = world->max_manifolds * 2 > count ? world->max_manifolds * 2 : count;
+    CollisionManifold** manifolds[2] = { &world->manifolds, &world->previous_manifolds };
+    ContactPoint** contacts[2] = { &world->contact_points, &world->previous_contact_points };
+    for (int b = 0; b < 2; b++) {
+        CollisionManifold* grown_manifolds = (CollisionManifold*)realloc(*manifolds[b],
+            capacity * sizeof(CollisionManifold));
+        if (!grown_manifolds) return false;
+        *manifolds[b] = grown_manifolds;
+
+        ContactPoint* grown_contacts = (ContactPoint*)realloc(*contacts[b], capacity * sizeof(ContactPoint));
+        if (!grown_contacts) return false;
+        *contacts[b] = grown_contacts;
+    }
+    world->max_manifolds = capacity;
+
+    for (int i = 0; i < world->manifold_count; i++) {
+        world->manifolds[i].contacts = &world->contact_points[i];
+    }
+    for (int i = 0; i < world->previous_manifold_count; i++) {
+        world->previous_manifolds[i].contacts = &world->previous_contact_points[i];
+    }
+    return true;
+}
+
+static uint32_t manifold_pair_hash(const RigidBody* body_a, const RigidBody* body_b) {
+    uint64_t key = (uint64_t)(uintptr_t)body_a * 0x9E3779B97F4A7C15ull ^ (uint64_t)(uintptr_t)body_b;
+    key ^= key >> 31;
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= key >> 29;
+    return (uint32_t)key;
+}
 
-            // Integrate acceleration
-            body->linear_velocity = vector3_add(body->linear_velocity,
-                vector3_multiply(acceleration, delta_time));
+/**
+ * Last step's manifolds become the warm start source: swap the buffers
+ * and index the previous manifolds by body pair
+ */
+static void physics_world_begin_manifolds(PhysicsWorld* world) {
+    CollisionManifold* manifolds = world->previous_manifolds;
+    ContactPoint* contacts = world->previous_contact_points;
+    world->previous_manifolds = world->manifolds;
+    world->previous_contact_points = world->contact_points;
+    world->previous_manifold_count = world->manifold_count;
+    world->manifolds = manifolds;
+    world->contact_points = contacts;
+    world->manifold_count = 0;
 
-            // Apply damping
-            body->linear_velocity = vector3_multiply(body->linear_velocity,
-                1.0f - body->linear_damping * delta_time);
+    // At most half full
+    int size = 16;
+    while (size < world->previous_manifold_count * 2) size *= 2;
+    if (size > world->manifold_table_size) {
+        int* table = (int*)realloc(world->manifold_table, size * sizeof(int));
+        if (!table) {
+            world->previous_manifold_count = 0;
+            return;
+        }
+        world->manifold_table = table;
+        world->manifold_table_size = size;
+    }
+    size = world->manifold_table_size;
+    memset(world->manifold_table, 0xFF, size * sizeof(int));
+
+    for (int i = 0; i < world->previous_manifold_count; i++) {
+        const CollisionManifold* manifold = &world->previous_manifolds[i];
+        uint32_t slot = manifold_pair_hash(manifold->body_a, manifold->body_b) & (uint32_t)(size - 1);
+        while (world->manifold_table[slot] >= 0) slot = (slot + 1) & (uint32_t)(size - 1);
+        world->manifold_table[slot] = i;
+    }
+}
 
-            // Clear force accumulator
-            body->force_accumulator = vector3_create(0, 0, 0);
+// Carry the pair's accumulated impulses over from last step if the contact is still alike
+static void physics_world_warm_start(PhysicsWorld* world, CollisionManifold* manifold) {
+    if (world->previous_manifold_count == 0) return;
+
+    uint32_t mask = (uint32_t)(world->manifold_table_size - 1);
+    uint32_t slot = manifold_pair_hash(manifold->body_a, manifold->body_b) & mask;
+    for (; world->manifold_table[slot] >= 0; slot = (slot + 1) & mask) {
+        int index = world->manifold_table[slot];
+        const CollisionManifold* previous = &world->previous_manifolds[index];
+        if (previous->body_a != manifold->body_a || previous->body_b != manifold->body_b) continue;
+
+        const ContactPoint* old_contact = &world->previous_contact_points[index];
+        ContactPoint* contact = &manifold->contacts[0];
+        if (vector3_dot(old_contact->normal, contact->normal) > PHYSICS_WARM_START_COSINE) {
+            contact->impulse = old_contact->impulse;
+            contact->friction_impulse = old_contact->friction_impulse;
         }
+        return;
     }
+}
 
-    // Integrate velocities and update positions
-    for (int i = 0; i < world->body_count; i++) {
-        RigidBody* body = world->bodies[i];
-        if (body && !body->kinematic) {
-            // Integrate velocity
-            body->position = vector3_add(body->position,
-                vector3_multiply(body->linear_velocity, delta_time));
+// Narrow phase test of one broad phase pair
+static void physics_world_narrow_phase(void* user_a, void* user_b, void* context) {
+    PhysicsWorld* world = (PhysicsWorld*)context;
+    RigidBody* body_a = (RigidBody*)user_a;
+    RigidBody* body_b = (RigidBody*)user_b;
 
-            // Update transform timestamp
-            body->last_updated = (uint64_t)time(NULL);
+    world->collision_checks++;
+
+    // Check if bodies can collide
+    if (body_a->kinematic && body_b->kinematic) return;
+
+    // Same order every step, so a pair keeps its manifold key and normal direction
+    if ((uintptr_t)body_a > (uintptr_t)body_b) {
+        RigidBody* swap = body_a;
+        body_a = body_b;
+        body_b = swap;
+    }
+
+    ContactPoint contact;
+    CollisionManifold manifold = {0};
+    manifold.contacts = &contact;
+
+    if (!physics_check_collision(body_a->collider, body_b->collider, &manifold)) return;
+
+    // Triggers report overlaps but are not solved
+    if (body_a->collider->is_trigger || body_b->collider->is_trigger) {
+        if (world->on_trigger) {
+            world->on_trigger(body_a->collider, body_b->collider);
         }
+        return;
     }
 
-    // Broad phase collision detection (simplified)
-    world->collision_checks = 0;
-    world->manifold_count = 0;
+    physics_world_wake_pair(world, body_a, body_b);
 
-    for (int i = 0; i < world->body_count; i++) {
-        for (int j = i + 1; j < world->body_count; j++) {
-            RigidBody* body_a = world->bodies[i];
-            RigidBody* body_b = world->bodies[j];
+    manifold.body_a = body_a;
+    manifold.body_b = body_b;
+    physics_world_warm_start(world, &manifold);
 
-            if (!body_a || !body_b) continue;
+    // Store manifold for the solver
+    if (physics_world_reserve_manifolds(world, world->manifold_count + 1)) {
+        int index = world->manifold_count++;
+        world->contact_points[index] = contact;
+        manifold.contacts = &world->contact_points[index];
+        world->manifolds[index] = manifold;
+    }
 
-            world->collision_checks++;
+    // Call collision callback
+    if (world->on_collision) {
+        world->on_collision(&manifold);
+    }
+}
 
-            // Check if bodies can collide
-            if (body_a->kinematic && body_b->kinematic) continue;
+void physics_world_update(PhysicsWorld* world, float delta_time) {
+    if (!world || world->paused || world->fixed_timestep <= 0.0f) return;
+
+    float step = world->fixed_timestep;
+    world->accumulator += fmaxf(delta_time, 0.0f);
+    world->substeps = 0;
+    while (world->accumulator >= step && world->substeps < world->max_substeps) {
+        physics_world_step(world, step);
+        world->accumulator -= step;
+        world->substeps++;
+    }
 
-            // Narrow phase collision detection
-            CollisionManifold manifold = {0};
-            if (physics_check_collision(body_a->collider, body_b->collider, &manifold)) {
-                manifold.body_a = body_a;
-                manifold.body_b = body_b;
+    // Catching up on a long frame would make the next one longer still: drop the excess
+    if (world->accumulator >= step) {
+        world->accumulator = fmodf(world->accumulator, step);
+    }
+    world->interpolation_alpha = world->accumulator / step;
+}
 
-                // Store manifold for resolution
-                if (world->manifold_count < world->max_manifolds) {
-                    world->manifolds[world->manifold_count++] = manifold;
-                }
+// Copy the store's state of a range of slots back into their bodies' fields
+static void physics_world_sync_slots(PhysicsWorld* world, int first, int count) {
+    uint64_t now = (uint64_t)time(NULL);
+    for (int i = first; i < first + count; i++) {
+        store_read_state(&world->store, i, world->bodies[i]);
+        world->bodies[i]->last_updated = now;
+    }
+}
 
-                // Call collision callback
-                if (world->on_collision) {
-                    world->on_collision(&manifold);
-                }
-            }
-        }
+void physics_world_step(PhysicsWorld* world, float delta_time) {
+    if (!world || delta_time <= 0.0f) return;
+
+    // With sleeping turned off every body takes part again
+    if (!world->allow_sleeping && world->store.awake_count < world->store.count) {
+        physics_world_wake_all(world);
     }
 
-    // Resolve collisions (simplified)
-    for (int i = 0; i < world->manifold_count; i++) {
-        CollisionManifold* manifold = &world->manifolds[i];
+    // Where the awake bodies start from, for interpolation (sleeping bodies stay put)
+    RigidBodyStore* store = &world->store;
+    size_t awake_bytes = (size_t)store->awake_count * sizeof(float);
+    memcpy(store->previous_x, store->position_x, awake_bytes);
+    memcpy(store->previous_y, store->position_y, awake_bytes);
+    memcpy(store->previous_z, store->position_z, awake_bytes);
+
+    // Broad phase collision detection: only pairs with overlapping bounds reach the narrow phase
+    world->collision_checks = 0;
+    physics_world_begin_manifolds(world);
+
+    physics_world_sync_broad_phase(world, delta_time);
+    broad_phase_find_pairs(world->broad_phase, physics_world_narrow_phase, world);
+    physics_world_wake_joints(world);
+    physics_world_wake_queued(world);
+
+    // Integrate gravity and forces, solve contacts and joints on the velocities, then move
+    // (only the awake slots: nothing reaches the solver from a sleeping island)
+    int stepped = store->awake_count;
+    physics_select_velocity_kernel()(store, 0, stepped, world->gravity, delta_time);
+    bool solved = constraint_solver_solve(world->solver, world, delta_time);
+    physics_select_position_kernel()(store, 0, stepped, delta_time);
+
+    if (world->allow_sleeping && solved) {
+        physics_world_update_sleep(world, delta_time);
+    }
 
-        // Simple position correction
-        if (manifold->contact_count > 0) {
-            ContactPoint* contact = &manifold->contacts[0];
+    // Bodies put to sleep only move within the stepped range, so it still covers every changed slot
+    physics_world_sync_slots(world, 0, stepped);
+}
 
-            // Separate bodies
-            Vector3 correction = vector3_multiply(contact->normal, contact->penetration * 0.5f);
+void physics_world_integrate(PhysicsWorld* world, float delta_time) {
+    if (!world) return;
 
-            if (!manifold->body_a->kinematic) {
-                manifold->body_a->position = vector3_subtract(manifold->body_a->position, correction);
-            }
-            if (!manifold->body_b->kinematic) {
-                manifold->body_b->position = vector3_add(manifold->body_b->position, correction);
-            }
+    physics_select_velocity_kernel()(&world->store, 0, world->store.awake_count, world->gravity, delta_time);
+    physics_select_position_kernel()(&world->store, 0, world->store.awake_count, delta_time);
+}
 
-            // Apply impulse
-            float impulse = contact->impulse;
-            if (!manifold->body_a->kinematic) {
-                manifold->body_a->linear_velocity = vector3_add(manifold->body_a->linear_velocity,
-                    vector3_multiply(contact->normal, -impulse / manifold->body_a->mass));
-            }
-            if (!manifold->body_b->kinematic) {
-                manifold->body_b->linear_velocity = vector3_add(manifold->body_b->linear_velocity,
-                    vector3_multiply(contact->normal, impulse / manifold->body_b->mass));
-            }
+void physics_world_sync_bodies(PhysicsWorld* world) {
+    if (!world) return;
+
+    physics_world_sync_slots(world, 0, world->body_count);
+}
+
+bool physics_world_set_broad_phase(PhysicsWorld* world, BroadPhaseType type) {
+    if (!world) return false;
+
+    BroadPhase* broad_phase = broad_phase_create(type, BROAD_PHASE_DEFAULT_MARGIN);
+    if (!broad_phase) return false;
+
+    // Proxies belong to the old broad phase; bodies re-register on the next update
+    physics_world_wake_all(world);
+    for (int i = 0; i < world->body_count; i++) {
+        if (world->bodies[i]) {
+            world->bodies[i]->broad_phase_proxy = BROAD_PHASE_NULL_PROXY;
         }
     }
 
-    world->constraints_solved = world->manifold_count;
+    broad_phase_destroy(world->broad_phase);
+    world->broad_phase = broad_phase;
+    return true;
+}
+
+bool physics_world_set_threads(PhysicsWorld* world, int num_threads) {
+    if (!world) return false;
+    return constraint_solver_set_threads(world->solver, num_threads);
 }
 
 bool physics_world_add_body(PhysicsWorld* world, RigidBody* body) {
-    if (!world || !body || world->body_count >= world->max_bodies) {
+    if (!world || !body || body->world || world->body_count >= world->max_bodies) {
         return false;
     }
 
-    world->bodies[world->body_count++] = body;
+    int slot = world->body_count++;
+    world->bodies[slot] = body;
+    store_write_state(&world->store, slot, body);
+    store_write_properties(&world->store, slot, body);
+    store_snap_previous(&world->store, slot);
+    world->store.sleep_time[slot] = 0.0f;
+    world->store.count = world->body_count;
+
+    body->world = world;
+    body->store_index = slot;
+    body->sleeping = false;
+    body->sleep_next = NULL;
+    body->wake_queued = false;
+
+    // Join the awake range ahead of the sleeping bodies
+    physics_world_swap_slots(world, slot, world->store.awake_count++);
     return true;
 }
 
 bool physics_world_remove_body(PhysicsWorld* world, RigidBody* body) {
-    if (!world || !body) return false;
+    if (!world || !body || body->world != world) return false;
 
-    for (int i = 0; i < world->body_count; i++) {
-        if (world->bodies[i] == body) {
-            // Shift remaining bodies
-            for (int j = i; j < world->body_count - 1; j++) {
-                world->bodies[j] = world->bodies[j + 1];
-            }
-            world->body_count--;
+    // Whatever rested on the body has to fall
+    if (body->sleeping) {
+        physics_world_wake_island(world, body);
+    }
+
+    if (body->broad_phase_proxy != BROAD_PHASE_NULL_PROXY) {
+        broad_phase_destroy_proxy(world->broad_phase, body->broad_phase_proxy);
+        body->broad_phase_proxy = BROAD_PHASE_NULL_PROXY;
+    }
+
+    // Last step's manifolds must not warm start a later body at the same address
+    for (int i = 0; i < world->manifold_count; i++) {
+        CollisionManifold* manifold = &world->manifolds[i];
+        if (manifold->body_a == body || manifold->body_b == body) {
+            manifold->body_a = NULL;
+            manifold->body_b = NULL;
+        }
+    }
+
+    // Hand the state back to the body; the last awake slot fills the hole, the last slot fills that
+    store_read_state(&world->store, body->store_index, body);
+    physics_world_swap_slots(world, body->store_index, --world->store.awake_count);
+    int slot = body->store_index;
+    int last = world->body_count - 1;
+    if (slot != last) {
+        store_move_slot(&world->store, slot, last);
+        world->bodies[slot] = world->bodies[last];
+        world->bodies[slot]->store_index = slot;
+    }
+    world->bodies[last] = NULL;
+    world->body_count--;
+    world->store.count = world->body_count;
+
+    body->world = NULL;
+    body->store_index = -1;
+    return true;
+}
+
+bool physics_world_add_joint(PhysicsWorld* world, Joint* joint) {
+    if (!world || !joint || joint->world) return false;
+
+    if (world->joint_count >= world->max_joints) {
+        int capacity = world->max_joints > 0 ? world->max_joints * 2 : 16;
+        Joint** joints = (Joint**)realloc(world->joints, capacity * sizeof(Joint*));
+        if (!joints) return false;
+        world->joints = joints;
+        world->max_joints = capacity;
+    }
+
+    world->joints[world->joint_count++] = joint;
+    joint->world = world;
+    rigid_body_wake(joint->body_a);
+    rigid_body_wake(joint->body_b);
+    return true;
+}
+
+bool physics_world_remove_joint(PhysicsWorld* world, Joint* joint) {
+    if (!world || !joint || joint->world != world) return false;
+
+    for (int i = 0; i < world->joint_count; i++) {
+        if (world->joints[i] == joint) {
+            world->joints[i] = world->joints[--world->joint_count];
+            joint->world = NULL;
+            rigid_body_wake(joint->body_a);
+            rigid_body_wake(joint->body_b);
             return true;
         }
     }
@@ -275,7 +1043,7 @@ bool physics_world_raycast(PhysicsWorld* world, Vector3 origin, Vector3 directio
 
         // Simple sphere-ray intersection (for sphere colliders)
         if (collider->type == COLLIDER_SPHERE) {
-            Vector3 to_center = vector3_subtract(collider->body->position, origin);
+            Vector3 to_center = vector3_subtract(rigid_body_get_position(collider->body), origin);
             float distance_to_center = vector3_magnitude(to_center);
 
             if (distance_to_center <= collider->shape.sphere.radius) {
@@ -295,7 +1063,7 @@ bool physics_world_raycast(PhysicsWorld* world, Vector3 origin, Vector3 directio
 
             Vector3 closest_point = vector3_add(origin,
                 vector3_multiply(direction, projection));
-            Vector3 to_closest = vector3_subtract(closest_point, collider->body->position);
+            Vector3 to_closest = vector3_subtract(closest_point, rigid_body_get_position(collider->body));
             float distance_to_sphere = vector3_magnitude(to_closest);
 
             if (distance_to_sphere <= collider->shape.sphere.radius) {
@@ -309,7 +1077,7 @@ bool physics_world_raycast(PhysicsWorld* world, Vector3 origin, Vector3 directio
                     hit->point = vector3_add(origin, vector3_multiply(direction, hit_distance));
                     hit->body = collider->body;
                     hit->collider = collider;
-                    hit->normal = vector3_normalize(vector3_subtract(hit->point, collider->body->position));
+                    hit->normal = vector3_normalize(vector3_subtract(hit->point, rigid_body_get_position(collider->body)));
                     return true;
                 }
             }
@@ -319,33 +1087,116 @@ bool physics_world_raycast(PhysicsWorld* world, Vector3 origin, Vector3 directio
     return hit->hit;
 }
 
+// Axis-aligned boxes: separate along the axis of least overlap, contact at the overlap center
+static bool collide_boxes(Vector3 pos_a, Vector3 half_a, Vector3 pos_b, Vector3 half_b, ContactPoint* contact) {
+    float center_a[3] = { pos_a.x, pos_a.y, pos_a.z };
+    float center_b[3] = { pos_b.x, pos_b.y, pos_b.z };
+    float extent_a[3] = { half_a.x, half_a.y, half_a.z };
+    float extent_b[3] = { half_b.x, half_b.y, half_b.z };
+    float normal[3] = { 0, 0, 0 };
+    float point[3];
+    float penetration = FLT_MAX;
+    int axis = 0;
+
+    for (int k = 0; k < 3; k++) {
+        float overlap = extent_a[k] + extent_b[k] - fabsf(center_b[k] - center_a[k]);
+        if (overlap <= 0.0f) return false;
+        if (overlap < penetration) {
+            penetration = overlap;
+            axis = k;
+        }
+
+        float low = fmaxf(center_a[k] - extent_a[k], center_b[k] - extent_b[k]);
+        float high = fminf(center_a[k] + extent_a[k], center_b[k] + extent_b[k]);
+        point[k] = 0.5f * (low + high);
+    }
+    normal[axis] = center_b[axis] < center_a[axis] ? -1.0f : 1.0f;
+
+    contact->point = vector3_create(point[0], point[1], point[2]);
+    contact->normal = vector3_create(normal[0], normal[1], normal[2]);
+    contact->penetration = penetration;
+    return true;
+}
+
+// Sphere against an axis-aligned box, normal from the sphere to the box
+static bool collide_sphere_box(Vector3 center, float radius, Vector3 box, Vector3 half, ContactPoint* contact) {
+    Vector3 closest = vector3_create(fmaxf(box.x - half.x, fminf(center.x, box.x + half.x)),
+                                     fmaxf(box.y - half.y, fminf(center.y, box.y + half.y)),
+                                     fmaxf(box.z - half.z, fminf(center.z, box.z + half.z)));
+    Vector3 delta = vector3_subtract(closest, center);
+    float distance_squared = vector3_dot(delta, delta);
+    if (distance_squared >= radius * radius) return false;
+
+    if (distance_squared > 1e-12f) {
+        float distance = sqrtf(distance_squared);
+        contact->point = closest;
+        contact->normal = vector3_multiply(delta, 1.0f / distance);
+        contact->penetration = radius - distance;
+        return true;
+    }
+
+    // Center inside the box: push out through the nearest face
+    float offset[3] = { center.x - box.x, center.y - box.y, center.z - box.z };
+    float extent[3] = { half.x, half.y, half.z };
+    float normal[3] = { 0, 0, 0 };
+    float depth = FLT_MAX;
+    int axis = 0;
+    for (int k = 0; k < 3; k++) {
+        float to_face = extent[k] - fabsf(offset[k]);
+        if (to_face < depth) {
+            depth = to_face;
+            axis = k;
+        }
+    }
+    normal[axis] = offset[axis] < 0.0f ? 1.0f : -1.0f;
+
+    contact->point = center;
+    contact->normal = vector3_create(normal[0], normal[1], normal[2]);
+    contact->penetration = radius + depth;
+    return true;
+}
+
 bool physics_check_collision(Collider* collider_a, Collider* collider_b,
                            CollisionManifold* manifold) {
     if (!collider_a || !collider_b || !manifold) return false;
 
-    // Only handle sphere-sphere collisions for simplicity
-    if (collider_a->type == COLLIDER_SPHERE && collider_b->type == COLLIDER_SPHERE) {
-        Vector3 pos_a = vector3_add(collider_a->body->position, collider_a->offset);
-        Vector3 pos_b = vector3_add(collider_b->body->position, collider_b->offset);
+    Vector3 pos_a = vector3_add(rigid_body_get_position(collider_a->body), collider_a->offset);
+    Vector3 pos_b = vector3_add(rigid_body_get_position(collider_b->body), collider_b->offset);
+    ContactPoint* contact = &manifold->contacts[0];
+    bool hit = false;
 
+    if (collider_a->type == COLLIDER_SPHERE && collider_b->type == COLLIDER_SPHERE) {
         float distance = vector3_distance(pos_a, pos_b);
         float combined_radius = collider_a->shape.sphere.radius + collider_b->shape.sphere.radius;
 
         if (distance < combined_radius) {
-            // Collision detected
-            manifold->contact_count = 1;
-            manifold->contacts[0].point = vector3_add(pos_a,
-                vector3_multiply(vector3_normalize(vector3_subtract(pos_b, pos_a)),
-                collider_a->shape.sphere.radius));
-            manifold->contacts[0].normal = vector3_normalize(vector3_subtract(pos_b, pos_a));
-            manifold->contacts[0].penetration = combined_radius - distance;
-            manifold->contacts[0].impulse = 0.0f; // Would calculate based on velocities
-
-            return true;
+            // Coincident centers have no direction: separate upwards
+            Vector3 normal = distance > 1e-6f ? vector3_multiply(vector3_subtract(pos_b, pos_a), 1.0f / distance)
+                                              : vector3_create(0, 1, 0);
+            contact->point = vector3_add(pos_a, vector3_multiply(normal, collider_a->shape.sphere.radius));
+            contact->normal = normal;
+            contact->penetration = combined_radius - distance;
+            hit = true;
         }
+    } else if (collider_a->type == COLLIDER_BOX && collider_b->type == COLLIDER_BOX) {
+        hit = collide_boxes(pos_a, collider_a->shape.box.half_extents,
+                            pos_b, collider_b->shape.box.half_extents, contact);
+    } else if (collider_a->type == COLLIDER_SPHERE && collider_b->type == COLLIDER_BOX) {
+        hit = collide_sphere_box(pos_a, collider_a->shape.sphere.radius,
+                                 pos_b, collider_b->shape.box.half_extents, contact);
+    } else if (collider_a->type == COLLIDER_BOX && collider_b->type == COLLIDER_SPHERE) {
+        hit = collide_sphere_box(pos_b, collider_b->shape.sphere.radius,
+                                 pos_a, collider_a->shape.box.half_extents, contact);
+        contact->normal = vector3_multiply(contact->normal, -1.0f);
     }
 
-    return false;
+    if (hit) {
+        // Accumulated impulses start at zero; the world carries them over between steps
+        manifold->contact_count = 1;
+        contact->impulse = 0.0f;
+        contact->friction_impulse = vector3_create(0, 0, 0);
+    }
+    return hit;
 }
 
 // ============================================================================
@@ -392,6 +1243,8 @@ RigidBody* rigid_body_create(float mass, Vector3 position, Quaternion rotation)
     body->collider = NULL;
     body->kinematic = false;
     body->sleeping = false;
+    body->sleep_next = NULL;
+    body->wake_queued = false;
 
     // Simulation properties
     body->linear_damping = 0.1f;
@@ -405,6 +1258,11 @@ RigidBody* rigid_body_create(float mass, Vector3 position, Quaternion rotation)
     // Performance
     body->last_updated = (uint64_t)time(NULL);
     body->needs_update = false;
+    body->broad_phase_proxy = BROAD_PHASE_NULL_PROXY;
+
+    // World storage
+    body->world = NULL;
+    body->store_index = -1;
 
     return body;
 }
@@ -412,6 +1270,20 @@ RigidBody* rigid_body_create(float mass, Vector3 position, Quaternion rotation)
 void rigid_body_destroy(RigidBody* body) {
     if (!body) return;
 
+    // Leave the world so its store and broad phase drop the body
+    if (body->world) {
+        physics_world_remove_body(body->world, body);
+    }
+
+    // Joints outlive the body but no longer hold it
+    for (int i = 0; i < body->joint_count; i++) {
+        Joint* joint = body->joints[i];
+        if (joint->body_a == body) joint->body_a = NULL;
+        if (joint->body_b == body) joint->body_b = NULL;
+        joint->enabled = false;
+    }
+    free(body->joints);
+
     // Destroy collider if owned by this body
     if (body->collider) {
         collider_destroy(body->collider);
@@ -423,10 +1295,18 @@ void rigid_body_destroy(RigidBody* body) {
 void rigid_body_apply_force(RigidBody* body, Vector3 force, Vector3 world_point) {
     if (!body || body->kinematic) return;
 
-    body->force_accumulator = vector3_add(body->force_accumulator, force);
+    rigid_body_wake(body);
+    if (body->world) {
+        RigidBodyStore* store = &body->world->store;
+        store->force_x[body->store_index] += force.x;
+        store->force_y[body->store_index] += force.y;
+        store->force_z[body->store_index] += force.z;
+    } else {
+        body->force_accumulator = vector3_add(body->force_accumulator, force);
+    }
 
     // Calculate torque if point is not at center of mass
-    Vector3 r = vector3_subtract(world_point, body->position);
+    Vector3 r = vector3_subtract(world_point, rigid_body_get_position(body));
     Vector3 torque = vector3_cross(r, force);
     body->torque_accumulator = vector3_add(body->torque_accumulator, torque);
 }
@@ -435,11 +1315,11 @@ void rigid_body_apply_impulse(RigidBody* body, Vector3 impulse, Vector3 world_po
     if (!body || body->kinematic) return;
 
     // Apply immediate velocity change
-    body->linear_velocity = vector3_add(body->linear_velocity,
-        vector3_multiply(impulse, 1.0f / body->mass));
+    rigid_body_set_velocity(body, vector3_add(rigid_body_get_velocity(body),
+        vector3_multiply(impulse, 1.0f / body->mass)));
 
     // Apply angular impulse
-    Vector3 r = vector3_subtract(world_point, body->position);
+    Vector3 r = vector3_subtract(world_point, rigid_body_get_position(body));
     Vector3 angular_impulse = vector3_cross(r, impulse);
     // Simplified: would need to transform by inverse inertia tensor
     body->angular_velocity = vector3_add(body->angular_velocity, angular_impulse);
@@ -453,43 +1333,164 @@ void rigid_body_apply_torque(RigidBody* body, Vector3 torque) {
 
 void rigid_body_set_position(RigidBody* body, Vector3 position) {
     if (!body) return;
+    rigid_body_wake(body);
     body->position = position;
+    if (body->world) {
+        store_set_position(&body->world->store, body->store_index, position);
+        store_snap_previous(&body->world->store, body->store_index);
+    }
     body->needs_update = true;
 }
 
+Vector3 rigid_body_get_position(RigidBody* body) {
+    if (!body) return vector3_create(0, 0, 0);
+    return body->world ? store_position(&body->world->store, body->store_index) : body->position;
+}
+
+Vector3 rigid_body_get_velocity(RigidBody* body) {
+    if (!body) return vector3_create(0, 0, 0);
+    return body->world ? store_velocity(&body->world->store, body->store_index) : body->linear_velocity;
+}
+
+void rigid_body_set_velocity(RigidBody* body, Vector3 velocity) {
+    if (!body) return;
+    if (velocity.x != 0.0f || velocity.y != 0.0f || velocity.z != 0.0f) {
+        rigid_body_wake(body);
+    }
+    body->linear_velocity = velocity;
+    if (body->world) {
+        store_set_velocity(&body->world->store, body->store_index, velocity);
+    }
+}
+
+void rigid_body_set_mass(RigidBody* body, float mass) {
+    if (!body || mass <= 0.0f) return;
+    body->mass = mass;
+    rigid_body_wake(body);
+    if (body->world) {
+        store_write_properties(&body->world->store, body->store_index, body);
+    }
+}
+
+void rigid_body_set_kinematic(RigidBody* body, bool kinematic) {
+    if (!body) return;
+    body->kinematic = kinematic;
+    rigid_body_wake(body);
+    if (body->world) {
+        store_write_properties(&body->world->store, body->store_index, body);
+    }
+}
+
+void rigid_body_set_damping(RigidBody* body, float linear_damping, float angular_damping) {
+    if (!body) return;
+    body->linear_damping = linear_damping;
+    body->angular_damping = angular_damping;
+    if (body->world) {
+        store_write_properties(&body->world->store, body->store_index, body);
+    }
+}
+
+void rigid_body_set_gravity_scale(RigidBody* body, float gravity_scale) {
+    if (!body) return;
+    body->gravity_scale = gravity_scale;
+    rigid_body_wake(body);
+    if (body->world) {
+        store_write_properties(&body->world->store, body->store_index, body);
+    }
+}
+
 void rigid_body_set_rotation(RigidBody* body, Quaternion rotation) {
     if (!body) return;
     body->rotation = quaternion_normalize(rotation);
     body->needs_update = true;
 }
 
-Matrix4x4 rigid_body_get_transform(RigidBody* body) {
+// Rotation matrix of a unit quaternion with the translation in the last column
+static Matrix4x4 transform_from(Quaternion q, Vector3 position) {
     Matrix4x4 transform = {0};
 
+    transform.m[0][0] = 1 - 2 * (q.y * q.y + q.z * q.z);
+    transform.m[0][1] = 2 * (q.x * q.y - q.z * q.w);
+    transform.m[0][2] = 2 * (q.x * q.z + q.y * q.w);
+    transform.m[1][0] = 2 * (q.x * q.y + q.z * q.w);
+    transform.m[1][1] = 1 - 2 * (q.x * q.x + q.z * q.z);
+    transform.m[1][2] = 2 * (q.y * q.z - q.x * q.w);
+    transform.m[2][0] = 2 * (q.x * q.z - q.y * q.w);
+    transform.m[2][1] = 2 * (q.y * q.z + q.x * q.w);
+    transform.m[2][2] = 1 - 2 * (q.x * q.x + q.y * q.y);
+
+    transform.m[0][3] = position.x;
+    transform.m[1][3] = position.y;
+    transform.m[2][3] = position.z;
+    transform.m[3][3] = 1;
+
+    return transform;
+}
+
+Matrix4x4 rigid_body_get_transform(RigidBody* body) {
     if (!body) {
         // Return identity matrix
-        transform.m[0][0] = 1; transform.m[1][1] = 1;
-        transform.m[2][2] = 1; transform.m[3][3] = 1;
-        return transform;
+        return transform_from(quaternion_identity(), vector3_create(0, 0, 0));
     }
 
-    // Simplified: would build proper transformation matrix
-    // For now, return identity
-    transform.m[0][0] = 1; transform.m[1][1] = 1;
-    transform.m[2][2] = 1; transform.m[3][3] = 1;
+    return transform_from(body->rotation, rigid_body_get_position(body));
+}
 
-    return transform;
+Vector3 rigid_body_get_interpolated_position(RigidBody* body, float alpha) {
+    if (!body) return vector3_create(0, 0, 0);
+    if (!body->world) return body->position;
+
+    const RigidBodyStore* store = &body->world->store;
+    int slot = body->store_index;
+    alpha = fmaxf(0.0f, fminf(alpha, 1.0f));
+    return vector3_create(store->previous_x[slot] + (store->position_x[slot] - store->previous_x[slot]) * alpha,
+                          store->previous_y[slot] + (store->position_y[slot] - store->previous_y[slot]) * alpha,
+                          store->previous_z[slot] + (store->position_z[slot] - store->previous_z[slot]) * alpha);
+}
+
+Matrix4x4 rigid_body_get_interpolated_transform(RigidBody* body, float alpha) {
+    if (!body) return rigid_body_get_transform(NULL);
+    return transform_from(body->rotation, rigid_body_get_interpolated_position(body, alpha));
+}
+
+AABB rigid_body_get_bounds(RigidBody* body) {
+    AABB bounds = {{0, 0, 0}, {0, 0, 0}};
+    if (!body) return bounds;
+
+    Vector3 position = rigid_body_get_position(body);
+    bounds.min = position;
+    bounds.max = position;
+    if (body->collider) {
+        collider_get_bounds(body->collider, &bounds.min, &bounds.max);
+        bounds.min = vector3_add(bounds.min, position);
+        bounds.max = vector3_add(bounds.max, position);
+    }
+
+    return bounds;
 }
 
 void rigid_body_sleep(RigidBody* body) {
     if (!body) return;
+
+    // In a world the body sleeps alone: it is its own island
+    if (body->world && !body->sleeping) {
+        body->sleep_next = body;
+        physics_world_deactivate(body->world, body);
+    }
     body->sleeping = true;
-    body->linear_velocity = vector3_create(0, 0, 0);
+    rigid_body_set_velocity(body, vector3_create(0, 0, 0));
     body->angular_velocity = vector3_create(0, 0, 0);
 }
 
 void rigid_body_wake(RigidBody* body) {
     if (!body) return;
+
+    if (body->world) {
+        if (body->sleeping) {
+            physics_world_wake_island(body->world, body);
+        }
+        body->world->store.sleep_time[body->store_index] = 0.0f;
+    }
     body->sleeping = false;
 }
 
@@ -526,6 +1527,16 @@ Collider* collider_create_sphere(float radius) {
     return collider;
 }
 
+Collider* collider_create_box(Vector3 half_extents) {
+    Collider* collider = collider_create_sphere(0.0f);
+    if (!collider) return NULL;
+
+    collider->type = COLLIDER_BOX;
+    collider->shape.box.half_extents = half_extents;
+
+    return collider;
+}
+
 void collider_destroy(Collider* collider) {
     if (!collider) return;
 
@@ -581,6 +1592,112 @@ void collider_get_bounds(Collider* collider, Vector3* min, Vector3* max) {
     *max = vector3_add(*max, collider->offset);
 }
 
+// ============================================================================
+// Joint Implementation
+// ============================================================================
+
+static bool body_add_joint(RigidBody* body, Joint* joint) {
+    Joint** joints = (Joint**)realloc(body->joints, (body->joint_count + 1) * sizeof(Joint*));
+    if (!joints) return false;
+
+    joints[body->joint_count++] = joint;
+    body->joints = joints;
+    return true;
+}
+
+static void body_remove_joint(RigidBody* body, Joint* joint) {
+    for (int i = 0; i < body->joint_count; i++) {
+        if (body->joints[i] == joint) {
+            body->joints[i] = body->joints[--body->joint_count];
+            return;
+        }
+    }
+}
+
+// Common setup: anchors are stored relative to each body's position
+static Joint* joint_create(JointType type, RigidBody* body_a, RigidBody* body_b, Vector3 anchor) {
+    if (!body_a || !body_b || body_a == body_b) return NULL;
+
+    Joint* joint = (Joint*)calloc(1, sizeof(Joint));
+    if (!joint) return NULL;
+
+    // Generate unique ID
+    static int id_counter = 0;
+    sprintf(joint->id, "joint_%d", id_counter++);
+
+    joint->type = type;
+    joint->body_a = body_a;
+    joint->body_b = body_b;
+    joint->anchor_a = vector3_subtract(anchor, rigid_body_get_position(body_a));
+    joint->anchor_b = vector3_subtract(anchor, rigid_body_get_position(body_b));
+
+    // Unbreakable until joint_set_break_forces
+    joint->enabled = true;
+    joint->break_force = FLT_MAX;
+    joint->break_torque = FLT_MAX;
+
+    joint->impulse = vector3_create(0, 0, 0);
+    joint->world = NULL;
+
+    if (!body_add_joint(body_a, joint)) {
+        free(joint);
+        return NULL;
+    }
+    if (!body_add_joint(body_b, joint)) {
+        body_remove_joint(body_a, joint);
+        free(joint);
+        return NULL;
+    }
+
+    return joint;
+}
+
+Joint* joint_create_fixed(RigidBody* body_a, RigidBody* body_b, Vector3 anchor) {
+    return joint_create(JOINT_FIXED, body_a, body_b, anchor);
+}
+
+Joint* joint_create_hinge(RigidBody* body_a, RigidBody* body_b, Vector3 anchor, Vector3 axis) {
+    Joint* joint = joint_create(JOINT_HINGE, body_a, body_b, anchor);
+    if (!joint) return NULL;
+
+    joint->data.hinge.axis = vector3_normalize(axis);
+    joint->data.hinge.min_angle = -(float)M_PI;
+    joint->data.hinge.max_angle = (float)M_PI;
+
+    return joint;
+}
+
+Joint* joint_create_ball_socket(RigidBody* body_a, RigidBody* body_b, Vector3 anchor) {
+    Joint* joint = joint_create(JOINT_BALL_SOCKET, body_a, body_b, anchor);
+    if (!joint) return NULL;
+
+    joint->data.ball_socket.cone_limit = (float)M_PI;
+
+    return joint;
+}
+
+void joint_destroy(Joint* joint) {
+    if (!joint) return;
+
+    if (joint->world) {
+        physics_world_remove_joint(joint->world, joint);
+    }
+    if (joint->body_a) body_remove_joint(joint->body_a, joint);
+    if (joint->body_b) body_remove_joint(joint->body_b, joint);
+
+    free(joint);
+}
+
+void joint_set_break_forces(Joint* joint, float break_force, float break_torque) {
+    if (!joint) return;
+    joint->break_force = break_force;
+    joint->break_torque = break_torque;
+}
+
+bool joint_is_broken(Joint* joint) {
+    return joint ? !joint->enabled : false;
+}
+
 // ============================================================================
 // Utility Functions
 // ============================================================================
@@ -632,9 +1749,11 @@ void physics_world_debug_draw(PhysicsWorld* world) {
     if (!world) return;
 
     printf("Physics World Debug:\n");
-    printf("- Bodies: %d/%d\n", world->body_count, world->max_bodies);
+    printf("- Bodies: %d/%d (awake: %d)\n", world->body_count, world->max_bodies, world->store.awake_count);
     printf("- Colliders: %d/%d\n", world->collider_count, world->max_colliders);
     printf("- Manifolds: %d/%d\n", world->manifold_count, world->max_manifolds);
     printf("- Collision checks: %d\n", world->collision_checks);
     printf("- Constraints solved: %d\n", world->constraints_solved);
+    printf("- Joints: %d\n", world->joint_count);
+    printf("- Islands: %d (solver threads: %d)\n", world->island_count, constraint_solver_threads(world->solver));
 }
\ No newline at end of file
@@ -69,7 +69,7 @@ float vector3_distance(Vector3 a, Vector3 b) {
 // ============================================================================
 
 Quaternion quaternion_identity(void) {
-    Quaternion q = {0, 0, 0, 1};
+    Quaternion q = {1, 0, 0, 0};    // w, x, y, z
     return q;
 }
 
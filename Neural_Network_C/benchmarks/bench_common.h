@@ -0,0 +1,299 @@
+/*
+ * Neural Network System - Benchmark Helpers
+ * Shared timing and data utilities for the benchmark programs, and the
+ * dense MLP fixture the training benchmarks build their networks from
+ */
+
+#ifndef NEURAL_NETWORK_BENCH_COMMON_H
+#define NEURAL_NETWORK_BENCH_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "../headers/neural_net.h"
+#include "../headers/layers.h"
+#include "../headers/activations.h"
+#include "../headers/losses.h"
+#include "../headers/dense_kernels.h"
+#include "../headers/tensor_arena.h"
+
+#define BENCH_TEACHER_HIDDEN 32     // Hidden units of the make_dataset teacher
+
+/**
+ * @brief Monotonic wall-clock time in seconds
+ */
+static inline double bench_now(void) {
+#ifdef _WIN32
+    return (double)clock() / CLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * @brief Fill array with uniform random values in [-1, 1]
+ */
+static inline void bench_fill_random(float* data, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        data[i] = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
+    }
+}
+
+/**
+ * @brief Pick a repetition count so a run lasts roughly target_seconds
+ * @param single_run_seconds Duration of one calibration run
+ * @param target_seconds Desired total duration
+ */
+static inline int bench_repetitions(double single_run_seconds, double target_seconds) {
+    if (single_run_seconds <= 0.0) return 1000;
+    int reps = (int)(target_seconds / single_run_seconds);
+    return reps < 1 ? 1 : (reps > 100000 ? 100000 : reps);
+}
+
+// ============================================================================
+// Dense MLP Fixture
+// ============================================================================
+
+static inline Tensor* bench_dense_forward(Layer* layer, Tensor* x) {
+    DenseData* data = (DenseData*)layer->layer_data;
+    Tensor* y = tensor_create(NULL, (int[]){ x->shape[0], data->params.output_size }, 2);
+    if (!y || !dense_forward_fused(x, data->weights, data->biases, data->params.activation, y)) {
+        tensor_destroy(y);
+        return NULL;
+    }
+    layer->input_cache = x;
+    layer->output_cache = y;
+    return y;
+}
+
+static inline Tensor* bench_dense_backward(Layer* layer, Tensor* grad) {
+    DenseData* data = (DenseData*)layer->layer_data;
+    Tensor* x = layer->input_cache;
+    Tensor* dx = tensor_create(NULL, x->shape, x->ndim);
+    if (dx && !dense_backward_fused(x, data->weights, layer->output_cache, data->params.activation, grad,
+                                    data->weight_gradients, data->bias_gradients, dx, true)) {
+        tensor_destroy(dx);
+        return NULL;
+    }
+    return dx;
+}
+
+/**
+ * @brief Dense layer over the fused dense kernels, weights uniform in +-sqrt(3 / inputs)
+ * @param data_size Bytes of layer data; a struct larger than DenseData must start with it
+ */
+static inline Layer* bench_dense_create_sized(size_t data_size, int inputs, int outputs,
+                                              void (*activation)(float*, int)) {
+    Layer* layer = (Layer*)calloc(1, sizeof(Layer));
+    DenseData* data = (DenseData*)calloc(1, data_size);
+    data->params.input_size = inputs;
+    data->params.output_size = outputs;
+    data->params.activation = activation;
+    data->weights = tensor_create(NULL, (int[]){ outputs, inputs }, 2);
+    data->biases = tensor_create(NULL, (int[]){ outputs }, 1);
+    data->weight_gradients = tensor_create(NULL, (int[]){ outputs, inputs }, 2);
+    data->bias_gradients = tensor_create(NULL, (int[]){ outputs }, 1);
+
+    bench_fill_random(data->weights->data, data->weights->size);
+    float gain = sqrtf(3.0f / inputs);
+    for (int i = 0; i < data->weights->size; i++) data->weights->data[i] *= gain;
+
+    layer->type = LAYER_DENSE;
+    layer->trainable = true;
+    layer->layer_data = data;
+    layer->forward = bench_dense_forward;
+    layer->backward = bench_dense_backward;
+    layer->input_ndim = layer->output_ndim = 1;
+    layer->input_shape = (int*)malloc(sizeof(int));
+    layer->output_shape = (int*)malloc(sizeof(int));
+    layer->input_shape[0] = inputs;
+    layer->output_shape[0] = outputs;
+    layer->num_weights = layer->num_biases = 1;
+    layer->weights = &data->weights;
+    layer->biases = &data->biases;
+    layer->weight_gradients = &data->weight_gradients;
+    layer->bias_gradients = &data->bias_gradients;
+    return layer;
+}
+
+static inline Layer* bench_dense_create(int inputs, int outputs, void (*activation)(float*, int)) {
+    return bench_dense_create_sized(sizeof(DenseData), inputs, outputs, activation);
+}
+
+/**
+ * @brief ReLU MLP with a linear output layer and identical initial weights for every call (seeded)
+ * @param widths num_layers + 1 sizes: the input, then each layer's output
+ */
+static inline void bench_network_init(NeuralNetwork* net, const int* widths, int num_layers) {
+    srand(1234);
+    memset(net, 0, sizeof(*net));
+    net->num_layers = num_layers;
+    net->layers = (Layer**)malloc(num_layers * sizeof(Layer*));
+    for (int l = 0; l < num_layers; l++) {
+        bool last = l == num_layers - 1;
+        net->layers[l] = bench_dense_create(widths[l], widths[l + 1], last ? activation_linear : activation_relu);
+        snprintf(net->layers[l]->name, sizeof(net->layers[l]->name), "dense_%d (%dx%d)",
+                 l, widths[l], widths[l + 1]);
+    }
+}
+
+/**
+ * @brief Free the layers; release mixed precision, pruning etc. first
+ */
+static inline void bench_network_free(NeuralNetwork* net) {
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        DenseData* data = (DenseData*)layer->layer_data;
+        tensor_destroy(data->weights);
+        tensor_destroy(data->biases);
+        tensor_destroy(data->weight_gradients);
+        tensor_destroy(data->bias_gradients);
+        free(layer->input_shape);
+        free(layer->output_shape);
+        free(data);
+        free(layer);
+    }
+    free(net->layers);
+}
+
+static inline Tensor* bench_forward(NeuralNetwork* net, Tensor* x) {
+    for (int l = 0; x && l < net->num_layers; l++) x = net->layers[l]->forward(net->layers[l], x);
+    return x;
+}
+
+/**
+ * @brief Forward, softmax cross-entropy and backward of the loss gradient times grad_scale
+ *
+ * Step temporaries come from arena, which is reset afterwards.
+ *
+ * @return Batch loss
+ */
+static inline float bench_forward_backward(NeuralNetwork* net, TensorArena* arena, Tensor* x,
+                                           const int* labels, int classes, float grad_scale) {
+    TensorArena* previous = tensor_arena_activate(arena);
+    Tensor* logits = bench_forward(net, x);
+    Tensor* grad = logits ? tensor_create(NULL, logits->shape, logits->ndim) : NULL;
+    float loss = 0.0f;
+
+    if (grad) {
+        loss = loss_softmax_crossentropy_sparse(logits->data, labels, logits->shape[0], classes, grad->data);
+        if (grad_scale != 1.0f) {
+            for (int i = 0; i < grad->size; i++) grad->data[i] *= grad_scale;
+        }
+        for (int l = net->num_layers - 1; grad && l >= 0; l--) {
+            grad = net->layers[l]->backward(net->layers[l], grad);
+        }
+    }
+    tensor_arena_activate(previous);
+    tensor_arena_reset(arena);
+    return loss;
+}
+
+static inline void bench_zero_gradients(NeuralNetwork* net) {
+    for (int l = 0; l < net->num_layers; l++) {
+        DenseData* data = (DenseData*)net->layers[l]->layer_data;
+        tensor_zero(data->weight_gradients);
+        tensor_zero(data->bias_gradients);
+    }
+}
+
+/**
+ * @brief Plain SGD update, then zero the gradients
+ */
+static inline void bench_sgd_update(NeuralNetwork* net, float learning_rate) {
+    for (int l = 0; l < net->num_layers; l++) {
+        DenseData* data = (DenseData*)net->layers[l]->layer_data;
+        Tensor* params[2] = { data->weights, data->biases };
+        Tensor* grads[2] = { data->weight_gradients, data->bias_gradients };
+        for (int p = 0; p < 2; p++) {
+            for (int i = 0; i < params[p]->size; i++) params[p]->data[i] -= learning_rate * grads[p]->data[i];
+        }
+    }
+    bench_zero_gradients(net);
+}
+
+/**
+ * @brief One unscaled SGD step
+ * @return Batch loss
+ */
+static inline float bench_train_step(NeuralNetwork* net, TensorArena* arena, Tensor* x, const int* labels,
+                                     int classes, float learning_rate) {
+    float loss = bench_forward_backward(net, arena, x, labels, classes, 1.0f);
+    bench_sgd_update(net, learning_rate);
+    return loss;
+}
+
+/**
+ * @brief Fraction of rows whose largest logit is the label
+ */
+static inline float bench_accuracy(NeuralNetwork* net, TensorArena* arena, Tensor* x, const int* labels,
+                                   int classes) {
+    TensorArena* previous = tensor_arena_activate(arena);
+    Tensor* logits = bench_forward(net, x);
+    int correct = 0;
+    for (int r = 0; logits && r < logits->shape[0]; r++) {
+        const float* row = logits->data + (size_t)r * classes;
+        int best = 0;
+        for (int c = 1; c < classes; c++) if (row[c] > row[best]) best = c;
+        correct += best == labels[r];
+    }
+    tensor_arena_activate(previous);
+    tensor_arena_reset(arena);
+    return (float)correct / x->shape[0];
+}
+
+/**
+ * @brief Random inputs labelled by a fixed random two-layer teacher: learnable, not linearly trivial
+ *
+ * The teacher is drawn (seeded) on the first call, so every later call
+ * labels with the same function. Every call must use the same feature and
+ * class counts.
+ *
+ * @param x Inputs to fill (rows x features)
+ * @param labels Label per row
+ * @param classes Number of classes
+ */
+static inline void bench_make_dataset(Tensor* x, int* labels, int classes) {
+    static float* teacher = NULL;
+    static int features = 0;
+    if (!teacher) {
+        features = x->shape[1];
+        teacher = (float*)malloc((size_t)BENCH_TEACHER_HIDDEN * (features + classes) * sizeof(float));
+        if (!teacher) return;
+        srand(99);
+        bench_fill_random(teacher, (size_t)BENCH_TEACHER_HIDDEN * features);
+        bench_fill_random(teacher + (size_t)BENCH_TEACHER_HIDDEN * features, (size_t)classes * BENCH_TEACHER_HIDDEN);
+    }
+    const float* w1 = teacher;
+    const float* w2 = teacher + (size_t)BENCH_TEACHER_HIDDEN * features;
+
+    int rows = x->shape[0];
+    bench_fill_random(x->data, x->size);
+    for (int r = 0; r < rows; r++) {
+        const float* xr = x->data + (size_t)r * features;
+        float hidden[BENCH_TEACHER_HIDDEN];
+        for (int h = 0; h < BENCH_TEACHER_HIDDEN; h++) {
+            float sum = 0.0f;
+            for (int f = 0; f < features; f++) sum += w1[(size_t)h * features + f] * xr[f];
+            hidden[h] = tanhf(sum);
+        }
+        int best = 0;
+        float best_score = -INFINITY;
+        for (int c = 0; c < classes; c++) {
+            float score = 0.0f;
+            for (int h = 0; h < BENCH_TEACHER_HIDDEN; h++) score += w2[(size_t)c * BENCH_TEACHER_HIDDEN + h] * hidden[h];
+            if (score > best_score) {
+                best_score = score;
+                best = c;
+            }
+        }
+        labels[r] = best;
+    }
+}
+
+#endif // NEURAL_NETWORK_BENCH_COMMON_H
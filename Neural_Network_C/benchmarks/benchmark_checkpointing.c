@@ -0,0 +1,276 @@
+/*
+ * Neural Network System - Gradient Checkpointing Benchmark
+ * Trains one step of a 50-layer MLP with and without checkpointing: checks
+ * that gradients are bitwise identical, that recomputed segments replay
+ * their dropout masks, and reports activation memory against step time for
+ * fixed segment lengths and for one chosen from a memory budget
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_checkpointing.c src/checkpointing.c src/memory_plan.c \
+ *        src/conv_kernels.c src/dense_kernels.c src/rnn_kernels.c src/vec_math.c src/gemm.c \
+ *        src/tensor.c src/tensor_arena.c src/thread_pool.c src/activations.c \
+ *        -o benchmark_checkpointing -lm -pthread
+ * Usage: ./benchmark_checkpointing [batch, default 256] [width, default 512]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/layers.h"
+#include "../headers/gemm.h"
+#include "../headers/tensor_arena.h"
+#include "../headers/checkpointing.h"
+#include "bench_common.h"
+
+#define CKPT_BENCH_LAYERS 50
+#define CKPT_BENCH_DROPOUT 0.1f
+#define CKPT_BENCH_STEPS 3
+
+/**
+ * @brief Dense layer data with dropout mask tracking; DenseData first so the
+ *        memory planner and the shared fixture read it like a real dense layer
+ */
+typedef struct {
+    DenseData dense;
+    uint32_t mask_hash;         // Dropout mask of the first forward in this step
+    int forwards;               // Forward calls in this step
+    bool mask_replayed;         // Every later forward reproduced mask_hash
+} BenchDense;
+
+// ============================================================================
+// Benchmark Layers
+// ============================================================================
+
+static Tensor* dropout_dense_forward(Layer* layer, Tensor* x) {
+    BenchDense* data = (BenchDense*)layer->layer_data;
+    Tensor* y = bench_dense_forward(layer, x);
+    if (!y) return NULL;
+
+    float rate = data->dense.params.dropout_rate;
+    if (rate > 0.0f) {
+        uint32_t hash = 2166136261u;
+        float scale = 1.0f / (1.0f - rate);
+        for (int i = 0; i < y->size; i++) {
+            bool drop = (float)rand() / RAND_MAX < rate;
+            y->data[i] = drop ? 0.0f : y->data[i] * scale;
+            hash = (hash ^ (uint32_t)drop) * 16777619u;
+        }
+        if (data->forwards == 0) data->mask_hash = hash;
+        else if (hash != data->mask_hash) data->mask_replayed = false;
+    }
+    data->forwards++;
+    return y;
+}
+
+static Tensor* dropout_dense_backward(Layer* layer, Tensor* grad) {
+    BenchDense* data = (BenchDense*)layer->layer_data;
+
+    // Dropped units have a zero output, so the ReLU derivative already masks
+    // them; kept ones were scaled. In place: nobody else reads the gradient
+    float rate = data->dense.params.dropout_rate;
+    if (rate > 0.0f) {
+        float scale = 1.0f / (1.0f - rate);
+        for (int i = 0; i < grad->size; i++) grad->data[i] *= scale;
+    }
+    return bench_dense_backward(layer, grad);
+}
+
+static void bench_deep_network_init(NeuralNetwork* net, int width, float dropout) {
+    memset(net, 0, sizeof(*net));
+    net->num_layers = CKPT_BENCH_LAYERS;
+    net->layers = (Layer**)malloc(CKPT_BENCH_LAYERS * sizeof(Layer*));
+    for (int l = 0; l < CKPT_BENCH_LAYERS; l++) {
+        bool hidden = l < CKPT_BENCH_LAYERS - 1;
+        Layer* layer = bench_dense_create_sized(sizeof(BenchDense), width, width,
+                                                hidden ? activation_relu : activation_linear);
+        BenchDense* data = (BenchDense*)layer->layer_data;
+        data->dense.params.dropout_rate = hidden && l % 2 ? dropout : 0.0f;
+        layer->forward = dropout_dense_forward;
+        layer->backward = dropout_dense_backward;
+
+        bench_fill_random(layer->biases[0]->data, width);
+        for (int i = 0; i < width; i++) layer->biases[0]->data[i] *= 0.01f;
+        net->layers[l] = layer;
+    }
+}
+
+// ============================================================================
+// Training Step
+// ============================================================================
+
+/**
+ * @brief Result of one forward/backward step
+ */
+typedef struct {
+    double seconds;             // Fastest step
+    size_t peak_bytes;          // Step arena peak + segment arena peak
+    int recomputed;             // Layer forwards repeated in backward
+    bool masks_replayed;        // Recomputed dropout masks matched the forward pass
+    bool ok;                    // Forward and backward succeeded
+} StepResult;
+
+/**
+ * @brief Forward, MSE gradient against zero, backward; step temporaries in an arena
+ */
+static StepResult run_steps(NeuralNetwork* net, TensorArena* arena, Tensor* x, int steps) {
+    StepResult result = { 1e30, 0, 0, true, true };
+    CheckpointState* state = (CheckpointState*)net->checkpoint;
+
+    for (int step = 0; step < steps && result.ok; step++) {
+        for (int l = 0; l < net->num_layers; l++) {
+            Layer* layer = net->layers[l];
+            BenchDense* data = (BenchDense*)layer->layer_data;
+            data->forwards = 0;
+            data->mask_replayed = true;
+            memset(layer->weight_gradients[0]->data, 0, layer->weight_gradients[0]->size * sizeof(float));
+            memset(layer->bias_gradients[0]->data, 0, layer->bias_gradients[0]->size * sizeof(float));
+        }
+        srand(7);
+        arena->peak = 0;
+        if (state) state->arena->peak = 0;
+
+        double start = bench_now();
+        TensorArena* previous = tensor_arena_activate(arena);
+        Tensor* output = x;
+        if (state) {
+            output = neural_network_checkpoint_forward(net, x);
+        } else {
+            output = bench_forward(net, x);
+        }
+
+        Tensor* grad = output ? tensor_create(output->data, output->shape, output->ndim) : NULL;
+        if (grad) {
+            for (int i = 0; i < grad->size; i++) grad->data[i] *= 2.0f / grad->size;
+            if (state) {
+                result.ok = neural_network_checkpoint_backward(net, grad);
+            } else {
+                for (int l = net->num_layers - 1; grad && l >= 0; l--) {
+                    grad = net->layers[l]->backward(net->layers[l], grad);
+                }
+                result.ok = grad != NULL;
+            }
+        } else {
+            result.ok = false;
+        }
+        tensor_arena_activate(previous);
+        double seconds = bench_now() - start;
+
+        if (seconds < result.seconds) result.seconds = seconds;
+        result.peak_bytes = arena->peak + (state ? state->arena->peak : 0);
+        result.recomputed = state ? state->recomputed_layers : 0;
+        for (int l = 0; l < net->num_layers; l++) {
+            if (!((BenchDense*)net->layers[l]->layer_data)->mask_replayed) result.masks_replayed = false;
+        }
+        tensor_arena_reset(arena);
+    }
+    return result;
+}
+
+static float** snapshot_gradients(const NeuralNetwork* net) {
+    float** copy = (float**)malloc(net->num_layers * sizeof(float*));
+    for (int l = 0; l < net->num_layers; l++) {
+        const Tensor* g = net->layers[l]->weight_gradients[0];
+        copy[l] = (float*)malloc(g->size * sizeof(float));
+        memcpy(copy[l], g->data, g->size * sizeof(float));
+    }
+    return copy;
+}
+
+static bool same_gradients(const NeuralNetwork* net, float** expected) {
+    for (int l = 0; l < net->num_layers; l++) {
+        const Tensor* g = net->layers[l]->weight_gradients[0];
+        if (memcmp(g->data, expected[l], g->size * sizeof(float)) != 0) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int batch = argc > 1 ? atoi(argv[1]) : 256;
+    int width = argc > 2 ? atoi(argv[2]) : 512;
+    if (batch <= 0) batch = 256;
+    if (width <= 0) width = 512;
+    srand(42);
+
+    NeuralNetwork net;
+    TensorArena* arena = tensor_arena_create(0);
+    Tensor* x = tensor_create(NULL, (int[]){ batch, width }, 2);
+    bench_fill_random(x->data, x->size);
+    int failures = 0;
+
+    // Without dropout, checkpointed gradients must match the plain pass bit for bit
+    bench_deep_network_init(&net, width, 0.0f);
+    run_steps(&net, arena, x, 1);
+    float** expected = snapshot_gradients(&net);
+    bool identical = true;
+    for (int k = 1; k <= 10 && identical; k += 3) {
+        neural_network_set_checkpointing(&net, k);
+        StepResult r = run_steps(&net, arena, x, 1);
+        identical = r.ok && same_gradients(&net, expected);
+    }
+    printf("Gradients with segments of 1/4/7/10 layers equal the plain pass bit for bit %s\n",
+           identical ? "✅" : "❌");
+    failures += identical ? 0 : 1;
+    for (int l = 0; l < net.num_layers; l++) free(expected[l]);
+    free(expected);
+    neural_network_release_checkpointing(&net);
+    bench_network_free(&net);
+
+    // With dropout on every other layer: memory and time per segment length
+    bench_deep_network_init(&net, width, CKPT_BENCH_DROPOUT);
+    size_t plain_estimate = neural_network_checkpoint_memory(&net, batch, 0);
+    size_t budget = plain_estimate / 3;
+    int auto_interval = neural_network_checkpoint_interval_for_budget(&net, batch, budget);
+
+    printf("\n%d-layer MLP, width %d, batch %d, dropout %.1f on every other layer (%s GEMM)\n",
+           CKPT_BENCH_LAYERS, width, batch, CKPT_BENCH_DROPOUT, gemm_kernel_name(gemm_get_kernel()));
+    printf("Budget %.1f MB (a third of the plain estimate) -> segments of %d layers\n\n",
+           budget / (1024.0 * 1024.0), auto_interval);
+    printf("%-12s | %11s | %11s | %10s | %9s | %8s | %s\n", "Segment", "Estimate MB", "Measured MB",
+           "Step ms", "Recompute", "Time", "Masks");
+
+    static const int intervals[] = { 0, 25, 10, 7, 5, 2, 1 };
+    StepResult plain = { 0 };
+    size_t sqrt_peak = 0;
+    bool budget_met = false;
+    for (size_t i = 0; i <= sizeof(intervals) / sizeof(intervals[0]); i++) {
+        bool is_auto = i == sizeof(intervals) / sizeof(intervals[0]);
+        int k = is_auto ? auto_interval : intervals[i];
+        neural_network_set_checkpointing(&net, k);
+        StepResult r = run_steps(&net, arena, x, CKPT_BENCH_STEPS);
+        if (k == 0) plain = r;
+
+        size_t estimate = neural_network_checkpoint_memory(&net, batch, k);
+        if (is_auto) budget_met = estimate <= budget;
+
+        char label[32];
+        if (is_auto) snprintf(label, sizeof(label), "auto (%d)", k);
+        else if (k == 0) snprintf(label, sizeof(label), "off");
+        else snprintf(label, sizeof(label), "%d", k);
+
+        if (k == 7) sqrt_peak = r.peak_bytes;
+        bool ok = r.ok && r.masks_replayed;
+        printf("%-12s | %11.1f | %11.1f | %10.2f | %9d | %7.2fx | %s\n", label,
+               estimate / (1024.0 * 1024.0), r.peak_bytes / (1024.0 * 1024.0), r.seconds * 1e3,
+               r.recomputed, r.seconds / plain.seconds, ok ? "✅" : "❌");
+        failures += ok ? 0 : 1;
+    }
+
+    // Segments of about sqrt(L) layers should hold well under half the activations
+    bool saved = sqrt_peak > 0 && sqrt_peak * 2 < plain.peak_bytes;
+    printf("\nSegments of 7 layers: %.0f%% of the plain step's memory %s\n",
+           100.0 * sqrt_peak / plain.peak_bytes, saved ? "✅" : "❌");
+    printf("Auto-selected segments fit the budget %s\n", budget_met ? "✅" : "❌");
+    failures += (saved ? 0 : 1) + (budget_met ? 0 : 1);
+
+    neural_network_release_checkpointing(&net);
+    bench_network_free(&net);
+    tensor_destroy(x);
+    tensor_arena_destroy(arena);
+
+    printf("\n%s\n", failures ? "❌ Checkpointing checks failed" : "✅ All checkpointing checks passed");
+    return failures ? 1 : 0;
+}
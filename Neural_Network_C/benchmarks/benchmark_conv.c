@@ -0,0 +1,429 @@
+/*
+ * Neural Network System - Convolution Benchmark
+ * Checks im2col and Winograd convolution (NCHW and NHWC, with and without
+ * fused max pooling) against a direct loop, then reports images/sec across
+ * kernel sizes and batch sizes
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_conv.c src/conv_kernels.c src/dense_kernels.c \
+ *        src/gemm.c src/tensor.c src/tensor_arena.c src/thread_pool.c src/activations.c \
+ *        src/vec_math.c -o benchmark_conv -lm -pthread
+ * Usage: ./benchmark_conv
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/activations.h"
+#include "../headers/conv_kernels.h"
+#include "bench_common.h"
+
+// ============================================================================
+// Direct Reference (NCHW, ReLU)
+// ============================================================================
+
+static void ref_forward(const ConvShape* s, const float* x, const float* k, const float* b,
+                        float* y, int out_h, int out_w) {
+    int ks = s->kernel_size;
+    for (int n = 0; n < s->batch; n++) {
+        for (int o = 0; o < s->out_channels; o++) {
+            for (int oy = 0; oy < out_h; oy++) {
+                for (int ox = 0; ox < out_w; ox++) {
+                    double sum = b[o];
+                    for (int c = 0; c < s->in_channels; c++) {
+                        for (int kh = 0; kh < ks; kh++) {
+                            int iy = oy * s->stride - s->padding + kh;
+                            if (iy < 0 || iy >= s->in_height) continue;
+                            for (int kw = 0; kw < ks; kw++) {
+                                int ix = ox * s->stride - s->padding + kw;
+                                if (ix < 0 || ix >= s->in_width) continue;
+                                sum += (double)x[((n * s->in_channels + c) * s->in_height + iy) * s->in_width + ix] *
+                                       k[((o * s->in_channels + c) * ks + kh) * ks + kw];
+                            }
+                        }
+                    }
+                    y[((n * s->out_channels + o) * out_h + oy) * out_w + ox] = sum > 0.0 ? (float)sum : 0.0f;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Max pooling that also scatters an upstream gradient to the argmax
+ */
+static void ref_pool(const ConvShape* s, const float* y, int out_h, int out_w,
+                     float* pooled, const float* grad, float* unpooled_grad) {
+    int ph = (out_h - s->pool_size) / s->pool_stride + 1;
+    int pw = (out_w - s->pool_size) / s->pool_stride + 1;
+    int planes = s->batch * s->out_channels;
+
+    if (unpooled_grad) memset(unpooled_grad, 0, (size_t)planes * out_h * out_w * sizeof(float));
+    for (int p = 0; p < planes; p++) {
+        const float* plane = y + (size_t)p * out_h * out_w;
+        for (int py = 0; py < ph; py++) {
+            for (int px = 0; px < pw; px++) {
+                int best = py * s->pool_stride * out_w + px * s->pool_stride;
+                for (int wy = 0; wy < s->pool_size; wy++) {
+                    for (int wx = 0; wx < s->pool_size; wx++) {
+                        int pos = (py * s->pool_stride + wy) * out_w + px * s->pool_stride + wx;
+                        if (plane[pos] > plane[best]) best = pos;
+                    }
+                }
+                size_t out = ((size_t)p * ph + py) * pw + px;
+                if (pooled) pooled[out] = plane[best];
+                if (unpooled_grad) unpooled_grad[(size_t)p * out_h * out_w + best] += grad[out];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Kernel, bias and input gradients from the unpooled output gradient
+ */
+static void ref_backward(const ConvShape* s, const float* x, const float* k, const float* y,
+                         const float* grad, int out_h, int out_w,
+                         float* dk, float* db, float* dx) {
+    int ks = s->kernel_size;
+    memset(dk, 0, (size_t)s->out_channels * s->in_channels * ks * ks * sizeof(float));
+    memset(db, 0, (size_t)s->out_channels * sizeof(float));
+    memset(dx, 0, (size_t)s->batch * s->in_channels * s->in_height * s->in_width * sizeof(float));
+
+    for (int n = 0; n < s->batch; n++) {
+        for (int o = 0; o < s->out_channels; o++) {
+            for (int oy = 0; oy < out_h; oy++) {
+                for (int ox = 0; ox < out_w; ox++) {
+                    size_t out = ((size_t)(n * s->out_channels + o) * out_h + oy) * out_w + ox;
+                    float d = y[out] > 0.0f ? grad[out] : 0.0f;
+                    db[o] += d;
+                    for (int c = 0; c < s->in_channels; c++) {
+                        for (int kh = 0; kh < ks; kh++) {
+                            int iy = oy * s->stride - s->padding + kh;
+                            if (iy < 0 || iy >= s->in_height) continue;
+                            for (int kw = 0; kw < ks; kw++) {
+                                int ix = ox * s->stride - s->padding + kw;
+                                if (ix < 0 || ix >= s->in_width) continue;
+                                size_t xi = ((size_t)(n * s->in_channels + c) * s->in_height + iy) * s->in_width + ix;
+                                size_t ki = ((size_t)(o * s->in_channels + c) * ks + kh) * ks + kw;
+                                dk[ki] += d * x[xi];
+                                dx[xi] += d * k[ki];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief NCHW <-> NHWC for a batch of c x h x w maps
+ */
+static void convert_layout(const float* src, float* dst, int n, int c, int h, int w, bool to_nhwc) {
+    for (int b = 0; b < n; b++) {
+        for (int ch = 0; ch < c; ch++) {
+            for (int i = 0; i < h * w; i++) {
+                size_t nchw = ((size_t)b * c + ch) * h * w + i;
+                size_t nhwc = ((size_t)b * h * w + i) * c + ch;
+                if (to_nhwc) dst[nhwc] = src[nchw]; else dst[nchw] = src[nhwc];
+            }
+        }
+    }
+}
+
+static float relative_error(const float* x, const float* ref, size_t count) {
+    float worst = 0.0f, scale = 1.0f;
+    for (size_t i = 0; i < count; i++) {
+        float d = fabsf(x[i] - ref[i]);
+        if (d > worst) worst = d;
+        if (fabsf(ref[i]) > scale) scale = fabsf(ref[i]);
+    }
+    return worst / scale;
+}
+
+static Tensor* make_tensor(size_t count, bool random) {
+    Tensor* t = tensor_create(NULL, (int[]){(int)count}, 1);
+    if (t && random) bench_fill_random(t->data, t->size);
+    return t;
+}
+
+// ============================================================================
+// Correctness
+// ============================================================================
+
+typedef struct {
+    int batch, in_c, size, out_c, kernel, stride, padding;
+} CheckCase;
+
+static const CheckCase check_cases[] = {
+    { 2,  3,  9,  4, 3, 1, 1 },     // Winograd with odd output (edge tiles)
+    { 3, 16, 12, 16, 3, 1, 0 },
+    { 2,  5, 11,  6, 5, 2, 2 },
+    { 2,  8, 10, 12, 1, 1, 0 },     // 1x1: GEMM directly on the input
+    { 2,  4, 10,  3, 3, 2, 1 },
+};
+
+/**
+ * @brief Run one configuration forward and backward against the reference
+ * @return Number of mismatching results
+ */
+static int check_configuration(const CheckCase* cc, ConvLayout layout, ConvAlgorithm algorithm,
+                               int pool) {
+    ConvShape s = { cc->batch, cc->in_c, cc->size, cc->size, cc->out_c, cc->kernel,
+                    cc->stride, cc->padding, pool, pool, CONV_LAYOUT_NCHW };
+    int out_h = conv_output_size(cc->size, cc->kernel, cc->stride, cc->padding);
+    int out_w = out_h;
+    int res_h, res_w;
+    s.layout = layout;
+    if (!conv_output_dims(&s, &res_h, &res_w)) return 1;
+
+    size_t in_count = (size_t)cc->batch * cc->in_c * cc->size * cc->size;
+    size_t conv_count = (size_t)cc->batch * cc->out_c * out_h * out_w;
+    size_t res_count = (size_t)cc->batch * cc->out_c * res_h * res_w;
+    size_t k_count = (size_t)cc->out_c * cc->in_c * cc->kernel * cc->kernel;
+
+    Tensor* x = make_tensor(in_count, true);
+    Tensor* k = make_tensor(k_count, true);
+    Tensor* b = make_tensor(cc->out_c, true);
+    Tensor* grad = make_tensor(res_count, true);
+    Tensor* x_l = make_tensor(in_count, false);
+    Tensor* y = make_tensor(res_count, false);
+    Tensor* g_l = make_tensor(res_count, false);
+    Tensor* dk = make_tensor(k_count, false);
+    Tensor* db = make_tensor(cc->out_c, false);
+    Tensor* dx = make_tensor(in_count, false);
+    float* ref_y = malloc(conv_count * sizeof(float));
+    float* ref_res = malloc(res_count * sizeof(float));
+    float* ref_grad = malloc(conv_count * sizeof(float));
+    float* ref_dk = malloc(k_count * sizeof(float));
+    float* ref_db = malloc(cc->out_c * sizeof(float));
+    float* ref_dx = malloc(in_count * sizeof(float));
+    float* tmp = malloc((in_count > res_count ? in_count : res_count) * sizeof(float));
+    int* indices = malloc(res_count * sizeof(int));
+    int failures = 0;
+
+    // Reference in NCHW
+    s.layout = CONV_LAYOUT_NCHW;
+    ref_forward(&s, x->data, k->data, b->data, ref_y, out_h, out_w);
+    if (pool) {
+        ref_pool(&s, ref_y, out_h, out_w, ref_res, grad->data, ref_grad);
+    } else {
+        memcpy(ref_res, ref_y, conv_count * sizeof(float));
+        memcpy(ref_grad, grad->data, conv_count * sizeof(float));
+    }
+    ref_backward(&s, x->data, k->data, ref_y, ref_grad, out_h, out_w, ref_dk, ref_db, ref_dx);
+    s.layout = layout;
+
+    // Engine in the requested layout
+    bool nhwc = layout == CONV_LAYOUT_NHWC;
+    if (nhwc) {
+        convert_layout(x->data, x_l->data, cc->batch, cc->in_c, cc->size, cc->size, true);
+        convert_layout(grad->data, g_l->data, cc->batch, cc->out_c, res_h, res_w, true);
+    } else {
+        tensor_copy_into(x_l, x);
+        tensor_copy_into(g_l, grad);
+    }
+
+    if (!conv2d_forward(&s, algorithm, x_l, k, b, activation_relu, y, pool ? indices : NULL, NULL) ||
+        !conv2d_backward(&s, x_l, k, y, pool ? indices : NULL, activation_relu, g_l, dk, db, dx,
+                         false, NULL)) {
+        failures++;
+    } else {
+        const float tolerance = 1e-4f;
+        const float* y_nchw = y->data;
+        const float* dx_nchw = dx->data;
+        if (nhwc) {
+            convert_layout(y->data, tmp, cc->batch, cc->out_c, res_h, res_w, false);
+            y_nchw = tmp;
+        }
+        if (relative_error(y_nchw, ref_res, res_count) > tolerance) failures++;
+        if (nhwc) {
+            convert_layout(dx->data, tmp, cc->batch, cc->in_c, cc->size, cc->size, false);
+            dx_nchw = tmp;
+        }
+        if (relative_error(dx_nchw, ref_dx, in_count) > tolerance) failures++;
+        if (relative_error(dk->data, ref_dk, k_count) > tolerance) failures++;
+        if (relative_error(db->data, ref_db, cc->out_c) > tolerance) failures++;
+    }
+
+    tensor_destroy(x); tensor_destroy(k); tensor_destroy(b); tensor_destroy(grad);
+    tensor_destroy(x_l); tensor_destroy(y); tensor_destroy(g_l);
+    tensor_destroy(dk); tensor_destroy(db); tensor_destroy(dx);
+    free(ref_y); free(ref_res); free(ref_grad); free(ref_dk); free(ref_db); free(ref_dx);
+    free(tmp); free(indices);
+    return failures;
+}
+
+// ============================================================================
+// Throughput
+// ============================================================================
+
+typedef struct {
+    int in_c, size, out_c, kernel, stride, padding;
+    const char* label;
+} BenchLayer;
+
+static const BenchLayer bench_layers[] = {
+    {  3, 32, 32, 3, 1, 1, "stem 3x3" },
+    { 32, 32, 32, 1, 1, 0, "1x1" },
+    { 32, 32, 64, 3, 1, 1, "3x3" },
+    { 64, 16, 64, 3, 1, 1, "3x3 deep" },
+    { 32, 32, 32, 5, 1, 2, "5x5" },
+    { 32, 32, 64, 3, 2, 1, "3x3 s2" },
+};
+
+static const int bench_batches[] = { 1, 16, 64 };
+
+/**
+ * @brief Images per second of one forward configuration
+ */
+static double forward_rate(const ConvShape* s, ConvAlgorithm algorithm,
+                           Tensor* x, Tensor* k, Tensor* b, Tensor* y, float* workspace) {
+    double start = bench_now();
+    conv2d_forward(s, algorithm, x, k, b, activation_relu, y, NULL, workspace);
+    int reps = bench_repetitions(bench_now() - start, 0.2);
+
+    start = bench_now();
+    for (int r = 0; r < reps; r++) {
+        conv2d_forward(s, algorithm, x, k, b, activation_relu, y, NULL, workspace);
+    }
+    return s->batch * reps / (bench_now() - start);
+}
+
+static int run_throughput(void) {
+    printf("\n%-9s %5s | %9s %9s %9s %9s | %9s %9s | %s\n", "layer", "batch",
+           "direct", "im2col", "winograd", "NHWC", "train", "pool", "auto");
+
+    for (size_t l = 0; l < sizeof(bench_layers) / sizeof(bench_layers[0]); l++) {
+        const BenchLayer* bl = &bench_layers[l];
+
+        for (size_t bi = 0; bi < sizeof(bench_batches) / sizeof(bench_batches[0]); bi++) {
+            int batch = bench_batches[bi];
+            ConvShape s = { batch, bl->in_c, bl->size, bl->size, bl->out_c, bl->kernel,
+                            bl->stride, bl->padding, 0, 0, CONV_LAYOUT_NCHW };
+            int out_h, out_w;
+            if (!conv_output_dims(&s, &out_h, &out_w)) return 1;
+
+            size_t in_count = (size_t)batch * bl->in_c * bl->size * bl->size;
+            size_t out_count = (size_t)batch * bl->out_c * out_h * out_w;
+            size_t k_count = (size_t)bl->out_c * bl->in_c * bl->kernel * bl->kernel;
+            ConvShape pooled = s;
+            pooled.pool_size = 2;
+            pooled.pool_stride = 2;
+            ConvShape nhwc = s;
+            nhwc.layout = CONV_LAYOUT_NHWC;
+
+            // One scratch buffer sized for every variant timed below
+            const ConvShape* variants[] = { &s, &pooled, &nhwc };
+            size_t ws = 0;
+            for (int v = 0; v < 3; v++) {
+                for (int a = CONV_ALGO_AUTO; a <= CONV_ALGO_WINOGRAD; a++) {
+                    size_t size = conv_workspace_size(variants[v], (ConvAlgorithm)a);
+                    if (size > ws) ws = size;
+                }
+            }
+
+            Tensor* x = make_tensor(in_count, true);
+            Tensor* k = make_tensor(k_count, true);
+            Tensor* b = make_tensor(bl->out_c, true);
+            Tensor* y = make_tensor(out_count, false);
+            Tensor* g = make_tensor(out_count, true);
+            Tensor* dk = make_tensor(k_count, false);
+            Tensor* db = make_tensor(bl->out_c, false);
+            Tensor* dx = make_tensor(in_count, false);
+            float* workspace = malloc((ws ? ws : 1) * sizeof(float));
+            if (!x || !k || !b || !y || !g || !dk || !db || !dx || !workspace) {
+                printf("❌ Memory allocation failed\n");
+                return 1;
+            }
+
+            // Direct loop on a few images, scaled
+            ConvShape few = s;
+            few.batch = batch < 2 ? batch : 2;
+            double start = bench_now();
+            ref_forward(&few, x->data, k->data, b->data, y->data, out_h, out_w);
+            double direct = few.batch / (bench_now() - start);
+
+            double im2col = forward_rate(&s, CONV_ALGO_IM2COL, x, k, b, y, workspace);
+            double winograd = conv_winograd_supported(&s)
+                                  ? forward_rate(&s, CONV_ALGO_WINOGRAD, x, k, b, y, workspace) : 0.0;
+
+            double nhwc_rate = forward_rate(&nhwc, CONV_ALGO_AUTO, x, k, b, y, workspace);
+
+            // Training step: forward + backward with all gradients
+            start = bench_now();
+            int reps = 0;
+            do {
+                conv2d_forward(&s, CONV_ALGO_AUTO, x, k, b, activation_relu, y, NULL, workspace);
+                conv2d_backward(&s, x, k, y, NULL, activation_relu, g, dk, db, dx, false, workspace);
+                reps++;
+            } while (bench_now() - start < 0.2);
+            double train = (double)batch * reps / (bench_now() - start);
+
+            // Fused pooling, when the output is even enough to pool
+            Tensor* yp_fit = NULL;
+            double pool_rate = 0.0;
+            int ph, pw;
+            if (conv_output_dims(&pooled, &ph, &pw)) {
+                yp_fit = make_tensor((size_t)batch * bl->out_c * ph * pw, false);
+                start = bench_now();
+                reps = 0;
+                do {
+                    conv2d_forward(&pooled, CONV_ALGO_AUTO, x, k, b, activation_relu, yp_fit,
+                                   NULL, workspace);
+                    reps++;
+                } while (bench_now() - start < 0.2);
+                pool_rate = (double)batch * reps / (bench_now() - start);
+            }
+
+            printf("%-9s %5d | %9.0f %9.0f ", bl->label, batch, direct, im2col);
+            if (winograd > 0.0) printf("%9.0f ", winograd); else printf("%9s ", "-");
+            printf("%9.0f | %9.0f %9.0f | %s\n", nhwc_rate, train, pool_rate,
+                   conv_select_algorithm(&s) == CONV_ALGO_WINOGRAD ? "winograd" : "im2col");
+
+            tensor_destroy(x); tensor_destroy(k); tensor_destroy(b); tensor_destroy(y);
+            tensor_destroy(g); tensor_destroy(dk); tensor_destroy(db);
+            tensor_destroy(dx); tensor_destroy(yp_fit);
+            free(workspace);
+        }
+    }
+
+    printf("\nColumns: forward images/sec (NCHW unless noted), train = forward + backward,\n");
+    printf("pool = forward with fused 2x2 max pooling\n");
+    return 0;
+}
+
+int main(void) {
+    srand(42);
+    int failures = 0;
+
+    printf("Convolution benchmark (kernel: %s)\n", gemm_kernel_name(gemm_get_kernel()));
+
+    for (size_t c = 0; c < sizeof(check_cases) / sizeof(check_cases[0]); c++) {
+        for (int layout = CONV_LAYOUT_NCHW; layout <= CONV_LAYOUT_NHWC; layout++) {
+            for (int pool = 0; pool <= 2; pool += 2) {
+                ConvShape probe = { check_cases[c].batch, check_cases[c].in_c, check_cases[c].size,
+                                    check_cases[c].size, check_cases[c].out_c, check_cases[c].kernel,
+                                    check_cases[c].stride, check_cases[c].padding, 0, 0,
+                                    (ConvLayout)layout };
+                failures += check_configuration(&check_cases[c], (ConvLayout)layout,
+                                                CONV_ALGO_IM2COL, pool);
+                if (conv_winograd_supported(&probe)) {
+                    failures += check_configuration(&check_cases[c], (ConvLayout)layout,
+                                                    CONV_ALGO_WINOGRAD, pool);
+                }
+            }
+        }
+    }
+
+    if (failures) {
+        printf("❌ %d convolution results disagreed with the direct reference\n", failures);
+        return 1;
+    }
+    printf("✅ im2col and Winograd match the direct reference (NCHW/NHWC, pooled and unpooled)\n");
+
+    return run_throughput();
+}
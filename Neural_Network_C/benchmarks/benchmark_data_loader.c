@@ -0,0 +1,357 @@
+/*
+ * Neural Network System - Data Loader Benchmark
+ * Writes an MNIST-sized dataset file, checks that a shuffled epoch delivers
+ * every record exactly once and intact, then times training epochs of a
+ * small MLP fed from memory (batches sliced on the training thread) and from
+ * the streaming loader with and without prefetch, through mmap and pread,
+ * with the file in the page cache and evicted
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_data_loader.c src/data_loader.c src/tensor.c \
+ *        src/tensor_arena.c src/gemm.c src/vec_math.c src/thread_pool.c \
+ *        -o benchmark_data_loader -lm -pthread
+ * Usage: ./benchmark_data_loader [records, default 60000] [dataset path, default benchmark_data.nnd]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../headers/data_loader.h"
+#include "../headers/gemm.h"
+#include "bench_common.h"
+
+#define LOADER_INPUTS 784
+#define LOADER_HIDDEN 128
+#define LOADER_CLASSES 10
+#define LOADER_BATCH 64
+
+/**
+ * @brief Deterministic record contents, so any record can be checked in isolation
+ */
+static float record_value(int record, int j) {
+    return (float)((record * 31 + j * 7) % 251) / 251.0f;
+}
+
+static void make_record(int record, float* x, float* y) {
+    for (int j = 0; j < LOADER_INPUTS; j++) x[j] = record_value(record, j);
+    x[0] = (float)record;           // Exact in float below 2^24
+    for (int c = 0; c < LOADER_CLASSES; c++) y[c] = (c == record % LOADER_CLASSES) ? 1.0f : 0.0f;
+}
+
+static bool write_dataset(const char* path, int records) {
+    DataFileWriter writer;
+    if (!data_file_create(&writer, path, LOADER_INPUTS, LOADER_CLASSES)) return false;
+
+    float x[LOADER_INPUTS], y[LOADER_CLASSES];
+    bool ok = true;
+    for (int r = 0; r < records && ok; r++) {
+        make_record(r, x, y);
+        ok = data_file_append(&writer, x, y, 1);
+    }
+    return data_file_finish(&writer) && ok;
+}
+
+/**
+ * @brief Drop the file from the page cache so the next epoch reads from storage
+ */
+static void evict_dataset(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+// ============================================================================
+// Training Step
+// ============================================================================
+
+typedef struct {
+    float* w1;                      // LOADER_HIDDEN x LOADER_INPUTS
+    float* b1;
+    float* w2;                      // LOADER_CLASSES x LOADER_HIDDEN
+    float* b2;
+    float* hidden;                  // Batch activations and gradients
+    float* output;
+    float* d_hidden;
+    float* d_w1;
+    float* d_w2;
+} LoaderModel;
+
+static void model_init(LoaderModel* model) {
+    model->w1 = (float*)malloc(LOADER_HIDDEN * LOADER_INPUTS * sizeof(float));
+    model->b1 = (float*)calloc(LOADER_HIDDEN, sizeof(float));
+    model->w2 = (float*)malloc(LOADER_CLASSES * LOADER_HIDDEN * sizeof(float));
+    model->b2 = (float*)calloc(LOADER_CLASSES, sizeof(float));
+    model->hidden = (float*)malloc(LOADER_BATCH * LOADER_HIDDEN * sizeof(float));
+    model->output = (float*)malloc(LOADER_BATCH * LOADER_CLASSES * sizeof(float));
+    model->d_hidden = (float*)malloc(LOADER_BATCH * LOADER_HIDDEN * sizeof(float));
+    model->d_w1 = (float*)malloc(LOADER_HIDDEN * LOADER_INPUTS * sizeof(float));
+    model->d_w2 = (float*)malloc(LOADER_CLASSES * LOADER_HIDDEN * sizeof(float));
+
+    bench_fill_random(model->w1, LOADER_HIDDEN * LOADER_INPUTS);
+    bench_fill_random(model->w2, LOADER_CLASSES * LOADER_HIDDEN);
+    for (int i = 0; i < LOADER_HIDDEN * LOADER_INPUTS; i++) model->w1[i] *= 0.05f;
+    for (int i = 0; i < LOADER_CLASSES * LOADER_HIDDEN; i++) model->w2[i] *= 0.1f;
+}
+
+static void model_free(LoaderModel* model) {
+    free(model->w1);
+    free(model->b1);
+    free(model->w2);
+    free(model->b2);
+    free(model->hidden);
+    free(model->output);
+    free(model->d_hidden);
+    free(model->d_w1);
+    free(model->d_w2);
+}
+
+/**
+ * @brief One SGD step of a 784-128-10 ReLU MLP with MSE loss
+ * @return Batch loss
+ */
+static float train_step(LoaderModel* m, const float* x, const float* y, int rows) {
+    GemmEpilogue relu = { m->b1, GEMM_ACTIVATION_RELU, NULL };
+    GemmEpilogue linear = { m->b2, GEMM_ACTIVATION_NONE, NULL };
+    gemm_sgemm_epilogue(GEMM_NO_TRANS, GEMM_TRANS, rows, LOADER_HIDDEN, LOADER_INPUTS, 1.0f,
+                        x, LOADER_INPUTS, m->w1, LOADER_INPUTS, 0.0f, m->hidden, LOADER_HIDDEN, &relu);
+    gemm_sgemm_epilogue(GEMM_NO_TRANS, GEMM_TRANS, rows, LOADER_CLASSES, LOADER_HIDDEN, 1.0f,
+                        m->hidden, LOADER_HIDDEN, m->w2, LOADER_HIDDEN, 0.0f, m->output, LOADER_CLASSES,
+                        &linear);
+
+    // Output gradient overwrites the predictions
+    float loss = 0.0f;
+    float scale = 2.0f / (rows * LOADER_CLASSES);
+    for (int i = 0; i < rows * LOADER_CLASSES; i++) {
+        float diff = m->output[i] - y[i];
+        loss += diff * diff;
+        m->output[i] = diff * scale;
+    }
+
+    gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, LOADER_CLASSES, LOADER_HIDDEN, rows, 1.0f,
+               m->output, LOADER_CLASSES, m->hidden, LOADER_HIDDEN, 0.0f, m->d_w2, LOADER_HIDDEN);
+    gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, rows, LOADER_HIDDEN, LOADER_CLASSES, 1.0f,
+               m->output, LOADER_CLASSES, m->w2, LOADER_HIDDEN, 0.0f, m->d_hidden, LOADER_HIDDEN);
+    for (int i = 0; i < rows * LOADER_HIDDEN; i++) {
+        if (m->hidden[i] <= 0.0f) m->d_hidden[i] = 0.0f;
+    }
+    gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, LOADER_HIDDEN, LOADER_INPUTS, rows, 1.0f,
+               m->d_hidden, LOADER_HIDDEN, x, LOADER_INPUTS, 0.0f, m->d_w1, LOADER_INPUTS);
+
+    float lr = 0.01f;
+    for (int i = 0; i < LOADER_HIDDEN * LOADER_INPUTS; i++) m->w1[i] -= lr * m->d_w1[i];
+    for (int i = 0; i < LOADER_CLASSES * LOADER_HIDDEN; i++) m->w2[i] -= lr * m->d_w2[i];
+    return loss / (rows * LOADER_CLASSES);
+}
+
+// ============================================================================
+// Epoch Runners
+// ============================================================================
+
+/**
+ * @brief The in-memory pattern: shuffle indices, gather each batch on the training thread
+ */
+static double epoch_in_memory(LoaderModel* model, const float* x, const float* y, int records,
+                              int* order, float* x_batch, float* y_batch) {
+    double start = bench_now();
+
+    for (int i = records - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    for (int begin = 0; begin < records; begin += LOADER_BATCH) {
+        int rows = records - begin < LOADER_BATCH ? records - begin : LOADER_BATCH;
+        for (int r = 0; r < rows; r++) {
+            memcpy(x_batch + (size_t)r * LOADER_INPUTS, x + (size_t)order[begin + r] * LOADER_INPUTS,
+                   LOADER_INPUTS * sizeof(float));
+            memcpy(y_batch + (size_t)r * LOADER_CLASSES, y + (size_t)order[begin + r] * LOADER_CLASSES,
+                   LOADER_CLASSES * sizeof(float));
+        }
+        train_step(model, x_batch, y_batch, rows);
+    }
+    return bench_now() - start;
+}
+
+static double epoch_streamed(LoaderModel* model, DataLoader* loader, bool* failed) {
+    double start = bench_now();
+    Tensor* xb;
+    Tensor* yb;
+
+    data_loader_begin_epoch(loader);
+    while (data_loader_next(loader, &xb, &yb)) {
+        train_step(model, xb->data, yb->data, xb->shape[0]);
+    }
+    *failed = *failed || data_loader_failed(loader);
+    return bench_now() - start;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+/**
+ * @brief One shuffled epoch must be a permutation of intact records
+ */
+static int check_epoch(const char* path, int records, DataLoaderIO io, bool prefetch) {
+    DataLoaderConfig config = data_loader_config_default();
+    config.batch_size = LOADER_BATCH;
+    config.io = io;
+    config.prefetch = prefetch;
+
+    DataLoader* loader = data_loader_open(path, config);
+    if (!loader) {
+        printf("❌ Could not open %s\n", path);
+        return 1;
+    }
+
+    unsigned char* seen = (unsigned char*)calloc(records, 1);
+    float x[LOADER_INPUTS], y[LOADER_CLASSES];
+    int delivered = 0, in_place = 0, corrupt = 0, first[2] = { -1, -1 };
+
+    for (int epoch = 0; epoch < 2; epoch++) {
+        memset(seen, 0, records);
+        delivered = 0;
+        in_place = 0;
+
+        // Abandon a first pass half-way: restarting mid-epoch must not leak stale batches
+        if (epoch == 1) {
+            Tensor* xb;
+            Tensor* yb;
+            data_loader_begin_epoch(loader);
+            for (int b = 0; b < data_loader_num_batches(loader) / 2; b++) data_loader_next(loader, &xb, &yb);
+        }
+
+        Tensor* xb;
+        Tensor* yb;
+        data_loader_begin_epoch(loader);
+        while (data_loader_next(loader, &xb, &yb)) {
+            for (int r = 0; r < xb->shape[0]; r++) {
+                const float* xr = xb->data + (size_t)r * LOADER_INPUTS;
+                int record = (int)xr[0];
+                if (record < 0 || record >= records || seen[record]) {
+                    corrupt++;
+                    continue;
+                }
+                make_record(record, x, y);
+                if (memcmp(x, xr, sizeof(x)) != 0 ||
+                    memcmp(y, yb->data + (size_t)r * LOADER_CLASSES, sizeof(y)) != 0) {
+                    corrupt++;
+                }
+                if (first[epoch] < 0) first[epoch] = record;
+                in_place += (record == delivered);
+                seen[record] = 1;
+                delivered++;
+            }
+        }
+    }
+
+    data_loader_close(loader);
+    free(seen);
+
+    bool ok = delivered == records && corrupt == 0 && in_place < records / 10 && first[0] != first[1];
+    printf("%-5s %-12s: %d/%d records, %d corrupt, %d left in place %s\n", io == DATA_LOADER_MMAP ? "mmap" : "pread",
+           prefetch ? "prefetch" : "synchronous", delivered, records, corrupt, in_place, ok ? "✅" : "❌");
+    return ok ? 0 : 1;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+    int records = argc > 1 ? atoi(argv[1]) : 60000;
+    const char* path = argc > 2 ? argv[2] : "benchmark_data.nnd";
+    if (records <= 0) records = 60000;
+    srand(42);
+
+    double start = bench_now();
+    if (!write_dataset(path, records)) {
+        printf("❌ Could not write %s\n", path);
+        return 1;
+    }
+    double file_mb = (double)records * (LOADER_INPUTS + LOADER_CLASSES) * sizeof(float) / (1024.0 * 1024.0);
+    printf("Dataset: %d records of %d+%d floats (%.1f MB) written in %.2f s\n", records, LOADER_INPUTS,
+           LOADER_CLASSES, file_mb, bench_now() - start);
+    printf("Model: MLP %d-%d-%d, batch %d\n\n", LOADER_INPUTS, LOADER_HIDDEN, LOADER_CLASSES, LOADER_BATCH);
+
+    int failures = 0;
+    failures += check_epoch(path, records, DATA_LOADER_MMAP, true);
+    failures += check_epoch(path, records, DATA_LOADER_MMAP, false);
+    failures += check_epoch(path, records, DATA_LOADER_PREAD, true);
+    failures += check_epoch(path, records, DATA_LOADER_PREAD, false);
+
+    LoaderModel model;
+    model_init(&model);
+
+    // In-memory baseline: the dataset must fit in RAM
+    float* x = (float*)malloc((size_t)records * LOADER_INPUTS * sizeof(float));
+    float* y = (float*)malloc((size_t)records * LOADER_CLASSES * sizeof(float));
+    int* order = (int*)malloc(records * sizeof(int));
+    float* x_batch = (float*)malloc(LOADER_BATCH * LOADER_INPUTS * sizeof(float));
+    float* y_batch = (float*)malloc(LOADER_BATCH * LOADER_CLASSES * sizeof(float));
+    for (int r = 0; r < records; r++) {
+        make_record(r, x + (size_t)r * LOADER_INPUTS, y + (size_t)r * LOADER_CLASSES);
+        order[r] = r;
+    }
+    epoch_in_memory(&model, x, y, records, order, x_batch, y_batch);
+    double memory_seconds = epoch_in_memory(&model, x, y, records, order, x_batch, y_batch);
+    free(x);
+    free(y);
+    free(order);
+    free(x_batch);
+    free(y_batch);
+
+    printf("\n%-28s | %12s | %12s | %8s\n", "Epoch source", "Warm cache s", "Cold cache s", "Prefetch");
+    printf("%-28s | %12.3f | %12s |\n", "In-memory tensors", memory_seconds, "-");
+
+    bool failed = false;
+    for (int io = 0; io < 2; io++) {
+        double synchronous[2] = { 0.0, 0.0 };
+        for (int prefetch = 0; prefetch < 2; prefetch++) {
+            DataLoaderConfig config = data_loader_config_default();
+            config.batch_size = LOADER_BATCH;
+            config.io = io ? DATA_LOADER_PREAD : DATA_LOADER_MMAP;
+            config.prefetch = prefetch != 0;
+
+            DataLoader* loader = data_loader_open(path, config);
+            if (!loader) {
+                failures++;
+                continue;
+            }
+
+            epoch_streamed(&model, loader, &failed);
+            double warm = epoch_streamed(&model, loader, &failed);
+            evict_dataset(path);
+            double cold = epoch_streamed(&model, loader, &failed);
+            data_loader_close(loader);
+
+            char label[64];
+            snprintf(label, sizeof(label), "Loader %s, %s", io ? "pread" : "mmap",
+                     prefetch ? "prefetch" : "synchronous");
+            if (prefetch) {
+                printf("%-28s | %12.3f | %12.3f | %4.2fx/%4.2fx\n", label, warm, cold,
+                       synchronous[0] / warm, synchronous[1] / cold);
+            } else {
+                synchronous[0] = warm;
+                synchronous[1] = cold;
+                printf("%-28s | %12.3f | %12.3f |\n", label, warm, cold);
+            }
+        }
+    }
+    printf("(prefetch column: synchronous / prefetched epoch time, warm/cold; overlap needs a spare core)\n");
+
+    failures += failed ? 1 : 0;
+    model_free(&model);
+    remove(path);
+
+    printf("\n%s\n", failures ? "❌ Data loader checks failed" : "✅ All data loader checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Neural Network System - Fused Dense Benchmark
+ * Compares separate matmul / bias / activation passes against the fused
+ * dense kernels, reporting time and output-sized memory traffic
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_dense.c src/dense_kernels.c src/gemm.c \
+ *        src/tensor.c src/tensor_arena.c src/thread_pool.c src/activations.c src/vec_math.c \
+ *        -o benchmark_dense -lm -pthread
+ * Usage: ./benchmark_dense
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/activations.h"
+#include "../headers/dense_kernels.h"
+#include "bench_common.h"
+
+typedef struct {
+    int batch, in_features, out_features;
+} DenseShape;
+
+static const DenseShape shapes[] = {
+    {   64,  784,  256 },   // MNIST input layer
+    {  256,  256,  256 },
+    { 1024,  512,  512 },
+    { 4096,  128,   64 },   // large batch, narrow layer
+    { 4096,   64, 1024 },   // wide output: traffic-bound
+};
+
+// Output-sized passes over memory (reads + writes of a batch x out buffer)
+#define UNFUSED_FORWARD_PASSES 5    // GEMM write, bias read+write, activation read+write
+#define FUSED_FORWARD_PASSES 1      // GEMM write with epilogue
+#define UNFUSED_BACKWARD_PASSES 8   // copy r+w, derivative r+w, multiply r+r+w, bias sum r
+#define FUSED_BACKWARD_PASSES 3     // read y, read g, write delta (bias sum on the fly)
+
+/**
+ * @brief Forward as written before fusion: allocate, add bias, activate
+ */
+static Tensor* unfused_forward(Tensor* x, Tensor* w, Tensor* b) {
+    Tensor* y = matrix_multiply_transpose_b(x, w);
+    int rows = y->shape[0], cols = y->shape[1];
+
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) y->data[i * cols + j] += b->data[j];
+    }
+    activation_relu(y->data, y->size);
+    return y;
+}
+
+/**
+ * @brief Backward as written before fusion: derivative tensor, elementwise
+ * product, separate bias reduction, then the two GEMMs
+ */
+static void unfused_backward(Tensor* x, Tensor* w, Tensor* y, Tensor* grad,
+                             Tensor* dw, Tensor* db, Tensor* dx) {
+    Tensor* derivative = tensor_copy(y);
+    for (int i = 0; i < derivative->size; i++) {
+        derivative->data[i] = derivative->data[i] > 0.0f ? 1.0f : 0.0f;
+    }
+    Tensor* delta = tensor_multiply(grad, derivative);
+
+    int rows = delta->shape[0], cols = delta->shape[1];
+    memset(db->data, 0, db->size * sizeof(float));
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) db->data[j] += delta->data[i * cols + j];
+    }
+
+    Tensor* weight_grad = matrix_multiply_transpose_a(delta, x);
+    memcpy(dw->data, weight_grad->data, dw->size * sizeof(float));
+    Tensor* input_grad = matrix_multiply(delta, w);
+    memcpy(dx->data, input_grad->data, dx->size * sizeof(float));
+
+    tensor_destroy(derivative);
+    tensor_destroy(delta);
+    tensor_destroy(weight_grad);
+    tensor_destroy(input_grad);
+}
+
+static float max_abs_diff(const float* x, const float* y, int count) {
+    float worst = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float d = fabsf(x[i] - y[i]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+static Tensor* random_tensor(int rows, int cols) {
+    Tensor* t = tensor_create(NULL, (int[]){rows, cols}, 2);
+    if (t) bench_fill_random(t->data, t->size);
+    return t;
+}
+
+int main(void) {
+    srand(42);
+    int failures = 0;
+
+    printf("Fused dense benchmark (ReLU, kernel: %s)\n", gemm_kernel_name(gemm_get_kernel()));
+    printf("%5s %5s %5s | %-8s %9s %9s %7s | %9s %9s\n",
+           "batch", "in", "out", "pass", "unfused", "fused", "speedup", "MB before", "MB after");
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        int batch = shapes[s].batch, in = shapes[s].in_features, out = shapes[s].out_features;
+
+        Tensor* x = random_tensor(batch, in);
+        Tensor* w = random_tensor(out, in);
+        Tensor* b = random_tensor(1, out);
+        Tensor* y = random_tensor(batch, out);
+        Tensor* g = random_tensor(batch, out);
+        Tensor* g_work = random_tensor(batch, out);
+        Tensor* dw_ref = random_tensor(out, in);
+        Tensor* db_ref = random_tensor(1, out);
+        Tensor* dx_ref = random_tensor(batch, in);
+        Tensor* dw = random_tensor(out, in);
+        Tensor* db = random_tensor(1, out);
+        Tensor* dx = random_tensor(batch, in);
+        if (!x || !w || !b || !y || !g || !g_work || !dw_ref || !db_ref || !dx_ref ||
+            !dw || !db || !dx) {
+            printf("❌ Memory allocation failed\n");
+            return 1;
+        }
+
+        // Correctness against the unfused reference
+        Tensor* y_ref = unfused_forward(x, w, b);
+        dense_forward_fused(x, w, b, activation_relu, y);
+        if (max_abs_diff(y->data, y_ref->data, y->size) > 1e-4f * in) failures++;
+
+        unfused_backward(x, w, y_ref, g, dw_ref, db_ref, dx_ref);
+        tensor_copy_into(g_work, g);
+        dense_backward_fused(x, w, y, activation_relu, g_work, dw, db, dx, false);
+        if (max_abs_diff(dw->data, dw_ref->data, dw->size) > 1e-4f * batch) failures++;
+        if (max_abs_diff(db->data, db_ref->data, db->size) > 1e-4f * batch) failures++;
+        if (max_abs_diff(dx->data, dx_ref->data, dx->size) > 1e-4f * out) failures++;
+        tensor_destroy(y_ref);
+
+        // Forward timing
+        double start = bench_now();
+        tensor_destroy(unfused_forward(x, w, b));
+        int reps = bench_repetitions(bench_now() - start, 0.3);
+
+        start = bench_now();
+        for (int r = 0; r < reps; r++) tensor_destroy(unfused_forward(x, w, b));
+        double t_unfused = (bench_now() - start) / reps;
+
+        start = bench_now();
+        for (int r = 0; r < reps; r++) dense_forward_fused(x, w, b, activation_relu, y);
+        double t_fused = (bench_now() - start) / reps;
+
+        double out_mb = (double)batch * out * sizeof(float) / (1024.0 * 1024.0);
+        printf("%5d %5d %5d | %-8s %7.3fms %7.3fms %6.2fx | %9.2f %9.2f\n",
+               batch, in, out, "forward", t_unfused * 1e3, t_fused * 1e3, t_unfused / t_fused,
+               out_mb * UNFUSED_FORWARD_PASSES, out_mb * FUSED_FORWARD_PASSES);
+
+        // Backward timing (the fused path consumes its gradient, so refresh it each rep)
+        start = bench_now();
+        for (int r = 0; r < reps; r++) unfused_backward(x, w, y, g, dw_ref, db_ref, dx_ref);
+        t_unfused = (bench_now() - start) / reps;
+
+        start = bench_now();
+        for (int r = 0; r < reps; r++) tensor_copy_into(g_work, g);
+        double t_copy = (bench_now() - start) / reps;
+
+        start = bench_now();
+        for (int r = 0; r < reps; r++) {
+            tensor_copy_into(g_work, g);
+            dense_backward_fused(x, w, y, activation_relu, g_work, dw, db, dx, false);
+        }
+        t_fused = (bench_now() - start) / reps - t_copy;
+
+        printf("%5s %5s %5s | %-8s %7.3fms %7.3fms %6.2fx | %9.2f %9.2f\n",
+               "", "", "", "backward", t_unfused * 1e3, t_fused * 1e3, t_unfused / t_fused,
+               out_mb * UNFUSED_BACKWARD_PASSES, out_mb * FUSED_BACKWARD_PASSES);
+
+        tensor_destroy(x); tensor_destroy(w); tensor_destroy(b); tensor_destroy(y);
+        tensor_destroy(g); tensor_destroy(g_work);
+        tensor_destroy(dw_ref); tensor_destroy(db_ref); tensor_destroy(dx_ref);
+        tensor_destroy(dw); tensor_destroy(db); tensor_destroy(dx);
+    }
+
+    printf("\nMB columns: traffic over batch x out buffers outside the GEMM itself\n");
+
+    if (failures) {
+        printf("❌ %d fused results disagreed with the unfused reference\n", failures);
+        return 1;
+    }
+
+    printf("✅ Fused kernels match the unfused reference\n");
+    return 0;
+}
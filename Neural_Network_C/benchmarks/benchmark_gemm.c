@@ -0,0 +1,161 @@
+/*
+ * Neural Network System - GEMM Benchmark
+ * Compares the packed GEMM kernels against the original naive i-j-k loop
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_gemm.c src/gemm.c src/vec_math.c src/tensor.c \
+ *        src/tensor_arena.c src/thread_pool.c -o benchmark_gemm -lm -pthread
+ * Usage: ./benchmark_gemm [threads]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/gemm.h"
+#include "bench_common.h"
+
+typedef struct {
+    const char* label;
+    int m, n, k;
+} GemmShape;
+
+static const GemmShape shapes[] = {
+    { "square",  128,  128,  128 },
+    { "square",  256,  256,  256 },
+    { "square",  512,  512,  512 },
+    { "square", 1024, 1024, 1024 },
+    { "skinny",   32, 1024, 1024 },  // small batch through a wide layer
+    { "skinny", 4096,   64,  256 },  // large batch through a narrow layer
+    { "skinny",  256,   10,  512 },  // classifier head
+    { "skinny", 1024, 1024,   16 },  // low-rank update
+};
+
+/**
+ * @brief The pre-GEMM matrix_multiply loop, kept as the baseline
+ */
+static void naive_matmul(const float* a, const float* b, float* c, int m, int n, int p) {
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            float sum = 0.0f;
+            for (int k = 0; k < p; k++) {
+                sum += a[i * p + k] * b[k * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+static float max_abs_diff(const float* x, const float* y, int count) {
+    float worst = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float d = fabsf(x[i] - y[i]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+static double time_naive(const float* a, const float* b, float* c, int m, int n, int k) {
+    double start = bench_now();
+    naive_matmul(a, b, c, m, n, k);
+    double once = bench_now() - start;
+
+    int reps = bench_repetitions(once, 0.5);
+    start = bench_now();
+    for (int r = 0; r < reps; r++) naive_matmul(a, b, c, m, n, k);
+    return (bench_now() - start) / reps;
+}
+
+static double time_gemm(GemmTranspose ta, GemmTranspose tb, const float* a, int lda,
+                        const float* b, int ldb, float* c, int m, int n, int k) {
+    double start = bench_now();
+    gemm_sgemm(ta, tb, m, n, k, 1.0f, a, lda, b, ldb, 0.0f, c, n);
+    double once = bench_now() - start;
+
+    int reps = bench_repetitions(once, 0.5);
+    start = bench_now();
+    for (int r = 0; r < reps; r++) {
+        gemm_sgemm(ta, tb, m, n, k, 1.0f, a, lda, b, ldb, 0.0f, c, n);
+    }
+    return (bench_now() - start) / reps;
+}
+
+int main(int argc, char* argv[]) {
+    srand(42);
+
+    ThreadPool* pool = NULL;
+    if (argc > 1) {
+        pool = thread_pool_create(atoi(argv[1]));
+        gemm_set_thread_pool(pool);
+    }
+
+    GemmKernelType kernels[] = { GEMM_KERNEL_SCALAR, GEMM_KERNEL_AVX2, GEMM_KERNEL_AVX512 };
+    GemmKernelType best = gemm_get_kernel();
+    int failures = 0;
+
+    printf("GEMM benchmark (auto-selected kernel: %s, %d thread(s))\n",
+           gemm_kernel_name(best), thread_pool_size(pool));
+    printf("%-7s %5s %5s %5s | %9s | %9s %9s %9s | %9s %9s\n",
+           "shape", "m", "n", "k", "naive", "scalar", "avx2", "avx512", "A*B^T", "A^T*B");
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        int m = shapes[s].m, n = shapes[s].n, k = shapes[s].k;
+        double flops = 2.0 * m * n * k;
+
+        float* a = (float*)malloc((size_t)m * k * sizeof(float));
+        float* b = (float*)malloc((size_t)k * n * sizeof(float));
+        float* a_t = (float*)malloc((size_t)k * m * sizeof(float));
+        float* b_t = (float*)malloc((size_t)n * k * sizeof(float));
+        float* ref = (float*)malloc((size_t)m * n * sizeof(float));
+        float* out = (float*)malloc((size_t)m * n * sizeof(float));
+        if (!a || !b || !a_t || !b_t || !ref || !out) {
+            printf("❌ Memory allocation failed\n");
+            return 1;
+        }
+
+        bench_fill_random(a, (size_t)m * k);
+        bench_fill_random(b, (size_t)k * n);
+        for (int i = 0; i < m; i++)
+            for (int p = 0; p < k; p++) a_t[(size_t)p * m + i] = a[(size_t)i * k + p];
+        for (int p = 0; p < k; p++)
+            for (int j = 0; j < n; j++) b_t[(size_t)j * k + p] = b[(size_t)p * n + j];
+
+        double naive = time_naive(a, b, ref, m, n, k);
+        float tolerance = 1e-4f * k;
+
+        printf("%-7s %5d %5d %5d | %9.2f |", shapes[s].label, m, n, k, flops / naive * 1e-9);
+
+        for (size_t ki = 0; ki < sizeof(kernels) / sizeof(kernels[0]); ki++) {
+            if (!gemm_set_kernel(kernels[ki])) {
+                printf(" %9s", "n/a");
+                continue;
+            }
+            double t = time_gemm(GEMM_NO_TRANS, GEMM_NO_TRANS, a, k, b, n, out, m, n, k);
+            if (max_abs_diff(out, ref, m * n) > tolerance) failures++;
+            printf(" %9.2f", flops / t * 1e-9);
+        }
+
+        gemm_set_kernel(best);
+        double t_bt = time_gemm(GEMM_NO_TRANS, GEMM_TRANS, a, k, b_t, k, out, m, n, k);
+        if (max_abs_diff(out, ref, m * n) > tolerance) failures++;
+        double t_at = time_gemm(GEMM_TRANS, GEMM_NO_TRANS, a_t, m, b, n, out, m, n, k);
+        if (max_abs_diff(out, ref, m * n) > tolerance) failures++;
+
+        printf(" | %9.2f %9.2f   GFLOP/s\n", flops / t_bt * 1e-9, flops / t_at * 1e-9);
+
+        free(a); free(b); free(a_t); free(b_t); free(ref); free(out);
+    }
+
+    gemm_set_thread_pool(NULL);
+    thread_pool_destroy(pool);
+
+    if (failures) {
+        printf("❌ %d kernel results disagreed with the naive reference\n", failures);
+        return 1;
+    }
+
+    printf("✅ All kernels match the naive reference\n");
+    return 0;
+}
@@ -0,0 +1,335 @@
+/*
+ * Neural Network System - Hyperparameter Search Benchmark
+ * Checks grid and random trial generation, runs a successive-halving
+ * search of MLP classifiers over one shared dataset, checks the rung
+ * sizes, the epoch savings and the results table, and compares the wall
+ * time of one worker with one worker per core
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_hyperparam_search.c src/hyperparam_search.c \
+ *        src/neural_net.c src/layers.c src/optimizers.c src/losses.c src/activations.c \
+ *        src/dense_kernels.c src/vec_math.c src/gemm.c src/tensor.c src/tensor_arena.c \
+ *        src/thread_pool.c -o benchmark_hyperparam_search -lm -pthread
+ * Note: src/neural_net.c and src/layers.c are not in this snapshot; the search driver trains
+ *       through neural_network_train_step/evaluate, so this links only against the full sources
+ * Usage: ./benchmark_hyperparam_search [max epochs, default 9] [results file, default hyperparam_results.csv]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/layers.h"
+#include "../headers/activations.h"
+#include "../headers/thread_pool.h"
+#include "../headers/hyperparam_search.h"
+#include "bench_common.h"
+
+#define SEARCH_BENCH_FEATURES 32
+#define SEARCH_BENCH_CLASSES 8
+#define SEARCH_BENCH_SAMPLES 6144
+#define SEARCH_BENCH_TRIALS 27
+#define SEARCH_BENCH_ETA 3
+#define SEARCH_BENCH_MIN_ACCURACY 0.6f
+
+// ============================================================================
+// Trial Generation
+// ============================================================================
+
+/**
+ * @brief Builder for searches that are generated but never run
+ */
+static NeuralNetwork* build_none(const HyperparamTrial* trial, const HyperparamSpace* space, void* user_data) {
+    (void)trial;
+    (void)space;
+    (void)user_data;
+    return NULL;
+}
+
+static bool check_generation(void) {
+    static const float widths[] = { 16.0f, 64.0f, 256.0f };
+    HyperparamSpace space;
+    memset(&space, 0, sizeof(space));
+    hyperparam_space_add_choice(&space, "hidden_units", widths, 3);
+    hyperparam_space_add_range(&space, "learning_rate", HYPERPARAM_LOG_UNIFORM, 1e-4f, 1e-1f, 4);
+    hyperparam_space_add_range(&space, "batch_size", HYPERPARAM_INT_UNIFORM, 16.0f, 17.0f, 5);
+
+    // Rejected: duplicate name, empty log range, no grid points
+    bool rejects = !hyperparam_space_add_choice(&space, "hidden_units", widths, 3) &&
+                   !hyperparam_space_add_range(&space, "weight_decay", HYPERPARAM_LOG_UNIFORM, 0.0f, 1.0f, 2) &&
+                   !hyperparam_space_add_range(&space, "momentum", HYPERPARAM_UNIFORM, 0.5f, 0.9f, 0) &&
+                   space.num_params == 3;
+
+    // Grid: 3 x 4 x 2 (only two integers in [16, 17]) distinct combinations
+    HyperparamSearchConfig config = hyperparam_search_config_default();
+    config.strategy = HYPERPARAM_GRID;
+    config.num_trials = 0;
+    HyperparamSearch* grid = hyperparam_search_create(&space, config, build_none, NULL);
+    bool distinct = grid && grid->num_trials == 24;
+    for (int a = 0; distinct && a < grid->num_trials; a++) {
+        for (int b = a + 1; b < grid->num_trials; b++) {
+            if (memcmp(grid->trials[a].values, grid->trials[b].values, 3 * sizeof(float)) == 0) distinct = false;
+        }
+    }
+    bool endpoints = grid && fabsf(grid->trials[0].values[1] - 1e-4f) < 1e-9f &&
+                     fabsf(grid->trials[grid->num_trials - 1].values[1] - 1e-1f) < 1e-6f &&
+                     fabsf(grid->trials[2].values[1] - 1e-3f) < 1e-8f;
+
+    // Random: in range, integral where required, and reproducible from the seed
+    config.strategy = HYPERPARAM_RANDOM;
+    config.num_trials = 200;
+    HyperparamSearch* first = hyperparam_search_create(&space, config, build_none, NULL);
+    HyperparamSearch* second = hyperparam_search_create(&space, config, build_none, NULL);
+    config.seed++;
+    HyperparamSearch* other = hyperparam_search_create(&space, config, build_none, NULL);
+
+    bool in_range = first && second && other;
+    int seen_16 = 0, seen_17 = 0;
+    for (int t = 0; in_range && t < first->num_trials; t++) {
+        const float* v = first->trials[t].values;
+        in_range = (v[0] == 16.0f || v[0] == 64.0f || v[0] == 256.0f) && v[1] >= 1e-4f && v[1] <= 1e-1f &&
+                   (v[2] == 16.0f || v[2] == 17.0f);
+        seen_16 += v[2] == 16.0f;
+        seen_17 += v[2] == 17.0f;
+    }
+    bool both_integers = seen_16 > 0 && seen_17 > 0;
+    bool reproducible = in_range &&
+                        memcmp(first->trials, second->trials, first->num_trials * sizeof(HyperparamTrial)) == 0 &&
+                        memcmp(first->trials, other->trials, first->num_trials * sizeof(HyperparamTrial)) != 0;
+
+    printf("  Space rejects duplicate names, empty log ranges and zero grid points %s\n", rejects ? "✅" : "❌");
+    printf("  Grid: %d distinct combinations (3 x 4 x 2) %s\n", grid ? grid->num_trials : 0,
+           distinct ? "✅" : "❌");
+    printf("  Grid: log-uniform values evenly spaced in log space %s\n", endpoints ? "✅" : "❌");
+    printf("  Random: 200 draws in range, both integers drawn %s\n",
+           in_range && both_integers ? "✅" : "❌");
+    printf("  Random: same seed same trials, next seed different %s\n", reproducible ? "✅" : "❌");
+
+    hyperparam_search_destroy(grid);
+    hyperparam_search_destroy(first);
+    hyperparam_search_destroy(second);
+    hyperparam_search_destroy(other);
+    return rejects && distinct && endpoints && in_range && both_integers && reproducible;
+}
+
+// ============================================================================
+// Benchmark Search
+// ============================================================================
+
+/**
+ * @brief Teacher-labelled data: class = argmax of a random tanh network's outputs
+ */
+static void make_dataset(Tensor* x, Tensor* y) {
+    enum { TEACHER_HIDDEN = 24 };
+    static float w1[TEACHER_HIDDEN][SEARCH_BENCH_FEATURES], w2[SEARCH_BENCH_CLASSES][TEACHER_HIDDEN];
+    srand(99);
+    bench_fill_random(&w1[0][0], sizeof(w1) / sizeof(float));
+    bench_fill_random(&w2[0][0], sizeof(w2) / sizeof(float));
+
+    bench_fill_random(x->data, x->size);
+    for (int r = 0; r < x->shape[0]; r++) {
+        const float* xr = x->data + (size_t)r * SEARCH_BENCH_FEATURES;
+        float hidden[TEACHER_HIDDEN];
+        for (int h = 0; h < TEACHER_HIDDEN; h++) {
+            float sum = 0.0f;
+            for (int f = 0; f < SEARCH_BENCH_FEATURES; f++) sum += w1[h][f] * xr[f];
+            hidden[h] = tanhf(sum);
+        }
+        int best = 0;
+        float best_score = -INFINITY;
+        for (int c = 0; c < SEARCH_BENCH_CLASSES; c++) {
+            float score = 0.0f;
+            for (int h = 0; h < TEACHER_HIDDEN; h++) score += w2[c][h] * hidden[h];
+            if (score > best_score) {
+                best_score = score;
+                best = c;
+            }
+        }
+        y->data[r] = (float)best;
+    }
+}
+
+/**
+ * @brief Two-hidden-layer MLP of the trial's width (called concurrently by workers)
+ */
+static NeuralNetwork* build_mlp(const HyperparamTrial* trial, const HyperparamSpace* space, void* user_data) {
+    (void)user_data;
+    int units = (int)hyperparam_trial_value(trial, space, "hidden_units", 64.0f);
+
+    NeuralNetwork* net = neural_network_create("search_mlp");
+    if (!net) return NULL;
+    if (!neural_network_add_layer(net, layer_dense_create(SEARCH_BENCH_FEATURES, units, activation_relu)) ||
+        !neural_network_add_layer(net, layer_dense_create(units, units, activation_relu)) ||
+        !neural_network_add_layer(net, layer_dense_create(units, SEARCH_BENCH_CLASSES, activation_linear))) {
+        neural_network_destroy(net);
+        return NULL;
+    }
+    return net;
+}
+
+static void make_space(HyperparamSpace* space) {
+    static const float widths[] = { 32.0f, 128.0f, 256.0f };
+    static const float batches[] = { 32.0f, 128.0f };
+    static const float optimizers[] = { (float)OPTIMIZER_SGD_MOMENTUM, (float)OPTIMIZER_ADAM };
+    memset(space, 0, sizeof(*space));
+    hyperparam_space_add_range(space, "learning_rate", HYPERPARAM_LOG_UNIFORM, 1e-4f, 3e-1f, 3);
+    hyperparam_space_add_choice(space, "hidden_units", widths, 3);
+    hyperparam_space_add_choice(space, "batch_size", batches, 2);
+    hyperparam_space_add_choice(space, "optimizer", optimizers, 2);
+}
+
+static HyperparamSearch* run_search(const HyperparamSpace* space, int epochs, int workers, Tensor* x, Tensor* y) {
+    HyperparamSearchConfig config = hyperparam_search_config_default();
+    config.strategy = HYPERPARAM_RANDOM;
+    config.num_trials = SEARCH_BENCH_TRIALS;
+    config.num_workers = workers;
+    config.min_epochs = 1;
+    config.reduction_factor = SEARCH_BENCH_ETA;
+    config.training.epochs = epochs;
+    config.loss = LOSS_SOFTMAX_CROSSENTROPY;
+
+    HyperparamSearch* search = hyperparam_search_create(space, config, build_mlp, NULL);
+    if (search && !hyperparam_search_run(search, x, y)) {
+        hyperparam_search_destroy(search);
+        return NULL;
+    }
+    return search;
+}
+
+/**
+ * @brief Rung sizes follow n, n / eta, n / eta^2, ... and halving saves epochs
+ */
+static bool check_halving(const HyperparamSearch* search, int epochs) {
+    int expected_rungs = 1;
+    for (int budget = 1; budget < epochs; budget *= SEARCH_BENCH_ETA) expected_rungs++;
+    if (epochs == 1) expected_rungs = 1;
+
+    bool sizes = search->num_rungs == expected_rungs;
+    int allowed = search->num_trials;
+    int budget = 1;
+    int worst_case = 0;
+    for (int r = 0; r < search->num_rungs; r++) {
+        int reached = 0;
+        for (int t = 0; t < search->num_trials; t++) reached += search->trials[t].rung >= r;
+        printf("    rung %d: %2d trials (<= %2d), budget %d epochs\n", r, reached, allowed, budget);
+        sizes = sizes && reached <= allowed && reached > 0;
+
+        int next_budget = budget * SEARCH_BENCH_ETA < epochs ? budget * SEARCH_BENCH_ETA : epochs;
+        worst_case += allowed * (r == 0 ? budget : budget - budget / SEARCH_BENCH_ETA);
+        allowed = allowed / SEARCH_BENCH_ETA > 0 ? allowed / SEARCH_BENCH_ETA : 1;
+        budget = next_budget;
+    }
+
+    int eliminated = 0, early = 0, failed = 0;
+    for (int t = 0; t < search->num_trials; t++) {
+        eliminated += search->trials[t].eliminated;
+        early += search->trials[t].early_stopped;
+        failed += search->trials[t].failed;
+    }
+    int full = search->num_trials * epochs;
+    bool savings = search->total_epochs <= worst_case && (epochs == 1 || search->total_epochs < full);
+
+    printf("  Rung sizes shrink by %d per rung %s\n", SEARCH_BENCH_ETA, sizes ? "✅" : "❌");
+    printf("  %d epochs trained vs %d without halving (%d eliminated, %d early-stopped, %d failed) %s\n",
+           search->total_epochs, full, eliminated, early, failed, savings ? "✅" : "❌");
+    return sizes && savings;
+}
+
+static bool check_results(const HyperparamSearch* search, const char* filename) {
+    const HyperparamTrial* best = hyperparam_search_best(search);
+    bool accurate = best && best->val_accuracy >= SEARCH_BENCH_MIN_ACCURACY;
+
+    bool written = hyperparam_search_write_results(search, filename);
+    int lines = 0;
+    char header[256] = { 0 };
+    FILE* file = written ? fopen(filename, "r") : NULL;
+    if (file) {
+        char line[512];
+        while (fgets(line, sizeof(line), file)) {
+            if (lines == 0) memcpy(header, line, sizeof(header) - 1);
+            lines++;
+        }
+        fclose(file);
+    }
+    bool table = lines == search->num_trials + 1 &&
+                 strncmp(header, "rank,trial,learning_rate,hidden_units,batch_size,optimizer,rung", 63) == 0;
+
+    char summary[8192];
+    hyperparam_search_summary(search, summary, sizeof(summary));
+    printf("\n%s\n", summary);
+
+    if (best) {
+        printf("  Best trial %d: lr %.2e, %d units, batch %d, %s - val loss %.4f, accuracy %.1f%% %s\n", best->id,
+               best->values[0], (int)best->values[1], (int)best->values[2],
+               best->values[3] == (float)OPTIMIZER_ADAM ? "Adam" : "SGD+momentum", best->val_loss,
+               100.0f * best->val_accuracy, accurate ? "✅" : "❌");
+    } else {
+        printf("  No trial succeeded ❌\n");
+    }
+    printf("  Results table: %d rows + header in %s %s\n", lines - 1, filename, table ? "✅" : "❌");
+    return accurate && table;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    int epochs = argc > 1 ? atoi(argv[1]) : 9;
+    const char* filename = argc > 2 ? argv[2] : "hyperparam_results.csv";
+    if (epochs < 1) epochs = 9;
+
+    printf("Hyperparameter Search Benchmark\n");
+    printf("===============================\n\n");
+    printf("Trial generation\n");
+    bool ok = check_generation();
+
+    Tensor* x = tensor_create(NULL, (int[]){ SEARCH_BENCH_SAMPLES, SEARCH_BENCH_FEATURES }, 2);
+    Tensor* y = tensor_create(NULL, (int[]){ SEARCH_BENCH_SAMPLES }, 1);
+    if (!x || !y) {
+        printf("❌ Allocation failed\n");
+        return 1;
+    }
+    make_dataset(x, y);
+
+    HyperparamSpace space;
+    make_space(&space);
+    int cores = thread_pool_hardware_threads();
+
+    printf("\nSuccessive halving: %d random trials, eta %d, 1 to %d epochs, %d samples (20%% validation)\n",
+           SEARCH_BENCH_TRIALS, SEARCH_BENCH_ETA, epochs, SEARCH_BENCH_SAMPLES);
+    HyperparamSearch* parallel = run_search(&space, epochs, cores, x, y);
+    if (!parallel) {
+        printf("  Search failed ❌\n");
+        ok = false;
+    } else {
+        ok = check_halving(parallel, epochs) && ok;
+        ok = check_results(parallel, filename) && ok;
+    }
+
+    // Same trials on one worker: the shared dataset scales with no per-worker copies
+    printf("\nWall time (%d cores)\n", cores);
+    HyperparamSearch* serial = cores > 1 ? run_search(&space, epochs, 1, x, y) : NULL;
+    if (parallel) {
+        printf("  %2d worker%s x 1 core: %7.2f s (%.1f epochs/s)\n", parallel->config.num_workers,
+               parallel->config.num_workers == 1 ? " " : "s",
+               parallel->seconds, parallel->total_epochs / parallel->seconds);
+    }
+    if (serial) {
+        printf("   1 worker  x 1 core: %7.2f s (%.1f epochs/s)\n", serial->seconds,
+               serial->total_epochs / serial->seconds);
+        if (parallel) printf("  Speedup: %.2fx\n", serial->seconds / parallel->seconds);
+    } else if (cores == 1) {
+        printf("  Single core: no parallel comparison\n");
+    }
+
+    hyperparam_search_destroy(parallel);
+    hyperparam_search_destroy(serial);
+    tensor_destroy(x);
+    tensor_destroy(y);
+
+    printf("\n%s\n", ok ? "✅ All hyperparameter search checks passed" : "❌ Some checks failed");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+/*
+ * Neural Network System - Inference Serving Benchmark
+ * Closed-loop load generator: client threads issue single-sample requests
+ * against an MLP, either each running its own forward with fresh
+ * allocations (the one-sample neural_network_predict pattern) or through the
+ * micro-batcher with planned per-worker scratch. Reports p50/p99 latency,
+ * throughput and average batch size per client count
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_inference.c src/micro_batcher.c \
+ *        src/gemm.c src/vec_math.c src/thread_pool.c -o benchmark_inference -lm -pthread
+ * Usage: ./benchmark_inference [seconds per run, default 1.0]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "../headers/micro_batcher.h"
+#include "../headers/thread_pool.h"
+#include "../headers/gemm.h"
+#include "bench_common.h"
+
+#define SERVE_LAYERS 3
+#define SERVE_MAX_LATENCIES 200000
+
+static const int serve_sizes[SERVE_LAYERS + 1] = { 1024, 2048, 2048, 10 };
+static const int serve_clients[] = { 1, 4, 16, 64 };
+
+typedef struct {
+    float* weights[SERVE_LAYERS];   // out x in
+    float* biases[SERVE_LAYERS];
+    int widest;
+} ServeModel;
+
+static void serve_model_init(ServeModel* model) {
+    model->widest = 0;
+    for (int l = 0; l < SERVE_LAYERS; l++) {
+        size_t count = (size_t)serve_sizes[l + 1] * serve_sizes[l];
+        model->weights[l] = (float*)malloc(count * sizeof(float));
+        model->biases[l] = (float*)malloc(serve_sizes[l + 1] * sizeof(float));
+        bench_fill_random(model->weights[l], count);
+        for (size_t i = 0; i < count; i++) model->weights[l][i] *= 1.0f / sqrtf((float)serve_sizes[l]);
+        bench_fill_random(model->biases[l], serve_sizes[l + 1]);
+    }
+    for (int l = 0; l <= SERVE_LAYERS; l++) {
+        if (serve_sizes[l] > model->widest) model->widest = serve_sizes[l];
+    }
+}
+
+static void serve_model_free(ServeModel* model) {
+    for (int l = 0; l < SERVE_LAYERS; l++) {
+        free(model->weights[l]);
+        free(model->biases[l]);
+    }
+}
+
+static void serve_layer(const ServeModel* model, int l, const float* x, int rows, float* y) {
+    GemmEpilogue epilogue = { model->biases[l],
+                              l + 1 < SERVE_LAYERS ? GEMM_ACTIVATION_RELU : GEMM_ACTIVATION_NONE, NULL };
+    gemm_sgemm_epilogue(GEMM_NO_TRANS, GEMM_TRANS, rows, serve_sizes[l + 1], serve_sizes[l], 1.0f,
+                        x, serve_sizes[l], model->weights[l], serve_sizes[l], 0.0f,
+                        y, serve_sizes[l + 1], &epilogue);
+}
+
+// ============================================================================
+// Serving Paths
+// ============================================================================
+
+/**
+ * @brief One sample, one forward, a fresh buffer per layer output
+ */
+static bool predict_unbatched(const ServeModel* model, const float* input, float* output) {
+    const float* x = input;
+    float* owned = NULL;
+
+    for (int l = 0; l < SERVE_LAYERS; l++) {
+        float* y = (float*)malloc(serve_sizes[l + 1] * sizeof(float));
+        if (!y) {
+            free(owned);
+            return false;
+        }
+        serve_layer(model, l, x, 1, y);
+        free(owned);
+        owned = y;
+        x = y;
+    }
+
+    memcpy(output, x, serve_sizes[SERVE_LAYERS] * sizeof(float));
+    free(owned);
+    return true;
+}
+
+/**
+ * @brief Micro-batch callback: whole batch through the model in per-worker scratch
+ */
+typedef struct {
+    const ServeModel* model;
+    float** scratch;                // Per worker: two max_batch x widest buffers
+} BatchContext;
+
+static bool predict_batch(void* context, int worker, const float* inputs, int count, float* outputs) {
+    BatchContext* ctx = (BatchContext*)context;
+    const ServeModel* model = ctx->model;
+    float* buffers[2] = { ctx->scratch[worker], ctx->scratch[worker] + (size_t)count * model->widest };
+
+    const float* x = inputs;
+    for (int l = 0; l < SERVE_LAYERS; l++) {
+        float* y = (l + 1 == SERVE_LAYERS) ? outputs : buffers[l & 1];
+        serve_layer(model, l, x, count, y);
+        x = y;
+    }
+    return true;
+}
+
+// ============================================================================
+// Load Generator
+// ============================================================================
+
+typedef struct {
+    const ServeModel* model;
+    MicroBatcher* batcher;          // NULL = unbatched path
+    double stop_time;               // Clients stop issuing at this time
+    const float* inputs;            // Pool of request inputs
+    int num_inputs;
+    int client;
+    double* latencies;              // Per-request latency (seconds)
+    int count;
+    bool failed;
+} ClientState;
+
+static void* client_thread(void* arg) {
+    ClientState* state = (ClientState*)arg;
+    float output[16];
+    int in = serve_sizes[0];
+
+    while (state->count < SERVE_MAX_LATENCIES && bench_now() < state->stop_time) {
+        const float* input = state->inputs + (size_t)((state->client * 7919 + state->count) %
+                                                      state->num_inputs) * in;
+        double start = bench_now();
+        bool ok = state->batcher ? micro_batcher_submit(state->batcher, input, output)
+                                 : predict_unbatched(state->model, input, output);
+        state->latencies[state->count++] = bench_now() - start;
+        state->failed = state->failed || !ok;
+    }
+    return NULL;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    double p50_ms;
+    double p99_ms;
+    double throughput;              // Requests per second
+    bool failed;
+} LoadResult;
+
+static LoadResult run_load(const ServeModel* model, MicroBatcher* batcher, int clients,
+                           double seconds, const float* inputs, int num_inputs) {
+    ClientState* states = (ClientState*)calloc(clients, sizeof(ClientState));
+    pthread_t* threads = (pthread_t*)malloc(clients * sizeof(pthread_t));
+    double start = bench_now();
+
+    for (int c = 0; c < clients; c++) {
+        states[c].model = model;
+        states[c].batcher = batcher;
+        states[c].stop_time = start + seconds;
+        states[c].inputs = inputs;
+        states[c].num_inputs = num_inputs;
+        states[c].client = c;
+        states[c].latencies = (double*)malloc(SERVE_MAX_LATENCIES * sizeof(double));
+        pthread_create(&threads[c], NULL, client_thread, &states[c]);
+    }
+
+    int total = 0;
+    for (int c = 0; c < clients; c++) {
+        pthread_join(threads[c], NULL);
+        total += states[c].count;
+    }
+    double elapsed = bench_now() - start;
+
+    double* all = (double*)malloc((size_t)(total > 0 ? total : 1) * sizeof(double));
+    LoadResult result = { 0.0, 0.0, total / elapsed, false };
+    int filled = 0;
+    for (int c = 0; c < clients; c++) {
+        memcpy(all + filled, states[c].latencies, states[c].count * sizeof(double));
+        filled += states[c].count;
+        result.failed = result.failed || states[c].failed;
+        free(states[c].latencies);
+    }
+
+    if (total > 0) {
+        qsort(all, total, sizeof(double), compare_double);
+        result.p50_ms = all[total / 2] * 1e3;
+        result.p99_ms = all[(int)(total * 0.99)] * 1e3;
+    }
+
+    free(all);
+    free(states);
+    free(threads);
+    return result;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+/**
+ * @brief Batched outputs must match the single-sample path
+ */
+static int check_batched(const ServeModel* model, MicroBatcher* batcher, const float* inputs, int count) {
+    float expected[16], actual[16];
+    double max_error = 0.0;
+    bool ok = true;
+
+    for (int i = 0; i < count && ok; i++) {
+        const float* input = inputs + (size_t)i * serve_sizes[0];
+        ok = predict_unbatched(model, input, expected) && micro_batcher_submit(batcher, input, actual);
+        for (int j = 0; j < serve_sizes[SERVE_LAYERS] && ok; j++) {
+            double err = fabs(expected[j] - actual[j]) / (fabs(expected[j]) + 1.0);
+            if (err > max_error) max_error = err;
+        }
+    }
+
+    ok = ok && max_error < 1e-4;
+    printf("Batched vs single-sample outputs: max relative error %.2e %s\n", max_error, ok ? "✅" : "❌");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 1.0;
+    if (seconds <= 0.0) seconds = 1.0;
+    srand(42);
+
+    ServeModel model;
+    serve_model_init(&model);
+
+    int num_inputs = 256;
+    float* inputs = (float*)malloc((size_t)num_inputs * serve_sizes[0] * sizeof(float));
+    bench_fill_random(inputs, (size_t)num_inputs * serve_sizes[0]);
+
+    MicroBatchConfig config = micro_batch_config_default();
+    config.num_workers = thread_pool_hardware_threads();
+
+    BatchContext context;
+    context.model = &model;
+    context.scratch = (float**)malloc(config.num_workers * sizeof(float*));
+    for (int w = 0; w < config.num_workers; w++) {
+        context.scratch[w] = (float*)malloc((size_t)2 * config.max_batch * model.widest * sizeof(float));
+    }
+
+    MicroBatcher* batcher = micro_batcher_create(serve_sizes[0], serve_sizes[SERVE_LAYERS], config,
+                                                 predict_batch, &context);
+    if (!batcher) {
+        printf("❌ Could not start the micro-batcher\n");
+        return 1;
+    }
+
+    printf("MLP %d-%d-%d-%d, %d batch worker(s), max batch %d, max delay %d us, %.1f s per run\n",
+           serve_sizes[0], serve_sizes[1], serve_sizes[2], serve_sizes[3], config.num_workers,
+           config.max_batch, config.max_delay_us, seconds);
+    int failures = check_batched(&model, batcher, inputs, 16);
+
+    printf("\n%-8s | %-30s | %-42s | %s\n", "", "Unbatched predict", "Micro-batched session", "");
+    printf("%-8s | %9s %9s %10s | %9s %9s %10s %10s | %s\n", "Clients", "p50 ms", "p99 ms", "req/s",
+           "p50 ms", "p99 ms", "req/s", "avg batch", "Speedup");
+
+    double best_speedup = 0.0;
+    for (size_t c = 0; c < sizeof(serve_clients) / sizeof(serve_clients[0]); c++) {
+        int clients = serve_clients[c];
+
+        LoadResult single = run_load(&model, NULL, clients, seconds, inputs, num_inputs);
+
+        MicroBatchStats before, after;
+        micro_batcher_get_stats(batcher, &before);
+        LoadResult batched = run_load(&model, batcher, clients, seconds, inputs, num_inputs);
+        micro_batcher_get_stats(batcher, &after);
+
+        uint64_t batches = after.batches - before.batches;
+        double avg_batch = batches ? (double)(after.requests - before.requests) / batches : 0.0;
+        double speedup = batched.throughput / single.throughput;
+        if (clients > 1 && speedup > best_speedup) best_speedup = speedup;
+
+        printf("%-8d | %9.3f %9.3f %10.0f | %9.3f %9.3f %10.0f %10.1f | %6.2fx %s\n", clients,
+               single.p50_ms, single.p99_ms, single.throughput, batched.p50_ms, batched.p99_ms,
+               batched.throughput, avg_batch, speedup, (single.failed || batched.failed) ? "❌" : "");
+        failures += (single.failed || batched.failed) ? 1 : 0;
+    }
+
+    micro_batcher_destroy(batcher);
+
+    printf("\nBest concurrent throughput gain: %.2fx %s\n", best_speedup, best_speedup > 1.0 ? "✅" : "❌");
+    failures += best_speedup > 1.0 ? 0 : 1;
+
+    for (int w = 0; w < config.num_workers; w++) free(context.scratch[w]);
+    free(context.scratch);
+    free(inputs);
+    serve_model_free(&model);
+
+    printf("\n%s\n", failures ? "❌ Inference serving checks failed" : "✅ All inference serving checks passed");
+    return failures ? 1 : 0;
+}
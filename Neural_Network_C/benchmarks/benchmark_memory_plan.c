@@ -0,0 +1,257 @@
+/*
+ * Neural Network System - Memory Planner Benchmark
+ * Checks that planned buffers never share bytes while both are live (by
+ * replaying the schedule on a real slab), then reports peak training and
+ * inference memory against one allocation per buffer for MLP, CNN and LSTM
+ * stacks, and the cost of planning
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_memory_plan.c src/memory_plan.c src/conv_kernels.c \
+ *        src/dense_kernels.c src/rnn_kernels.c src/vec_math.c src/gemm.c src/tensor.c \
+ *        src/tensor_arena.c src/thread_pool.c src/activations.c -o benchmark_memory_plan -lm -pthread
+ * Usage: ./benchmark_memory_plan [batch, default 64]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../headers/neural_net.h"
+#include "../headers/layers.h"
+#include "../headers/memory_plan.h"
+#include "bench_common.h"
+
+#define PLAN_BENCH_MLP_LAYERS 50
+#define PLAN_BENCH_MLP_WIDTH 1024
+
+static const double plan_bench_mb = 1024.0 * 1024.0;
+
+// ============================================================================
+// Schedule Replay
+// ============================================================================
+
+/**
+ * @brief Run the schedule on the slab: each buffer is stamped with its index
+ *        when its lifetime starts and must still hold it when it ends
+ */
+static bool replay_schedule(MemoryPlan* plan) {
+    if (!plan->slab && !memory_plan_allocate(plan)) return false;
+
+    for (int step = 0; step < plan->num_steps; step++) {
+        for (int i = 0; i < plan->num_buffers; i++) {
+            if (plan->buffers[i].first_step != step) continue;
+            uint32_t* words = (uint32_t*)memory_plan_buffer(plan, i);
+            for (size_t w = 0; w < plan->buffers[i].bytes / sizeof(uint32_t); w++) words[w] = (uint32_t)i;
+        }
+        for (int i = 0; i < plan->num_buffers; i++) {
+            const MemoryBuffer* b = &plan->buffers[i];
+            if (step < b->first_step || step > b->last_step) continue;
+            const uint32_t* words = (const uint32_t*)memory_plan_buffer(plan, i);
+            for (size_t w = 0; w < b->bytes / sizeof(uint32_t); w++) {
+                if (words[w] != (uint32_t)i) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static int report(const char* name, MemoryPlan* plan) {
+    bool ok = plan && memory_plan_verify(plan) && plan->peak_bytes >= plan->live_bytes_bound &&
+              replay_schedule(plan);
+    if (!plan) {
+        printf("%-26s planning failed ❌\n", name);
+        return 1;
+    }
+
+    printf("%-26s | %4d | %9.2f | %9.2f | %9.2f | %6.2fx %s\n", name, plan->num_buffers,
+           plan->peak_bytes / plan_bench_mb, plan->live_bytes_bound / plan_bench_mb,
+           plan->total_bytes / plan_bench_mb, (double)plan->total_bytes / plan->peak_bytes, ok ? "✅" : "❌");
+    return ok ? 0 : 1;
+}
+
+// ============================================================================
+// Synthetic Networks
+// ============================================================================
+
+/**
+ * @brief Dense layer descriptor with real DenseData, as neural_network_build leaves it
+ */
+static Layer* fake_dense(int inputs, int outputs, float dropout) {
+    Layer* layer = (Layer*)calloc(1, sizeof(Layer));
+    DenseData* data = (DenseData*)calloc(1, sizeof(DenseData));
+    data->params.input_size = inputs;
+    data->params.output_size = outputs;
+    data->params.dropout_rate = dropout;
+
+    layer->type = LAYER_DENSE;
+    layer->layer_data = data;
+    layer->input_ndim = layer->output_ndim = 1;
+    layer->input_shape = (int*)malloc(sizeof(int));
+    layer->output_shape = (int*)malloc(sizeof(int));
+    layer->input_shape[0] = inputs;
+    layer->output_shape[0] = outputs;
+    return layer;
+}
+
+static Layer* fake_conv(int channels_in, int channels_out, int size) {
+    Layer* layer = (Layer*)calloc(1, sizeof(Layer));
+    Conv2DData* data = (Conv2DData*)calloc(1, sizeof(Conv2DData));
+    data->params = (Conv2DParams){ channels_in, channels_out, 3, 1, 1, NULL };
+    data->input_height = data->input_width = size;
+    data->output_height = data->output_width = size;
+
+    layer->type = LAYER_CONV2D;
+    layer->layer_data = data;
+    layer->input_ndim = layer->output_ndim = 3;
+    layer->input_shape = (int*)malloc(3 * sizeof(int));
+    layer->output_shape = (int*)malloc(3 * sizeof(int));
+    memcpy(layer->input_shape, (int[]){ channels_in, size, size }, 3 * sizeof(int));
+    memcpy(layer->output_shape, (int[]){ channels_out, size, size }, 3 * sizeof(int));
+    return layer;
+}
+
+static void fake_network_free(NeuralNetwork* net) {
+    neural_network_release_memory_plan(net);
+    for (int l = 0; l < net->num_layers; l++) {
+        free(net->layers[l]->layer_data);
+        free(net->layers[l]->input_shape);
+        free(net->layers[l]->output_shape);
+        free(net->layers[l]);
+    }
+    free(net->layers);
+}
+
+/**
+ * @brief 50-layer MLP through the network entry points, plus a planned tensor
+ */
+static int check_network_mlp(int batch) {
+    NeuralNetwork net;
+    memset(&net, 0, sizeof(net));
+    net.num_layers = PLAN_BENCH_MLP_LAYERS;
+    net.layers = (Layer**)malloc(net.num_layers * sizeof(Layer*));
+    for (int l = 0; l < net.num_layers; l++) {
+        int outputs = l == net.num_layers - 1 ? 10 : PLAN_BENCH_MLP_WIDTH;
+        net.layers[l] = fake_dense(l == 0 ? 784 : PLAN_BENCH_MLP_WIDTH, outputs, l % 2 ? 0.1f : 0.0f);
+    }
+
+    double start = bench_now();
+    bool planned = neural_network_plan_memory(&net, batch);
+    double plan_ms = (bench_now() - start) * 1e3;
+
+    int failures = 0;
+    if (planned) {
+        failures += report("MLP 50x1024 (training)", (MemoryPlan*)neural_network_memory_plan(&net, true));
+        failures += report("MLP 50x1024 (inference)", (MemoryPlan*)neural_network_memory_plan(&net, false));
+
+        // The view lands inside the shared slab; an oversized request falls back (NULL)
+        Tensor* view = neural_network_planned_tensor(&net, MEMORY_BUFFER_ACTIVATION, 3, 0, true,
+                                                     (int[]){ batch, PLAN_BENCH_MLP_WIDTH }, 2);
+        Tensor* too_big = neural_network_planned_tensor(&net, MEMORY_BUFFER_ACTIVATION, 3, 0, true,
+                                                        (int[]){ batch + 1, PLAN_BENCH_MLP_WIDTH }, 2);
+        bool views_ok = view && !too_big && view->size == batch * PLAN_BENCH_MLP_WIDTH;
+        tensor_destroy(view);
+
+        char summary[512];
+        neural_network_memory_summary(&net, summary, sizeof(summary));
+        printf("\n%s", summary);
+        printf("memory_usage %.2f MB, planned in %.3f ms, slab views %s\n\n", net.memory_usage, plan_ms,
+               views_ok ? "✅" : "❌");
+        failures += views_ok ? 0 : 1;
+    } else {
+        printf("neural_network_plan_memory failed ❌\n");
+        failures++;
+    }
+
+    fake_network_free(&net);
+    return failures;
+}
+
+/**
+ * @brief 3x3 same-padding CNN on 32x32 images: convolution workspaces are per-call scratch
+ */
+static int check_network_cnn(int batch) {
+    static const int channels[] = { 3, 32, 32, 64, 64, 128, 128 };
+    NeuralNetwork net;
+    memset(&net, 0, sizeof(net));
+    net.num_layers = 6;
+    net.layers = (Layer**)malloc(net.num_layers * sizeof(Layer*));
+    for (int l = 0; l < net.num_layers; l++) {
+        net.layers[l] = fake_conv(channels[l], channels[l + 1], 32);
+    }
+
+    int failures = 1;
+    if (neural_network_plan_memory(&net, batch)) {
+        failures = report("CNN 6 conv (training)", (MemoryPlan*)neural_network_memory_plan(&net, true));
+        failures += report("CNN 6 conv (inference)", (MemoryPlan*)neural_network_memory_plan(&net, false));
+    } else {
+        printf("CNN planning failed ❌\n");
+    }
+    fake_network_free(&net);
+    return failures;
+}
+
+/**
+ * @brief LSTM stack: per-timestep gate workspaces are saved state
+ */
+static int check_lstm_stack(int batch) {
+    MemoryPlanLayer layers[4];
+    const size_t steps = 128, hidden = 512;
+    for (int l = 0; l < 4; l++) {
+        layers[l].output_floats = (size_t)batch * steps * hidden;
+        layers[l].saved_floats = (size_t)batch * steps * 6 * hidden;
+        layers[l].forward_scratch = 0;
+        layers[l].backward_scratch = (size_t)batch * steps * 4 * hidden;
+    }
+
+    MemoryPlan* training = memory_plan_layers(layers, 4, true);
+    MemoryPlan* inference = memory_plan_layers(layers, 4, false);
+    int failures = report("LSTM 4x512x128 (training)", training) +
+                   report("LSTM 4x512x128 (inference)", inference);
+    memory_plan_destroy(training);
+    memory_plan_destroy(inference);
+    return failures;
+}
+
+/**
+ * @brief Random sizes and lifetimes: packing stays valid and within 2x of the bound
+ */
+static int check_random_plans(void) {
+    double worst = 1.0;
+    bool ok = true;
+    for (int trial = 0; trial < 200 && ok; trial++) {
+        MemoryPlan* plan = memory_plan_create(64, true);
+        int count = 8 + rand() % 120;
+        for (int i = 0; i < count; i++) {
+            int first = rand() % 64;
+            int last = first + rand() % (64 - first);
+            memory_plan_add(plan, MEMORY_BUFFER_SCRATCH, i, (size_t)(1 + rand() % 100000), first, last);
+        }
+        ok = memory_plan_solve(plan) && memory_plan_verify(plan) && replay_schedule(plan);
+        double ratio = (double)plan->peak_bytes / plan->live_bytes_bound;
+        if (ratio > worst) worst = ratio;
+        memory_plan_destroy(plan);
+    }
+
+    ok = ok && worst < 2.0;
+    printf("200 random plans: valid, worst peak / live bound %.3f %s\n", worst, ok ? "✅" : "❌");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    int batch = argc > 1 ? atoi(argv[1]) : 64;
+    if (batch <= 0) batch = 64;
+    srand(42);
+
+    printf("Batch %d, sizes in MB (reuse = one allocation per buffer / planned slab)\n", batch);
+    printf("%-26s | %4s | %9s | %9s | %9s | %7s\n", "Plan", "Bufs", "Peak", "Bound", "No reuse", "Reuse");
+
+    int failures = 0;
+    failures += check_network_mlp(batch);
+    failures += check_network_cnn(batch);
+    failures += check_lstm_stack(batch);
+    failures += check_random_plans();
+
+    printf("\n%s\n", failures ? "❌ Memory plan checks failed" : "✅ All memory plan checks passed");
+    return failures ? 1 : 0;
+}
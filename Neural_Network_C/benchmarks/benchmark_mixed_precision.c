@@ -0,0 +1,444 @@
+/*
+ * Neural Network System - Mixed Precision Benchmark
+ * Checks bf16 rounding and every bf16 GEMM kernel against an fp64
+ * reference, loss-scale overflow handling, then compares fp32 and bf16
+ * GEMM throughput, saved activation bytes and the convergence of an MLP
+ * classifier trained in fp32 and in mixed precision
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_mixed_precision.c src/mixed_precision.c \
+ *        src/bf16_kernels.c src/dense_kernels.c src/losses.c src/vec_math.c src/gemm.c \
+ *        src/tensor.c src/tensor_arena.c src/thread_pool.c src/activations.c \
+ *        -o benchmark_mixed_precision -lm -pthread
+ * Usage: ./benchmark_mixed_precision [epochs, default 8] [hidden width, default 512]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/layers.h"
+#include "../headers/activations.h"
+#include "../headers/losses.h"
+#include "../headers/dense_kernels.h"
+#include "../headers/tensor_arena.h"
+#include "../headers/mixed_precision.h"
+#include "bench_common.h"
+
+#define MP_BENCH_FEATURES 64
+#define MP_BENCH_CLASSES 10
+#define MP_BENCH_HIDDEN_LAYERS 3
+#define MP_BENCH_TRAIN 8192
+#define MP_BENCH_TEST 2048
+#define MP_BENCH_BATCH 128
+#define MP_BENCH_LR 0.05f
+
+static const Bf16KernelType kernels[] = { BF16_KERNEL_SCALAR, BF16_KERNEL_AVX512, BF16_KERNEL_AVX512_BF16 };
+#define MP_BENCH_KERNELS (int)(sizeof(kernels) / sizeof(kernels[0]))
+
+// ============================================================================
+// Conversion
+// ============================================================================
+
+static float float_from_bits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool check_conversion(void) {
+    // 1 + 2^-8 is halfway between 1 and 1 + 2^-7 (rounds to the even 1.0);
+    // 1 + 3 * 2^-8 is halfway between odd 0x3f81 and even 0x3f82
+    bool ok = bf16_from_float(float_from_bits(0x3f808000u)) == 0x3f80 &&
+              bf16_from_float(float_from_bits(0x3f818000u)) == 0x3f82 &&
+              bf16_from_float(float_from_bits(0x3f808001u)) == 0x3f81 &&
+              bf16_from_float(INFINITY) == 0x7f80 &&
+              bf16_from_float(3.4e38f) == 0x7f80 &&
+              isnan(bf16_to_float(bf16_from_float(NAN))) &&
+              bf16_to_float(bf16_from_float(-2.5f)) == -2.5f;
+
+    enum { COUNT = 4099 };
+    float* src = (float*)malloc(COUNT * sizeof(float));
+    bf16* expected = (bf16*)malloc(COUNT * sizeof(bf16));
+    bf16* got = (bf16*)malloc(COUNT * sizeof(bf16));
+    float* widened = (float*)malloc(COUNT * sizeof(float));
+
+    for (int i = 0; i < COUNT; i++) {
+        // Normal values over a wide exponent range, plus halfway cases and specials
+        float mantissa = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
+        src[i] = ldexpf(mantissa, rand() % 80 - 40);
+        if (i % 97 == 0) src[i] = float_from_bits(0x3f800000u | ((uint32_t)(rand() % 128) << 16) | 0x8000u);
+        expected[i] = bf16_from_float(src[i]);
+    }
+    src[0] = NAN;
+    src[1] = -INFINITY;
+    expected[0] = bf16_from_float(src[0]);
+    expected[1] = bf16_from_float(src[1]);
+
+    for (int k = 0; k < MP_BENCH_KERNELS; k++) {
+        if (!bf16_set_kernel(kernels[k])) continue;
+        bf16_from_float_array(src, got, COUNT);
+        bf16_to_float_array(got, widened, COUNT);
+        int mismatches = 0;
+        for (int i = 0; i < COUNT; i++) {
+            // NaN payloads may differ between kernels; the widened bits must round-trip
+            bool same = isnan(src[i]) ? isnan(bf16_to_float(got[i])) : got[i] == expected[i];
+            uint32_t widened_bits;
+            memcpy(&widened_bits, &widened[i], sizeof(widened_bits));
+            if (!same || widened_bits != (uint32_t)got[i] << 16) mismatches++;
+        }
+        printf("  %-18s | round-to-nearest-even conversion: %d mismatches %s\n",
+               bf16_kernel_name(kernels[k]), mismatches, mismatches == 0 ? "✅" : "❌");
+        ok = ok && mismatches == 0;
+    }
+
+    free(src);
+    free(expected);
+    free(got);
+    free(widened);
+    return ok;
+}
+
+// ============================================================================
+// GEMM Accuracy
+// ============================================================================
+
+static float rounded(float value) {
+    return bf16_to_float(bf16_from_float(value));
+}
+
+/**
+ * @brief Max error of C = relu(op(A) * op(B) + beta * C0 + bias) over the fp64
+ *        product of the rounded inputs, relative to sum |a * b|
+ */
+static double gemm_error(int m, int n, int k, GemmTranspose ta, GemmTranspose tb, bool prepacked,
+                         float beta) {
+    float* a = (float*)malloc((size_t)m * k * sizeof(float));
+    float* b = (float*)malloc((size_t)k * n * sizeof(float));
+    float* bias = (float*)malloc((size_t)n * sizeof(float));
+    float* c = (float*)malloc((size_t)m * n * sizeof(float));
+    float* c0 = (float*)malloc((size_t)m * n * sizeof(float));
+    bf16* a16 = (bf16*)malloc((size_t)m * k * sizeof(bf16));
+    bench_fill_random(a, (size_t)m * k);
+    bench_fill_random(b, (size_t)k * n);
+    bench_fill_random(bias, n);
+    bench_fill_random(c0, (size_t)m * n);
+    memcpy(c, c0, (size_t)m * n * sizeof(float));
+    bf16_from_float_array(a, a16, (size_t)m * k);
+
+    int lda = ta == GEMM_TRANS ? m : k;
+    int ldb = tb == GEMM_TRANS ? k : n;
+    Bf16Operand a_op = { a16, NULL, lda, ta };
+    Bf16Operand b_op = { NULL, b, ldb, tb };
+    GemmEpilogue epilogue = { bias, GEMM_ACTIVATION_RELU, NULL };
+
+    bool ok;
+    if (prepacked) {
+        Bf16PackedMatrix packed;
+        ok = bf16_pack_b(&packed, &b_op, k, n) &&
+             bf16_gemm_packed(m, &a_op, &packed, beta, c, n, &epilogue);
+        bf16_packed_free(&packed);
+    } else {
+        ok = bf16_gemm(m, n, k, &a_op, &b_op, beta, c, n, &epilogue);
+    }
+
+    double worst = ok ? 0.0 : INFINITY;
+    for (int i = 0; ok && i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            double sum = 0.0, magnitude = 0.0;
+            for (int p = 0; p < k; p++) {
+                double x = rounded(ta == GEMM_TRANS ? a[(size_t)p * lda + i] : a[(size_t)i * lda + p]);
+                double y = rounded(tb == GEMM_TRANS ? b[(size_t)j * ldb + p] : b[(size_t)p * ldb + j]);
+                sum += x * y;
+                magnitude += fabs(x * y);
+            }
+            sum += beta * c0[(size_t)i * n + j] + bias[j];
+            if (sum < 0.0) sum = 0.0;
+            double error = fabs(sum - c[(size_t)i * n + j]) / (magnitude + 1.0);
+            if (error > worst) worst = error;
+        }
+    }
+
+    free(a);
+    free(b);
+    free(bias);
+    free(c);
+    free(c0);
+    free(a16);
+    return worst;
+}
+
+static bool check_gemm(void) {
+    bool ok = true;
+    for (int k = 0; k < MP_BENCH_KERNELS; k++) {
+        if (!bf16_set_kernel(kernels[k])) {
+            printf("  %-18s | not supported on this CPU, skipped\n", bf16_kernel_name(kernels[k]));
+            continue;
+        }
+
+        // Ragged tiles, odd k, every transpose and a reduction longer than one block
+        double worst = 0.0;
+        for (int t = 0; t < 4; t++) {
+            GemmTranspose ta = t & 1 ? GEMM_TRANS : GEMM_NO_TRANS;
+            GemmTranspose tb = t & 2 ? GEMM_TRANS : GEMM_NO_TRANS;
+            double e1 = gemm_error(37, 70, 131, ta, tb, t % 2 == 0, t < 2 ? 0.0f : 1.0f);
+            if (e1 > worst) worst = e1;
+        }
+        double e2 = gemm_error(13, 45, 2 * BF16_BLOCK_PAIRS + 77, GEMM_NO_TRANS, GEMM_TRANS, true, 0.5f);
+        if (e2 > worst) worst = e2;
+
+        bool good = worst < 1e-5;
+        printf("  %-18s | GEMM vs fp64 on rounded inputs: max rel error %.2e %s\n",
+               bf16_kernel_name(kernels[k]), worst, good ? "✅" : "❌");
+        ok = ok && good;
+    }
+    return ok;
+}
+
+// ============================================================================
+// Throughput
+// ============================================================================
+
+static void report_throughput(int size) {
+    size_t count = (size_t)size * size;
+    float* a = (float*)malloc(count * sizeof(float));
+    float* b = (float*)malloc(count * sizeof(float));
+    float* c = (float*)malloc(count * sizeof(float));
+    bf16* a16 = (bf16*)malloc(count * sizeof(bf16));
+    bench_fill_random(a, count);
+    bench_fill_random(b, count);
+    bf16_from_float_array(a, a16, count);
+    double flops = 2.0 * size * size * size;
+
+    // Weights are packed once, activations arrive in bf16: the training steady state
+    double start = bench_now();
+    gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, size, size, size, 1.0f, a, size, b, size, 0.0f, c, size);
+    int reps = bench_repetitions(bench_now() - start, 0.3);
+    start = bench_now();
+    for (int r = 0; r < reps; r++) {
+        gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, size, size, size, 1.0f, a, size, b, size, 0.0f, c, size);
+    }
+    double fp32 = flops * reps / (bench_now() - start) / 1e9;
+    printf("  %4d^3 | %-18s | %7.1f GFLOP/s\n", size, "fp32 sgemm", fp32);
+
+    Bf16Operand a_op = { a16, NULL, size, GEMM_NO_TRANS };
+    Bf16Operand b_op = { NULL, b, size, GEMM_TRANS };
+    Bf16PackedMatrix packed;
+    bf16_pack_b(&packed, &b_op, size, size);
+    for (int k = 1; k < MP_BENCH_KERNELS; k++) {
+        if (!bf16_set_kernel(kernels[k])) continue;
+        start = bench_now();
+        bf16_gemm_packed(size, &a_op, &packed, 0.0f, c, size, NULL);
+        reps = bench_repetitions(bench_now() - start, 0.3);
+        start = bench_now();
+        for (int r = 0; r < reps; r++) bf16_gemm_packed(size, &a_op, &packed, 0.0f, c, size, NULL);
+        double gflops = flops * reps / (bench_now() - start) / 1e9;
+        printf("  %4d^3 | %-18s | %7.1f GFLOP/s  %.2fx\n", size, bf16_kernel_name(kernels[k]),
+               gflops, gflops / fp32);
+    }
+    bf16_packed_free(&packed);
+
+    free(a);
+    free(b);
+    free(c);
+    free(a16);
+}
+
+// ============================================================================
+// Benchmark Network
+// ============================================================================
+
+/**
+ * @brief MP_BENCH_HIDDEN_LAYERS ReLU layers of the given width and a linear classifier
+ */
+static void mixed_network_init(NeuralNetwork* net, int width) {
+    int widths[MP_BENCH_HIDDEN_LAYERS + 2];
+    widths[0] = MP_BENCH_FEATURES;
+    for (int l = 1; l <= MP_BENCH_HIDDEN_LAYERS; l++) widths[l] = width;
+    widths[MP_BENCH_HIDDEN_LAYERS + 1] = MP_BENCH_CLASSES;
+    bench_network_init(net, widths, MP_BENCH_HIDDEN_LAYERS + 1);
+}
+
+static void mixed_network_free(NeuralNetwork* net) {
+    neural_network_disable_mixed_precision(net);
+    bench_network_free(net);
+}
+
+/**
+ * @brief One SGD step with the train_step protocol: scaled backward, unscale, update, refresh
+ * @return Batch loss, or NAN if the step was skipped for overflow
+ */
+static float mixed_train_step(NeuralNetwork* net, TensorArena* arena, Tensor* x, const int* labels) {
+    float loss = bench_forward_backward(net, arena, x, labels, MP_BENCH_CLASSES, neural_network_loss_scale(net));
+
+    bool apply = neural_network_unscale_gradients(net);
+    if (apply) {
+        bench_sgd_update(net, MP_BENCH_LR);
+        neural_network_refresh_mixed_precision(net);
+    } else {
+        bench_zero_gradients(net);
+    }
+    return apply ? loss : NAN;
+}
+
+// ============================================================================
+// Convergence
+// ============================================================================
+
+typedef struct {
+    float final_loss;           // Mean loss of the last epoch
+    float test_accuracy;        // Held-out accuracy after training
+    double epoch_seconds;       // Mean epoch time
+    size_t saved_bytes;         // Activations kept for backward at the training batch
+    int skipped;                // Steps skipped for overflow
+} TrainResult;
+
+static TrainResult train(bool mixed, int width, int epochs, Tensor* train_x, const int* train_y,
+                         Tensor* test_x, const int* test_y, TensorArena* arena) {
+    NeuralNetwork net;
+    mixed_network_init(&net, width);
+    if (mixed) neural_network_enable_mixed_precision(&net, loss_scaler_default());
+
+    TrainResult result = { 0 };
+    int batches = MP_BENCH_TRAIN / MP_BENCH_BATCH;
+    double start = bench_now();
+
+    printf("  %-5s |", mixed ? "bf16" : "fp32");
+    for (int epoch = 0; epoch < epochs; epoch++) {
+        double loss_sum = 0.0;
+        int counted = 0;
+        for (int b = 0; b < batches; b++) {
+            Tensor* x = tensor_create_view(train_x->data + (size_t)b * MP_BENCH_BATCH * MP_BENCH_FEATURES,
+                                           (int[]){ MP_BENCH_BATCH, MP_BENCH_FEATURES }, 2);
+            if (b == 0 && epoch == 0) {
+                // Step activations live in the arena: measure before it is reset
+                TensorArena* previous = tensor_arena_activate(arena);
+                bench_forward(&net, x);
+                result.saved_bytes = neural_network_saved_activation_bytes(&net);
+                tensor_arena_activate(previous);
+                tensor_arena_reset(arena);
+            }
+            float loss = mixed_train_step(&net, arena, x, train_y + b * MP_BENCH_BATCH);
+            if (!isnan(loss)) {
+                loss_sum += loss;
+                counted++;
+            }
+            tensor_destroy(x);
+        }
+        result.final_loss = counted ? (float)(loss_sum / counted) : NAN;
+        printf(" %.3f", result.final_loss);
+    }
+    result.epoch_seconds = (bench_now() - start) / epochs;
+    result.test_accuracy = bench_accuracy(&net, arena, test_x, test_y, MP_BENCH_CLASSES);
+    if (mixed) result.skipped = ((MixedPrecisionState*)net.mixed_precision)->scaler.skipped_steps;
+    printf("\n");
+
+    mixed_network_free(&net);
+    return result;
+}
+
+// ============================================================================
+// Loss Scaling
+// ============================================================================
+
+static bool check_overflow(Tensor* x, const int* labels, TensorArena* arena) {
+    NeuralNetwork net;
+    mixed_network_init(&net, 64);
+    LossScaler scaler = loss_scaler_default();
+    scaler.scale = 1024.0f;
+    scaler.growth_interval = 2;
+    neural_network_enable_mixed_precision(&net, scaler);
+    LossScaler* state = &((MixedPrecisionState*)net.mixed_precision)->scaler;
+
+    DenseData* first = (DenseData*)net.layers[0]->layer_data;
+    DenseData* middle = (DenseData*)net.layers[1]->layer_data;
+    float before = first->weights->data[0];
+    Tensor* batch = tensor_create_view(x->data, (int[]){ MP_BENCH_BATCH, MP_BENCH_FEATURES }, 2);
+
+    // An inf anywhere: every gradient is cleared, the update refused and the scale halved
+    bench_fill_random(first->weight_gradients->data, first->weight_gradients->size);
+    middle->bias_gradients->data[3] = INFINITY;
+    bool refused = !neural_network_unscale_gradients(&net);
+    bool cleared = true;
+    for (int i = 0; i < first->weight_gradients->size; i++) cleared = cleared && first->weight_gradients->data[i] == 0.0f;
+    bool backed_off = refused && cleared && state->scale == 512.0f && state->skipped_steps == 1;
+
+    // Two clean scaled steps update the fp32 masters and grow the scale back
+    bool clean = !isnan(mixed_train_step(&net, arena, batch, labels)) &&
+                 !isnan(mixed_train_step(&net, arena, batch, labels));
+    bool grows = clean && state->scale == 1024.0f && first->weights->data[0] != before;
+
+    printf("  Injected inf: update refused, gradients cleared, scale 1024 -> 512 %s\n", backed_off ? "✅" : "❌");
+    printf("  Two clean scaled steps: masters updated, scale back to %.0f %s\n", state->scale,
+           grows ? "✅" : "❌");
+
+    tensor_destroy(batch);
+    mixed_network_free(&net);
+    return backed_off && grows;
+}
+
+int main(int argc, char** argv) {
+    int epochs = argc > 1 ? atoi(argv[1]) : 8;
+    int width = argc > 2 ? atoi(argv[2]) : 512;
+    if (epochs <= 0) epochs = 8;
+    if (width <= 0) width = 512;
+    srand(42);
+
+    Bf16KernelType best = bf16_get_kernel();
+    int failures = 0;
+
+    printf("bf16 conversion and GEMM (best kernel: %s)\n", bf16_kernel_name(best));
+    failures += check_conversion() ? 0 : 1;
+    failures += check_gemm() ? 0 : 1;
+
+    printf("\nGEMM throughput (bf16 with prepacked B)\n");
+    for (int size = 256; size <= 1024; size *= 2) report_throughput(size);
+    bf16_set_kernel(best);
+
+    TensorArena* arena = tensor_arena_create(0);
+    Tensor* train_x = tensor_create(NULL, (int[]){ MP_BENCH_TRAIN, MP_BENCH_FEATURES }, 2);
+    Tensor* test_x = tensor_create(NULL, (int[]){ MP_BENCH_TEST, MP_BENCH_FEATURES }, 2);
+    int* train_y = (int*)malloc(MP_BENCH_TRAIN * sizeof(int));
+    int* test_y = (int*)malloc(MP_BENCH_TEST * sizeof(int));
+    bench_make_dataset(train_x, train_y, MP_BENCH_CLASSES);
+    bench_make_dataset(test_x, test_y, MP_BENCH_CLASSES);
+
+    printf("\nDynamic loss scaling\n");
+    failures += check_overflow(train_x, train_y, arena) ? 0 : 1;
+
+    printf("\nMLP %d -> %d x %d -> %d, batch %d, SGD lr %.2f: loss per epoch\n", MP_BENCH_FEATURES,
+           MP_BENCH_HIDDEN_LAYERS, width, MP_BENCH_CLASSES, MP_BENCH_BATCH, MP_BENCH_LR);
+    TrainResult fp32 = train(false, width, epochs, train_x, train_y, test_x, test_y, arena);
+    TrainResult bf16r = train(true, width, epochs, train_x, train_y, test_x, test_y, arena);
+
+    printf("\n%-5s | %10s | %9s | %13s | %14s | %s\n", "", "Final loss", "Test acc", "Epoch ms",
+           "Samples/s", "Saved act. KB");
+    const TrainResult* results[2] = { &fp32, &bf16r };
+    for (int i = 0; i < 2; i++) {
+        const TrainResult* r = results[i];
+        printf("%-5s | %10.4f | %8.1f%% | %13.1f | %14.0f | %.0f\n", i ? "bf16" : "fp32", r->final_loss,
+               100.0f * r->test_accuracy, r->epoch_seconds * 1e3, MP_BENCH_TRAIN / r->epoch_seconds,
+               r->saved_bytes / 1024.0);
+    }
+
+    bool converged = fabsf(bf16r.test_accuracy - fp32.test_accuracy) < 0.02f &&
+                     fabsf(bf16r.final_loss - fp32.final_loss) < 0.05f + 0.1f * fp32.final_loss;
+    bool halved = bf16r.saved_bytes * 10 < fp32.saved_bytes * 6;
+    printf("\nbf16 matches fp32 convergence (accuracy within 2 points) %s\n", converged ? "✅" : "❌");
+    printf("Saved activations %.0f%% of fp32 %s\n", 100.0 * bf16r.saved_bytes / fp32.saved_bytes,
+           halved ? "✅" : "❌");
+    printf("Speedup per epoch %.2fx, %d steps skipped for overflow\n",
+           fp32.epoch_seconds / bf16r.epoch_seconds, bf16r.skipped);
+    failures += (converged ? 0 : 1) + (halved ? 0 : 1);
+
+    tensor_destroy(train_x);
+    tensor_destroy(test_x);
+    free(train_y);
+    free(test_y);
+    tensor_arena_destroy(arena);
+
+    printf("\n%s\n", failures ? "❌ Mixed precision checks failed" : "✅ All mixed precision checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,324 @@
+/*
+ * Neural Network System - Model Load Benchmark
+ * Writes MLP models of ~1M and ~36M parameters in the binary model format,
+ * checks that loaded weights are bit-exact, then measures process-startup
+ * cost: time to open the model and time to the first prediction, for a heap
+ * copy versus a read-only memory mapping, with warm and cold page cache
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_model_load.c src/model_file.c \
+ *        src/gemm.c src/vec_math.c src/thread_pool.c -o benchmark_model_load -lm -pthread
+ * Usage: ./benchmark_model_load [model path, default /tmp/benchmark_model_load.nnm]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../headers/neural_net.h"
+#include "../headers/model_file.h"
+#include "../headers/gemm.h"
+#include "bench_common.h"
+
+#define LOAD_MAX_LAYERS 8
+#define LOAD_REPS 5
+
+typedef struct {
+    const char* name;
+    int sizes[LOAD_MAX_LAYERS + 1];     // Layer widths, input first
+    int num_layers;
+    float* weights[LOAD_MAX_LAYERS];    // out x in
+    float* biases[LOAD_MAX_LAYERS];
+    size_t parameters;
+} LoadModel;
+
+static void model_generate(LoadModel* model) {
+    model->parameters = 0;
+    for (int l = 0; l < model->num_layers; l++) {
+        size_t count = (size_t)model->sizes[l + 1] * model->sizes[l];
+        model->weights[l] = (float*)malloc(count * sizeof(float));
+        model->biases[l] = (float*)malloc((size_t)model->sizes[l + 1] * sizeof(float));
+        bench_fill_random(model->weights[l], count);
+        bench_fill_random(model->biases[l], (size_t)model->sizes[l + 1]);
+        model->parameters += count + model->sizes[l + 1];
+    }
+}
+
+static void model_release(LoadModel* model) {
+    for (int l = 0; l < model->num_layers; l++) {
+        free(model->weights[l]);
+        free(model->biases[l]);
+    }
+}
+
+static bool model_save(const LoadModel* model, const char* path) {
+    ModelWriter writer;
+    model_writer_init(&writer, model->name, &model->sizes[0], 1);
+
+    bool ok = true;
+    for (int l = 0; l < model->num_layers && ok; l++) {
+        ModelLayerRecord record;
+        memset(&record, 0, sizeof(record));
+        snprintf(record.name, sizeof(record.name), "dense_%d", l);
+        record.type = LAYER_DENSE;
+        record.num_weights = 1;
+        record.num_biases = 1;
+        record.params[0] = model->sizes[l];
+        record.params[1] = model->sizes[l + 1];
+        record.trainable = 1;
+        strcpy(record.activation, l + 1 < model->num_layers ? "relu" : "linear");
+
+        int w_shape[2] = { model->sizes[l + 1], model->sizes[l] };
+        ok = model_writer_add_layer(&writer, &record) &&
+             model_writer_add_tensor(&writer, model->weights[l], w_shape, 2) &&
+             model_writer_add_tensor(&writer, model->biases[l], &w_shape[0], 1);
+    }
+
+    ok = ok && model_writer_write(&writer, path);
+    model_writer_free(&writer);
+    return ok;
+}
+
+// ============================================================================
+// Inference
+// ============================================================================
+
+/**
+ * @brief Batch-1 forward pass (relu hidden layers, linear output)
+ */
+static void mlp_forward(const LoadModel* model, const float* const* weights,
+                        const float* const* biases, const float* input,
+                        float* scratch_a, float* scratch_b) {
+    const float* x = input;
+    float* y = scratch_a;
+
+    for (int l = 0; l < model->num_layers; l++) {
+        int in = model->sizes[l];
+        int out = model->sizes[l + 1];
+        gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, 1, out, in, 1.0f, x, in,
+                   weights[l], in, 0.0f, y, out);
+        for (int j = 0; j < out; j++) {
+            float v = y[j] + biases[l][j];
+            y[j] = (l + 1 < model->num_layers && v < 0.0f) ? 0.0f : v;
+        }
+        x = y;
+        y = (y == scratch_a) ? scratch_b : scratch_a;
+    }
+
+    if (x != scratch_a) memcpy(scratch_a, x, (size_t)model->sizes[model->num_layers] * sizeof(float));
+}
+
+static void file_forward(const LoadModel* model, const ModelFile* file, const float* input,
+                         float* scratch_a, float* scratch_b) {
+    const float* weights[LOAD_MAX_LAYERS];
+    const float* biases[LOAD_MAX_LAYERS];
+    for (int l = 0; l < model->num_layers; l++) {
+        weights[l] = model_file_tensor_data(file, (uint32_t)(2 * l));
+        biases[l] = model_file_tensor_data(file, (uint32_t)(2 * l + 1));
+    }
+    mlp_forward(model, weights, biases, input, scratch_a, scratch_b);
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+/**
+ * @brief Verify header, checksums and bit-exact parameters of a mapped file
+ */
+static int check_file(const LoadModel* model, const char* path) {
+    ModelFile file;
+    if (!model_file_open(&file, path, MODEL_LOAD_MMAP)) {
+        printf("  Open                         ❌\n");
+        return 1;
+    }
+
+    bool layout = file.header->num_layers == (uint32_t)model->num_layers &&
+                  file.header->num_tensors == (uint32_t)(2 * model->num_layers) &&
+                  file.header->input_ndim == 1 && file.header->input_shape[0] == model->sizes[0];
+    bool aligned = ((uintptr_t)file.blob % MODEL_FILE_ALIGNMENT) == 0;
+    bool exact = true;
+
+    for (int l = 0; l < model->num_layers; l++) {
+        const float* w = model_file_tensor_data(&file, (uint32_t)(2 * l));
+        const float* b = model_file_tensor_data(&file, (uint32_t)(2 * l + 1));
+        aligned = aligned && ((uintptr_t)w % MODEL_FILE_ALIGNMENT) == 0 &&
+                  ((uintptr_t)b % MODEL_FILE_ALIGNMENT) == 0;
+        exact = exact &&
+                memcmp(w, model->weights[l], (size_t)model->sizes[l + 1] * model->sizes[l] * sizeof(float)) == 0 &&
+                memcmp(b, model->biases[l], (size_t)model->sizes[l + 1] * sizeof(float)) == 0;
+    }
+    bool verified = model_file_verify(&file);
+    model_file_close(&file);
+
+    // A truncated copy must be rejected without touching the weights
+    char truncated[512];
+    snprintf(truncated, sizeof(truncated), "%s.truncated", path);
+    bool rejected = false;
+    FILE* src = fopen(path, "rb");
+    FILE* dst = fopen(truncated, "wb");
+    if (src && dst) {
+        char buffer[4096];
+        size_t n = fread(buffer, 1, sizeof(buffer), src);
+        fwrite(buffer, 1, n, dst);
+    }
+    if (src) fclose(src);
+    if (dst) {
+        fclose(dst);
+        fflush(stdout);
+        fprintf(stderr, "(expected) ");
+        rejected = !model_file_open(&file, truncated, MODEL_LOAD_MMAP);
+        remove(truncated);
+    }
+
+    printf("  Header and tables            %s\n", layout ? "✅" : "❌");
+    printf("  64-byte tensor alignment     %s\n", aligned ? "✅" : "❌");
+    printf("  Bit-exact parameters         %s\n", exact ? "✅" : "❌");
+    printf("  Tensor checksums             %s\n", verified ? "✅" : "❌");
+    printf("  Truncated file rejected      %s\n", rejected ? "✅" : "❌");
+    return (layout && aligned && exact && verified && rejected) ? 0 : 1;
+}
+
+// ============================================================================
+// Startup Timing
+// ============================================================================
+
+/**
+ * @brief Evict the file from the page cache (best effort; needs no mapping open)
+ */
+static bool drop_page_cache(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = fdatasync(fd) == 0 && posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return ok;
+}
+
+typedef struct {
+    double open_ms;         // model_file_open
+    double first_ms;        // First prediction after open
+    bool matches;           // Output equals the in-memory reference
+} StartupTiming;
+
+static StartupTiming time_startup(const LoadModel* model, const char* path, ModelLoadMode mode,
+                                  bool cold, const float* input, const float* reference,
+                                  float* scratch_a, float* scratch_b) {
+    StartupTiming best = { 1e30, 1e30, true };
+    int outputs = model->sizes[model->num_layers];
+
+    for (int r = 0; r < LOAD_REPS; r++) {
+        if (cold) drop_page_cache(path);
+
+        ModelFile file;
+        double start = bench_now();
+        if (!model_file_open(&file, path, mode)) {
+            best.matches = false;
+            return best;
+        }
+        double opened = bench_now();
+        file_forward(model, &file, input, scratch_a, scratch_b);
+        double done = bench_now();
+        model_file_close(&file);
+
+        best.matches = best.matches && memcmp(scratch_a, reference, (size_t)outputs * sizeof(float)) == 0;
+        double open_ms = (opened - start) * 1e3;
+        double first_ms = (done - opened) * 1e3;
+        if (open_ms + first_ms < best.open_ms + best.first_ms) {
+            best.open_ms = open_ms;
+            best.first_ms = first_ms;
+        }
+    }
+    return best;
+}
+
+static int report_model(LoadModel* model, const char* path) {
+    model_generate(model);
+    double mb = model->parameters * sizeof(float) / (1024.0 * 1024.0);
+    printf("\n%s (%.1fM parameters, %.1f MB)\n", model->name, model->parameters / 1e6, mb);
+
+    double start = bench_now();
+    if (!model_save(model, path)) {
+        printf("  Save                         ❌\n");
+        model_release(model);
+        return 1;
+    }
+    double save_seconds = bench_now() - start;
+    printf("  Save                         %.1f ms (%.0f MB/s)\n", save_seconds * 1e3, mb / save_seconds);
+
+    int failures = check_file(model, path);
+
+    int widest = 0;
+    for (int l = 0; l <= model->num_layers; l++) {
+        if (model->sizes[l] > widest) widest = model->sizes[l];
+    }
+    float* input = (float*)malloc((size_t)model->sizes[0] * sizeof(float));
+    float* reference = (float*)malloc((size_t)widest * sizeof(float));
+    float* scratch_a = (float*)malloc((size_t)widest * sizeof(float));
+    float* scratch_b = (float*)malloc((size_t)widest * sizeof(float));
+    bench_fill_random(input, (size_t)model->sizes[0]);
+
+    // Steady-state latency with weights already resident in the process
+    mlp_forward(model, (const float* const*)model->weights, (const float* const*)model->biases,
+                input, reference, scratch_b);
+    start = bench_now();
+    for (int r = 0; r < LOAD_REPS; r++) {
+        mlp_forward(model, (const float* const*)model->weights, (const float* const*)model->biases,
+                    input, scratch_a, scratch_b);
+    }
+    printf("  Resident prediction          %.2f ms\n", (bench_now() - start) / LOAD_REPS * 1e3);
+
+    static const struct { ModelLoadMode mode; const char* name; } modes[] = {
+        { MODEL_LOAD_READ, "read (heap copy)" },
+        { MODEL_LOAD_MMAP, "mmap" },
+        { MODEL_LOAD_MMAP_POPULATE, "mmap + populate" },
+    };
+
+    bool can_drop = drop_page_cache(path);
+    printf("  %-18s %-6s %12s %18s %12s\n", "Load", "Cache", "Open (ms)", "First pred (ms)", "Total (ms)");
+
+    StartupTiming warm_read = { 0, 0, true }, warm_mmap = { 0, 0, true };
+    for (int cold = 0; cold <= (can_drop ? 1 : 0); cold++) {
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+            StartupTiming t = time_startup(model, path, modes[m].mode, cold != 0, input, reference,
+                                           scratch_a, scratch_b);
+            printf("  %-18s %-6s %12.3f %18.3f %12.3f %s\n", modes[m].name, cold ? "cold" : "warm",
+                   t.open_ms, t.first_ms, t.open_ms + t.first_ms, t.matches ? "✅" : "❌");
+            failures += t.matches ? 0 : 1;
+            if (!cold && modes[m].mode == MODEL_LOAD_READ) warm_read = t;
+            if (!cold && modes[m].mode == MODEL_LOAD_MMAP) warm_mmap = t;
+        }
+    }
+    if (!can_drop) printf("  (page cache could not be dropped; cold rows skipped)\n");
+
+    printf("  mmap open vs heap copy       %.0fx faster %s\n", warm_read.open_ms / warm_mmap.open_ms,
+           warm_mmap.open_ms < warm_read.open_ms ? "✅" : "❌");
+    failures += warm_mmap.open_ms < warm_read.open_ms ? 0 : 1;
+
+    free(input);
+    free(reference);
+    free(scratch_a);
+    free(scratch_b);
+    model_release(model);
+    remove(path);
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "/tmp/benchmark_model_load.nnm";
+    srand(42);
+
+    printf("Model load: binary format v%d, %d-byte aligned tensors, file %s\n",
+           MODEL_FILE_VERSION, MODEL_FILE_ALIGNMENT, path);
+
+    LoadModel small = { "MLP 784-1024-512-10", { 784, 1024, 512, 10 }, 3, { 0 }, { 0 }, 0 };
+    LoadModel large = { "MLP 2048-4096-4096-2048-1000", { 2048, 4096, 4096, 2048, 1000 }, 4,
+                        { 0 }, { 0 }, 0 };
+
+    int failures = report_model(&small, path);
+    failures += report_model(&large, path);
+
+    printf("\n%s\n", failures ? "❌ Model load checks failed" : "✅ All model load checks passed");
+    return failures ? 1 : 0;
+}
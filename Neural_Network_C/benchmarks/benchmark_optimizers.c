@@ -0,0 +1,338 @@
+/*
+ * Neural Network System - Optimizer Benchmark
+ * Checks every optimizer against a double-precision reference trace and
+ * measures multi-tensor update throughput against the previous Adam
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_optimizers.c src/optimizers.c src/tensor.c \
+ *        src/tensor_arena.c src/gemm.c src/vec_math.c src/thread_pool.c \
+ *        -o benchmark_optimizers -lm -pthread
+ * Usage: ./benchmark_optimizers
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/optimizers.h"
+#include "bench_common.h"
+
+#define TRACE_STEPS 200
+#define MAX_PARAMS 8
+
+static const OptimizerType optimizer_types[] = {
+    OPTIMIZER_SGD, OPTIMIZER_SGD_MOMENTUM, OPTIMIZER_ADAGRAD, OPTIMIZER_RMSPROP,
+    OPTIMIZER_ADAM, OPTIMIZER_ADAMAX, OPTIMIZER_NADAM
+};
+
+// ============================================================================
+// Test Network
+// ============================================================================
+
+typedef struct {
+    Layer** layers;
+    int num_layers;
+    long long num_params;
+} ParamSet;
+
+/**
+ * @brief Dense-shaped parameter layers without a forward pass
+ */
+static ParamSet param_set_create(const int* sizes, int count) {
+    ParamSet set = { (Layer**)calloc(count - 1, sizeof(Layer*)), count - 1, 0 };
+
+    for (int l = 0; l + 1 < count; l++) {
+        Layer* layer = (Layer*)calloc(1, sizeof(Layer));
+        int w_shape[2] = { sizes[l + 1], sizes[l] };
+        int b_shape[1] = { sizes[l + 1] };
+
+        layer->num_weights = 1;
+        layer->num_biases = 1;
+        layer->weights = (Tensor**)malloc(sizeof(Tensor*));
+        layer->biases = (Tensor**)malloc(sizeof(Tensor*));
+        layer->weight_gradients = (Tensor**)malloc(sizeof(Tensor*));
+        layer->bias_gradients = (Tensor**)malloc(sizeof(Tensor*));
+        layer->weights[0] = tensor_create(NULL, w_shape, 2);
+        layer->biases[0] = tensor_create(NULL, b_shape, 1);
+        layer->weight_gradients[0] = tensor_create(NULL, w_shape, 2);
+        layer->bias_gradients[0] = tensor_create(NULL, b_shape, 1);
+        layer->trainable = true;
+
+        bench_fill_random(layer->weights[0]->data, layer->weights[0]->size);
+        bench_fill_random(layer->biases[0]->data, layer->biases[0]->size);
+        set.num_params += layer->weights[0]->size + layer->biases[0]->size;
+        set.layers[l] = layer;
+    }
+
+    return set;
+}
+
+static void param_set_destroy(ParamSet* set) {
+    for (int l = 0; l < set->num_layers; l++) {
+        Layer* layer = set->layers[l];
+        tensor_destroy(layer->weights[0]);
+        tensor_destroy(layer->biases[0]);
+        tensor_destroy(layer->weight_gradients[0]);
+        tensor_destroy(layer->bias_gradients[0]);
+        free(layer->weights);
+        free(layer->biases);
+        free(layer->weight_gradients);
+        free(layer->bias_gradients);
+        free(layer);
+    }
+    free(set->layers);
+}
+
+/**
+ * @brief Deterministic gradient for step/parameter/element (same in both traces)
+ */
+static float trace_gradient(int step, int param, int index) {
+    return sinf(0.37f * (float)(index + 1) + 1.3f * (float)param + 0.11f * (float)step) *
+           (0.5f + 0.5f * cosf(0.05f * (float)step));
+}
+
+// ============================================================================
+// Double-precision Reference
+// ============================================================================
+
+typedef struct {
+    double* w;
+    double* m;
+    double* v;
+    int size;
+} ReferenceParam;
+
+static void reference_step(OptimizerType type, ReferenceParam* p, const float* grad, int t,
+                           double lr, double b1, double b2, double eps, double momentum) {
+    for (int i = 0; i < p->size; i++) {
+        double g = grad[i];
+
+        switch (type) {
+            case OPTIMIZER_SGD:
+                p->w[i] -= lr * g;
+                break;
+            case OPTIMIZER_SGD_MOMENTUM:
+                p->m[i] = momentum * p->m[i] - lr * g;
+                p->w[i] += p->m[i];
+                break;
+            case OPTIMIZER_ADAGRAD:
+                p->m[i] += g * g;
+                p->w[i] -= lr * g / (sqrt(p->m[i]) + eps);
+                break;
+            case OPTIMIZER_RMSPROP:
+                p->v[i] = b2 * p->v[i] + (1.0 - b2) * g * g;
+                p->w[i] -= lr * g / (sqrt(p->v[i]) + eps);
+                break;
+            case OPTIMIZER_ADAM: {
+                p->m[i] = b1 * p->m[i] + (1.0 - b1) * g;
+                p->v[i] = b2 * p->v[i] + (1.0 - b2) * g * g;
+                double m_hat = p->m[i] / (1.0 - pow(b1, t));
+                double v_hat = p->v[i] / (1.0 - pow(b2, t));
+                p->w[i] -= lr * m_hat / (sqrt(v_hat) + eps);
+                break;
+            }
+            case OPTIMIZER_ADAMAX:
+                p->m[i] = b1 * p->m[i] + (1.0 - b1) * g;
+                p->v[i] = fmax(b2 * p->v[i], fabs(g));
+                p->w[i] -= lr / (1.0 - pow(b1, t)) * p->m[i] / (p->v[i] + eps);
+                break;
+            case OPTIMIZER_NADAM: {
+                p->m[i] = b1 * p->m[i] + (1.0 - b1) * g;
+                p->v[i] = b2 * p->v[i] + (1.0 - b2) * g * g;
+                double m_hat = b1 * p->m[i] / (1.0 - pow(b1, t + 1)) +
+                               (1.0 - b1) * g / (1.0 - pow(b1, t));
+                double v_hat = p->v[i] / (1.0 - pow(b2, t));
+                p->w[i] -= lr * m_hat / (sqrt(v_hat) + eps);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Run the optimizer and the reference side by side on several tensors
+ * @return Largest absolute weight difference over the trace
+ */
+static double check_trace(OptimizerType type) {
+    const int sizes[] = { 5, 17, 3, 40, 1 };  // odd sizes exercise SIMD tails
+    ParamSet set = param_set_create(sizes, 5);
+    Optimizer* optimizer = optimizer_create(type, 0.01f);
+
+    Tensor* params[MAX_PARAMS];
+    Tensor* grads[MAX_PARAMS];
+    ReferenceParam ref[MAX_PARAMS];
+    int num = 0;
+
+    for (int l = 0; l < set.num_layers; l++) {
+        params[num] = set.layers[l]->weights[0];
+        grads[num++] = set.layers[l]->weight_gradients[0];
+        params[num] = set.layers[l]->biases[0];
+        grads[num++] = set.layers[l]->bias_gradients[0];
+    }
+
+    for (int p = 0; p < num; p++) {
+        ref[p].size = params[p]->size;
+        ref[p].w = (double*)malloc(ref[p].size * sizeof(double));
+        ref[p].m = (double*)calloc(ref[p].size, sizeof(double));
+        ref[p].v = (double*)calloc(ref[p].size, sizeof(double));
+        for (int i = 0; i < ref[p].size; i++) ref[p].w[i] = params[p]->data[i];
+    }
+
+    double worst = 0.0;
+    for (int step = 1; step <= TRACE_STEPS; step++) {
+        for (int p = 0; p < num; p++) {
+            for (int i = 0; i < grads[p]->size; i++) {
+                grads[p]->data[i] = trace_gradient(step, p, i);
+            }
+            reference_step(type, &ref[p], grads[p]->data, step, optimizer->learning_rate,
+                           optimizer->beta1, optimizer->beta2, optimizer->epsilon,
+                           optimizer->momentum);
+        }
+
+        optimizer_step(optimizer, set.layers, set.num_layers);
+
+        for (int p = 0; p < num; p++) {
+            for (int i = 0; i < ref[p].size; i++) {
+                double d = fabs(ref[p].w[i] - params[p]->data[i]);
+                if (d > worst) worst = d;
+            }
+        }
+    }
+
+    for (int p = 0; p < num; p++) {
+        free(ref[p].w);
+        free(ref[p].m);
+        free(ref[p].v);
+    }
+    optimizer_destroy(optimizer);
+    param_set_destroy(&set);
+    return worst;
+}
+
+// ============================================================================
+// Previous Implementation (baseline)
+// ============================================================================
+
+/**
+ * @brief Adam as it was: static state shared by all tensors, powf per element
+ */
+static void legacy_adam_update(Tensor* weights, Tensor* gradients, float learning_rate) {
+    static float* m = NULL;
+    static float* v = NULL;
+    static int state_size = 0;
+    static int t = 0;
+
+    if (state_size != weights->size) {
+        free(m);
+        free(v);
+        m = (float*)calloc(weights->size, sizeof(float));
+        v = (float*)calloc(weights->size, sizeof(float));
+        state_size = weights->size;
+        t = 0;
+    }
+
+    t++;
+    for (int i = 0; i < weights->size; i++) {
+        m[i] = 0.9f * m[i] + 0.1f * gradients->data[i];
+        v[i] = 0.999f * v[i] + 0.001f * gradients->data[i] * gradients->data[i];
+        float m_hat = m[i] / (1.0f - powf(0.9f, t));
+        float v_hat = v[i] / (1.0f - powf(0.999f, t));
+        weights->data[i] -= learning_rate * m_hat / (sqrtf(v_hat) + 1e-8f);
+    }
+}
+
+static void legacy_adam_step(ParamSet* set) {
+    for (int l = 0; l < set->num_layers; l++) {
+        legacy_adam_update(set->layers[l]->weights[0], set->layers[l]->weight_gradients[0], 0.001f);
+        legacy_adam_update(set->layers[l]->biases[0], set->layers[l]->bias_gradients[0], 0.001f);
+    }
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+/**
+ * @brief Floats moved per parameter: w r/w + g r, plus r/w of each state array
+ */
+static int floats_per_param(OptimizerType type) {
+    switch (type) {
+        case OPTIMIZER_SGD: return 3;
+        case OPTIMIZER_SGD_MOMENTUM:
+        case OPTIMIZER_ADAGRAD:
+        case OPTIMIZER_RMSPROP: return 5;
+        default: return 7;
+    }
+}
+
+static void fill_gradients(ParamSet* set) {
+    for (int l = 0; l < set->num_layers; l++) {
+        Tensor* wg = set->layers[l]->weight_gradients[0];
+        Tensor* bg = set->layers[l]->bias_gradients[0];
+        for (int i = 0; i < wg->size; i++) wg->data[i] = 1e-3f * ((i % 13) - 6);
+        for (int i = 0; i < bg->size; i++) bg->data[i] = 1e-3f * ((i % 7) - 3);
+    }
+}
+
+int main(void) {
+    srand(42);
+    int failures = 0;
+
+    printf("Optimizer reference traces (%d steps, 8 tensors of mixed sizes)\n", TRACE_STEPS);
+    for (size_t i = 0; i < sizeof(optimizer_types) / sizeof(optimizer_types[0]); i++) {
+        double err = check_trace(optimizer_types[i]);
+        bool ok = err < 1e-4;
+        if (!ok) failures++;
+        printf("  %s %-28s max |w - w_ref| = %.2e\n", ok ? "✅" : "❌",
+               optimizer_get_name(optimizer_types[i]), err);
+    }
+
+    const int sizes[] = { 784, 512, 512, 256, 10 };
+    ParamSet set = param_set_create(sizes, 5);
+    fill_gradients(&set);
+
+    printf("\nUpdate throughput (MLP 784-512-512-256-10, %lld parameters)\n", set.num_params);
+    printf("%-28s | %9s | %10s | %8s\n", "optimizer", "time (ms)", "Mparams/s", "GB/s");
+
+    double start = bench_now();
+    legacy_adam_step(&set);
+    int reps = bench_repetitions(bench_now() - start, 0.5);
+
+    start = bench_now();
+    for (int r = 0; r < reps; r++) legacy_adam_step(&set);
+    double legacy = (bench_now() - start) / reps;
+    printf("%-28s | %9.3f | %10.1f | %8.2f\n", "Adam (previous, per-tensor)", legacy * 1e3,
+           set.num_params / legacy * 1e-6,
+           set.num_params * floats_per_param(OPTIMIZER_ADAM) * sizeof(float) / legacy * 1e-9);
+
+    double adam_time = 0.0;
+    for (size_t i = 0; i < sizeof(optimizer_types) / sizeof(optimizer_types[0]); i++) {
+        Optimizer* optimizer = optimizer_create(optimizer_types[i], 0.001f);
+        optimizer_step(optimizer, set.layers, set.num_layers);
+
+        start = bench_now();
+        for (int r = 0; r < reps; r++) optimizer_step(optimizer, set.layers, set.num_layers);
+        double t = (bench_now() - start) / reps;
+        if (optimizer_types[i] == OPTIMIZER_ADAM) adam_time = t;
+
+        printf("%-28s | %9.3f | %10.1f | %8.2f\n", optimizer_get_name(optimizer_types[i]), t * 1e3,
+               set.num_params / t * 1e-6,
+               set.num_params * floats_per_param(optimizer_types[i]) * sizeof(float) / t * 1e-9);
+        optimizer_destroy(optimizer);
+    }
+
+    printf("\nFused Adam speedup over previous Adam: %.1fx\n", legacy / adam_time);
+    param_set_destroy(&set);
+
+    if (failures) {
+        printf("❌ %d optimizers diverged from the reference trace\n", failures);
+        return 1;
+    }
+
+    printf("✅ All optimizers match the reference trace\n");
+    return 0;
+}
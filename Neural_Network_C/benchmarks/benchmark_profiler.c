@@ -0,0 +1,223 @@
+/*
+ * Neural Network System - Profiler Benchmark
+ * Checks per-layer call, FLOP and allocation counters and the exported
+ * Chrome trace of an MLP trained with Adam, measures profiling overhead
+ * per step and prints the per-layer training and inference tables
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_profiler.c src/profiler.c src/optimizers.c \
+ *        src/dense_kernels.c src/losses.c src/vec_math.c src/gemm.c src/tensor.c \
+ *        src/tensor_arena.c src/thread_pool.c src/activations.c -o benchmark_profiler -lm -pthread
+ * Usage: ./benchmark_profiler [steps, default 50] [trace path, default profile_trace.json]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/layers.h"
+#include "../headers/activations.h"
+#include "../headers/losses.h"
+#include "../headers/optimizers.h"
+#include "../headers/dense_kernels.h"
+#include "../headers/tensor_arena.h"
+#include "../headers/profiler.h"
+#include "bench_common.h"
+
+#define PROF_BENCH_BATCH 64
+#define PROF_BENCH_CLASSES 10
+#define PROF_BENCH_LAYERS 3
+#define PROF_BENCH_ROUNDS 3
+
+static const int widths[PROF_BENCH_LAYERS + 1] = { 784, 1024, 256, PROF_BENCH_CLASSES };
+
+// ============================================================================
+// Benchmark Network
+// ============================================================================
+
+static void profiled_network_init(NeuralNetwork* net) {
+    bench_network_init(net, widths, PROF_BENCH_LAYERS);
+    snprintf(net->name, sizeof(net->name), "profiler benchmark MLP");
+    net->optimizer = optimizer_create(OPTIMIZER_ADAM, 1e-3f);
+}
+
+static void profiled_network_free(NeuralNetwork* net) {
+    neural_network_disable_profiling(net);
+    optimizer_destroy(net->optimizer);
+    bench_network_free(net);
+}
+
+/**
+ * @brief One training step with the step markers the trainer places
+ */
+static void profiled_train_step(NeuralNetwork* net, TensorArena* arena, Tensor* x, const int* labels) {
+    neural_network_profile_step_begin(net);
+    bench_forward_backward(net, arena, x, labels, PROF_BENCH_CLASSES, 1.0f);
+    neural_network_profile_update(net);
+    bench_zero_gradients(net);
+    neural_network_profile_step_end(net);
+}
+
+static double run_steps(NeuralNetwork* net, TensorArena* arena, Tensor* x, const int* labels, int steps) {
+    double start = bench_now();
+    for (int s = 0; s < steps; s++) profiled_train_step(net, arena, x, labels);
+    return bench_now() - start;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+static bool check_counters(const NetworkStats* stats, int steps) {
+    bool calls = true, flops = true, allocations = true;
+    for (int l = 0; l < PROF_BENCH_LAYERS; l++) {
+        const LayerStats* layer = &stats->layers[l];
+        for (int phase = 0; phase < PROFILER_LAYER_PHASES; phase++) {
+            calls = calls && layer->calls[phase] == (uint64_t)steps;
+        }
+
+        uint64_t product = 2ull * PROF_BENCH_BATCH * widths[l] * widths[l + 1];
+        uint64_t outputs = (uint64_t)PROF_BENCH_BATCH * widths[l + 1];
+        flops = flops && layer->flops[PROFILE_FORWARD] == steps * (product + outputs) &&
+                layer->flops[PROFILE_BACKWARD] == steps * (2 * product + outputs);
+
+        // Each pass creates exactly its output tensor in the arena; updates reuse optimizer state
+        allocations = allocations && layer->allocations[PROFILE_FORWARD] >= (uint64_t)steps &&
+                      layer->allocations[PROFILE_UPDATE] == 0;
+    }
+
+    printf("  Calls: %d per phase per layer %s\n", steps, calls ? "✅" : "❌");
+    printf("  FLOPs: forward 2*B*in*out + B*out, backward twice the product %s\n", flops ? "✅" : "❌");
+    printf("  Allocations: output tensors counted, none in the steady-state update %s\n",
+           allocations ? "✅" : "❌");
+    return calls && flops && allocations;
+}
+
+static bool check_coverage(const NetworkStats* stats) {
+    uint64_t layers = 0;
+    for (int l = 0; l < PROF_BENCH_LAYERS; l++) {
+        for (int phase = 0; phase < PROFILER_LAYER_PHASES; phase++) layers += stats->layers[l].time_ns[phase];
+    }
+    double share = stats->step_time_ns ? (double)layers / stats->step_time_ns : 0.0;
+    bool ok = share > 0.8 && share <= 1.0 && stats->slowest_layer == 0;
+    printf("  Layer spans cover %.1f%% of step time, slowest layer %d (%s) %s\n", 100.0 * share,
+           stats->slowest_layer, stats->slowest_layer >= 0 ? stats->layers[stats->slowest_layer].name : "-",
+           ok ? "✅" : "❌");
+    return ok;
+}
+
+/**
+ * @brief Count events in the exported file and check the JSON frame
+ */
+static bool check_trace(const char* path, uint64_t expected_events, int steps) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        printf("  Trace %s not written ❌\n", path);
+        return false;
+    }
+
+    char line[1024];
+    uint64_t complete = 0, step_spans = 0, lines = 0;
+    bool framed = false, closed = false;
+    while (fgets(line, sizeof(line), file)) {
+        if (lines++ == 0) framed = strncmp(line, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 39) == 0;
+        if (strstr(line, "\"ph\":\"X\"")) complete++;
+        if (strstr(line, "\"cat\":\"step\"")) step_spans++;
+        closed = strcmp(line, "]}\n") == 0;
+    }
+    fclose(file);
+
+    bool ok = framed && closed && complete == expected_events && step_spans == (uint64_t)steps;
+    printf("  Trace %s: %llu complete events, %llu step spans %s\n", path, (unsigned long long)complete,
+           (unsigned long long)step_spans, ok ? "✅" : "❌");
+    return ok;
+}
+
+static bool check_overflow(TensorArena* arena, Tensor* x, const int* labels, int steps) {
+    NeuralNetwork net;
+    profiled_network_init(&net);
+    neural_network_enable_profiling(&net, 16);
+    run_steps(&net, arena, x, labels, steps);
+
+    NetworkStats stats;
+    neural_network_get_stats(&net, &stats);
+    bool ok = stats.events == 16 && stats.dropped_events == (uint64_t)steps * 10 - 16 &&
+              stats.layers[0].calls[PROFILE_FORWARD] == (uint64_t)steps;
+    printf("  Timeline of 16 events: %llu dropped, counters still complete %s\n",
+           (unsigned long long)stats.dropped_events, ok ? "✅" : "❌");
+
+    profiled_network_free(&net);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int steps = argc > 1 ? atoi(argv[1]) : 50;
+    const char* trace = argc > 2 ? argv[2] : "profile_trace.json";
+    if (steps <= 0) steps = 50;
+    srand(42);
+
+    TensorArena* arena = tensor_arena_create(0);
+    Tensor* x = tensor_create(NULL, (int[]){ PROF_BENCH_BATCH, widths[0] }, 2);
+    int labels[PROF_BENCH_BATCH];
+    bench_fill_random(x->data, x->size);
+    for (int r = 0; r < PROF_BENCH_BATCH; r++) labels[r] = rand() % PROF_BENCH_CLASSES;
+
+    NeuralNetwork net;
+    profiled_network_init(&net);
+    int failures = 0;
+
+    // Overhead: alternate unprofiled and profiled rounds, keep the best of each
+    run_steps(&net, arena, x, labels, steps);
+    double plain = 1e30, profiled = 1e30;
+    for (int round = 0; round < PROF_BENCH_ROUNDS; round++) {
+        double t = run_steps(&net, arena, x, labels, steps);
+        if (t < plain) plain = t;
+
+        neural_network_enable_profiling(&net, 0);
+        t = run_steps(&net, arena, x, labels, steps);
+        if (t < profiled) profiled = t;
+        neural_network_disable_profiling(&net);
+    }
+
+    printf("MLP %d -> %d -> %d -> %d, batch %d, Adam: %d steps\n", widths[0], widths[1], widths[2], widths[3],
+           PROF_BENCH_BATCH, steps);
+    printf("  Step %.3f ms unprofiled, %.3f ms profiled (%+.2f%% overhead)\n\n", plain * 1e3 / steps,
+           profiled * 1e3 / steps, 100.0 * (profiled - plain) / plain);
+
+    // Counters and trace of one clean profiled run
+    printf("Training profile\n");
+    neural_network_enable_profiling(&net, 0);
+    run_steps(&net, arena, x, labels, steps);
+
+    NetworkStats stats;
+    neural_network_get_stats(&net, &stats);
+    failures += check_counters(&stats, steps) ? 0 : 1;
+    failures += check_coverage(&stats) ? 0 : 1;
+    failures += neural_network_export_trace(&net, trace) ? 0 : 1;
+    failures += check_trace(trace, stats.events, steps) ? 0 : 1;
+    failures += check_overflow(arena, x, labels, steps) ? 0 : 1;
+
+    char summary[4096];
+    neural_network_profile_summary(&net, summary, sizeof(summary));
+    printf("\n%s", summary);
+
+    // Inference: no step markers, so the table is per forward call
+    neural_network_reset_profile(&net);
+    for (int s = 0; s < steps; s++) {
+        TensorArena* previous = tensor_arena_activate(arena);
+        bench_forward(&net, x);
+        tensor_arena_activate(previous);
+        tensor_arena_reset(arena);
+    }
+    neural_network_profile_summary(&net, summary, sizeof(summary));
+    printf("\nInference %s", summary);
+
+    profiled_network_free(&net);
+    tensor_destroy(x);
+    tensor_arena_destroy(arena);
+
+    printf("\n%s\n", failures ? "❌ Profiler checks failed" : "✅ All profiler checks passed");
+    return failures ? 1 : 0;
+}
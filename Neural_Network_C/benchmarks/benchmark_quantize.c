@@ -0,0 +1,668 @@
+/*
+ * Neural Network System - Int8 Quantization Benchmark
+ * Checks the int8 GEMM kernels against an exact integer reference and the
+ * int8 dense/conv operators against float, then trains small MLP and CNN
+ * demo models, quantizes them with calibrated activation ranges and reports
+ * accuracy delta, latency and model size
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_quantize.c src/quant_kernels.c \
+ *        src/conv_kernels.c src/dense_kernels.c src/gemm.c src/tensor.c src/tensor_arena.c \
+ *        src/thread_pool.c src/activations.c src/vec_math.c -o benchmark_quantize -lm -pthread
+ * Usage: ./benchmark_quantize
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/activations.h"
+#include "../headers/quant_kernels.h"
+#include "bench_common.h"
+
+static Tensor* make_matrix(int rows, int cols) {
+    int shape[2] = { rows, cols };
+    return tensor_create(NULL, shape, 2);
+}
+
+// ============================================================================
+// Int8 GEMM Check
+// ============================================================================
+
+typedef struct {
+    int m, n, k;
+} GemmCase;
+
+static const GemmCase gemm_cases[] = {
+    {  1,  10, 784 },   // single-sample classifier head
+    {  7,  33,  13 },   // ragged rows, panels and groups
+    { 13,  17,   5 },
+    { 64, 128, 256 },
+    {  6,  64,  72 },   // exact 6x32 tiles, conv depth 8*3*3
+};
+
+/**
+ * @brief Compare every supported kernel with a plain int32 reference
+ *
+ * Weights are integers in [-127, 127] with a +/-127 in every row, so the
+ * per-row scale is exactly 1 and the packed codes equal the inputs.
+ */
+static int check_gemm_kernels(void) {
+    int failures = 0;
+    QuantKernelType original = quant_get_kernel();
+
+    for (size_t t = 0; t < sizeof(gemm_cases) / sizeof(gemm_cases[0]); t++) {
+        const GemmCase* gc = &gemm_cases[t];
+        int lda = (gc->k + QUANT_GROUP - 1) / QUANT_GROUP * QUANT_GROUP;
+
+        float* w = (float*)malloc((size_t)gc->n * gc->k * sizeof(float));
+        uint8_t* a = (uint8_t*)calloc((size_t)gc->m * lda, 1);
+        int32_t* ref = (int32_t*)malloc((size_t)gc->m * gc->n * sizeof(int32_t));
+        int32_t* c = (int32_t*)malloc((size_t)gc->m * gc->n * sizeof(int32_t));
+
+        for (int j = 0; j < gc->n; j++) {
+            for (int p = 0; p < gc->k; p++) w[(size_t)j * gc->k + p] = (float)(rand() % 255 - 127);
+            w[(size_t)j * gc->k + rand() % gc->k] = (j & 1) ? 127.0f : -127.0f;
+        }
+        for (int i = 0; i < gc->m; i++) {
+            for (int p = 0; p < gc->k; p++) a[(size_t)i * lda + p] = (uint8_t)(rand() % 256);
+        }
+        for (int i = 0; i < gc->m; i++) {
+            for (int j = 0; j < gc->n; j++) {
+                int32_t sum = 0;
+                for (int p = 0; p < gc->k; p++) {
+                    sum += (int32_t)a[(size_t)i * lda + p] * (int32_t)w[(size_t)j * gc->k + p];
+                }
+                ref[(size_t)i * gc->n + j] = sum;
+            }
+        }
+
+        QuantizedWeights qw;
+        quant_weights_init(&qw, w, gc->n, gc->k);
+
+        for (int kt = QUANT_KERNEL_SCALAR; kt <= QUANT_KERNEL_AVX512_VNNI; kt++) {
+            if (!quant_set_kernel((QuantKernelType)kt)) continue;
+
+            memset(c, 0, (size_t)gc->m * gc->n * sizeof(int32_t));
+            quant_gemm_u8s8(gc->m, a, lda, &qw, c, gc->n);
+            int mismatches = 0;
+            for (int i = 0; i < gc->m * gc->n; i++) mismatches += c[i] != ref[i];
+
+            printf("  %4dx%-4dx%-4d %-12s %s\n", gc->m, gc->n, gc->k,
+                   quant_kernel_name((QuantKernelType)kt), mismatches ? "❌" : "✅");
+            failures += mismatches != 0;
+        }
+
+        quant_weights_free(&qw);
+        free(w);
+        free(a);
+        free(ref);
+        free(c);
+    }
+
+    quant_set_kernel(original);
+    return failures;
+}
+
+// ============================================================================
+// Int8 Operator Check
+// ============================================================================
+
+typedef struct {
+    int in_c, out_c, size, kernel, stride, padding;
+} ConvCase;
+
+static const ConvCase conv_cases[] = {
+    {  1,  8, 28, 3, 1, 1 },
+    {  8, 16, 28, 3, 2, 1 },
+    { 16, 40, 13, 5, 1, 2 },
+    { 32, 64,  7, 1, 1, 0 },
+};
+
+static float relative_error(const float* x, const float* ref, size_t count) {
+    double diff = 0.0, norm = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        diff += (double)(x[i] - ref[i]) * (x[i] - ref[i]);
+        norm += (double)ref[i] * ref[i];
+    }
+    return norm > 0.0 ? (float)sqrt(diff / norm) : (float)sqrt(diff);
+}
+
+/**
+ * @brief Int8 dense and conv operators against the float kernels (NCHW and NHWC)
+ */
+static int check_operators(void) {
+    int failures = 0;
+    const float tolerance = 0.02f;
+
+    for (size_t t = 0; t < sizeof(conv_cases) / sizeof(conv_cases[0]); t++) {
+        const ConvCase* cc = &conv_cases[t];
+        Conv2DParams params = { cc->in_c, cc->out_c, cc->kernel, cc->stride, cc->padding,
+                                activation_relu };
+
+        for (int layout = 0; layout < 2; layout++) {
+            ConvShape shape;
+            conv_shape_init(&shape, &params, 3, cc->size, cc->size, (ConvLayout)layout);
+            int out_h, out_w;
+            conv_output_dims(&shape, &out_h, &out_w);
+
+            int in_size[1] = { 3 * cc->in_c * cc->size * cc->size };
+            int k_size[1] = { cc->out_c * cc->in_c * cc->kernel * cc->kernel };
+            int out_size[1] = { 3 * cc->out_c * out_h * out_w };
+            int b_size[1] = { cc->out_c };
+            Tensor* x = tensor_create(NULL, in_size, 1);
+            Tensor* k = tensor_create(NULL, k_size, 1);
+            Tensor* b = tensor_create(NULL, b_size, 1);
+            Tensor* y = tensor_create(NULL, out_size, 1);
+            Tensor* yq = tensor_create(NULL, out_size, 1);
+            bench_fill_random(x->data, (size_t)x->size);
+            bench_fill_random(k->data, (size_t)k->size);
+            bench_fill_random(b->data, (size_t)b->size);
+
+            QuantizedLinear q;
+            quant_linear_init(&q, k->data, cc->out_c, k_size[0] / cc->out_c, b->data,
+                              -1.0f, 1.0f, activation_relu);
+            conv2d_forward(&shape, CONV_ALGO_IM2COL, x, k, b, activation_relu, y, NULL, NULL);
+            bool ok = quant_conv2d_forward(&q, &shape, x->data, yq->data);
+            float err = relative_error(yq->data, y->data, (size_t)y->size);
+
+            printf("  conv %2d->%-2d %2dx%-2d k%d s%d p%d %s   rel err %.4f %s\n",
+                   cc->in_c, cc->out_c, cc->size, cc->size, cc->kernel, cc->stride, cc->padding,
+                   layout ? "NHWC" : "NCHW", err, ok && err < tolerance ? "✅" : "❌");
+            failures += !(ok && err < tolerance);
+
+            quant_linear_free(&q);
+            tensor_destroy(x);
+            tensor_destroy(k);
+            tensor_destroy(b);
+            tensor_destroy(y);
+            tensor_destroy(yq);
+        }
+    }
+
+    static const DenseActivationFn activations[] = { activation_relu, activation_tanh, activation_softmax };
+    static const char* activation_names[] = { "relu", "tanh", "softmax" };
+    for (int a = 0; a < 3; a++) {
+        int batch = 70, in = 300, out = 50;
+        Tensor* x = make_matrix(batch, in);
+        Tensor* w = make_matrix(out, in);
+        Tensor* b = make_matrix(1, out);
+        Tensor* y = make_matrix(batch, out);
+        Tensor* yq = make_matrix(batch, out);
+        bench_fill_random(x->data, (size_t)x->size);
+        bench_fill_random(w->data, (size_t)w->size);
+        bench_fill_random(b->data, (size_t)b->size);
+        tensor_scale_inplace(w, 0.1f);
+
+        QuantizedLinear q;
+        quant_linear_init(&q, w->data, out, in, b->data, -1.0f, 1.0f, activations[a]);
+        dense_forward_fused(x, w, b, activations[a], y);
+        quant_dense_forward(&q, x->data, batch, yq->data);
+        float err = relative_error(yq->data, y->data, (size_t)y->size);
+
+        printf("  dense %dx%d->%d %-8s rel err %.4f %s\n", batch, in, out, activation_names[a],
+               err, err < tolerance ? "✅" : "❌");
+        failures += !(err < tolerance);
+
+        quant_linear_free(&q);
+        tensor_destroy(x);
+        tensor_destroy(w);
+        tensor_destroy(b);
+        tensor_destroy(y);
+        tensor_destroy(yq);
+    }
+
+    return failures;
+}
+
+// ============================================================================
+// Demo Models
+// ============================================================================
+
+#define DEMO_CLASSES 10
+#define DEMO_IMAGE 28
+#define DEMO_INPUT (DEMO_IMAGE * DEMO_IMAGE)
+#define DEMO_TRAIN 4000
+#define DEMO_TEST 2000
+#define DEMO_CALIBRATION 512
+#define DEMO_BATCH 32
+#define DEMO_MAX_LAYERS 4
+
+typedef struct {
+    bool conv;                  // Conv2D (NCHW) or dense
+    ConvShape shape;            // Conv description (batch set per call)
+    int in_size;                // Input values per sample
+    int out_size;               // Output values per sample
+    int rows, cols;             // Weight matrix shape
+    DenseActivationFn activation;
+    Tensor* weights;
+    Tensor* biases;
+    Tensor* weight_grad;
+    Tensor* bias_grad;
+    QuantRange range;           // Calibrated input range
+    QuantizedLinear quantized;
+} DemoLayer;
+
+typedef struct {
+    const char* name;
+    DemoLayer layers[DEMO_MAX_LAYERS];
+    int num_layers;
+} DemoModel;
+
+static void demo_init_layer(DemoLayer* layer) {
+    layer->weights = make_matrix(layer->rows, layer->cols);
+    layer->biases = make_matrix(1, layer->rows);
+    layer->weight_grad = make_matrix(layer->rows, layer->cols);
+    layer->bias_grad = make_matrix(1, layer->rows);
+
+    // He uniform initialization
+    float limit = sqrtf(6.0f / layer->cols);
+    for (int i = 0; i < layer->weights->size; i++) {
+        layer->weights->data[i] = (((float)rand() / RAND_MAX) * 2.0f - 1.0f) * limit;
+    }
+    quant_range_reset(&layer->range);
+}
+
+static void demo_add_dense(DemoModel* model, int in, int out, DenseActivationFn activation) {
+    DemoLayer* layer = &model->layers[model->num_layers++];
+    memset(layer, 0, sizeof(*layer));
+    layer->in_size = in;
+    layer->out_size = out;
+    layer->rows = out;
+    layer->cols = in;
+    layer->activation = activation;
+    demo_init_layer(layer);
+}
+
+static void demo_add_conv(DemoModel* model, int in_c, int out_c, int size, int stride) {
+    DemoLayer* layer = &model->layers[model->num_layers++];
+    memset(layer, 0, sizeof(*layer));
+
+    Conv2DParams params = { in_c, out_c, 3, stride, 1, activation_relu };
+    conv_shape_init(&layer->shape, &params, 1, size, size, CONV_LAYOUT_NCHW);
+
+    int out_h, out_w;
+    conv_output_dims(&layer->shape, &out_h, &out_w);
+    layer->conv = true;
+    layer->in_size = in_c * size * size;
+    layer->out_size = out_c * out_h * out_w;
+    layer->rows = out_c;
+    layer->cols = in_c * 9;
+    layer->activation = activation_relu;
+    demo_init_layer(layer);
+}
+
+static void demo_free(DemoModel* model) {
+    for (int l = 0; l < model->num_layers; l++) {
+        DemoLayer* layer = &model->layers[l];
+        tensor_destroy(layer->weights);
+        tensor_destroy(layer->biases);
+        tensor_destroy(layer->weight_grad);
+        tensor_destroy(layer->bias_grad);
+        quant_linear_free(&layer->quantized);
+    }
+}
+
+/**
+ * @brief Float forward of one batch; acts[l + 1] receives layer l's output
+ */
+static void demo_forward(DemoModel* model, Tensor** acts, int batch) {
+    for (int l = 0; l < model->num_layers; l++) {
+        DemoLayer* layer = &model->layers[l];
+        if (layer->conv) {
+            layer->shape.batch = batch;
+            conv2d_forward(&layer->shape, CONV_ALGO_AUTO, acts[l], layer->weights, layer->biases,
+                           layer->activation, acts[l + 1], NULL, NULL);
+        } else {
+            dense_forward_fused(acts[l], layer->weights, layer->biases, layer->activation,
+                                acts[l + 1]);
+        }
+    }
+}
+
+/**
+ * @brief Int8 forward of one batch using the calibrated operators
+ */
+static void demo_forward_int8(DemoModel* model, Tensor** acts, int batch) {
+    for (int l = 0; l < model->num_layers; l++) {
+        DemoLayer* layer = &model->layers[l];
+        if (layer->conv) {
+            layer->shape.batch = batch;
+            quant_conv2d_forward(&layer->quantized, &layer->shape, acts[l]->data, acts[l + 1]->data);
+        } else {
+            quant_dense_forward(&layer->quantized, acts[l]->data, batch, acts[l + 1]->data);
+        }
+    }
+}
+
+/**
+ * @brief Per-batch activation buffers (2D so dense layers accept conv outputs)
+ */
+static Tensor** demo_alloc_acts(DemoModel* model, int batch) {
+    Tensor** acts = (Tensor**)calloc(model->num_layers + 1, sizeof(Tensor*));
+    acts[0] = make_matrix(batch, model->layers[0].in_size);
+    for (int l = 0; l < model->num_layers; l++) {
+        acts[l + 1] = make_matrix(batch, model->layers[l].out_size);
+    }
+    return acts;
+}
+
+static void demo_free_acts(DemoModel* model, Tensor** acts) {
+    for (int l = 0; l <= model->num_layers; l++) tensor_destroy(acts[l]);
+    free(acts);
+}
+
+// ============================================================================
+// Synthetic Dataset
+// ============================================================================
+
+/**
+ * @brief Ten blurred random prototypes; samples are shifted, noisy copies
+ */
+static void make_dataset(float* x, int* y, int count, const float* prototypes) {
+    for (int s = 0; s < count; s++) {
+        int label = rand() % DEMO_CLASSES;
+        int dy = rand() % 5 - 2, dx = rand() % 5 - 2;
+        const float* proto = prototypes + (size_t)label * DEMO_INPUT;
+        float* img = x + (size_t)s * DEMO_INPUT;
+
+        for (int i = 0; i < DEMO_IMAGE; i++) {
+            for (int j = 0; j < DEMO_IMAGE; j++) {
+                int si = i + dy, sj = j + dx;
+                float v = (si >= 0 && si < DEMO_IMAGE && sj >= 0 && sj < DEMO_IMAGE)
+                        ? proto[si * DEMO_IMAGE + sj] : 0.0f;
+                float noise = ((float)rand() / RAND_MAX - 0.5f) * 3.0f;
+                v += noise;
+                img[i * DEMO_IMAGE + j] = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+            }
+        }
+        y[s] = label;
+    }
+}
+
+static void make_prototypes(float* prototypes) {
+    float* raw = (float*)malloc(DEMO_INPUT * sizeof(float));
+    for (int c = 0; c < DEMO_CLASSES; c++) {
+        for (int i = 0; i < DEMO_INPUT; i++) raw[i] = (float)rand() / RAND_MAX;
+
+        // 5x5 box blur gives stroke-like blobs that survive the shifts
+        for (int i = 0; i < DEMO_IMAGE; i++) {
+            for (int j = 0; j < DEMO_IMAGE; j++) {
+                float sum = 0.0f;
+                int n = 0;
+                for (int di = -2; di <= 2; di++) {
+                    for (int dj = -2; dj <= 2; dj++) {
+                        int si = i + di, sj = j + dj;
+                        if (si < 0 || si >= DEMO_IMAGE || sj < 0 || sj >= DEMO_IMAGE) continue;
+                        sum += raw[si * DEMO_IMAGE + sj];
+                        n++;
+                    }
+                }
+                float v = (sum / n - 0.5f) * 6.0f + 0.3f;
+                prototypes[(size_t)c * DEMO_INPUT + i * DEMO_IMAGE + j] = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+            }
+        }
+    }
+    free(raw);
+}
+
+// ============================================================================
+// Training and Evaluation
+// ============================================================================
+
+static void demo_train(DemoModel* model, const float* x, const int* y, int count,
+                       int epochs, float learning_rate) {
+    Tensor** acts = demo_alloc_acts(model, DEMO_BATCH);
+    Tensor** grads = demo_alloc_acts(model, DEMO_BATCH);
+    int classes = model->layers[model->num_layers - 1].out_size;
+
+    for (int epoch = 0; epoch < epochs; epoch++) {
+        for (int begin = 0; begin + DEMO_BATCH <= count; begin += DEMO_BATCH) {
+            memcpy(acts[0]->data, x + (size_t)begin * DEMO_INPUT,
+                   (size_t)DEMO_BATCH * DEMO_INPUT * sizeof(float));
+            demo_forward(model, acts, DEMO_BATCH);
+
+            // Softmax cross-entropy gradient on the logits
+            Tensor* logits = acts[model->num_layers];
+            Tensor* delta = grads[model->num_layers];
+            for (int i = 0; i < DEMO_BATCH; i++) {
+                float* g = delta->data + (size_t)i * classes;
+                memcpy(g, logits->data + (size_t)i * classes, classes * sizeof(float));
+                activation_softmax(g, classes);
+                g[y[begin + i]] -= 1.0f;
+                for (int j = 0; j < classes; j++) g[j] /= DEMO_BATCH;
+            }
+
+            for (int l = model->num_layers - 1; l >= 0; l--) {
+                DemoLayer* layer = &model->layers[l];
+                Tensor* grad_input = l > 0 ? grads[l] : NULL;
+                if (layer->conv) {
+                    conv2d_backward(&layer->shape, acts[l], layer->weights, acts[l + 1], NULL,
+                                    layer->activation, grads[l + 1], layer->weight_grad,
+                                    layer->bias_grad, grad_input, false, NULL);
+                } else {
+                    dense_backward_fused(acts[l], layer->weights, acts[l + 1], layer->activation,
+                                         grads[l + 1], layer->weight_grad, layer->bias_grad,
+                                         grad_input, false);
+                }
+                tensor_axpy(layer->weights, -learning_rate, layer->weight_grad);
+                tensor_axpy(layer->biases, -learning_rate, layer->bias_grad);
+            }
+        }
+    }
+
+    demo_free_acts(model, acts);
+    demo_free_acts(model, grads);
+}
+
+/**
+ * @brief Record each layer's float input range over the calibration samples
+ */
+static void demo_calibrate(DemoModel* model, const float* x, int count) {
+    Tensor** acts = demo_alloc_acts(model, DEMO_BATCH);
+
+    for (int begin = 0; begin + DEMO_BATCH <= count; begin += DEMO_BATCH) {
+        memcpy(acts[0]->data, x + (size_t)begin * DEMO_INPUT,
+               (size_t)DEMO_BATCH * DEMO_INPUT * sizeof(float));
+        demo_forward(model, acts, DEMO_BATCH);
+        for (int l = 0; l < model->num_layers; l++) {
+            quant_range_observe(&model->layers[l].range, acts[l]->data, (size_t)acts[l]->size,
+                                QUANT_CALIBRATION_MINMAX, 1.0f);
+        }
+    }
+
+    for (int l = 0; l < model->num_layers; l++) {
+        DemoLayer* layer = &model->layers[l];
+        float lo, hi;
+        quant_range_get(&layer->range, QUANT_CALIBRATION_MINMAX, &lo, &hi);
+        quant_linear_init(&layer->quantized, layer->weights->data, layer->rows, layer->cols,
+                          layer->biases->data, lo, hi, layer->activation);
+    }
+
+    demo_free_acts(model, acts);
+}
+
+typedef struct {
+    double accuracy_fp32;
+    double accuracy_int8;
+    double agreement;           // Fraction of identical top-1 predictions
+    double logit_error;         // RMS logit difference relative to logit RMS
+} DemoAccuracy;
+
+static int argmax(const float* v, int n) {
+    int best = 0;
+    for (int i = 1; i < n; i++) best = v[i] > v[best] ? i : best;
+    return best;
+}
+
+static DemoAccuracy demo_evaluate(DemoModel* model, const float* x, const int* y, int count) {
+    Tensor** acts = demo_alloc_acts(model, DEMO_BATCH);
+    Tensor** acts_q = demo_alloc_acts(model, DEMO_BATCH);
+    int classes = model->layers[model->num_layers - 1].out_size;
+    int correct = 0, correct_q = 0, agree = 0, total = 0;
+    double diff2 = 0.0, ref2 = 0.0;
+
+    for (int begin = 0; begin + DEMO_BATCH <= count; begin += DEMO_BATCH) {
+        memcpy(acts[0]->data, x + (size_t)begin * DEMO_INPUT,
+               (size_t)DEMO_BATCH * DEMO_INPUT * sizeof(float));
+        memcpy(acts_q[0]->data, acts[0]->data, (size_t)DEMO_BATCH * DEMO_INPUT * sizeof(float));
+        demo_forward(model, acts, DEMO_BATCH);
+        demo_forward_int8(model, acts_q, DEMO_BATCH);
+
+        for (int i = 0; i < DEMO_BATCH; i++) {
+            const float* ref = acts[model->num_layers]->data + (size_t)i * classes;
+            const float* q = acts_q[model->num_layers]->data + (size_t)i * classes;
+            int p = argmax(ref, classes), pq = argmax(q, classes);
+            correct += p == y[begin + i];
+            correct_q += pq == y[begin + i];
+            agree += p == pq;
+            total++;
+            for (int j = 0; j < classes; j++) {
+                diff2 += (double)(q[j] - ref[j]) * (q[j] - ref[j]);
+                ref2 += (double)ref[j] * ref[j];
+            }
+        }
+    }
+
+    demo_free_acts(model, acts);
+    demo_free_acts(model, acts_q);
+
+    DemoAccuracy result;
+    result.accuracy_fp32 = (double)correct / total;
+    result.accuracy_int8 = (double)correct_q / total;
+    result.agreement = (double)agree / total;
+    result.logit_error = ref2 > 0.0 ? sqrt(diff2 / ref2) : 0.0;
+    return result;
+}
+
+static size_t demo_bytes_fp32(const DemoModel* model) {
+    size_t bytes = 0;
+    for (int l = 0; l < model->num_layers; l++) {
+        bytes += (size_t)(model->layers[l].weights->size + model->layers[l].biases->size) * sizeof(float);
+    }
+    return bytes;
+}
+
+static size_t demo_bytes_int8(const DemoModel* model) {
+    size_t bytes = 0;
+    for (int l = 0; l < model->num_layers; l++) bytes += quant_linear_bytes(&model->layers[l].quantized);
+    return bytes;
+}
+
+/**
+ * @brief Milliseconds per batch of one forward pass
+ */
+static double demo_latency(DemoModel* model, int batch, bool int8) {
+    Tensor** acts = demo_alloc_acts(model, batch);
+    bench_fill_random(acts[0]->data, (size_t)acts[0]->size);
+    for (int i = 0; i < acts[0]->size; i++) acts[0]->data[i] = fabsf(acts[0]->data[i]);
+
+    double start = bench_now();
+    if (int8) demo_forward_int8(model, acts, batch); else demo_forward(model, acts, batch);
+    int reps = bench_repetitions(bench_now() - start, 0.3);
+
+    start = bench_now();
+    for (int r = 0; r < reps; r++) {
+        if (int8) demo_forward_int8(model, acts, batch); else demo_forward(model, acts, batch);
+    }
+    double ms = (bench_now() - start) / reps * 1e3;
+
+    demo_free_acts(model, acts);
+    return ms;
+}
+
+/**
+ * @brief Print accuracy, size and latency; returns 1 if int8 loses over 1% accuracy
+ */
+static int report_model(DemoModel* model, const float* x_test, const int* y_test) {
+    DemoAccuracy acc = demo_evaluate(model, x_test, y_test, DEMO_TEST);
+    size_t fp32_bytes = demo_bytes_fp32(model);
+    size_t int8_bytes = demo_bytes_int8(model);
+
+    printf("\n%s\n", model->name);
+    printf("  Accuracy   fp32 %.2f%%   int8 %.2f%%   delta %+.2f%%   top-1 agreement %.2f%%   "
+           "logit error %.2f%%\n",
+           acc.accuracy_fp32 * 100.0, acc.accuracy_int8 * 100.0,
+           (acc.accuracy_int8 - acc.accuracy_fp32) * 100.0, acc.agreement * 100.0,
+           acc.logit_error * 100.0);
+    printf("  Size       fp32 %.1f KB   int8 %.1f KB   (%.2fx smaller)\n",
+           fp32_bytes / 1024.0, int8_bytes / 1024.0, (double)fp32_bytes / int8_bytes);
+
+    static const int batches[] = { 1, 64 };
+    QuantKernelType original = quant_get_kernel();
+
+    printf("  %-6s %12s", "Batch", "fp32 (ms)");
+    for (int kt = QUANT_KERNEL_SCALAR; kt <= QUANT_KERNEL_AVX512_VNNI; kt++) {
+        if (quant_set_kernel((QuantKernelType)kt)) printf(" %20s", quant_kernel_name((QuantKernelType)kt));
+    }
+    printf("\n");
+
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b++) {
+        double fp32 = demo_latency(model, batches[b], false);
+        printf("  %-6d %12.4f", batches[b], fp32);
+        for (int kt = QUANT_KERNEL_SCALAR; kt <= QUANT_KERNEL_AVX512_VNNI; kt++) {
+            if (!quant_set_kernel((QuantKernelType)kt)) continue;
+            double ms = demo_latency(model, batches[b], true);
+            printf("   %9.4f (%5.2fx)", ms, fp32 / ms);
+        }
+        printf("\n");
+    }
+
+    quant_set_kernel(original);
+
+    if (acc.accuracy_fp32 - acc.accuracy_int8 > 0.01) {
+        printf("  ❌ int8 accuracy more than 1%% below fp32\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    srand(42);
+
+    printf("Int8 GEMM kernels (selected: %s)\n", quant_kernel_name(quant_get_kernel()));
+    int failures = check_gemm_kernels();
+    printf("\nInt8 operators vs float\n");
+    failures += check_operators();
+
+    float* prototypes = (float*)malloc((size_t)DEMO_CLASSES * DEMO_INPUT * sizeof(float));
+    float* x_train = (float*)malloc((size_t)DEMO_TRAIN * DEMO_INPUT * sizeof(float));
+    float* x_test = (float*)malloc((size_t)DEMO_TEST * DEMO_INPUT * sizeof(float));
+    int* y_train = (int*)malloc(DEMO_TRAIN * sizeof(int));
+    int* y_test = (int*)malloc(DEMO_TEST * sizeof(int));
+
+    make_prototypes(prototypes);
+    make_dataset(x_train, y_train, DEMO_TRAIN, prototypes);
+    make_dataset(x_test, y_test, DEMO_TEST, prototypes);
+
+    DemoModel mlp = { "MLP 784-256-128-10", { { 0 } }, 0 };
+    demo_add_dense(&mlp, DEMO_INPUT, 256, activation_relu);
+    demo_add_dense(&mlp, 256, 128, activation_relu);
+    demo_add_dense(&mlp, 128, DEMO_CLASSES, activation_linear);
+
+    DemoModel cnn = { "CNN conv8-conv16/2-conv32/2-dense10", { { 0 } }, 0 };
+    demo_add_conv(&cnn, 1, 8, DEMO_IMAGE, 1);
+    demo_add_conv(&cnn, 8, 16, DEMO_IMAGE, 2);
+    demo_add_conv(&cnn, 16, 32, DEMO_IMAGE / 2, 2);
+    demo_add_dense(&cnn, 32 * 7 * 7, DEMO_CLASSES, activation_linear);
+
+    DemoModel* models[] = { &mlp, &cnn };
+    for (int m = 0; m < 2; m++) {
+        demo_train(models[m], x_train, y_train, DEMO_TRAIN, 3, 0.05f);
+        demo_calibrate(models[m], x_train, DEMO_CALIBRATION);
+        failures += report_model(models[m], x_test, y_test);
+    }
+
+    demo_free(&mlp);
+    demo_free(&cnn);
+    free(prototypes);
+    free(x_train);
+    free(x_test);
+    free(y_train);
+    free(y_test);
+
+    printf("\n%s\n", failures ? "❌ Int8 checks failed" : "✅ All int8 checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,373 @@
+/*
+ * Neural Network System - Recurrent Kernels Benchmark
+ * Checks the fused LSTM/GRU engine against a per-gate, per-timestep
+ * reference and its gradients against finite differences (including BPTT
+ * truncation), then reports tokens/sec for sequence lengths 32-1024
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_rnn.c src/rnn_kernels.c src/gemm.c \
+ *        src/vec_math.c src/tensor.c src/tensor_arena.c src/thread_pool.c -o benchmark_rnn -lm -pthread
+ * Usage: ./benchmark_rnn [seconds per measurement, default 0.5]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/rnn_kernels.h"
+#include "../headers/gemm.h"
+#include "bench_common.h"
+
+#define RNN_BENCH_BATCH 32
+#define RNN_BENCH_INPUT 128
+#define RNN_BENCH_HIDDEN 256
+
+static const int rnn_bench_steps[] = { 32, 128, 512, 1024 };
+
+/**
+ * @brief Parameters and buffers for one shape
+ */
+typedef struct {
+    RnnShape shape;
+    Tensor* input;
+    Tensor* input_weights;
+    Tensor* hidden_weights;
+    Tensor* biases;
+    Tensor* output;
+    Tensor* grad_output;
+    Tensor* input_weight_grad;
+    Tensor* hidden_weight_grad;
+    Tensor* bias_grad;
+    Tensor* grad_input;
+    float* workspace;
+    bool return_sequences;
+} RnnCase;
+
+static Tensor* rnn_tensor(int rows, int cols) {
+    int shape[2] = { rows, cols };
+    return tensor_create(NULL, shape, 2);
+}
+
+static void rnn_case_init(RnnCase* c, RnnCell cell, int batch, int steps, int input_size,
+                          int hidden, bool return_sequences) {
+    RnnShape shape = { cell, batch, steps, input_size, hidden, 0 };
+    int gates_h = rnn_gate_count(cell) * hidden;
+    int out_rows = batch * (return_sequences ? steps : 1);
+
+    c->shape = shape;
+    c->return_sequences = return_sequences;
+    c->input = rnn_tensor(batch * steps, input_size);
+    c->input_weights = rnn_tensor(gates_h, input_size);
+    c->hidden_weights = rnn_tensor(gates_h, hidden);
+    c->biases = rnn_tensor(1, gates_h);
+    c->output = rnn_tensor(out_rows, hidden);
+    c->grad_output = rnn_tensor(out_rows, hidden);
+    c->input_weight_grad = rnn_tensor(gates_h, input_size);
+    c->hidden_weight_grad = rnn_tensor(gates_h, hidden);
+    c->bias_grad = rnn_tensor(1, gates_h);
+    c->grad_input = rnn_tensor(batch * steps, input_size);
+    c->workspace = (float*)malloc(rnn_workspace_size(&shape) * sizeof(float));
+
+    bench_fill_random(c->input->data, c->input->size);
+    bench_fill_random(c->input_weights->data, c->input_weights->size);
+    bench_fill_random(c->hidden_weights->data, c->hidden_weights->size);
+    bench_fill_random(c->biases->data, c->biases->size);
+    bench_fill_random(c->grad_output->data, c->grad_output->size);
+    float wx = 1.0f / sqrtf((float)input_size), wh = 1.0f / sqrtf((float)hidden);
+    for (int i = 0; i < c->input_weights->size; i++) c->input_weights->data[i] *= wx;
+    for (int i = 0; i < c->hidden_weights->size; i++) c->hidden_weights->data[i] *= wh;
+}
+
+static void rnn_case_free(RnnCase* c) {
+    tensor_destroy(c->input);
+    tensor_destroy(c->input_weights);
+    tensor_destroy(c->hidden_weights);
+    tensor_destroy(c->biases);
+    tensor_destroy(c->output);
+    tensor_destroy(c->grad_output);
+    tensor_destroy(c->input_weight_grad);
+    tensor_destroy(c->hidden_weight_grad);
+    tensor_destroy(c->bias_grad);
+    tensor_destroy(c->grad_input);
+    free(c->workspace);
+}
+
+static bool rnn_case_forward(RnnCase* c) {
+    return rnn_forward(&c->shape, c->input, c->input_weights, c->hidden_weights, c->biases,
+                       NULL, NULL, c->return_sequences, c->output, c->workspace);
+}
+
+static bool rnn_case_backward(RnnCase* c) {
+    return rnn_backward(&c->shape, c->input, c->input_weights, c->hidden_weights, c->grad_output,
+                        c->return_sequences, c->input_weight_grad, c->hidden_weight_grad,
+                        c->bias_grad, c->grad_input, false, c->workspace);
+}
+
+static const char* rnn_cell_name(RnnCell cell) {
+    return cell == RNN_CELL_LSTM ? "LSTM" : "GRU";
+}
+
+// ============================================================================
+// Per-Gate Reference
+// ============================================================================
+
+static float ref_sigmoid(float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+/**
+ * @brief What separate gate matrices imply: two small GEMMs per gate per
+ *        timestep, then scalar nonlinearities
+ */
+static void ref_forward(const RnnCase* c, float* output, float* scratch) {
+    const RnnShape* s = &c->shape;
+    int B = s->batch, T = s->steps, I = s->input_size, H = s->hidden_size;
+    int gates = rnn_gate_count(s->cell);
+    float* h = scratch;                         // B x H
+    float* cell = h + (size_t)B * H;            // B x H
+    float* pre = cell + (size_t)B * H;          // gates x B x H
+    float* hn = pre + (size_t)gates * B * H;    // B x H (GRU W_hn h)
+
+    memset(h, 0, (size_t)2 * B * H * sizeof(float));
+    for (int t = 0; t < T; t++) {
+        for (int g = 0; g < gates; g++) {
+            float* p = pre + (size_t)g * B * H;
+            const float* wx = c->input_weights->data + (size_t)g * H * I;
+            const float* wh = c->hidden_weights->data + (size_t)g * H * H;
+            gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, B, H, I, 1.0f, c->input->data + (size_t)t * I, T * I,
+                       wx, I, 0.0f, p, H);
+            bool reset_after = s->cell == RNN_CELL_GRU && g == 2;
+            gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, B, H, H, 1.0f, h, H, wh, H,
+                       reset_after ? 0.0f : 1.0f, reset_after ? hn : p, H);
+            for (int b = 0; b < B; b++) {
+                for (int j = 0; j < H; j++) p[b * H + j] += c->biases->data[g * H + j];
+            }
+        }
+
+        for (int b = 0; b < B; b++) {
+            for (int j = 0; j < H; j++) {
+                size_t k = (size_t)b * H + j;
+                size_t plane = (size_t)B * H;
+                if (s->cell == RNN_CELL_LSTM) {
+                    float i = ref_sigmoid(pre[k]), f = ref_sigmoid(pre[plane + k]);
+                    float g = tanhf(pre[2 * plane + k]), o = ref_sigmoid(pre[3 * plane + k]);
+                    cell[k] = f * cell[k] + i * g;
+                    h[k] = o * tanhf(cell[k]);
+                } else {
+                    float z = ref_sigmoid(pre[k]), r = ref_sigmoid(pre[plane + k]);
+                    float n = tanhf(pre[2 * plane + k] + r * hn[k]);
+                    h[k] = (1.0f - z) * n + z * h[k];
+                }
+                if (c->return_sequences) output[((size_t)b * T + t) * H + j] = h[k];
+                else if (t == T - 1) output[k] = h[k];
+            }
+        }
+    }
+}
+
+static size_t ref_scratch_floats(const RnnShape* s) {
+    return (size_t)(3 + rnn_gate_count(s->cell)) * s->batch * s->hidden_size;
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+static int check_forward(RnnCell cell, bool return_sequences) {
+    RnnCase c;
+    rnn_case_init(&c, cell, 5, 9, 12, 20, return_sequences);
+    float* expected = (float*)malloc(c.output->size * sizeof(float));
+    float* scratch = (float*)malloc(ref_scratch_floats(&c.shape) * sizeof(float));
+
+    bool ok = rnn_case_forward(&c);
+    ref_forward(&c, expected, scratch);
+
+    double max_error = 0.0;
+    for (int i = 0; i < c.output->size && ok; i++) {
+        double err = fabs(expected[i] - c.output->data[i]);
+        if (err > max_error) max_error = err;
+    }
+    ok = ok && max_error < 1e-5;
+    printf("%-4s forward %-9s vs per-gate reference: max error %.2e %s\n", rnn_cell_name(cell),
+           return_sequences ? "(seq)" : "(last)", max_error, ok ? "✅" : "❌");
+
+    free(expected);
+    free(scratch);
+    rnn_case_free(&c);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Loss = sum(output * grad_output), evaluated in double
+ */
+static double rnn_case_loss(RnnCase* c) {
+    rnn_case_forward(c);
+    double loss = 0.0;
+    for (int i = 0; i < c->output->size; i++) loss += (double)c->output->data[i] * c->grad_output->data[i];
+    return loss;
+}
+
+/**
+ * @brief Largest relative gap between analytic and central-difference gradients
+ */
+static double gradient_gap(RnnCase* c, Tensor* param, const float* analytic) {
+    const float eps = 1e-2f;
+    double worst = 0.0;
+
+    for (int i = 0; i < param->size; i++) {
+        float saved = param->data[i];
+        param->data[i] = saved + eps;
+        double up = rnn_case_loss(c);
+        param->data[i] = saved - eps;
+        double down = rnn_case_loss(c);
+        param->data[i] = saved;
+
+        double numeric = (up - down) / (2.0 * eps);
+        double gap = fabs(numeric - analytic[i]) / (fabs(numeric) + fabs(analytic[i]) + 1e-2);
+        if (gap > worst) worst = gap;
+    }
+    return worst;
+}
+
+static int check_gradients(RnnCell cell, bool return_sequences) {
+    RnnCase c;
+    rnn_case_init(&c, cell, 2, 6, 3, 17, return_sequences);
+
+    bool ok = rnn_case_forward(&c) && rnn_case_backward(&c);
+    size_t wx = c.input_weight_grad->size, wh = c.hidden_weight_grad->size, nb = c.bias_grad->size;
+    size_t nx = c.grad_input->size;
+    float* analytic = (float*)malloc((wx + wh + nb + nx) * sizeof(float));
+    memcpy(analytic, c.input_weight_grad->data, wx * sizeof(float));
+    memcpy(analytic + wx, c.hidden_weight_grad->data, wh * sizeof(float));
+    memcpy(analytic + wx + wh, c.bias_grad->data, nb * sizeof(float));
+    memcpy(analytic + wx + wh + nb, c.grad_input->data, nx * sizeof(float));
+
+    double gap = gradient_gap(&c, c.input_weights, analytic);
+    double g = gradient_gap(&c, c.hidden_weights, analytic + wx);
+    gap = g > gap ? g : gap;
+    g = gradient_gap(&c, c.biases, analytic + wx + wh);
+    gap = g > gap ? g : gap;
+    g = gradient_gap(&c, c.input, analytic + wx + wh + nb);
+    gap = g > gap ? g : gap;
+
+    ok = ok && gap < 1e-2;
+    printf("%-4s gradients %-7s vs finite differences: max relative gap %.2e %s\n", rnn_cell_name(cell),
+           return_sequences ? "(seq)" : "(last)", gap, ok ? "✅" : "❌");
+
+    free(analytic);
+    rnn_case_free(&c);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief With a window of k steps and only the last output scored, inputs
+ *        before the last window get no gradient; full BPTT reaches them all
+ */
+static int check_truncation(RnnCell cell) {
+    RnnCase c;
+    int steps = 12, window = 4;
+    rnn_case_init(&c, cell, 3, steps, 5, 16, false);
+
+    int cut = 0, reached = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        c.shape.bptt_steps = pass == 0 ? window : 0;
+        bool ok = rnn_case_forward(&c) && rnn_case_backward(&c);
+
+        for (int b = 0; b < c.shape.batch && ok; b++) {
+            for (int t = 0; t < steps; t++) {
+                double norm = 0.0;
+                const float* row = c.grad_input->data + ((size_t)b * steps + t) * c.shape.input_size;
+                for (int i = 0; i < c.shape.input_size; i++) norm += fabs(row[i]);
+                if (pass == 0 && t < steps - window && norm != 0.0) cut++;
+                if (pass == 1 && norm > 0.0) reached++;
+            }
+        }
+    }
+
+    bool ok = cut == 0 && reached == c.shape.batch * steps;
+    printf("%-4s truncated BPTT (window %d of %d): %d leaked, %d/%d reached with full BPTT %s\n",
+           rnn_cell_name(cell), window, steps, cut, reached, c.shape.batch * steps, ok ? "✅" : "❌");
+    rnn_case_free(&c);
+    return ok ? 0 : 1;
+}
+
+// ============================================================================
+// Throughput
+// ============================================================================
+
+typedef enum {
+    RUN_REFERENCE,              // Per-gate forward
+    RUN_FORWARD,                // Fused forward
+    RUN_TRAIN                   // Fused forward + backward
+} RunKind;
+
+static double tokens_per_second(RnnCase* c, RunKind kind, double seconds, float* output, float* scratch) {
+    double start = bench_now();
+    int runs = 0;
+
+    do {
+        if (kind == RUN_REFERENCE) {
+            ref_forward(c, output, scratch);
+        } else {
+            rnn_case_forward(c);
+            if (kind == RUN_TRAIN) rnn_case_backward(c);
+        }
+        runs++;
+    } while (bench_now() - start < seconds);
+
+    double elapsed = bench_now() - start;
+    return (double)runs * c->shape.batch * c->shape.steps / elapsed;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 0.5;
+    if (seconds <= 0.0) seconds = 0.5;
+    srand(42);
+
+    int failures = 0;
+    for (int cell = RNN_CELL_LSTM; cell <= RNN_CELL_GRU; cell++) {
+        failures += check_forward((RnnCell)cell, true);
+        failures += check_forward((RnnCell)cell, false);
+        failures += check_gradients((RnnCell)cell, true);
+        failures += check_gradients((RnnCell)cell, false);
+        failures += check_truncation((RnnCell)cell);
+    }
+
+    printf("\nBatch %d, input %d, hidden %d, %s GEMM kernel, %.1f s per measurement\n", RNN_BENCH_BATCH,
+           RNN_BENCH_INPUT, RNN_BENCH_HIDDEN, gemm_kernel_name(gemm_get_kernel()), seconds);
+    printf("%-5s %-6s | %14s | %14s | %8s | %14s\n", "Cell", "Steps", "Per-gate tok/s",
+           "Fused tok/s", "Speedup", "Train tok/s");
+
+    double worst_speedup = 1e30;
+    for (int cell = RNN_CELL_LSTM; cell <= RNN_CELL_GRU; cell++) {
+        for (size_t i = 0; i < sizeof(rnn_bench_steps) / sizeof(rnn_bench_steps[0]); i++) {
+            RnnCase c;
+            rnn_case_init(&c, (RnnCell)cell, RNN_BENCH_BATCH, rnn_bench_steps[i], RNN_BENCH_INPUT,
+                          RNN_BENCH_HIDDEN, true);
+            c.shape.bptt_steps = 32;
+            float* output = (float*)malloc(c.output->size * sizeof(float));
+            float* scratch = (float*)malloc(ref_scratch_floats(&c.shape) * sizeof(float));
+
+            double reference = tokens_per_second(&c, RUN_REFERENCE, seconds, output, scratch);
+            double fused = tokens_per_second(&c, RUN_FORWARD, seconds, output, scratch);
+            double train = tokens_per_second(&c, RUN_TRAIN, seconds, output, scratch);
+            double speedup = fused / reference;
+            if (speedup < worst_speedup) worst_speedup = speedup;
+
+            printf("%-5s %-6d | %14.0f | %14.0f | %7.2fx | %14.0f\n", rnn_cell_name((RnnCell)cell),
+                   rnn_bench_steps[i], reference, fused, speedup, train);
+
+            free(output);
+            free(scratch);
+            rnn_case_free(&c);
+        }
+    }
+
+    printf("\nFused forward vs per-gate: at least %.2fx %s\n", worst_speedup, worst_speedup > 1.0 ? "✅" : "❌");
+    failures += worst_speedup > 1.0 ? 0 : 1;
+
+    printf("\n%s\n", failures ? "❌ Recurrent kernel checks failed" : "✅ All recurrent kernel checks passed");
+    return failures ? 1 : 0;
+}
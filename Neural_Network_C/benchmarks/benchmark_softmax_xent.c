@@ -0,0 +1,243 @@
+/*
+ * Neural Network System - Fused Softmax Cross-Entropy Benchmark
+ * Checks the fused log-sum-exp loss against the softmax + categorical
+ * cross-entropy pipeline and finite differences, its stability on extreme
+ * logits and sparse/dense agreement, then times both for 10-10000 classes
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_softmax_xent.c src/losses.c src/vec_math.c \
+ *        src/tensor.c src/tensor_arena.c src/gemm.c src/thread_pool.c -o benchmark_softmax_xent \
+ *        -lm -pthread
+ * Usage: ./benchmark_softmax_xent [seconds per measurement, default 0.3]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/neural_net.h"
+#include "../headers/losses.h"
+#include "../headers/vec_math.h"
+#include "bench_common.h"
+
+#define XENT_BENCH_ROWS 256
+
+static const int xent_bench_classes[] = { 10, 100, 1000, 10000 };
+
+/**
+ * @brief Logits, one-hot targets and sparse labels for one shape
+ */
+typedef struct {
+    int rows, classes;
+    Tensor* logits;
+    Tensor* one_hot;
+    Tensor* labels;             // Class index per row, as floats
+    Tensor* gradient;
+    int* int_labels;
+} XentCase;
+
+static void xent_case_init(XentCase* c, int rows, int classes, float spread) {
+    c->rows = rows;
+    c->classes = classes;
+    c->logits = tensor_create(NULL, (int[]){ rows, classes }, 2);
+    c->one_hot = tensor_create(NULL, (int[]){ rows, classes }, 2);
+    c->labels = tensor_create(NULL, (int[]){ rows }, 1);
+    c->gradient = tensor_create(NULL, (int[]){ rows, classes }, 2);
+    c->int_labels = (int*)malloc((size_t)rows * sizeof(int));
+
+    memset(c->one_hot->data, 0, (size_t)c->one_hot->size * sizeof(float));
+    bench_fill_random(c->logits->data, c->logits->size);
+    for (int i = 0; i < c->logits->size; i++) c->logits->data[i] *= spread;
+    for (int r = 0; r < rows; r++) {
+        int label = rand() % classes;
+        c->int_labels[r] = label;
+        c->labels->data[r] = (float)label;
+        c->one_hot->data[(size_t)r * classes + label] = 1.0f;
+    }
+}
+
+static void xent_case_free(XentCase* c) {
+    tensor_destroy(c->logits);
+    tensor_destroy(c->one_hot);
+    tensor_destroy(c->labels);
+    tensor_destroy(c->gradient);
+    free(c->int_labels);
+}
+
+/**
+ * @brief Double-precision loss per row and gradient, the ground truth
+ */
+static double reference(const XentCase* c, double* gradient) {
+    double total = 0.0;
+    for (int r = 0; r < c->rows; r++) {
+        const float* z = c->logits->data + (size_t)r * c->classes;
+        double max = z[0], sum = 0.0;
+        for (int j = 1; j < c->classes; j++) max = z[j] > max ? z[j] : max;
+        for (int j = 0; j < c->classes; j++) sum += exp(z[j] - max);
+        double lse = max + log(sum);
+        total += lse - z[c->int_labels[r]];
+        for (int j = 0; j < c->classes; j++) {
+            double p = exp(z[j] - lse);
+            gradient[(size_t)r * c->classes + j] = (p - (j == c->int_labels[r])) / c->rows;
+        }
+    }
+    return total / c->rows;
+}
+
+/**
+ * @brief The pipeline the fused loss replaces: softmax activation,
+ *        clamped-log cross-entropy, separate allocating gradient pass
+ *
+ * The old loss averages over every element; it is rescaled to the per-row
+ * convention so the values are comparable.
+ */
+static float unfused(XentCase* c, Tensor* probabilities, Tensor** gradient) {
+    memcpy(probabilities->data, c->logits->data, (size_t)c->logits->size * sizeof(float));
+    for (int r = 0; r < c->rows; r++) vec_math_softmax(probabilities->data + (size_t)r * c->classes, c->classes);
+
+    float loss = loss_categorical_crossentropy_compute(probabilities, c->one_hot) * c->classes;
+    *gradient = loss_categorical_crossentropy_gradient(probabilities, c->one_hot);
+    return loss;
+}
+
+// ============================================================================
+// Correctness
+// ============================================================================
+
+static int check_against_reference(int classes, float spread) {
+    XentCase c;
+    xent_case_init(&c, 64, classes, spread);
+    double* expected = (double*)malloc(c.logits->size * sizeof(double));
+    double ref = reference(&c, expected);
+
+    float dense = loss_softmax_crossentropy_fused(c.logits, c.one_hot, c.gradient);
+    double dense_gap = 0.0;
+    for (int i = 0; i < c.gradient->size; i++) {
+        double gap = fabs(c.gradient->data[i] - expected[i]);
+        if (gap > dense_gap) dense_gap = gap;
+    }
+
+    float sparse = loss_softmax_crossentropy_fused(c.logits, c.labels, c.gradient);
+    float* raw = (float*)malloc(c.logits->size * sizeof(float));
+    float raw_loss = loss_softmax_crossentropy_sparse(c.logits->data, c.int_labels, c.rows, classes, raw);
+    bool same = raw_loss == sparse && memcmp(raw, c.gradient->data, c.logits->size * sizeof(float)) == 0;
+
+    double loss_gap = fmax(fabs(dense - ref), fabs(sparse - ref)) / fmax(1.0, fabs(ref));
+    bool ok = isfinite(sparse) && loss_gap < 1e-5 && dense_gap < 1e-7 && same;
+    printf("Classes %-5d logits ±%-6g loss %10.4f vs %10.4f (double), grad gap %.1e, float == int labels %s %s\n",
+           classes, spread, sparse, ref, dense_gap, same ? "yes" : "no", ok ? "✅" : "❌");
+
+    free(raw);
+    free(expected);
+    xent_case_free(&c);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Central differences of the fused loss against its gradient
+ */
+static int check_finite_differences(void) {
+    XentCase c;
+    xent_case_init(&c, 8, 13, 3.0f);
+    loss_softmax_crossentropy_fused(c.logits, c.labels, c.gradient);
+
+    const float h = 1e-2f;
+    double worst = 0.0;
+    for (int i = 0; i < c.logits->size; i++) {
+        float saved = c.logits->data[i];
+        c.logits->data[i] = saved + h;
+        float up = loss_softmax_crossentropy_compute(c.logits, c.labels);
+        c.logits->data[i] = saved - h;
+        float down = loss_softmax_crossentropy_compute(c.logits, c.labels);
+        c.logits->data[i] = saved;
+
+        double gap = fabs((up - down) / (2.0 * h) - c.gradient->data[i]);
+        if (gap > worst) worst = gap;
+    }
+
+    bool ok = worst < 1e-3;
+    printf("Gradient vs finite differences: max gap %.2e %s\n", worst, ok ? "✅" : "❌");
+    xent_case_free(&c);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Invalid labels and mismatched shapes are rejected
+ */
+static int check_validation(void) {
+    XentCase c;
+    xent_case_init(&c, 4, 5, 1.0f);
+
+    c.labels->data[2] = 5.0f;
+    bool out_of_range = loss_softmax_crossentropy_gradient(c.logits, c.labels) == NULL;
+    c.labels->data[2] = 1.5f;
+    bool fractional = loss_softmax_crossentropy_gradient(c.logits, c.labels) == NULL;
+    c.int_labels[1] = -1;
+    bool negative = loss_softmax_crossentropy_sparse(c.logits->data, c.int_labels, 4, 5, NULL) == 0.0f;
+
+    bool ok = out_of_range && fractional && negative;
+    printf("Invalid labels rejected %s\n", ok ? "✅" : "❌");
+    xent_case_free(&c);
+    return ok ? 0 : 1;
+}
+
+// ============================================================================
+// Throughput
+// ============================================================================
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 0.3;
+    if (seconds <= 0.0) seconds = 0.3;
+    srand(42);
+
+    int failures = 0;
+    failures += check_against_reference(10, 5.0f);
+    failures += check_against_reference(1000, 5.0f);
+    failures += check_against_reference(10, 1000.0f);
+    failures += check_against_reference(1000, 1e4f);
+    failures += check_finite_differences();
+    failures += check_validation();
+
+    printf("\n%d rows, %s math kernel, %.2f s per measurement (rows/s)\n", XENT_BENCH_ROWS,
+           vec_math_kernel_name(vec_math_get_kernel()), seconds);
+    printf("%-8s | %12s | %12s | %12s | %8s\n", "Classes", "Unfused", "Fused dense", "Fused sparse",
+           "Speedup");
+
+    double worst_speedup = 1e30;
+    for (size_t i = 0; i < sizeof(xent_bench_classes) / sizeof(xent_bench_classes[0]); i++) {
+        XentCase c;
+        xent_case_init(&c, XENT_BENCH_ROWS, xent_bench_classes[i], 4.0f);
+        Tensor* probabilities = tensor_create(NULL, c.logits->shape, 2);
+        double rate[3];
+
+        for (int variant = 0; variant < 3; variant++) {
+            double start = bench_now();
+            long calls = 0;
+            do {
+                if (variant == 0) {
+                    Tensor* gradient;
+                    unfused(&c, probabilities, &gradient);
+                    tensor_destroy(gradient);
+                } else {
+                    loss_softmax_crossentropy_fused(c.logits, variant == 1 ? c.one_hot : c.labels, c.gradient);
+                }
+                calls++;
+            } while (bench_now() - start < seconds);
+            rate[variant] = (double)calls * c.rows / (bench_now() - start);
+        }
+
+        double speedup = rate[2] / rate[0];
+        if (speedup < worst_speedup) worst_speedup = speedup;
+        printf("%-8d | %12.0f | %12.0f | %12.0f | %7.2fx\n", c.classes, rate[0], rate[1], rate[2], speedup);
+
+        tensor_destroy(probabilities);
+        xent_case_free(&c);
+    }
+
+    printf("\nFused sparse vs unfused: at least %.2fx %s\n", worst_speedup, worst_speedup > 1.0 ? "✅" : "❌");
+    failures += worst_speedup > 1.0 ? 0 : 1;
+
+    printf("\n%s\n", failures ? "❌ Softmax cross-entropy checks failed" : "✅ All softmax cross-entropy checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,996 @@
+/*
+ * Neural Network System - Benchmark Suite
+ * Times matrix_multiply, every activation, loss and optimizer update,
+ * dense/conv/LSTM forward and backward at several sizes and one training
+ * epoch of an MLP, writes the results with machine information as JSON and
+ * compares them against a previous run to catch performance regressions
+ *
+ * Build: gcc -O2 -I headers/ benchmarks/benchmark_suite.c src/optimizers.c src/losses.c \
+ *        src/conv_kernels.c src/rnn_kernels.c src/dense_kernels.c src/vec_math.c src/gemm.c \
+ *        src/tensor.c src/tensor_arena.c src/thread_pool.c src/activations.c \
+ *        -o benchmark_suite -lm -pthread
+ * Usage: ./benchmark_suite [--json out.json] [--baseline previous.json] [--threshold 0.10]
+ *                          [--filter substring] [--threads n] [--quick]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/utsname.h>
+#endif
+#include "../headers/neural_net.h"
+#include "../headers/activations.h"
+#include "../headers/losses.h"
+#include "../headers/optimizers.h"
+#include "../headers/dense_kernels.h"
+#include "../headers/conv_kernels.h"
+#include "../headers/rnn_kernels.h"
+#include "../headers/vec_math.h"
+#include "../headers/gemm.h"
+#include "../headers/thread_pool.h"
+#include "../headers/tensor_arena.h"
+#include "bench_common.h"
+
+#define SUITE_SCHEMA_VERSION 1
+#define SUITE_MAX_RESULTS 256
+#define SUITE_SECONDS 0.1               // Timed duration per round (--quick: a fifth)
+#define SUITE_ROUNDS 3                  // Rounds per case; the fastest is reported
+#define SUITE_THRESHOLD 0.10            // Slowdown over the baseline reported as a regression
+
+#define SUITE_ELEMENTS (1 << 18)        // Activation vector length
+#define SUITE_SOFTMAX_ROW 1024          // Softmax row length
+#define SUITE_LOSS_ROWS 256             // Loss batch
+#define SUITE_LOSS_CLASSES 1000         // Loss classes
+
+#define SUITE_EPOCH_SAMPLES 8192        // End-to-end training set
+#define SUITE_EPOCH_BATCH 128           // End-to-end batch size
+#define SUITE_EPOCH_CLASSES 10          // End-to-end classes
+
+/**
+ * @brief One timed case
+ */
+typedef struct {
+    char name[80];              // Unique key: group/case/size
+    char group[16];             // Case family
+    double seconds;             // Best mean time per call
+    double work;                // Units of work per call
+    const char* unit;           // Throughput unit (work / seconds)
+    int repetitions;            // Calls per timed round
+} SuiteResult;
+
+/**
+ * @brief Run options and collected results
+ */
+typedef struct {
+    const char* filter;         // Only cases whose name contains this (NULL = all)
+    double seconds;             // Timed duration per round
+    int threads;                // GEMM pool size
+    double overhead;            // Per-call time subtracted from results (e.g. restoring an in-place input)
+    char title[160];            // Group heading, printed before its first selected case
+    SuiteResult results[SUITE_MAX_RESULTS];
+    int num_results;
+} Suite;
+
+typedef void (*SuiteFn)(void* context);
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+static bool suite_selected(const Suite* suite, const char* name) {
+    return !suite->filter || strstr(name, suite->filter) != NULL;
+}
+
+/**
+ * @brief Time fn(context): warm-up, calibrate, then the fastest of SUITE_ROUNDS rounds
+ * @param work Units of work one call performs
+ * @param unit Throughput unit shown and stored
+ */
+static void suite_time(Suite* suite, const char* group, const char* name, SuiteFn fn, void* context,
+                       double work, const char* unit) {
+    if (suite->num_results >= SUITE_MAX_RESULTS) return;
+
+    fn(context);
+    double start = bench_now();
+    fn(context);
+    int reps = bench_repetitions(bench_now() - start, suite->seconds);
+
+    double best = 1e30;
+    for (int round = 0; round < SUITE_ROUNDS; round++) {
+        start = bench_now();
+        for (int r = 0; r < reps; r++) fn(context);
+        double t = (bench_now() - start) / reps;
+        if (t < best) best = t;
+    }
+    best = best - suite->overhead > 0.05 * best ? best - suite->overhead : 0.05 * best;
+
+    if (suite->title[0]) {
+        printf("\n%s\n", suite->title);
+        printf("  %-44s | %11s | %s\n", "Case", "ms / call", "Throughput");
+        suite->title[0] = '\0';
+    }
+
+    SuiteResult* result = &suite->results[suite->num_results++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    snprintf(result->group, sizeof(result->group), "%s", group);
+    result->seconds = best;
+    result->work = work;
+    result->unit = unit;
+    result->repetitions = reps;
+    printf("  %-44s | %11.4f | %10.2f %s\n", name, best * 1e3, work / best, unit);
+}
+
+static void suite_group(Suite* suite, const char* title) {
+    snprintf(suite->title, sizeof(suite->title), "%s", title);
+}
+
+static Tensor* suite_tensor(int rows, int cols) {
+    Tensor* t = tensor_create(NULL, (int[]){ rows, cols }, 2);
+    if (t) bench_fill_random(t->data, t->size);
+    return t;
+}
+
+// ============================================================================
+// Matrix Multiply
+// ============================================================================
+
+typedef struct {
+    Tensor* a;
+    Tensor* b;
+    Tensor* c;
+} MatmulCase;
+
+static void run_matmul(void* context) {
+    MatmulCase* c = (MatmulCase*)context;
+    matrix_multiply_into(c->c, c->a, c->b);
+}
+
+static void bench_matmul(Suite* suite) {
+    static const int shapes[][3] = { { 64, 64, 64 }, { 256, 256, 256 }, { 512, 512, 512 },
+                                     { 1024, 1024, 1024 }, { 32, 1024, 1024 }, { 1024, 64, 1024 } };
+    suite_group(suite, "matrix_multiply (M x K x N)");
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        int m = shapes[s][0], k = shapes[s][1], n = shapes[s][2];
+        char name[80];
+        snprintf(name, sizeof(name), "matmul/%dx%dx%d", m, k, n);
+        if (!suite_selected(suite, name)) continue;
+
+        MatmulCase c = { suite_tensor(m, k), suite_tensor(k, n), suite_tensor(m, n) };
+        if (c.a && c.b && c.c) suite_time(suite, "matmul", name, run_matmul, &c, 2.0 * m * k * n * 1e-9, "GFLOP/s");
+        tensor_destroy(c.a);
+        tensor_destroy(c.b);
+        tensor_destroy(c.c);
+    }
+}
+
+// ============================================================================
+// Activations
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    ActivationFunction forward;
+    ActivationDerivative derivative;    // NULL = none declared
+} SuiteActivation;
+
+static const SuiteActivation suite_activations[] = {
+    { "sigmoid", activation_sigmoid, activation_sigmoid_derivative },
+    { "tanh", activation_tanh, activation_tanh_derivative },
+    { "relu", activation_relu, activation_relu_derivative },
+    { "leaky_relu", activation_leaky_relu, activation_leaky_relu_derivative },
+    { "elu", activation_elu, activation_elu_derivative },
+    { "swish", activation_swish, activation_swish_derivative },
+    { "softmax", activation_softmax, activation_softmax_derivative },
+    { "linear", activation_linear, activation_linear_derivative },
+    { "gelu", activation_gelu, NULL },
+    { "selu", activation_selu, NULL },
+    { "mish", activation_mish, NULL }
+};
+
+/**
+ * @brief In-place activation restored from a source each call (the copy is subtracted)
+ */
+typedef struct {
+    void (*fn)(float*, int);    // NULL = copy only
+    const float* source;
+    float* data;
+    int size;
+    int row;                    // Call length (softmax normalizes one row at a time)
+} ActivationCase;
+
+static void run_activation(void* context) {
+    ActivationCase* c = (ActivationCase*)context;
+    memcpy(c->data, c->source, c->size * sizeof(float));
+    if (!c->fn) return;
+    for (int offset = 0; offset < c->size; offset += c->row) c->fn(c->data + offset, c->row);
+}
+
+static void bench_activations(Suite* suite) {
+    float* source = (float*)malloc(SUITE_ELEMENTS * sizeof(float));
+    float* outputs = (float*)malloc(SUITE_ELEMENTS * sizeof(float));
+    float* data = (float*)malloc(SUITE_ELEMENTS * sizeof(float));
+    if (!source || !outputs || !data) {
+        free(source);
+        free(outputs);
+        free(data);
+        return;
+    }
+    for (int i = 0; i < SUITE_ELEMENTS; i++) source[i] = 4.0f * ((float)rand() / RAND_MAX * 2.0f - 1.0f);
+
+    suite_group(suite, "Activations (262144 elements, forward and derivative in place)");
+    ActivationCase copy = { NULL, source, data, SUITE_ELEMENTS, SUITE_ELEMENTS };
+    double copy_seconds = 1e30;
+    for (int round = 0; round < SUITE_ROUNDS; round++) {
+        double start = bench_now();
+        for (int r = 0; r < 100; r++) run_activation(&copy);
+        double t = (bench_now() - start) / 100;
+        if (t < copy_seconds) copy_seconds = t;
+    }
+    suite->overhead = copy_seconds;
+
+    for (size_t a = 0; a < sizeof(suite_activations) / sizeof(suite_activations[0]); a++) {
+        const SuiteActivation* act = &suite_activations[a];
+        int row = act->forward == activation_softmax ? SUITE_SOFTMAX_ROW : SUITE_ELEMENTS;
+        char name[80];
+
+        snprintf(name, sizeof(name), "activation/%s", act->name);
+        if (suite_selected(suite, name)) {
+            ActivationCase c = { act->forward, source, data, SUITE_ELEMENTS, row };
+            suite_time(suite, "activation", name, run_activation, &c, SUITE_ELEMENTS * 1e-6, "Melem/s");
+        }
+
+        // Derivatives take the forward output, as in backward
+        snprintf(name, sizeof(name), "activation/%s_derivative", act->name);
+        if (act->derivative && suite_selected(suite, name)) {
+            memcpy(outputs, source, SUITE_ELEMENTS * sizeof(float));
+            for (int offset = 0; offset < SUITE_ELEMENTS; offset += row) act->forward(outputs + offset, row);
+            ActivationCase c = { act->derivative, outputs, data, SUITE_ELEMENTS, row };
+            suite_time(suite, "activation", name, run_activation, &c, SUITE_ELEMENTS * 1e-6, "Melem/s");
+        }
+    }
+    suite->overhead = 0.0;
+
+    free(source);
+    free(outputs);
+    free(data);
+}
+
+// ============================================================================
+// Losses
+// ============================================================================
+
+typedef struct {
+    Loss* loss;
+    Tensor* predictions;
+    Tensor* targets;
+    Tensor* gradient;
+} LossCase;
+
+static void run_loss(void* context) {
+    LossCase* c = (LossCase*)context;
+    loss_compute_with_gradient(c->loss, c->predictions, c->targets, c->gradient);
+}
+
+static void bench_losses(Suite* suite) {
+    static const LossType types[] = { LOSS_MSE, LOSS_CROSS_ENTROPY, LOSS_BINARY_CROSS_ENTROPY,
+                                      LOSS_CATEGORICAL_CROSS_ENTROPY, LOSS_HUBER, LOSS_SOFTMAX_CROSSENTROPY };
+    static const char* keys[] = { "mse", "cross_entropy", "binary_cross_entropy", "categorical_cross_entropy",
+                                  "huber", "softmax_cross_entropy" };
+    const int rows = SUITE_LOSS_ROWS, classes = SUITE_LOSS_CLASSES;
+
+    // Probabilities for the losses on activated outputs, one-hot and sparse targets
+    Tensor* logits = suite_tensor(rows, classes);
+    Tensor* probabilities = tensor_create(NULL, (int[]){ rows, classes }, 2);
+    Tensor* one_hot = tensor_create(NULL, (int[]){ rows, classes }, 2);
+    Tensor* labels = tensor_create(NULL, (int[]){ rows }, 1);
+    Tensor* gradient = tensor_create(NULL, (int[]){ rows, classes }, 2);
+    if (!logits || !probabilities || !one_hot || !labels || !gradient) goto cleanup;
+
+    memcpy(probabilities->data, logits->data, logits->size * sizeof(float));
+    for (int r = 0; r < rows; r++) {
+        int label = rand() % classes;
+        activation_softmax(probabilities->data + (size_t)r * classes, classes);
+        one_hot->data[(size_t)r * classes + label] = 1.0f;
+        labels->data[r] = (float)label;
+    }
+
+    suite_group(suite, "Losses (256 x 1000, loss and gradient)");
+    for (size_t l = 0; l < sizeof(types) / sizeof(types[0]); l++) {
+        char name[80];
+        snprintf(name, sizeof(name), "loss/%s", keys[l]);
+        if (!suite_selected(suite, name)) continue;
+
+        LossCase c = { loss_create(types[l]), probabilities, one_hot, gradient };
+        if (types[l] == LOSS_MSE || types[l] == LOSS_HUBER) c.predictions = logits;
+        if (types[l] == LOSS_SOFTMAX_CROSSENTROPY) {
+            c.predictions = logits;
+            c.targets = labels;
+        }
+        // Types loss_create leaves without a compute function are listed, not timed
+        if (c.loss && (c.loss->compute || c.loss->compute_with_gradient)) {
+            suite_time(suite, "loss", name, run_loss, &c, (double)rows * classes * 1e-6, "Melem/s");
+        } else {
+            printf("  %-44s | not implemented\n", name);
+        }
+        loss_destroy(c.loss);
+    }
+
+cleanup:
+    tensor_destroy(logits);
+    tensor_destroy(probabilities);
+    tensor_destroy(one_hot);
+    tensor_destroy(labels);
+    tensor_destroy(gradient);
+}
+
+// ============================================================================
+// Optimizer Updates
+// ============================================================================
+
+static Layer* param_layer_create(int inputs, int outputs) {
+    Layer* layer = (Layer*)calloc(1, sizeof(Layer));
+    DenseData* data = (DenseData*)calloc(1, sizeof(DenseData));
+    if (!layer || !data) {
+        free(layer);
+        free(data);
+        return NULL;
+    }
+
+    data->params.input_size = inputs;
+    data->params.output_size = outputs;
+    data->weights = suite_tensor(outputs, inputs);
+    data->biases = tensor_create(NULL, (int[]){ outputs }, 1);
+    data->weight_gradients = tensor_create(NULL, (int[]){ outputs, inputs }, 2);
+    data->bias_gradients = tensor_create(NULL, (int[]){ outputs }, 1);
+
+    float gain = sqrtf(3.0f / inputs);
+    for (int i = 0; data->weights && i < data->weights->size; i++) data->weights->data[i] *= gain;
+
+    layer->type = LAYER_DENSE;
+    layer->trainable = true;
+    layer->layer_data = data;
+    layer->num_weights = layer->num_biases = 1;
+    layer->weights = &data->weights;
+    layer->biases = &data->biases;
+    layer->weight_gradients = &data->weight_gradients;
+    layer->bias_gradients = &data->bias_gradients;
+    return layer;
+}
+
+static void param_layer_destroy(Layer* layer) {
+    if (!layer) return;
+    DenseData* data = (DenseData*)layer->layer_data;
+    tensor_destroy(data->weights);
+    tensor_destroy(data->biases);
+    tensor_destroy(data->weight_gradients);
+    tensor_destroy(data->bias_gradients);
+    free(data);
+    free(layer);
+}
+
+typedef struct {
+    Optimizer* optimizer;
+    Layer** layers;
+    int num_layers;
+} OptimizerCase;
+
+static void run_optimizer(void* context) {
+    OptimizerCase* c = (OptimizerCase*)context;
+    optimizer_step(c->optimizer, c->layers, c->num_layers);
+}
+
+static void bench_optimizers(Suite* suite) {
+    static const OptimizerType types[] = { OPTIMIZER_SGD, OPTIMIZER_SGD_MOMENTUM, OPTIMIZER_ADAGRAD,
+                                           OPTIMIZER_RMSPROP, OPTIMIZER_ADAM, OPTIMIZER_ADAMAX, OPTIMIZER_NADAM };
+    static const char* keys[] = { "sgd", "sgd_momentum", "adagrad", "rmsprop", "adam", "adamax", "nadam" };
+    static const int sizes[] = { 784, 1024, 512, 256, 10 };
+    enum { LAYERS = 4 };
+
+    Layer* layers[LAYERS];
+    long long params = 0;
+    for (int l = 0; l < LAYERS; l++) {
+        layers[l] = param_layer_create(sizes[l], sizes[l + 1]);
+        if (!layers[l]) {
+            for (int k = 0; k < l; k++) param_layer_destroy(layers[k]);
+            return;
+        }
+        Tensor* wg = layers[l]->weight_gradients[0];
+        Tensor* bg = layers[l]->bias_gradients[0];
+        for (int i = 0; i < wg->size; i++) wg->data[i] = 1e-3f * ((i % 13) - 6);
+        for (int i = 0; i < bg->size; i++) bg->data[i] = 1e-3f * ((i % 7) - 3);
+        params += wg->size + bg->size;
+    }
+
+    snprintf(suite->title, sizeof(suite->title), "Optimizer updates (MLP 784-1024-512-256-10, %lld parameters)",
+             params);
+    for (size_t o = 0; o < sizeof(types) / sizeof(types[0]); o++) {
+        char name[80];
+        snprintf(name, sizeof(name), "optimizer/%s", keys[o]);
+        if (!suite_selected(suite, name)) continue;
+
+        OptimizerCase c = { optimizer_create(types[o], 1e-4f), layers, LAYERS };
+        if (!c.optimizer) continue;
+        suite_time(suite, "optimizer", name, run_optimizer, &c, params * 1e-6, "Mparam/s");
+        optimizer_destroy(c.optimizer);
+    }
+
+    for (int l = 0; l < LAYERS; l++) param_layer_destroy(layers[l]);
+}
+
+// ============================================================================
+// Dense Layers
+// ============================================================================
+
+typedef struct {
+    Tensor* input;
+    Tensor* weights;
+    Tensor* biases;
+    Tensor* output;
+    Tensor* grad_output;
+    Tensor* weight_gradients;
+    Tensor* bias_gradients;
+    Tensor* grad_input;
+} DenseCase;
+
+static void run_dense_forward(void* context) {
+    DenseCase* c = (DenseCase*)context;
+    dense_forward_fused(c->input, c->weights, c->biases, activation_relu, c->output);
+}
+
+static void run_dense_train(void* context) {
+    DenseCase* c = (DenseCase*)context;
+    dense_forward_fused(c->input, c->weights, c->biases, activation_relu, c->output);
+    dense_backward_fused(c->input, c->weights, c->output, activation_relu, c->grad_output,
+                         c->weight_gradients, c->bias_gradients, c->grad_input, false);
+}
+
+static void bench_dense(Suite* suite) {
+    static const int shapes[][3] = { { 32, 256, 256 }, { 128, 784, 512 }, { 256, 1024, 1024 } };
+    suite_group(suite, "Dense + ReLU (batch x inputs x outputs)");
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        int batch = shapes[s][0], inputs = shapes[s][1], outputs = shapes[s][2];
+        char forward[80], train[80];
+        snprintf(forward, sizeof(forward), "dense/forward/%dx%dx%d", batch, inputs, outputs);
+        snprintf(train, sizeof(train), "dense/forward_backward/%dx%dx%d", batch, inputs, outputs);
+        if (!suite_selected(suite, forward) && !suite_selected(suite, train)) continue;
+
+        DenseCase c = { suite_tensor(batch, inputs), suite_tensor(outputs, inputs), suite_tensor(1, outputs),
+                        suite_tensor(batch, outputs), suite_tensor(batch, outputs), suite_tensor(outputs, inputs),
+                        suite_tensor(1, outputs), suite_tensor(batch, inputs) };
+        double flops = 2.0 * batch * inputs * outputs * 1e-9;
+        if (c.input && c.weights && c.biases && c.output && c.grad_output && c.weight_gradients &&
+            c.bias_gradients && c.grad_input) {
+            if (suite_selected(suite, forward)) {
+                suite_time(suite, "dense", forward, run_dense_forward, &c, flops, "GFLOP/s");
+            }
+            if (suite_selected(suite, train)) {
+                suite_time(suite, "dense", train, run_dense_train, &c, 3.0 * flops, "GFLOP/s");
+            }
+        }
+
+        Tensor* tensors[] = { c.input, c.weights, c.biases, c.output, c.grad_output, c.weight_gradients,
+                              c.bias_gradients, c.grad_input };
+        for (size_t t = 0; t < sizeof(tensors) / sizeof(tensors[0]); t++) tensor_destroy(tensors[t]);
+    }
+}
+
+// ============================================================================
+// Convolution
+// ============================================================================
+
+typedef struct {
+    ConvShape shape;
+    Tensor* input;
+    Tensor* kernels;
+    Tensor* biases;
+    Tensor* output;
+    Tensor* grad_output;
+    Tensor* kernel_gradients;
+    Tensor* bias_gradients;
+    Tensor* grad_input;
+    float* workspace;
+} ConvCase;
+
+static void run_conv_forward(void* context) {
+    ConvCase* c = (ConvCase*)context;
+    conv2d_forward(&c->shape, CONV_ALGO_AUTO, c->input, c->kernels, c->biases, activation_relu, c->output,
+                   NULL, c->workspace);
+}
+
+static void run_conv_train(void* context) {
+    ConvCase* c = (ConvCase*)context;
+    conv2d_forward(&c->shape, CONV_ALGO_AUTO, c->input, c->kernels, c->biases, activation_relu, c->output,
+                   NULL, c->workspace);
+    conv2d_backward(&c->shape, c->input, c->kernels, c->output, NULL, activation_relu, c->grad_output,
+                    c->kernel_gradients, c->bias_gradients, c->grad_input, false, c->workspace);
+}
+
+static void bench_conv(Suite* suite) {
+    // batch, in channels, size, out channels, kernel, stride
+    static const int shapes[][6] = { { 8, 3, 64, 32, 5, 2 }, { 8, 16, 32, 32, 3, 1 },
+                                     { 8, 64, 16, 64, 3, 1 }, { 8, 128, 8, 128, 3, 1 } };
+    suite_group(suite, "Conv2D + ReLU, NCHW (batch x channels x size^2 -> out channels, kernel / stride)");
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        ConvShape shape = { shapes[s][0], shapes[s][1], shapes[s][2], shapes[s][2], shapes[s][3], shapes[s][4],
+                            shapes[s][5], shapes[s][4] / 2, 0, 0, CONV_LAYOUT_NCHW };
+        char forward[80], train[80], size[48];
+        snprintf(size, sizeof(size), "%dx%dx%dx%d-%dk%ds%d", shape.batch, shape.in_channels, shape.in_height,
+                 shape.in_width, shape.out_channels, shape.kernel_size, shape.stride);
+        snprintf(forward, sizeof(forward), "conv/forward/%s", size);
+        snprintf(train, sizeof(train), "conv/forward_backward/%s", size);
+        if (!suite_selected(suite, forward) && !suite_selected(suite, train)) continue;
+
+        int out_h, out_w;
+        if (!conv_output_dims(&shape, &out_h, &out_w)) continue;
+        int in_shape[4] = { shape.batch, shape.in_channels, shape.in_height, shape.in_width };
+        int k_shape[4] = { shape.out_channels, shape.in_channels, shape.kernel_size, shape.kernel_size };
+        int out_shape[4] = { shape.batch, shape.out_channels, out_h, out_w };
+        size_t workspace = conv_workspace_size(&shape, CONV_ALGO_AUTO);
+
+        ConvCase c;
+        c.shape = shape;
+        c.input = tensor_create(NULL, in_shape, 4);
+        c.kernels = tensor_create(NULL, k_shape, 4);
+        c.biases = tensor_create(NULL, (int[]){ shape.out_channels }, 1);
+        c.output = tensor_create(NULL, out_shape, 4);
+        c.grad_output = tensor_create(NULL, out_shape, 4);
+        c.kernel_gradients = tensor_create(NULL, k_shape, 4);
+        c.bias_gradients = tensor_create(NULL, (int[]){ shape.out_channels }, 1);
+        c.grad_input = tensor_create(NULL, in_shape, 4);
+        c.workspace = (float*)malloc((workspace > 0 ? workspace : 1) * sizeof(float));
+
+        double flops = 2.0 * shape.batch * shape.out_channels * out_h * out_w * shape.in_channels *
+                       shape.kernel_size * shape.kernel_size * 1e-9;
+        if (c.input && c.kernels && c.biases && c.output && c.grad_output && c.kernel_gradients &&
+            c.bias_gradients && c.grad_input && c.workspace) {
+            bench_fill_random(c.input->data, c.input->size);
+            bench_fill_random(c.kernels->data, c.kernels->size);
+            bench_fill_random(c.grad_output->data, c.grad_output->size);
+            if (suite_selected(suite, forward)) {
+                suite_time(suite, "conv", forward, run_conv_forward, &c, flops, "GFLOP/s");
+            }
+            if (suite_selected(suite, train)) {
+                suite_time(suite, "conv", train, run_conv_train, &c, 3.0 * flops, "GFLOP/s");
+            }
+        }
+
+        Tensor* tensors[] = { c.input, c.kernels, c.biases, c.output, c.grad_output, c.kernel_gradients,
+                              c.bias_gradients, c.grad_input };
+        for (size_t t = 0; t < sizeof(tensors) / sizeof(tensors[0]); t++) tensor_destroy(tensors[t]);
+        free(c.workspace);
+    }
+}
+
+// ============================================================================
+// LSTM
+// ============================================================================
+
+typedef struct {
+    RnnShape shape;
+    Tensor* input;
+    Tensor* input_weights;
+    Tensor* hidden_weights;
+    Tensor* biases;
+    Tensor* output;
+    Tensor* grad_output;
+    Tensor* input_weight_gradients;
+    Tensor* hidden_weight_gradients;
+    Tensor* bias_gradients;
+    Tensor* grad_input;
+    float* workspace;
+} LstmCase;
+
+static void run_lstm_forward(void* context) {
+    LstmCase* c = (LstmCase*)context;
+    rnn_forward(&c->shape, c->input, c->input_weights, c->hidden_weights, c->biases, NULL, NULL, true,
+                c->output, c->workspace);
+}
+
+static void run_lstm_train(void* context) {
+    LstmCase* c = (LstmCase*)context;
+    run_lstm_forward(c);
+    rnn_backward(&c->shape, c->input, c->input_weights, c->hidden_weights, c->grad_output, true,
+                 c->input_weight_gradients, c->hidden_weight_gradients, c->bias_gradients, c->grad_input,
+                 false, c->workspace);
+}
+
+static void bench_lstm(Suite* suite) {
+    // batch, steps, inputs, hidden
+    static const int shapes[][4] = { { 16, 32, 64, 128 }, { 32, 64, 128, 256 }, { 64, 32, 256, 512 } };
+    suite_group(suite, "LSTM, all timesteps returned (batch x steps x inputs -> hidden)");
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        RnnShape shape = { RNN_CELL_LSTM, shapes[s][0], shapes[s][1], shapes[s][2], shapes[s][3], 0 };
+        int gates = rnn_gate_count(RNN_CELL_LSTM) * shape.hidden_size;
+        int rows = shape.batch * shape.steps;
+        char forward[80], train[80];
+        snprintf(forward, sizeof(forward), "lstm/forward/%dx%dx%d-%d", shape.batch, shape.steps,
+                 shape.input_size, shape.hidden_size);
+        snprintf(train, sizeof(train), "lstm/forward_backward/%dx%dx%d-%d", shape.batch, shape.steps,
+                 shape.input_size, shape.hidden_size);
+        if (!suite_selected(suite, forward) && !suite_selected(suite, train)) continue;
+
+        LstmCase c = { shape, suite_tensor(rows, shape.input_size), suite_tensor(gates, shape.input_size),
+                       suite_tensor(gates, shape.hidden_size), suite_tensor(1, gates),
+                       suite_tensor(rows, shape.hidden_size), suite_tensor(rows, shape.hidden_size),
+                       suite_tensor(gates, shape.input_size), suite_tensor(gates, shape.hidden_size),
+                       suite_tensor(1, gates), suite_tensor(rows, shape.input_size),
+                       (float*)malloc(rnn_workspace_size(&shape) * sizeof(float)) };
+
+        double flops = 2.0 * rows * gates * (double)(shape.input_size + shape.hidden_size) * 1e-9;
+        if (c.input && c.input_weights && c.hidden_weights && c.biases && c.output && c.grad_output &&
+            c.input_weight_gradients && c.hidden_weight_gradients && c.bias_gradients && c.grad_input &&
+            c.workspace) {
+            float wx = 1.0f / sqrtf((float)shape.input_size), wh = 1.0f / sqrtf((float)shape.hidden_size);
+            for (int i = 0; i < c.input_weights->size; i++) c.input_weights->data[i] *= wx;
+            for (int i = 0; i < c.hidden_weights->size; i++) c.hidden_weights->data[i] *= wh;
+            if (suite_selected(suite, forward)) {
+                suite_time(suite, "lstm", forward, run_lstm_forward, &c, flops, "GFLOP/s");
+            }
+            if (suite_selected(suite, train)) {
+                suite_time(suite, "lstm", train, run_lstm_train, &c, 3.0 * flops, "GFLOP/s");
+            }
+        }
+
+        Tensor* tensors[] = { c.input, c.input_weights, c.hidden_weights, c.biases, c.output, c.grad_output,
+                              c.input_weight_gradients, c.hidden_weight_gradients, c.bias_gradients,
+                              c.grad_input };
+        for (size_t t = 0; t < sizeof(tensors) / sizeof(tensors[0]); t++) tensor_destroy(tensors[t]);
+        free(c.workspace);
+    }
+}
+
+// ============================================================================
+// End-to-End Epoch
+// ============================================================================
+
+typedef struct {
+    Layer* layers[3];
+    Optimizer* optimizer;
+    TensorArena* arena;
+    Tensor* x;                  // SUITE_EPOCH_SAMPLES x 784
+    int* labels;                // Class per sample
+} EpochCase;
+
+static Tensor* epoch_layer_forward(Layer* layer, Tensor* x, DenseActivationFn activation) {
+    DenseData* data = (DenseData*)layer->layer_data;
+    Tensor* y = tensor_create(NULL, (int[]){ x->shape[0], data->params.output_size }, 2);
+    if (!y || !dense_forward_fused(x, data->weights, data->biases, activation, y)) return NULL;
+    layer->input_cache = x;
+    layer->output_cache = y;
+    return y;
+}
+
+static Tensor* epoch_layer_backward(Layer* layer, Tensor* grad, DenseActivationFn activation) {
+    DenseData* data = (DenseData*)layer->layer_data;
+    Tensor* x = layer->input_cache;
+    Tensor* dx = tensor_create(NULL, x->shape, x->ndim);
+    if (!dx || !dense_backward_fused(x, data->weights, layer->output_cache, activation, grad,
+                                     data->weight_gradients, data->bias_gradients, dx, false)) {
+        return NULL;
+    }
+    return dx;
+}
+
+/**
+ * @brief One pass over the training set: forward, softmax cross-entropy, backward, update
+ */
+static void run_epoch(void* context) {
+    EpochCase* c = (EpochCase*)context;
+    int features = c->x->shape[1];
+
+    for (int offset = 0; offset < SUITE_EPOCH_SAMPLES; offset += SUITE_EPOCH_BATCH) {
+        TensorArena* previous = tensor_arena_activate(c->arena);
+        Tensor* xb = tensor_create_view(c->x->data + (size_t)offset * features,
+                                        (int[]){ SUITE_EPOCH_BATCH, features }, 2);
+        Tensor* h = xb;
+        for (int l = 0; h && l < 3; l++) {
+            h = epoch_layer_forward(c->layers[l], h, l < 2 ? activation_relu : activation_linear);
+        }
+        Tensor* grad = h ? tensor_create(NULL, h->shape, h->ndim) : NULL;
+        if (grad) {
+            loss_softmax_crossentropy_sparse(h->data, c->labels + offset, SUITE_EPOCH_BATCH, SUITE_EPOCH_CLASSES,
+                                             grad->data);
+            for (int l = 2; grad && l >= 0; l--) {
+                grad = epoch_layer_backward(c->layers[l], grad, l < 2 ? activation_relu : activation_linear);
+            }
+        }
+        tensor_arena_activate(previous);
+        tensor_arena_reset(c->arena);
+        optimizer_step(c->optimizer, c->layers, 3);
+    }
+}
+
+static void bench_epoch(Suite* suite) {
+    static const int sizes[] = { 784, 256, 128, SUITE_EPOCH_CLASSES };
+    const char* name = "epoch/mlp-784-256-128-10";
+    if (!suite_selected(suite, name)) return;
+
+    EpochCase c;
+    memset(&c, 0, sizeof(c));
+    bool ok = true;
+    for (int l = 0; l < 3; l++) {
+        c.layers[l] = param_layer_create(sizes[l], sizes[l + 1]);
+        ok = ok && c.layers[l];
+    }
+    c.optimizer = optimizer_create(OPTIMIZER_ADAM, 1e-3f);
+    c.arena = tensor_arena_create(0);
+    c.x = suite_tensor(SUITE_EPOCH_SAMPLES, sizes[0]);
+    c.labels = (int*)malloc(SUITE_EPOCH_SAMPLES * sizeof(int));
+    ok = ok && c.optimizer && c.arena && c.x && c.labels;
+
+    snprintf(suite->title, sizeof(suite->title), "End-to-end epoch (MLP 784-256-128-10, %d samples, batch %d, Adam)",
+             SUITE_EPOCH_SAMPLES, SUITE_EPOCH_BATCH);
+    if (ok) {
+        for (int i = 0; i < SUITE_EPOCH_SAMPLES; i++) c.labels[i] = rand() % SUITE_EPOCH_CLASSES;
+        suite_time(suite, "epoch", name, run_epoch, &c, SUITE_EPOCH_SAMPLES, "samples/s");
+    }
+
+    for (int l = 0; l < 3; l++) param_layer_destroy(c.layers[l]);
+    optimizer_destroy(c.optimizer);
+    tensor_arena_destroy(c.arena);
+    tensor_destroy(c.x);
+    free(c.labels);
+}
+
+// ============================================================================
+// JSON Output
+// ============================================================================
+
+static void json_string(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* p = text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fprintf(file, "\\%c", *p);
+        } else if ((unsigned char)*p < 0x20) {
+            fprintf(file, "\\u%04x", (unsigned char)*p);
+        } else {
+            fputc(*p, file);
+        }
+    }
+    fputc('"', file);
+}
+
+/**
+ * @brief CPU model name (Linux), "unknown" elsewhere
+ */
+static void cpu_model(char* out, size_t size) {
+    snprintf(out, size, "unknown");
+#ifdef __linux__
+    FILE* file = fopen("/proc/cpuinfo", "r");
+    if (!file) return;
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        char* colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) == 0 && colon) {
+            colon += 2;
+            colon[strcspn(colon, "\n")] = '\0';
+            snprintf(out, size, "%s", colon);
+            break;
+        }
+    }
+    fclose(file);
+#endif
+}
+
+static void write_machine(FILE* file, const Suite* suite) {
+    char cpu[256], stamp[32] = "unknown";
+    cpu_model(cpu, sizeof(cpu));
+    time_t now = time(NULL);
+    struct tm* utc = gmtime(&now);
+    if (utc) strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", utc);
+
+    fprintf(file, "  \"machine\": {\n    \"cpu\": ");
+    json_string(file, cpu);
+    fprintf(file, ",\n    \"hardware_threads\": %d,\n    \"threads\": %d,\n", thread_pool_hardware_threads(),
+            suite->threads);
+#if defined(__unix__) || defined(__APPLE__)
+    struct utsname system;
+    if (uname(&system) == 0) {
+        fprintf(file, "    \"os\": ");
+        json_string(file, system.sysname);
+        fprintf(file, ",\n    \"os_release\": ");
+        json_string(file, system.release);
+        fprintf(file, ",\n    \"arch\": ");
+        json_string(file, system.machine);
+        fprintf(file, ",\n");
+    }
+#endif
+#ifdef __VERSION__
+    fprintf(file, "    \"compiler\": ");
+    json_string(file, __VERSION__);
+    fprintf(file, ",\n");
+#endif
+#ifdef __OPTIMIZE__
+    fprintf(file, "    \"optimized\": true,\n");
+#else
+    fprintf(file, "    \"optimized\": false,\n");
+#endif
+    fprintf(file, "    \"gemm_kernel\": ");
+    json_string(file, gemm_kernel_name(gemm_get_kernel()));
+    fprintf(file, ",\n    \"vec_math_kernel\": ");
+    json_string(file, vec_math_kernel_name(vec_math_get_kernel()));
+    fprintf(file, ",\n    \"timestamp\": ");
+    json_string(file, stamp);
+    fprintf(file, "\n  },\n");
+}
+
+static bool write_json(const Suite* suite, const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\n  \"schema\": %d,\n", SUITE_SCHEMA_VERSION);
+    write_machine(file, suite);
+    fprintf(file, "  \"results\": [\n");
+    for (int r = 0; r < suite->num_results; r++) {
+        const SuiteResult* result = &suite->results[r];
+        fprintf(file, "    { \"name\": ");
+        json_string(file, result->name);
+        fprintf(file, ", \"group\": ");
+        json_string(file, result->group);
+        fprintf(file, ", \"seconds\": %.9g, \"throughput\": %.6g, \"unit\": ", result->seconds,
+                result->work / result->seconds);
+        json_string(file, result->unit);
+        fprintf(file, ", \"repetitions\": %d }%s\n", result->repetitions, r + 1 < suite->num_results ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+// ============================================================================
+// Baseline Comparison
+// ============================================================================
+
+static char* read_file(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return NULL;
+
+    char* text = NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long length = ftell(file);
+        if (length >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+            text = (char*)malloc((size_t)length + 1);
+            if (text && fread(text, 1, (size_t)length, file) != (size_t)length) {
+                free(text);
+                text = NULL;
+            }
+            if (text) text[length] = '\0';
+        }
+    }
+    fclose(file);
+    return text;
+}
+
+/**
+ * @brief Seconds of a named case in a file written by write_json
+ * @return Seconds, or a negative value if the case is missing
+ */
+static double baseline_seconds(const char* json, const char* name) {
+    char key[112];
+    snprintf(key, sizeof(key), "\"name\": \"%s\",", name);
+    const char* entry = strstr(json, key);
+    if (!entry) return -1.0;
+
+    const char* end = strchr(entry, '}');
+    const char* seconds = strstr(entry, "\"seconds\":");
+    if (!seconds || (end && seconds > end)) return -1.0;
+    return strtod(seconds + strlen("\"seconds\":"), NULL);
+}
+
+/**
+ * @brief Print current vs baseline per case
+ * @return Number of cases slower than the baseline by more than threshold
+ */
+static int compare_baseline(const Suite* suite, const char* filename, double threshold) {
+    char* json = read_file(filename);
+    if (!json) {
+        printf("\n❌ Cannot read baseline %s\n", filename);
+        return -1;
+    }
+
+    printf("\nComparison with %s (regression: more than %.0f%% slower)\n", filename, 100.0 * threshold);
+    printf("  %-44s | %11s | %11s | %8s\n", "Case", "Baseline ms", "Current ms", "Change");
+    int regressions = 0, improvements = 0, missing = 0;
+    for (int r = 0; r < suite->num_results; r++) {
+        const SuiteResult* result = &suite->results[r];
+        double before = baseline_seconds(json, result->name);
+        if (before <= 0.0) {
+            missing++;
+            printf("  %-44s | %11s | %11.4f | %8s\n", result->name, "-", result->seconds * 1e3, "new");
+            continue;
+        }
+
+        double change = result->seconds / before - 1.0;
+        bool regressed = change > threshold;
+        regressions += regressed;
+        improvements += change < -threshold;
+        printf("  %-44s | %11.4f | %11.4f | %+7.1f%% %s\n", result->name, before * 1e3, result->seconds * 1e3,
+               100.0 * change, regressed ? "❌" : (change < -threshold ? "⬆️" : "✅"));
+    }
+    printf("  %d regressions, %d improvements, %d cases without a baseline\n", regressions, improvements,
+           missing);
+
+    free(json);
+    return regressions;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char* program) {
+    printf("Usage: %s [--json out.json] [--baseline previous.json] [--threshold 0.10]\n"
+           "       [--filter substring] [--threads n] [--quick]\n", program);
+}
+
+int main(int argc, char** argv) {
+    static Suite suite;
+    const char* json = "benchmark_results.json";
+    const char* baseline = NULL;
+    double threshold = SUITE_THRESHOLD;
+    suite.seconds = SUITE_SECONDS;
+    suite.threads = 1;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--json") == 0 && has_value) {
+            json = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+            baseline = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && has_value) {
+            suite.filter = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            suite.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            suite.seconds = SUITE_SECONDS / 5;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (suite.threads < 1) suite.threads = thread_pool_hardware_threads();
+
+    // Single-threaded by default so runs on different machines compare kernels, not core counts
+    ThreadPool* pool = suite.threads > 1 ? thread_pool_create(suite.threads) : NULL;
+    gemm_set_thread_pool(pool);
+    srand(42);
+
+    char cpu[256];
+    cpu_model(cpu, sizeof(cpu));
+    printf("Neural Network Benchmark Suite\n");
+    printf("==============================\n");
+    printf("CPU: %s (%d hardware threads), %d GEMM thread%s, GEMM kernel %s, math kernel %s\n", cpu,
+           thread_pool_hardware_threads(), suite.threads, suite.threads == 1 ? "" : "s",
+           gemm_kernel_name(gemm_get_kernel()), vec_math_kernel_name(vec_math_get_kernel()));
+
+    bench_matmul(&suite);
+    bench_activations(&suite);
+    bench_losses(&suite);
+    bench_optimizers(&suite);
+    bench_dense(&suite);
+    bench_conv(&suite);
+    bench_lstm(&suite);
+    bench_epoch(&suite);
+
+    gemm_set_thread_pool(NULL);
+    thread_pool_destroy(pool);
+
+    // Compare before writing, so the baseline may be the output file of the previous run
+    int regressions = baseline ? compare_baseline(&suite, baseline, threshold) : 0;
+    bool written = write_json(&suite, json);
+    printf("\n%s %d results written to %s\n", written ? "✅" : "❌", suite.num_results, json);
+    if (!written || regressions != 0) return 1;
+    return 0;
+}
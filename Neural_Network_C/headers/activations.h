@@ -14,6 +14,10 @@
 
 /**
  * @brief Activation function pointer type
+ *
+ * The transcendental activations (sigmoid, tanh, swish, softmax) have the
+ * same signature as the vec_math array functions (vec_math.h) and are
+ * evaluated by them, so they share its error bounds and SIMD dispatch.
  */
 typedef void (*ActivationFunction)(float*, int);
 
@@ -0,0 +1,163 @@
+/*
+ * Neural Network System - BF16 Kernels Header
+ * bfloat16 conversion and a bf16 x bf16 -> fp32 GEMM with AVX512-BF16,
+ * emulated AVX-512 and scalar kernels behind runtime CPU dispatch
+ */
+
+#ifndef NEURAL_NETWORK_BF16_KERNELS_H
+#define NEURAL_NETWORK_BF16_KERNELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "gemm.h"
+
+// ============================================================================
+// BF16 Configuration
+// ============================================================================
+
+#define BF16_PANEL_COLS 32          // Columns per packed B panel (two 16-lane vectors)
+#define BF16_PANEL_ROWS 6           // Rows per packed A panel (micro-kernel height)
+#define BF16_BLOCK_PAIRS 256        // Reduction pairs per cache block
+#define BF16_ALIGNMENT 64           // Packed buffer alignment in bytes
+
+typedef uint16_t bf16;              // Upper half of an IEEE float
+
+/**
+ * @brief BF16 micro-kernel implementations
+ */
+typedef enum {
+    BF16_KERNEL_SCALAR,             // Portable C kernel
+    BF16_KERNEL_AVX512,             // AVX-512F, pairs widened to fp32 and FMA'd
+    BF16_KERNEL_AVX512_BF16         // AVX512-BF16 pair dot products (vdpbf16ps)
+} Bf16KernelType;
+
+/**
+ * @brief Round a float to bf16 (nearest even; NaN stays NaN)
+ */
+static inline bf16 bf16_from_float(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffffu) > 0x7f800000u) return (bf16)((bits >> 16) | 0x0040u);
+    bits += 0x7fffu + ((bits >> 16) & 1u);
+    return (bf16)(bits >> 16);
+}
+
+/**
+ * @brief Widen a bf16 to float (exact)
+ */
+static inline float bf16_to_float(bf16 value) {
+    uint32_t bits = (uint32_t)value << 16;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/**
+ * @brief B operand packed once for repeated products (e.g. weights)
+ *
+ * Columns are grouped into panels of BF16_PANEL_COLS. Within a panel each
+ * reduction pair (k, k + 1) of a column is one 32-bit word, low half k,
+ * which is the operand layout of vdpbf16ps. Odd k and partial panels are
+ * zero padded.
+ */
+typedef struct {
+    int k;                          // Reduction length
+    int n;                          // Columns
+    int k_pairs;                    // (k + 1) / 2
+    int panels;                     // Column panels
+    uint32_t* data;                 // panels x k_pairs x BF16_PANEL_COLS words
+    void* raw;                      // Allocation backing data
+} Bf16PackedMatrix;
+
+/**
+ * @brief Row-major matrix operand in bf16, or fp32 rounded while packing
+ */
+typedef struct {
+    const bf16* data;               // bf16 storage (NULL = use data_f32)
+    const float* data_f32;          // fp32 storage
+    int ld;                         // Row stride in elements
+    GemmTranspose trans;            // Use the transpose of the stored matrix
+} Bf16Operand;
+
+// ============================================================================
+// Conversion
+// ============================================================================
+
+/**
+ * @brief Round an array to bf16
+ */
+void bf16_from_float_array(const float* src, bf16* dst, size_t count);
+
+/**
+ * @brief Widen an array to float
+ */
+void bf16_to_float_array(const bf16* src, float* dst, size_t count);
+
+// ============================================================================
+// GEMM
+// ============================================================================
+
+/**
+ * @brief Pack (and round) a k x n B operand
+ * @param packed Output (free with bf16_packed_free)
+ * @param b Source operand (op(B) is k x n)
+ * @param k Reduction length
+ * @param n Columns
+ * @return False on allocation failure
+ */
+bool bf16_pack_b(Bf16PackedMatrix* packed, const Bf16Operand* b, int k, int n);
+
+/**
+ * @brief Repack into an existing buffer of the same shape (no allocation)
+ */
+void bf16_repack_b(Bf16PackedMatrix* packed, const Bf16Operand* b);
+
+/**
+ * @brief Release a packed operand
+ */
+void bf16_packed_free(Bf16PackedMatrix* packed);
+
+/**
+ * @brief C = act(op(A) * B + beta * C + bias) with bf16 operands, fp32 accumulation
+ * @param m Rows of op(A) and C
+ * @param a A operand (op(A) is m x k)
+ * @param b Packed B (k x n)
+ * @param beta Scale of existing C (0 = C is not read)
+ * @param c Row-major fp32 output (m x n)
+ * @param ldc Row stride of C
+ * @param epilogue Bias/activation applied once per output tile (NULL = none)
+ * @return False on allocation failure
+ */
+bool bf16_gemm_packed(int m, const Bf16Operand* a, const Bf16PackedMatrix* b,
+                      float beta, float* c, int ldc, const GemmEpilogue* epilogue);
+
+/**
+ * @brief bf16 GEMM with both operands packed on the fly
+ * @return False on allocation failure
+ */
+bool bf16_gemm(int m, int n, int k, const Bf16Operand* a, const Bf16Operand* b,
+               float beta, float* c, int ldc, const GemmEpilogue* epilogue);
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+/**
+ * @brief Kernel used by bf16_gemm (best supported by the CPU by default)
+ */
+Bf16KernelType bf16_get_kernel(void);
+
+/**
+ * @brief Force a kernel (for testing and benchmarking)
+ * @return False if the CPU does not support it
+ */
+bool bf16_set_kernel(Bf16KernelType type);
+
+/**
+ * @brief Human-readable kernel name
+ */
+const char* bf16_kernel_name(Bf16KernelType type);
+
+#endif // NEURAL_NETWORK_BF16_KERNELS_H
@@ -0,0 +1,124 @@
+/*
+ * Neural Network System - Gradient Checkpointing Header
+ * Keeps only segment-boundary activations during forward and recomputes
+ * each segment during backward, trading one extra forward for memory
+ */
+
+#ifndef NEURAL_NETWORK_CHECKPOINTING_H
+#define NEURAL_NETWORK_CHECKPOINTING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "neural_net.h"
+#include "tensor_arena.h"
+
+// ============================================================================
+// Checkpoint State
+// ============================================================================
+
+/**
+ * @brief Checkpointing state attached to a network (net->checkpoint)
+ *
+ * Layers are split into segments of `interval` layers. Every segment but
+ * the last runs forward inside `arena`, which is reset once the segment's
+ * output has been copied out, so only segment inputs survive the forward
+ * pass. Backward walks the last segment as usual, then re-runs each earlier
+ * segment from its saved input in the arena and backpropagates through it.
+ *
+ * Layers own their output_cache and reference their input through
+ * input_cache; both are cleared when a segment's arena is reset. Dropout
+ * draws from rand(), so each segment reseeds it with a recorded seed and
+ * recomputation reproduces the forward masks. Batch normalization running
+ * statistics see recomputed segments twice.
+ */
+typedef struct {
+    int interval;               // Layers per segment
+    int num_layers;             // Layers when the state was created
+    Tensor** inputs;            // Saved input of each segment start (NULL elsewhere)
+    bool* owns_input;           // Whether inputs[l] is a copy made by the forward pass
+    unsigned int* seeds;        // rand() seed each segment ran forward with
+    unsigned int resume_seed;   // Seed restored after backward
+    TensorArena* arena;         // Segment activations during forward and recompute
+    int recomputed_layers;      // Layer forwards repeated by the last backward
+} CheckpointState;
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/**
+ * @brief Enable, change or disable checkpointing
+ * @param net Built network
+ * @param interval Layers per segment (0 or >= num_layers disables)
+ * @return False on allocation failure or if mixed precision is on (reported on stderr)
+ */
+bool neural_network_set_checkpointing(NeuralNetwork* net, int interval);
+
+/**
+ * @brief Current segment length
+ * @return Layers per segment, 0 when checkpointing is off
+ */
+int neural_network_get_checkpointing(const NeuralNetwork* net);
+
+/**
+ * @brief Estimated training memory with a given segment length
+ *
+ * Segment-boundary activations, the last segment's activations and saved
+ * state, the largest recomputed segment, two output gradients and the
+ * largest per-call scratch buffer, using the memory planner's layer sizes.
+ *
+ * @param net Built network
+ * @param batch Batch size
+ * @param interval Layers per segment (0 = no checkpointing)
+ * @return Bytes, or 0 if the layer shapes are unknown
+ */
+size_t neural_network_checkpoint_memory(const NeuralNetwork* net, int batch, int interval);
+
+/**
+ * @brief Segment length for a memory budget
+ *
+ * Picks the longest segment (least recomputation) whose estimate fits the
+ * budget; if none fits, the one with the smallest estimate.
+ *
+ * @param net Built network
+ * @param batch Batch size
+ * @param budget_bytes Training memory budget for activations
+ * @return Layers per segment, 0 if the network fits without checkpointing
+ */
+int neural_network_checkpoint_interval_for_budget(const NeuralNetwork* net, int batch,
+                                                  size_t budget_bytes);
+
+// ============================================================================
+// Forward / Backward
+// ============================================================================
+
+/**
+ * @brief Forward pass keeping only segment inputs
+ *
+ * neural_network_forward dispatches here when checkpointing is on. The
+ * input must stay valid until the matching backward call.
+ *
+ * @param net Network with checkpointing enabled
+ * @param input Input batch
+ * @return Output tensor (owned by the last layer) or NULL on failure
+ */
+Tensor* neural_network_checkpoint_forward(NeuralNetwork* net, Tensor* input);
+
+/**
+ * @brief Backward pass recomputing every segment but the last
+ *
+ * neural_network_backward dispatches here with the loss gradient when
+ * checkpointing is on. Weight gradients accumulate as in the plain pass.
+ *
+ * @param net Network after neural_network_checkpoint_forward
+ * @param gradient Loss gradient w.r.t. the network output
+ * @return Success status
+ */
+bool neural_network_checkpoint_backward(NeuralNetwork* net, Tensor* gradient);
+
+/**
+ * @brief Free a network's checkpointing state (called by neural_network_destroy)
+ */
+void neural_network_release_checkpointing(NeuralNetwork* net);
+
+#endif // NEURAL_NETWORK_CHECKPOINTING_H
@@ -0,0 +1,175 @@
+/*
+ * Neural Network System - Convolution Kernels Header
+ * Conv2D forward/backward lowered to the blocked GEMM (im2col) or computed
+ * with Winograd F(2x2,3x3), in NCHW or NHWC layout, with fused max pooling
+ */
+
+#ifndef NEURAL_NETWORK_CONV_KERNELS_H
+#define NEURAL_NETWORK_CONV_KERNELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "neural_net.h"
+#include "layers.h"
+#include "dense_kernels.h"
+
+// ============================================================================
+// Convolution Description
+// ============================================================================
+
+/**
+ * @brief Memory layout of activation tensors
+ *
+ * Kernels are always stored as (output_channels, input_channels, k, k);
+ * only the input/output feature maps change layout.
+ */
+typedef enum {
+    CONV_LAYOUT_NCHW,           // batch, channels, height, width
+    CONV_LAYOUT_NHWC            // batch, height, width, channels
+} ConvLayout;
+
+/**
+ * @brief Forward algorithm
+ */
+typedef enum {
+    CONV_ALGO_AUTO,             // Pick per shape (conv_select_algorithm)
+    CONV_ALGO_IM2COL,           // Patch matrix + GEMM (any kernel, stride, padding)
+    CONV_ALGO_WINOGRAD          // F(2x2,3x3): 3x3 kernels with stride 1 only
+} ConvAlgorithm;
+
+/**
+ * @brief Full description of one convolution call
+ */
+typedef struct {
+    int batch;                  // Images per call
+    int in_channels;            // Input channels
+    int in_height;              // Input feature map height
+    int in_width;               // Input feature map width
+    int out_channels;           // Output channels
+    int kernel_size;            // Square kernel size
+    int stride;                 // Convolution stride
+    int padding;                // Zero padding on each side
+    int pool_size;              // Fused max pooling window (0 = no pooling)
+    int pool_stride;            // Fused max pooling stride
+    ConvLayout layout;          // Layout of input and output tensors
+} ConvShape;
+
+// ============================================================================
+// Shape Helpers
+// ============================================================================
+
+/**
+ * @brief Describe a Conv2D layer applied to a batch
+ * @param shape Output description (pooling disabled)
+ * @param params Layer parameters
+ * @param batch Images per call
+ * @param height Input height
+ * @param width Input width
+ * @param layout Activation layout
+ * @return True if the resulting output is non-empty
+ */
+bool conv_shape_init(ConvShape* shape, const Conv2DParams* params,
+                     int batch, int height, int width, ConvLayout layout);
+
+/**
+ * @brief Output extent of a convolution along one axis
+ * @return (input + 2 * padding - kernel) / stride + 1, or 0 if empty
+ */
+int conv_output_size(int input, int kernel_size, int stride, int padding);
+
+/**
+ * @brief Height and width of the tensor conv2d_forward writes
+ *
+ * With fused pooling these are the pooled dimensions.
+ *
+ * @param shape Convolution description
+ * @param height Output height
+ * @param width Output width
+ * @return False if the shape is invalid
+ */
+bool conv_output_dims(const ConvShape* shape, int* height, int* width);
+
+/**
+ * @brief Whether Winograd F(2x2,3x3) applies to a shape
+ */
+bool conv_winograd_supported(const ConvShape* shape);
+
+/**
+ * @brief Algorithm CONV_ALGO_AUTO resolves to
+ *
+ * Winograd when supported and the channel counts are large enough for its
+ * 2.25x multiply saving to beat the transform cost, im2col otherwise.
+ */
+ConvAlgorithm conv_select_algorithm(const ConvShape* shape);
+
+/**
+ * @brief Scratch floats needed by conv2d_forward and conv2d_backward
+ *
+ * Work is batched over a few images at a time, so the size depends on the
+ * per-image footprint rather than the whole batch (except for the backward
+ * gradient of a pooled convolution, which spans the full batch).
+ *
+ * @param shape Convolution description
+ * @param algorithm Forward algorithm
+ * @return Number of floats, 0 if the shape is invalid or needs no scratch
+ */
+size_t conv_workspace_size(const ConvShape* shape, ConvAlgorithm algorithm);
+
+// ============================================================================
+// Forward and Backward
+// ============================================================================
+
+/**
+ * @brief Convolution forward: output = pool(act(conv(input, kernels) + biases))
+ *
+ * Bias and activation run in the GEMM epilogue (im2col) or the output
+ * transform (Winograd). With pool_size set, each batch of images is pooled
+ * straight out of the scratch buffer, so the full-resolution feature map
+ * never reaches the output tensor.
+ *
+ * @param shape Convolution description
+ * @param algorithm Forward algorithm
+ * @param input Input feature maps in shape->layout
+ * @param kernels Kernels (out_channels x in_channels x k x k)
+ * @param biases Per-channel bias (out_channels, NULL = none)
+ * @param activation Elementwise activation (NULL = linear)
+ * @param output Output feature maps in shape->layout (pooled if pooling)
+ * @param max_indices Argmax per pooled output as a flat index into the
+ *                    unpooled batch output (NULL = not recorded)
+ * @param workspace conv_workspace_size floats (NULL = allocate internally)
+ * @return False on shape mismatch, unsupported algorithm or activation, or out of memory
+ */
+bool conv2d_forward(const ConvShape* shape, ConvAlgorithm algorithm,
+                    const Tensor* input, const Tensor* kernels, const Tensor* biases,
+                    DenseActivationFn activation, Tensor* output,
+                    int* max_indices, float* workspace);
+
+/**
+ * @brief Convolution backward
+ *
+ * The activation derivative comes from the forward output. Without pooling
+ * grad_output is overwritten with the pre-activation delta; with pooling the
+ * pooled gradient is scattered through max_indices into scratch and left
+ * untouched. Weight and input gradients always go through im2col GEMMs.
+ *
+ * @param shape Convolution description
+ * @param input Forward input
+ * @param kernels Kernels (out_channels x in_channels x k x k)
+ * @param output Forward output (pooled if pooling)
+ * @param max_indices Indices recorded by conv2d_forward (required with pooling)
+ * @param activation Activation used in the forward pass
+ * @param grad_output Gradient w.r.t. output
+ * @param kernel_gradients Kernel gradient (same shape as kernels)
+ * @param bias_gradients Bias gradient (out_channels, NULL = skip)
+ * @param grad_input Gradient w.r.t. input (NULL = skip)
+ * @param accumulate Add to existing parameter gradients instead of overwriting
+ * @param workspace conv_workspace_size floats (NULL = allocate internally)
+ * @return False on shape mismatch, unsupported activation or out of memory
+ */
+bool conv2d_backward(const ConvShape* shape, const Tensor* input, const Tensor* kernels,
+                     const Tensor* output, const int* max_indices,
+                     DenseActivationFn activation, Tensor* grad_output,
+                     Tensor* kernel_gradients, Tensor* bias_gradients,
+                     Tensor* grad_input, bool accumulate, float* workspace);
+
+#endif // NEURAL_NETWORK_CONV_KERNELS_H
@@ -0,0 +1,165 @@
+/*
+ * Neural Network System - Streaming Data Loader Header
+ * Fixed-record binary datasets read through mmap or pread, shuffled by an
+ * index permutation each epoch, with batches assembled on a background
+ * thread into double-buffered tensors
+ */
+
+#ifndef NEURAL_NETWORK_DATA_LOADER_H
+#define NEURAL_NETWORK_DATA_LOADER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "neural_net.h"
+
+// ============================================================================
+// Dataset Files
+// ============================================================================
+
+#define DATA_FILE_MAGIC "NNDATA"        // 6 characters plus terminator
+#define DATA_FILE_VERSION 1             // Bumped on any incompatible layout change
+#define DATA_FILE_HEADER_SIZE 64        // Records start at this offset
+
+/**
+ * @brief Dataset file header (64 bytes, at offset 0)
+ *
+ * Followed by num_records records of sample_size input floats immediately
+ * followed by target_size target floats, all in host byte order.
+ */
+typedef struct {
+    char magic[8];                  // DATA_FILE_MAGIC
+    uint32_t version;               // DATA_FILE_VERSION
+    uint32_t header_size;           // DATA_FILE_HEADER_SIZE
+    uint64_t num_records;           // Records in the file
+    uint32_t sample_size;           // Input floats per record
+    uint32_t target_size;           // Target floats per record
+    uint32_t reserved[8];           // Zero
+} DataFileHeader;
+
+/**
+ * @brief Appends records to a dataset file that may be larger than memory
+ */
+typedef struct {
+    FILE* file;                     // Open output file
+    DataFileHeader header;          // Header rewritten by data_file_finish
+} DataFileWriter;
+
+/**
+ * @brief Create a dataset file
+ * @param writer Writer to initialize
+ * @param path Output path
+ * @param sample_size Input floats per record
+ * @param target_size Target floats per record
+ * @return False if the file cannot be created
+ */
+bool data_file_create(DataFileWriter* writer, const char* path, int sample_size, int target_size);
+
+/**
+ * @brief Append count records
+ * @param x count x sample_size inputs
+ * @param y count x target_size targets
+ * @return False on write failure
+ */
+bool data_file_append(DataFileWriter* writer, const float* x, const float* y, int count);
+
+/**
+ * @brief Write the final record count and close the file
+ * @return False on write failure
+ */
+bool data_file_finish(DataFileWriter* writer);
+
+/**
+ * @brief Write an in-memory dataset (samples along the first axis of x and y)
+ * @return False on mismatched tensors or write failure
+ */
+bool data_file_write_tensors(const char* path, const Tensor* x, const Tensor* y);
+
+// ============================================================================
+// Data Loader
+// ============================================================================
+
+/**
+ * @brief How records are read
+ */
+typedef enum {
+    DATA_LOADER_MMAP,               // Read-only mapping; records copied out of the page cache
+    DATA_LOADER_PREAD               // One pread per record; no address space needed for the file
+} DataLoaderIO;
+
+/**
+ * @brief Loader settings
+ */
+typedef struct {
+    int batch_size;                 // Records per batch
+    bool shuffle;                   // New random permutation every epoch
+    bool drop_last;                 // Skip the final partial batch
+    bool prefetch;                  // Assemble the next batch on a background thread
+    DataLoaderIO io;                // Read strategy
+    uint64_t seed;                  // Shuffle seed (epoch e uses seed + e)
+} DataLoaderConfig;
+
+/**
+ * @brief Default settings: batches of 32, shuffled, prefetched, mmap
+ */
+DataLoaderConfig data_loader_config_default(void);
+
+// DataLoader is declared opaque in neural_net.h
+
+/**
+ * @brief Open a dataset file written by data_file_create / data_file_write_tensors
+ * @return Loader or NULL (with a message on stderr) on failure
+ */
+DataLoader* data_loader_open(const char* path, DataLoaderConfig config);
+
+/**
+ * @brief Stop the prefetch thread and close the file
+ */
+void data_loader_close(DataLoader* loader);
+
+/**
+ * @brief Start an epoch: draw the next permutation and start prefetching
+ *
+ * May be called before the previous epoch was fully consumed.
+ */
+bool data_loader_begin_epoch(DataLoader* loader);
+
+/**
+ * @brief Next batch of the current epoch
+ *
+ * The tensors belong to the loader and stay valid until the following call;
+ * with prefetch enabled the other buffer is being filled meanwhile. The
+ * last batch may have fewer rows (shape[0]) unless drop_last is set.
+ *
+ * @param x Output: batch inputs (rows x sample_size)
+ * @param y Output: batch targets (rows x target_size)
+ * @return False at the end of the epoch or on a read error
+ */
+bool data_loader_next(DataLoader* loader, Tensor** x, Tensor** y);
+
+/**
+ * @brief True if a read failed during the current epoch
+ */
+bool data_loader_failed(DataLoader* loader);
+
+/**
+ * @brief Records in the file
+ */
+int data_loader_num_samples(const DataLoader* loader);
+
+/**
+ * @brief Batches per epoch
+ */
+int data_loader_num_batches(const DataLoader* loader);
+
+/**
+ * @brief Input floats per record
+ */
+int data_loader_sample_size(const DataLoader* loader);
+
+/**
+ * @brief Target floats per record
+ */
+int data_loader_target_size(const DataLoader* loader);
+
+#endif // NEURAL_NETWORK_DATA_LOADER_H
@@ -0,0 +1,81 @@
+/*
+ * Neural Network System - Fused Dense Kernels Header
+ * Single-pass dense forward (GEMM + bias + activation) and the matching
+ * backward pass (activation derivative + bias gradient, then two GEMMs)
+ */
+
+#ifndef NEURAL_NETWORK_DENSE_KERNELS_H
+#define NEURAL_NETWORK_DENSE_KERNELS_H
+
+#include <stdbool.h>
+#include "neural_net.h"
+#include "gemm.h"
+
+/**
+ * @brief Activation function pointer as stored in DenseParams
+ */
+typedef void (*DenseActivationFn)(float*, int);
+
+/**
+ * @brief Map a dense activation to the GEMM epilogue that computes it
+ * @param activation Activation function (NULL = linear)
+ * @param kind Output epilogue activation
+ * @return False if the activation cannot be fused (e.g. softmax, swish)
+ */
+bool dense_activation_kind(DenseActivationFn activation, GemmActivation* kind);
+
+/**
+ * @brief delta = grad * act'(y) in place, computed from the activation output
+ * @param kind Activation applied in the forward pass
+ * @param y Forward output (rows x cols)
+ * @param grad Output gradient (rows x cols), overwritten with the delta
+ * @param bias_grad Column sums of the delta are added here (cols, NULL = skip)
+ * @param rows Number of rows
+ * @param cols Number of columns
+ */
+void dense_activation_delta(GemmActivation kind, const float* y, float* grad,
+                            float* bias_grad, int rows, int cols);
+
+/**
+ * @brief Fused dense forward: output = act(input * weights^T + biases)
+ *
+ * Elementwise activations run in the GEMM epilogue, so each output tile is
+ * written once while hot. Row-wise activations such as softmax are applied
+ * per sample after the bias-fused GEMM.
+ *
+ * @param input Input batch (batch x input_size)
+ * @param weights Weight matrix (output_size x input_size)
+ * @param biases Bias vector (output_size, NULL = none)
+ * @param activation Activation function (NULL = linear)
+ * @param output Preallocated output (batch x output_size)
+ * @return True on success
+ */
+bool dense_forward_fused(const Tensor* input, const Tensor* weights, const Tensor* biases,
+                         DenseActivationFn activation, Tensor* output);
+
+/**
+ * @brief Fused dense backward
+ *
+ * One pass over the output gradient turns it into the pre-activation delta
+ * (using the cached forward output) and accumulates the bias gradient; the
+ * weight and input gradients then come straight from GEMM with no
+ * transposed copies. Softmax is treated as identity, as its derivative is
+ * folded into the cross-entropy loss gradient.
+ *
+ * @param input Forward input (batch x input_size)
+ * @param weights Weight matrix (output_size x input_size)
+ * @param output Forward output (batch x output_size)
+ * @param activation Activation used in the forward pass
+ * @param grad_output Gradient w.r.t. output; overwritten with the delta
+ * @param weight_gradients Weight gradient (output_size x input_size)
+ * @param bias_gradients Bias gradient (output_size, NULL = skip)
+ * @param grad_input Gradient w.r.t. input (batch x input_size, NULL = skip)
+ * @param accumulate Add to existing parameter gradients instead of overwriting
+ * @return False if the activation derivative cannot be computed from the output, or out of memory
+ */
+bool dense_backward_fused(const Tensor* input, const Tensor* weights, const Tensor* output,
+                          DenseActivationFn activation, Tensor* grad_output,
+                          Tensor* weight_gradients, Tensor* bias_gradients,
+                          Tensor* grad_input, bool accumulate);
+
+#endif // NEURAL_NETWORK_DENSE_KERNELS_H
@@ -0,0 +1,202 @@
+/*
+ * Neural Network System - GEMM Kernel Header
+ * Cache-blocked, register-tiled single precision matrix multiply with
+ * runtime CPU dispatch between AVX-512, AVX2 and portable scalar kernels
+ */
+
+#ifndef NEURAL_NETWORK_GEMM_H
+#define NEURAL_NETWORK_GEMM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "thread_pool.h"
+
+// ============================================================================
+// GEMM Configuration
+// ============================================================================
+
+#define GEMM_BLOCK_K 256            // Depth of packed panels (fits L1/L2)
+#define GEMM_BLOCK_M_PANELS 16      // Micro-panels of A per cache block (L2)
+#define GEMM_BLOCK_N 2048           // Width of packed B block (L3)
+#define GEMM_SMALL_THRESHOLD 32768  // m*n*k below which packing is skipped
+#define GEMM_PARALLEL_THRESHOLD (1 << 21) // m*n*k above which the pool is used
+#define GEMM_ALIGNMENT 64           // Pack buffer alignment in bytes
+
+/**
+ * @brief Operand transposition flags
+ */
+typedef enum {
+    GEMM_NO_TRANS,              // Use operand as stored
+    GEMM_TRANS                  // Use transpose of stored operand
+} GemmTranspose;
+
+/**
+ * @brief Micro-kernel implementations
+ */
+typedef enum {
+    GEMM_KERNEL_SCALAR,         // Portable C kernel (4x8 tile)
+    GEMM_KERNEL_AVX2,           // AVX2 + FMA kernel (6x16 tile)
+    GEMM_KERNEL_AVX512          // AVX-512F kernel (6x32 tile)
+} GemmKernelType;
+
+/**
+ * @brief Elementwise activations that can be fused into the GEMM epilogue
+ */
+typedef enum {
+    GEMM_ACTIVATION_NONE,       // Identity
+    GEMM_ACTIVATION_RELU,       // max(0, x)
+    GEMM_ACTIVATION_LEAKY_RELU, // x if x > 0, 0.01x otherwise
+    GEMM_ACTIVATION_SIGMOID,    // 1 / (1 + e^(-x))
+    GEMM_ACTIVATION_TANH        // tanh(x)
+} GemmActivation;
+
+#define GEMM_LEAKY_RELU_SLOPE 0.01f // Matches activation_leaky_relu
+
+/**
+ * @brief Work applied to each C tile while it is still in registers/L1
+ *
+ * C = act(alpha * op(A) * op(B) + beta * C + bias + row_bias), with bias
+ * broadcast along rows (one value per column of C) and row_bias broadcast
+ * along columns (one value per row, e.g. a channel bias in NCHW convolution).
+ */
+typedef struct {
+    const float* bias;          // Per-column bias (n values, NULL = none)
+    GemmActivation activation;  // Activation applied after the bias
+    const float* row_bias;      // Per-row bias (m values, NULL = none)
+} GemmEpilogue;
+
+/**
+ * @brief Aligned scratch buffer, grown on demand and reused
+ *
+ * The GEMM pack buffers and the bf16, sparse and int8 kernels' tiles are
+ * thread-local GemmScratch variables (zero-initialised) reserved with
+ * gemm_scratch_reserve. A reserved buffer is registered with the calling
+ * thread and freed when that thread exits or calls
+ * gemm_release_thread_buffers, so it must be thread-local.
+ */
+typedef struct GemmScratch {
+    void* raw;                  // Allocation (NULL until first reserved)
+    void* data;                 // raw rounded up to GEMM_ALIGNMENT
+    size_t capacity;            // Usable bytes at data
+    struct GemmScratch* next;   // Next buffer registered with the same thread
+    bool listed;                // Registered with its thread
+} GemmScratch;
+
+// ============================================================================
+// GEMM Functions
+// ============================================================================
+
+/**
+ * @brief Single precision GEMM: C = alpha * op(A) * op(B) + beta * C
+ * @param trans_a Whether A is used transposed
+ * @param trans_b Whether B is used transposed
+ * @param m Rows of op(A) and C
+ * @param n Columns of op(B) and C
+ * @param k Columns of op(A) / rows of op(B)
+ * @param alpha Scale applied to the product
+ * @param a Row-major storage of A (m x k, or k x m when transposed)
+ * @param lda Row stride of A
+ * @param b Row-major storage of B (k x n, or n x k when transposed)
+ * @param ldb Row stride of B
+ * @param beta Scale applied to existing C (0 means C is not read)
+ * @param c Row-major output matrix (m x n)
+ * @param ldc Row stride of C
+ * @return False if a pack buffer could not be allocated (C is then incomplete)
+ */
+bool gemm_sgemm(GemmTranspose trans_a, GemmTranspose trans_b,
+                int m, int n, int k, float alpha,
+                const float* a, int lda, const float* b, int ldb,
+                float beta, float* c, int ldc);
+
+/**
+ * @brief GEMM with a fused bias/activation epilogue
+ *
+ * Same contract as gemm_sgemm; the epilogue runs on each output tile right
+ * after its final accumulation, so C is written exactly once.
+ *
+ * @param epilogue Bias and activation to fuse (NULL behaves like gemm_sgemm)
+ * @return False if a pack buffer could not be allocated (C is then incomplete)
+ */
+bool gemm_sgemm_epilogue(GemmTranspose trans_a, GemmTranspose trans_b,
+                         int m, int n, int k, float alpha,
+                         const float* a, int lda, const float* b, int ldb,
+                         float beta, float* c, int ldc, const GemmEpilogue* epilogue);
+
+/**
+ * @brief Apply an epilogue to a rows x cols block of C
+ * @param epilogue Epilogue to apply
+ * @param c Block start
+ * @param ldc Row stride of C
+ * @param rows Rows in the block
+ * @param cols Columns in the block
+ * @param row0 Row of C where the block starts (indexes the row bias)
+ * @param col0 Column of C where the block starts (indexes the bias)
+ */
+void gemm_apply_epilogue(const GemmEpilogue* epilogue, float* c, int ldc,
+                         int rows, int cols, int row0, int col0);
+
+/**
+ * @brief Attach a thread pool used to split large products across cores
+ * @param pool Thread pool (NULL for single-threaded GEMM)
+ * @return Previously attached pool, so the caller can restore it
+ */
+ThreadPool* gemm_set_thread_pool(ThreadPool* pool);
+
+/**
+ * @brief Give the calling thread its own pool, overriding gemm_set_thread_pool
+ *
+ * Lets independent trainings run side by side, each splitting its
+ * products over its own cores (see hyperparam_search.h).
+ *
+ * @param pool Thread pool (NULL = back to the shared pool)
+ */
+void gemm_bind_thread_pool(ThreadPool* pool);
+
+/**
+ * @brief Free every scratch buffer the calling thread reserved
+ *
+ * Covers the GEMM pack buffers and the bf16, sparse and int8 kernel
+ * tiles. Buffers are kept per thread and reused; exiting threads free
+ * theirs automatically, so this is for threads that stay alive but are
+ * done with the kernels.
+ */
+void gemm_release_thread_buffers(void);
+
+/**
+ * @brief Make a scratch buffer hold at least bytes
+ *
+ * Growing discards the old contents; on failure the buffer is left empty.
+ *
+ * @param scratch Scratch buffer
+ * @param bytes Bytes needed
+ * @return GEMM_ALIGNMENT-aligned storage, or NULL on allocation failure
+ */
+void* gemm_scratch_reserve(GemmScratch* scratch, size_t bytes);
+
+/**
+ * @brief Get the thread pool GEMMs of the calling thread use
+ * @return Bound pool, else the attached one, or NULL
+ */
+ThreadPool* gemm_get_thread_pool(void);
+
+/**
+ * @brief Get the micro-kernel selected for this CPU
+ * @return Active kernel type
+ */
+GemmKernelType gemm_get_kernel(void);
+
+/**
+ * @brief Force a specific micro-kernel (benchmarking and testing)
+ * @param type Kernel to use
+ * @return False if the CPU does not support the requested kernel
+ */
+bool gemm_set_kernel(GemmKernelType type);
+
+/**
+ * @brief Get printable kernel name
+ * @param type Kernel type
+ * @return Kernel name string
+ */
+const char* gemm_kernel_name(GemmKernelType type);
+
+#endif // NEURAL_NETWORK_GEMM_H
@@ -0,0 +1,233 @@
+/*
+ * Neural Network System - Hyperparameter Search Header
+ * Grid and random search over training and optimizer settings, run as
+ * concurrent trainings pinned to core subsets over one shared dataset,
+ * with successive-halving early termination and a results table
+ */
+
+#ifndef NEURAL_NETWORK_HYPERPARAM_SEARCH_H
+#define NEURAL_NETWORK_HYPERPARAM_SEARCH_H
+
+#include <stdbool.h>
+#include "neural_net.h"
+
+// ============================================================================
+// Search Configuration
+// ============================================================================
+
+#define HYPERPARAM_MAX_PARAMS 16        // Parameters in a search space
+#define HYPERPARAM_MAX_CHOICES 16       // Values of a choice parameter
+#define HYPERPARAM_NAME_LENGTH 32       // Parameter name capacity
+
+/**
+ * @brief How a parameter's values are drawn
+ */
+typedef enum {
+    HYPERPARAM_CHOICE,              // One of a list of values
+    HYPERPARAM_UNIFORM,             // Uniform in [low, high]
+    HYPERPARAM_LOG_UNIFORM,         // Uniform in log space (learning rates, weight decay)
+    HYPERPARAM_INT_UNIFORM          // Integer uniform in [low, high] (layer widths, batch sizes)
+} HyperparamKind;
+
+/**
+ * @brief One searched parameter
+ *
+ * The driver applies these names itself: "optimizer" (an OptimizerType),
+ * "learning_rate", "batch_size" and every name optimizer_set_param
+ * accepts ("momentum", "beta1", "beta2", "epsilon", "weight_decay"). Any
+ * other name is only passed to the network builder, which reads it with
+ * hyperparam_trial_value (e.g. "hidden_units").
+ */
+typedef struct {
+    char name[HYPERPARAM_NAME_LENGTH];      // Parameter name
+    HyperparamKind kind;                    // Value distribution
+    float choices[HYPERPARAM_MAX_CHOICES];  // Values of a choice parameter
+    int num_choices;                        // Number of choices
+    float low;                              // Range minimum
+    float high;                             // Range maximum
+    int grid_points;                        // Grid values of a range (evenly spaced, in log space if log-uniform)
+} Hyperparam;
+
+/**
+ * @brief Parameters searched jointly
+ */
+typedef struct {
+    Hyperparam params[HYPERPARAM_MAX_PARAMS];   // Parameters
+    int num_params;                             // Number of parameters
+} HyperparamSpace;
+
+/**
+ * @brief How trials are generated
+ */
+typedef enum {
+    HYPERPARAM_GRID,                // Cartesian product of every parameter's values
+    HYPERPARAM_RANDOM               // Independent draws from each parameter's distribution
+} HyperparamStrategy;
+
+/**
+ * @brief Search settings
+ *
+ * With successive halving (reduction_factor > 1) every trial first
+ * trains for min_epochs; only the best 1 / reduction_factor by
+ * validation loss continue to reduction_factor times as many epochs, and
+ * so on up to training.epochs. Within a rung, a trial also ends early
+ * when neural_network_check_early_stopping says so (training.patience
+ * and min_delta on the validation loss).
+ */
+typedef struct {
+    HyperparamStrategy strategy;    // Grid or random
+    int num_trials;                 // Random draws (grid: cap on the product, 0 = all)
+    unsigned int seed;              // Seed for draws, weight-independent shuffles
+    int num_workers;                // Concurrent trainings (0 = cores / cores_per_worker)
+    int cores_per_worker;           // Cores pinned to each training (its GEMMs use them all)
+    int min_epochs;                 // Epochs of the first halving rung
+    int reduction_factor;           // Halving rate eta (<= 1 = train every trial to the end)
+    TrainingConfig training;        // Epochs (maximum per trial), batch size, validation split, shuffle, patience
+    OptimizerType optimizer;        // Optimizer when the space has no "optimizer"
+    float learning_rate;            // Learning rate when the space has no "learning_rate"
+    LossType loss;                  // Loss of every trial
+} HyperparamSearchConfig;
+
+/**
+ * @brief Outcome of one parameter combination
+ */
+typedef struct {
+    int id;                                 // Trial index (generation order)
+    float values[HYPERPARAM_MAX_PARAMS];    // Value of each space parameter
+    int rung;                               // Last halving rung the trial trained in
+    int epochs;                             // Epochs trained
+    float train_loss;                       // Mean training loss of the last epoch
+    float val_loss;                         // Validation loss after the last epoch
+    float val_accuracy;                     // Validation accuracy after the last epoch
+    bool early_stopped;                     // Ended by neural_network_check_early_stopping
+    bool eliminated;                        // Dropped by successive halving
+    bool failed;                            // Build, compile or training failed
+    int worker;                             // Worker that trained it last
+    double seconds;                         // Wall time spent training and validating
+} HyperparamTrial;
+
+/**
+ * @brief Build the (uncompiled) network of a trial
+ *
+ * Called from worker threads, possibly concurrently; must not share
+ * mutable state between calls. The driver compiles the network with the
+ * trial's optimizer and destroys it.
+ *
+ * @param trial Trial being built (read parameters with hyperparam_trial_value)
+ * @param space Search space
+ * @param user_data Caller context
+ * @return Network or NULL on failure
+ */
+typedef NeuralNetwork* (*HyperparamBuildFn)(const HyperparamTrial* trial, const HyperparamSpace* space,
+                                            void* user_data);
+
+/**
+ * @brief Search state and results
+ */
+typedef struct {
+    HyperparamSpace space;          // Parameters
+    HyperparamSearchConfig config;  // Settings
+    HyperparamBuildFn build;        // Network builder
+    void* user_data;                // Builder context
+
+    HyperparamTrial* trials;        // Generated trials
+    int num_trials;                 // Number of trials
+    int num_rungs;                  // Halving rungs run
+    int total_epochs;               // Epochs trained over all trials
+    double seconds;                 // Wall time of the search
+} HyperparamSearch;
+
+// ============================================================================
+// Search Space
+// ============================================================================
+
+/**
+ * @brief Add a parameter that takes one of a list of values
+ * @return False if the space is full, the name exists or count is out of range
+ */
+bool hyperparam_space_add_choice(HyperparamSpace* space, const char* name, const float* values, int count);
+
+/**
+ * @brief Add a range parameter
+ * @param space Search space
+ * @param name Parameter name
+ * @param kind HYPERPARAM_UNIFORM, HYPERPARAM_LOG_UNIFORM or HYPERPARAM_INT_UNIFORM
+ * @param low Range minimum (> 0 for log-uniform)
+ * @param high Range maximum
+ * @param grid_points Values used by grid search (at least 1)
+ * @return False on an invalid range, a full space or an existing name
+ */
+bool hyperparam_space_add_range(HyperparamSpace* space, const char* name, HyperparamKind kind,
+                                float low, float high, int grid_points);
+
+/**
+ * @brief Value of a named parameter in a trial
+ * @return The trial's value, or fallback if the space has no such parameter
+ */
+float hyperparam_trial_value(const HyperparamTrial* trial, const HyperparamSpace* space, const char* name,
+                             float fallback);
+
+// ============================================================================
+// Search Functions
+// ============================================================================
+
+/**
+ * @brief Default settings: random search of 16 trials, halving by 3 from 1 to 9 epochs,
+ *        one core per worker, Adam
+ */
+HyperparamSearchConfig hyperparam_search_config_default(void);
+
+/**
+ * @brief Generate the trials of a search
+ * @param space Parameters (copied)
+ * @param config Settings
+ * @param build Network builder
+ * @param user_data Builder context
+ * @return Search or NULL on failure or an empty space
+ */
+HyperparamSearch* hyperparam_search_create(const HyperparamSpace* space, HyperparamSearchConfig config,
+                                           HyperparamBuildFn build, void* user_data);
+
+/**
+ * @brief Destroy a search
+ */
+void hyperparam_search_destroy(HyperparamSearch* search);
+
+/**
+ * @brief Train every trial on one shared dataset
+ *
+ * x and y are read by all workers and never copied: the validation split
+ * (the last training.validation_split of the rows) is a view, and each
+ * batch is a view or, with training.shuffle, gathered into a per-worker
+ * buffer. Worker w is pinned to cores [w * cores_per_worker, ...) and
+ * binds its GEMMs to its own pool of cores_per_worker threads.
+ *
+ * @param search Search from hyperparam_search_create
+ * @param x Inputs (samples along the first axis)
+ * @param y Targets (samples along the first axis)
+ * @return False if the data is invalid or every trial failed
+ */
+bool hyperparam_search_run(HyperparamSearch* search, Tensor* x, Tensor* y);
+
+/**
+ * @brief Trial with the lowest validation loss among those that reached the last rung
+ * @return Best trial or NULL if none succeeded
+ */
+const HyperparamTrial* hyperparam_search_best(const HyperparamSearch* search);
+
+/**
+ * @brief Write the results table as CSV, best trial first
+ *
+ * Columns: rank, trial, one per parameter, rung, epochs, train_loss,
+ * val_loss, val_accuracy, status, seconds.
+ *
+ * @return False if the file cannot be written
+ */
+bool hyperparam_search_write_results(const HyperparamSearch* search, const char* filename);
+
+/**
+ * @brief Ranked results table as text
+ */
+void hyperparam_search_summary(const HyperparamSearch* search, char* out, int max_length);
+
+#endif // NEURAL_NETWORK_HYPERPARAM_SEARCH_H
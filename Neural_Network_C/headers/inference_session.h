@@ -0,0 +1,68 @@
+/*
+ * Neural Network System - Inference Session Header
+ * Low-latency serving of a trained network to many request threads:
+ * per-worker replicas and scratch arenas planned up front, with concurrent
+ * single-sample requests coalesced into batches
+ */
+
+#ifndef NEURAL_NETWORK_INFERENCE_SESSION_H
+#define NEURAL_NETWORK_INFERENCE_SESSION_H
+
+#include <stdbool.h>
+#include "neural_net.h"
+#include "micro_batcher.h"
+
+#define INFERENCE_MAX_SAMPLE_DIMS 7     // Sample rank (the batch axis is added in front)
+
+typedef struct InferenceSession InferenceSession;
+
+/**
+ * @brief Create a session serving a network
+ *
+ * Each worker gets a replica whose parameters alias the network's (see
+ * neural_network_replicate) and a tensor arena. A planning forward pass at
+ * max_batch sizes every arena, so serving a batch does not allocate. The
+ * network itself is only read; it must outlive the session and must not be
+ * trained while the session exists.
+ *
+ * @param net Trained network
+ * @param sample_shape Shape of one sample without the batch axis (NULL = flat input_size)
+ * @param sample_ndim Rank of sample_shape (at most INFERENCE_MAX_SAMPLE_DIMS)
+ * @param config Batching policy (max_batch, max_delay_us, num_workers)
+ * @return Session or NULL if the planning pass fails
+ */
+InferenceSession* inference_session_create(NeuralNetwork* net, const int* sample_shape,
+                                           int sample_ndim, MicroBatchConfig config);
+
+/**
+ * @brief Finish outstanding requests and free the session (not the network)
+ */
+void inference_session_destroy(InferenceSession* session);
+
+/**
+ * @brief Predict one sample (thread-safe, blocking)
+ *
+ * The sample joins the next batch; the call returns once that batch has run.
+ *
+ * @param input One sample (inference_session_input_size floats)
+ * @param output Prediction (inference_session_output_size floats)
+ * @return Success status
+ */
+bool inference_session_predict(InferenceSession* session, const float* input, float* output);
+
+/**
+ * @brief Floats per sample input
+ */
+int inference_session_input_size(const InferenceSession* session);
+
+/**
+ * @brief Floats per sample prediction
+ */
+int inference_session_output_size(const InferenceSession* session);
+
+/**
+ * @brief Request and batch counters
+ */
+void inference_session_get_stats(InferenceSession* session, MicroBatchStats* stats);
+
+#endif // NEURAL_NETWORK_INFERENCE_SESSION_H
@@ -185,21 +185,27 @@ typedef struct {
     int input_size;             // Input feature size
     int hidden_size;            // Hidden state size
     bool return_sequences;      // Whether to return all sequences
+    int bptt_steps;             // Truncated BPTT window (0 = full sequence)
 } LSTMParams;
 
 /**
  * @brief LSTM layer data
+ *
+ * Gate blocks i, f, g, o are stacked along the weight rows so the whole
+ * sequence runs through rnn_forward / rnn_backward (see rnn_kernels.h).
  */
 typedef struct {
     LSTMParams params;          // Layer parameters
-    Tensor* input_weights;      // Input-to-hidden weights
-    Tensor* hidden_weights;     // Hidden-to-hidden weights
-    Tensor* biases;             // Bias terms
+    Tensor* input_weights;      // Input-to-hidden weights (4H x input_size)
+    Tensor* hidden_weights;     // Hidden-to-hidden weights (4H x H)
+    Tensor* biases;             // Bias terms (4H)
     Tensor* cell_state;         // Cell state
     Tensor* hidden_state;       // Hidden state
     Tensor* input_gradients;    // Input weight gradients
     Tensor* hidden_gradients;   // Hidden weight gradients
     Tensor* bias_gradients;     // Bias gradients
+    float* workspace;           // Per-timestep gates and states kept for backward
+    size_t workspace_size;      // Floats allocated (grown to the longest batch * steps seen)
 } LSTMData;
 
 /**
@@ -218,8 +224,28 @@ typedef struct {
     int input_size;             // Input feature size
     int hidden_size;            // Hidden state size
     bool return_sequences;      // Whether to return all sequences
+    int bptt_steps;             // Truncated BPTT window (0 = full sequence)
 } GRUParams;
 
+/**
+ * @brief GRU layer data
+ *
+ * Gate blocks z, r, n are stacked along the weight rows (see rnn_kernels.h
+ * for where the reset gate applies).
+ */
+typedef struct {
+    GRUParams params;           // Layer parameters
+    Tensor* input_weights;      // Input-to-hidden weights (3H x input_size)
+    Tensor* hidden_weights;     // Hidden-to-hidden weights (3H x H)
+    Tensor* biases;             // Bias terms (3H)
+    Tensor* hidden_state;       // Hidden state
+    Tensor* input_gradients;    // Input weight gradients
+    Tensor* hidden_gradients;   // Hidden weight gradients
+    Tensor* bias_gradients;     // Bias gradients
+    float* workspace;           // Per-timestep gates and states kept for backward
+    size_t workspace_size;      // Floats allocated
+} GRUData;
+
 /**
  * @brief Create a GRU layer
  * @param input_size Input feature size
@@ -229,6 +255,13 @@ typedef struct {
  */
 Layer* layer_gru_create(int input_size, int hidden_size, bool return_sequences);
 
+/**
+ * @brief Limit backpropagation through time of an LSTM or GRU layer
+ * @param layer Recurrent layer
+ * @param bptt_steps Timesteps per truncation window (0 = full sequence)
+ */
+void layer_recurrent_set_bptt(Layer* layer, int bptt_steps);
+
 // ============================================================================
 // Layer Management Functions
 // ============================================================================
@@ -397,6 +430,22 @@ Tensor* layer_lstm_forward(Layer* layer, Tensor* input);
  */
 Tensor* layer_lstm_backward(Layer* layer, Tensor* gradient_output);
 
+/**
+ * @brief GRU layer forward pass
+ * @param layer GRU layer
+ * @param input Input tensor
+ * @return Output tensor or NULL on failure
+ */
+Tensor* layer_gru_forward(Layer* layer, Tensor* input);
+
+/**
+ * @brief GRU layer backward pass
+ * @param layer GRU layer
+ * @param gradient_output Output gradient
+ * @return Input gradient or NULL on failure
+ */
+Tensor* layer_gru_backward(Layer* layer, Tensor* gradient_output);
+
 // ============================================================================
 // Layer Utility Functions
 // ============================================================================
@@ -59,6 +59,20 @@ float loss_compute(Loss* loss, Tensor* predictions, Tensor* targets);
  */
 Tensor* loss_gradient(Loss* loss, Tensor* predictions, Tensor* targets);
 
+/**
+ * @brief Compute loss value and gradient together
+ *
+ * Uses the loss's fused pass when it has one, otherwise compute followed by
+ * gradient.
+ *
+ * @param loss Loss function
+ * @param predictions Network predictions
+ * @param targets Target values
+ * @param gradient Preallocated gradient, same shape as predictions
+ * @return Loss value
+ */
+float loss_compute_with_gradient(Loss* loss, Tensor* predictions, Tensor* targets, Tensor* gradient);
+
 // ============================================================================
 // Mean Squared Error (MSE) Loss
 // ============================================================================
@@ -115,6 +129,55 @@ float loss_categorical_crossentropy_compute(Tensor* predictions, Tensor* targets
  */
 Tensor* loss_categorical_crossentropy_gradient(Tensor* predictions, Tensor* targets);
 
+// ============================================================================
+// Fused Softmax Cross-Entropy
+// ============================================================================
+
+// Takes the raw logits of a linear output layer (no softmax activation).
+// Each row is handled once: max, exp-sum and log-sum-exp give the loss
+// lse - z[label] without ever taking the log of a probability, and the same
+// exponentials become the gradient (softmax - target) / rows. Targets are
+// either dense (rows x classes, one-hot or soft labels) or sparse: one class
+// index per row, so no one-hot tensor is needed for large class counts.
+// Losses are averaged over rows (samples), not over all elements.
+
+/**
+ * @brief Softmax cross-entropy on logits
+ * @param logits Raw scores (rows x classes)
+ * @param targets rows x classes probabilities, or rows class indices (stored as floats)
+ * @return Mean loss per row (0 on invalid input)
+ */
+float loss_softmax_crossentropy_compute(Tensor* logits, Tensor* targets);
+
+/**
+ * @brief Softmax cross-entropy gradient w.r.t. the logits
+ * @param logits Raw scores
+ * @param targets Dense or sparse targets
+ * @return Gradient tensor (logits shape) or NULL on invalid input
+ */
+Tensor* loss_softmax_crossentropy_gradient(Tensor* logits, Tensor* targets);
+
+/**
+ * @brief Loss and gradient in a single pass per row
+ * @param logits Raw scores
+ * @param targets Dense or sparse targets
+ * @param gradient Output gradient (logits shape, NULL = loss only)
+ * @return Mean loss per row (0 on invalid input)
+ */
+float loss_softmax_crossentropy_fused(Tensor* logits, Tensor* targets, Tensor* gradient);
+
+/**
+ * @brief Sparse-label softmax cross-entropy on raw arrays
+ * @param logits rows x classes scores
+ * @param labels Class index per row
+ * @param rows Number of rows
+ * @param classes Number of classes
+ * @param gradient rows x classes output (NULL = loss only)
+ * @return Mean loss per row (0 if a label is out of range)
+ */
+float loss_softmax_crossentropy_sparse(const float* logits, const int* labels, int rows, int classes,
+                                       float* gradient);
+
 // ============================================================================
 // Huber Loss
 // ============================================================================
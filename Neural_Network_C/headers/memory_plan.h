@@ -0,0 +1,234 @@
+/*
+ * Neural Network System - Static Memory Planner Header
+ * Lifetimes of every activation, gradient and scratch buffer of a forward
+ * (and backward) pass, packed into one preallocated slab with reuse of
+ * memory between buffers whose lifetimes do not overlap
+ */
+
+#ifndef NEURAL_NETWORK_MEMORY_PLAN_H
+#define NEURAL_NETWORK_MEMORY_PLAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "neural_net.h"
+
+#define MEMORY_PLAN_ALIGNMENT 64        // Byte alignment of every buffer offset
+
+// ============================================================================
+// Plan Structures
+// ============================================================================
+
+/**
+ * @brief What a planned buffer holds
+ */
+typedef enum {
+    MEMORY_BUFFER_ACTIVATION,   // Layer output
+    MEMORY_BUFFER_GRADIENT,     // Loss gradient w.r.t. a layer output
+    MEMORY_BUFFER_SAVED,        // Forward state kept for backward (masks, indices, recurrent workspace)
+    MEMORY_BUFFER_SCRATCH       // Temporary of a single forward or backward call
+} MemoryBufferKind;
+
+/**
+ * @brief One buffer with its lifetime and assigned slab offset
+ *
+ * Lifetimes are inclusive ranges of schedule steps. A training schedule of
+ * L layers runs forward of layer l at step l, the loss at step L and
+ * backward of layer l at step 2L - l; inference uses steps 0..L-1.
+ */
+typedef struct {
+    MemoryBufferKind kind;      // Buffer role
+    int layer;                  // Owning layer index
+    size_t bytes;               // Requested size
+    int first_step;             // Step that writes it first
+    int last_step;              // Step that reads it last
+    size_t offset;              // Slab offset (valid after memory_plan_solve)
+} MemoryBuffer;
+
+/**
+ * @brief Buffer sizes of one layer, as seen by the planner (floats)
+ */
+typedef struct {
+    size_t output_floats;       // Activation for the whole batch
+    size_t saved_floats;        // Forward state needed by backward
+    size_t forward_scratch;     // Temporary floats of the forward call
+    size_t backward_scratch;    // Temporary floats of the backward call
+} MemoryPlanLayer;
+
+/**
+ * @brief Buffer set and its packing
+ */
+typedef struct {
+    MemoryBuffer* buffers;      // Planned buffers
+    int num_buffers;            // Buffers in use
+    int capacity;               // Buffers allocated
+    int num_steps;              // Schedule length
+    bool training;              // Forward + backward schedule
+    int batch;                  // Batch size the sizes were computed for (0 = unknown)
+
+    size_t peak_bytes;          // Slab size with reuse
+    size_t total_bytes;         // Sum of all buffers (one allocation each)
+    size_t live_bytes_bound;    // Largest sum of simultaneously live buffers (lower bound)
+
+    void* slab;                 // Backing memory (NULL until allocated or shared)
+    void* slab_raw;             // Unaligned allocation behind slab (NULL if shared)
+} MemoryPlan;
+
+// ============================================================================
+// Planning
+// ============================================================================
+
+/**
+ * @brief Create an empty plan
+ * @param num_steps Schedule length
+ * @param training Whether the schedule includes backward
+ * @return Created plan or NULL on failure
+ */
+MemoryPlan* memory_plan_create(int num_steps, bool training);
+
+/**
+ * @brief Destroy a plan and its slab
+ */
+void memory_plan_destroy(MemoryPlan* plan);
+
+/**
+ * @brief Add a buffer
+ * @return Buffer index, -1 on invalid lifetime or allocation failure
+ */
+int memory_plan_add(MemoryPlan* plan, MemoryBufferKind kind, int layer, size_t bytes,
+                    int first_step, int last_step);
+
+/**
+ * @brief Assign offsets
+ *
+ * Greedy by size: buffers are placed largest first, each into the
+ * best-fitting gap left between already placed buffers whose lifetimes
+ * overlap its own. Also computes peak_bytes, total_bytes and
+ * live_bytes_bound.
+ *
+ * @return False if the plan is empty or invalid
+ */
+bool memory_plan_solve(MemoryPlan* plan);
+
+/**
+ * @brief Check that no two live-overlapping buffers share bytes
+ */
+bool memory_plan_verify(const MemoryPlan* plan);
+
+/**
+ * @brief Build and solve the plan of a layer stack
+ *
+ * Activations live from their forward step to the backward step of the
+ * next layer (which reads them as input) or of their own layer (which
+ * reads them as output); gradients from the backward step producing them
+ * to the one consuming them; saved state from forward to backward of its
+ * layer; scratch for one step. Without training, activations die after the
+ * next layer's forward (the last one lives to the end), saved state is
+ * forward scratch and no gradients exist. The network input belongs to
+ * the caller and is not planned.
+ *
+ * @param layers Per-layer sizes
+ * @param num_layers Number of layers
+ * @param training Plan forward and backward
+ * @return Solved plan or NULL on failure
+ */
+MemoryPlan* memory_plan_layers(const MemoryPlanLayer* layers, int num_layers, bool training);
+
+/**
+ * @brief Index of a layer's buffer of one kind
+ *
+ * Scratch buffers of training plans are ordered forward first, backward
+ * second; pass which = 1 for the backward one.
+ *
+ * @return Buffer index or -1 if the layer has none
+ */
+int memory_plan_find(const MemoryPlan* plan, MemoryBufferKind kind, int layer, int which);
+
+// ============================================================================
+// Slab
+// ============================================================================
+
+/**
+ * @brief Allocate the slab (peak_bytes, MEMORY_PLAN_ALIGNMENT aligned)
+ * @return False on allocation failure or unsolved plan
+ */
+bool memory_plan_allocate(MemoryPlan* plan);
+
+/**
+ * @brief Address of a buffer inside the slab
+ * @return Buffer memory or NULL if the slab is not allocated
+ */
+void* memory_plan_buffer(const MemoryPlan* plan, int index);
+
+/**
+ * @brief One-line description: peak, total without reuse and lower bound
+ */
+void memory_plan_describe(const MemoryPlan* plan, char* out, int max_length);
+
+// ============================================================================
+// Network Integration
+// ============================================================================
+
+/**
+ * @brief Plan a built network's training and inference memory
+ *
+ * Called by neural_network_build with config.batch_size (1 if unset).
+ * Sizes come from every layer's input_shape / output_shape plus the
+ * recurrent and convolution workspace queries. Both plans share one slab
+ * sized for the larger of the two (a network runs one schedule at a time).
+ * Replaces any previous plan and sets memory_usage to the training peak.
+ *
+ * @param net Built network
+ * @param batch Batch size to plan for
+ * @return False on invalid shapes or allocation failure
+ */
+bool neural_network_plan_memory(NeuralNetwork* net, int batch);
+
+/**
+ * @brief Planner sizes of every layer of a built network
+ * @param net Built network
+ * @param batch Batch size
+ * @param layers Output, one entry per layer
+ * @return False if a layer has no output shape
+ */
+bool neural_network_memory_layers(const NeuralNetwork* net, int batch, MemoryPlanLayer* layers);
+
+/**
+ * @brief Current plan of a network
+ * @param training Training (true) or inference (false) plan
+ * @return Plan or NULL if the network has not been planned
+ */
+const MemoryPlan* neural_network_memory_plan(const NeuralNetwork* net, bool training);
+
+/**
+ * @brief Slab-backed tensor for a planned buffer
+ *
+ * Layers request their output, gradient and scratch tensors here and fall
+ * back to tensor_create when this returns NULL (no plan, or a batch larger
+ * than the planned one). The view stays valid until the plan is replaced.
+ *
+ * @param net Planned network
+ * @param kind Buffer role
+ * @param layer Layer index
+ * @param which 0, or 1 for the backward scratch buffer
+ * @param training Use the training plan's offsets
+ * @param shape Tensor shape (its size must fit the planned buffer)
+ * @param ndim Number of dimensions
+ * @return View tensor or NULL
+ */
+Tensor* neural_network_planned_tensor(NeuralNetwork* net, MemoryBufferKind kind, int layer, int which,
+                                      bool training, int* shape, int ndim);
+
+/**
+ * @brief Summary lines appended by neural_network_summary
+ *
+ * Peak training and inference memory for the planned batch, the memory
+ * the same buffers would take without reuse, and the live-set lower bound.
+ */
+void neural_network_memory_summary(const NeuralNetwork* net, char* out, int max_length);
+
+/**
+ * @brief Free a network's plan (called by neural_network_destroy)
+ */
+void neural_network_release_memory_plan(NeuralNetwork* net);
+
+#endif // NEURAL_NETWORK_MEMORY_PLAN_H
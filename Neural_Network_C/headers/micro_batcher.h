@@ -0,0 +1,89 @@
+/*
+ * Neural Network System - Micro-Batcher Header
+ * Coalesces concurrent single-sample requests into batches that a fixed set
+ * of worker threads run through one batched forward pass
+ */
+
+#ifndef NEURAL_NETWORK_MICRO_BATCHER_H
+#define NEURAL_NETWORK_MICRO_BATCHER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Batched compute callback
+ * @param context User context given to micro_batcher_create
+ * @param worker Index of the calling worker (0..num_workers-1), for per-worker scratch
+ * @param inputs count rows of input_size floats
+ * @param count Requests in the batch (1..max_batch)
+ * @param outputs count rows of output_size floats to fill
+ * @return False to fail every request in the batch
+ */
+typedef bool (*MicroBatchFn)(void* context, int worker, const float* inputs,
+                             int count, float* outputs);
+
+/**
+ * @brief Batching policy
+ */
+typedef struct {
+    int max_batch;              // Most requests per batch
+    int max_delay_us;           // Longest the oldest request waits for others (0 = never wait)
+    int num_workers;            // Worker threads (0 = all cores)
+} MicroBatchConfig;
+
+/**
+ * @brief Default policy: batches of up to 32, 200 us delay, one worker per core
+ */
+MicroBatchConfig micro_batch_config_default(void);
+
+/**
+ * @brief Counters since creation
+ */
+typedef struct {
+    uint64_t requests;          // Requests submitted
+    uint64_t batches;           // Batches run
+    int largest_batch;          // Largest batch run
+} MicroBatchStats;
+
+typedef struct MicroBatcher MicroBatcher;
+
+/**
+ * @brief Start a batcher and its worker threads
+ * @param input_size Floats per request input
+ * @param output_size Floats per request output
+ * @param config Batching policy
+ * @param fn Batched compute callback (called concurrently by different workers)
+ * @param context Passed to fn
+ * @return Batcher or NULL on failure
+ */
+MicroBatcher* micro_batcher_create(int input_size, int output_size, MicroBatchConfig config,
+                                   MicroBatchFn fn, void* context);
+
+/**
+ * @brief Run outstanding requests, then stop and free the batcher
+ */
+void micro_batcher_destroy(MicroBatcher* batcher);
+
+/**
+ * @brief Submit one request and wait for its result (thread-safe)
+ *
+ * A batch is dispatched as soon as max_batch requests are queued or the
+ * oldest queued request has waited max_delay_us, whichever comes first.
+ *
+ * @param input input_size floats (read until the call returns)
+ * @param output output_size floats, written before the call returns
+ * @return False if the batch failed or the batcher is shutting down
+ */
+bool micro_batcher_submit(MicroBatcher* batcher, const float* input, float* output);
+
+/**
+ * @brief Number of worker threads
+ */
+int micro_batcher_workers(const MicroBatcher* batcher);
+
+/**
+ * @brief Snapshot of the batcher's counters
+ */
+void micro_batcher_get_stats(MicroBatcher* batcher, MicroBatchStats* stats);
+
+#endif // NEURAL_NETWORK_MICRO_BATCHER_H
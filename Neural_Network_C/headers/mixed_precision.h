@@ -0,0 +1,168 @@
+/*
+ * Neural Network System - Mixed Precision Header
+ * bf16 weights and saved activations for dense layers, fp32 master weights
+ * in the optimizer and dynamic loss scaling with overflow detection
+ */
+
+#ifndef NEURAL_NETWORK_MIXED_PRECISION_H
+#define NEURAL_NETWORK_MIXED_PRECISION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "neural_net.h"
+#include "bf16_kernels.h"
+
+// ============================================================================
+// Loss Scaling
+// ============================================================================
+
+/**
+ * @brief Dynamic loss scale
+ *
+ * The loss gradient is multiplied by `scale` before backward so small
+ * gradients survive bf16 rounding. If any parameter gradient comes back
+ * inf/NaN the step is skipped and the scale multiplied by backoff_factor;
+ * after growth_interval clean steps in a row it is multiplied by
+ * growth_factor.
+ */
+typedef struct {
+    float scale;                // Current loss scale
+    float growth_factor;        // Multiplier after growth_interval clean steps
+    float backoff_factor;       // Multiplier after an overflow
+    int growth_interval;        // Clean steps between growths
+    float min_scale;            // Lower clamp
+    float max_scale;            // Upper clamp
+    int good_steps;             // Clean steps since the last change
+    int skipped_steps;          // Steps dropped for overflow so far
+} LossScaler;
+
+/**
+ * @brief Defaults: scale 65536, x2 every 1000 clean steps, x0.5 on overflow
+ */
+LossScaler loss_scaler_default(void);
+
+// ============================================================================
+// Layer Conversion
+// ============================================================================
+
+/**
+ * @brief bf16 state of a converted dense layer (layer->mixed_precision_data)
+ *
+ * The fp32 weights in DenseData stay the master copy the optimizer updates;
+ * the layer computes with two packed bf16 copies (W^T for forward, W for
+ * the input gradient) refreshed after every update. Backward keeps only
+ * bf16 activations: the rounded input and output. When the next layer is
+ * also converted its input is this layer's bf16 output, so each activation
+ * is stored once, and the fp32 output it reads is a shared scratch buffer
+ * rather than a per-layer tensor.
+ */
+typedef struct MixedPrecisionLayer {
+    Bf16PackedMatrix forward_weights;   // W^T (k = input_size, n = output_size)
+    Bf16PackedMatrix backward_weights;  // W (k = output_size, n = input_size)
+    bool shared_weights;                // Packed weights belong to another network's layer
+    GemmActivation activation;          // Activation fused into the GEMM epilogue
+
+    bf16* input;                        // Own rounded input (unless shared)
+    bf16* output;                       // Rounded output
+    size_t input_capacity;              // Elements allocated in input
+    size_t output_capacity;             // Elements allocated in output
+    const bf16* saved_input;            // Input used by backward (own or previous output)
+    int rows;                           // Batch rows of the last forward
+    int input_ndim;                     // Rank of the last input (1 = single sample)
+
+    struct MixedPrecisionLayer* previous;   // Converted layer feeding this one (NULL = none)
+    bool scratch_output;                // fp32 output lives in a shared scratch slot
+    int slot;                           // Scratch slot (layer index parity)
+    void* network;                      // Owning network's MixedPrecisionState
+    Tensor* output_tensor;              // fp32 output handed to the next layer
+    Tensor* grad_input;                 // Gradient w.r.t. the input
+
+    Tensor* (*float_forward)(Layer*, Tensor*);  // Restored on release
+    Tensor* (*float_backward)(Layer*, Tensor*); // Restored on release
+} MixedPrecisionLayer;
+
+/**
+ * @brief Network-wide mixed precision state (net->mixed_precision)
+ */
+typedef struct {
+    LossScaler scaler;          // Dynamic loss scale
+    int num_layers;             // Layers when enabled
+    int converted_layers;       // Dense layers running in bf16
+    float* scratch[2];          // fp32 outputs consumed by a converted next layer
+    size_t scratch_capacity[2]; // Floats allocated per scratch slot
+    float* widened;             // bf16 outputs widened for the activation derivative
+    size_t widened_capacity;    // Floats in widened
+} MixedPrecisionState;
+
+// ============================================================================
+// Network Functions
+// ============================================================================
+
+/**
+ * @brief Run eligible dense layers in bf16 and enable loss scaling
+ *
+ * Dense layers with a GEMM-fusable activation (linear, ReLU, leaky ReLU,
+ * sigmoid, tanh) and no dropout are converted; softmax outputs and other
+ * layer types stay in fp32. Tensors stay fp32 at layer boundaries.
+ * Checkpointing and mixed precision are exclusive.
+ *
+ * @param net Built network
+ * @param scaler Initial loss scale settings
+ * @return False on allocation failure or if checkpointing is on (reported on stderr)
+ */
+bool neural_network_enable_mixed_precision(NeuralNetwork* net, LossScaler scaler);
+
+/**
+ * @brief Enable mixed precision on a replica that reads the master's bf16 weights
+ *
+ * The replica's converted layers use the master's packed copies rather
+ * than their own, so refreshing the master after an update is enough.
+ * The replica's parameters must alias the master's (see
+ * neural_network_replicate), and the master must outlive the replica.
+ *
+ * @param replica Replica of master without mixed precision
+ * @param master Network with mixed precision enabled
+ * @return False on allocation failure, mismatched layers or if checkpointing is on
+ */
+bool neural_network_share_mixed_precision(NeuralNetwork* replica, const NeuralNetwork* master);
+
+/**
+ * @brief Restore fp32 layers and free the bf16 state (called by neural_network_destroy)
+ */
+void neural_network_disable_mixed_precision(NeuralNetwork* net);
+
+/**
+ * @brief Repack the bf16 weights from the fp32 masters after an update
+ *
+ * Networks sharing net's packed weights see the new values too; on such a
+ * network this does nothing.
+ */
+void neural_network_refresh_mixed_precision(NeuralNetwork* net);
+
+/**
+ * @brief Current loss scale
+ * @return Scale to multiply the loss gradient by (1 when mixed precision is off)
+ */
+float neural_network_loss_scale(const NeuralNetwork* net);
+
+/**
+ * @brief Check, unscale and account for the gradients of a scaled backward
+ *
+ * neural_network_train_step calls this between backward and the optimizer
+ * update. On overflow the gradients are zeroed, the scale backs off and
+ * the update must be skipped.
+ *
+ * @param net Network after a backward pass with a scaled loss gradient
+ * @return True if the gradients are finite and the update may run
+ */
+bool neural_network_unscale_gradients(NeuralNetwork* net);
+
+/**
+ * @brief Bytes of activations kept for backward by the last forward pass
+ *
+ * Converted layers count their bf16 copies; fp32 layers their output cache
+ * (and the network input cached by the first layer).
+ */
+size_t neural_network_saved_activation_bytes(const NeuralNetwork* net);
+
+#endif // NEURAL_NETWORK_MIXED_PRECISION_H
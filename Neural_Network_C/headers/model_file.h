@@ -0,0 +1,211 @@
+/*
+ * Neural Network System - Binary Model File Header
+ * Versioned on-disk model format laid out for zero-copy loading: a fixed
+ * header, a layer table, a tensor table and one contiguous weight blob whose
+ * tensors all start on 64-byte boundaries, so a memory-mapped file can back
+ * Tensor::data directly
+ */
+
+#ifndef NEURAL_NETWORK_MODEL_FILE_H
+#define NEURAL_NETWORK_MODEL_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// File Layout
+// ============================================================================
+
+#define MODEL_FILE_MAGIC "NNMODEL"      // 7 characters plus terminator
+#define MODEL_FILE_VERSION 1            // Bumped on any incompatible layout change
+#define MODEL_FILE_ALIGNMENT 64         // Alignment of tables, blob and every tensor
+#define MODEL_FILE_BYTE_ORDER 0x01020304u // Written natively; detects foreign-endian files
+#define MODEL_FILE_MAX_DIMS 4           // Dimensions recorded per tensor
+#define MODEL_FILE_MAX_PARAMS 6         // Integer constructor arguments per layer
+
+/**
+ * @brief Fixed file header (256 bytes, at offset 0)
+ *
+ * All offsets are absolute byte offsets into the file and multiples of
+ * MODEL_FILE_ALIGNMENT. Sections follow in the order header, layer table,
+ * tensor table, weight blob.
+ */
+typedef struct {
+    char magic[8];                  // MODEL_FILE_MAGIC
+    uint32_t version;               // MODEL_FILE_VERSION
+    uint32_t byte_order;            // MODEL_FILE_BYTE_ORDER as stored by the writer
+    uint32_t header_size;           // sizeof(ModelFileHeader)
+    uint32_t num_layers;            // Entries in the layer table
+    uint32_t num_tensors;           // Entries in the tensor table
+    uint32_t table_checksum;        // FNV-1a over the layer and tensor tables
+    uint64_t layer_table_offset;    // ModelLayerRecord[num_layers]
+    uint64_t tensor_table_offset;   // ModelTensorRecord[num_tensors]
+    uint64_t blob_offset;           // Start of the weight blob
+    uint64_t blob_size;             // Bytes in the weight blob
+    uint64_t file_size;             // Total file size (detects truncation)
+    int32_t input_ndim;             // Network input rank (0 = unknown)
+    int32_t input_shape[MODEL_FILE_MAX_DIMS]; // Network input shape
+    char name[164];                 // Network name
+} ModelFileHeader;
+
+/**
+ * @brief One layer: type, constructor arguments and its parameter tensors (128 bytes)
+ *
+ * params holds the integer arguments of the layer's create function in
+ * declaration order (dense: in, out; conv2d: in_channels, out_channels,
+ * kernel, stride, padding; pooling: pool, stride; LSTM/GRU: in, hidden,
+ * return_sequences, followed by the BPTT window). The layer's tensors are the weights followed by the
+ * biases, starting at first_tensor in the tensor table.
+ */
+typedef struct {
+    char name[64];                  // Layer name
+    uint32_t type;                  // LayerType
+    uint32_t first_tensor;          // First tensor table index
+    uint32_t num_weights;           // Weight tensors
+    uint32_t num_biases;            // Bias tensors
+    int32_t params[MODEL_FILE_MAX_PARAMS]; // Constructor arguments
+    float rate;                     // Dropout rate
+    char activation[16];            // Activation name ("" = none)
+    uint32_t trainable;             // Layer trainable flag
+} ModelLayerRecord;
+
+/**
+ * @brief One float32 tensor inside the weight blob (64 bytes)
+ */
+typedef struct {
+    uint64_t offset;                // Byte offset from blob_offset (64-byte aligned)
+    uint64_t size;                  // Element count
+    uint32_t ndim;                  // Used entries of shape
+    int32_t shape[MODEL_FILE_MAX_DIMS]; // Tensor shape
+    uint32_t checksum;              // FNV-1a of the data, checked by model_file_verify
+    uint32_t reserved[6];           // Zero
+} ModelTensorRecord;
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+/**
+ * @brief How model_file_open brings the file into memory
+ */
+typedef enum {
+    MODEL_LOAD_MMAP,                // Read-only shared mapping, pages faulted in on first use
+    MODEL_LOAD_MMAP_POPULATE,       // Shared mapping with all pages faulted in up front
+    MODEL_LOAD_READ                 // Private heap copy (writable, not shared)
+} ModelLoadMode;
+
+/**
+ * @brief An open model file
+ *
+ * Pointers refer into the mapping (or heap copy) and stay valid until
+ * model_file_close. Mapped data is read-only: writing to it faults.
+ */
+typedef struct {
+    void* base;                         // Mapping or aligned heap copy
+    void* raw;                          // Heap allocation behind base (read mode)
+    size_t length;                      // Bytes at base
+    bool mapped;                        // True when base is an mmap region
+    const ModelFileHeader* header;      // File header
+    const ModelLayerRecord* layers;     // Layer table
+    const ModelTensorRecord* tensors;   // Tensor table
+    const unsigned char* blob;          // Weight blob
+} ModelFile;
+
+/**
+ * @brief Open and validate a model file
+ *
+ * Validation covers magic, version, byte order, section bounds and
+ * alignment, the table checksum and every tensor's extent; it never touches
+ * the weight blob, so opening a mapped file costs the same for any model
+ * size. Platforms without mmap fall back to MODEL_LOAD_READ.
+ *
+ * @param file Output handle
+ * @param filename Path to the model file
+ * @param mode Mapping strategy
+ * @return False (with a message on stderr) if the file is missing or malformed
+ */
+bool model_file_open(ModelFile* file, const char* filename, ModelLoadMode mode);
+
+/**
+ * @brief Unmap or free the file; pointers into it become invalid
+ */
+void model_file_close(ModelFile* file);
+
+/**
+ * @brief Data of tensor table entry index (64-byte aligned)
+ */
+const float* model_file_tensor_data(const ModelFile* file, uint32_t index);
+
+/**
+ * @brief Check every tensor's data against its stored checksum
+ *
+ * Reads the whole blob, so it is kept out of model_file_open.
+ */
+bool model_file_verify(const ModelFile* file);
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+/**
+ * @brief Accumulates layers and tensors for one model file
+ *
+ * Tensor data is referenced, not copied, until model_writer_write.
+ */
+typedef struct {
+    ModelFileHeader header;             // Header being assembled
+    ModelLayerRecord* layers;           // Layer table
+    ModelTensorRecord* tensors;         // Tensor table
+    const float** sources;              // Data of each tensor
+    uint32_t layer_capacity;            // Allocated layer entries
+    uint32_t tensor_capacity;           // Allocated tensor entries
+} ModelWriter;
+
+/**
+ * @brief Start a model file
+ * @param writer Writer to initialize
+ * @param name Network name (truncated to fit)
+ * @param input_shape Network input shape (NULL if unknown)
+ * @param input_ndim Input rank (at most MODEL_FILE_MAX_DIMS)
+ */
+void model_writer_init(ModelWriter* writer, const char* name,
+                       const int* input_shape, int input_ndim);
+
+/**
+ * @brief Append a layer record
+ *
+ * Tensors added afterwards belong to this layer; first_tensor is filled in
+ * here and num_weights + num_biases must match the tensors that follow.
+ *
+ * @return False on allocation failure
+ */
+bool model_writer_add_layer(ModelWriter* writer, const ModelLayerRecord* record);
+
+/**
+ * @brief Append a float32 tensor to the most recent layer
+ * @param data Tensor data (must stay valid until model_writer_write)
+ * @param shape Tensor shape
+ * @param ndim Tensor rank (at most MODEL_FILE_MAX_DIMS)
+ * @return False on allocation failure or invalid shape
+ */
+bool model_writer_add_tensor(ModelWriter* writer, const float* data,
+                             const int* shape, int ndim);
+
+/**
+ * @brief Write the file
+ *
+ * The file is written under a temporary name and renamed into place, so
+ * processes that have the previous version mapped keep a consistent copy
+ * and readers never observe a partial file.
+ *
+ * @return False (with a message on stderr) on I/O failure
+ */
+bool model_writer_write(ModelWriter* writer, const char* filename);
+
+/**
+ * @brief Release the writer's tables
+ */
+void model_writer_free(ModelWriter* writer);
+
+#endif // NEURAL_NETWORK_MODEL_FILE_H
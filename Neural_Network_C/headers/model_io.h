@@ -0,0 +1,53 @@
+/*
+ * Neural Network System - Model Save/Load Header
+ * Network serialization on top of the binary model format: save writes the
+ * layer structure and parameters, load rebuilds the layers and points their
+ * parameter tensors straight into the mapped file
+ */
+
+#ifndef NEURAL_NETWORK_MODEL_IO_H
+#define NEURAL_NETWORK_MODEL_IO_H
+
+#include <stdbool.h>
+#include "neural_net.h"
+#include "model_file.h"
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+/**
+ * @brief Load a network with an explicit mapping strategy
+ *
+ * With the mmap modes no parameter data is copied: each weight and bias
+ * tensor's data points into the shared read-only mapping, so load time is
+ * independent of model size and concurrent processes share one copy in the
+ * page cache. Such networks are for inference; call
+ * neural_network_detach_model_file before training or modifying parameters.
+ * neural_network_load uses MODEL_LOAD_MMAP.
+ *
+ * @param filename Model file written by neural_network_save
+ * @param mode Mapping strategy
+ * @return Loaded network or NULL on failure
+ */
+NeuralNetwork* neural_network_load_with_mode(const char* filename, ModelLoadMode mode);
+
+/**
+ * @brief Copy mapped parameters into owned memory and close the model file
+ *
+ * Afterwards the network is an ordinary writable network. Does nothing for
+ * networks that were not loaded from a file.
+ *
+ * @return False if a copy could not be allocated (the mapping is kept)
+ */
+bool neural_network_detach_model_file(NeuralNetwork* net);
+
+/**
+ * @brief Destroy a network and close the model file backing it
+ *
+ * Equivalent to neural_network_destroy for networks that own their
+ * parameters.
+ */
+void neural_network_unload(NeuralNetwork* net);
+
+#endif // NEURAL_NETWORK_MODEL_IO_H
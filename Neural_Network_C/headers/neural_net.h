@@ -16,21 +16,27 @@ typedef struct Loss Loss;
 typedef struct Optimizer Optimizer;
 typedef struct NeuralNetwork NeuralNetwork;
 typedef struct TrainingConfig TrainingConfig;
+typedef struct DataLoader DataLoader;
 
 // ============================================================================
 // Tensor Data Structure
 // ============================================================================
 
+#define TENSOR_INLINE_DIMS 4     // Shapes up to this rank are stored inside the Tensor
+
 /**
  * @brief Multi-dimensional tensor for neural network computations
  */
 struct Tensor {
     float* data;                // Contiguous data array
-    int* shape;                 // Dimension sizes
+    int* shape;                 // Dimension sizes (points to shape_inline when ndim is small)
     int ndim;                   // Number of dimensions
     int size;                   // Total number of elements
     bool requires_grad;         // Whether gradients are needed
     float* grad;                // Gradient data (if requires_grad)
+    bool owns_data;             // Whether tensor_destroy frees data
+    bool arena_owned;           // Carved from an arena; tensor_destroy leaves it alone
+    int shape_inline[TENSOR_INLINE_DIMS]; // Storage for small shapes
 };
 
 // ============================================================================
@@ -39,6 +45,10 @@ struct Tensor {
 
 /**
  * @brief Create a tensor
+ *
+ * If a TensorArena is active on the calling thread (see tensor_arena.h) the
+ * tensor is carved out of it and lives until the arena is reset.
+ *
  * @param data Data array (can be NULL for zero initialization)
  * @param shape Shape array
  * @param ndim Number of dimensions
@@ -47,11 +57,217 @@ struct Tensor {
 Tensor* tensor_create(float* data, int* shape, int ndim);
 
 /**
- * @brief Destroy a tensor
+ * @brief Create a tensor that wraps existing memory without copying it
+ * @param data Data array (must outlive the view)
+ * @param shape Shape array
+ * @param ndim Number of dimensions
+ * @return Created view or NULL on failure
+ */
+Tensor* tensor_create_view(float* data, int* shape, int ndim);
+
+/**
+ * @brief Point a tensor at existing memory, releasing the storage it owned
+ *
+ * Heap storage is freed through the allocation counters; arena storage is
+ * left to the arena.
+ *
+ * @param tensor Tensor to repoint
+ * @param data Data array of at least tensor->size floats (must outlive the tensor)
+ */
+void tensor_alias_data(Tensor* tensor, float* data);
+
+/**
+ * @brief Destroy a tensor (no-op for arena-owned tensors)
  * @param tensor Tensor to destroy
  */
 void tensor_destroy(Tensor* tensor);
 
+// ============================================================================
+// Tensor Operations
+// ============================================================================
+
+/**
+ * @brief Elementwise sum into a new tensor
+ * @param a First operand
+ * @param b Second operand (same size as a)
+ * @return New tensor a + b or NULL on failure
+ */
+Tensor* tensor_add(Tensor* a, Tensor* b);
+
+/**
+ * @brief Elementwise product into a new tensor
+ * @param a First operand
+ * @param b Second operand (same size as a)
+ * @return New tensor a * b or NULL on failure
+ */
+Tensor* tensor_multiply(Tensor* a, Tensor* b);
+
+/**
+ * @brief Scale into a new tensor
+ * @param tensor Operand
+ * @param scalar Scale factor
+ * @return New tensor scalar * tensor or NULL on failure
+ */
+Tensor* tensor_scalar_multiply(Tensor* tensor, float scalar);
+
+/**
+ * @brief Sum of all elements
+ * @param tensor Input tensor
+ * @return Element sum
+ */
+float tensor_sum(Tensor* tensor);
+
+/**
+ * @brief Set every element to a value
+ * @param tensor Tensor to fill
+ * @param value Fill value
+ */
+void tensor_fill(Tensor* tensor, float value);
+
+/**
+ * @brief Set every element to zero
+ * @param tensor Tensor to clear
+ */
+void tensor_zero(Tensor* tensor);
+
+/**
+ * @brief Deep copy of a tensor
+ * @param tensor Tensor to copy
+ * @return New tensor or NULL on failure
+ */
+Tensor* tensor_copy(Tensor* tensor);
+
+/**
+ * @brief Elementwise sum into an existing buffer: out = a + b
+ * @param out Output tensor (same size; may alias a or b)
+ * @param a First operand
+ * @param b Second operand
+ * @return True on success
+ */
+bool tensor_add_into(Tensor* out, const Tensor* a, const Tensor* b);
+
+/**
+ * @brief Elementwise product into an existing buffer: out = a * b
+ * @param out Output tensor (same size; may alias a or b)
+ * @param a First operand
+ * @param b Second operand
+ * @return True on success
+ */
+bool tensor_multiply_into(Tensor* out, const Tensor* a, const Tensor* b);
+
+/**
+ * @brief Scale into an existing buffer: out = scalar * tensor
+ * @param out Output tensor (same size; may alias tensor)
+ * @param tensor Operand
+ * @param scalar Scale factor
+ * @return True on success
+ */
+bool tensor_scalar_multiply_into(Tensor* out, const Tensor* tensor, float scalar);
+
+/**
+ * @brief Fused multiply-add in one pass: out = a * b + c
+ * @param out Output tensor (same size; may alias any operand)
+ * @param a First factor
+ * @param b Second factor
+ * @param c Addend
+ * @return True on success
+ */
+bool tensor_fma_into(Tensor* out, const Tensor* a, const Tensor* b, const Tensor* c);
+
+/**
+ * @brief Copy data into an existing buffer of the same size
+ * @param out Destination tensor
+ * @param tensor Source tensor
+ * @return True on success
+ */
+bool tensor_copy_into(Tensor* out, const Tensor* tensor);
+
+/**
+ * @brief In-place sum: a += b
+ * @return True on success
+ */
+bool tensor_add_inplace(Tensor* a, const Tensor* b);
+
+/**
+ * @brief In-place product: a *= b
+ * @return True on success
+ */
+bool tensor_multiply_inplace(Tensor* a, const Tensor* b);
+
+/**
+ * @brief In-place scale: tensor *= scalar
+ * @return True on success
+ */
+bool tensor_scale_inplace(Tensor* tensor, float scalar);
+
+/**
+ * @brief BLAS-style axpy: y += alpha * x
+ * @param y Accumulator
+ * @param alpha Scale applied to x
+ * @param x Operand (same size as y)
+ * @return True on success
+ */
+bool tensor_axpy(Tensor* y, float alpha, const Tensor* x);
+
+/**
+ * @brief Scaled accumulate: y = alpha * x + beta * y
+ * @param y Accumulator
+ * @param alpha Scale applied to x
+ * @param x Operand (same size as y)
+ * @param beta Scale applied to y
+ * @return True on success
+ */
+bool tensor_axpby(Tensor* y, float alpha, const Tensor* x, float beta);
+
+/**
+ * @brief Matrix product a * b
+ * @param a Left matrix (m x k)
+ * @param b Right matrix (k x n)
+ * @return Result matrix (m x n) or NULL on failure
+ */
+Tensor* matrix_multiply(Tensor* a, Tensor* b);
+
+/**
+ * @brief Matrix product a * b^T without materializing the transpose
+ * @param a Left matrix (m x k)
+ * @param b Right matrix (n x k)
+ * @return Result matrix (m x n) or NULL on failure
+ */
+Tensor* matrix_multiply_transpose_b(Tensor* a, Tensor* b);
+
+/**
+ * @brief Matrix product a^T * b without materializing the transpose
+ * @param a Left matrix (k x m)
+ * @param b Right matrix (k x n)
+ * @return Result matrix (m x n) or NULL on failure
+ */
+Tensor* matrix_multiply_transpose_a(Tensor* a, Tensor* b);
+
+/**
+ * @brief Matrix product into an existing (m x n) buffer
+ * @return True on success
+ */
+bool matrix_multiply_into(Tensor* out, const Tensor* a, const Tensor* b);
+
+/**
+ * @brief a * b^T into an existing (m x n) buffer
+ * @return True on success
+ */
+bool matrix_multiply_transpose_b_into(Tensor* out, const Tensor* a, const Tensor* b);
+
+/**
+ * @brief a^T * b into an existing (m x n) buffer
+ * @return True on success
+ */
+bool matrix_multiply_transpose_a_into(Tensor* out, const Tensor* a, const Tensor* b);
+
+/**
+ * @brief Transpose a matrix
+ * @param matrix Input matrix (m x n)
+ * @return Transposed copy (n x m) or NULL on failure
+ */
+Tensor* matrix_transpose(Tensor* matrix);
+
 // ============================================================================
 // Layer System
 // ============================================================================
@@ -100,6 +316,10 @@ struct Layer {
     // Layer-specific data
     void* layer_data;           // Layer-specific parameters
     bool trainable;             // Whether layer is trainable
+    void* quantized_data;       // Int8 inference state (NULL = float, see quantize.h)
+    void* mixed_precision_data; // bf16 compute state (NULL = fp32, see mixed_precision.h)
+    void* profile_data;         // Profiler hook around forward/backward (NULL = off, see profiler.h)
+    void* sparse_data;          // Compressed weights of a sparsified layer (NULL = dense, see pruning.h)
 
     // State
     Tensor* input_cache;        // Cached input for backprop
@@ -118,7 +338,8 @@ typedef enum {
     LOSS_CROSS_ENTROPY,         // Cross entropy
     LOSS_BINARY_CROSS_ENTROPY,  // Binary cross entropy
     LOSS_CATEGORICAL_CROSS_ENTROPY, // Categorical cross entropy
-    LOSS_HUBER                  // Huber loss
+    LOSS_HUBER,                 // Huber loss
+    LOSS_SOFTMAX_CROSSENTROPY   // Softmax + cross entropy fused, on logits
 } LossType;
 
 /**
@@ -131,6 +352,7 @@ struct Loss {
     // Loss computation
     float (*compute)(Tensor*, Tensor*);  // Compute loss
     Tensor* (*gradient)(Tensor*, Tensor*); // Compute gradient
+    float (*compute_with_gradient)(Tensor*, Tensor*, Tensor*); // Loss + gradient in one pass (NULL = none)
 
     // User data
     void* user_data;            // User-defined data
@@ -168,13 +390,18 @@ struct Optimizer {
     float weight_decay;         // Weight decay (L2 regularization)
     float momentum;             // Momentum factor
 
-    // State
-    Tensor** m;                 // First moment estimates (Adam)
-    Tensor** v;                 // Second moment estimates (Adam)
+    // State (one slot per parameter tensor, created on its first update)
+    Tensor** params;            // Parameter tensor owning each slot
+    Tensor** m;                 // First moment / velocity / squared-gradient sum per slot
+    Tensor** v;                 // Second moment (Adam, NAdam, RMSProp) or infinity norm (Adamax)
+    int* steps;                 // Updates applied to each slot
+    int num_slots;              // Slots in use
+    int slot_capacity;          // Allocated slot entries
+    int slot_cursor;            // Slot expected next (parameters arrive in a stable order)
     int t;                      // Time step (for bias correction)
 
     // Update function
-    void (*update)(Layer*, int);  // Update layer parameters
+    void (*update)(Optimizer*, Layer*, int);  // Update layer parameters
 
     // User data
     void* user_data;            // User-defined data
@@ -196,6 +423,7 @@ struct TrainingConfig {
     bool early_stopping;        // Whether to use early stopping
     int patience;               // Early stopping patience
     float min_delta;            // Minimum change for early stopping
+    int num_threads;            // Worker threads for training (0 = all cores)
 };
 
 /**
@@ -233,7 +461,15 @@ struct NeuralNetwork {
     // Performance metrics
     double training_time;       // Total training time
     int parameters_count;       // Total number of parameters
-    float memory_usage;         // Memory usage in MB
+    float memory_usage;         // Peak training memory of the planned buffers in MB
+
+    // Storage
+    void* model_file;           // Open ModelFile backing the parameters (see model_io.h)
+    void* memory_plan;          // Activation/gradient slab and its offsets (see memory_plan.h)
+    void* checkpoint;           // Gradient checkpointing state (see checkpointing.h, NULL = off)
+    void* mixed_precision;      // bf16 layers and loss scale (see mixed_precision.h, NULL = off)
+    void* profiler;             // Per-layer counters and timeline (see profiler.h, NULL = off)
+    void* pruning;              // Magnitude pruning masks and schedule (see pruning.h, NULL = off)
 };
 
 // ============================================================================
@@ -280,6 +516,12 @@ bool neural_network_compile(NeuralNetwork* net, Loss* loss, Optimizer* optimizer
 
 /**
  * @brief Build the network with input shape
+ *
+ * Once every layer's input_shape / output_shape is known, plans the
+ * activation, gradient and scratch buffers of one training and one
+ * inference step for config.batch_size into a single slab
+ * (neural_network_plan_memory).
+ *
  * @param net Network to build
  * @param input_shape Input tensor shape
  * @param input_ndim Number of input dimensions
@@ -289,6 +531,10 @@ bool neural_network_build(NeuralNetwork* net, int* input_shape, int input_ndim);
 
 /**
  * @brief Forward pass through the network
+ *
+ * With gradient checkpointing enabled, runs neural_network_checkpoint_forward
+ * so that only segment inputs are kept.
+ *
  * @param net Network
  * @param input Input tensor
  * @return Output tensor or NULL on failure
@@ -297,6 +543,10 @@ Tensor* neural_network_forward(NeuralNetwork* net, Tensor* input);
 
 /**
  * @brief Backward pass through the network
+ *
+ * With gradient checkpointing enabled, hands the loss gradient to
+ * neural_network_checkpoint_backward, which recomputes dropped segments.
+ *
  * @param net Network
  * @param output Network output
  * @param target Target values
@@ -306,12 +556,21 @@ bool neural_network_backward(NeuralNetwork* net, Tensor* output, Tensor* target)
 
 /**
  * @brief Update network parameters
+ *
+ * Applies the network's optimizer to every trainable layer in a single
+ * multi-tensor pass (see optimizer_step). With profiling on it runs
+ * neural_network_profile_update instead, which times each layer.
+ *
  * @param net Network to update
  */
 void neural_network_update(NeuralNetwork* net);
 
 /**
  * @brief Train the neural network
+ *
+ * Runs neural_network_train_step over each batch, so an enabled pruning
+ * schedule (see pruning.h) advances once per batch.
+ *
  * @param net Network to train
  * @param x Training input data
  * @param y Training target data
@@ -320,6 +579,19 @@ void neural_network_update(NeuralNetwork* net);
  */
 bool neural_network_fit(NeuralNetwork* net, Tensor* x, Tensor* y, TrainingConfig config);
 
+/**
+ * @brief Train the neural network on batches streamed from a DataLoader
+ *
+ * Each epoch walks the loader once (see data_loader.h); the loader's
+ * batch size and shuffle settings apply, and validation_split is ignored.
+ *
+ * @param net Network to train
+ * @param loader Open dataset loader
+ * @param config Training configuration
+ * @return False if the network is not compiled or a dataset read fails
+ */
+bool neural_network_fit_loader(NeuralNetwork* net, DataLoader* loader, TrainingConfig config);
+
 /**
  * @brief Make predictions with the network
  * @param net Trained network
@@ -348,6 +620,10 @@ bool neural_network_save(NeuralNetwork* net, const char* filename);
 
 /**
  * @brief Load network from file
+ *
+ * Parameters are memory-mapped read-only rather than copied (see
+ * model_io.h); release the network with neural_network_unload.
+ *
  * @param filename Input filename
  * @return Loaded network or NULL on failure
  */
@@ -359,6 +635,15 @@ NeuralNetwork* neural_network_load(const char* filename);
 
 /**
  * @brief Train network for one epoch
+ *
+ * With mixed precision enabled (see mixed_precision.h) the loss gradient is
+ * multiplied by the current loss scale before backward. The gradients are
+ * then checked and unscaled by neural_network_unscale_gradients; on overflow
+ * the optimizer update is skipped and the scale backs off, otherwise the
+ * update runs on the fp32 master weights and the bf16 copies are refreshed.
+ * With pruning enabled (see pruning.h) neural_network_prune_step follows the
+ * update, so the bf16 copies are refreshed from the masked weights.
+ *
  * @param net Network to train
  * @param x_batch Input batch
  * @param y_batch Target batch
@@ -390,6 +675,10 @@ bool neural_network_check_early_stopping(NeuralNetwork* net, float current_loss)
 
 /**
  * @brief Get network summary
+ *
+ * Ends with the peak training and inference memory of the memory plan
+ * (neural_network_memory_summary).
+ *
  * @param net Network
  * @param summary Output summary string
  * @param max_length Maximum summary length
@@ -398,8 +687,12 @@ void neural_network_summary(NeuralNetwork* net, char* summary, int max_length);
 
 /**
  * @brief Get network statistics
+ *
+ * Parameter count, planned memory and training time, plus the per-layer
+ * profiler counters when profiling is on (see profiler.h).
+ *
  * @param net Network
- * @param stats Output statistics structure
+ * @param stats Output NetworkStats
  */
 void neural_network_get_stats(NeuralNetwork* net, void* stats);
 
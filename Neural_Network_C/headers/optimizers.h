@@ -36,6 +36,20 @@ typedef struct {
     void (*update)(Tensor*, Tensor*, float, void*); // Parameter update function
 } OptimizerFunction;
 
+/**
+ * @brief Optimizer state of one parameter tensor for a single update
+ *
+ * Passed as user_data to the per-tensor update functions. Optimizers own
+ * one state slot per parameter; optimizer_update_layer and optimizer_step
+ * build this view internally.
+ */
+typedef struct {
+    const Optimizer* optimizer; // Hyperparameters (beta1, beta2, epsilon, ...)
+    float* m;                   // First moment / velocity / squared-gradient sum
+    float* v;                   // Second moment / infinity norm
+    int t;                      // Step number of this update (1-based)
+} OptimizerUpdateState;
+
 // ============================================================================
 // Optimizer Creation and Management
 // ============================================================================
@@ -62,6 +76,27 @@ void optimizer_destroy(Optimizer* optimizer);
  */
 void optimizer_update_layer(Optimizer* optimizer, Layer* layer, int layer_index);
 
+/**
+ * @brief Fused multi-tensor update of every trainable parameter
+ *
+ * Walks all layers' weights and biases once, applying the vectorized
+ * update kernel to each tensor with its own state slot. Bias corrections
+ * are computed once per tensor rather than per element.
+ *
+ * @param optimizer Optimizer
+ * @param layers Layers to update
+ * @param num_layers Number of layers
+ */
+void optimizer_step(Optimizer* optimizer, Layer** layers, int num_layers);
+
+/**
+ * @brief Find the state slot of a parameter tensor
+ * @param optimizer Optimizer
+ * @param param Parameter tensor
+ * @return Slot index or -1 if the parameter has not been updated yet
+ */
+int optimizer_find_slot(Optimizer* optimizer, const Tensor* param);
+
 /**
  * @brief Reset optimizer state
  * @param optimizer Optimizer to reset
@@ -86,7 +121,7 @@ void optimizer_sgd_update(Tensor* weights, Tensor* gradients, float learning_rat
  * @param weights Weight tensor
  * @param gradients Gradient tensor
  * @param learning_rate Learning rate
- * @param user_data Momentum state
+ * @param user_data OptimizerUpdateState of this parameter (NULL falls back to SGD)
  */
 void optimizer_sgd_momentum_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data);
 
@@ -99,7 +134,7 @@ void optimizer_sgd_momentum_update(Tensor* weights, Tensor* gradients, float lea
  * @param weights Weight tensor
  * @param gradients Gradient tensor
  * @param learning_rate Learning rate
- * @param user_data AdaGrad state (accumulated squares)
+ * @param user_data OptimizerUpdateState of this parameter (NULL falls back to SGD)
  */
 void optimizer_adagrad_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data);
 
@@ -112,7 +147,7 @@ void optimizer_adagrad_update(Tensor* weights, Tensor* gradients, float learning
  * @param weights Weight tensor
  * @param gradients Gradient tensor
  * @param learning_rate Learning rate
- * @param user_data RMSProp state
+ * @param user_data OptimizerUpdateState of this parameter (NULL falls back to SGD)
  */
 void optimizer_rmsprop_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data);
 
@@ -125,7 +160,7 @@ void optimizer_rmsprop_update(Tensor* weights, Tensor* gradients, float learning
  * @param weights Weight tensor
  * @param gradients Gradient tensor
  * @param learning_rate Learning rate
- * @param user_data Adam state (m, v, t)
+ * @param user_data OptimizerUpdateState of this parameter (NULL falls back to SGD)
  */
 void optimizer_adam_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data);
 
@@ -134,7 +169,7 @@ void optimizer_adam_update(Tensor* weights, Tensor* gradients, float learning_ra
  * @param weights Weight tensor
  * @param gradients Gradient tensor
  * @param learning_rate Learning rate
- * @param user_data Adamax state
+ * @param user_data OptimizerUpdateState of this parameter (NULL falls back to SGD)
  */
 void optimizer_adamax_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data);
 
@@ -143,7 +178,7 @@ void optimizer_adamax_update(Tensor* weights, Tensor* gradients, float learning_
  * @param weights Weight tensor
  * @param gradients Gradient tensor
  * @param learning_rate Learning rate
- * @param user_data NAdam state
+ * @param user_data OptimizerUpdateState of this parameter (NULL falls back to SGD)
  */
 void optimizer_nadam_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data);
 
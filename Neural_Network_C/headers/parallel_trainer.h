@@ -0,0 +1,110 @@
+/*
+ * Neural Network System - Parallel Trainer Header
+ * Data-parallel mini-batch training on a persistent thread pool
+ */
+
+#ifndef NEURAL_NETWORK_PARALLEL_TRAINER_H
+#define NEURAL_NETWORK_PARALLEL_TRAINER_H
+
+#include "neural_net.h"
+#include "thread_pool.h"
+#include "tensor_arena.h"
+
+/**
+ * @brief Gradient tensor and its per-replica copies, reduced in chunks
+ */
+typedef struct {
+    Tensor* target;             // Master gradient (also replica 0's buffer)
+    Tensor** sources;           // Gradient of the same parameter in replicas 1..n-1
+    int first_task;             // First reduction task index for this tensor
+    int num_tasks;              // Number of reduction chunks
+} GradientReduction;
+
+/**
+ * @brief Data-parallel trainer
+ *
+ * Replica 0 is the master network itself; replicas 1..n-1 are architecture
+ * copies whose weights and biases alias the master's memory, so only the
+ * gradient buffers and activation caches are duplicated per thread.
+ */
+typedef struct {
+    NeuralNetwork* master;      // Network being trained
+    NeuralNetwork** replicas;   // Per-thread networks (replicas[0] == master)
+    int num_replicas;           // Number of replicas (== pool threads)
+    ThreadPool* pool;           // Persistent worker pool
+    ThreadPool* previous_pool;  // GEMM pool attached before the trainer
+    bool attached;              // Pool is attached to GEMM (previous_pool restored on destroy)
+    TensorArena** arenas;       // Per-replica arenas for step temporaries
+
+    GradientReduction* reductions; // One entry per parameter gradient
+    int num_reductions;         // Number of gradient tensors
+    int num_reduce_tasks;       // Total reduction chunks
+
+    float* shard_loss;          // Loss of each shard in the current step
+    float* shard_weight;        // Fraction of the batch in each shard
+    Tensor* x_batch;            // Current step input
+    Tensor* y_batch;            // Current step target
+    int num_shards;             // Shards used in the current step
+} ParallelTrainer;
+
+#define PARALLEL_TRAINER_REDUCE_CHUNK 16384 // Elements per reduction task
+
+/**
+ * @brief Create a data-parallel trainer for a compiled network
+ *
+ * The trainer's pool is attached to GEMM (gemm_set_thread_pool) so large
+ * products outside the data-parallel region use it too, until the
+ * trainer is destroyed.
+ *
+ * @param net Compiled network (master copy of the parameters)
+ * @param num_threads Number of threads (0 = all cores)
+ * @return Trainer or NULL on failure
+ */
+ParallelTrainer* parallel_trainer_create(NeuralNetwork* net, int num_threads);
+
+/**
+ * @brief Destroy trainer, its replicas and its thread pool
+ *
+ * Reattaches the GEMM pool that was attached when the trainer was created.
+ *
+ * @param trainer Trainer to destroy
+ */
+void parallel_trainer_destroy(ParallelTrainer* trainer);
+
+/**
+ * @brief Data-parallel replacement for neural_network_train_step
+ *
+ * Splits the batch row-wise across replicas, runs forward/backward on each
+ * shard concurrently, reduces shard gradients into the master weighted by
+ * shard size, then calls neural_network_update on the master. Tensors
+ * created during forward/backward come from per-replica arenas that are
+ * reset at the end of the step, so after warm-up a step does not touch the
+ * heap for temporaries.
+ *
+ * @param trainer Parallel trainer
+ * @param x_batch Input batch (rows are samples)
+ * @param y_batch Target batch
+ * @return Average loss for the batch
+ */
+float parallel_trainer_train_step(ParallelTrainer* trainer, Tensor* x_batch, Tensor* y_batch);
+
+/**
+ * @brief Copy a network whose weights and biases alias the original's storage
+ *
+ * Only gradient buffers and per-layer caches are duplicated, so a replica
+ * can run forward/backward on its own thread while the parameters stay
+ * shared. Destroy replicas before the network they alias.
+ *
+ * @param net Network to replicate
+ * @return Replica or NULL on failure
+ */
+NeuralNetwork* neural_network_replicate(NeuralNetwork* net);
+
+/**
+ * @brief Resolve TrainingConfig::num_threads to a concrete thread count
+ * @param config Training configuration
+ * @return Number of threads to use (at least 1)
+ */
+int training_config_get_threads(const TrainingConfig* config);
+
+#endif // NEURAL_NETWORK_PARALLEL_TRAINER_H
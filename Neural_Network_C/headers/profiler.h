@@ -0,0 +1,165 @@
+/*
+ * Neural Network System - Profiler Header
+ * Per-layer forward/backward/update timing, FLOP, byte and allocation
+ * counters, network statistics and Chrome trace-event timeline export
+ */
+
+#ifndef NEURAL_NETWORK_PROFILER_H
+#define NEURAL_NETWORK_PROFILER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "neural_net.h"
+
+// ============================================================================
+// Profiler Configuration
+// ============================================================================
+
+#define PROFILER_DEFAULT_EVENTS 65536   // Timeline events kept by default
+#define PROFILER_LAYER_PHASES 3         // Forward, backward, update
+
+/**
+ * @brief What a timeline event measured
+ */
+typedef enum {
+    PROFILE_FORWARD,                // Layer forward pass
+    PROFILE_BACKWARD,               // Layer backward pass
+    PROFILE_UPDATE,                 // Optimizer update of the layer's parameters
+    PROFILE_STEP                    // Whole training step (layer = -1)
+} ProfilePhase;
+
+/**
+ * @brief One timed span on the timeline
+ */
+typedef struct {
+    int layer;                      // Layer index (-1 for step events)
+    ProfilePhase phase;             // What was measured
+    int thread;                     // Profiler thread id (0 = first thread seen)
+    int64_t step;                   // Training step the span belongs to
+    uint64_t start_ns;              // Start, relative to profiling start
+    uint64_t duration_ns;           // Wall time
+    uint64_t flops;                 // Floating-point operations (estimated from shapes)
+    uint64_t bytes;                 // Bytes read and written (compulsory traffic estimate)
+    uint64_t allocations;           // Tensor heap and arena allocations made during the span
+} ProfileEvent;
+
+/**
+ * @brief Accumulated counters of one layer
+ *
+ * FLOPs count the multiply-adds of the layer's GEMMs/convolutions as two
+ * operations (plus one per element for pooling and elementwise layers).
+ * Bytes are the tensors the call must touch at least once: input, output
+ * and parameters forward; incoming and outgoing gradients, cached input,
+ * parameters and their gradients backward; parameters, gradients and
+ * optimizer state for the update. Allocations come from the calling
+ * thread's tensor allocation counters (tensor_get_thread_alloc_stats).
+ */
+typedef struct {
+    char name[64];                              // Layer name
+    LayerType type;                             // Layer type
+    uint64_t calls[PROFILER_LAYER_PHASES];      // Calls per phase
+    uint64_t time_ns[PROFILER_LAYER_PHASES];    // Total wall time per phase
+    uint64_t flops[PROFILER_LAYER_PHASES];      // Total FLOPs per phase
+    uint64_t bytes[PROFILER_LAYER_PHASES];      // Total bytes per phase
+    uint64_t allocations[PROFILER_LAYER_PHASES]; // Total allocations per phase
+} LayerStats;
+
+/**
+ * @brief Network statistics filled by neural_network_get_stats
+ */
+typedef struct {
+    int num_layers;                 // Layers in the network
+    int parameters_count;           // Trainable parameters
+    float memory_usage;             // Planned peak training memory in MB
+    double training_time;           // Seconds spent in fit so far
+
+    bool profiling;                 // Whether the profiler is on (the fields below are 0 if not)
+    int64_t steps;                  // Training steps profiled
+    uint64_t step_time_ns;          // Total wall time of profiled steps
+    uint64_t last_step_ns;          // Wall time of the latest step
+    uint64_t events;                // Timeline events recorded
+    uint64_t dropped_events;        // Events that did not fit the timeline (counters still include them)
+    int slowest_layer;              // Layer with the most forward+backward+update time (-1 = none)
+    const LayerStats* layers;       // Per-layer counters (valid until the next call or profiling stops)
+} NetworkStats;
+
+// ============================================================================
+// Network Functions
+// ============================================================================
+
+/**
+ * @brief Start recording every layer call of a network
+ *
+ * Wraps each layer's current forward and backward, so enable it after
+ * quantization or mixed precision to time the converted kernels.
+ *
+ * @param net Network to profile
+ * @param max_events Timeline capacity (0 = PROFILER_DEFAULT_EVENTS)
+ * @return False on allocation failure
+ */
+bool neural_network_enable_profiling(NeuralNetwork* net, int max_events);
+
+/**
+ * @brief Record a replica's layer calls into another network's profiler
+ *
+ * Used by the parallel trainer so every replica's shard lands on the
+ * master's timeline (each worker thread gets its own track).
+ *
+ * @param replica Network with the same layers as source
+ * @param source Profiled network
+ * @return False on allocation failure or if source is not profiled
+ */
+bool neural_network_attach_profiler(NeuralNetwork* replica, NeuralNetwork* source);
+
+/**
+ * @brief Restore the layers' own forward/backward and release the profiler
+ * (called by neural_network_destroy)
+ */
+void neural_network_disable_profiling(NeuralNetwork* net);
+
+/**
+ * @brief Clear counters and the timeline, keeping profiling on
+ */
+void neural_network_reset_profile(NeuralNetwork* net);
+
+/**
+ * @brief Mark the start of a training step
+ */
+void neural_network_profile_step_begin(NeuralNetwork* net);
+
+/**
+ * @brief Mark the end of a training step and record its span
+ */
+void neural_network_profile_step_end(NeuralNetwork* net);
+
+/**
+ * @brief Optimizer update timed layer by layer
+ *
+ * Same update as optimizer_step; used in place of neural_network_update
+ * while profiling is on so each layer's update gets its own span.
+ *
+ * @param net Compiled network
+ */
+void neural_network_profile_update(NeuralNetwork* net);
+
+/**
+ * @brief Write the timeline as Chrome trace-event JSON
+ *
+ * Load the file in chrome://tracing or Perfetto. Layer calls are complete
+ * ("X") events named after the layer with the phase as category and the
+ * FLOP, byte and allocation counts as args; training steps span them on
+ * the same thread tracks.
+ *
+ * @param net Profiled network
+ * @param filename Output path
+ * @return False if profiling is off or the file cannot be written
+ */
+bool neural_network_export_trace(const NeuralNetwork* net, const char* filename);
+
+/**
+ * @brief Per-layer table: time per phase, share of the step, GFLOP/s, GB/s, allocations
+ */
+void neural_network_profile_summary(const NeuralNetwork* net, char* out, int max_length);
+
+#endif // NEURAL_NETWORK_PROFILER_H
@@ -0,0 +1,158 @@
+/*
+ * Neural Network System - Pruning Header
+ * Gradual magnitude pruning (unstructured, N:M and block) of dense layers
+ * during training, and sparse inference over the pruned weights
+ */
+
+#ifndef NEURAL_NETWORK_PRUNING_H
+#define NEURAL_NETWORK_PRUNING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "neural_net.h"
+#include "sparse_kernels.h"
+
+// ============================================================================
+// Pruning Configuration
+// ============================================================================
+
+#define PRUNING_MAX_GROUP 64            // Largest M of an N:M pattern
+#define PRUNING_BLOCKED_MIN_FILL 0.75f  // Block fill from which sparsify picks the blocked format
+
+/**
+ * @brief Which weights compete for removal
+ */
+typedef enum {
+    PRUNE_UNSTRUCTURED,             // Smallest |w| of the whole layer
+    PRUNE_N_M,                      // Keep the N largest |w| of every M consecutive inputs of a row
+    PRUNE_BLOCK                     // Smallest L2 norm SPARSE_BLOCK_ROWS x 1 blocks (blocked format)
+} PruningMethod;
+
+/**
+ * @brief Magnitude pruning schedule
+ *
+ * Sparsity follows the cubic schedule of Zhu & Gupta (2017): it stays 0
+ * before begin_step, rises as s_f * (1 - (1 - p)^3) with p the fraction
+ * of [begin_step, end_step] done, and holds at s_f afterwards. s_f is
+ * target_sparsity, or 1 - n / m for N:M, which ramps by keeping between
+ * m and n weights per group. Masks are recomputed every frequency steps
+ * (and once more at end_step) and stay fixed after end_step; masked
+ * weights are zeroed after every optimizer update in between.
+ */
+typedef struct {
+    PruningMethod method;           // Selection rule
+    float target_sparsity;          // Final fraction of zero weights (unstructured and block)
+    int n;                          // N:M weights kept per group
+    int m;                          // N:M group size (<= PRUNING_MAX_GROUP)
+    int64_t begin_step;             // First step that prunes
+    int64_t end_step;               // Step at which the final sparsity is reached
+    int64_t frequency;              // Steps between mask updates
+} PruningConfig;
+
+// ============================================================================
+// Pruning Functions
+// ============================================================================
+
+/**
+ * @brief 80% unstructured sparsity reached over steps 0..1000, masks every 100 steps
+ */
+PruningConfig pruning_config_default(void);
+
+/**
+ * @brief Scheduled sparsity at a training step
+ */
+float pruning_schedule_sparsity(const PruningConfig* config, int64_t step);
+
+/**
+ * @brief Zero the lowest-magnitude weights of one row-major matrix
+ *
+ * @param weights rows x cols values (output x input, like DenseData)
+ * @param rows Output rows
+ * @param cols Input columns
+ * @param method Selection rule
+ * @param sparsity Fraction to remove (N:M: kept per group is m - round(sparsity * m),
+ *                 at least n)
+ * @param n N:M weights kept per group (ignored otherwise)
+ * @param m N:M group size (ignored otherwise)
+ * @param mask Output keep mask (rows x cols, NULL = only zero the weights)
+ * @return False on allocation failure or invalid arguments
+ */
+bool prune_weights(float* weights, int rows, int cols, PruningMethod method, float sparsity,
+                   int n, int m, uint8_t* mask);
+
+// ============================================================================
+// Network Functions
+// ============================================================================
+
+/**
+ * @brief Prune the network's dense layers while it trains
+ *
+ * Once enabled, neural_network_train_step (and so neural_network_fit)
+ * calls neural_network_prune_step after every optimizer update. Parallel
+ * trainer replicas share the master's weights and need no state of their
+ * own.
+ *
+ * @param net Network with dense layers
+ * @param config Schedule
+ * @return False on allocation failure, invalid config or no dense layer
+ */
+bool neural_network_enable_pruning(NeuralNetwork* net, PruningConfig config);
+
+/**
+ * @brief Drop the masks, keeping the weights as pruned so far
+ * (called by neural_network_destroy)
+ */
+void neural_network_disable_pruning(NeuralNetwork* net);
+
+/**
+ * @brief Advance the schedule by one step
+ *
+ * Recomputes the masks on mask-update steps and re-zeroes the pruned
+ * weights, which the optimizer update may have moved.
+ *
+ * @param net Network with pruning enabled (no-op otherwise)
+ * @return False on allocation failure
+ */
+bool neural_network_prune_step(NeuralNetwork* net);
+
+/**
+ * @brief Training steps seen by the schedule
+ */
+int64_t neural_network_pruning_step(const NeuralNetwork* net);
+
+/**
+ * @brief Fraction of zero weights over all dense layers
+ */
+float neural_network_sparsity(const NeuralNetwork* net);
+
+/**
+ * @brief Run sufficiently sparse dense layers through sparse kernels
+ *
+ * Each dense layer whose weights are at least min_sparsity zero is
+ * compressed (blocked format if sparse_block_fill reaches
+ * PRUNING_BLOCKED_MIN_FILL, CSR otherwise) and its forward pointer is
+ * swapped for a sparse_matmul one, as quantize_layer does; the dense
+ * weights are kept for neural_network_densify. Works with
+ * neural_network_predict unchanged. Weights changed afterwards are not
+ * seen until the network is sparsified again, so do this after training
+ * (and before enabling profiling).
+ *
+ * @param net Network
+ * @param min_sparsity Sparsity from which a layer is converted
+ * @return Number of converted layers, -1 on allocation failure
+ */
+int neural_network_sparsify(NeuralNetwork* net, float min_sparsity);
+
+/**
+ * @brief Restore the dense forward of every sparsified layer
+ * (called by neural_network_destroy)
+ */
+void neural_network_densify(NeuralNetwork* net);
+
+/**
+ * @brief Bytes of the compressed weights of sparsified layers
+ */
+size_t neural_network_sparse_bytes(const NeuralNetwork* net);
+
+#endif // NEURAL_NETWORK_PRUNING_H
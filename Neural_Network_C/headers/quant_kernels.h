@@ -0,0 +1,245 @@
+/*
+ * Neural Network System - Int8 Kernels Header
+ * Activation range calibration, per-channel int8 weight packing and int8
+ * dense/conv kernels with int32 accumulation and runtime CPU dispatch
+ */
+
+#ifndef NEURAL_NETWORK_QUANT_KERNELS_H
+#define NEURAL_NETWORK_QUANT_KERNELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "dense_kernels.h"
+#include "conv_kernels.h"
+
+// ============================================================================
+// Int8 Configuration
+// ============================================================================
+
+#define QUANT_PANEL_ROWS 16         // Output channels per packed weight panel
+#define QUANT_GROUP 4               // Input bytes per 32-bit dot product lane
+#define QUANT_TILE_ROWS 64          // Samples/pixels quantized and multiplied per tile
+#define QUANT_ALIGNMENT 64          // Packed weight alignment in bytes
+
+/**
+ * @brief How activation ranges are derived from calibration data
+ */
+typedef enum {
+    QUANT_CALIBRATION_MINMAX,       // Observed minimum and maximum
+    QUANT_CALIBRATION_PERCENTILE    // Per-batch percentiles, averaged over batches
+} QuantCalibration;
+
+/**
+ * @brief Int8 micro-kernel implementations
+ */
+typedef enum {
+    QUANT_KERNEL_SCALAR,            // Portable C kernel
+    QUANT_KERNEL_AVX2,              // AVX2 widening multiply-add (pmaddwd)
+    QUANT_KERNEL_AVX512_VNNI        // AVX-512 VNNI u8 x s8 dot products (vpdpbusd)
+} QuantKernelType;
+
+/**
+ * @brief Int8 weight matrix packed for the int8 GEMM
+ *
+ * Weights are quantized symmetrically per output channel (row). Rows are
+ * grouped into panels of QUANT_PANEL_ROWS; within a panel each step holds
+ * QUANT_GROUP consecutive inputs of every row, which is the operand layout
+ * of one 32-bit lane of vpdpbusd.
+ */
+typedef struct {
+    int rows;                       // Output channels
+    int cols;                       // Inputs per channel
+    int padded_cols;                // cols rounded up to QUANT_GROUP
+    int8_t* data;                   // Packed panels (QUANT_ALIGNMENT aligned)
+    void* raw;                      // Allocation backing data
+    float* scales;                  // Per-row dequantization scale
+    int32_t* row_sums;              // Per-row sum of int8 weights
+} QuantizedWeights;
+
+/**
+ * @brief Complete int8 linear operator: quantize input, int8 GEMM, dequantize
+ *
+ * Inputs are quantized asymmetrically to uint8 with a calibrated scale and
+ * zero point, so a post-ReLU activation uses all 256 levels. The zero point
+ * correction and bias fold into one per-channel offset:
+ *   y[j] = acc[j] * output_scales[j] + output_offsets[j]
+ */
+typedef struct {
+    QuantizedWeights weights;       // Packed int8 weights
+    float input_scale;              // Real value of one input step
+    int input_zero_point;           // uint8 code of 0.0
+    float* output_scales;           // input_scale * weight scale per channel
+    float* output_offsets;          // Bias minus zero point correction per channel
+    GemmActivation activation;      // Fused elementwise activation
+    DenseActivationFn row_activation; // Row-wise activation (softmax), NULL if fused
+} QuantizedLinear;
+
+/**
+ * @brief Running activation range of one layer input during calibration
+ */
+typedef struct {
+    float min;                      // Smallest value seen
+    float max;                      // Largest value seen
+    double percentile_min_sum;      // Sum of per-batch low percentiles
+    double percentile_max_sum;      // Sum of per-batch high percentiles
+    int batches;                    // Batches observed
+} QuantRange;
+
+// ============================================================================
+// Calibration
+// ============================================================================
+
+/**
+ * @brief Clear a range before calibration
+ */
+void quant_range_reset(QuantRange* range);
+
+/**
+ * @brief Fold one calibration batch into a range
+ * @param range Range to update
+ * @param values Layer input values
+ * @param count Number of values
+ * @param method Estimator the range will be read with
+ * @param percentile Kept fraction for QUANT_CALIBRATION_PERCENTILE
+ */
+void quant_range_observe(QuantRange* range, const float* values, size_t count,
+                         QuantCalibration method, float percentile);
+
+/**
+ * @brief Final range for quantization
+ * @param range Observed range
+ * @param method Estimator to apply
+ * @param min_value Output minimum
+ * @param max_value Output maximum
+ * @return False if no batch was observed
+ */
+bool quant_range_get(const QuantRange* range, QuantCalibration method,
+                     float* min_value, float* max_value);
+
+// ============================================================================
+// Quantization Primitives
+// ============================================================================
+
+/**
+ * @brief Pack float weights into per-row symmetric int8 panels
+ * @param weights Output description
+ * @param data Float weights (rows x cols)
+ * @param rows Output channels
+ * @param cols Inputs per channel
+ * @return False on invalid size or allocation failure
+ */
+bool quant_weights_init(QuantizedWeights* weights, const float* data, int rows, int cols);
+
+/**
+ * @brief Free packed weights
+ */
+void quant_weights_free(QuantizedWeights* weights);
+
+/**
+ * @brief Asymmetric uint8 scale and zero point for a real range
+ *
+ * The range is widened to include 0.0 so zero padding quantizes exactly.
+ *
+ * @param min_value Smallest value to represent
+ * @param max_value Largest value to represent
+ * @param scale Output scale
+ * @param zero_point Output zero point (0..255)
+ */
+void quant_choose_params(float min_value, float max_value, float* scale, int* zero_point);
+
+/**
+ * @brief q = clamp(round(x / scale) + zero_point, 0, 255)
+ */
+void quant_quantize_u8(const float* x, uint8_t* q, size_t count, float scale, int zero_point);
+
+/**
+ * @brief Raw int8 GEMM: c = a * weights^T with int32 accumulation
+ * @param m Rows of A
+ * @param a uint8 rows of weights->padded_cols readable bytes each
+ * @param lda Row stride of A in bytes
+ * @param weights Packed weights (weights->rows output columns)
+ * @param c int32 output (m x weights->rows)
+ * @param ldc Row stride of C in elements
+ */
+void quant_gemm_u8s8(int m, const uint8_t* a, int lda, const QuantizedWeights* weights,
+                     int32_t* c, int ldc);
+
+// ============================================================================
+// Int8 Operators
+// ============================================================================
+
+/**
+ * @brief Build an int8 linear operator
+ * @param linear Output operator
+ * @param weights Float weights (rows x cols)
+ * @param rows Output channels
+ * @param cols Inputs per channel
+ * @param biases Per-channel bias (rows, NULL = none)
+ * @param input_min Calibrated input minimum
+ * @param input_max Calibrated input maximum
+ * @param activation Activation applied after dequantization (NULL = linear)
+ * @return False on allocation failure
+ */
+bool quant_linear_init(QuantizedLinear* linear, const float* weights, int rows, int cols,
+                       const float* biases, float input_min, float input_max,
+                       DenseActivationFn activation);
+
+/**
+ * @brief Free an int8 linear operator
+ */
+void quant_linear_free(QuantizedLinear* linear);
+
+/**
+ * @brief Bytes of parameter storage used by an int8 operator
+ */
+size_t quant_linear_bytes(const QuantizedLinear* linear);
+
+/**
+ * @brief Int8 dense forward: output = act(dequant(quant(input) * Wq^T))
+ * @param linear Operator (rows = output features)
+ * @param input Float input (batch x cols)
+ * @param batch Number of samples
+ * @param output Float output (batch x rows)
+ * @return False on invalid arguments
+ */
+bool quant_dense_forward(const QuantizedLinear* linear, const float* input, int batch,
+                         float* output);
+
+/**
+ * @brief Int8 convolution forward via uint8 im2col tiles
+ *
+ * Kernels are quantized from the (out, in, k, k) layout, so patch columns
+ * are ordered (channel, ky, kx) in both activation layouts. Fused pooling
+ * and row-wise activations are not supported.
+ *
+ * @param linear Operator (rows = out_channels, cols = in_channels * k * k)
+ * @param shape Convolution description (pool_size must be 0)
+ * @param input Float input feature maps in shape->layout
+ * @param output Float output feature maps in shape->layout
+ * @return False on shape mismatch or unsupported configuration
+ */
+bool quant_conv2d_forward(const QuantizedLinear* linear, const ConvShape* shape,
+                          const float* input, float* output);
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+/**
+ * @brief Get the int8 micro-kernel selected for this CPU
+ */
+QuantKernelType quant_get_kernel(void);
+
+/**
+ * @brief Force a specific int8 micro-kernel (benchmarking and testing)
+ * @return False if the CPU does not support the requested kernel
+ */
+bool quant_set_kernel(QuantKernelType type);
+
+/**
+ * @brief Get printable int8 kernel name
+ */
+const char* quant_kernel_name(QuantKernelType type);
+
+#endif // NEURAL_NETWORK_QUANT_KERNELS_H
@@ -0,0 +1,88 @@
+/*
+ * Neural Network System - Int8 Quantization Header
+ * Post-training quantization of trained networks: calibration over sample
+ * data, then dense and Conv2D layers switched to int8 forward passes
+ */
+
+#ifndef NEURAL_NETWORK_QUANTIZE_H
+#define NEURAL_NETWORK_QUANTIZE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "neural_net.h"
+#include "layers.h"
+#include "quant_kernels.h"
+
+// ============================================================================
+// Quantization Configuration
+// ============================================================================
+
+/**
+ * @brief Post-training quantization settings
+ */
+typedef struct {
+    QuantCalibration method;        // Activation range estimator
+    float percentile;               // Kept fraction for QUANT_CALIBRATION_PERCENTILE
+    int batch_size;                 // Calibration samples per forward pass
+    bool quantize_conv;             // Quantize Conv2D layers as well as dense layers
+} QuantizationConfig;
+
+/**
+ * @brief Default configuration: min/max calibration, batches of 64, conv enabled
+ */
+QuantizationConfig quantization_config_default(void);
+
+// ============================================================================
+// Network Quantization
+// ============================================================================
+
+/**
+ * @brief Quantize one dense or Conv2D layer in place
+ *
+ * The layer keeps its float parameters; its forward pointer is swapped for
+ * the int8 one and the original is kept in layer->quantized_data so
+ * quantize_layer_release can restore it.
+ *
+ * @param layer Dense or Conv2D layer
+ * @param input_min Calibrated input minimum
+ * @param input_max Calibrated input maximum
+ * @return False if the layer type or activation cannot be quantized
+ */
+bool quantize_layer(Layer* layer, float input_min, float input_max);
+
+/**
+ * @brief Drop a layer's int8 state and restore its float forward
+ */
+void quantize_layer_release(Layer* layer);
+
+/**
+ * @brief Post-training int8 quantization of a trained network
+ *
+ * Runs the float network over the calibration samples to record the input
+ * range of every dense (and optionally Conv2D) layer, then returns a copy in
+ * which those layers compute in int8. The copy works with
+ * neural_network_predict unchanged; layers that cannot be quantized (e.g.
+ * softmax convolutions, recurrent layers) stay in float.
+ *
+ * @param net Trained float network (not modified)
+ * @param calibration_x Representative inputs (samples along the first axis)
+ * @param config Calibration settings
+ * @return Quantized network or NULL on failure; release its int8 state with
+ *         neural_network_dequantize before neural_network_destroy
+ */
+NeuralNetwork* neural_network_quantize(NeuralNetwork* net, Tensor* calibration_x,
+                                       QuantizationConfig config);
+
+/**
+ * @brief Restore float forward passes on every quantized layer
+ * @param net Network returned by neural_network_quantize
+ */
+void neural_network_dequantize(NeuralNetwork* net);
+
+/**
+ * @brief Bytes of parameter storage, counting int8 layers at their packed size
+ * @param net Network (float or quantized)
+ */
+size_t neural_network_parameter_bytes(NeuralNetwork* net);
+
+#endif // NEURAL_NETWORK_QUANTIZE_H
@@ -0,0 +1,132 @@
+/*
+ * Neural Network System - Recurrent Kernels Header
+ * Sequence-batched LSTM and GRU: one GEMM for the input projection of every
+ * timestep, one recurrent GEMM plus a fused gate pass per timestep, and
+ * truncated backpropagation through time over a preallocated workspace
+ */
+
+#ifndef NEURAL_NETWORK_RNN_KERNELS_H
+#define NEURAL_NETWORK_RNN_KERNELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "neural_net.h"
+
+// ============================================================================
+// Recurrent Description
+// ============================================================================
+
+/**
+ * @brief Recurrent cell type
+ *
+ * Gate blocks are stacked along the rows of the weight matrices:
+ * LSTM i, f, g, o (input_weights 4H x input, hidden_weights 4H x H,
+ * biases 4H); GRU z, r, n (3H x input, 3H x H, 3H). The GRU candidate is
+ * n = tanh(W_in x + b_n + r * (W_hn h)), i.e. the reset gate is applied
+ * after the recurrent product, which keeps that product a single GEMM.
+ */
+typedef enum {
+    RNN_CELL_LSTM,              // Long short-term memory
+    RNN_CELL_GRU                // Gated recurrent unit
+} RnnCell;
+
+/**
+ * @brief Full description of one recurrent call
+ */
+typedef struct {
+    RnnCell cell;               // Cell type
+    int batch;                  // Sequences per call
+    int steps;                  // Timesteps per sequence
+    int input_size;             // Input features per timestep
+    int hidden_size;            // Hidden units (H)
+    int bptt_steps;             // Truncation window for backward (0 = full sequence)
+} RnnShape;
+
+/**
+ * @brief Gate blocks per cell (4 for LSTM, 3 for GRU)
+ */
+int rnn_gate_count(RnnCell cell);
+
+/**
+ * @brief Floats of workspace needed by rnn_forward and rnn_backward
+ *
+ * The workspace holds the activated gates of every timestep and the hidden
+ * (and cell) state sequence, so it grows with batch * steps. Allocate it
+ * once for the longest sequence and reuse it across calls.
+ *
+ * @return Number of floats, 0 if the shape is invalid
+ */
+size_t rnn_workspace_size(const RnnShape* shape);
+
+// ============================================================================
+// Forward and Backward
+// ============================================================================
+
+/**
+ * @brief Recurrent forward over a batch of sequences
+ *
+ * The input projection of all batch * steps rows (plus bias) is one GEMM
+ * written straight into the gate buffer. Each timestep then runs one
+ * batch x gates*H GEMM against the previous hidden state, followed by a
+ * single pass that applies the gate nonlinearities and the cell/hidden
+ * update for the whole batch.
+ *
+ * @param shape Recurrent description
+ * @param input Input sequences (batch x steps x input_size)
+ * @param input_weights Input weights (gates*H x input_size)
+ * @param hidden_weights Recurrent weights (gates*H x H)
+ * @param biases Gate biases (gates*H, NULL = none)
+ * @param initial_hidden Hidden state before the first step (batch x H, NULL = zeros)
+ * @param initial_cell LSTM cell state before the first step (batch x H, NULL = zeros)
+ * @param return_sequences Output every timestep instead of the last one
+ * @param output batch x steps x H, or batch x H without return_sequences
+ * @param workspace rnn_workspace_size floats; keeps the state rnn_backward needs
+ * @return False on shape mismatch, missing workspace or out of memory
+ */
+bool rnn_forward(const RnnShape* shape, const Tensor* input, const Tensor* input_weights,
+                 const Tensor* hidden_weights, const Tensor* biases,
+                 const float* initial_hidden, const float* initial_cell,
+                 bool return_sequences, Tensor* output, float* workspace);
+
+/**
+ * @brief Truncated backpropagation through time
+ *
+ * Walks the timesteps in reverse over the workspace of the matching
+ * rnn_forward, turning the saved gates into gate deltas in place. The
+ * gradient carried to the previous timestep is cut at every bptt_steps
+ * boundary (counted from the first step), so no recurrent GEMM runs there.
+ * The weight, bias and input gradients are then a handful of large GEMMs
+ * over all timesteps at once. Consumes the forward state: call at most
+ * once per forward.
+ *
+ * @param shape Recurrent description (as passed to rnn_forward)
+ * @param input Forward input
+ * @param input_weights Input weights
+ * @param hidden_weights Recurrent weights
+ * @param grad_output Gradient w.r.t. the forward output
+ * @param return_sequences As passed to rnn_forward
+ * @param input_weight_gradients Input weight gradient (gates*H x input_size)
+ * @param hidden_weight_gradients Recurrent weight gradient (gates*H x H)
+ * @param bias_gradients Bias gradient (gates*H, NULL = skip)
+ * @param grad_input Gradient w.r.t. input (NULL = skip)
+ * @param accumulate Add to existing parameter gradients instead of overwriting
+ * @param workspace Workspace of the matching rnn_forward
+ * @return False on shape mismatch, missing workspace or out of memory
+ */
+bool rnn_backward(const RnnShape* shape, const Tensor* input, const Tensor* input_weights,
+                  const Tensor* hidden_weights, const Tensor* grad_output, bool return_sequences,
+                  Tensor* input_weight_gradients, Tensor* hidden_weight_gradients,
+                  Tensor* bias_gradients, Tensor* grad_input, bool accumulate, float* workspace);
+
+/**
+ * @brief State after the last timestep of the preceding rnn_forward
+ *
+ * Feeding it to the next call as the initial state carries the sequence
+ * across calls (stateful truncated BPTT over long streams).
+ *
+ * @param hidden Final hidden state (batch x H, NULL = skip)
+ * @param cell Final LSTM cell state (batch x H, NULL = skip; ignored for GRU)
+ */
+void rnn_final_state(const RnnShape* shape, const float* workspace, float* hidden, float* cell);
+
+#endif // NEURAL_NETWORK_RNN_KERNELS_H
@@ -0,0 +1,142 @@
+/*
+ * Neural Network System - Sparse Kernels Header
+ * Compressed sparse weight formats (CSR and row-blocked) and sparse weight
+ * x dense activation products with scalar and AVX-512 kernels
+ */
+
+#ifndef NEURAL_NETWORK_SPARSE_KERNELS_H
+#define NEURAL_NETWORK_SPARSE_KERNELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "gemm.h"
+
+// ============================================================================
+// Sparse Configuration
+// ============================================================================
+
+#define SPARSE_BATCH_TILE 32        // Samples per transposed activation tile (two 16-lane vectors)
+#define SPARSE_CHUNK_COLS 256       // Inputs per column chunk (a tile chunk stays in L1)
+#define SPARSE_BLOCK_ROWS 4         // Output rows sharing one column index in the blocked format
+#define SPARSE_GATHER_MAX_ROWS 4    // Batches up to this size use the row-wise gather kernel
+
+/**
+ * @brief Storage format of a sparse weight matrix
+ */
+typedef enum {
+    SPARSE_FORMAT_CSR,              // One column index per nonzero
+    SPARSE_FORMAT_BLOCKED           // One column index per SPARSE_BLOCK_ROWS x 1 block
+} SparseFormat;
+
+/**
+ * @brief Sparse kernel implementations
+ */
+typedef enum {
+    SPARSE_KERNEL_SCALAR,           // Portable C kernel
+    SPARSE_KERNEL_AVX512            // AVX-512F broadcast-FMA tiles and gathers
+} SparseKernelType;
+
+/**
+ * @brief Sparse rows x cols weight matrix (output x input, like DenseData)
+ *
+ * Entries are ordered by column chunk, then row group, then column, so the
+ * product walks one SPARSE_CHUNK_COLS slice of the activations at a time.
+ * A row group is one row (CSR) or SPARSE_BLOCK_ROWS rows (blocked). The
+ * entries of chunk c and group g are [group_ptr[c * groups + g],
+ * group_ptr[c * groups + g + 1]). A blocked entry stores SPARSE_BLOCK_ROWS
+ * values, one per row of its group, zero where that row has no weight.
+ */
+typedef struct {
+    SparseFormat format;            // Storage format
+    int rows;                       // Output rows
+    int cols;                       // Input columns
+    int chunks;                     // Column chunks
+    int groups;                     // Row groups
+    int entries;                    // Stored column indices
+    int nonzeros;                   // Nonzero weights
+    int* group_ptr;                 // chunks * groups + 1 entry offsets
+    int* col_index;                 // Column of each entry
+    float* values;                  // entries (CSR) or entries * SPARSE_BLOCK_ROWS (blocked)
+} SparseMatrix;
+
+// ============================================================================
+// Sparse Matrices
+// ============================================================================
+
+/**
+ * @brief Compress a dense row-major matrix, dropping exact zeros
+ * @param matrix Output (free with sparse_matrix_free)
+ * @param dense Row-major rows x cols values
+ * @param rows Output rows
+ * @param cols Input columns
+ * @param format Storage format
+ * @return False on allocation failure or invalid shape
+ */
+bool sparse_matrix_from_dense(SparseMatrix* matrix, const float* dense, int rows, int cols,
+                              SparseFormat format);
+
+/**
+ * @brief Release a sparse matrix
+ */
+void sparse_matrix_free(SparseMatrix* matrix);
+
+/**
+ * @brief Bytes of index and value storage
+ */
+size_t sparse_matrix_bytes(const SparseMatrix* matrix);
+
+/**
+ * @brief Fraction of zero weights in a dense matrix
+ */
+float sparse_dense_sparsity(const float* dense, int rows, int cols);
+
+/**
+ * @brief Fraction of nonzero values inside the blocks the blocked format would store
+ *
+ * 1.0 for block-pruned weights; close to 1 - sparsity for unstructured ones.
+ */
+float sparse_block_fill(const float* dense, int rows, int cols);
+
+// ============================================================================
+// Sparse Products
+// ============================================================================
+
+/**
+ * @brief Y = act(X * W^T + bias) with sparse W
+ *
+ * Batches above SPARSE_GATHER_MAX_ROWS are transposed into tiles of
+ * SPARSE_BATCH_TILE samples so every stored weight becomes one broadcast
+ * FMA over the tile; smaller batches gather the inputs of each row.
+ *
+ * @param x Row-major m x cols activations
+ * @param m Samples
+ * @param w Sparse weights (rows x cols)
+ * @param y Row-major m x rows output
+ * @param ldy Row stride of Y
+ * @param epilogue Bias and activation (NULL = none)
+ * @return False on allocation failure
+ */
+bool sparse_matmul(const float* x, int m, const SparseMatrix* w, float* y, int ldy,
+                   const GemmEpilogue* epilogue);
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+/**
+ * @brief Kernel used by sparse_matmul (best supported by the CPU by default)
+ */
+SparseKernelType sparse_get_kernel(void);
+
+/**
+ * @brief Force a kernel (for testing and benchmarking)
+ * @return False if the CPU does not support it
+ */
+bool sparse_set_kernel(SparseKernelType type);
+
+/**
+ * @brief Human-readable kernel name
+ */
+const char* sparse_kernel_name(SparseKernelType type);
+
+#endif // NEURAL_NETWORK_SPARSE_KERNELS_H
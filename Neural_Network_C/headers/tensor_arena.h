@@ -0,0 +1,141 @@
+/*
+ * Neural Network System - Tensor Arena Header
+ * Bump allocator for per-step tensor temporaries and allocation counters
+ */
+
+#ifndef NEURAL_NETWORK_TENSOR_ARENA_H
+#define NEURAL_NETWORK_TENSOR_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TENSOR_ARENA_ALIGNMENT 64           // Alignment of every arena block
+#define TENSOR_ARENA_DEFAULT_CHUNK (1 << 20) // Minimum chunk size in bytes
+
+/**
+ * @brief One contiguous block of arena memory
+ */
+typedef struct TensorArenaChunk {
+    char* base;                         // Aligned start of usable memory
+    void* raw;                          // Pointer returned by malloc
+    size_t capacity;                    // Usable bytes
+    size_t used;                        // Bytes handed out since last reset
+    struct TensorArenaChunk* next;      // Next chunk
+} TensorArenaChunk;
+
+/**
+ * @brief Bump allocator whose contents are released all at once
+ *
+ * Chunks are never returned to the heap before tensor_arena_destroy, so
+ * after the first few steps have sized the arena, allocation is a pointer
+ * bump and reset is O(chunks). Tensors created while an arena is active are
+ * owned by it (Tensor.arena_owned): tensor_destroy on them is a no-op. A
+ * reset recycles their headers, so drop references to them before it.
+ */
+typedef struct TensorArena {
+    TensorArenaChunk* chunks;           // Chunk list (first chunk is largest)
+    TensorArenaChunk* current;          // Chunk currently being bumped
+    size_t chunk_size;                  // Minimum size of new chunks
+    size_t used;                        // Bytes allocated since last reset
+    size_t peak;                        // Maximum bytes used in any step
+} TensorArena;
+
+/**
+ * @brief Tensor allocation counters (process wide)
+ */
+typedef struct {
+    uint64_t tensors_created;           // Tensors created (heap or arena)
+    uint64_t heap_allocations;          // malloc/calloc calls for tensors and arena chunks
+    uint64_t heap_bytes;                // Bytes requested from the heap
+    uint64_t heap_frees;                // Tensor blocks returned to the heap
+    uint64_t arena_allocations;         // Blocks served from an arena
+    uint64_t arena_bytes;               // Bytes served from arenas
+} TensorAllocStats;
+
+// ============================================================================
+// Arena Management
+// ============================================================================
+
+/**
+ * @brief Create an arena
+ * @param initial_bytes Size of the first chunk (0 = default)
+ * @return Created arena or NULL on failure
+ */
+TensorArena* tensor_arena_create(size_t initial_bytes);
+
+/**
+ * @brief Destroy an arena and release all its chunks
+ * @param arena Arena to destroy (must not be active on any thread)
+ */
+void tensor_arena_destroy(TensorArena* arena);
+
+/**
+ * @brief Allocate an aligned block from an arena
+ * @param arena Target arena
+ * @param bytes Block size
+ * @return Block pointer or NULL on failure
+ */
+void* tensor_arena_alloc(TensorArena* arena, size_t bytes);
+
+/**
+ * @brief Release every block allocated since the last reset
+ * @param arena Arena to reset
+ */
+void tensor_arena_reset(TensorArena* arena);
+
+/**
+ * @brief Make an arena the allocation target for this thread
+ * @param arena Arena to activate (NULL restores heap allocation)
+ * @return Previously active arena, for restoring
+ */
+TensorArena* tensor_arena_activate(TensorArena* arena);
+
+/**
+ * @brief Get the arena active on this thread
+ * @return Active arena or NULL
+ */
+TensorArena* tensor_arena_active(void);
+
+// ============================================================================
+// Allocation Counters
+// ============================================================================
+
+/**
+ * @brief Get a snapshot of the allocation counters
+ * @param stats Output statistics
+ */
+void tensor_get_alloc_stats(TensorAllocStats* stats);
+
+/**
+ * @brief Get the counters of allocations made by the calling thread
+ *
+ * Not affected by tensor_reset_alloc_stats; take differences of two
+ * snapshots (the profiler does this around each layer call).
+ *
+ * @param stats Output statistics
+ */
+void tensor_get_thread_alloc_stats(TensorAllocStats* stats);
+
+/**
+ * @brief Reset all allocation counters to zero
+ */
+void tensor_reset_alloc_stats(void);
+
+/**
+ * @brief Record heap allocation (used by tensor code)
+ * @param bytes Bytes requested
+ */
+void tensor_stats_heap_alloc(size_t bytes);
+
+/**
+ * @brief Record a heap free (used by tensor code)
+ */
+void tensor_stats_heap_free(void);
+
+/**
+ * @brief Record tensor creation (used by tensor code)
+ */
+void tensor_stats_tensor_created(void);
+
+#endif // NEURAL_NETWORK_TENSOR_ARENA_H
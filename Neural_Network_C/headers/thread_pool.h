@@ -0,0 +1,80 @@
+/*
+ * Neural Network System - Thread Pool Header
+ * Persistent worker pool used for data-parallel training and
+ * multi-threaded kernels
+ */
+
+#ifndef NEURAL_NETWORK_THREAD_POOL_H
+#define NEURAL_NETWORK_THREAD_POOL_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Opaque persistent thread pool
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief Parallel task body
+ * @param context User context shared by all tasks
+ * @param index Task index in [0, count)
+ * @param thread_id Executing thread in [0, thread_pool_size)
+ */
+typedef void (*ThreadPoolTask)(void* context, int index, int thread_id);
+
+/**
+ * @brief Create a thread pool
+ * @param num_threads Total threads including the caller (0 = all cores)
+ * @return Created pool or NULL on failure
+ */
+ThreadPool* thread_pool_create(int num_threads);
+
+/**
+ * @brief Stop workers and destroy the pool
+ * @param pool Pool to destroy
+ */
+void thread_pool_destroy(ThreadPool* pool);
+
+/**
+ * @brief Get number of threads (workers plus the calling thread)
+ * @param pool Thread pool (NULL counts as one thread)
+ * @return Thread count
+ */
+int thread_pool_size(ThreadPool* pool);
+
+/**
+ * @brief Run task(context, i, thread) for every i in [0, count) and wait
+ * @param pool Thread pool (NULL runs serially on the caller)
+ * @param count Number of tasks
+ * @param task Task body
+ * @param context User context passed to every task
+ * @note Calls made from inside a pool task run serially, so kernels that
+ *       parallelize internally can be used safely from parallel regions.
+ */
+void thread_pool_parallel_for(ThreadPool* pool, int count, ThreadPoolTask task, void* context);
+
+/**
+ * @brief Check whether the calling thread is executing a pool task
+ * @return True inside a parallel region
+ */
+bool thread_pool_in_parallel_region(void);
+
+/**
+ * @brief Get number of online CPU cores
+ * @return Core count (at least 1)
+ */
+int thread_pool_hardware_threads(void);
+
+/**
+ * @brief Restrict the calling thread to cores [first_core, first_core + count)
+ *
+ * Core indices wrap around the online core count. Threads created
+ * afterwards by this thread (e.g. a pool's workers) inherit the set.
+ *
+ * @param first_core First core of the subset
+ * @param count Cores in the subset
+ * @return False if pinning is unsupported on this platform or was refused
+ */
+bool thread_pool_pin_current_thread(int first_core, int count);
+
+#endif // NEURAL_NETWORK_THREAD_POOL_H
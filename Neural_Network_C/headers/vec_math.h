@@ -0,0 +1,319 @@
+/*
+ * Neural Network System - Vectorized Math Header
+ * Polynomial exp/log/tanh with bounded ULP error in scalar, AVX2 and
+ * AVX-512 form, and the transcendental activations built on them
+ */
+
+#ifndef NEURAL_NETWORK_VEC_MATH_H
+#define NEURAL_NETWORK_VEC_MATH_H
+
+#include <stdbool.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VEC_MATH_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+/**
+ * @brief Instruction set used by the array functions
+ */
+typedef enum {
+    VEC_MATH_SCALAR,            // Portable C, one element at a time
+    VEC_MATH_AVX2,              // AVX2 + FMA, 8 lanes
+    VEC_MATH_AVX512             // AVX-512F, 16 lanes
+} VecMathKernel;
+
+/**
+ * @brief Kernel selected for this CPU (the widest supported)
+ */
+VecMathKernel vec_math_get_kernel(void);
+
+/**
+ * @brief Force a kernel (accuracy testing and benchmarking)
+ * @return False if the CPU does not support it
+ */
+bool vec_math_set_kernel(VecMathKernel kernel);
+
+/**
+ * @brief Printable kernel name
+ */
+const char* vec_math_kernel_name(VecMathKernel kernel);
+
+// ============================================================================
+// Scalar Functions
+// ============================================================================
+
+// Same algorithms as the vector kernels, so results do not depend on where
+// an element falls in an array. Maximum errors against the correctly
+// rounded result: exp 2 ulp, log 2 ulp, tanh 3 ulp, sigmoid 4 ulp.
+
+float vec_math_expf(float x);
+float vec_math_logf(float x);
+float vec_math_tanhf(float x);
+float vec_math_sigmoidf(float x);
+
+// ============================================================================
+// Array Functions
+// ============================================================================
+
+// All array functions work in place with the ActivationFunction signature
+// (see activations.h) and dispatch on vec_math_get_kernel().
+
+/**
+ * @brief x = e^x (overflows to +inf above 88.72, flushes to 0 below -103.97)
+ */
+void vec_math_exp(float* x, int size);
+
+/**
+ * @brief x = ln(x) (-inf at 0, NaN below 0; subnormal inputs are exact)
+ */
+void vec_math_log(float* x, int size);
+
+/**
+ * @brief x = tanh(x)
+ */
+void vec_math_tanh(float* x, int size);
+
+/**
+ * @brief x = 1 / (1 + e^-x), computed as e^x / (1 + e^x) for x < 0 so the
+ *        negative tail keeps full relative precision
+ */
+void vec_math_sigmoid(float* x, int size);
+
+/**
+ * @brief x = x * sigmoid(x)
+ */
+void vec_math_swish(float* x, int size);
+
+/**
+ * @brief GELU, tanh form: 0.5 x (1 + tanh(sqrt(2/pi) (x + 0.044715 x^3)))
+ *
+ * Evaluated as x * sigmoid(2u), which is the same function without the
+ * cancellation of 1 + tanh(u) for negative inputs.
+ */
+void vec_math_gelu(float* x, int size);
+
+/**
+ * @brief Mish: x * tanh(ln(1 + e^x)), as x * n / (n + 2) with n = e^x (e^x + 2)
+ */
+void vec_math_mish(float* x, int size);
+
+/**
+ * @brief Numerically stable softmax of one row
+ */
+void vec_math_softmax(float* x, int size);
+
+// ============================================================================
+// Inline Vector Primitives
+// ============================================================================
+
+// Building blocks for kernels that fuse transcendentals with other work
+// (e.g. the recurrent gate passes). Callers need a matching target attribute.
+
+#define VEC_MATH_EXP_HI 88.7228394f         // Largest x with finite e^x
+#define VEC_MATH_EXP_LO -103.972076f        // Below this e^x rounds to 0
+#define VEC_MATH_LOG2E 1.44269504088896341f
+#define VEC_MATH_LN2_HI 0.693359375f        // ln 2 split for exact n * ln2_hi
+#define VEC_MATH_LN2_LO -2.12194440e-4f
+#define VEC_MATH_SQRT_HALF 0.707106781186547524f
+#define VEC_MATH_TANH_SMALL 0.625f          // Odd polynomial below, exp form above
+
+#ifdef VEC_MATH_HAVE_X86
+
+// e^r on |r| <= ln2/2 (Cephes expf coefficients)
+#define VEC_MATH_EXP_POLY(mul, fma, set, r)                                        \
+    fma(fma(fma(fma(fma(fma(set(1.9875691500e-4f), r, set(1.3981999507e-3f)), r,  \
+    set(8.3334519073e-3f)), r, set(4.1665795894e-2f)), r, set(1.6666665459e-1f)),  \
+    r, set(5.0000001201e-1f)), mul(r, r), r)
+
+__attribute__((target("avx512f")))
+static inline __m512 vec_math_exp_zmm(__m512 x) {
+    __m512 lo = _mm512_set1_ps(VEC_MATH_EXP_LO);
+    __mmask16 underflow = _mm512_cmp_ps_mask(x, lo, _CMP_LT_OQ);
+    x = _mm512_max_ps(lo, _mm512_min_ps(_mm512_set1_ps(VEC_MATH_EXP_HI + 1.0f), x));
+
+    __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(VEC_MATH_LOG2E)),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(VEC_MATH_LN2_HI), x);
+    r = _mm512_fnmadd_ps(n, _mm512_set1_ps(VEC_MATH_LN2_LO), r);
+    __m512 p = _mm512_add_ps(VEC_MATH_EXP_POLY(_mm512_mul_ps, _mm512_fmadd_ps, _mm512_set1_ps, r),
+                             _mm512_set1_ps(1.0f));
+
+    // vscalefps rounds once into the subnormal range and saturates to inf
+    return _mm512_mask_mov_ps(_mm512_scalef_ps(p, n), underflow, _mm512_setzero_ps());
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 vec_math_log_zmm(__m512 x) {
+    __m512 one = _mm512_set1_ps(1.0f);
+
+    // x = m * 2^e with m in [0.5, 1); getexp/getmant also normalize subnormals
+    __m512 m = _mm512_getmant_ps(x, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_zero);
+    __m512 e = _mm512_add_ps(_mm512_getexp_ps(x), one);
+    __mmask16 low = _mm512_cmp_ps_mask(m, _mm512_set1_ps(VEC_MATH_SQRT_HALF), _CMP_LT_OQ);
+    e = _mm512_mask_sub_ps(e, low, e, one);
+    __m512 f = _mm512_sub_ps(_mm512_mask_add_ps(m, low, m, m), one);
+
+    __m512 z = _mm512_mul_ps(f, f);
+    __m512 y = _mm512_set1_ps(7.0376836292e-2f);
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(-1.1514610310e-1f));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(1.1676998740e-1f));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(-1.2420140846e-1f));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(1.4249322787e-1f));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(-1.6668057665e-1f));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(2.0000714765e-1f));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(-2.4999993993e-1f));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(3.3333331174e-1f));
+    y = _mm512_mul_ps(_mm512_mul_ps(y, f), z);
+    y = _mm512_fmadd_ps(e, _mm512_set1_ps(VEC_MATH_LN2_LO), y);
+    y = _mm512_fnmadd_ps(_mm512_set1_ps(0.5f), z, y);
+    __m512 result = _mm512_fmadd_ps(e, _mm512_set1_ps(VEC_MATH_LN2_HI), _mm512_add_ps(f, y));
+
+    // Special inputs: 0 -> -inf, negative -> NaN, +inf and NaN pass through
+    __m512 zero = _mm512_setzero_ps();
+    result = _mm512_mask_mov_ps(result, _mm512_cmp_ps_mask(x, zero, _CMP_EQ_OQ),
+                                _mm512_set1_ps(-__builtin_inff()));
+    result = _mm512_mask_mov_ps(result, _mm512_cmp_ps_mask(x, zero, _CMP_LT_OQ), _mm512_set1_ps(__builtin_nanf("")));
+    __mmask16 passthrough = _mm512_cmp_ps_mask(x, _mm512_set1_ps(__builtin_inff()), _CMP_EQ_OQ) |
+                            _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+    return _mm512_mask_mov_ps(result, passthrough, x);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 vec_math_tanh_zmm(__m512 x) {
+    __m512 one = _mm512_set1_ps(1.0f);
+    __m512 ax = _mm512_abs_ps(x);
+
+    // |x| < 0.625: x + x^3 P(x^2) (Cephes tanhf)
+    __m512 z = _mm512_mul_ps(x, x);
+    __m512 p = _mm512_set1_ps(-5.70498872745e-3f);
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(2.06390887954e-2f));
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(-5.37397155531e-2f));
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(1.33314422036e-1f));
+    p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(-3.33332819422e-1f));
+    __m512 small = _mm512_fmadd_ps(_mm512_mul_ps(p, z), ax, ax);
+
+    // Otherwise 1 - 2 / (e^2|x| + 1); both branches on |x|, sign restored last
+    __m512 e = vec_math_exp_zmm(_mm512_add_ps(ax, ax));
+    __m512 large = _mm512_sub_ps(one, _mm512_div_ps(_mm512_set1_ps(2.0f), _mm512_add_ps(e, one)));
+
+    __mmask16 is_small = _mm512_cmp_ps_mask(ax, _mm512_set1_ps(VEC_MATH_TANH_SMALL), _CMP_LT_OQ);
+    __m512 t = _mm512_mask_mov_ps(large, is_small, small);
+    return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(t),
+        _mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32((int)0x80000000u))));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 vec_math_sigmoid_zmm(__m512 x) {
+    __m512 e = vec_math_exp_zmm(_mm512_sub_ps(_mm512_setzero_ps(), _mm512_abs_ps(x)));
+    __m512 s = _mm512_div_ps(_mm512_set1_ps(1.0f), _mm512_add_ps(_mm512_set1_ps(1.0f), e));
+    __mmask16 negative = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+    return _mm512_mask_mul_ps(s, negative, s, e);
+}
+
+/**
+ * @brief 2^n for integral n in [-252, 254], as two exponent-field halves
+ */
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_scale_ymm(__m256 p, __m256 n) {
+    __m256i ni = _mm256_cvtps_epi32(n);
+    __m256i half = _mm256_srai_epi32(ni, 1);
+    __m256i bias = _mm256_set1_epi32(127);
+    __m256 a = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(half, bias), 23));
+    __m256 b = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(ni, half), bias), 23));
+    return _mm256_mul_ps(_mm256_mul_ps(p, a), b);
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_exp_ymm(__m256 x) {
+    __m256 lo = _mm256_set1_ps(VEC_MATH_EXP_LO);
+    __m256 underflow = _mm256_cmp_ps(x, lo, _CMP_LT_OQ);
+    x = _mm256_max_ps(lo, _mm256_min_ps(_mm256_set1_ps(VEC_MATH_EXP_HI + 1.0f), x));
+
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(VEC_MATH_LOG2E)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(VEC_MATH_LN2_HI), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(VEC_MATH_LN2_LO), r);
+    __m256 p = _mm256_add_ps(VEC_MATH_EXP_POLY(_mm256_mul_ps, _mm256_fmadd_ps, _mm256_set1_ps, r),
+                             _mm256_set1_ps(1.0f));
+
+    return _mm256_andnot_ps(underflow, vec_math_scale_ymm(p, n));
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_log_ymm(__m256 x) {
+    __m256 one = _mm256_set1_ps(1.0f);
+
+    // Subnormals are scaled into the normal range first
+    __m256 tiny = _mm256_cmp_ps(x, _mm256_set1_ps(1.17549435e-38f), _CMP_LT_OQ);
+    __m256 v = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(8388608.0f)), tiny);
+    __m256i bits = _mm256_castps_si256(v);
+
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    e = _mm256_sub_ps(e, _mm256_and_ps(tiny, _mm256_set1_ps(23.0f)));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)),
+                                                   _mm256_set1_epi32(0x3F000000)));
+
+    __m256 low = _mm256_cmp_ps(m, _mm256_set1_ps(VEC_MATH_SQRT_HALF), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(low, one));
+    __m256 f = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(low, m)), one);
+
+    __m256 z = _mm256_mul_ps(f, f);
+    __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(-1.1514610310e-1f));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(1.1676998740e-1f));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(-1.2420140846e-1f));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(1.4249322787e-1f));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(-1.6668057665e-1f));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(2.0000714765e-1f));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(-2.4999993993e-1f));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(3.3333331174e-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, f), z);
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(VEC_MATH_LN2_LO), y);
+    y = _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, y);
+    __m256 result = _mm256_fmadd_ps(e, _mm256_set1_ps(VEC_MATH_LN2_HI), _mm256_add_ps(f, y));
+
+    __m256 zero = _mm256_setzero_ps();
+    result = _mm256_blendv_ps(result, _mm256_set1_ps(-__builtin_inff()), _mm256_cmp_ps(x, zero, _CMP_EQ_OQ));
+    result = _mm256_blendv_ps(result, _mm256_set1_ps(__builtin_nanf("")), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    __m256 passthrough = _mm256_or_ps(_mm256_cmp_ps(x, _mm256_set1_ps(__builtin_inff()), _CMP_EQ_OQ),
+                                      _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+    return _mm256_blendv_ps(result, x, passthrough);
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_tanh_ymm(__m256 x) {
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 ax = _mm256_andnot_ps(sign, x);
+
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(2.06390887954e-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-5.37397155531e-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.33314422036e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33332819422e-1f));
+    __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, z), ax, ax);
+
+    __m256 e = vec_math_exp_ymm(_mm256_add_ps(ax, ax));
+    __m256 large = _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, one)));
+
+    __m256 t = _mm256_blendv_ps(large, small, _mm256_cmp_ps(ax, _mm256_set1_ps(VEC_MATH_TANH_SMALL), _CMP_LT_OQ));
+    return _mm256_or_ps(t, _mm256_and_ps(sign, x));
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_sigmoid_ymm(__m256 x) {
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 e = vec_math_exp_ymm(_mm256_or_ps(x, _mm256_set1_ps(-0.0f)));     // e^-|x|
+    __m256 s = _mm256_div_ps(one, _mm256_add_ps(one, e));
+    return _mm256_blendv_ps(s, _mm256_mul_ps(s, e), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+}
+
+#endif // VEC_MATH_HAVE_X86
+
+#endif // NEURAL_NETWORK_VEC_MATH_H
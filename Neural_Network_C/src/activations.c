@@ -0,0 +1,324 @@
+/*
+ * Neural Network System - Activation Functions Implementation
+ * Element-wise activations, their derivatives and lookup by name
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/activations.h"
+#include "../headers/vec_math.h"
+
+#define ACTIVATION_LEAKY_SLOPE 0.01f        // Matches GEMM_LEAKY_RELU_SLOPE
+#define ACTIVATION_ELU_ALPHA 1.0f
+#define ACTIVATION_SELU_ALPHA 1.6732632423543772f
+#define ACTIVATION_SELU_SCALE 1.0507009873554805f
+#define ACTIVATION_DERIVATIVE_BLOCK 256     // Stack block for activation_compute_derivative
+
+/**
+ * @brief Activation lookup table entry
+ */
+typedef struct {
+    const char* name;
+    ActivationFunction function;
+    ActivationDerivative derivative;
+} ActivationEntry;
+
+static const ActivationEntry activation_table[] = {
+    { "linear", activation_linear, activation_linear_derivative },
+    { "relu", activation_relu, activation_relu_derivative },
+    { "leaky_relu", activation_leaky_relu, activation_leaky_relu_derivative },
+    { "sigmoid", activation_sigmoid, activation_sigmoid_derivative },
+    { "tanh", activation_tanh, activation_tanh_derivative },
+    { "softmax", activation_softmax, activation_softmax_derivative },
+    { "elu", activation_elu, activation_elu_derivative },
+    { "swish", activation_swish, activation_swish_derivative },
+    { "gelu", activation_gelu, NULL },
+    { "selu", activation_selu, NULL },
+    { "mish", activation_mish, NULL }
+};
+
+#define ACTIVATION_COUNT (int)(sizeof(activation_table) / sizeof(activation_table[0]))
+
+// ============================================================================
+// Sigmoid Activation
+// ============================================================================
+
+void activation_sigmoid(float* x, int size) {
+    vec_math_sigmoid(x, size);
+}
+
+void activation_sigmoid_derivative(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = x[i] * (1.0f - x[i]);
+    }
+}
+
+// ============================================================================
+// Tanh (Hyperbolic Tangent) Activation
+// ============================================================================
+
+void activation_tanh(float* x, int size) {
+    vec_math_tanh(x, size);
+}
+
+void activation_tanh_derivative(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = 1.0f - x[i] * x[i];
+    }
+}
+
+// ============================================================================
+// ReLU (Rectified Linear Unit) Activation
+// ============================================================================
+
+void activation_relu(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = x[i] > 0.0f ? x[i] : 0.0f;
+    }
+}
+
+void activation_relu_derivative(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = x[i] > 0.0f ? 1.0f : 0.0f;
+    }
+}
+
+// ============================================================================
+// Leaky ReLU Activation
+// ============================================================================
+
+void activation_leaky_relu(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = x[i] > 0.0f ? x[i] : ACTIVATION_LEAKY_SLOPE * x[i];
+    }
+}
+
+void activation_leaky_relu_derivative(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = x[i] > 0.0f ? 1.0f : ACTIVATION_LEAKY_SLOPE;
+    }
+}
+
+// ============================================================================
+// ELU (Exponential Linear Unit) Activation
+// ============================================================================
+
+void activation_elu(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        if (x[i] <= 0.0f) x[i] = ACTIVATION_ELU_ALPHA * (vec_math_expf(x[i]) - 1.0f);
+    }
+}
+
+void activation_elu_derivative(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = x[i] > 0.0f ? 1.0f : ACTIVATION_ELU_ALPHA * vec_math_expf(x[i]);
+    }
+}
+
+// ============================================================================
+// Swish Activation
+// ============================================================================
+
+void activation_swish(float* x, int size) {
+    vec_math_swish(x, size);
+}
+
+void activation_swish_derivative(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        float s = vec_math_sigmoidf(x[i]);
+        float swish = x[i] * s;
+        x[i] = swish + s * (1.0f - swish);
+    }
+}
+
+// ============================================================================
+// Softmax Activation
+// ============================================================================
+
+void activation_softmax(float* x, int size) {
+    vec_math_softmax(x, size);
+}
+
+void activation_softmax_derivative(float* x, int size) {
+    // Diagonal of the Jacobian; the full product is folded into cross-entropy
+    for (int i = 0; i < size; i++) {
+        x[i] = x[i] * (1.0f - x[i]);
+    }
+}
+
+// ============================================================================
+// Linear Activation (Identity)
+// ============================================================================
+
+void activation_linear(float* x, int size) {
+    (void)x;
+    (void)size;
+}
+
+void activation_linear_derivative(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        x[i] = 1.0f;
+    }
+}
+
+// ============================================================================
+// Utility Functions
+// ============================================================================
+
+void activation_apply(float* x, int size, ActivationFunction activation) {
+    if (!x || !activation) return;
+    activation(x, size);
+}
+
+/**
+ * Multiplies gradient (dL/d output on entry) by the derivative, leaving
+ * dL/d input. Sigmoid, tanh and softmax derivatives take the outputs, the
+ * others take the original inputs.
+ */
+void activation_compute_derivative(float* input, float* output, float* gradient,
+                                 int size, ActivationDerivative activation_derivative) {
+    if (!gradient || !activation_derivative) return;
+
+    bool from_output = activation_derivative == activation_sigmoid_derivative ||
+                       activation_derivative == activation_tanh_derivative ||
+                       activation_derivative == activation_softmax_derivative;
+    const float* source = from_output ? output : input;
+    if (!source) return;
+
+    float block[ACTIVATION_DERIVATIVE_BLOCK];
+    for (int start = 0; start < size; start += ACTIVATION_DERIVATIVE_BLOCK) {
+        int count = size - start < ACTIVATION_DERIVATIVE_BLOCK ? size - start : ACTIVATION_DERIVATIVE_BLOCK;
+        memcpy(block, source + start, count * sizeof(float));
+        activation_derivative(block, count);
+        for (int i = 0; i < count; i++) {
+            gradient[start + i] *= block[i];
+        }
+    }
+}
+
+ActivationFunction activation_get_function(const char* name) {
+    if (!name) return NULL;
+
+    for (int i = 0; i < ACTIVATION_COUNT; i++) {
+        if (strcmp(activation_table[i].name, name) == 0) return activation_table[i].function;
+    }
+    return NULL;
+}
+
+ActivationDerivative activation_get_derivative(const char* name) {
+    if (!name) return NULL;
+
+    for (int i = 0; i < ACTIVATION_COUNT; i++) {
+        if (strcmp(activation_table[i].name, name) == 0) return activation_table[i].derivative;
+    }
+    return NULL;
+}
+
+int activation_list_functions(char** names, int max_names) {
+    if (names) {
+        for (int i = 0; i < ACTIVATION_COUNT && i < max_names; i++) {
+            names[i] = (char*)activation_table[i].name;
+        }
+    }
+    return ACTIVATION_COUNT;
+}
+
+// ============================================================================
+// Activation Function Properties
+// ============================================================================
+
+bool activation_is_bounded(ActivationFunction activation) {
+    return activation == activation_sigmoid || activation == activation_tanh ||
+           activation == activation_softmax;
+}
+
+bool activation_has_zero_mean(ActivationFunction activation) {
+    return activation == activation_tanh || activation == activation_selu;
+}
+
+void activation_get_range(ActivationFunction activation, float* min_output, float* max_output) {
+    float lo = -INFINITY, hi = INFINITY;
+
+    if (activation == activation_sigmoid || activation == activation_softmax) {
+        lo = 0.0f;
+        hi = 1.0f;
+    } else if (activation == activation_tanh) {
+        lo = -1.0f;
+        hi = 1.0f;
+    } else if (activation == activation_relu) {
+        lo = 0.0f;
+    } else if (activation == activation_elu) {
+        lo = -ACTIVATION_ELU_ALPHA;
+    } else if (activation == activation_selu) {
+        lo = -ACTIVATION_SELU_SCALE * ACTIVATION_SELU_ALPHA;
+    } else if (activation == activation_swish) {
+        lo = -0.2785f;
+    } else if (activation == activation_gelu) {
+        lo = -0.1700f;
+    } else if (activation == activation_mish) {
+        lo = -0.3088f;
+    }
+
+    if (min_output) *min_output = lo;
+    if (max_output) *max_output = hi;
+}
+
+bool activation_is_monotonic(ActivationFunction activation) {
+    return activation != activation_swish && activation != activation_gelu &&
+           activation != activation_mish;
+}
+
+// ============================================================================
+// Advanced Activation Functions
+// ============================================================================
+
+void activation_gelu(float* x, int size) {
+    vec_math_gelu(x, size);
+}
+
+void activation_selu(float* x, int size) {
+    for (int i = 0; i < size; i++) {
+        float v = x[i] > 0.0f ? x[i] : ACTIVATION_SELU_ALPHA * (vec_math_expf(x[i]) - 1.0f);
+        x[i] = ACTIVATION_SELU_SCALE * v;
+    }
+}
+
+void activation_mish(float* x, int size) {
+    vec_math_mish(x, size);
+}
+
+// ============================================================================
+// Batch Normalization Compatible Activations
+// ============================================================================
+
+bool activation_batch_norm_compatible(ActivationFunction activation) {
+    // SELU normalizes itself and softmax is an output layer
+    return activation && activation != activation_selu && activation != activation_softmax;
+}
+
+ActivationFunction activation_recommend_for_batch_norm(bool use_batch_norm) {
+    return use_batch_norm ? activation_relu : activation_selu;
+}
+
+// ============================================================================
+// Performance Considerations
+// ============================================================================
+
+bool activation_is_expensive(ActivationFunction activation) {
+    return activation != activation_linear && activation != activation_relu &&
+           activation != activation_leaky_relu;
+}
+
+size_t activation_memory_requirement(ActivationFunction activation, int input_size) {
+    if (input_size <= 0) return 0;
+
+    // Derivatives that take the inputs need them kept next to the outputs
+    if (activation == activation_sigmoid || activation == activation_tanh ||
+        activation == activation_softmax || activation == activation_linear) {
+        return 0;
+    }
+    return (size_t)input_size * sizeof(float);
+}
@@ -0,0 +1,599 @@
+/*
+ * Neural Network System - BF16 Kernels Implementation
+ * Rounding conversions, pair-interleaved operand packing and the bf16 GEMM
+ * micro-kernels (scalar, emulated AVX-512, AVX512-BF16 vdpbf16ps)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../headers/bf16_kernels.h"
+#include "../headers/thread_pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BF16_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define BF16_THREAD_LOCAL __declspec(thread)
+#else
+#define BF16_THREAD_LOCAL __thread
+#endif
+
+// ============================================================================
+// Scratch Buffers
+// ============================================================================
+
+static BF16_THREAD_LOCAL GemmScratch bf16_a_buffer;      // Packed A block
+static BF16_THREAD_LOCAL GemmScratch bf16_b_buffer;      // Packed B (bf16_gemm)
+static BF16_THREAD_LOCAL GemmScratch bf16_a_rounded;     // fp32 A rounded before packing
+static BF16_THREAD_LOCAL GemmScratch bf16_b_rounded;     // fp32 B rounded before packing
+
+// ============================================================================
+// Conversion
+// ============================================================================
+
+#ifdef BF16_HAVE_X86
+
+static int bf16_cpu_avx512 = -1;
+static int bf16_cpu_avx512_bf16 = -1;
+
+static bool bf16_has_avx512(void) {
+    if (bf16_cpu_avx512 < 0) {
+        __builtin_cpu_init();
+        bf16_cpu_avx512 = __builtin_cpu_supports("avx512f") ? 1 : 0;
+    }
+    return bf16_cpu_avx512 == 1;
+}
+
+static bool bf16_has_avx512_bf16(void) {
+    if (bf16_cpu_avx512_bf16 < 0) {
+        __builtin_cpu_init();
+        bf16_cpu_avx512_bf16 = bf16_has_avx512() && __builtin_cpu_supports("avx512bf16") ? 1 : 0;
+    }
+    return bf16_cpu_avx512_bf16 == 1;
+}
+
+/**
+ * @brief vcvtneps2bf16 (rounds to nearest even; denormal inputs become zero)
+ */
+__attribute__((target("avx512f,avx512bf16")))
+static void bf16_from_float_avx512_bf16(const float* src, bf16* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256bh packed = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), (__m256i)packed);
+    }
+    for (; i < count; i++) dst[i] = bf16_from_float(src[i]);
+}
+
+/**
+ * @brief Round to nearest even in integer lanes, quieting NaNs
+ */
+__attribute__((target("avx512f")))
+static void bf16_from_float_avx512(const float* src, bf16* dst, size_t count) {
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i bias = _mm512_set1_epi32(0x7fff);
+    const __m512i abs_mask = _mm512_set1_epi32(0x7fffffff);
+    const __m512i infinity = _mm512_set1_epi32(0x7f800000);
+    const __m512i quiet = _mm512_set1_epi32(0x00400000);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i bits = _mm512_loadu_si512((const void*)(src + i));
+        __mmask16 nan = _mm512_cmpgt_epu32_mask(_mm512_and_si512(bits, abs_mask), infinity);
+        __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+        __m512i rounded = _mm512_add_epi32(bits, _mm512_add_epi32(bias, lsb));
+        rounded = _mm512_mask_or_epi32(rounded, nan, bits, quiet);
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm512_cvtepi32_epi16(_mm512_srli_epi32(rounded, 16)));
+    }
+    for (; i < count; i++) dst[i] = bf16_from_float(src[i]);
+}
+
+__attribute__((target("avx512f")))
+static void bf16_to_float_avx512(const bf16* src, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i wide = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)(src + i)));
+        _mm512_storeu_si512((void*)(dst + i), _mm512_slli_epi32(wide, 16));
+    }
+    for (; i < count; i++) dst[i] = bf16_to_float(src[i]);
+}
+
+#endif // BF16_HAVE_X86
+
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+/**
+ * @brief Round an fp32 operand into a dense bf16 copy (bf16 operands pass through)
+ * @param op Operand, op(X) is rows x cols
+ * @param buffer Scratch holding the copy
+ * @param rounded Storage for the returned operand
+ * @return Operand with bf16 data, or NULL on allocation failure
+ */
+static const Bf16Operand* operand_as_bf16(const Bf16Operand* op, int rows, int cols,
+                                          GemmScratch* buffer, Bf16Operand* rounded) {
+    if (op->data) return op;
+
+    // Stored layout: the transpose of op(X) is what sits in memory
+    int stored_rows = op->trans == GEMM_TRANS ? cols : rows;
+    int stored_cols = op->trans == GEMM_TRANS ? rows : cols;
+    bf16* copy = (bf16*)gemm_scratch_reserve(buffer, (size_t)stored_rows * stored_cols * sizeof(bf16));
+    if (!copy) return NULL;
+
+    for (int i = 0; i < stored_rows; i++) {
+        bf16_from_float_array(op->data_f32 + (size_t)i * op->ld, copy + (size_t)i * stored_cols,
+                              (size_t)stored_cols);
+    }
+    rounded->data = copy;
+    rounded->data_f32 = NULL;
+    rounded->ld = stored_cols;
+    rounded->trans = op->trans;
+    return rounded;
+}
+
+/**
+ * @brief Pack words[p - p0][l] for lanes l in [0, width) starting at lane0
+ *
+ * The bf16 operand is viewed as lanes x k; word (p, l) holds elements
+ * (l, 2p) in the low and (l, 2p + 1) in the high half. With
+ * lanes_contiguous element (l, kk) sits at kk * ld + l, so each pair
+ * interleaves two row segments; otherwise at l * ld + kk, so consecutive
+ * elements of a row already form the lane's pair words. Missing lanes and
+ * the high half of a final odd pair are zero.
+ */
+static void pack_words(uint32_t* dst, const Bf16Operand* op, bool lanes_contiguous,
+                       int lane0, int lanes, int width, int p0, int p1, int k) {
+    int valid = lanes - lane0 < width ? lanes - lane0 : width;
+    const bf16* src = op->data;
+    int ld = op->ld;
+
+    if (lanes_contiguous) {
+        for (int p = p0; p < p1; p++, dst += width) {
+            const bf16* lo = src + (size_t)(2 * p) * ld + lane0;
+            if (2 * p + 1 < k) {
+                const bf16* hi = lo + ld;
+                for (int l = 0; l < valid; l++) dst[l] = (uint32_t)lo[l] | ((uint32_t)hi[l] << 16);
+            } else {
+                for (int l = 0; l < valid; l++) dst[l] = lo[l];
+            }
+            for (int l = valid; l < width; l++) dst[l] = 0;
+        }
+        return;
+    }
+
+    // Word by word across the lanes so every packed row is written whole
+    const bf16* rows[BF16_PANEL_COLS];
+    for (int l = 0; l < valid; l++) rows[l] = src + (size_t)(lane0 + l) * ld;
+
+    int full = k / 2 < p1 ? k / 2 : p1;
+    for (int p = p0; p < p1; p++, dst += width) {
+        if (p < full) {
+            for (int l = 0; l < valid; l++) {
+                dst[l] = (uint32_t)rows[l][2 * p] | ((uint32_t)rows[l][2 * p + 1] << 16);
+            }
+        } else {
+            for (int l = 0; l < valid; l++) dst[l] = rows[l][k - 1];
+        }
+        for (int l = valid; l < width; l++) dst[l] = 0;
+    }
+}
+
+/**
+ * @brief Pack pairs [p0, p1) of A rows [r0, r0 + BF16_PANEL_ROWS) as pair x row words
+ */
+static void pack_a_panel(uint32_t* dst, const Bf16Operand* a, int m, int k, int r0, int p0, int p1) {
+    // op(A) is m x k: rows are the lanes
+    pack_words(dst, a, a->trans == GEMM_TRANS, r0, m, BF16_PANEL_ROWS, p0, p1, k);
+}
+
+/**
+ * @brief Pack all pairs of one B column panel as pair x column words
+ */
+static void pack_b_panel(uint32_t* dst, const Bf16Operand* b, int k, int n, int panel, int k_pairs) {
+    // op(B) is k x n: columns are the lanes
+    pack_words(dst, b, b->trans != GEMM_TRANS, panel * BF16_PANEL_COLS, n, BF16_PANEL_COLS, 0, k_pairs, k);
+}
+
+static bool bf16_operand_valid(const Bf16Operand* op) {
+    return op && (op->data || op->data_f32) && op->ld > 0;
+}
+
+bool bf16_pack_b(Bf16PackedMatrix* packed, const Bf16Operand* b, int k, int n) {
+    if (!packed) return false;
+    memset(packed, 0, sizeof(*packed));
+    if (!bf16_operand_valid(b) || k <= 0 || n <= 0) return false;
+
+    packed->k = k;
+    packed->n = n;
+    packed->k_pairs = (k + 1) / 2;
+    packed->panels = (n + BF16_PANEL_COLS - 1) / BF16_PANEL_COLS;
+
+    size_t bytes = (size_t)packed->panels * packed->k_pairs * BF16_PANEL_COLS * sizeof(uint32_t);
+    packed->raw = malloc(bytes + BF16_ALIGNMENT);
+    if (!packed->raw) return false;
+    packed->data = (uint32_t*)(((uintptr_t)packed->raw + BF16_ALIGNMENT - 1) & ~(uintptr_t)(BF16_ALIGNMENT - 1));
+
+    bf16_repack_b(packed, b);
+    return true;
+}
+
+void bf16_repack_b(Bf16PackedMatrix* packed, const Bf16Operand* b) {
+    if (!packed || !packed->data || !bf16_operand_valid(b)) return;
+
+    Bf16Operand rounded;
+    b = operand_as_bf16(b, packed->k, packed->n, &bf16_b_rounded, &rounded);
+    if (!b) return;
+
+    size_t panel_words = (size_t)packed->k_pairs * BF16_PANEL_COLS;
+    for (int panel = 0; panel < packed->panels; panel++) {
+        pack_b_panel(packed->data + panel * panel_words, b, packed->k, packed->n, panel, packed->k_pairs);
+    }
+}
+
+void bf16_packed_free(Bf16PackedMatrix* packed) {
+    if (!packed) return;
+    free(packed->raw);
+    memset(packed, 0, sizeof(*packed));
+}
+
+// ============================================================================
+// Micro-Kernels
+// ============================================================================
+
+/**
+ * @brief 6 x 32 tile over `pairs` reduction pairs; c = acc (+ c when accumulating)
+ */
+typedef void (*Bf16KernelFn)(int pairs, const uint32_t* ap, const uint32_t* bp,
+                             float* c, int ldc, bool accumulate);
+
+static void bf16_kernel_scalar(int pairs, const uint32_t* ap, const uint32_t* bp,
+                               float* c, int ldc, bool accumulate) {
+    float acc[BF16_PANEL_ROWS][BF16_PANEL_COLS] = { { 0.0f } };
+
+    for (int p = 0; p < pairs; p++) {
+        for (int r = 0; r < BF16_PANEL_ROWS; r++) {
+            float a_lo = bf16_to_float((bf16)(ap[r] & 0xffffu));
+            float a_hi = bf16_to_float((bf16)(ap[r] >> 16));
+            for (int j = 0; j < BF16_PANEL_COLS; j++) {
+                acc[r][j] += a_lo * bf16_to_float((bf16)(bp[j] & 0xffffu)) +
+                             a_hi * bf16_to_float((bf16)(bp[j] >> 16));
+            }
+        }
+        ap += BF16_PANEL_ROWS;
+        bp += BF16_PANEL_COLS;
+    }
+
+    for (int r = 0; r < BF16_PANEL_ROWS; r++) {
+        for (int j = 0; j < BF16_PANEL_COLS; j++) {
+            c[r * ldc + j] = accumulate ? c[r * ldc + j] + acc[r][j] : acc[r][j];
+        }
+    }
+}
+
+#ifdef BF16_HAVE_X86
+
+/**
+ * @brief Store (or add) the twelve accumulators of a 6 x 32 tile
+ */
+#define BF16_STORE_TILE_AVX512(c, ldc, accumulate)                                        \
+    do {                                                                                  \
+        __m512 acc[BF16_PANEL_ROWS][2] = {                                                \
+            {c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}        \
+        };                                                                                \
+        for (int r = 0; r < BF16_PANEL_ROWS; r++) {                                       \
+            float* row = (c) + r * (ldc);                                                 \
+            for (int h = 0; h < 2; h++) {                                                 \
+                __m512 v = acc[r][h];                                                     \
+                if (accumulate) v = _mm512_add_ps(v, _mm512_loadu_ps(row + h * 16));      \
+                _mm512_storeu_ps(row + h * 16, v);                                        \
+            }                                                                             \
+        }                                                                                 \
+    } while (0)
+
+/**
+ * @brief Pairs widened to fp32 (low half shifted up, high half masked) and FMA'd
+ */
+__attribute__((target("avx512f")))
+static void bf16_kernel_avx512(int pairs, const uint32_t* ap, const uint32_t* bp,
+                               float* c, int ldc, bool accumulate) {
+    const __m512i high_mask = _mm512_set1_epi32((int)0xffff0000u);
+    __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+    __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+    __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+    __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+    __m512 c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps();
+    __m512 c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+
+#define BF16_EMULATED_ROW(i, acc0, acc1)                                                  \
+    do {                                                                                  \
+        __m512i a = _mm512_set1_epi32((int)ap[i]);                                        \
+        __m512 a_lo = _mm512_castsi512_ps(_mm512_slli_epi32(a, 16));                      \
+        __m512 a_hi = _mm512_castsi512_ps(_mm512_and_si512(a, high_mask));                \
+        acc0 = _mm512_fmadd_ps(a_hi, b0_hi, _mm512_fmadd_ps(a_lo, b0_lo, acc0));          \
+        acc1 = _mm512_fmadd_ps(a_hi, b1_hi, _mm512_fmadd_ps(a_lo, b1_lo, acc1));          \
+    } while (0)
+
+    for (int p = 0; p < pairs; p++) {
+        __m512i b0 = _mm512_load_si512((const void*)bp);
+        __m512i b1 = _mm512_load_si512((const void*)(bp + 16));
+        __m512 b0_lo = _mm512_castsi512_ps(_mm512_slli_epi32(b0, 16));
+        __m512 b0_hi = _mm512_castsi512_ps(_mm512_and_si512(b0, high_mask));
+        __m512 b1_lo = _mm512_castsi512_ps(_mm512_slli_epi32(b1, 16));
+        __m512 b1_hi = _mm512_castsi512_ps(_mm512_and_si512(b1, high_mask));
+
+        BF16_EMULATED_ROW(0, c00, c01);
+        BF16_EMULATED_ROW(1, c10, c11);
+        BF16_EMULATED_ROW(2, c20, c21);
+        BF16_EMULATED_ROW(3, c30, c31);
+        BF16_EMULATED_ROW(4, c40, c41);
+        BF16_EMULATED_ROW(5, c50, c51);
+
+        ap += BF16_PANEL_ROWS;
+        bp += BF16_PANEL_COLS;
+    }
+#undef BF16_EMULATED_ROW
+
+    BF16_STORE_TILE_AVX512(c, ldc, accumulate);
+}
+
+__attribute__((target("avx512f,avx512bf16")))
+static void bf16_kernel_avx512_bf16(int pairs, const uint32_t* ap, const uint32_t* bp,
+                                    float* c, int ldc, bool accumulate) {
+    __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+    __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+    __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+    __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+    __m512 c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps();
+    __m512 c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+
+    for (int p = 0; p < pairs; p++) {
+        __m512bh b0 = (__m512bh)_mm512_load_si512((const void*)bp);
+        __m512bh b1 = (__m512bh)_mm512_load_si512((const void*)(bp + 16));
+        __m512bh a;
+
+        a = (__m512bh)_mm512_set1_epi32((int)ap[0]);
+        c00 = _mm512_dpbf16_ps(c00, a, b0); c01 = _mm512_dpbf16_ps(c01, a, b1);
+        a = (__m512bh)_mm512_set1_epi32((int)ap[1]);
+        c10 = _mm512_dpbf16_ps(c10, a, b0); c11 = _mm512_dpbf16_ps(c11, a, b1);
+        a = (__m512bh)_mm512_set1_epi32((int)ap[2]);
+        c20 = _mm512_dpbf16_ps(c20, a, b0); c21 = _mm512_dpbf16_ps(c21, a, b1);
+        a = (__m512bh)_mm512_set1_epi32((int)ap[3]);
+        c30 = _mm512_dpbf16_ps(c30, a, b0); c31 = _mm512_dpbf16_ps(c31, a, b1);
+        a = (__m512bh)_mm512_set1_epi32((int)ap[4]);
+        c40 = _mm512_dpbf16_ps(c40, a, b0); c41 = _mm512_dpbf16_ps(c41, a, b1);
+        a = (__m512bh)_mm512_set1_epi32((int)ap[5]);
+        c50 = _mm512_dpbf16_ps(c50, a, b0); c51 = _mm512_dpbf16_ps(c51, a, b1);
+
+        ap += BF16_PANEL_ROWS;
+        bp += BF16_PANEL_COLS;
+    }
+
+    BF16_STORE_TILE_AVX512(c, ldc, accumulate);
+}
+
+#undef BF16_STORE_TILE_AVX512
+
+#endif // BF16_HAVE_X86
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+static int bf16_active_kernel = -1;
+
+static bool bf16_cpu_supports(Bf16KernelType type) {
+    switch (type) {
+        case BF16_KERNEL_SCALAR:
+            return true;
+#ifdef BF16_HAVE_X86
+        case BF16_KERNEL_AVX512:
+            return bf16_has_avx512();
+        case BF16_KERNEL_AVX512_BF16:
+            return bf16_has_avx512_bf16();
+#endif
+        default:
+            return false;
+    }
+}
+
+Bf16KernelType bf16_get_kernel(void) {
+    if (bf16_active_kernel < 0) {
+        Bf16KernelType best = BF16_KERNEL_SCALAR;
+        if (bf16_cpu_supports(BF16_KERNEL_AVX512)) best = BF16_KERNEL_AVX512;
+        if (bf16_cpu_supports(BF16_KERNEL_AVX512_BF16)) best = BF16_KERNEL_AVX512_BF16;
+        bf16_active_kernel = (int)best;
+    }
+    return (Bf16KernelType)bf16_active_kernel;
+}
+
+bool bf16_set_kernel(Bf16KernelType type) {
+    if (!bf16_cpu_supports(type)) return false;
+    bf16_active_kernel = (int)type;
+    return true;
+}
+
+const char* bf16_kernel_name(Bf16KernelType type) {
+    switch (type) {
+        case BF16_KERNEL_SCALAR: return "scalar";
+        case BF16_KERNEL_AVX512: return "avx512 (emulated)";
+        case BF16_KERNEL_AVX512_BF16: return "avx512-bf16";
+        default: return "unknown";
+    }
+}
+
+static Bf16KernelFn bf16_select_kernel(void) {
+#ifdef BF16_HAVE_X86
+    switch (bf16_get_kernel()) {
+        case BF16_KERNEL_AVX512_BF16: return bf16_kernel_avx512_bf16;
+        case BF16_KERNEL_AVX512: return bf16_kernel_avx512;
+        default: break;
+    }
+#endif
+    return bf16_kernel_scalar;
+}
+
+// ============================================================================
+// Array Conversion
+// ============================================================================
+
+void bf16_from_float_array(const float* src, bf16* dst, size_t count) {
+    if (!src || !dst) return;
+#ifdef BF16_HAVE_X86
+    switch (bf16_get_kernel()) {
+        case BF16_KERNEL_AVX512_BF16:
+            bf16_from_float_avx512_bf16(src, dst, count);
+            return;
+        case BF16_KERNEL_AVX512:
+            bf16_from_float_avx512(src, dst, count);
+            return;
+        default:
+            break;
+    }
+#endif
+    for (size_t i = 0; i < count; i++) dst[i] = bf16_from_float(src[i]);
+}
+
+void bf16_to_float_array(const bf16* src, float* dst, size_t count) {
+    if (!src || !dst) return;
+#ifdef BF16_HAVE_X86
+    if (bf16_get_kernel() != BF16_KERNEL_SCALAR) {
+        bf16_to_float_avx512(src, dst, count);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; i++) dst[i] = bf16_to_float(src[i]);
+}
+
+// ============================================================================
+// GEMM
+// ============================================================================
+
+/**
+ * @brief One reduction block of the product, split by column panel
+ */
+typedef struct {
+    Bf16KernelFn kernel;
+    const uint32_t* a_packed;       // m panels x block pairs x BF16_PANEL_ROWS
+    const Bf16PackedMatrix* b;
+    int m, p0, p1;
+    bool accumulate;                // Add to C (earlier blocks or beta != 0)
+    bool last_block;                // Apply the epilogue
+    float* c;
+    int ldc;
+    const GemmEpilogue* epilogue;
+} Bf16BlockTask;
+
+static void bf16_tile_task(void* context, int index, int thread_id) {
+    const Bf16BlockTask* task = (const Bf16BlockTask*)context;
+    (void)thread_id;
+
+    // Row blocks outermost: a block of A panels stays cached across every B panel
+    const Bf16PackedMatrix* b = task->b;
+    int panel = index % b->panels;
+    int row_begin = (index / b->panels) * BF16_PANEL_ROWS * GEMM_BLOCK_M_PANELS;
+    int row_end = row_begin + BF16_PANEL_ROWS * GEMM_BLOCK_M_PANELS < task->m
+                ? row_begin + BF16_PANEL_ROWS * GEMM_BLOCK_M_PANELS : task->m;
+
+    int pairs = task->p1 - task->p0;
+    int col0 = panel * BF16_PANEL_COLS;
+    int cols = b->n - col0 < BF16_PANEL_COLS ? b->n - col0 : BF16_PANEL_COLS;
+    const uint32_t* bp = b->data + ((size_t)panel * b->k_pairs + task->p0) * BF16_PANEL_COLS;
+
+    for (int r0 = row_begin; r0 < row_end; r0 += BF16_PANEL_ROWS) {
+        int rows = task->m - r0 < BF16_PANEL_ROWS ? task->m - r0 : BF16_PANEL_ROWS;
+        const uint32_t* ap = task->a_packed + (size_t)(r0 / BF16_PANEL_ROWS) * pairs * BF16_PANEL_ROWS;
+        float* c = task->c + (size_t)r0 * task->ldc + col0;
+
+        if (rows == BF16_PANEL_ROWS && cols == BF16_PANEL_COLS) {
+            task->kernel(pairs, ap, bp, c, task->ldc, task->accumulate);
+        } else {
+            // Edge tile: compute the full tile aside and copy the valid part
+            float tile[BF16_PANEL_ROWS * BF16_PANEL_COLS];
+            for (int r = 0; r < rows; r++) {
+                for (int j = 0; j < cols; j++) {
+                    tile[r * BF16_PANEL_COLS + j] = task->accumulate ? c[(size_t)r * task->ldc + j] : 0.0f;
+                }
+            }
+            task->kernel(pairs, ap, bp, tile, BF16_PANEL_COLS, true);
+            for (int r = 0; r < rows; r++) {
+                memcpy(c + (size_t)r * task->ldc, tile + r * BF16_PANEL_COLS, cols * sizeof(float));
+            }
+        }
+
+        if (task->last_block && task->epilogue) {
+            gemm_apply_epilogue(task->epilogue, c, task->ldc, rows, cols, r0, col0);
+        }
+    }
+}
+
+bool bf16_gemm_packed(int m, const Bf16Operand* a, const Bf16PackedMatrix* b,
+                      float beta, float* c, int ldc, const GemmEpilogue* epilogue) {
+    if (m <= 0 || !bf16_operand_valid(a) || !b || !b->data || !c) return false;
+
+    Bf16Operand rounded;
+    a = operand_as_bf16(a, m, b->k, &bf16_a_rounded, &rounded);
+    if (!a) return false;
+
+    int m_panels = (m + BF16_PANEL_ROWS - 1) / BF16_PANEL_ROWS;
+    int row_blocks = (m_panels + GEMM_BLOCK_M_PANELS - 1) / GEMM_BLOCK_M_PANELS;
+    int block = b->k_pairs < BF16_BLOCK_PAIRS ? b->k_pairs : BF16_BLOCK_PAIRS;
+    uint32_t* a_packed = (uint32_t*)gemm_scratch_reserve(
+        &bf16_a_buffer, (size_t)m_panels * block * BF16_PANEL_ROWS * sizeof(uint32_t));
+    if (!a_packed) return false;
+
+    if (beta != 0.0f && beta != 1.0f) {
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < b->n; j++) c[(size_t)i * ldc + j] *= beta;
+        }
+    }
+
+    ThreadPool* pool = gemm_get_thread_pool();
+    long long work = (long long)m * b->n * b->k;
+    bool parallel = pool && work >= GEMM_PARALLEL_THRESHOLD && row_blocks * b->panels > 1 &&
+                    !thread_pool_in_parallel_region();
+
+    Bf16BlockTask task = { bf16_select_kernel(), a_packed, b, m, 0, 0, false, false, c, ldc, epilogue };
+    for (int p0 = 0; p0 < b->k_pairs; p0 += block) {
+        int p1 = p0 + block < b->k_pairs ? p0 + block : b->k_pairs;
+        for (int r0 = 0; r0 < m; r0 += BF16_PANEL_ROWS) {
+            pack_a_panel(a_packed + (size_t)(r0 / BF16_PANEL_ROWS) * (p1 - p0) * BF16_PANEL_ROWS,
+                         a, m, b->k, r0, p0, p1);
+        }
+
+        task.p0 = p0;
+        task.p1 = p1;
+        task.accumulate = p0 > 0 || beta != 0.0f;
+        task.last_block = p1 == b->k_pairs;
+        int tiles = row_blocks * b->panels;
+        if (parallel) {
+            thread_pool_parallel_for(pool, tiles, bf16_tile_task, &task);
+        } else {
+            for (int tile = 0; tile < tiles; tile++) bf16_tile_task(&task, tile, 0);
+        }
+    }
+    return true;
+}
+
+bool bf16_gemm(int m, int n, int k, const Bf16Operand* a, const Bf16Operand* b,
+               float beta, float* c, int ldc, const GemmEpilogue* epilogue) {
+    if (m <= 0 || n <= 0 || k <= 0 || !bf16_operand_valid(b)) return false;
+
+    Bf16PackedMatrix packed;
+    packed.k = k;
+    packed.n = n;
+    packed.k_pairs = (k + 1) / 2;
+    packed.panels = (n + BF16_PANEL_COLS - 1) / BF16_PANEL_COLS;
+    packed.raw = NULL;
+    packed.data = (uint32_t*)gemm_scratch_reserve(
+        &bf16_b_buffer, (size_t)packed.panels * packed.k_pairs * BF16_PANEL_COLS * sizeof(uint32_t));
+    if (!packed.data) return false;
+
+    bf16_repack_b(&packed, b);
+    return bf16_gemm_packed(m, a, &packed, beta, c, ldc, epilogue);
+}
@@ -0,0 +1,272 @@
+/*
+ * Neural Network System - Gradient Checkpointing Implementation
+ * Segmented forward in a scratch arena, per-segment recompute in backward
+ * and the budget-driven choice of the segment length
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../headers/checkpointing.h"
+#include "../headers/memory_plan.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/**
+ * @brief Drop the copies of segment inputs made by the last forward pass
+ */
+static void release_saved_inputs(CheckpointState* state) {
+    for (int l = 0; l < state->num_layers; l++) {
+        if (state->owns_input[l]) tensor_destroy(state->inputs[l]);
+        state->inputs[l] = NULL;
+        state->owns_input[l] = false;
+    }
+}
+
+void neural_network_release_checkpointing(NeuralNetwork* net) {
+    if (!net || !net->checkpoint) return;
+
+    CheckpointState* state = (CheckpointState*)net->checkpoint;
+    release_saved_inputs(state);
+    tensor_arena_destroy(state->arena);
+    free(state->inputs);
+    free(state->owns_input);
+    free(state->seeds);
+    free(state);
+    net->checkpoint = NULL;
+}
+
+bool neural_network_set_checkpointing(NeuralNetwork* net, int interval) {
+    if (!net) return false;
+
+    if (interval <= 0 || interval >= net->num_layers) {
+        neural_network_release_checkpointing(net);
+        return true;
+    }
+    if (net->mixed_precision) {
+        fprintf(stderr, "Checkpointing: not supported together with mixed precision\n");
+        return false;
+    }
+
+    CheckpointState* state = (CheckpointState*)net->checkpoint;
+    if (state && state->num_layers == net->num_layers) {
+        release_saved_inputs(state);
+        state->interval = interval;
+        return true;
+    }
+    neural_network_release_checkpointing(net);
+
+    state = (CheckpointState*)calloc(1, sizeof(CheckpointState));
+    if (!state) return false;
+
+    state->interval = interval;
+    state->num_layers = net->num_layers;
+    state->inputs = (Tensor**)calloc(net->num_layers, sizeof(Tensor*));
+    state->owns_input = (bool*)calloc(net->num_layers, sizeof(bool));
+    state->seeds = (unsigned int*)calloc(net->num_layers, sizeof(unsigned int));
+    state->arena = tensor_arena_create(0);
+    net->checkpoint = state;
+
+    if (!state->inputs || !state->owns_input || !state->seeds || !state->arena) {
+        neural_network_release_checkpointing(net);
+        return false;
+    }
+    return true;
+}
+
+int neural_network_get_checkpointing(const NeuralNetwork* net) {
+    if (!net || !net->checkpoint) return 0;
+    return ((const CheckpointState*)net->checkpoint)->interval;
+}
+
+// ============================================================================
+// Memory Estimate
+// ============================================================================
+
+static size_t estimate_floats(const MemoryPlanLayer* layers, int num_layers, int interval) {
+    int k = interval <= 0 || interval >= num_layers ? num_layers : interval;
+    int last_start = ((num_layers - 1) / k) * k;
+
+    size_t max_output = 0, max_scratch = 0;
+    for (int l = 0; l < num_layers; l++) {
+        const MemoryPlanLayer* layer = &layers[l];
+        if (layer->output_floats > max_output) max_output = layer->output_floats;
+        if (layer->forward_scratch > max_scratch) max_scratch = layer->forward_scratch;
+        if (layer->backward_scratch > max_scratch) max_scratch = layer->backward_scratch;
+    }
+
+    size_t kept = 0, largest_segment = 0;
+    for (int s = 0; s < num_layers; s += k) {
+        int e = s + k < num_layers ? s + k : num_layers;
+        size_t segment = 0;
+        for (int l = s; l < e; l++) segment += layers[l].output_floats + layers[l].saved_floats;
+
+        if (s == last_start) {
+            kept += segment;
+        } else {
+            kept += layers[e - 1].output_floats;
+            if (segment > largest_segment) largest_segment = segment;
+        }
+    }
+
+    return kept + largest_segment + 2 * max_output + max_scratch;
+}
+
+size_t neural_network_checkpoint_memory(const NeuralNetwork* net, int batch, int interval) {
+    if (!net || net->num_layers <= 0) return 0;
+
+    MemoryPlanLayer* layers = (MemoryPlanLayer*)malloc(net->num_layers * sizeof(MemoryPlanLayer));
+    size_t floats = 0;
+    if (layers && neural_network_memory_layers(net, batch, layers)) {
+        floats = estimate_floats(layers, net->num_layers, interval);
+    }
+    free(layers);
+    return floats * sizeof(float);
+}
+
+int neural_network_checkpoint_interval_for_budget(const NeuralNetwork* net, int batch,
+                                                  size_t budget_bytes) {
+    if (!net || net->num_layers <= 1) return 0;
+
+    MemoryPlanLayer* layers = (MemoryPlanLayer*)malloc(net->num_layers * sizeof(MemoryPlanLayer));
+    if (!layers || !neural_network_memory_layers(net, batch, layers)) {
+        free(layers);
+        return 0;
+    }
+
+    size_t budget_floats = budget_bytes / sizeof(float);
+    int best = 0;
+    size_t best_floats = estimate_floats(layers, net->num_layers, 0);
+
+    // Longest segments first: the first fit recomputes the fewest layers
+    if (best_floats > budget_floats) {
+        for (int k = net->num_layers - 1; k >= 1; k--) {
+            size_t floats = estimate_floats(layers, net->num_layers, k);
+            if (floats <= budget_floats) {
+                best = k;
+                break;
+            }
+            if (floats < best_floats) {
+                best_floats = floats;
+                best = k;
+            }
+        }
+    }
+
+    free(layers);
+    return best;
+}
+
+// ============================================================================
+// Forward / Backward
+// ============================================================================
+
+static Tensor* forward_layers(NeuralNetwork* net, int begin, int end, Tensor* x) {
+    for (int l = begin; x && l < end; l++) {
+        Layer* layer = net->layers[l];
+        x = layer->forward ? layer->forward(layer, x) : x;
+    }
+    return x;
+}
+
+static Tensor* backward_layers(NeuralNetwork* net, int begin, int end, Tensor* grad) {
+    for (int l = end - 1; grad && l >= begin; l--) {
+        Layer* layer = net->layers[l];
+        grad = layer->backward ? layer->backward(layer, grad) : grad;
+    }
+    return grad;
+}
+
+/**
+ * @brief Forget caches that pointed into the segment arena before it is reset
+ */
+static void clear_caches(NeuralNetwork* net, int begin, int end) {
+    for (int l = begin; l < end; l++) {
+        net->layers[l]->input_cache = NULL;
+        net->layers[l]->output_cache = NULL;
+    }
+}
+
+/**
+ * @brief Copy a segment result out of the arena into the caller's allocation target
+ */
+static Tensor* carry_out(Tensor* tensor) {
+    return tensor ? tensor_create(tensor->data, tensor->shape, tensor->ndim) : NULL;
+}
+
+Tensor* neural_network_checkpoint_forward(NeuralNetwork* net, Tensor* input) {
+    if (!net || !input || !net->checkpoint) return NULL;
+
+    CheckpointState* state = (CheckpointState*)net->checkpoint;
+    if (state->num_layers != net->num_layers) return NULL;
+    release_saved_inputs(state);
+
+    int k = state->interval;
+    int last_start = ((net->num_layers - 1) / k) * k;
+    Tensor* x = input;
+
+    for (int s = 0; s < last_start; s += k) {
+        state->inputs[s] = x;
+        state->owns_input[s] = s > 0;
+        state->seeds[s] = (unsigned int)rand();
+        srand(state->seeds[s]);
+
+        TensorArena* previous = tensor_arena_activate(state->arena);
+        Tensor* y = forward_layers(net, s, s + k, x);
+        tensor_arena_activate(previous);
+
+        x = carry_out(y);
+        clear_caches(net, s, s + k);
+        tensor_arena_reset(state->arena);
+        if (!x) return NULL;
+    }
+
+    // The last segment keeps its activations for the backward pass that follows
+    state->inputs[last_start] = x;
+    state->owns_input[last_start] = last_start > 0;
+    Tensor* output = forward_layers(net, last_start, net->num_layers, x);
+
+    state->resume_seed = (unsigned int)rand();
+    return output;
+}
+
+bool neural_network_checkpoint_backward(NeuralNetwork* net, Tensor* gradient) {
+    if (!net || !gradient || !net->checkpoint) return false;
+
+    CheckpointState* state = (CheckpointState*)net->checkpoint;
+    if (state->num_layers != net->num_layers) return false;
+
+    int k = state->interval;
+    int last_start = ((net->num_layers - 1) / k) * k;
+    if (last_start > 0 && !state->inputs[last_start - k]) return false;
+
+    state->recomputed_layers = 0;
+    Tensor* grad = backward_layers(net, last_start, net->num_layers, gradient);
+    bool owns_grad = false;
+    bool ok = grad != NULL;
+
+    for (int s = last_start - k; ok && s >= 0; s -= k) {
+        srand(state->seeds[s]);
+
+        TensorArena* previous = tensor_arena_activate(state->arena);
+        Tensor* y = forward_layers(net, s, s + k, state->inputs[s]);
+        Tensor* g = y ? backward_layers(net, s, s + k, grad) : NULL;
+        tensor_arena_activate(previous);
+        state->recomputed_layers += k;
+
+        // The first layer's input gradient is not needed
+        Tensor* carried = g && s > 0 ? carry_out(g) : NULL;
+        ok = g && (s == 0 || carried);
+        clear_caches(net, s, s + k);
+        tensor_arena_reset(state->arena);
+
+        if (owns_grad) tensor_destroy(grad);
+        grad = carried;
+        owns_grad = true;
+    }
+
+    srand(state->resume_seed);
+    if (owns_grad) tensor_destroy(grad);
+    return ok;
+}
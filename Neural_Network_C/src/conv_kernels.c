@@ -0,0 +1,1374 @@
+/*
+ * Neural Network System - Convolution Kernels Implementation
+ * im2col + GEMM and Winograd F(2x2,3x3) convolution with fused max pooling
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/conv_kernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONV_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#define CONV_CHUNK_PIXELS 2048          // Output pixels lowered per GEMM batch
+#define CONV_WINOGRAD_MIN_CHANNELS 16   // Below this the transforms outweigh the saving
+#define CONV_WINOGRAD_MIN_TILES 256     // Per call; fewer leaves the 16 GEMMs too small
+#define CONV_WINOGRAD_POINTS 16         // 4x4 transformed tile
+#define CONV_WINOGRAD_LANES 16          // Tiles or channels transformed together
+#define CONV_WINOGRAD_SKEW 16           // Floats between point planes (breaks 4K aliasing)
+
+typedef float ConvLanes[CONV_WINOGRAD_LANES];
+
+/**
+ * @brief Derived sizes shared by the size query and the kernels
+ */
+typedef struct {
+    ConvAlgorithm algorithm;    // Resolved forward algorithm
+    int out_h, out_w;           // Convolution output
+    int pool_h, pool_w;         // Pooled output (equal to out_* without pooling)
+    int pixels;                 // out_h * out_w
+    int depth;                  // in_channels * k * k, the lowered GEMM depth
+    bool direct;                // 1x1, stride 1, no padding: no patch matrix needed
+    int chunk;                  // Images per forward batch
+    int backward_chunk;         // Images per backward batch
+    int tiles_h, tiles_w;       // Winograd tiles per image
+
+    // Forward scratch (floats)
+    size_t weights;             // Reordered (NHWC) or transformed (Winograd) kernels
+    size_t col;                 // Patch matrix or transformed input tiles
+    size_t gemm_out;            // Winograd products before the output transform
+    size_t padded;              // Zero-padded NCHW input planes (Winograd)
+    size_t conv_tile;           // Unpooled output of one batch
+
+    // Backward scratch (floats)
+    size_t backward_weights;    // Reordered kernels (NHWC)
+    size_t weight_grad;         // Kernel gradient in reordered layout (NHWC)
+    size_t backward_col;        // Patch matrix
+    size_t dcol;                // Patch gradient before col2im
+    size_t conv_delta;          // Unpooled delta for the whole batch
+} ConvPlan;
+
+// ============================================================================
+// Shape Helpers
+// ============================================================================
+
+int conv_output_size(int input, int kernel_size, int stride, int padding) {
+    if (input <= 0 || kernel_size <= 0 || stride <= 0 || padding < 0) return 0;
+    int span = input + 2 * padding - kernel_size;
+    return span < 0 ? 0 : span / stride + 1;
+}
+
+bool conv_shape_init(ConvShape* shape, const Conv2DParams* params,
+                     int batch, int height, int width, ConvLayout layout) {
+    if (!shape || !params) return false;
+
+    shape->batch = batch;
+    shape->in_channels = params->input_channels;
+    shape->in_height = height;
+    shape->in_width = width;
+    shape->out_channels = params->output_channels;
+    shape->kernel_size = params->kernel_size;
+    shape->stride = params->stride;
+    shape->padding = params->padding;
+    shape->pool_size = 0;
+    shape->pool_stride = 0;
+    shape->layout = layout;
+
+    int h, w;
+    return conv_output_dims(shape, &h, &w);
+}
+
+static bool conv_shape_valid(const ConvShape* shape) {
+    if (!shape) return false;
+    if (shape->batch <= 0 || shape->in_channels <= 0 || shape->out_channels <= 0) return false;
+    if (shape->layout != CONV_LAYOUT_NCHW && shape->layout != CONV_LAYOUT_NHWC) return false;
+    if (shape->pool_size < 0 || (shape->pool_size > 0 && shape->pool_stride <= 0)) return false;
+    return conv_output_size(shape->in_height, shape->kernel_size, shape->stride, shape->padding) > 0 &&
+           conv_output_size(shape->in_width, shape->kernel_size, shape->stride, shape->padding) > 0;
+}
+
+bool conv_output_dims(const ConvShape* shape, int* height, int* width) {
+    if (!conv_shape_valid(shape)) return false;
+
+    int h = conv_output_size(shape->in_height, shape->kernel_size, shape->stride, shape->padding);
+    int w = conv_output_size(shape->in_width, shape->kernel_size, shape->stride, shape->padding);
+    if (shape->pool_size > 0) {
+        h = conv_output_size(h, shape->pool_size, shape->pool_stride, 0);
+        w = conv_output_size(w, shape->pool_size, shape->pool_stride, 0);
+        if (h <= 0 || w <= 0) return false;
+    }
+
+    if (height) *height = h;
+    if (width) *width = w;
+    return true;
+}
+
+bool conv_winograd_supported(const ConvShape* shape) {
+    return conv_shape_valid(shape) && shape->kernel_size == 3 && shape->stride == 1;
+}
+
+ConvAlgorithm conv_select_algorithm(const ConvShape* shape) {
+    if (!conv_winograd_supported(shape)) return CONV_ALGO_IM2COL;
+
+    int out_h = conv_output_size(shape->in_height, 3, 1, shape->padding);
+    int out_w = conv_output_size(shape->in_width, 3, 1, shape->padding);
+    long long tiles = (long long)shape->batch * ((out_h + 1) / 2) * ((out_w + 1) / 2);
+
+    if (shape->in_channels >= CONV_WINOGRAD_MIN_CHANNELS &&
+        shape->out_channels >= CONV_WINOGRAD_MIN_CHANNELS &&
+        tiles >= CONV_WINOGRAD_MIN_TILES) {
+        return CONV_ALGO_WINOGRAD;
+    }
+    return CONV_ALGO_IM2COL;
+}
+
+static int conv_images_per_chunk(int per_image, int batch) {
+    int chunk = CONV_CHUNK_PIXELS / (per_image > 0 ? per_image : 1);
+    if (chunk < 1) chunk = 1;
+    return chunk < batch ? chunk : batch;
+}
+
+/**
+ * @brief Row stride of staged NCHW planes: whole lane blocks of tiles, so a
+ * partial block at the right edge still reads inside its own row
+ */
+static int conv_winograd_padded_width(const ConvPlan* plan) {
+    int blocks = (plan->tiles_w + CONV_WINOGRAD_LANES - 1) / CONV_WINOGRAD_LANES;
+    return 2 * blocks * CONV_WINOGRAD_LANES + 2;
+}
+
+static bool conv_plan(const ConvShape* shape, ConvAlgorithm algorithm, ConvPlan* plan) {
+    if (!conv_shape_valid(shape) || !conv_output_dims(shape, &plan->pool_h, &plan->pool_w)) {
+        return false;
+    }
+
+    if (algorithm == CONV_ALGO_AUTO) algorithm = conv_select_algorithm(shape);
+    if (algorithm == CONV_ALGO_WINOGRAD && !conv_winograd_supported(shape)) return false;
+    if (algorithm != CONV_ALGO_IM2COL && algorithm != CONV_ALGO_WINOGRAD) return false;
+
+    const int k = shape->kernel_size;
+    const size_t in_c = (size_t)shape->in_channels;
+    const size_t out_c = (size_t)shape->out_channels;
+    const bool nhwc = shape->layout == CONV_LAYOUT_NHWC;
+    const bool pooled = shape->pool_size > 0;
+
+    plan->algorithm = algorithm;
+    plan->out_h = conv_output_size(shape->in_height, k, shape->stride, shape->padding);
+    plan->out_w = conv_output_size(shape->in_width, k, shape->stride, shape->padding);
+    plan->pixels = plan->out_h * plan->out_w;
+    plan->depth = shape->in_channels * k * k;
+    plan->direct = (k == 1 && shape->stride == 1 && shape->padding == 0);
+    plan->tiles_h = (plan->out_h + 1) / 2;
+    plan->tiles_w = (plan->out_w + 1) / 2;
+
+    // NCHW im2col produces one (out_channels x pixels) block per image, so it
+    // lowers image by image; NHWC rows from consecutive images are contiguous
+    if (algorithm == CONV_ALGO_WINOGRAD) {
+        int tiles = plan->tiles_h * plan->tiles_w;
+        plan->chunk = conv_images_per_chunk(tiles * 4, shape->batch);
+        size_t chunk_tiles = (size_t)plan->chunk * tiles;
+        plan->weights = CONV_WINOGRAD_POINTS * out_c * in_c;
+        plan->col = CONV_WINOGRAD_POINTS * (in_c * chunk_tiles + CONV_WINOGRAD_SKEW);
+        plan->gemm_out = CONV_WINOGRAD_POINTS * (out_c * chunk_tiles + CONV_WINOGRAD_SKEW);
+        plan->padded = nhwc ? 0 : (size_t)plan->chunk * in_c *
+                                  (2 * plan->tiles_h + 2) * conv_winograd_padded_width(plan);
+    } else {
+        plan->chunk = nhwc ? conv_images_per_chunk(plan->pixels, shape->batch) : 1;
+        plan->weights = (nhwc && !plan->direct) ? out_c * plan->depth : 0;
+        plan->col = plan->direct ? 0 : (size_t)plan->chunk * plan->pixels * plan->depth;
+        plan->gemm_out = 0;
+        plan->padded = 0;
+    }
+    plan->conv_tile = pooled ? (size_t)plan->chunk * plan->pixels * out_c : 0;
+
+    // Backward always lowers through im2col
+    plan->backward_chunk = nhwc ? conv_images_per_chunk(plan->pixels, shape->batch) : 1;
+    size_t backward_rows = (size_t)plan->backward_chunk * plan->pixels;
+    plan->backward_weights = (nhwc && !plan->direct) ? out_c * plan->depth : 0;
+    plan->weight_grad = plan->backward_weights;
+    plan->backward_col = plan->direct ? 0 : backward_rows * plan->depth;
+    plan->dcol = plan->backward_col;
+    plan->conv_delta = pooled ? (size_t)shape->batch * plan->pixels * out_c : 0;
+
+    return true;
+}
+
+static size_t conv_plan_forward_size(const ConvPlan* plan) {
+    return plan->weights + plan->col + plan->gemm_out + plan->padded + plan->conv_tile;
+}
+
+static size_t conv_plan_backward_size(const ConvPlan* plan) {
+    return plan->backward_weights + plan->weight_grad + plan->backward_col +
+           plan->dcol + plan->conv_delta;
+}
+
+size_t conv_workspace_size(const ConvShape* shape, ConvAlgorithm algorithm) {
+    ConvPlan plan;
+    if (!conv_plan(shape, algorithm, &plan)) return 0;
+
+    size_t forward = conv_plan_forward_size(&plan);
+    size_t backward = conv_plan_backward_size(&plan);
+    return forward > backward ? forward : backward;
+}
+
+static bool conv_tensors_valid(const ConvShape* shape, const ConvPlan* plan,
+                               const Tensor* input, const Tensor* kernels, const Tensor* output) {
+    if (!input || !kernels || !output) return false;
+
+    long long images = shape->batch;
+    long long in_size = images * shape->in_channels * shape->in_height * shape->in_width;
+    long long kernel_size = (long long)shape->out_channels * plan->depth;
+    long long out_size = images * shape->out_channels * plan->pool_h * plan->pool_w;
+
+    return input->size == in_size && kernels->size == kernel_size && output->size == out_size;
+}
+
+/**
+ * @brief Scratch for one call: the caller's buffer, or a temporary one
+ */
+static float* conv_workspace_acquire(float* workspace, size_t floats, float** owned) {
+    *owned = NULL;
+    if (workspace || floats == 0) return workspace;
+
+    *owned = (float*)malloc(floats * sizeof(float));
+    if (!*owned) fprintf(stderr, "Error: Failed to allocate convolution workspace\n");
+    return *owned;
+}
+
+// ============================================================================
+// Scalar Activation Helpers
+// ============================================================================
+
+static inline float conv_activate(GemmActivation kind, float x) {
+    switch (kind) {
+        case GEMM_ACTIVATION_RELU: return x > 0.0f ? x : 0.0f;
+        case GEMM_ACTIVATION_LEAKY_RELU: return x > 0.0f ? x : GEMM_LEAKY_RELU_SLOPE * x;
+        case GEMM_ACTIVATION_SIGMOID: return 1.0f / (1.0f + expf(-x));
+        case GEMM_ACTIVATION_TANH: return tanhf(x);
+        case GEMM_ACTIVATION_NONE:
+        default: return x;
+    }
+}
+
+/**
+ * @brief Activation derivative expressed through the activation output
+ */
+static inline float conv_activation_slope(GemmActivation kind, float y) {
+    switch (kind) {
+        case GEMM_ACTIVATION_RELU: return y > 0.0f ? 1.0f : 0.0f;
+        case GEMM_ACTIVATION_LEAKY_RELU: return y > 0.0f ? 1.0f : GEMM_LEAKY_RELU_SLOPE;
+        case GEMM_ACTIVATION_SIGMOID: return y * (1.0f - y);
+        case GEMM_ACTIVATION_TANH: return 1.0f - y * y;
+        case GEMM_ACTIVATION_NONE:
+        default: return 1.0f;
+    }
+}
+
+// ============================================================================
+// im2col / col2im
+// ============================================================================
+
+/**
+ * @brief NCHW patch matrix of one image: depth rows x pixels columns
+ *
+ * Row (c, kh, kw) holds the input pixel each output position sees through
+ * that kernel tap, so stride-1 rows are shifted copies of input rows.
+ */
+static void conv_im2col_nchw(const ConvShape* shape, const ConvPlan* plan,
+                             const float* image, float* col) {
+    const int k = shape->kernel_size, stride = shape->stride, pad = shape->padding;
+    const int h = shape->in_height, w = shape->in_width;
+    const int out_h = plan->out_h, out_w = plan->out_w;
+
+    for (int c = 0; c < shape->in_channels; c++) {
+        const float* plane = image + (size_t)c * h * w;
+
+        for (int kh = 0; kh < k; kh++) {
+            for (int kw = 0; kw < k; kw++) {
+                float* dst = col + ((size_t)(c * k + kh) * k + kw) * plan->pixels;
+
+                for (int oy = 0; oy < out_h; oy++) {
+                    float* row = dst + (size_t)oy * out_w;
+                    int iy = oy * stride - pad + kh;
+                    if (iy < 0 || iy >= h) {
+                        memset(row, 0, (size_t)out_w * sizeof(float));
+                        continue;
+                    }
+
+                    const float* src = plane + (size_t)iy * w;
+                    int ix0 = kw - pad;
+                    if (stride == 1) {
+                        int lo = ix0 < 0 ? -ix0 : 0;
+                        int hi = (w - ix0 < out_w) ? w - ix0 : out_w;
+                        if (hi < lo) hi = lo;
+                        memset(row, 0, (size_t)lo * sizeof(float));
+                        memcpy(row + lo, src + ix0 + lo, (size_t)(hi - lo) * sizeof(float));
+                        memset(row + hi, 0, (size_t)(out_w - hi) * sizeof(float));
+                    } else {
+                        for (int ox = 0; ox < out_w; ox++) {
+                            int ix = ox * stride + ix0;
+                            row[ox] = (ix >= 0 && ix < w) ? src[ix] : 0.0f;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Scatter-add an NCHW patch gradient back onto one image
+ */
+static void conv_col2im_nchw(const ConvShape* shape, const ConvPlan* plan,
+                             const float* col, float* image) {
+    const int k = shape->kernel_size, stride = shape->stride, pad = shape->padding;
+    const int h = shape->in_height, w = shape->in_width;
+    const int out_h = plan->out_h, out_w = plan->out_w;
+
+    for (int c = 0; c < shape->in_channels; c++) {
+        float* plane = image + (size_t)c * h * w;
+
+        for (int kh = 0; kh < k; kh++) {
+            for (int kw = 0; kw < k; kw++) {
+                const float* src = col + ((size_t)(c * k + kh) * k + kw) * plan->pixels;
+
+                // Output columns whose tap lands inside the row: ox in [lo, hi)
+                int ix0 = kw - pad;
+                int lo = ix0 < 0 ? (-ix0 + stride - 1) / stride : 0;
+                int hi = (w - ix0 + stride - 1) / stride;
+                if (hi > out_w) hi = out_w;
+
+                for (int oy = 0; oy < out_h; oy++) {
+                    int iy = oy * stride - pad + kh;
+                    if (iy < 0 || iy >= h) continue;
+
+                    const float* row = src + (size_t)oy * out_w;
+                    float* dst = plane + (size_t)iy * w + ix0;
+                    if (stride == 1) {
+                        for (int ox = lo; ox < hi; ox++) dst[ox] += row[ox];
+                    } else {
+                        for (int ox = lo; ox < hi; ox++) dst[ox * stride] += row[ox];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief NHWC patch matrix of one image: pixels rows x depth columns
+ *
+ * Columns are ordered (kh, kw, c) so each tap is one contiguous copy of
+ * in_channels floats; kernels are reordered to match.
+ */
+static void conv_im2col_nhwc(const ConvShape* shape, const ConvPlan* plan,
+                             const float* image, float* col) {
+    const int k = shape->kernel_size, stride = shape->stride, pad = shape->padding;
+    const int h = shape->in_height, w = shape->in_width, channels = shape->in_channels;
+
+    for (int oy = 0; oy < plan->out_h; oy++) {
+        for (int ox = 0; ox < plan->out_w; ox++) {
+            float* dst = col + ((size_t)oy * plan->out_w + ox) * plan->depth;
+
+            for (int kh = 0; kh < k; kh++) {
+                int iy = oy * stride - pad + kh;
+                for (int kw = 0; kw < k; kw++) {
+                    int ix = ox * stride - pad + kw;
+                    float* tap = dst + (size_t)(kh * k + kw) * channels;
+                    if (iy < 0 || iy >= h || ix < 0 || ix >= w) {
+                        for (int c = 0; c < channels; c++) tap[c] = 0.0f;
+                    } else {
+                        // Plain loops: a library memcpy call costs more than a few channels
+                        const float* src = image + ((size_t)iy * w + ix) * channels;
+                        for (int c = 0; c < channels; c++) tap[c] = src[c];
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void conv_col2im_nhwc(const ConvShape* shape, const ConvPlan* plan,
+                             const float* col, float* image) {
+    const int k = shape->kernel_size, stride = shape->stride, pad = shape->padding;
+    const int h = shape->in_height, w = shape->in_width, channels = shape->in_channels;
+
+    for (int oy = 0; oy < plan->out_h; oy++) {
+        for (int ox = 0; ox < plan->out_w; ox++) {
+            const float* src = col + ((size_t)oy * plan->out_w + ox) * plan->depth;
+
+            for (int kh = 0; kh < k; kh++) {
+                int iy = oy * stride - pad + kh;
+                if (iy < 0 || iy >= h) continue;
+                for (int kw = 0; kw < k; kw++) {
+                    int ix = ox * stride - pad + kw;
+                    if (ix < 0 || ix >= w) continue;
+
+                    const float* tap = src + (size_t)(kh * k + kw) * channels;
+                    float* dst = image + ((size_t)iy * w + ix) * channels;
+                    for (int c = 0; c < channels; c++) dst[c] += tap[c];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief (out, in, kh, kw) kernels to the (out, kh, kw, in) order of NHWC patches
+ */
+static void conv_reorder_kernels_nhwc(const ConvShape* shape, const float* kernels, float* reordered) {
+    const int k = shape->kernel_size, channels = shape->in_channels;
+
+    for (int o = 0; o < shape->out_channels; o++) {
+        const float* src = kernels + (size_t)o * channels * k * k;
+        float* dst = reordered + (size_t)o * channels * k * k;
+        for (int c = 0; c < channels; c++) {
+            for (int t = 0; t < k * k; t++) dst[(size_t)t * channels + c] = src[(size_t)c * k * k + t];
+        }
+    }
+}
+
+static void conv_restore_kernel_grad_nhwc(const ConvShape* shape, const float* reordered,
+                                          float* kernel_grad, bool accumulate) {
+    const int k = shape->kernel_size, channels = shape->in_channels;
+
+    for (int o = 0; o < shape->out_channels; o++) {
+        const float* src = reordered + (size_t)o * channels * k * k;
+        float* dst = kernel_grad + (size_t)o * channels * k * k;
+        for (int c = 0; c < channels; c++) {
+            for (int t = 0; t < k * k; t++) {
+                float g = src[(size_t)t * channels + c];
+                dst[(size_t)c * k * k + t] = accumulate ? dst[(size_t)c * k * k + t] + g : g;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Fused Max Pooling
+// ============================================================================
+
+/**
+ * @brief Max-pool a batch of unpooled outputs into the final output
+ * @param conv Unpooled outputs of images [first, first + count)
+ */
+static void conv_max_pool(const ConvShape* shape, const ConvPlan* plan, const float* conv,
+                          int first, int count, float* output, int* max_indices) {
+    const int size = shape->pool_size, stride = shape->pool_stride;
+    const int channels = shape->out_channels;
+    const int out_w = plan->out_w;
+    const size_t pooled_pixels = (size_t)plan->pool_h * plan->pool_w;
+
+    if (shape->layout == CONV_LAYOUT_NCHW) {
+        for (int i = 0; i < count; i++) {
+            for (int c = 0; c < channels; c++) {
+                size_t plane_index = (size_t)(first + i) * channels + c;
+                const float* plane = conv + ((size_t)i * channels + c) * plan->pixels;
+                float* dst = output + plane_index * pooled_pixels;
+                int* idx = max_indices ? max_indices + plane_index * pooled_pixels : NULL;
+
+                for (int py = 0; py < plan->pool_h; py++) {
+                    for (int px = 0; px < plan->pool_w; px++) {
+                        int best_pos = py * stride * out_w + px * stride;
+                        float best = plane[best_pos];
+                        for (int wy = 0; wy < size; wy++) {
+                            for (int wx = 0; wx < size; wx++) {
+                                int pos = (py * stride + wy) * out_w + px * stride + wx;
+                                if (plane[pos] > best) {
+                                    best = plane[pos];
+                                    best_pos = pos;
+                                }
+                            }
+                        }
+                        dst[py * plan->pool_w + px] = best;
+                        if (idx) {
+                            idx[py * plan->pool_w + px] =
+                                (int)(plane_index * plan->pixels + best_pos);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // NHWC: channels are innermost, so each window compares whole pixel rows
+    for (int i = 0; i < count; i++) {
+        const float* image = conv + (size_t)i * plan->pixels * channels;
+        size_t image_base = (size_t)(first + i) * plan->pixels * channels;
+
+        for (int py = 0; py < plan->pool_h; py++) {
+            for (int px = 0; px < plan->pool_w; px++) {
+                size_t out_pos = (((size_t)(first + i) * plan->pool_h + py) * plan->pool_w + px) * channels;
+                float* dst = output + out_pos;
+                int* idx = max_indices ? max_indices + out_pos : NULL;
+                int origin = py * stride * out_w + px * stride;
+
+                memcpy(dst, image + (size_t)origin * channels, (size_t)channels * sizeof(float));
+                if (idx) {
+                    for (int c = 0; c < channels; c++) {
+                        idx[c] = (int)(image_base + (size_t)origin * channels + c);
+                    }
+                }
+
+                for (int wy = 0; wy < size; wy++) {
+                    for (int wx = 0; wx < size; wx++) {
+                        int pos = (py * stride + wy) * out_w + px * stride + wx;
+                        const float* src = image + (size_t)pos * channels;
+                        for (int c = 0; c < channels; c++) {
+                            if (src[c] > dst[c]) {
+                                dst[c] = src[c];
+                                if (idx) idx[c] = (int)(image_base + (size_t)pos * channels + c);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// im2col Forward
+// ============================================================================
+
+static bool conv_im2col_forward(const ConvShape* shape, const ConvPlan* plan,
+                                const float* input, const float* kernels, const float* biases,
+                                GemmActivation kind, float* output, int* max_indices,
+                                float* workspace) {
+    const int in_c = shape->in_channels, out_c = shape->out_channels;
+    const size_t image_in = (size_t)in_c * shape->in_height * shape->in_width;
+    const size_t image_out = (size_t)out_c * plan->pixels;
+    const bool pooled = shape->pool_size > 0;
+
+    float* weights = workspace;
+    float* col = weights + plan->weights;
+    float* conv_tile = col + plan->col;
+
+    if (shape->layout == CONV_LAYOUT_NCHW) {
+        // out (out_c x pixels) = W (out_c x depth) * col (depth x pixels)
+        GemmEpilogue epilogue = { NULL, kind, biases };
+
+        for (int n = 0; n < shape->batch; n++) {
+            const float* image = input + (size_t)n * image_in;
+            float* dst = pooled ? conv_tile : output + (size_t)n * image_out;
+            const float* patches = image;
+
+            if (!plan->direct) {
+                conv_im2col_nchw(shape, plan, image, col);
+                patches = col;
+            }
+
+            if (!gemm_sgemm_epilogue(GEMM_NO_TRANS, GEMM_NO_TRANS, out_c, plan->pixels, plan->depth, 1.0f,
+                                     kernels, plan->depth, patches, plan->pixels,
+                                     0.0f, dst, plan->pixels, &epilogue)) {
+                return false;
+            }
+
+            if (pooled) conv_max_pool(shape, plan, conv_tile, n, 1, output, max_indices);
+        }
+        return true;
+    }
+
+    // NHWC: out (rows x out_c) = col (rows x depth) * W'^T, rows spanning several images
+    GemmEpilogue epilogue = { biases, kind, NULL };
+    const float* weights_used = kernels;
+    if (!plan->direct) {
+        conv_reorder_kernels_nhwc(shape, kernels, weights);
+        weights_used = weights;
+    }
+
+    for (int n0 = 0; n0 < shape->batch; n0 += plan->chunk) {
+        int count = (shape->batch - n0 < plan->chunk) ? shape->batch - n0 : plan->chunk;
+        int rows = count * plan->pixels;
+        const float* images = input + (size_t)n0 * image_in;
+        float* dst = pooled ? conv_tile : output + (size_t)n0 * image_out;
+        const float* patches = images;
+
+        if (!plan->direct) {
+            for (int i = 0; i < count; i++) {
+                conv_im2col_nhwc(shape, plan, images + (size_t)i * image_in,
+                                 col + (size_t)i * plan->pixels * plan->depth);
+            }
+            patches = col;
+        }
+
+        if (!gemm_sgemm_epilogue(GEMM_NO_TRANS, GEMM_TRANS, rows, out_c, plan->depth, 1.0f,
+                                 patches, plan->depth, weights_used, plan->depth,
+                                 0.0f, dst, out_c, &epilogue)) {
+            return false;
+        }
+
+        if (pooled) conv_max_pool(shape, plan, conv_tile, n0, count, output, max_indices);
+    }
+    return true;
+}
+
+// ============================================================================
+// Winograd F(2x2,3x3) Forward
+// ============================================================================
+//
+// Y = A^T [ (G g G^T) .* (B^T d B) ] A over 4x4 input tiles d with stride 2.
+// The elementwise product summed over input channels is 16 independent
+// GEMMs, one per transformed point: 16 multiplies per 2x2 outputs instead
+// of 36.
+
+/**
+ * @brief U[point][out][in] = G g G^T for every kernel
+ */
+static void conv_winograd_kernels(const ConvShape* shape, const float* kernels, float* u) {
+    const int in_c = shape->in_channels, out_c = shape->out_channels;
+    const size_t stride = (size_t)out_c * in_c;
+
+    for (int o = 0; o < out_c; o++) {
+        for (int c = 0; c < in_c; c++) {
+            const float* g = kernels + ((size_t)o * in_c + c) * 9;
+            float t[4][3];
+
+            // t = G g  (G = [1 0 0; .5 .5 .5; .5 -.5 .5; 0 0 1])
+            for (int j = 0; j < 3; j++) {
+                float g0 = g[j], g1 = g[3 + j], g2 = g[6 + j];
+                t[0][j] = g0;
+                t[1][j] = 0.5f * (g0 + g1 + g2);
+                t[2][j] = 0.5f * (g0 - g1 + g2);
+                t[3][j] = g2;
+            }
+
+            // U = t G^T
+            float* dst = u + (size_t)o * in_c + c;
+            for (int i = 0; i < 4; i++) {
+                dst[(i * 4 + 0) * stride] = t[i][0];
+                dst[(i * 4 + 1) * stride] = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+                dst[(i * 4 + 2) * stride] = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+                dst[(i * 4 + 3) * stride] = t[i][2];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Copy one block of lanes, with a constant size for full blocks
+ */
+static inline void conv_copy_lanes(float* dst, const float* src, int lanes) {
+    if (lanes == CONV_WINOGRAD_LANES) {
+        memcpy(dst, src, sizeof(ConvLanes));
+    } else {
+        memcpy(dst, src, (size_t)lanes * sizeof(float));
+    }
+}
+
+/**
+ * @brief Image and top-left output pixel of a tile within a chunk
+ */
+typedef struct {
+    int image;                  // Image within the chunk
+    int y0, x0;                 // Top-left output pixel of the tile
+} ConvTilePos;
+
+static inline ConvTilePos conv_tile_position(const ConvPlan* plan, size_t tile) {
+    int tiles = plan->tiles_h * plan->tiles_w;
+    int local = (int)(tile % tiles);
+    ConvTilePos pos = { (int)(tile / tiles), 2 * (local / plan->tiles_w), 2 * (local % plan->tiles_w) };
+    return pos;
+}
+
+/**
+ * @brief v = B^T d B on a block of lanes (independent tiles or channels)
+ */
+static void conv_winograd_input_lanes(ConvLanes d[16], ConvLanes v[16]) {
+    ConvLanes t[16];
+
+    // t = B^T d  (B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1])
+    for (int j = 0; j < 4; j++) {
+        for (int l = 0; l < CONV_WINOGRAD_LANES; l++) {
+            t[0 + j][l] = d[0 + j][l] - d[8 + j][l];
+            t[4 + j][l] = d[4 + j][l] + d[8 + j][l];
+            t[8 + j][l] = d[8 + j][l] - d[4 + j][l];
+            t[12 + j][l] = d[4 + j][l] - d[12 + j][l];
+        }
+    }
+
+    // v = t B
+    for (int i = 0; i < 4; i++) {
+        ConvLanes* r = t + i * 4;
+        for (int l = 0; l < CONV_WINOGRAD_LANES; l++) {
+            v[i * 4 + 0][l] = r[0][l] - r[2][l];
+            v[i * 4 + 1][l] = r[1][l] + r[2][l];
+            v[i * 4 + 2][l] = r[2][l] - r[1][l];
+            v[i * 4 + 3][l] = r[1][l] - r[3][l];
+        }
+    }
+}
+
+/**
+ * @brief y = act(A^T m A + bias) on a block of lanes: 2x2 outputs per lane
+ */
+static void conv_winograd_output_lanes(ConvLanes m[16], const float* bias, GemmActivation kind,
+                                       ConvLanes y[4]) {
+    ConvLanes s[8];
+
+    // s = A^T m  (A^T = [1 1 1 0; 0 1 -1 -1])
+    for (int j = 0; j < 4; j++) {
+        for (int l = 0; l < CONV_WINOGRAD_LANES; l++) {
+            s[j][l] = m[j][l] + m[4 + j][l] + m[8 + j][l];
+            s[4 + j][l] = m[4 + j][l] - m[8 + j][l] - m[12 + j][l];
+        }
+    }
+
+    for (int r = 0; r < 2; r++) {
+        ConvLanes* sr = s + r * 4;
+        for (int l = 0; l < CONV_WINOGRAD_LANES; l++) {
+            y[r * 2 + 0][l] = conv_activate(kind, sr[0][l] + sr[1][l] + sr[2][l] + bias[l]);
+            y[r * 2 + 1][l] = conv_activate(kind, sr[1][l] - sr[2][l] - sr[3][l] + bias[l]);
+        }
+    }
+}
+
+#ifdef CONV_HAVE_X86
+
+// The same transforms with one zmm register per point. ReLU-style
+// activations are max(x, slope * x); slope 1 gives the identity.
+
+__attribute__((target("avx512f")))
+static inline void conv_winograd_input_zmm(__m512 d[16]) {
+    __m512 t[16];
+
+    for (int j = 0; j < 4; j++) {
+        t[0 + j] = _mm512_sub_ps(d[0 + j], d[8 + j]);
+        t[4 + j] = _mm512_add_ps(d[4 + j], d[8 + j]);
+        t[8 + j] = _mm512_sub_ps(d[8 + j], d[4 + j]);
+        t[12 + j] = _mm512_sub_ps(d[4 + j], d[12 + j]);
+    }
+    for (int i = 0; i < 4; i++) {
+        d[i * 4 + 0] = _mm512_sub_ps(t[i * 4 + 0], t[i * 4 + 2]);
+        d[i * 4 + 1] = _mm512_add_ps(t[i * 4 + 1], t[i * 4 + 2]);
+        d[i * 4 + 2] = _mm512_sub_ps(t[i * 4 + 2], t[i * 4 + 1]);
+        d[i * 4 + 3] = _mm512_sub_ps(t[i * 4 + 1], t[i * 4 + 3]);
+    }
+}
+
+__attribute__((target("avx512f")))
+static inline void conv_winograd_output_zmm(const __m512 m[16], __m512 bias, __m512 slope,
+                                            __m512 y[4]) {
+    __m512 s[8];
+
+    for (int j = 0; j < 4; j++) {
+        s[j] = _mm512_add_ps(_mm512_add_ps(m[j], m[4 + j]), m[8 + j]);
+        s[4 + j] = _mm512_sub_ps(_mm512_sub_ps(m[4 + j], m[8 + j]), m[12 + j]);
+    }
+    for (int r = 0; r < 2; r++) {
+        const __m512* sr = s + r * 4;
+        __m512 y0 = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(sr[0], sr[1]), sr[2]), bias);
+        __m512 y1 = _mm512_add_ps(_mm512_sub_ps(_mm512_sub_ps(sr[1], sr[2]), sr[3]), bias);
+        y[r * 2 + 0] = _mm512_max_ps(y0, _mm512_mul_ps(y0, slope));
+        y[r * 2 + 1] = _mm512_max_ps(y1, _mm512_mul_ps(y1, slope));
+    }
+}
+
+static inline __mmask16 conv_lane_mask(int lanes) {
+    return lanes >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << lanes) - 1);
+}
+
+/**
+ * @brief NCHW input block: lanes are 16 neighbouring tiles of one tile row
+ *
+ * Tile l reads columns 2l..2l+3, so each row splits into even/odd columns of
+ * two overlapping 32-float loads.
+ */
+__attribute__((target("avx512f")))
+static void conv_winograd_input_nchw_avx512(const float* src, int padded_w, float* v,
+                                            size_t point_stride, int lanes) {
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    __m512 d[16];
+
+    for (int r = 0; r < 4; r++) {
+        const float* row = src + (size_t)r * padded_w;
+        __m512 a = _mm512_loadu_ps(row), b = _mm512_loadu_ps(row + 16);
+        __m512 a2 = _mm512_loadu_ps(row + 2), b2 = _mm512_loadu_ps(row + 18);
+        d[r * 4 + 0] = _mm512_permutex2var_ps(a, even, b);
+        d[r * 4 + 1] = _mm512_permutex2var_ps(a, odd, b);
+        d[r * 4 + 2] = _mm512_permutex2var_ps(a2, even, b2);
+        d[r * 4 + 3] = _mm512_permutex2var_ps(a2, odd, b2);
+    }
+
+    conv_winograd_input_zmm(d);
+    __mmask16 mask = conv_lane_mask(lanes);
+    for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+        _mm512_mask_storeu_ps(v + p * point_stride, mask, d[p]);
+    }
+}
+
+/**
+ * @brief NHWC input block: lanes are 16 channels of one tile
+ * @param taps The 16 input pixels of the tile (NULL = zero padding)
+ */
+__attribute__((target("avx512f")))
+static void conv_winograd_input_nhwc_avx512(const float* const taps[16], float* v,
+                                            size_t point_stride, int lanes) {
+    __mmask16 mask = conv_lane_mask(lanes);
+    __m512 d[16];
+
+    for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+        d[p] = taps[p] ? _mm512_maskz_loadu_ps(mask, taps[p]) : _mm512_setzero_ps();
+    }
+    conv_winograd_input_zmm(d);
+    for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+        _mm512_mask_storeu_ps(v + p * point_stride, mask, d[p]);
+    }
+}
+
+/**
+ * @brief NCHW output block: interleave 16 tiles' 2x2 results into two rows
+ */
+__attribute__((target("avx512f")))
+static void conv_winograd_output_nchw_avx512(const float* m, size_t point_stride, float bias,
+                                             float slope, float* dst, int out_w, int valid_rows,
+                                             int valid_cols, int lanes) {
+    const __m512i lo = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    const __m512i hi = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    __mmask16 mask = conv_lane_mask(lanes);
+    __m512 mt[16], y[4];
+
+    for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) mt[p] = _mm512_maskz_loadu_ps(mask, m + p * point_stride);
+    conv_winograd_output_zmm(mt, _mm512_set1_ps(bias), _mm512_set1_ps(slope), y);
+
+    __mmask16 mask_lo = conv_lane_mask(valid_cols);
+    __mmask16 mask_hi = valid_cols > 16 ? conv_lane_mask(valid_cols - 16) : 0;
+    for (int r = 0; r < valid_rows; r++) {
+        float* row = dst + (size_t)r * out_w;
+        _mm512_mask_storeu_ps(row, mask_lo, _mm512_permutex2var_ps(y[r * 2], lo, y[r * 2 + 1]));
+        if (mask_hi) _mm512_mask_storeu_ps(row + 16, mask_hi, _mm512_permutex2var_ps(y[r * 2], hi, y[r * 2 + 1]));
+    }
+}
+
+/**
+ * @brief NHWC output block: lanes are 16 channels of one tile
+ * @param outs Destination of each of the 2x2 pixels (NULL = outside the image)
+ */
+__attribute__((target("avx512f")))
+static void conv_winograd_output_nhwc_avx512(const float* m, size_t point_stride, const float* bias,
+                                             float slope, float* const outs[4], int lanes) {
+    __mmask16 mask = conv_lane_mask(lanes);
+    __m512 mt[16], y[4];
+
+    for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) mt[p] = _mm512_maskz_loadu_ps(mask, m + p * point_stride);
+    __m512 b = bias ? _mm512_maskz_loadu_ps(mask, bias) : _mm512_setzero_ps();
+    conv_winograd_output_zmm(mt, b, _mm512_set1_ps(slope), y);
+
+    for (int i = 0; i < 4; i++) {
+        if (outs[i]) _mm512_mask_storeu_ps(outs[i], mask, y[i]);
+    }
+}
+
+static bool conv_has_avx512(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx512f") ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+#endif
+
+/**
+ * @brief Whether the AVX-512 transforms can run this activation
+ * @param slope Set to the max(x, slope * x) slope for the activation
+ */
+static bool conv_winograd_vectorized(GemmActivation kind, float* slope) {
+#ifdef CONV_HAVE_X86
+    if (!conv_has_avx512()) return false;
+    switch (kind) {
+        case GEMM_ACTIVATION_NONE: *slope = 1.0f; return true;
+        case GEMM_ACTIVATION_RELU: *slope = 0.0f; return true;
+        case GEMM_ACTIVATION_LEAKY_RELU: *slope = GEMM_LEAKY_RELU_SLOPE; return true;
+        default: return false;
+    }
+#else
+    (void)kind;
+    (void)slope;
+    return false;
+#endif
+}
+
+/**
+ * @brief Transform the input tiles of `count` images into V
+ *
+ * NCHW stores V[point][channel][tile] and runs lanes along a tile row;
+ * NHWC stores V[point][tile][channel] and runs lanes over channels, so
+ * both read and write V contiguously.
+ */
+static void conv_winograd_inputs(const ConvShape* shape, const ConvPlan* plan,
+                                 const float* images, int count, float* padded, float* v) {
+    const int h = shape->in_height, w = shape->in_width, in_c = shape->in_channels;
+    const int pad = shape->padding;
+    const size_t total = (size_t)count * plan->tiles_h * plan->tiles_w;
+    const size_t point_stride = (size_t)in_c * total + CONV_WINOGRAD_SKEW;
+    const size_t image_in = (size_t)in_c * h * w;
+    float unused_slope;
+    const bool simd = conv_winograd_vectorized(GEMM_ACTIVATION_NONE, &unused_slope);
+    ConvLanes d[16], t[16];
+
+    if (shape->layout == CONV_LAYOUT_NCHW) {
+        // Stage zero-padded planes so every tile gather is branch-free
+        const int padded_h = 2 * plan->tiles_h + 2, padded_w = conv_winograd_padded_width(plan);
+        const size_t padded_plane = (size_t)padded_h * padded_w;
+        memset(padded, 0, (size_t)count * in_c * padded_plane * sizeof(float));
+        for (int i = 0; i < count; i++) {
+            for (int c = 0; c < in_c; c++) {
+                const float* src = images + i * image_in + (size_t)c * h * w;
+                float* dst = padded + ((size_t)i * in_c + c) * padded_plane +
+                             (size_t)pad * padded_w + pad;
+                for (int y = 0; y < h; y++) {
+                    memcpy(dst + (size_t)y * padded_w, src + (size_t)y * w, (size_t)w * sizeof(float));
+                }
+            }
+        }
+
+        // Lanes are neighbouring tiles of one tile row: lane l starts at column 2l
+        for (int i = 0; i < count; i++) {
+            for (int ty = 0; ty < plan->tiles_h; ty++) {
+                for (int tx0 = 0; tx0 < plan->tiles_w; tx0 += CONV_WINOGRAD_LANES) {
+                    int lanes = (plan->tiles_w - tx0 < CONV_WINOGRAD_LANES) ? plan->tiles_w - tx0
+                                                                            : CONV_WINOGRAD_LANES;
+                    size_t tile0 = ((size_t)i * plan->tiles_h + ty) * plan->tiles_w + tx0;
+
+                    for (int c = 0; c < in_c; c++) {
+                        const float* src = padded + ((size_t)i * in_c + c) * padded_plane +
+                                           (size_t)(2 * ty) * padded_w + 2 * tx0;
+                        float* dst = v + (size_t)c * total + tile0;
+#ifdef CONV_HAVE_X86
+                        if (simd) {
+                            conv_winograd_input_nchw_avx512(src, padded_w, dst, point_stride, lanes);
+                            continue;
+                        }
+#endif
+                        for (int r = 0; r < 4; r++) {
+                            const float* row = src + (size_t)r * padded_w;
+                            for (int q = 0; q < 4; q++) {
+                                for (int l = 0; l < CONV_WINOGRAD_LANES; l++) d[r * 4 + q][l] = row[2 * l + q];
+                            }
+                        }
+                        conv_winograd_input_lanes(d, t);
+                        for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+                            conv_copy_lanes(dst + p * point_stride, t[p], lanes);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    const float* taps[16];
+    for (size_t tile = 0; tile < total; tile++) {
+        ConvTilePos pos = conv_tile_position(plan, tile);
+        const float* image = images + pos.image * image_in;
+        int y0 = pos.y0 - pad, x0 = pos.x0 - pad;
+
+        for (int r = 0; r < 4; r++) {
+            for (int q = 0; q < 4; q++) {
+                int iy = y0 + r, ix = x0 + q;
+                bool inside = iy >= 0 && iy < h && ix >= 0 && ix < w;
+                taps[r * 4 + q] = inside ? image + ((size_t)iy * w + ix) * in_c : NULL;
+            }
+        }
+
+        for (int c0 = 0; c0 < in_c; c0 += CONV_WINOGRAD_LANES) {
+            int lanes = (in_c - c0 < CONV_WINOGRAD_LANES) ? in_c - c0 : CONV_WINOGRAD_LANES;
+            float* dst = v + tile * in_c + c0;
+#ifdef CONV_HAVE_X86
+            if (simd) {
+                const float* shifted[16];
+                for (int p = 0; p < 16; p++) shifted[p] = taps[p] ? taps[p] + c0 : NULL;
+                conv_winograd_input_nhwc_avx512(shifted, dst, point_stride, lanes);
+                continue;
+            }
+#endif
+            for (int p = 0; p < 16; p++) {
+                if (taps[p]) {
+                    conv_copy_lanes(d[p], taps[p] + c0, lanes);
+                } else {
+                    memset(d[p], 0, sizeof(ConvLanes));
+                }
+            }
+            conv_winograd_input_lanes(d, t);
+            for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+                conv_copy_lanes(dst + p * point_stride, t[p], lanes);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Inverse-transform M into unpooled outputs with bias and activation
+ */
+static void conv_winograd_outputs(const ConvShape* shape, const ConvPlan* plan,
+                                  const float* m, int count, const float* biases,
+                                  GemmActivation kind, float* output) {
+    const int out_c = shape->out_channels;
+    const int out_h = plan->out_h, out_w = plan->out_w;
+    const size_t total = (size_t)count * plan->tiles_h * plan->tiles_w;
+    const size_t point_stride = (size_t)out_c * total + CONV_WINOGRAD_SKEW;
+    float slope = 1.0f;
+    const bool simd = conv_winograd_vectorized(kind, &slope);
+    ConvLanes mt[16], y[4], bias;
+
+    if (shape->layout == CONV_LAYOUT_NCHW) {
+        float rows[2][2 * CONV_WINOGRAD_LANES];
+
+        for (int i = 0; i < count; i++) {
+            for (int ty = 0; ty < plan->tiles_h; ty++) {
+                int valid_rows = (out_h - 2 * ty < 2) ? out_h - 2 * ty : 2;
+
+                for (int tx0 = 0; tx0 < plan->tiles_w; tx0 += CONV_WINOGRAD_LANES) {
+                    int lanes = (plan->tiles_w - tx0 < CONV_WINOGRAD_LANES) ? plan->tiles_w - tx0
+                                                                            : CONV_WINOGRAD_LANES;
+                    int valid_cols = (out_w - 2 * tx0 < 2 * lanes) ? out_w - 2 * tx0 : 2 * lanes;
+                    size_t tile0 = ((size_t)i * plan->tiles_h + ty) * plan->tiles_w + tx0;
+
+                    for (int o = 0; o < out_c; o++) {
+                        const float* src = m + (size_t)o * total + tile0;
+                        float* dst = output + ((size_t)i * out_c + o) * plan->pixels +
+                                     (size_t)(2 * ty) * out_w + 2 * tx0;
+                        float b = biases ? biases[o] : 0.0f;
+#ifdef CONV_HAVE_X86
+                        if (simd) {
+                            conv_winograd_output_nchw_avx512(src, point_stride, b, slope, dst, out_w,
+                                                             valid_rows, valid_cols, lanes);
+                            continue;
+                        }
+#endif
+                        for (int l = 0; l < CONV_WINOGRAD_LANES; l++) bias[l] = b;
+                        for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+                            conv_copy_lanes(mt[p], src + p * point_stride, lanes);
+                        }
+                        conv_winograd_output_lanes(mt, bias, kind, y);
+
+                        // Interleave the 2x2 results back into two output rows
+                        for (int r = 0; r < 2; r++) {
+                            for (int l = 0; l < CONV_WINOGRAD_LANES; l++) {
+                                rows[r][2 * l] = y[r * 2][l];
+                                rows[r][2 * l + 1] = y[r * 2 + 1][l];
+                            }
+                        }
+                        for (int r = 0; r < valid_rows; r++) {
+                            memcpy(dst + (size_t)r * out_w, rows[r], (size_t)valid_cols * sizeof(float));
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    float* outs[4];
+    for (size_t tile = 0; tile < total; tile++) {
+        ConvTilePos pos = conv_tile_position(plan, tile);
+        float* image = output + (size_t)pos.image * plan->pixels * out_c;
+
+        for (int r = 0; r < 2; r++) {
+            for (int q = 0; q < 2; q++) {
+                int oy = pos.y0 + r, ox = pos.x0 + q;
+                outs[r * 2 + q] = (oy < out_h && ox < out_w)
+                                      ? image + ((size_t)oy * out_w + ox) * out_c : NULL;
+            }
+        }
+
+        for (int o0 = 0; o0 < out_c; o0 += CONV_WINOGRAD_LANES) {
+            int lanes = (out_c - o0 < CONV_WINOGRAD_LANES) ? out_c - o0 : CONV_WINOGRAD_LANES;
+            const float* src = m + tile * out_c + o0;
+#ifdef CONV_HAVE_X86
+            if (simd) {
+                float* shifted[4];
+                for (int i = 0; i < 4; i++) shifted[i] = outs[i] ? outs[i] + o0 : NULL;
+                conv_winograd_output_nhwc_avx512(src, point_stride, biases ? biases + o0 : NULL,
+                                                 slope, shifted, lanes);
+                continue;
+            }
+#endif
+            for (int l = 0; l < lanes; l++) bias[l] = biases ? biases[o0 + l] : 0.0f;
+            for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+                conv_copy_lanes(mt[p], src + p * point_stride, lanes);
+            }
+            conv_winograd_output_lanes(mt, bias, kind, y);
+
+            for (int i = 0; i < 4; i++) {
+                if (outs[i]) conv_copy_lanes(outs[i] + o0, y[i], lanes);
+            }
+        }
+    }
+}
+
+static bool conv_winograd_forward(const ConvShape* shape, const ConvPlan* plan,
+                                  const float* input, const float* kernels, const float* biases,
+                                  GemmActivation kind, float* output, int* max_indices,
+                                  float* workspace) {
+    const int in_c = shape->in_channels, out_c = shape->out_channels;
+    const size_t image_in = (size_t)in_c * shape->in_height * shape->in_width;
+    const size_t image_out = (size_t)out_c * plan->pixels;
+    const int tiles = plan->tiles_h * plan->tiles_w;
+    const bool pooled = shape->pool_size > 0;
+
+    float* u = workspace;
+    float* v = u + plan->weights;
+    float* m = v + plan->col;
+    float* padded = m + plan->gemm_out;
+    float* conv_tile = padded + plan->padded;
+
+    conv_winograd_kernels(shape, kernels, u);
+
+    for (int n0 = 0; n0 < shape->batch; n0 += plan->chunk) {
+        int count = (shape->batch - n0 < plan->chunk) ? shape->batch - n0 : plan->chunk;
+        int total_tiles = count * tiles;
+
+        conv_winograd_inputs(shape, plan, input + (size_t)n0 * image_in, count, padded, v);
+
+        for (int p = 0; p < CONV_WINOGRAD_POINTS; p++) {
+            const float* up = u + (size_t)p * out_c * in_c;
+            const float* vp = v + p * ((size_t)in_c * total_tiles + CONV_WINOGRAD_SKEW);
+            float* mp = m + p * ((size_t)out_c * total_tiles + CONV_WINOGRAD_SKEW);
+
+            bool ok;
+            if (shape->layout == CONV_LAYOUT_NCHW) {
+                // M (out_c x tiles) = U (out_c x in_c) * V (in_c x tiles)
+                ok = gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, out_c, total_tiles, in_c, 1.0f,
+                                up, in_c, vp, total_tiles, 0.0f, mp, total_tiles);
+            } else {
+                // M (tiles x out_c) = V (tiles x in_c) * U^T
+                ok = gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, total_tiles, out_c, in_c, 1.0f,
+                                vp, in_c, up, in_c, 0.0f, mp, out_c);
+            }
+            if (!ok) return false;
+        }
+
+        float* dst = pooled ? conv_tile : output + (size_t)n0 * image_out;
+        conv_winograd_outputs(shape, plan, m, count, biases, kind, dst);
+
+        if (pooled) conv_max_pool(shape, plan, conv_tile, n0, count, output, max_indices);
+    }
+    return true;
+}
+
+bool conv2d_forward(const ConvShape* shape, ConvAlgorithm algorithm,
+                    const Tensor* input, const Tensor* kernels, const Tensor* biases,
+                    DenseActivationFn activation, Tensor* output,
+                    int* max_indices, float* workspace) {
+    ConvPlan plan;
+    if (!conv_plan(shape, algorithm, &plan)) return false;
+    if (!conv_tensors_valid(shape, &plan, input, kernels, output)) return false;
+    if (biases && biases->size != shape->out_channels) return false;
+
+    GemmActivation kind;
+    if (!dense_activation_kind(activation, &kind)) return false;
+
+    float* owned;
+    float* scratch = conv_workspace_acquire(workspace, conv_plan_forward_size(&plan), &owned);
+    if (!scratch && conv_plan_forward_size(&plan) > 0) return false;
+
+    const float* bias = biases ? biases->data : NULL;
+    bool ok;
+    if (plan.algorithm == CONV_ALGO_WINOGRAD) {
+        ok = conv_winograd_forward(shape, &plan, input->data, kernels->data, bias, kind,
+                                   output->data, max_indices, scratch);
+    } else {
+        ok = conv_im2col_forward(shape, &plan, input->data, kernels->data, bias, kind,
+                                 output->data, max_indices, scratch);
+    }
+
+    free(owned);
+    return ok;
+}
+
+// ============================================================================
+// Backward
+// ============================================================================
+
+/**
+ * @brief Route the pooled gradient to each window's argmax, times act'(y)
+ *
+ * The pooled output is the activation value at the argmax, so the
+ * derivative needs no unpooled forward output. Bias sums ride along.
+ */
+static void conv_unpool_delta(const ConvShape* shape, const ConvPlan* plan,
+                              const float* pooled_output, const int* max_indices,
+                              const float* grad, GemmActivation kind,
+                              float* delta, float* bias_grad) {
+    const size_t count = (size_t)shape->batch * shape->out_channels * plan->pool_h * plan->pool_w;
+    const bool nchw = shape->layout == CONV_LAYOUT_NCHW;
+
+    memset(delta, 0, plan->conv_delta * sizeof(float));
+
+    for (size_t p = 0; p < count; p++) {
+        int index = max_indices[p];
+        float d = grad[p] * conv_activation_slope(kind, pooled_output[p]);
+        delta[index] += d;
+        if (bias_grad) {
+            int channel = nchw ? (index / plan->pixels) % shape->out_channels
+                               : index % shape->out_channels;
+            bias_grad[channel] += d;
+        }
+    }
+}
+
+bool conv2d_backward(const ConvShape* shape, const Tensor* input, const Tensor* kernels,
+                     const Tensor* output, const int* max_indices,
+                     DenseActivationFn activation, Tensor* grad_output,
+                     Tensor* kernel_gradients, Tensor* bias_gradients,
+                     Tensor* grad_input, bool accumulate, float* workspace) {
+    ConvPlan plan;
+    if (!conv_plan(shape, CONV_ALGO_IM2COL, &plan)) return false;
+    if (!conv_tensors_valid(shape, &plan, input, kernels, output)) return false;
+    if (!grad_output || grad_output->size != output->size) return false;
+    if (!kernel_gradients || kernel_gradients->size != kernels->size) return false;
+    if (bias_gradients && bias_gradients->size != shape->out_channels) return false;
+    if (grad_input && grad_input->size != input->size) return false;
+
+    const bool pooled = shape->pool_size > 0;
+    if (pooled && !max_indices) return false;
+
+    GemmActivation kind;
+    if (!dense_activation_kind(activation, &kind)) return false;
+
+    float* owned;
+    size_t scratch_size = conv_plan_backward_size(&plan);
+    float* scratch = conv_workspace_acquire(workspace, scratch_size, &owned);
+    if (!scratch && scratch_size > 0) return false;
+
+    float* weights = scratch;
+    float* weight_grad = weights + plan.backward_weights;
+    float* col = weight_grad + plan.weight_grad;
+    float* dcol = col + plan.backward_col;
+    float* conv_delta = dcol + plan.dcol;
+
+    const int in_c = shape->in_channels, out_c = shape->out_channels;
+    const size_t image_in = (size_t)in_c * shape->in_height * shape->in_width;
+    const size_t image_out = (size_t)out_c * plan.pixels;
+    const float* x = input->data;
+    const float* w = kernels->data;
+    float* dw = kernel_gradients->data;
+    float* dx = grad_input ? grad_input->data : NULL;
+
+    float* bias_grad = NULL;
+    if (bias_gradients) {
+        bias_grad = bias_gradients->data;
+        if (!accumulate) memset(bias_grad, 0, (size_t)out_c * sizeof(float));
+    }
+
+    // delta: the gradient w.r.t. the pre-activation, unpooled output
+    float* delta;
+    if (pooled) {
+        conv_unpool_delta(shape, &plan, output->data, max_indices, grad_output->data,
+                          kind, conv_delta, bias_grad);
+        delta = conv_delta;
+    } else if (shape->layout == CONV_LAYOUT_NHWC) {
+        dense_activation_delta(kind, output->data, grad_output->data, bias_grad,
+                               shape->batch * plan.pixels, out_c);
+        delta = grad_output->data;
+    } else {
+        dense_activation_delta(kind, output->data, grad_output->data, NULL,
+                               shape->batch * out_c, plan.pixels);
+        delta = grad_output->data;
+        if (bias_grad) {
+            for (int n = 0; n < shape->batch; n++) {
+                for (int o = 0; o < out_c; o++) {
+                    const float* plane = delta + (size_t)n * image_out + (size_t)o * plan.pixels;
+                    float sum = 0.0f;
+                    for (int i = 0; i < plan.pixels; i++) sum += plane[i];
+                    bias_grad[o] += sum;
+                }
+            }
+        }
+    }
+
+    bool ok = true;
+    if (shape->layout == CONV_LAYOUT_NCHW) {
+        for (int n = 0; ok && n < shape->batch; n++) {
+            const float* image = x + (size_t)n * image_in;
+            const float* d = delta + (size_t)n * image_out;
+            const float* patches = image;
+
+            if (!plan.direct) {
+                conv_im2col_nchw(shape, &plan, image, col);
+                patches = col;
+            }
+
+            // dW (out_c x depth) += delta (out_c x pixels) * col^T
+            ok = gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, out_c, plan.depth, plan.pixels, 1.0f,
+                            d, plan.pixels, patches, plan.pixels,
+                            (n > 0 || accumulate) ? 1.0f : 0.0f, dw, plan.depth);
+
+            // dcol (depth x pixels) = W^T * delta
+            if (ok && dx) {
+                float* dx_image = dx + (size_t)n * image_in;
+                if (plan.direct) {
+                    ok = gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, in_c, plan.pixels, out_c, 1.0f,
+                                    w, in_c, d, plan.pixels, 0.0f, dx_image, plan.pixels);
+                } else {
+                    ok = gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, plan.depth, plan.pixels, out_c, 1.0f,
+                                    w, plan.depth, d, plan.pixels, 0.0f, dcol, plan.pixels);
+                    memset(dx_image, 0, image_in * sizeof(float));
+                    conv_col2im_nchw(shape, &plan, dcol, dx_image);
+                }
+            }
+        }
+    } else {
+        const float* weights_used = w;
+        float* weight_grad_used = dw;
+        if (!plan.direct) {
+            conv_reorder_kernels_nhwc(shape, w, weights);
+            weights_used = weights;
+            weight_grad_used = weight_grad;
+        }
+
+        for (int n0 = 0; ok && n0 < shape->batch; n0 += plan.backward_chunk) {
+            int count = (shape->batch - n0 < plan.backward_chunk) ? shape->batch - n0
+                                                                  : plan.backward_chunk;
+            int rows = count * plan.pixels;
+            const float* images = x + (size_t)n0 * image_in;
+            const float* d = delta + (size_t)n0 * image_out;
+            const float* patches = images;
+
+            if (!plan.direct) {
+                for (int i = 0; i < count; i++) {
+                    conv_im2col_nhwc(shape, &plan, images + (size_t)i * image_in,
+                                     col + (size_t)i * plan.pixels * plan.depth);
+                }
+                patches = col;
+            }
+
+            // dW' (out_c x depth) += delta^T (out_c x rows) * col (rows x depth)
+            bool add = n0 > 0 || (plan.direct && accumulate);
+            ok = gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, out_c, plan.depth, rows, 1.0f,
+                            d, out_c, patches, plan.depth,
+                            add ? 1.0f : 0.0f, weight_grad_used, plan.depth);
+
+            // dcol (rows x depth) = delta (rows x out_c) * W'
+            if (ok && dx) {
+                float* dx_images = dx + (size_t)n0 * image_in;
+                if (plan.direct) {
+                    ok = gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, rows, in_c, out_c, 1.0f,
+                                    d, out_c, w, in_c, 0.0f, dx_images, in_c);
+                } else {
+                    ok = gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, rows, plan.depth, out_c, 1.0f,
+                                    d, out_c, weights_used, plan.depth, 0.0f, dcol, plan.depth);
+                    memset(dx_images, 0, (size_t)count * image_in * sizeof(float));
+                    for (int i = 0; i < count; i++) {
+                        conv_col2im_nhwc(shape, &plan, dcol + (size_t)i * plan.pixels * plan.depth,
+                                         dx_images + (size_t)i * image_in);
+                    }
+                }
+            }
+        }
+
+        if (ok && !plan.direct) conv_restore_kernel_grad_nhwc(shape, weight_grad, dw, accumulate);
+    }
+
+    free(owned);
+    return ok;
+}
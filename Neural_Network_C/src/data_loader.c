@@ -0,0 +1,512 @@
+/*
+ * Neural Network System - Streaming Data Loader Implementation
+ * Dataset file writer, per-epoch shuffled record order, a producer thread
+ * filling two batch buffers ahead of the training loop
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L     // pread, posix_fadvise, posix_madvise
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../headers/data_loader.h"
+#include "../headers/tensor_arena.h"
+
+#ifndef _WIN32
+#define DATA_LOADER_HAVE_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+typedef char data_file_header_is_64_bytes[sizeof(DataFileHeader) == DATA_FILE_HEADER_SIZE ? 1 : -1];
+
+// ============================================================================
+// Dataset Files
+// ============================================================================
+
+bool data_file_create(DataFileWriter* writer, const char* path, int sample_size, int target_size) {
+    if (!writer || !path || sample_size <= 0 || target_size < 0) return false;
+
+    memset(writer, 0, sizeof(DataFileWriter));
+    memcpy(writer->header.magic, DATA_FILE_MAGIC, sizeof(DATA_FILE_MAGIC));
+    writer->header.version = DATA_FILE_VERSION;
+    writer->header.header_size = DATA_FILE_HEADER_SIZE;
+    writer->header.sample_size = (uint32_t)sample_size;
+    writer->header.target_size = (uint32_t)target_size;
+
+    writer->file = fopen(path, "wb");
+    if (!writer->file) {
+        fprintf(stderr, "Data file: cannot create %s\n", path);
+        return false;
+    }
+
+    // Placeholder header; data_file_finish rewrites it with the record count
+    if (fwrite(&writer->header, sizeof(DataFileHeader), 1, writer->file) != 1) {
+        fclose(writer->file);
+        writer->file = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool data_file_append(DataFileWriter* writer, const float* x, const float* y, int count) {
+    if (!writer || !writer->file || !x || (!y && writer->header.target_size > 0) || count < 0) {
+        return false;
+    }
+
+    size_t sample_size = writer->header.sample_size;
+    size_t target_size = writer->header.target_size;
+
+    for (int i = 0; i < count; i++) {
+        if (fwrite(x + i * sample_size, sizeof(float), sample_size, writer->file) != sample_size) return false;
+        if (target_size > 0 &&
+            fwrite(y + i * target_size, sizeof(float), target_size, writer->file) != target_size) {
+            return false;
+        }
+    }
+    writer->header.num_records += (uint64_t)count;
+    return true;
+}
+
+bool data_file_finish(DataFileWriter* writer) {
+    if (!writer || !writer->file) return false;
+
+    bool ok = fseek(writer->file, 0, SEEK_SET) == 0 &&
+              fwrite(&writer->header, sizeof(DataFileHeader), 1, writer->file) == 1;
+    ok = (fclose(writer->file) == 0) && ok;
+    writer->file = NULL;
+    return ok;
+}
+
+bool data_file_write_tensors(const char* path, const Tensor* x, const Tensor* y) {
+    if (!x || !y || x->ndim < 1 || y->ndim < 1 || x->shape[0] <= 0 || x->shape[0] != y->shape[0]) {
+        return false;
+    }
+
+    int count = x->shape[0];
+    DataFileWriter writer;
+    if (!data_file_create(&writer, path, x->size / count, y->size / count)) return false;
+
+    bool ok = data_file_append(&writer, x->data, y->data, count);
+    return data_file_finish(&writer) && ok;
+}
+
+// ============================================================================
+// Loader Structures
+// ============================================================================
+
+typedef enum {
+    SLOT_EMPTY,                     // Free for the producer
+    SLOT_FILLING,                   // Producer is writing it
+    SLOT_FULL                       // Ready for (or held by) the consumer
+} SlotState;
+
+struct DataLoader {
+    DataLoaderConfig config;        // Loader settings
+    DataFileHeader header;          // File header
+    size_t record_bytes;            // Bytes per record
+    int num_samples;                // Records in the file
+    int num_batches;                // Batches per epoch
+
+#ifdef DATA_LOADER_HAVE_POSIX_IO
+    int fd;                         // Open file (pread, and kept for fadvise)
+    unsigned char* map;             // Read-only mapping (mmap mode)
+    size_t map_length;              // Mapped bytes
+#else
+    FILE* file;                     // Open file (seek + read)
+#endif
+    float* record;                  // One-record read buffer (producer only)
+
+    uint32_t* order;                // Record order of the current epoch
+    int epoch;                      // Epochs started
+
+    Tensor* x[2];                   // Double-buffered batch inputs
+    Tensor* y[2];                   // Double-buffered batch targets
+
+    pthread_t thread;               // Prefetch thread
+    bool thread_started;            // Whether thread is running
+    pthread_mutex_t lock;           // Protects the fields below
+    pthread_cond_t changed;         // Signalled on every slot or epoch change
+    SlotState slot_state[2];        // State of each buffer
+    int next_fill;                  // Next batch the producer assembles
+    int next_take;                  // Next batch handed to the consumer
+    int held;                       // Slot the consumer holds (-1 = none)
+    bool epoch_active;              // Producer may fill batches
+    bool stopping;                  // Set by data_loader_close
+    bool failed;                    // A read failed this epoch
+};
+
+DataLoaderConfig data_loader_config_default(void) {
+    DataLoaderConfig config;
+    config.batch_size = 32;
+    config.shuffle = true;
+    config.drop_last = false;
+    config.prefetch = true;
+    config.io = DATA_LOADER_MMAP;
+    config.seed = 42;
+    return config;
+}
+
+/**
+ * @brief splitmix64 step; private state keeps shuffles reproducible and thread-safe
+ */
+static uint64_t loader_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static void loader_shuffle(DataLoader* loader) {
+    for (int i = 0; i < loader->num_samples; i++) loader->order[i] = (uint32_t)i;
+    if (!loader->config.shuffle) return;
+
+    uint64_t state = loader->config.seed + (uint64_t)loader->epoch;
+    for (int i = loader->num_samples - 1; i > 0; i--) {
+        int j = (int)(loader_random(&state) % (uint64_t)(i + 1));
+        uint32_t tmp = loader->order[i];
+        loader->order[i] = loader->order[j];
+        loader->order[j] = tmp;
+    }
+}
+
+// ============================================================================
+// Batch Assembly
+// ============================================================================
+
+static bool loader_read_record(DataLoader* loader, uint32_t index, float* x_row, float* y_row) {
+    size_t sample_bytes = (size_t)loader->header.sample_size * sizeof(float);
+    size_t target_bytes = (size_t)loader->header.target_size * sizeof(float);
+    uint64_t offset = DATA_FILE_HEADER_SIZE + (uint64_t)index * loader->record_bytes;
+    const unsigned char* src;
+
+#ifdef DATA_LOADER_HAVE_POSIX_IO
+    if (loader->map) {
+        src = loader->map + offset;
+    } else {
+        ssize_t got = pread(loader->fd, loader->record, loader->record_bytes, (off_t)offset);
+        if (got != (ssize_t)loader->record_bytes) return false;
+        src = (const unsigned char*)loader->record;
+    }
+#else
+    if (fseek(loader->file, (long)offset, SEEK_SET) != 0 ||
+        fread(loader->record, 1, loader->record_bytes, loader->file) != loader->record_bytes) {
+        return false;
+    }
+    src = (const unsigned char*)loader->record;
+#endif
+
+    memcpy(x_row, src, sample_bytes);
+    if (target_bytes) memcpy(y_row, src + sample_bytes, target_bytes);
+    return true;
+}
+
+/**
+ * @brief Gather batch index batch of the current order into buffer slot
+ */
+static bool loader_fill(DataLoader* loader, int batch, int slot) {
+    int begin = batch * loader->config.batch_size;
+    int rows = loader->num_samples - begin;
+    if (rows > loader->config.batch_size) rows = loader->config.batch_size;
+
+    Tensor* x = loader->x[slot];
+    Tensor* y = loader->y[slot];
+    int sample_size = (int)loader->header.sample_size;
+    int target_size = (int)loader->header.target_size;
+
+    // Buffers are allocated for a full batch; a short final batch just reports fewer rows
+    x->shape[0] = rows;
+    x->size = rows * sample_size;
+    y->shape[0] = rows;
+    y->size = rows * target_size;
+
+    for (int r = 0; r < rows; r++) {
+        if (!loader_read_record(loader, loader->order[begin + r], x->data + (size_t)r * sample_size,
+                                y->data + (size_t)r * target_size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void* loader_producer(void* arg) {
+    DataLoader* loader = (DataLoader*)arg;
+
+    pthread_mutex_lock(&loader->lock);
+    for (;;) {
+        while (!loader->stopping &&
+               !(loader->epoch_active && loader->next_fill < loader->num_batches &&
+                 loader->slot_state[loader->next_fill % 2] == SLOT_EMPTY)) {
+            pthread_cond_wait(&loader->changed, &loader->lock);
+        }
+        if (loader->stopping) break;
+
+        int batch = loader->next_fill;
+        int slot = batch % 2;
+        loader->slot_state[slot] = SLOT_FILLING;
+        pthread_mutex_unlock(&loader->lock);
+
+        bool ok = loader_fill(loader, batch, slot);
+
+        pthread_mutex_lock(&loader->lock);
+        loader->slot_state[slot] = SLOT_FULL;
+        loader->failed = loader->failed || !ok;
+        loader->next_fill++;
+        pthread_cond_broadcast(&loader->changed);
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return NULL;
+}
+
+// ============================================================================
+// Loader Management
+// ============================================================================
+
+static bool loader_open_file(DataLoader* loader, const char* path) {
+#ifdef DATA_LOADER_HAVE_POSIX_IO
+    loader->fd = open(path, O_RDONLY);
+    if (loader->fd < 0) return false;
+    if (pread(loader->fd, &loader->header, sizeof(DataFileHeader), 0) != (ssize_t)sizeof(DataFileHeader)) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(loader->fd, &info) != 0) return false;
+    loader->map_length = (size_t)info.st_size;
+#else
+    loader->file = fopen(path, "rb");
+    if (!loader->file || fread(&loader->header, sizeof(DataFileHeader), 1, loader->file) != 1) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+static bool loader_check_header(DataLoader* loader, const char* path) {
+    const DataFileHeader* header = &loader->header;
+    const char* problem = NULL;
+
+    if (memcmp(header->magic, DATA_FILE_MAGIC, sizeof(DATA_FILE_MAGIC)) != 0) {
+        problem = "not a dataset file";
+    } else if (header->version != DATA_FILE_VERSION || header->header_size != DATA_FILE_HEADER_SIZE) {
+        problem = "unsupported format version";
+    } else if (header->sample_size == 0 || header->num_records == 0 || header->num_records > INT32_MAX) {
+        problem = "empty or oversized dataset";
+    }
+
+    loader->record_bytes = ((size_t)header->sample_size + header->target_size) * sizeof(float);
+#ifdef DATA_LOADER_HAVE_POSIX_IO
+    if (!problem && loader->map_length < DATA_FILE_HEADER_SIZE + header->num_records * loader->record_bytes) {
+        problem = "truncated";
+    }
+#endif
+
+    if (problem) {
+        fprintf(stderr, "Data file %s: %s\n", path, problem);
+        return false;
+    }
+    return true;
+}
+
+DataLoader* data_loader_open(const char* path, DataLoaderConfig config) {
+    if (!path || config.batch_size <= 0) return NULL;
+
+    DataLoader* loader = (DataLoader*)calloc(1, sizeof(DataLoader));
+    if (!loader) return NULL;
+
+    loader->config = config;
+    loader->held = -1;
+    pthread_mutex_init(&loader->lock, NULL);
+    pthread_cond_init(&loader->changed, NULL);
+#ifdef DATA_LOADER_HAVE_POSIX_IO
+    loader->fd = -1;
+#endif
+
+    if (!loader_open_file(loader, path)) {
+        fprintf(stderr, "Data file %s: cannot open\n", path);
+        data_loader_close(loader);
+        return NULL;
+    }
+    if (!loader_check_header(loader, path)) {
+        data_loader_close(loader);
+        return NULL;
+    }
+
+    loader->num_samples = (int)loader->header.num_records;
+    loader->num_batches = config.drop_last ? loader->num_samples / config.batch_size
+                                           : (loader->num_samples + config.batch_size - 1) / config.batch_size;
+
+#ifdef DATA_LOADER_HAVE_POSIX_IO
+    if (config.io == DATA_LOADER_MMAP) {
+        void* map = mmap(NULL, loader->map_length, PROT_READ, MAP_SHARED, loader->fd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "Data file %s: mmap failed\n", path);
+            data_loader_close(loader);
+            return NULL;
+        }
+        loader->map = (unsigned char*)map;
+        posix_madvise(map, loader->map_length,
+                      config.shuffle ? POSIX_MADV_RANDOM : POSIX_MADV_SEQUENTIAL);
+    } else {
+        posix_fadvise(loader->fd, 0, 0, config.shuffle ? POSIX_FADV_RANDOM : POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+
+    // Batch buffers live as long as the loader, never in a caller's arena
+    TensorArena* previous = tensor_arena_activate(NULL);
+    int x_shape[2] = { config.batch_size, (int)loader->header.sample_size };
+    int y_shape[2] = { config.batch_size, loader->header.target_size > 0 ? (int)loader->header.target_size : 1 };
+    for (int s = 0; s < 2; s++) {
+        loader->x[s] = tensor_create(NULL, x_shape, 2);
+        loader->y[s] = tensor_create(NULL, y_shape, 2);
+    }
+    tensor_arena_activate(previous);
+
+    loader->order = (uint32_t*)malloc((size_t)loader->num_samples * sizeof(uint32_t));
+    loader->record = (float*)malloc(loader->record_bytes);
+    if (!loader->order || !loader->record || !loader->x[0] || !loader->x[1] ||
+        !loader->y[0] || !loader->y[1] || loader->num_batches == 0) {
+        data_loader_close(loader);
+        return NULL;
+    }
+
+    if (config.prefetch) {
+        if (pthread_create(&loader->thread, NULL, loader_producer, loader) != 0) {
+            data_loader_close(loader);
+            return NULL;
+        }
+        loader->thread_started = true;
+    }
+    return loader;
+}
+
+void data_loader_close(DataLoader* loader) {
+    if (!loader) return;
+
+    if (loader->thread_started) {
+        pthread_mutex_lock(&loader->lock);
+        loader->stopping = true;
+        pthread_cond_broadcast(&loader->changed);
+        pthread_mutex_unlock(&loader->lock);
+        pthread_join(loader->thread, NULL);
+    }
+
+#ifdef DATA_LOADER_HAVE_POSIX_IO
+    if (loader->map) munmap(loader->map, loader->map_length);
+    if (loader->fd >= 0) close(loader->fd);
+#else
+    if (loader->file) fclose(loader->file);
+#endif
+
+    for (int s = 0; s < 2; s++) {
+        if (loader->x[s]) tensor_destroy(loader->x[s]);
+        if (loader->y[s]) tensor_destroy(loader->y[s]);
+    }
+    free(loader->order);
+    free(loader->record);
+    pthread_cond_destroy(&loader->changed);
+    pthread_mutex_destroy(&loader->lock);
+    free(loader);
+}
+
+// ============================================================================
+// Epoch Iteration
+// ============================================================================
+
+bool data_loader_begin_epoch(DataLoader* loader) {
+    if (!loader) return false;
+
+    pthread_mutex_lock(&loader->lock);
+
+    // Let an in-flight batch of an abandoned epoch land before reusing the buffers
+    loader->epoch_active = false;
+    while (loader->slot_state[0] == SLOT_FILLING || loader->slot_state[1] == SLOT_FILLING) {
+        pthread_cond_wait(&loader->changed, &loader->lock);
+    }
+
+    loader_shuffle(loader);
+    loader->epoch++;
+    loader->slot_state[0] = SLOT_EMPTY;
+    loader->slot_state[1] = SLOT_EMPTY;
+    loader->next_fill = 0;
+    loader->next_take = 0;
+    loader->held = -1;
+    loader->failed = false;
+    loader->epoch_active = true;
+    pthread_cond_broadcast(&loader->changed);
+
+    pthread_mutex_unlock(&loader->lock);
+    return true;
+}
+
+bool data_loader_next(DataLoader* loader, Tensor** x, Tensor** y) {
+    if (!loader || !x || !y) return false;
+
+    if (!loader->config.prefetch) {
+        if (!loader->epoch_active || loader->next_take >= loader->num_batches) return false;
+        if (!loader_fill(loader, loader->next_take++, 0)) {
+            loader->failed = true;
+            return false;
+        }
+        *x = loader->x[0];
+        *y = loader->y[0];
+        return true;
+    }
+
+    pthread_mutex_lock(&loader->lock);
+
+    // Returning the previous batch lets the producer refill that buffer
+    if (loader->held >= 0) {
+        loader->slot_state[loader->held] = SLOT_EMPTY;
+        loader->held = -1;
+        pthread_cond_broadcast(&loader->changed);
+    }
+
+    bool ok = loader->epoch_active && loader->next_take < loader->num_batches;
+    if (ok) {
+        int slot = loader->next_take % 2;
+        while (loader->slot_state[slot] != SLOT_FULL) {
+            pthread_cond_wait(&loader->changed, &loader->lock);
+        }
+        ok = !loader->failed;
+        if (ok) {
+            loader->held = slot;
+            loader->next_take++;
+            *x = loader->x[slot];
+            *y = loader->y[slot];
+        }
+    }
+
+    pthread_mutex_unlock(&loader->lock);
+    return ok;
+}
+
+bool data_loader_failed(DataLoader* loader) {
+    if (!loader) return true;
+
+    pthread_mutex_lock(&loader->lock);
+    bool failed = loader->failed;
+    pthread_mutex_unlock(&loader->lock);
+    return failed;
+}
+
+int data_loader_num_samples(const DataLoader* loader) {
+    return loader ? loader->num_samples : 0;
+}
+
+int data_loader_num_batches(const DataLoader* loader) {
+    return loader ? loader->num_batches : 0;
+}
+
+int data_loader_sample_size(const DataLoader* loader) {
+    return loader ? (int)loader->header.sample_size : 0;
+}
+
+int data_loader_target_size(const DataLoader* loader) {
+    return loader ? (int)loader->header.target_size : 0;
+}
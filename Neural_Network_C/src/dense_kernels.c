@@ -0,0 +1,209 @@
+/*
+ * Neural Network System - Fused Dense Kernels Implementation
+ * Dense layer forward/backward built on the GEMM epilogue
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/dense_kernels.h"
+#include "../headers/activations.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DENSE_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// Activation Mapping
+// ============================================================================
+
+bool dense_activation_kind(DenseActivationFn activation, GemmActivation* kind) {
+    GemmActivation result;
+
+    if (!activation || activation == activation_linear) {
+        result = GEMM_ACTIVATION_NONE;
+    } else if (activation == activation_relu) {
+        result = GEMM_ACTIVATION_RELU;
+    } else if (activation == activation_leaky_relu) {
+        result = GEMM_ACTIVATION_LEAKY_RELU;
+    } else if (activation == activation_sigmoid) {
+        result = GEMM_ACTIVATION_SIGMOID;
+    } else if (activation == activation_tanh) {
+        result = GEMM_ACTIVATION_TANH;
+    } else {
+        return false;
+    }
+
+    if (kind) *kind = result;
+    return true;
+}
+
+static bool dense_shapes_valid(const Tensor* input, const Tensor* weights, const Tensor* output) {
+    if (!input || !weights || !output) return false;
+    if (input->ndim != 2 || weights->ndim != 2) return false;
+    if (input->shape[1] != weights->shape[1]) return false;
+    return output->size == input->shape[0] * weights->shape[0];
+}
+
+// ============================================================================
+// Forward
+// ============================================================================
+
+bool dense_forward_fused(const Tensor* input, const Tensor* weights, const Tensor* biases,
+                         DenseActivationFn activation, Tensor* output) {
+    if (!dense_shapes_valid(input, weights, output)) return false;
+
+    int batch = input->shape[0];
+    int in_features = input->shape[1];
+    int out_features = weights->shape[0];
+    if (biases && biases->size != out_features) return false;
+
+    GemmEpilogue epilogue = { biases ? biases->data : NULL, GEMM_ACTIVATION_NONE, NULL };
+    bool fused = dense_activation_kind(activation, &epilogue.activation);
+
+    if (!gemm_sgemm_epilogue(GEMM_NO_TRANS, GEMM_TRANS, batch, out_features, in_features, 1.0f,
+                             input->data, in_features, weights->data, in_features,
+                             0.0f, output->data, out_features, &epilogue)) {
+        return false;
+    }
+
+    // Row-wise activations (softmax) and unknown functions run per sample
+    if (!fused) {
+        for (int i = 0; i < batch; i++) {
+            activation(output->data + (size_t)i * out_features, out_features);
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Backward
+// ============================================================================
+
+#ifdef DENSE_HAVE_X86
+
+/**
+ * @brief ReLU / leaky ReLU delta with masked blends instead of branches
+ */
+__attribute__((target("avx512f")))
+static void dense_relu_delta_avx512(const float* y, float* grad, float* bias_grad,
+                                    int cols, float negative_slope) {
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 slope = _mm512_set1_ps(negative_slope);
+
+    for (int j = 0; j < cols; j += 16) {
+        __mmask16 mask = (cols - j >= 16) ? (__mmask16)0xFFFF
+                                          : (__mmask16)((1u << (cols - j)) - 1);
+        __m512 g = _mm512_maskz_loadu_ps(mask, grad + j);
+        __m512 yv = _mm512_maskz_loadu_ps(mask, y + j);
+        __mmask16 positive = _mm512_cmp_ps_mask(yv, zero, _CMP_GT_OQ);
+        g = _mm512_mask_blend_ps(positive, _mm512_mul_ps(g, slope), g);
+        _mm512_mask_storeu_ps(grad + j, mask, g);
+        if (bias_grad) {
+            __m512 b = _mm512_maskz_loadu_ps(mask, bias_grad + j);
+            _mm512_mask_storeu_ps(bias_grad + j, mask, _mm512_add_ps(b, g));
+        }
+    }
+}
+
+static bool dense_has_avx512(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx512f") ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+#endif
+
+void dense_activation_delta(GemmActivation kind, const float* y, float* grad,
+                            float* bias_grad, int rows, int cols) {
+#ifdef DENSE_HAVE_X86
+    if ((kind == GEMM_ACTIVATION_RELU || kind == GEMM_ACTIVATION_LEAKY_RELU) && dense_has_avx512()) {
+        float slope = (kind == GEMM_ACTIVATION_RELU) ? 0.0f : GEMM_LEAKY_RELU_SLOPE;
+        for (int i = 0; i < rows; i++) {
+            dense_relu_delta_avx512(y + (size_t)i * cols, grad + (size_t)i * cols,
+                                    bias_grad, cols, slope);
+        }
+        return;
+    }
+#endif
+
+    for (int i = 0; i < rows; i++) {
+        const float* yr = y + (size_t)i * cols;
+        float* gr = grad + (size_t)i * cols;
+
+        switch (kind) {
+            case GEMM_ACTIVATION_RELU:
+                for (int j = 0; j < cols; j++) gr[j] = yr[j] > 0.0f ? gr[j] : 0.0f;
+                break;
+            case GEMM_ACTIVATION_LEAKY_RELU:
+                for (int j = 0; j < cols; j++) {
+                    gr[j] = yr[j] > 0.0f ? gr[j] : GEMM_LEAKY_RELU_SLOPE * gr[j];
+                }
+                break;
+            case GEMM_ACTIVATION_SIGMOID:
+                for (int j = 0; j < cols; j++) gr[j] *= yr[j] * (1.0f - yr[j]);
+                break;
+            case GEMM_ACTIVATION_TANH:
+                for (int j = 0; j < cols; j++) gr[j] *= 1.0f - yr[j] * yr[j];
+                break;
+            case GEMM_ACTIVATION_NONE:
+            default:
+                break;
+        }
+
+        if (bias_grad) {
+            for (int j = 0; j < cols; j++) bias_grad[j] += gr[j];
+        }
+    }
+}
+
+bool dense_backward_fused(const Tensor* input, const Tensor* weights, const Tensor* output,
+                          DenseActivationFn activation, Tensor* grad_output,
+                          Tensor* weight_gradients, Tensor* bias_gradients,
+                          Tensor* grad_input, bool accumulate) {
+    if (!dense_shapes_valid(input, weights, output) || !grad_output || !weight_gradients) {
+        return false;
+    }
+
+    int batch = input->shape[0];
+    int in_features = input->shape[1];
+    int out_features = weights->shape[0];
+
+    if (grad_output->size != output->size || weight_gradients->size != weights->size) return false;
+    if (bias_gradients && bias_gradients->size != out_features) return false;
+    if (grad_input && grad_input->size != input->size) return false;
+
+    GemmActivation kind = GEMM_ACTIVATION_NONE;
+    if (activation != activation_softmax && !dense_activation_kind(activation, &kind)) {
+        return false;
+    }
+
+    float* bias_grad = NULL;
+    if (bias_gradients) {
+        bias_grad = bias_gradients->data;
+        if (!accumulate) memset(bias_grad, 0, (size_t)out_features * sizeof(float));
+    }
+
+    dense_activation_delta(kind, output->data, grad_output->data, bias_grad, batch, out_features);
+
+    // dW = delta^T * X  (out x batch) * (batch x in)
+    if (!gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, out_features, in_features, batch, 1.0f,
+                    grad_output->data, out_features, input->data, in_features,
+                    accumulate ? 1.0f : 0.0f, weight_gradients->data, in_features)) {
+        return false;
+    }
+
+    // dX = delta * W  (batch x out) * (out x in)
+    if (grad_input) {
+        return gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, batch, in_features, out_features, 1.0f,
+                          grad_output->data, out_features, weights->data, in_features,
+                          0.0f, grad_input->data, in_features);
+    }
+
+    return true;
+}
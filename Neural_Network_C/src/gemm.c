@@ -0,0 +1,724 @@
+/*
+ * Neural Network System - GEMM Kernel Implementation
+ * Packed, cache-blocked matrix multiply (Goto/BLIS layout) with
+ * AVX-512 / AVX2 micro-kernels selected at runtime
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "../headers/gemm.h"
+#include "../headers/vec_math.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GEMM_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define GEMM_THREAD_LOCAL __declspec(thread)
+#else
+#define GEMM_THREAD_LOCAL __thread
+#endif
+
+#define GEMM_MAX_MR 6
+#define GEMM_MAX_NR 32
+
+// ============================================================================
+// Kernel Table
+// ============================================================================
+
+/**
+ * @brief Micro-kernel: C[mr x nr] = alpha * Ap * Bp + beta * C
+ * Ap is a packed MR-row panel, Bp a packed NR-column panel, both kc deep.
+ */
+typedef void (*GemmMicroKernel)(int kc, const float* ap, const float* bp,
+                                float* c, int ldc, float alpha, float beta);
+
+typedef struct {
+    GemmKernelType type;
+    int mr;                     // Rows per register tile
+    int nr;                     // Columns per register tile
+    GemmMicroKernel kernel;
+} GemmKernelInfo;
+
+static void gemm_kernel_scalar(int kc, const float* ap, const float* bp,
+                               float* c, int ldc, float alpha, float beta) {
+    float acc[4][8] = {{0}};
+
+    for (int p = 0; p < kc; p++) {
+        for (int i = 0; i < 4; i++) {
+            float a = ap[i];
+            for (int j = 0; j < 8; j++) {
+                acc[i][j] += a * bp[j];
+            }
+        }
+        ap += 4;
+        bp += 8;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        float* row = c + i * ldc;
+        for (int j = 0; j < 8; j++) {
+            row[j] = (beta == 0.0f) ? alpha * acc[i][j] : alpha * acc[i][j] + beta * row[j];
+        }
+    }
+}
+
+#ifdef GEMM_HAVE_X86
+
+__attribute__((target("avx2,fma")))
+static void gemm_kernel_avx2(int kc, const float* ap, const float* bp,
+                             float* c, int ldc, float alpha, float beta) {
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+    for (int p = 0; p < kc; p++) {
+        __m256 b0 = _mm256_load_ps(bp);
+        __m256 b1 = _mm256_load_ps(bp + 8);
+        __m256 a;
+
+        a = _mm256_broadcast_ss(ap + 0);
+        c00 = _mm256_fmadd_ps(a, b0, c00); c01 = _mm256_fmadd_ps(a, b1, c01);
+        a = _mm256_broadcast_ss(ap + 1);
+        c10 = _mm256_fmadd_ps(a, b0, c10); c11 = _mm256_fmadd_ps(a, b1, c11);
+        a = _mm256_broadcast_ss(ap + 2);
+        c20 = _mm256_fmadd_ps(a, b0, c20); c21 = _mm256_fmadd_ps(a, b1, c21);
+        a = _mm256_broadcast_ss(ap + 3);
+        c30 = _mm256_fmadd_ps(a, b0, c30); c31 = _mm256_fmadd_ps(a, b1, c31);
+        a = _mm256_broadcast_ss(ap + 4);
+        c40 = _mm256_fmadd_ps(a, b0, c40); c41 = _mm256_fmadd_ps(a, b1, c41);
+        a = _mm256_broadcast_ss(ap + 5);
+        c50 = _mm256_fmadd_ps(a, b0, c50); c51 = _mm256_fmadd_ps(a, b1, c51);
+
+        ap += 6;
+        bp += 16;
+    }
+
+    __m256 acc[6][2] = {
+        {c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}
+    };
+    __m256 va = _mm256_set1_ps(alpha);
+    __m256 vb = _mm256_set1_ps(beta);
+
+    for (int i = 0; i < 6; i++) {
+        float* row = c + i * ldc;
+        for (int h = 0; h < 2; h++) {
+            __m256 r = _mm256_mul_ps(va, acc[i][h]);
+            if (beta != 0.0f) {
+                r = _mm256_fmadd_ps(vb, _mm256_loadu_ps(row + h * 8), r);
+            }
+            _mm256_storeu_ps(row + h * 8, r);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+static void gemm_kernel_avx512(int kc, const float* ap, const float* bp,
+                               float* c, int ldc, float alpha, float beta) {
+    __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+    __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+    __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+    __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+    __m512 c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps();
+    __m512 c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+
+    for (int p = 0; p < kc; p++) {
+        __m512 b0 = _mm512_load_ps(bp);
+        __m512 b1 = _mm512_load_ps(bp + 16);
+        __m512 a;
+
+        a = _mm512_set1_ps(ap[0]);
+        c00 = _mm512_fmadd_ps(a, b0, c00); c01 = _mm512_fmadd_ps(a, b1, c01);
+        a = _mm512_set1_ps(ap[1]);
+        c10 = _mm512_fmadd_ps(a, b0, c10); c11 = _mm512_fmadd_ps(a, b1, c11);
+        a = _mm512_set1_ps(ap[2]);
+        c20 = _mm512_fmadd_ps(a, b0, c20); c21 = _mm512_fmadd_ps(a, b1, c21);
+        a = _mm512_set1_ps(ap[3]);
+        c30 = _mm512_fmadd_ps(a, b0, c30); c31 = _mm512_fmadd_ps(a, b1, c31);
+        a = _mm512_set1_ps(ap[4]);
+        c40 = _mm512_fmadd_ps(a, b0, c40); c41 = _mm512_fmadd_ps(a, b1, c41);
+        a = _mm512_set1_ps(ap[5]);
+        c50 = _mm512_fmadd_ps(a, b0, c50); c51 = _mm512_fmadd_ps(a, b1, c51);
+
+        ap += 6;
+        bp += 32;
+    }
+
+    __m512 acc[6][2] = {
+        {c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}
+    };
+    __m512 va = _mm512_set1_ps(alpha);
+    __m512 vb = _mm512_set1_ps(beta);
+
+    for (int i = 0; i < 6; i++) {
+        float* row = c + i * ldc;
+        for (int h = 0; h < 2; h++) {
+            __m512 r = _mm512_mul_ps(va, acc[i][h]);
+            if (beta != 0.0f) {
+                r = _mm512_fmadd_ps(vb, _mm512_loadu_ps(row + h * 16), r);
+            }
+            _mm512_storeu_ps(row + h * 16, r);
+        }
+    }
+}
+
+#endif // GEMM_HAVE_X86
+
+static const GemmKernelInfo gemm_kernels[] = {
+    { GEMM_KERNEL_SCALAR, 4, 8, gemm_kernel_scalar },
+#ifdef GEMM_HAVE_X86
+    { GEMM_KERNEL_AVX2, 6, 16, gemm_kernel_avx2 },
+    { GEMM_KERNEL_AVX512, 6, 32, gemm_kernel_avx512 },
+#endif
+};
+
+static const GemmKernelInfo* gemm_active_kernel = NULL;  // Loaded and stored atomically
+static pthread_once_t gemm_kernel_once = PTHREAD_ONCE_INIT;
+
+static bool gemm_cpu_supports(GemmKernelType type) {
+    switch (type) {
+        case GEMM_KERNEL_SCALAR:
+            return true;
+#ifdef GEMM_HAVE_X86
+        case GEMM_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case GEMM_KERNEL_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+static const GemmKernelInfo* gemm_find_kernel(GemmKernelType type) {
+    for (size_t i = 0; i < sizeof(gemm_kernels) / sizeof(gemm_kernels[0]); i++) {
+        if (gemm_kernels[i].type == type) return &gemm_kernels[i];
+    }
+    return NULL;
+}
+
+static void gemm_detect_kernel(void) {
+    const GemmKernelInfo* best = &gemm_kernels[0];
+    for (size_t i = 0; i < sizeof(gemm_kernels) / sizeof(gemm_kernels[0]); i++) {
+        if (gemm_cpu_supports(gemm_kernels[i].type) && gemm_kernels[i].type > best->type) {
+            best = &gemm_kernels[i];
+        }
+    }
+
+    __atomic_store_n(&gemm_active_kernel, best, __ATOMIC_RELEASE);
+}
+
+// GEMMs may start on several threads at once; detection runs exactly once
+static const GemmKernelInfo* gemm_select_kernel(void) {
+    pthread_once(&gemm_kernel_once, gemm_detect_kernel);
+    return __atomic_load_n(&gemm_active_kernel, __ATOMIC_ACQUIRE);
+}
+
+GemmKernelType gemm_get_kernel(void) {
+    return gemm_select_kernel()->type;
+}
+
+bool gemm_set_kernel(GemmKernelType type) {
+    const GemmKernelInfo* info = gemm_find_kernel(type);
+    if (!info || !gemm_cpu_supports(type)) return false;
+
+    // Detect first so a later first GEMM cannot overwrite the choice
+    pthread_once(&gemm_kernel_once, gemm_detect_kernel);
+    __atomic_store_n(&gemm_active_kernel, info, __ATOMIC_RELEASE);
+    return true;
+}
+
+const char* gemm_kernel_name(GemmKernelType type) {
+    switch (type) {
+        case GEMM_KERNEL_SCALAR: return "scalar";
+        case GEMM_KERNEL_AVX2: return "avx2";
+        case GEMM_KERNEL_AVX512: return "avx512";
+        default: return "unknown";
+    }
+}
+
+// ============================================================================
+// Pack Buffers
+// ============================================================================
+
+static GEMM_THREAD_LOCAL GemmScratch gemm_pack_a_buffer;
+static GEMM_THREAD_LOCAL GemmScratch gemm_pack_b_buffer;
+static ThreadPool* gemm_thread_pool = NULL;
+static GEMM_THREAD_LOCAL ThreadPool* gemm_bound_pool = NULL;    // Calling thread's own pool (overrides the shared one)
+
+// Every scratch buffer the thread reserved, across all kernel modules; the key's
+// destructor frees them when the thread exits (pool workers included)
+static GEMM_THREAD_LOCAL GemmScratch* gemm_scratch_list = NULL;
+static pthread_key_t gemm_scratch_key;
+static pthread_once_t gemm_scratch_once = PTHREAD_ONCE_INIT;
+
+static void gemm_scratch_free_list(void* head) {
+    GemmScratch* scratch = (GemmScratch*)head;
+    while (scratch) {
+        GemmScratch* next = scratch->next;
+        free(scratch->raw);
+        memset(scratch, 0, sizeof(GemmScratch));
+        scratch = next;
+    }
+}
+
+static void gemm_scratch_create_key(void) {
+    pthread_key_create(&gemm_scratch_key, gemm_scratch_free_list);
+}
+
+void* gemm_scratch_reserve(GemmScratch* scratch, size_t bytes) {
+    if (scratch->capacity >= bytes) return scratch->data;
+
+    free(scratch->raw);
+    scratch->raw = malloc(bytes + GEMM_ALIGNMENT);
+    if (!scratch->raw) {
+        scratch->data = NULL;
+        scratch->capacity = 0;
+        return NULL;
+    }
+
+    uintptr_t addr = (uintptr_t)scratch->raw;
+    addr = (addr + GEMM_ALIGNMENT - 1) & ~(uintptr_t)(GEMM_ALIGNMENT - 1);
+    scratch->data = (void*)addr;
+    scratch->capacity = bytes;
+
+    if (!scratch->listed) {
+        scratch->next = gemm_scratch_list;
+        scratch->listed = true;
+        gemm_scratch_list = scratch;
+        pthread_once(&gemm_scratch_once, gemm_scratch_create_key);
+        pthread_setspecific(gemm_scratch_key, gemm_scratch_list);
+    }
+    return scratch->data;
+}
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+/**
+ * @brief Pack an mc x kc block of op(A) into MR-row micro-panels
+ * Rows past mc are zero filled so the kernel never needs bounds checks.
+ */
+static void gemm_pack_a(GemmTranspose trans, const float* a, int lda,
+                        int row0, int col0, int mc, int kc, int mr, float* dst) {
+    for (int ir = 0; ir < mc; ir += mr) {
+        int rows = (mc - ir < mr) ? mc - ir : mr;
+
+        if (trans == GEMM_NO_TRANS) {
+            const float* src = a + (size_t)(row0 + ir) * lda + col0;
+            for (int p = 0; p < kc; p++) {
+                int r = 0;
+                for (; r < rows; r++) dst[r] = src[(size_t)r * lda + p];
+                for (; r < mr; r++) dst[r] = 0.0f;
+                dst += mr;
+            }
+        } else {
+            const float* src = a + (size_t)col0 * lda + row0 + ir;
+            for (int p = 0; p < kc; p++) {
+                const float* col = src + (size_t)p * lda;
+                int r = 0;
+                for (; r < rows; r++) dst[r] = col[r];
+                for (; r < mr; r++) dst[r] = 0.0f;
+                dst += mr;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Pack a kc x nc block of op(B) into NR-column micro-panels
+ */
+static void gemm_pack_b(GemmTranspose trans, const float* b, int ldb,
+                        int row0, int col0, int kc, int nc, int nr, float* dst) {
+    for (int jr = 0; jr < nc; jr += nr) {
+        int cols = (nc - jr < nr) ? nc - jr : nr;
+
+        if (trans == GEMM_NO_TRANS) {
+            const float* src = b + (size_t)row0 * ldb + col0 + jr;
+            for (int p = 0; p < kc; p++) {
+                const float* row = src + (size_t)p * ldb;
+                if (cols == nr) {
+                    memcpy(dst, row, nr * sizeof(float));
+                } else {
+                    int j = 0;
+                    for (; j < cols; j++) dst[j] = row[j];
+                    for (; j < nr; j++) dst[j] = 0.0f;
+                }
+                dst += nr;
+            }
+        } else {
+            const float* src = b + (size_t)(col0 + jr) * ldb + row0;
+            for (int p = 0; p < kc; p++) {
+                int j = 0;
+                for (; j < cols; j++) dst[j] = src[(size_t)j * ldb + p];
+                for (; j < nr; j++) dst[j] = 0.0f;
+                dst += nr;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Epilogue
+// ============================================================================
+
+static void gemm_epilogue_row_scalar(float* row, const float* bias, float shift, int cols,
+                                     GemmActivation activation) {
+    if (bias) {
+        for (int j = 0; j < cols; j++) row[j] += bias[j] + shift;
+    } else if (shift != 0.0f) {
+        for (int j = 0; j < cols; j++) row[j] += shift;
+    }
+
+    switch (activation) {
+        case GEMM_ACTIVATION_RELU:
+            for (int j = 0; j < cols; j++) row[j] = row[j] > 0.0f ? row[j] : 0.0f;
+            break;
+        case GEMM_ACTIVATION_LEAKY_RELU:
+            for (int j = 0; j < cols; j++) {
+                row[j] = row[j] > 0.0f ? row[j] : GEMM_LEAKY_RELU_SLOPE * row[j];
+            }
+            break;
+        case GEMM_ACTIVATION_SIGMOID:
+            for (int j = 0; j < cols; j++) row[j] = vec_math_sigmoidf(row[j]);
+            break;
+        case GEMM_ACTIVATION_TANH:
+            for (int j = 0; j < cols; j++) row[j] = vec_math_tanhf(row[j]);
+            break;
+        case GEMM_ACTIVATION_NONE:
+        default:
+            break;
+    }
+}
+
+#ifdef GEMM_HAVE_X86
+
+// ReLU-style epilogues as max() so random signs cost no branch mispredictions;
+// leaky ReLU is max(x, slope * x) because 0 < slope < 1. Sigmoid and tanh use
+// the vec_math polynomials, so every activation stays vectorized.
+
+__attribute__((target("avx512f")))
+static void gemm_epilogue_row_avx512(float* row, const float* bias, float shift, int cols,
+                                     GemmActivation activation) {
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 slope = _mm512_set1_ps(GEMM_LEAKY_RELU_SLOPE);
+    const __m512 offset = _mm512_set1_ps(shift);
+
+    for (int j = 0; j < cols; j += 16) {
+        __mmask16 mask = (cols - j >= 16) ? (__mmask16)0xFFFF
+                                          : (__mmask16)((1u << (cols - j)) - 1);
+        __m512 v = _mm512_maskz_loadu_ps(mask, row + j);
+        if (bias) v = _mm512_add_ps(v, _mm512_maskz_loadu_ps(mask, bias + j));
+        v = _mm512_add_ps(v, offset);
+        if (activation == GEMM_ACTIVATION_RELU) {
+            v = _mm512_max_ps(v, zero);
+        } else if (activation == GEMM_ACTIVATION_LEAKY_RELU) {
+            v = _mm512_max_ps(v, _mm512_mul_ps(v, slope));
+        } else if (activation == GEMM_ACTIVATION_SIGMOID) {
+            v = vec_math_sigmoid_zmm(v);
+        } else if (activation == GEMM_ACTIVATION_TANH) {
+            v = vec_math_tanh_zmm(v);
+        }
+        _mm512_mask_storeu_ps(row + j, mask, v);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void gemm_epilogue_row_avx2(float* row, const float* bias, float shift, int cols,
+                                   GemmActivation activation) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 slope = _mm256_set1_ps(GEMM_LEAKY_RELU_SLOPE);
+    const __m256 offset = _mm256_set1_ps(shift);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    for (int j = 0; j < cols; j += 8) {
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(cols - j), lanes);
+        __m256 v = _mm256_maskload_ps(row + j, mask);
+        if (bias) v = _mm256_add_ps(v, _mm256_maskload_ps(bias + j, mask));
+        v = _mm256_add_ps(v, offset);
+        if (activation == GEMM_ACTIVATION_RELU) {
+            v = _mm256_max_ps(v, zero);
+        } else if (activation == GEMM_ACTIVATION_LEAKY_RELU) {
+            v = _mm256_max_ps(v, _mm256_mul_ps(v, slope));
+        } else if (activation == GEMM_ACTIVATION_SIGMOID) {
+            v = vec_math_sigmoid_ymm(v);
+        } else if (activation == GEMM_ACTIVATION_TANH) {
+            v = vec_math_tanh_ymm(v);
+        }
+        _mm256_maskstore_ps(row + j, mask, v);
+    }
+}
+
+#endif
+
+void gemm_apply_epilogue(const GemmEpilogue* epilogue, float* c, int ldc,
+                         int rows, int cols, int row0, int col0) {
+    if (!epilogue) return;
+
+    const float* bias = epilogue->bias ? epilogue->bias + col0 : NULL;
+    const float* row_bias = epilogue->row_bias ? epilogue->row_bias + row0 : NULL;
+    GemmActivation activation = epilogue->activation;
+    void (*row_fn)(float*, const float*, float, int, GemmActivation) = gemm_epilogue_row_scalar;
+
+#ifdef GEMM_HAVE_X86
+    GemmKernelType type = gemm_select_kernel()->type;
+    if (type == GEMM_KERNEL_AVX512) {
+        row_fn = gemm_epilogue_row_avx512;
+    } else if (type == GEMM_KERNEL_AVX2) {
+        row_fn = gemm_epilogue_row_avx2;
+    }
+#endif
+
+    for (int i = 0; i < rows; i++) {
+        row_fn(c + (size_t)i * ldc, bias, row_bias ? row_bias[i] : 0.0f, cols, activation);
+    }
+}
+
+// ============================================================================
+// Macro-kernel and Driver
+// ============================================================================
+
+/**
+ * @brief Multiply a packed A block by a packed B block into C
+ * Full tiles are written in place; edge tiles go through a local buffer.
+ */
+static void gemm_macro_kernel(const GemmKernelInfo* info, int mc, int nc, int kc,
+                              const float* pack_a, const float* pack_b,
+                              float alpha, float beta, float* c, int ldc,
+                              const GemmEpilogue* epilogue, int row0, int col0) {
+    const int mr = info->mr;
+    const int nr = info->nr;
+    float edge[GEMM_MAX_MR * GEMM_MAX_NR];
+
+    for (int jr = 0; jr < nc; jr += nr) {
+        int cols = (nc - jr < nr) ? nc - jr : nr;
+        const float* bp = pack_b + (size_t)jr * kc;
+
+        for (int ir = 0; ir < mc; ir += mr) {
+            int rows = (mc - ir < mr) ? mc - ir : mr;
+            const float* ap = pack_a + (size_t)ir * kc;
+            float* ct = c + (size_t)ir * ldc + jr;
+
+            if (rows == mr && cols == nr) {
+                info->kernel(kc, ap, bp, ct, ldc, alpha, beta);
+            } else {
+                info->kernel(kc, ap, bp, edge, nr, alpha, 0.0f);
+                for (int i = 0; i < rows; i++) {
+                    for (int j = 0; j < cols; j++) {
+                        float* dst = &ct[(size_t)i * ldc + j];
+                        *dst = (beta == 0.0f) ? edge[i * nr + j] : edge[i * nr + j] + beta * *dst;
+                    }
+                }
+            }
+
+            // The tile is still hot, so bias and activation cost no extra pass
+            gemm_apply_epilogue(epilogue, ct, ldc, rows, cols, row0 + ir, col0 + jr);
+        }
+    }
+}
+
+/**
+ * @brief Unpacked path for small products where packing dominates
+ */
+static void gemm_small(GemmTranspose trans_a, GemmTranspose trans_b,
+                       int m, int n, int k, float alpha,
+                       const float* a, int lda, const float* b, int ldb,
+                       float beta, float* c, int ldc, const GemmEpilogue* epilogue) {
+    for (int i = 0; i < m; i++) {
+        float* crow = c + (size_t)i * ldc;
+
+        if (beta == 0.0f) {
+            memset(crow, 0, n * sizeof(float));
+        } else if (beta != 1.0f) {
+            for (int j = 0; j < n; j++) crow[j] *= beta;
+        }
+
+        if (trans_b == GEMM_NO_TRANS) {
+            // i-k-j order keeps the inner loop contiguous in B and C
+            for (int p = 0; p < k; p++) {
+                float av = alpha * (trans_a == GEMM_NO_TRANS ? a[(size_t)i * lda + p]
+                                                             : a[(size_t)p * lda + i]);
+                const float* brow = b + (size_t)p * ldb;
+                for (int j = 0; j < n; j++) crow[j] += av * brow[j];
+            }
+        } else {
+            // B transposed: rows of B are contiguous dot-product operands
+            for (int j = 0; j < n; j++) {
+                const float* brow = b + (size_t)j * ldb;
+                float sum = 0.0f;
+                for (int p = 0; p < k; p++) {
+                    float av = (trans_a == GEMM_NO_TRANS) ? a[(size_t)i * lda + p]
+                                                          : a[(size_t)p * lda + i];
+                    sum += av * brow[p];
+                }
+                crow[j] += alpha * sum;
+            }
+        }
+
+        gemm_apply_epilogue(epilogue, crow, ldc, 1, n, i, 0);
+    }
+}
+
+/**
+ * @brief One pc-slice of the product, shared by all block tasks
+ */
+typedef struct {
+    const GemmKernelInfo* info;
+    GemmTranspose trans_a;
+    const float* a;
+    int lda;
+    int pc, kc;                 // Depth slice of A/B being multiplied
+    int m, block_m;             // Rows of C and rows per task
+    int jc, nc;                 // Column block of C covered by pack_b
+    int chunk_n, n_chunks;      // Column split of the block across tasks
+    const float* pack_b;        // Shared packed B block
+    float alpha, beta;
+    float* c;
+    int ldc;
+    const GemmEpilogue* epilogue; // Set only on the last depth slice
+    int failed;                 // Set when a task could not reserve its pack buffer
+} GemmBlockJob;
+
+static void gemm_block_task(void* context, int index, int thread_id) {
+    GemmBlockJob* job = (GemmBlockJob*)context;
+    (void)thread_id;
+
+    int ic = (index / job->n_chunks) * job->block_m;
+    int jr = (index % job->n_chunks) * job->chunk_n;
+    int mc = (job->m - ic < job->block_m) ? job->m - ic : job->block_m;
+    int nc = (job->nc - jr < job->chunk_n) ? job->nc - jr : job->chunk_n;
+    if (mc <= 0 || nc <= 0) return;
+
+    const int mr = job->info->mr;
+    size_t a_size = (size_t)((job->block_m + mr - 1) / mr) * mr * job->kc;
+    float* pack_a = (float*)gemm_scratch_reserve(&gemm_pack_a_buffer, a_size * sizeof(float));
+    if (!pack_a) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    gemm_pack_a(job->trans_a, job->a, job->lda, ic, job->pc, mc, job->kc, mr, pack_a);
+    gemm_macro_kernel(job->info, mc, nc, job->kc, pack_a, job->pack_b + (size_t)jr * job->kc,
+                      job->alpha, job->beta, job->c + (size_t)ic * job->ldc + job->jc + jr,
+                      job->ldc, job->epilogue, ic, job->jc + jr);
+}
+
+ThreadPool* gemm_set_thread_pool(ThreadPool* pool) {
+    ThreadPool* previous = gemm_thread_pool;
+    gemm_thread_pool = pool;
+    return previous;
+}
+
+void gemm_bind_thread_pool(ThreadPool* pool) {
+    gemm_bound_pool = pool;
+}
+
+void gemm_release_thread_buffers(void) {
+    if (!gemm_scratch_list) return;
+
+    gemm_scratch_free_list(gemm_scratch_list);
+    gemm_scratch_list = NULL;
+    pthread_setspecific(gemm_scratch_key, NULL);
+}
+
+ThreadPool* gemm_get_thread_pool(void) {
+    return gemm_bound_pool ? gemm_bound_pool : gemm_thread_pool;
+}
+
+bool gemm_sgemm(GemmTranspose trans_a, GemmTranspose trans_b,
+                int m, int n, int k, float alpha,
+                const float* a, int lda, const float* b, int ldb,
+                float beta, float* c, int ldc) {
+    return gemm_sgemm_epilogue(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, NULL);
+}
+
+bool gemm_sgemm_epilogue(GemmTranspose trans_a, GemmTranspose trans_b,
+                         int m, int n, int k, float alpha,
+                         const float* a, int lda, const float* b, int ldb,
+                         float beta, float* c, int ldc, const GemmEpilogue* epilogue) {
+    if (!c || m <= 0 || n <= 0) return true;
+
+    if (epilogue && !epilogue->bias && !epilogue->row_bias &&
+        epilogue->activation == GEMM_ACTIVATION_NONE) {
+        epilogue = NULL;
+    }
+
+    if (k <= 0 || alpha == 0.0f || !a || !b) {
+        for (int i = 0; i < m; i++) {
+            float* crow = c + (size_t)i * ldc;
+            for (int j = 0; j < n; j++) crow[j] = (beta == 0.0f) ? 0.0f : beta * crow[j];
+            gemm_apply_epilogue(epilogue, crow, ldc, 1, n, i, 0);
+        }
+        return true;
+    }
+
+    long long work = (long long)m * n * k;
+    if (work < GEMM_SMALL_THRESHOLD) {
+        gemm_small(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, epilogue);
+        return true;
+    }
+
+    const GemmKernelInfo* info = gemm_select_kernel();
+    const int mr = info->mr;
+    const int nr = info->nr;
+    const int block_m = mr * GEMM_BLOCK_M_PANELS;
+    const int block_k = (k < GEMM_BLOCK_K) ? k : GEMM_BLOCK_K;
+    const int block_n = (n < GEMM_BLOCK_N) ? n : GEMM_BLOCK_N;
+
+    size_t b_size = (size_t)((block_n + nr - 1) / nr) * nr * block_k;
+    float* pack_b = (float*)gemm_scratch_reserve(&gemm_pack_b_buffer, b_size * sizeof(float));
+    if (!pack_b) {
+        gemm_small(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, epilogue);
+        return true;
+    }
+
+    // Split across the pool only for large products outside other parallel regions
+    ThreadPool* pool = NULL;
+    int threads = 1;
+    ThreadPool* attached = gemm_get_thread_pool();
+    if (attached && work >= GEMM_PARALLEL_THRESHOLD && !thread_pool_in_parallel_region()) {
+        pool = attached;
+        threads = thread_pool_size(pool);
+    }
+
+    int m_blocks = (m + block_m - 1) / block_m;
+
+    for (int jc = 0; jc < n; jc += block_n) {
+        int nc = (n - jc < block_n) ? n - jc : block_n;
+
+        // Give each thread work even when C has fewer row blocks than threads
+        int n_chunks = 1;
+        if (m_blocks < threads) {
+            int panels = (nc + nr - 1) / nr;
+            n_chunks = (threads + m_blocks - 1) / m_blocks;
+            if (n_chunks > panels) n_chunks = panels;
+        }
+        int chunk_panels = ((nc + nr - 1) / nr + n_chunks - 1) / n_chunks;
+
+        for (int pc = 0; pc < k; pc += block_k) {
+            int kc = (k - pc < block_k) ? k - pc : block_k;
+
+            gemm_pack_b(trans_b, b, ldb, pc, jc, kc, nc, nr, pack_b);
+
+            GemmBlockJob job = {
+                info, trans_a, a, lda, pc, kc, m, block_m, jc, nc,
+                chunk_panels * nr, n_chunks, pack_b,
+                alpha, (pc == 0) ? beta : 1.0f, c, ldc,
+                (pc + kc == k) ? epilogue : NULL, 0
+            };
+            thread_pool_parallel_for(pool, m_blocks * n_chunks, gemm_block_task, &job);
+            if (job.failed) return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,727 @@
+/*
+ * Neural Network System - Hyperparameter Search Implementation
+ * Trial generation, pinned worker threads over a shared read-only
+ * dataset, successive-halving rungs and the results table
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L     // clock_gettime
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include "../headers/hyperparam_search.h"
+#include "../headers/optimizers.h"
+#include "../headers/losses.h"
+#include "../headers/thread_pool.h"
+#include "../headers/gemm.h"
+
+/**
+ * @brief Per-trial training state kept alive between rungs
+ */
+typedef struct {
+    NeuralNetwork* net;             // Compiled network (NULL until built or once finished)
+    Optimizer* optimizer;           // Trial optimizer
+    Loss* loss;                     // Trial loss
+} TrialState;
+
+/**
+ * @brief One rung of a running search
+ */
+typedef struct {
+    HyperparamSearch* search;       // Search being run
+    TrialState* states;             // One per trial
+
+    Tensor* x;                      // Shared inputs
+    Tensor* y;                      // Shared targets
+    Tensor* x_val;                  // Validation view of x
+    Tensor* y_val;                  // Validation view of y
+    int train_rows;                 // Rows before the validation split
+    int x_row;                      // Floats per input sample
+    int y_row;                      // Floats per target sample
+
+    const int* active;              // Trials of the current rung
+    int num_active;                 // Number of active trials
+    int budget;                     // Epochs every active trial reaches in this rung
+    int rung;                       // Rung index
+
+    pthread_mutex_t lock;           // Protects next
+    int next;                       // Next unclaimed active trial
+} SearchRun;
+
+/**
+ * @brief Worker thread arguments and scratch
+ */
+typedef struct {
+    SearchRun* run;                 // Shared rung state
+    int index;                      // Worker index (selects the core subset)
+    int* order;                     // Row permutation (train_rows)
+    float* x_batch;                 // Gathered inputs of a shuffled batch
+    float* y_batch;                 // Gathered targets of a shuffled batch
+    int batch_capacity;             // Rows the gather buffers hold
+} SearchWorker;
+
+static double search_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief xorshift32: a private generator, so draws never touch rand()'s state
+ */
+static unsigned int search_random(unsigned int* state) {
+    unsigned int x = *state ? *state : 0x9e3779b9u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static float search_uniform(unsigned int* state) {
+    return (search_random(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+// ============================================================================
+// Search Space
+// ============================================================================
+
+static int find_param(const HyperparamSpace* space, const char* name) {
+    for (int p = 0; p < space->num_params; p++) {
+        if (strcmp(space->params[p].name, name) == 0) return p;
+    }
+    return -1;
+}
+
+static Hyperparam* add_param(HyperparamSpace* space, const char* name) {
+    if (!space || !name || !name[0] || strlen(name) >= HYPERPARAM_NAME_LENGTH ||
+        space->num_params >= HYPERPARAM_MAX_PARAMS || find_param(space, name) >= 0) {
+        return NULL;
+    }
+
+    Hyperparam* param = &space->params[space->num_params];
+    memset(param, 0, sizeof(*param));
+    memcpy(param->name, name, strlen(name) + 1);
+    return param;
+}
+
+bool hyperparam_space_add_choice(HyperparamSpace* space, const char* name, const float* values, int count) {
+    if (!values || count < 1 || count > HYPERPARAM_MAX_CHOICES) return false;
+
+    Hyperparam* param = add_param(space, name);
+    if (!param) return false;
+    param->kind = HYPERPARAM_CHOICE;
+    memcpy(param->choices, values, count * sizeof(float));
+    param->num_choices = count;
+    space->num_params++;
+    return true;
+}
+
+bool hyperparam_space_add_range(HyperparamSpace* space, const char* name, HyperparamKind kind,
+                                float low, float high, int grid_points) {
+    if (kind == HYPERPARAM_CHOICE || !(low <= high) || grid_points < 1 ||
+        (kind == HYPERPARAM_LOG_UNIFORM && low <= 0.0f)) {
+        return false;
+    }
+
+    Hyperparam* param = add_param(space, name);
+    if (!param) return false;
+    param->kind = kind;
+    param->low = low;
+    param->high = high;
+    param->grid_points = grid_points;
+    space->num_params++;
+    return true;
+}
+
+float hyperparam_trial_value(const HyperparamTrial* trial, const HyperparamSpace* space, const char* name,
+                             float fallback) {
+    if (!trial || !space || !name) return fallback;
+    int p = find_param(space, name);
+    return p >= 0 ? trial->values[p] : fallback;
+}
+
+/**
+ * @brief Number of values a parameter contributes to the grid
+ */
+static int grid_size(const Hyperparam* param) {
+    if (param->kind == HYPERPARAM_CHOICE) return param->num_choices;
+    if (param->kind == HYPERPARAM_INT_UNIFORM) {
+        int span = (int)floorf(param->high) - (int)ceilf(param->low) + 1;
+        return span < param->grid_points ? span : param->grid_points;
+    }
+    return param->grid_points;
+}
+
+static float grid_value(const Hyperparam* param, int index) {
+    if (param->kind == HYPERPARAM_CHOICE) return param->choices[index];
+
+    int points = grid_size(param);
+    float t = points > 1 ? (float)index / (float)(points - 1) : 0.5f;
+    switch (param->kind) {
+        case HYPERPARAM_LOG_UNIFORM:
+            return expf(logf(param->low) + t * (logf(param->high) - logf(param->low)));
+        case HYPERPARAM_INT_UNIFORM:
+            return roundf(ceilf(param->low) + t * (floorf(param->high) - ceilf(param->low)));
+        default:
+            return param->low + t * (param->high - param->low);
+    }
+}
+
+static float random_value(const Hyperparam* param, unsigned int* state) {
+    float u = search_uniform(state);
+    switch (param->kind) {
+        case HYPERPARAM_CHOICE: {
+            int index = (int)(u * param->num_choices);
+            return param->choices[index < param->num_choices ? index : param->num_choices - 1];
+        }
+        case HYPERPARAM_LOG_UNIFORM:
+            return expf(logf(param->low) + u * (logf(param->high) - logf(param->low)));
+        case HYPERPARAM_INT_UNIFORM: {
+            int low = (int)ceilf(param->low), high = (int)floorf(param->high);
+            int value = low + (int)(u * (high - low + 1));
+            return (float)(value > high ? high : value);
+        }
+        default:
+            return param->low + u * (param->high - param->low);
+    }
+}
+
+// ============================================================================
+// Search Lifetime
+// ============================================================================
+
+HyperparamSearchConfig hyperparam_search_config_default(void) {
+    HyperparamSearchConfig config;
+    memset(&config, 0, sizeof(config));
+    config.strategy = HYPERPARAM_RANDOM;
+    config.num_trials = 16;
+    config.seed = 42;
+    config.num_workers = 0;
+    config.cores_per_worker = 1;
+    config.min_epochs = 1;
+    config.reduction_factor = 3;
+    config.training.epochs = 9;
+    config.training.batch_size = 64;
+    config.training.validation_split = 0.2f;
+    config.training.shuffle = true;
+    config.training.early_stopping = true;
+    config.training.patience = 3;
+    config.training.min_delta = 1e-4f;
+    config.training.num_threads = 1;
+    config.optimizer = OPTIMIZER_ADAM;
+    config.learning_rate = 0.001f;
+    config.loss = LOSS_SOFTMAX_CROSSENTROPY;
+    return config;
+}
+
+static bool generate_trials(HyperparamSearch* search) {
+    const HyperparamSpace* space = &search->space;
+    int count = search->config.num_trials;
+
+    if (search->config.strategy == HYPERPARAM_GRID) {
+        long product = 1;
+        for (int p = 0; p < space->num_params && product <= 1 << 20; p++) product *= grid_size(&space->params[p]);
+        if (product > 1 << 20) return false;
+        if (count <= 0 || count > product) count = (int)product;
+    }
+    if (count <= 0) return false;
+
+    search->trials = (HyperparamTrial*)calloc(count, sizeof(HyperparamTrial));
+    if (!search->trials) return false;
+    search->num_trials = count;
+
+    unsigned int state = search->config.seed;
+    for (int t = 0; t < count; t++) {
+        HyperparamTrial* trial = &search->trials[t];
+        trial->id = t;
+        trial->val_loss = INFINITY;
+        trial->worker = -1;
+
+        // Grid: mixed-radix digits of the trial index, last parameter fastest
+        int index = t;
+        for (int p = space->num_params - 1; p >= 0; p--) {
+            const Hyperparam* param = &space->params[p];
+            if (search->config.strategy == HYPERPARAM_GRID) {
+                int size = grid_size(param);
+                trial->values[p] = grid_value(param, index % size);
+                index /= size;
+            } else {
+                trial->values[p] = random_value(param, &state);
+            }
+        }
+    }
+    return true;
+}
+
+HyperparamSearch* hyperparam_search_create(const HyperparamSpace* space, HyperparamSearchConfig config,
+                                           HyperparamBuildFn build, void* user_data) {
+    if (!space || space->num_params < 1 || space->num_params > HYPERPARAM_MAX_PARAMS || !build ||
+        config.training.epochs < 1 || config.training.batch_size < 1) {
+        return NULL;
+    }
+
+    HyperparamSearch* search = (HyperparamSearch*)calloc(1, sizeof(HyperparamSearch));
+    if (!search) return NULL;
+    search->space = *space;
+    search->config = config;
+    search->build = build;
+    search->user_data = user_data;
+
+    if (search->config.cores_per_worker < 1) search->config.cores_per_worker = 1;
+    if (search->config.min_epochs < 1) search->config.min_epochs = 1;
+    if (search->config.num_workers <= 0) {
+        int workers = thread_pool_hardware_threads() / search->config.cores_per_worker;
+        search->config.num_workers = workers > 0 ? workers : 1;
+    }
+
+    if (!generate_trials(search)) {
+        hyperparam_search_destroy(search);
+        return NULL;
+    }
+    return search;
+}
+
+void hyperparam_search_destroy(HyperparamSearch* search) {
+    if (!search) return;
+    free(search->trials);
+    free(search);
+}
+
+// ============================================================================
+// Trial Training
+// ============================================================================
+
+static void release_trial(TrialState* state) {
+    neural_network_destroy(state->net);
+    loss_destroy(state->loss);
+    optimizer_destroy(state->optimizer);
+    memset(state, 0, sizeof(*state));
+}
+
+/**
+ * @brief Build and compile a trial's network with its optimizer settings
+ */
+static bool setup_trial(SearchRun* run, HyperparamTrial* trial, TrialState* state) {
+    const HyperparamSearch* search = run->search;
+    const HyperparamSpace* space = &search->space;
+    const HyperparamSearchConfig* config = &search->config;
+
+    OptimizerType type = (OptimizerType)(int)hyperparam_trial_value(trial, space, "optimizer",
+                                                                    (float)config->optimizer);
+    float learning_rate = hyperparam_trial_value(trial, space, "learning_rate", config->learning_rate);
+
+    state->net = search->build(trial, space, search->user_data);
+    state->optimizer = optimizer_create(type, learning_rate);
+    state->loss = loss_create(config->loss);
+    if (!state->net || !state->optimizer || !state->loss) return false;
+
+    // Names optimizer_set_param does not know are builder parameters
+    for (int p = 0; p < space->num_params; p++) {
+        const char* name = space->params[p].name;
+        if (strcmp(name, "optimizer") != 0 && strcmp(name, "learning_rate") != 0 &&
+            strcmp(name, "batch_size") != 0) {
+            optimizer_set_param(state->optimizer, name, trial->values[p]);
+        }
+    }
+
+    if (!neural_network_compile(state->net, state->loss, state->optimizer)) return false;
+
+    TrainingConfig training = config->training;
+    training.batch_size = (int)hyperparam_trial_value(trial, space, "batch_size", (float)training.batch_size);
+    training.num_threads = config->cores_per_worker;
+    training.verbose = 0;
+    if (training.batch_size < 1) return false;
+    state->net->config = training;
+    return true;
+}
+
+static bool reserve_batch(SearchWorker* worker, int rows) {
+    if (worker->batch_capacity >= rows) return true;
+
+    const SearchRun* run = worker->run;
+    float* x = (float*)realloc(worker->x_batch, (size_t)rows * run->x_row * sizeof(float));
+    if (x) worker->x_batch = x;
+    float* y = x ? (float*)realloc(worker->y_batch, (size_t)rows * run->y_row * sizeof(float)) : NULL;
+    if (y) worker->y_batch = y;
+    if (!x || !y) return false;
+
+    worker->batch_capacity = rows;
+    return true;
+}
+
+/**
+ * @brief View of `rows` samples of a shared tensor
+ */
+static Tensor* sample_view(const Tensor* source, float* data, int rows) {
+    int shape[8];
+    int ndim = source->ndim < 8 ? source->ndim : 8;
+    memcpy(shape, source->shape, ndim * sizeof(int));
+    shape[0] = rows;
+    return tensor_create_view(data, shape, ndim);
+}
+
+/**
+ * @brief One pass over the training rows
+ * @return Mean training loss, NAN on failure
+ */
+static float train_epoch(SearchWorker* worker, HyperparamTrial* trial, NeuralNetwork* net) {
+    const SearchRun* run = worker->run;
+    int batch_size = net->config.batch_size;
+    bool shuffle = net->config.shuffle;
+
+    if (shuffle) {
+        // Seeded per trial and epoch: the order never depends on which worker trains it
+        unsigned int state = run->search->config.seed ^ (0x9e3779b9u * (unsigned int)(trial->id + 1)) ^
+                             (0x85ebca6bu * (unsigned int)(trial->epochs + 1));
+        for (int r = 0; r < run->train_rows; r++) worker->order[r] = r;
+        for (int r = run->train_rows - 1; r > 0; r--) {
+            int j = (int)(search_random(&state) % (unsigned int)(r + 1));
+            int t = worker->order[r];
+            worker->order[r] = worker->order[j];
+            worker->order[j] = t;
+        }
+        if (!reserve_batch(worker, batch_size)) return NAN;
+    }
+
+    double loss_sum = 0.0;
+    for (int offset = 0; offset < run->train_rows; offset += batch_size) {
+        int rows = run->train_rows - offset < batch_size ? run->train_rows - offset : batch_size;
+        float* x_data = run->x->data + (size_t)offset * run->x_row;
+        float* y_data = run->y->data + (size_t)offset * run->y_row;
+
+        if (shuffle) {
+            for (int r = 0; r < rows; r++) {
+                int source = worker->order[offset + r];
+                memcpy(worker->x_batch + (size_t)r * run->x_row, run->x->data + (size_t)source * run->x_row,
+                       run->x_row * sizeof(float));
+                memcpy(worker->y_batch + (size_t)r * run->y_row, run->y->data + (size_t)source * run->y_row,
+                       run->y_row * sizeof(float));
+            }
+            x_data = worker->x_batch;
+            y_data = worker->y_batch;
+        }
+
+        Tensor* xb = sample_view(run->x, x_data, rows);
+        Tensor* yb = sample_view(run->y, y_data, rows);
+        float loss = (xb && yb) ? neural_network_train_step(net, xb, yb, rows) : NAN;
+        tensor_destroy(xb);
+        tensor_destroy(yb);
+        loss_sum += (double)loss * rows;
+    }
+    return (float)(loss_sum / run->train_rows);
+}
+
+/**
+ * @brief Train a trial up to the rung budget, validating after every epoch
+ */
+static void train_trial(SearchWorker* worker, int id) {
+    SearchRun* run = worker->run;
+    HyperparamTrial* trial = &run->search->trials[id];
+    TrialState* state = &run->states[id];
+    double start = search_now();
+
+    trial->rung = run->rung;
+    trial->worker = worker->index;
+    if (!state->net && !setup_trial(run, trial, state)) {
+        trial->failed = true;
+        release_trial(state);
+        return;
+    }
+
+    NeuralNetwork* net = state->net;
+    while (trial->epochs < run->budget) {
+        trial->train_loss = train_epoch(worker, trial, net);
+
+        float metrics[8] = { 0 };
+        bool validated = neural_network_evaluate(net, run->x_val, run->y_val, metrics);
+        trial->val_loss = metrics[0];
+        trial->val_accuracy = metrics[1];
+        trial->epochs++;
+
+        // A diverged trial is failed rather than ranked
+        if (!validated || !isfinite(trial->train_loss) || !isfinite(trial->val_loss)) {
+            trial->failed = true;
+            break;
+        }
+        if (net->config.early_stopping && trial->epochs < net->config.epochs &&
+            neural_network_check_early_stopping(net, trial->val_loss)) {
+            trial->early_stopped = true;
+            break;
+        }
+    }
+
+    trial->seconds += search_now() - start;
+    if (trial->failed || trial->early_stopped) release_trial(state);
+}
+
+static void* search_worker(void* arg) {
+    SearchWorker* worker = (SearchWorker*)arg;
+    SearchRun* run = worker->run;
+    int cores = run->search->config.cores_per_worker;
+
+    // Pin first so the pool's threads inherit the core subset
+    thread_pool_pin_current_thread(worker->index * cores, cores);
+    ThreadPool* pool = thread_pool_create(cores);
+    gemm_bind_thread_pool(pool);
+
+    for (;;) {
+        pthread_mutex_lock(&run->lock);
+        int next = run->next++;
+        pthread_mutex_unlock(&run->lock);
+        if (next >= run->num_active) break;
+        train_trial(worker, run->active[next]);
+    }
+
+    gemm_bind_thread_pool(NULL);
+    gemm_release_thread_buffers();
+    thread_pool_destroy(pool);
+    return NULL;
+}
+
+/**
+ * @brief Train every active trial to the rung budget on the worker threads
+ */
+static void run_rung(SearchRun* run, SearchWorker* workers) {
+    int count = run->search->config.num_workers < run->num_active ? run->search->config.num_workers
+                                                                   : run->num_active;
+    run->next = 0;
+
+    pthread_t* threads = (pthread_t*)malloc(count * sizeof(pthread_t));
+    int started = 0;
+    for (int w = 0; threads && w < count; w++) {
+        if (pthread_create(&threads[w], NULL, search_worker, &workers[w]) != 0) break;
+        started++;
+    }
+
+    // No thread could start: train on the calling thread
+    if (started == 0) search_worker(&workers[0]);
+    for (int w = 0; w < started; w++) pthread_join(threads[w], NULL);
+    free(threads);
+}
+
+// ============================================================================
+// Successive Halving
+// ============================================================================
+
+/**
+ * @brief Ranking order: furthest rung, then lowest validation loss; failed trials last
+ */
+static int compare_trials(const HyperparamTrial* a, const HyperparamTrial* b) {
+    if (a->failed != b->failed) return a->failed ? 1 : -1;
+    if (a->rung != b->rung) return a->rung > b->rung ? -1 : 1;
+    if (a->val_loss != b->val_loss) return a->val_loss < b->val_loss ? -1 : 1;
+    return a->id < b->id ? -1 : (a->id > b->id);
+}
+
+static const HyperparamTrial* sort_trials;
+
+static int compare_indices(const void* a, const void* b) {
+    return compare_trials(&sort_trials[*(const int*)a], &sort_trials[*(const int*)b]);
+}
+
+/**
+ * @brief Trial indices in ranking order
+ */
+static int* ranked_indices(const HyperparamSearch* search, const int* ids, int count) {
+    int* order = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    if (!order) return NULL;
+    for (int i = 0; i < count; i++) order[i] = ids ? ids[i] : i;
+
+    // qsort has no context argument; ranking only runs on the driver thread
+    sort_trials = search->trials;
+    qsort(order, count, sizeof(int), compare_indices);
+    return order;
+}
+
+bool hyperparam_search_run(HyperparamSearch* search, Tensor* x, Tensor* y) {
+    if (!search || !x || !y || !x->data || !y->data || x->ndim < 1 || y->ndim < 1 ||
+        x->shape[0] != y->shape[0] || x->shape[0] < 2) {
+        return false;
+    }
+
+    const HyperparamSearchConfig* config = &search->config;
+    int rows = x->shape[0];
+    int val_rows = (int)(rows * config->training.validation_split);
+    if (val_rows >= rows) val_rows = rows - 1;
+    if (val_rows < 0) val_rows = 0;
+
+    SearchRun run;
+    memset(&run, 0, sizeof(run));
+    run.search = search;
+    run.x = x;
+    run.y = y;
+    run.x_row = x->size / rows;
+    run.y_row = y->size / rows;
+    run.train_rows = rows - val_rows;
+
+    // Without a split the training rows double as validation data
+    int val_offset = val_rows > 0 ? run.train_rows : 0;
+    int val_count = val_rows > 0 ? val_rows : rows;
+    run.x_val = sample_view(x, x->data + (size_t)val_offset * run.x_row, val_count);
+    run.y_val = sample_view(y, y->data + (size_t)val_offset * run.y_row, val_count);
+    run.states = (TrialState*)calloc(search->num_trials, sizeof(TrialState));
+    int* active = (int*)malloc(search->num_trials * sizeof(int));
+    SearchWorker* workers = (SearchWorker*)calloc(config->num_workers, sizeof(SearchWorker));
+
+    bool ok = run.x_val && run.y_val && run.states && active && workers;
+    for (int w = 0; ok && w < config->num_workers; w++) {
+        workers[w].run = &run;
+        workers[w].index = w;
+        workers[w].order = (int*)malloc(run.train_rows * sizeof(int));
+        ok = workers[w].order != NULL;
+    }
+
+    if (ok) {
+        pthread_mutex_init(&run.lock, NULL);
+        double start = search_now();
+        bool halving = config->reduction_factor > 1;
+        int max_epochs = config->training.epochs;
+
+        run.num_active = search->num_trials;
+        for (int t = 0; t < search->num_trials; t++) active[t] = t;
+        run.active = active;
+        run.budget = halving && config->min_epochs < max_epochs ? config->min_epochs : max_epochs;
+
+        for (run.rung = 0; run.num_active > 0; run.rung++) {
+            run_rung(&run, workers);
+            search->num_rungs = run.rung + 1;
+            if (run.budget >= max_epochs) break;
+
+            // Trials that finished the rung compete; the best 1 / eta train on
+            int survivors = 0;
+            for (int i = 0; i < run.num_active; i++) {
+                const HyperparamTrial* trial = &search->trials[active[i]];
+                if (!trial->failed && !trial->early_stopped) active[survivors++] = active[i];
+            }
+            int* ranked = ranked_indices(search, active, survivors);
+            if (!ranked) break;
+
+            int keep = survivors / config->reduction_factor;
+            if (keep < 1) keep = survivors < 1 ? 0 : 1;
+            for (int i = 0; i < survivors; i++) {
+                active[i] = ranked[i];
+                if (i >= keep) {
+                    search->trials[ranked[i]].eliminated = true;
+                    release_trial(&run.states[ranked[i]]);
+                }
+            }
+            free(ranked);
+
+            run.num_active = keep;
+            run.budget = run.budget * config->reduction_factor < max_epochs
+                             ? run.budget * config->reduction_factor : max_epochs;
+        }
+
+        search->seconds = search_now() - start;
+        pthread_mutex_destroy(&run.lock);
+    }
+
+    search->total_epochs = 0;
+    for (int t = 0; t < search->num_trials; t++) {
+        search->total_epochs += search->trials[t].epochs;
+        if (run.states) release_trial(&run.states[t]);
+    }
+    for (int w = 0; workers && w < config->num_workers; w++) {
+        free(workers[w].order);
+        free(workers[w].x_batch);
+        free(workers[w].y_batch);
+    }
+
+    free(workers);
+    free(active);
+    free(run.states);
+    tensor_destroy(run.x_val);
+    tensor_destroy(run.y_val);
+    return ok && hyperparam_search_best(search) != NULL;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+
+const HyperparamTrial* hyperparam_search_best(const HyperparamSearch* search) {
+    if (!search) return NULL;
+
+    const HyperparamTrial* best = NULL;
+    for (int t = 0; t < search->num_trials; t++) {
+        const HyperparamTrial* trial = &search->trials[t];
+        if (trial->epochs > 0 && !trial->failed && (!best || compare_trials(trial, best) < 0)) best = trial;
+    }
+    return best;
+}
+
+static const char* trial_status(const HyperparamTrial* trial) {
+    if (trial->failed) return "failed";
+    if (trial->eliminated) return "eliminated";
+    if (trial->early_stopped) return "early_stopped";
+    return trial->epochs > 0 ? "completed" : "pending";
+}
+
+bool hyperparam_search_write_results(const HyperparamSearch* search, const char* filename) {
+    if (!search || !filename) return false;
+
+    int* order = ranked_indices(search, NULL, search->num_trials);
+    FILE* file = order ? fopen(filename, "w") : NULL;
+    if (!file) {
+        free(order);
+        return false;
+    }
+
+    fprintf(file, "rank,trial");
+    for (int p = 0; p < search->space.num_params; p++) fprintf(file, ",%s", search->space.params[p].name);
+    fprintf(file, ",rung,epochs,train_loss,val_loss,val_accuracy,status,seconds\n");
+
+    for (int i = 0; i < search->num_trials; i++) {
+        const HyperparamTrial* trial = &search->trials[order[i]];
+        fprintf(file, "%d,%d", i + 1, trial->id);
+        for (int p = 0; p < search->space.num_params; p++) fprintf(file, ",%.6g", trial->values[p]);
+        fprintf(file, ",%d,%d,%.6g,%.6g,%.6g,%s,%.3f\n", trial->rung, trial->epochs, trial->train_loss,
+                trial->val_loss, trial->val_accuracy, trial_status(trial), trial->seconds);
+    }
+
+    free(order);
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+void hyperparam_search_summary(const HyperparamSearch* search, char* out, int max_length) {
+    if (!out || max_length <= 0) return;
+    if (!search) {
+        snprintf(out, max_length, "Hyperparameter search: none\n");
+        return;
+    }
+
+    int* order = ranked_indices(search, NULL, search->num_trials);
+    int written = snprintf(out, max_length, "Hyperparameter search (%d trials, %d rungs, %d epochs, %.1f s):\n",
+                           search->num_trials, search->num_rungs, search->total_epochs, search->seconds);
+
+    if (order && written >= 0 && written < max_length) {
+        written += snprintf(out + written, max_length - written, "  %4s %5s", "Rank", "Trial");
+        for (int p = 0; p < search->space.num_params && written >= 0 && written < max_length; p++) {
+            written += snprintf(out + written, max_length - written, " %13.13s", search->space.params[p].name);
+        }
+        if (written >= 0 && written < max_length) {
+            written += snprintf(out + written, max_length - written, " %4s %6s %9s %8s  %s\n", "Rung", "Epochs",
+                                "Val loss", "Val acc", "Status");
+        }
+    }
+
+    for (int i = 0; order && i < search->num_trials && written >= 0 && written < max_length; i++) {
+        const HyperparamTrial* trial = &search->trials[order[i]];
+        written += snprintf(out + written, max_length - written, "  %4d %5d", i + 1, trial->id);
+        for (int p = 0; p < search->space.num_params && written >= 0 && written < max_length; p++) {
+            written += snprintf(out + written, max_length - written, " %13.4g", trial->values[p]);
+        }
+        if (written >= 0 && written < max_length) {
+            written += snprintf(out + written, max_length - written, " %4d %6d %9.4f %7.1f%%  %s\n", trial->rung,
+                                trial->epochs, trial->val_loss, 100.0f * trial->val_accuracy, trial_status(trial));
+        }
+    }
+    free(order);
+}
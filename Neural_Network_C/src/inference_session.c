@@ -0,0 +1,179 @@
+/*
+ * Neural Network System - Inference Session Implementation
+ * Micro-batched forward passes on per-worker network replicas, with every
+ * temporary served from a per-worker arena sized by a planning pass
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/inference_session.h"
+#include "../headers/parallel_trainer.h"
+#include "../headers/tensor_arena.h"
+#include "../headers/layers.h"
+
+struct InferenceSession {
+    NeuralNetwork* net;                 // Served network (read only)
+    NeuralNetwork** replicas;           // Per-worker replicas sharing net's parameters
+    TensorArena** arenas;               // Per-worker scratch for forward temporaries
+    int num_workers;                    // Replicas, arenas and batcher workers
+    int sample_shape[INFERENCE_MAX_SAMPLE_DIMS]; // One sample, without the batch axis
+    int sample_ndim;                    // Rank of sample_shape
+    int input_size;                     // Floats per sample
+    int output_size;                    // Floats per prediction
+    MicroBatcher* batcher;              // Request queue and worker threads
+};
+
+// ============================================================================
+// Batched Forward
+// ============================================================================
+
+/**
+ * @brief Forward count samples on one worker's replica
+ * @return Output tensor (in the worker's arena) or NULL on failure
+ */
+static Tensor* session_forward(InferenceSession* session, int worker, const float* inputs, int count) {
+    int shape[INFERENCE_MAX_SAMPLE_DIMS + 1];
+    shape[0] = count;
+    memcpy(shape + 1, session->sample_shape, session->sample_ndim * sizeof(int));
+
+    Tensor* x = tensor_create_view((float*)inputs, shape, session->sample_ndim + 1);
+    return x ? neural_network_forward(session->replicas[worker], x) : NULL;
+}
+
+static bool session_batch(void* context, int worker, const float* inputs, int count, float* outputs) {
+    InferenceSession* session = (InferenceSession*)context;
+
+    TensorArena* previous = tensor_arena_activate(session->arenas[worker]);
+    Tensor* y = session_forward(session, worker, inputs, count);
+
+    bool ok = y && y->size == count * session->output_size;
+    if (ok) memcpy(outputs, y->data, (size_t)y->size * sizeof(float));
+
+    tensor_arena_reset(session->arenas[worker]);
+    tensor_arena_activate(previous);
+    return ok;
+}
+
+/**
+ * @brief Run a max_batch forward on every worker to size its arena
+ */
+static bool session_plan(InferenceSession* session, int max_batch) {
+    float* zeros = (float*)calloc((size_t)max_batch * session->input_size, sizeof(float));
+    if (!zeros) return false;
+
+    bool ok = true;
+    for (int w = 0; w < session->num_workers && ok; w++) {
+        TensorArena* previous = tensor_arena_activate(session->arenas[w]);
+        Tensor* y = session_forward(session, w, zeros, max_batch);
+
+        int output_size = (y && y->size % max_batch == 0) ? y->size / max_batch : 0;
+        if (w == 0) session->output_size = output_size;
+        ok = output_size > 0 && output_size == session->output_size;
+
+        tensor_arena_reset(session->arenas[w]);
+        tensor_arena_activate(previous);
+    }
+
+    free(zeros);
+    return ok;
+}
+
+// ============================================================================
+// Session Management
+// ============================================================================
+
+InferenceSession* inference_session_create(NeuralNetwork* net, const int* sample_shape,
+                                           int sample_ndim, MicroBatchConfig config) {
+    if (!net || net->num_layers <= 0) return NULL;
+    if (sample_shape && (sample_ndim <= 0 || sample_ndim > INFERENCE_MAX_SAMPLE_DIMS)) return NULL;
+
+    InferenceSession* session = (InferenceSession*)calloc(1, sizeof(InferenceSession));
+    if (!session) return NULL;
+
+    session->net = net;
+    if (sample_shape) {
+        memcpy(session->sample_shape, sample_shape, sample_ndim * sizeof(int));
+        session->sample_ndim = sample_ndim;
+    } else {
+        session->sample_shape[0] = net->input_size;
+        session->sample_ndim = 1;
+    }
+
+    session->input_size = 1;
+    for (int i = 0; i < session->sample_ndim; i++) session->input_size *= session->sample_shape[i];
+
+    if (config.max_batch <= 0) config.max_batch = 1;
+    if (config.num_workers <= 0) config.num_workers = thread_pool_hardware_threads();
+    session->num_workers = config.num_workers;
+
+    session->replicas = (NeuralNetwork**)calloc(session->num_workers, sizeof(NeuralNetwork*));
+    session->arenas = (TensorArena**)calloc(session->num_workers, sizeof(TensorArena*));
+    if (session->input_size <= 0 || !session->replicas || !session->arenas) {
+        inference_session_destroy(session);
+        return NULL;
+    }
+
+    // Replicas keep layer caches apart; the parameters stay a single shared copy
+    for (int w = 0; w < session->num_workers; w++) {
+        session->replicas[w] = neural_network_replicate(net);
+        session->arenas[w] = tensor_arena_create(0);
+        if (!session->replicas[w] || !session->arenas[w]) {
+            inference_session_destroy(session);
+            return NULL;
+        }
+        for (int l = 0; l < session->replicas[w]->num_layers; l++) {
+            layer_set_training_mode(session->replicas[w]->layers[l], false);
+        }
+    }
+
+    if (!session_plan(session, config.max_batch)) {
+        fprintf(stderr, "Inference session: planning forward pass failed\n");
+        inference_session_destroy(session);
+        return NULL;
+    }
+
+    session->batcher = micro_batcher_create(session->input_size, session->output_size, config,
+                                            session_batch, session);
+    if (!session->batcher) {
+        inference_session_destroy(session);
+        return NULL;
+    }
+    return session;
+}
+
+void inference_session_destroy(InferenceSession* session) {
+    if (!session) return;
+
+    // Workers drain the queue before the replicas go away
+    micro_batcher_destroy(session->batcher);
+
+    for (int w = 0; w < session->num_workers; w++) {
+        if (session->replicas && session->replicas[w]) neural_network_destroy(session->replicas[w]);
+        if (session->arenas && session->arenas[w]) tensor_arena_destroy(session->arenas[w]);
+    }
+    free(session->replicas);
+    free(session->arenas);
+    free(session);
+}
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+bool inference_session_predict(InferenceSession* session, const float* input, float* output) {
+    return session && micro_batcher_submit(session->batcher, input, output);
+}
+
+int inference_session_input_size(const InferenceSession* session) {
+    return session ? session->input_size : 0;
+}
+
+int inference_session_output_size(const InferenceSession* session) {
+    return session ? session->output_size : 0;
+}
+
+void inference_session_get_stats(InferenceSession* session, MicroBatchStats* stats) {
+    if (!session || !stats) return;
+    micro_batcher_get_stats(session->batcher, stats);
+}
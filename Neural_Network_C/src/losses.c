@@ -8,6 +8,10 @@
 #include <string.h>
 #include <math.h>
 #include "../headers/losses.h"
+#include "../headers/vec_math.h"
+
+// Cross-entropy logs are taken in blocks through the vectorized log
+#define LOSS_LOG_CHUNK 256
 
 // ============================================================================
 // Loss Function Creation and Management
@@ -19,6 +23,7 @@ Loss* loss_create(LossType type) {
 
     loss->type = type;
     loss->user_data = NULL;
+    loss->compute_with_gradient = NULL;
 
     // Set function pointers based on type
     switch (type) {
@@ -40,6 +45,13 @@ Loss* loss_create(LossType type) {
             loss->gradient = loss_categorical_crossentropy_gradient;
             break;
 
+        case LOSS_SOFTMAX_CROSSENTROPY:
+            strcpy(loss->name, "Softmax Cross-Entropy");
+            loss->compute = loss_softmax_crossentropy_compute;
+            loss->gradient = loss_softmax_crossentropy_gradient;
+            loss->compute_with_gradient = loss_softmax_crossentropy_fused;
+            break;
+
         case LOSS_HUBER:
             strcpy(loss->name, "Huber Loss");
             // Note: Huber loss would need additional parameters
@@ -76,6 +88,24 @@ Tensor* loss_gradient(Loss* loss, Tensor* predictions, Tensor* targets) {
     return loss->gradient(predictions, targets);
 }
 
+float loss_compute_with_gradient(Loss* loss, Tensor* predictions, Tensor* targets, Tensor* gradient) {
+    if (!loss || !predictions || !targets || !gradient || gradient->size != predictions->size) {
+        return 0.0f;
+    }
+
+    if (loss->compute_with_gradient) {
+        return loss->compute_with_gradient(predictions, targets, gradient);
+    }
+
+    float value = loss_compute(loss, predictions, targets);
+    Tensor* separate = loss_gradient(loss, predictions, targets);
+    if (separate) {
+        memcpy(gradient->data, separate->data, (size_t)gradient->size * sizeof(float));
+        tensor_destroy(separate);
+    }
+    return value;
+}
+
 // ============================================================================
 // Mean Squared Error Implementation
 // ============================================================================
@@ -121,15 +151,23 @@ float loss_binary_crossentropy_compute(Tensor* predictions, Tensor* targets) {
 
     float sum = 0.0f;
     const float epsilon = 1e-7f; // Prevent log(0)
+    float logs[2 * LOSS_LOG_CHUNK];
 
-    for (int i = 0; i < predictions->size; i++) {
-        float pred = predictions->data[i];
-        float target = targets->data[i];
+    for (int base = 0; base < predictions->size; base += LOSS_LOG_CHUNK) {
+        int count = predictions->size - base < LOSS_LOG_CHUNK ? predictions->size - base : LOSS_LOG_CHUNK;
 
-        // Clamp predictions to prevent log(0)
-        pred = fmaxf(epsilon, fminf(1.0f - epsilon, pred));
+        for (int i = 0; i < count; i++) {
+            // Clamp predictions to prevent log(0)
+            float pred = fmaxf(epsilon, fminf(1.0f - epsilon, predictions->data[base + i]));
+            logs[i] = pred;
+            logs[count + i] = 1.0f - pred;
+        }
+        vec_math_log(logs, 2 * count);
 
-        sum += -target * logf(pred) - (1.0f - target) * logf(1.0f - pred);
+        for (int i = 0; i < count; i++) {
+            float target = targets->data[base + i];
+            sum += -target * logs[i] - (1.0f - target) * logs[count + i];
+        }
     }
 
     return sum / predictions->size;
@@ -174,15 +212,16 @@ float loss_categorical_crossentropy_compute(Tensor* predictions, Tensor* targets
 
     float sum = 0.0f;
     const float epsilon = 1e-7f;
+    float logs[LOSS_LOG_CHUNK];
 
-    for (int i = 0; i < predictions->size; i++) {
-        float pred = predictions->data[i];
-        float target = targets->data[i];
+    for (int base = 0; base < predictions->size; base += LOSS_LOG_CHUNK) {
+        int count = predictions->size - base < LOSS_LOG_CHUNK ? predictions->size - base : LOSS_LOG_CHUNK;
 
         // Clamp predictions
-        pred = fmaxf(epsilon, pred);
+        for (int i = 0; i < count; i++) logs[i] = fmaxf(epsilon, predictions->data[base + i]);
+        vec_math_log(logs, count);
 
-        sum += -target * logf(pred);
+        for (int i = 0; i < count; i++) sum += -targets->data[base + i] * logs[i];
     }
 
     return sum / predictions->size;
@@ -203,6 +242,142 @@ Tensor* loss_categorical_crossentropy_gradient(Tensor* predictions, Tensor* targ
     return gradient;
 }
 
+// ============================================================================
+// Fused Softmax Cross-Entropy Implementation
+// ============================================================================
+
+/**
+ * @brief Loss of one row; writes (softmax - target) * scale when g is set
+ *
+ * Exactly one of target (dense row) and label (sparse, >= 0) is used.
+ */
+static float softmax_crossentropy_row(const float* z, int classes, const float* target, int label,
+                                      float scale, float* g) {
+    float max = z[0];
+    for (int j = 1; j < classes; j++) max = z[j] > max ? z[j] : max;
+
+    // e^(z - max) lands in the gradient row, or in blocks of a local buffer
+    float sum = 0.0f;
+    if (g) {
+        for (int j = 0; j < classes; j++) g[j] = z[j] - max;
+        vec_math_exp(g, classes);
+        for (int j = 0; j < classes; j++) sum += g[j];
+    } else {
+        float block[LOSS_LOG_CHUNK];
+        for (int base = 0; base < classes; base += LOSS_LOG_CHUNK) {
+            int count = classes - base < LOSS_LOG_CHUNK ? classes - base : LOSS_LOG_CHUNK;
+            for (int j = 0; j < count; j++) block[j] = z[base + j] - max;
+            vec_math_exp(block, count);
+            for (int j = 0; j < count; j++) sum += block[j];
+        }
+    }
+
+    float lse = max + vec_math_logf(sum);
+    float loss = 0.0f;
+    if (target) {
+        for (int j = 0; j < classes; j++) {
+            if (target[j] != 0.0f) loss += target[j] * (lse - z[j]);
+        }
+    } else {
+        loss = lse - z[label];
+    }
+
+    if (g) {
+        float inv = scale / sum;
+        if (target) {
+            for (int j = 0; j < classes; j++) g[j] = g[j] * inv - target[j] * scale;
+        } else {
+            for (int j = 0; j < classes; j++) g[j] *= inv;
+            g[label] -= scale;
+        }
+    }
+
+    return loss;
+}
+
+/**
+ * @brief Row layout of logits and target form; false if they do not match
+ */
+static bool softmax_crossentropy_layout(const Tensor* logits, const Tensor* targets,
+                                        int* rows, int* classes, bool* sparse) {
+    if (!logits || !targets || !logits->data || !targets->data || logits->ndim < 1) return false;
+
+    *classes = logits->shape[logits->ndim - 1];
+    if (*classes <= 0 || logits->size % *classes != 0) return false;
+    *rows = logits->size / *classes;
+
+    if (targets->size == logits->size) {
+        *sparse = false;
+    } else if (targets->size == *rows) {
+        *sparse = true;
+        for (int r = 0; r < *rows; r++) {
+            float v = targets->data[r];
+            if (!(v >= 0.0f && v < (float)*classes) || v != (float)(int)v) return false;
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+float loss_softmax_crossentropy_fused(Tensor* logits, Tensor* targets, Tensor* gradient) {
+    int rows, classes;
+    bool sparse;
+    if (!softmax_crossentropy_layout(logits, targets, &rows, &classes, &sparse) ||
+        (gradient && gradient->size != logits->size) || rows == 0) {
+        return 0.0f;
+    }
+
+    float scale = 1.0f / rows;
+    double sum = 0.0;
+    for (int r = 0; r < rows; r++) {
+        const float* z = logits->data + (size_t)r * classes;
+        float* g = gradient ? gradient->data + (size_t)r * classes : NULL;
+        if (sparse) {
+            sum += softmax_crossentropy_row(z, classes, NULL, (int)targets->data[r], scale, g);
+        } else {
+            sum += softmax_crossentropy_row(z, classes, targets->data + (size_t)r * classes, -1, scale, g);
+        }
+    }
+
+    return (float)(sum / rows);
+}
+
+float loss_softmax_crossentropy_compute(Tensor* logits, Tensor* targets) {
+    return loss_softmax_crossentropy_fused(logits, targets, NULL);
+}
+
+Tensor* loss_softmax_crossentropy_gradient(Tensor* logits, Tensor* targets) {
+    int rows, classes;
+    bool sparse;
+    if (!softmax_crossentropy_layout(logits, targets, &rows, &classes, &sparse)) {
+        return NULL;
+    }
+
+    Tensor* gradient = tensor_create(NULL, logits->shape, logits->ndim);
+    if (!gradient) return NULL;
+
+    loss_softmax_crossentropy_fused(logits, targets, gradient);
+    return gradient;
+}
+
+float loss_softmax_crossentropy_sparse(const float* logits, const int* labels, int rows, int classes,
+                                       float* gradient) {
+    if (!logits || !labels || rows <= 0 || classes <= 0) return 0.0f;
+    for (int r = 0; r < rows; r++) {
+        if (labels[r] < 0 || labels[r] >= classes) return 0.0f;
+    }
+
+    float scale = 1.0f / rows;
+    double sum = 0.0;
+    for (int r = 0; r < rows; r++) {
+        sum += softmax_crossentropy_row(logits + (size_t)r * classes, classes, NULL, labels[r], scale,
+                                        gradient ? gradient + (size_t)r * classes : NULL);
+    }
+
+    return (float)(sum / rows);
+}
+
 // ============================================================================
 // Utility Functions
 // ============================================================================
@@ -213,12 +388,14 @@ const char* loss_get_name(LossType type) {
         case LOSS_BINARY_CROSS_ENTROPY: return "Binary Cross-Entropy";
         case LOSS_CATEGORICAL_CROSS_ENTROPY: return "Categorical Cross-Entropy";
         case LOSS_HUBER: return "Huber Loss";
+        case LOSS_SOFTMAX_CROSSENTROPY: return "Softmax Cross-Entropy";
         default: return "Unknown";
     }
 }
 
 bool loss_is_classification(LossType type) {
-    return type == LOSS_BINARY_CROSS_ENTROPY || type == LOSS_CATEGORICAL_CROSS_ENTROPY;
+    return type == LOSS_BINARY_CROSS_ENTROPY || type == LOSS_CATEGORICAL_CROSS_ENTROPY ||
+           type == LOSS_SOFTMAX_CROSSENTROPY;
 }
 
 bool loss_is_regression(LossType type) {
@@ -238,6 +415,13 @@ LossType loss_recommend(int num_classes) {
 bool loss_validate(Loss* loss, Tensor* predictions, Tensor* targets) {
     if (!loss || !predictions || !targets) return false;
 
+    // Logits are unbounded and targets may be one class index per row
+    if (loss->type == LOSS_SOFTMAX_CROSSENTROPY) {
+        int rows, classes;
+        bool sparse;
+        return softmax_crossentropy_layout(predictions, targets, &rows, &classes, &sparse);
+    }
+
     // Check tensor sizes match
     if (predictions->size != targets->size) return false;
 
@@ -3,6 +3,10 @@
  * Entry point for the neural network training and inference system
  */
 
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L     // clock_gettime
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,6 +17,7 @@
 #include "../headers/activations.h"
 #include "../headers/losses.h"
 #include "../headers/optimizers.h"
+#include "../headers/parallel_trainer.h"
 
 // ============================================================================
 // Demo Data Generation
@@ -47,7 +52,8 @@ void generate_xor_data(float* x, float* y, int samples) {
  * @param features Number of features
  * @param classes Number of classes
  */
-void generate_classification_data(float* x, float* y, int samples, int features, int classes) {
+void generate_classification_data(float* x, float* y, int samples, int features, int classes,
+                                  bool one_hot) {
     for (int i = 0; i < samples; i++) {
         // Generate random features
         for (int f = 0; f < features; f++) {
@@ -61,13 +67,30 @@ void generate_classification_data(float* x, float* y, int samples, int features,
             class_idx = class_idx < 0 ? 0 : (class_idx >= classes ? classes - 1 : class_idx);
         }
 
-        // One-hot encoding for targets
+        // One-hot encoding for targets, or the class index alone
+        if (!one_hot) {
+            y[i] = (float)class_idx;
+            continue;
+        }
         for (int c = 0; c < classes; c++) {
             y[i * classes + c] = (c == class_idx) ? 1.0f : 0.0f;
         }
     }
 }
 
+/**
+ * @brief Monotonic wall-clock time in seconds
+ */
+static double wall_time_seconds(void) {
+#ifdef _WIN32
+    return (double)clock() / CLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
 // ============================================================================
 // Demo Functions
 // ============================================================================
@@ -188,10 +211,10 @@ void demo_classification_network() {
 
     // Add layers
     neural_network_add_layer(net, layer_dense_create(features, 8, activation_relu));
-    neural_network_add_layer(net, layer_dense_create(8, classes, activation_softmax));
+    neural_network_add_layer(net, layer_dense_create(8, classes, activation_linear));
 
-    // Create loss and optimizer
-    Loss* loss = loss_create(LOSS_CATEGORICAL_CROSS_ENTROPY);
+    // Softmax is fused into the loss, which takes logits and class indices
+    Loss* loss = loss_create(LOSS_SOFTMAX_CROSSENTROPY);
     Optimizer* optimizer = optimizer_create(OPTIMIZER_ADAM, 0.001f);
 
     // Compile network
@@ -203,24 +226,24 @@ void demo_classification_network() {
     printf("✅ Network compiled successfully\n");
     printf("   - Input features: %d\n", features);
     printf("   - Hidden layer: 8 neurons (ReLU)\n");
-    printf("   - Output classes: %d (Softmax)\n", classes);
-    printf("   - Loss: Categorical Cross-Entropy\n");
+    printf("   - Output classes: %d (logits)\n", classes);
+    printf("   - Loss: Softmax Cross-Entropy (sparse labels)\n");
     printf("   - Optimizer: Adam (lr=0.001)\n\n");
 
     // Generate training data
     float* x_data = (float*)malloc(samples * features * sizeof(float));
-    float* y_data = (float*)malloc(samples * classes * sizeof(float));
+    float* y_data = (float*)malloc(samples * sizeof(float));
 
     if (!x_data || !y_data) {
         printf("❌ Memory allocation failed\n");
         return;
     }
 
-    generate_classification_data(x_data, y_data, samples, features, classes);
+    generate_classification_data(x_data, y_data, samples, features, classes, false);
 
     // Create tensors
     Tensor* x_tensor = tensor_create(x_data, (int[]){samples, features}, 2);
-    Tensor* y_tensor = tensor_create(y_data, (int[]){samples, classes}, 2);
+    Tensor* y_tensor = tensor_create(y_data, (int[]){samples}, 1);
 
     if (!x_tensor || !y_tensor) {
         printf("❌ Tensor creation failed\n");
@@ -252,7 +275,8 @@ void demo_classification_network() {
             Tensor* prediction = neural_network_predict(net, test_input);
 
             if (prediction && prediction->data) {
-                // Find predicted class
+                // Logits to probabilities, then find predicted class
+                activation_softmax(prediction->data, classes);
                 int predicted_class = 0;
                 float max_prob = prediction->data[0];
                 for (int c = 1; c < classes; c++) {
@@ -284,6 +308,105 @@ void demo_classification_network() {
     optimizer_destroy(optimizer);
 }
 
+/**
+ * @brief Measure data-parallel training throughput for 1..N threads
+ *
+ * Trains the classification demo network with the parallel trainer on a
+ * larger synthetic dataset and reports samples/second and speedup.
+ */
+void demo_thread_scaling() {
+    printf("⚡ Training Thread Scaling Benchmark\n");
+    printf("===================================\n\n");
+
+    const int features = 4;
+    const int classes = 3;
+    const int samples = 20000;
+    const int batch_size = 512;
+    const int epochs = 3;
+    const int max_threads = thread_pool_hardware_threads();
+
+    float* x_data = (float*)malloc(samples * features * sizeof(float));
+    float* y_data = (float*)malloc(samples * classes * sizeof(float));
+    if (!x_data || !y_data) {
+        printf("❌ Memory allocation failed\n");
+        free(x_data);
+        free(y_data);
+        return;
+    }
+    generate_classification_data(x_data, y_data, samples, features, classes, true);
+
+    printf("Dataset: %d samples, batch %d, %d epochs, up to %d threads\n\n",
+           samples, batch_size, epochs, max_threads);
+    printf("Threads | Time (s) | Samples/s | Speedup | Final loss | Heap allocs/step\n");
+    printf("--------+----------+-----------+---------+------------+-----------------\n");
+
+    double baseline = 0.0;
+    for (int threads = 1; threads <= max_threads; threads++) {
+        srand(1234); // Identical initial weights for every run
+
+        NeuralNetwork* net = neural_network_create("Scaling_Network");
+        neural_network_add_layer(net, layer_dense_create(features, 8, activation_relu));
+        neural_network_add_layer(net, layer_dense_create(8, classes, activation_softmax));
+
+        Loss* loss = loss_create(LOSS_CATEGORICAL_CROSS_ENTROPY);
+        Optimizer* optimizer = optimizer_create(OPTIMIZER_ADAM, 0.001f);
+
+        ParallelTrainer* trainer = NULL;
+        if (neural_network_compile(net, loss, optimizer)) {
+            trainer = parallel_trainer_create(net, threads);
+        }
+        if (!trainer) {
+            printf("❌ Failed to set up %d-thread trainer\n", threads);
+            neural_network_destroy(net);
+            loss_destroy(loss);
+            optimizer_destroy(optimizer);
+            break;
+        }
+
+        float last_loss = 0.0f;
+        uint64_t step_allocs = 0;
+        int measured_steps = 0;
+        double start = wall_time_seconds();
+
+        for (int epoch = 0; epoch < epochs; epoch++) {
+            for (int offset = 0; offset < samples; offset += batch_size) {
+                int rows = (samples - offset < batch_size) ? samples - offset : batch_size;
+                Tensor* xb = tensor_create_view(&x_data[offset * features], (int[]){rows, features}, 2);
+                Tensor* yb = tensor_create_view(&y_data[offset * classes], (int[]){rows, classes}, 2);
+
+                TensorAllocStats before, after;
+                tensor_get_alloc_stats(&before);
+                last_loss = parallel_trainer_train_step(trainer, xb, yb);
+                tensor_get_alloc_stats(&after);
+
+                // The first epoch warms up the arenas
+                if (epoch > 0) {
+                    step_allocs += after.heap_allocations - before.heap_allocations;
+                    measured_steps++;
+                }
+
+                tensor_destroy(xb);
+                tensor_destroy(yb);
+            }
+        }
+
+        double elapsed = wall_time_seconds() - start;
+        if (threads == 1) baseline = elapsed;
+
+        printf("%7d | %8.3f | %9.0f | %6.2fx | %10.4f | %16.2f\n", threads, elapsed,
+               samples * epochs / elapsed, baseline / elapsed, last_loss,
+               measured_steps ? (double)step_allocs / measured_steps : 0.0);
+
+        parallel_trainer_destroy(trainer);
+        neural_network_destroy(net);
+        loss_destroy(loss);
+        optimizer_destroy(optimizer);
+    }
+
+    free(x_data);
+    free(y_data);
+}
+
 /**
  * @brief Display system information
  */
@@ -311,7 +434,8 @@ void display_system_info() {
     printf("🚀 Available Demos:\n");
     printf("1. XOR Problem - Classic neural network example\n");
     printf("2. Multi-Class Classification - General classification task\n");
-    printf("3. System Information - This display\n\n");
+    printf("3. System Information - This display\n");
+    printf("4. Thread Scaling - Data-parallel training benchmark\n\n");
 }
 
 /**
@@ -324,9 +448,10 @@ int display_menu() {
     printf("1. XOR Neural Network\n");
     printf("2. Multi-Class Classification\n");
     printf("3. System Information\n");
+    printf("4. Thread Scaling Benchmark\n");
     printf("0. Exit\n\n");
 
-    printf("Enter your choice (0-3): ");
+    printf("Enter your choice (0-4): ");
     int choice;
     scanf("%d", &choice);
     return choice;
@@ -351,6 +476,9 @@ int main(int argc, char* argv[]) {
         } else if (strcmp(argv[1], "--info") == 0) {
             display_system_info();
             return 0;
+        } else if (strcmp(argv[1], "--scaling") == 0) {
+            demo_thread_scaling();
+            return 0;
         }
     }
 
@@ -371,6 +499,9 @@ int main(int argc, char* argv[]) {
             case 3:
                 display_system_info();
                 break;
+            case 4:
+                demo_thread_scaling();
+                break;
             case 0:
                 running = false;
                 break;
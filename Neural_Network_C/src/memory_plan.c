@@ -0,0 +1,431 @@
+/*
+ * Neural Network System - Static Memory Planner Implementation
+ * Buffer lifetimes from the layer schedule, greedy-by-size offset
+ * assignment and the slab shared by a network's training and inference
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../headers/memory_plan.h"
+#include "../headers/layers.h"
+#include "../headers/conv_kernels.h"
+#include "../headers/rnn_kernels.h"
+
+/**
+ * @brief Plans of one network and the slab they share
+ */
+typedef struct {
+    MemoryPlan* training;       // Forward + backward schedule
+    MemoryPlan* inference;      // Forward-only schedule
+    void* slab_raw;             // Shared allocation
+    int batch;                  // Planned batch size
+} NetworkMemoryPlan;
+
+static size_t memory_plan_align(size_t bytes) {
+    return (bytes + MEMORY_PLAN_ALIGNMENT - 1) & ~(size_t)(MEMORY_PLAN_ALIGNMENT - 1);
+}
+
+// ============================================================================
+// Plan Management
+// ============================================================================
+
+MemoryPlan* memory_plan_create(int num_steps, bool training) {
+    if (num_steps <= 0) return NULL;
+
+    MemoryPlan* plan = (MemoryPlan*)calloc(1, sizeof(MemoryPlan));
+    if (!plan) return NULL;
+
+    plan->num_steps = num_steps;
+    plan->training = training;
+    return plan;
+}
+
+void memory_plan_destroy(MemoryPlan* plan) {
+    if (!plan) return;
+    free(plan->buffers);
+    free(plan->slab_raw);
+    free(plan);
+}
+
+int memory_plan_add(MemoryPlan* plan, MemoryBufferKind kind, int layer, size_t bytes,
+                    int first_step, int last_step) {
+    if (!plan || first_step < 0 || last_step < first_step || last_step >= plan->num_steps) {
+        return -1;
+    }
+
+    if (plan->num_buffers == plan->capacity) {
+        int capacity = plan->capacity ? plan->capacity * 2 : 16;
+        MemoryBuffer* grown = (MemoryBuffer*)realloc(plan->buffers, capacity * sizeof(MemoryBuffer));
+        if (!grown) return -1;
+        plan->buffers = grown;
+        plan->capacity = capacity;
+    }
+
+    MemoryBuffer* buffer = &plan->buffers[plan->num_buffers];
+    buffer->kind = kind;
+    buffer->layer = layer;
+    buffer->bytes = bytes;
+    buffer->first_step = first_step;
+    buffer->last_step = last_step;
+    buffer->offset = 0;
+    return plan->num_buffers++;
+}
+
+int memory_plan_find(const MemoryPlan* plan, MemoryBufferKind kind, int layer, int which) {
+    if (!plan) return -1;
+    for (int i = 0; i < plan->num_buffers; i++) {
+        const MemoryBuffer* b = &plan->buffers[i];
+        if (b->kind == kind && b->layer == layer && which-- == 0) return i;
+    }
+    return -1;
+}
+
+// ============================================================================
+// Offset Assignment
+// ============================================================================
+
+static bool lifetimes_overlap(const MemoryBuffer* a, const MemoryBuffer* b) {
+    return a->first_step <= b->last_step && b->first_step <= a->last_step;
+}
+
+static const MemoryPlan* sort_plan;     // qsort has no context argument
+
+static int compare_by_size(const void* a, const void* b) {
+    const MemoryBuffer* x = &sort_plan->buffers[*(const int*)a];
+    const MemoryBuffer* y = &sort_plan->buffers[*(const int*)b];
+    if (x->bytes != y->bytes) return x->bytes < y->bytes ? 1 : -1;
+    if (x->first_step != y->first_step) return x->first_step - y->first_step;
+    return *(const int*)a - *(const int*)b;
+}
+
+static int compare_by_offset(const void* a, const void* b) {
+    const MemoryBuffer* x = &sort_plan->buffers[*(const int*)a];
+    const MemoryBuffer* y = &sort_plan->buffers[*(const int*)b];
+    return (x->offset > y->offset) - (x->offset < y->offset);
+}
+
+bool memory_plan_solve(MemoryPlan* plan) {
+    if (!plan || plan->num_buffers == 0) return false;
+
+    int n = plan->num_buffers;
+    int* order = (int*)malloc(2 * n * sizeof(int));
+    size_t* live = (size_t*)calloc(plan->num_steps, sizeof(size_t));
+    if (!order || !live) {
+        free(order);
+        free(live);
+        return false;
+    }
+    int* conflicts = order + n;
+
+    for (int i = 0; i < n; i++) order[i] = i;
+    sort_plan = plan;
+    qsort(order, n, sizeof(int), compare_by_size);
+
+    plan->peak_bytes = 0;
+    plan->total_bytes = 0;
+
+    for (int placed = 0; placed < n; placed++) {
+        MemoryBuffer* b = &plan->buffers[order[placed]];
+        size_t size = memory_plan_align(b->bytes);
+
+        // Earlier (larger) buffers alive at the same time, by offset
+        int num_conflicts = 0;
+        for (int j = 0; j < placed; j++) {
+            if (lifetimes_overlap(b, &plan->buffers[order[j]])) conflicts[num_conflicts++] = order[j];
+        }
+        qsort(conflicts, num_conflicts, sizeof(int), compare_by_offset);
+
+        // Smallest gap that fits, else the end of the conflicting range
+        size_t best_offset = SIZE_MAX, best_gap = SIZE_MAX, cursor = 0;
+        for (int j = 0; j < num_conflicts; j++) {
+            const MemoryBuffer* c = &plan->buffers[conflicts[j]];
+            if (c->offset >= cursor + size && c->offset - cursor < best_gap) {
+                best_gap = c->offset - cursor;
+                best_offset = cursor;
+            }
+            size_t end = c->offset + memory_plan_align(c->bytes);
+            if (end > cursor) cursor = end;
+        }
+        b->offset = best_offset != SIZE_MAX ? best_offset : cursor;
+
+        if (b->offset + size > plan->peak_bytes) plan->peak_bytes = b->offset + size;
+        plan->total_bytes += size;
+        for (int s = b->first_step; s <= b->last_step; s++) live[s] += size;
+    }
+
+    plan->live_bytes_bound = 0;
+    for (int s = 0; s < plan->num_steps; s++) {
+        if (live[s] > plan->live_bytes_bound) plan->live_bytes_bound = live[s];
+    }
+
+    free(order);
+    free(live);
+    return true;
+}
+
+bool memory_plan_verify(const MemoryPlan* plan) {
+    if (!plan) return false;
+
+    for (int i = 0; i < plan->num_buffers; i++) {
+        const MemoryBuffer* a = &plan->buffers[i];
+        if (a->offset % MEMORY_PLAN_ALIGNMENT != 0 || a->offset + a->bytes > plan->peak_bytes) return false;
+
+        for (int j = i + 1; j < plan->num_buffers; j++) {
+            const MemoryBuffer* b = &plan->buffers[j];
+            if (a->bytes == 0 || b->bytes == 0 || !lifetimes_overlap(a, b)) continue;
+            if (a->offset < b->offset + b->bytes && b->offset < a->offset + a->bytes) return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Layer Schedules
+// ============================================================================
+
+MemoryPlan* memory_plan_layers(const MemoryPlanLayer* layers, int num_layers, bool training) {
+    if (!layers || num_layers <= 0) return NULL;
+
+    int last = num_layers - 1;
+    MemoryPlan* plan = memory_plan_create(training ? 2 * num_layers + 1 : num_layers, training);
+    if (!plan) return NULL;
+
+    bool ok = true;
+    for (int l = 0; l < num_layers && ok; l++) {
+        const MemoryPlanLayer* layer = &layers[l];
+        int backward = 2 * num_layers - l;
+
+        if (training) {
+            ok = memory_plan_add(plan, MEMORY_BUFFER_ACTIVATION, l, layer->output_floats * sizeof(float),
+                                 l, backward) >= 0;
+            // dL/d(output of l) comes from the loss or from backward of layer l + 1
+            if (ok) ok = memory_plan_add(plan, MEMORY_BUFFER_GRADIENT, l, layer->output_floats * sizeof(float),
+                                         backward - 1, backward) >= 0;
+            if (ok && layer->saved_floats) {
+                ok = memory_plan_add(plan, MEMORY_BUFFER_SAVED, l, layer->saved_floats * sizeof(float),
+                                     l, backward) >= 0;
+            }
+            if (ok && layer->forward_scratch) {
+                ok = memory_plan_add(plan, MEMORY_BUFFER_SCRATCH, l, layer->forward_scratch * sizeof(float),
+                                     l, l) >= 0;
+            }
+            if (ok && layer->backward_scratch) {
+                ok = memory_plan_add(plan, MEMORY_BUFFER_SCRATCH, l, layer->backward_scratch * sizeof(float),
+                                     backward, backward) >= 0;
+            }
+        } else {
+            int dies = l == last ? last : l + 1;
+            ok = memory_plan_add(plan, MEMORY_BUFFER_ACTIVATION, l, layer->output_floats * sizeof(float),
+                                 l, dies) >= 0;
+            size_t scratch = layer->saved_floats + layer->forward_scratch;
+            if (ok && scratch) {
+                ok = memory_plan_add(plan, MEMORY_BUFFER_SCRATCH, l, scratch * sizeof(float), l, l) >= 0;
+            }
+        }
+    }
+
+    if (!ok || !memory_plan_solve(plan)) {
+        memory_plan_destroy(plan);
+        return NULL;
+    }
+    return plan;
+}
+
+// ============================================================================
+// Slab
+// ============================================================================
+
+bool memory_plan_allocate(MemoryPlan* plan) {
+    if (!plan || plan->num_buffers == 0) return false;
+    if (plan->slab) return true;
+
+    plan->slab_raw = malloc(plan->peak_bytes + MEMORY_PLAN_ALIGNMENT);
+    if (!plan->slab_raw) return false;
+
+    uintptr_t base = (uintptr_t)plan->slab_raw;
+    plan->slab = (void*)((base + MEMORY_PLAN_ALIGNMENT - 1) & ~(uintptr_t)(MEMORY_PLAN_ALIGNMENT - 1));
+    return true;
+}
+
+void* memory_plan_buffer(const MemoryPlan* plan, int index) {
+    if (!plan || !plan->slab || index < 0 || index >= plan->num_buffers) return NULL;
+    return (char*)plan->slab + plan->buffers[index].offset;
+}
+
+void memory_plan_describe(const MemoryPlan* plan, char* out, int max_length) {
+    if (!out || max_length <= 0) return;
+    if (!plan) {
+        snprintf(out, max_length, "not planned");
+        return;
+    }
+
+    const double mb = 1024.0 * 1024.0;
+    snprintf(out, max_length, "%.2f MB peak (%.2f MB without reuse, live-set bound %.2f MB, %d buffers)",
+             plan->peak_bytes / mb, plan->total_bytes / mb, plan->live_bytes_bound / mb, plan->num_buffers);
+}
+
+// ============================================================================
+// Network Integration
+// ============================================================================
+
+static size_t shape_floats(const int* shape, int ndim) {
+    if (!shape || ndim <= 0) return 0;
+    size_t count = 1;
+    for (int i = 0; i < ndim; i++) count *= shape[i] > 0 ? (size_t)shape[i] : 0;
+    return count;
+}
+
+/**
+ * @brief Planner view of one layer (per-sample shapes times batch)
+ */
+static bool describe_layer(const Layer* layer, int batch, MemoryPlanLayer* out) {
+    memset(out, 0, sizeof(*out));
+    out->output_floats = (size_t)batch * shape_floats(layer->output_shape, layer->output_ndim);
+    if (out->output_floats == 0) return false;
+
+    switch (layer->type) {
+        case LAYER_DENSE: {
+            const DenseData* data = (const DenseData*)layer->layer_data;
+            if (data && data->params.dropout_rate > 0.0f) out->saved_floats = out->output_floats;
+            break;
+        }
+        case LAYER_CONV2D: {
+            const Conv2DData* data = (const Conv2DData*)layer->layer_data;
+            ConvShape shape;
+            if (data && conv_shape_init(&shape, &data->params, batch, data->input_height, data->input_width,
+                                        CONV_LAYOUT_NCHW)) {
+                size_t scratch = conv_workspace_size(&shape, conv_select_algorithm(&shape));
+                out->forward_scratch = scratch;
+                out->backward_scratch = scratch;
+            }
+            break;
+        }
+        case LAYER_MAXPOOL2D:
+        case LAYER_DROPOUT:
+            // Max indices / dropout mask, one per output element
+            out->saved_floats = out->output_floats;
+            break;
+        case LAYER_LSTM:
+        case LAYER_GRU: {
+            int steps = layer->input_ndim >= 2 ? layer->input_shape[0] : 1;
+            int input_size, hidden_size;
+            if (layer->type == LAYER_LSTM) {
+                const LSTMData* data = (const LSTMData*)layer->layer_data;
+                input_size = data ? data->params.input_size : 0;
+                hidden_size = data ? data->params.hidden_size : 0;
+            } else {
+                const GRUData* data = (const GRUData*)layer->layer_data;
+                input_size = data ? data->params.input_size : 0;
+                hidden_size = data ? data->params.hidden_size : 0;
+            }
+            RnnShape shape = { layer->type == LAYER_LSTM ? RNN_CELL_LSTM : RNN_CELL_GRU,
+                               batch, steps, input_size, hidden_size, 0 };
+            out->saved_floats = rnn_workspace_size(&shape);
+            break;
+        }
+        default:
+            break;
+    }
+    return true;
+}
+
+void neural_network_release_memory_plan(NeuralNetwork* net) {
+    if (!net || !net->memory_plan) return;
+
+    NetworkMemoryPlan* state = (NetworkMemoryPlan*)net->memory_plan;
+    memory_plan_destroy(state->training);
+    memory_plan_destroy(state->inference);
+    free(state->slab_raw);
+    free(state);
+    net->memory_plan = NULL;
+}
+
+bool neural_network_memory_layers(const NeuralNetwork* net, int batch, MemoryPlanLayer* layers) {
+    if (!net || !layers || batch <= 0) return false;
+
+    for (int l = 0; l < net->num_layers; l++) {
+        if (!describe_layer(net->layers[l], batch, &layers[l])) return false;
+    }
+    return true;
+}
+
+bool neural_network_plan_memory(NeuralNetwork* net, int batch) {
+    if (!net || net->num_layers <= 0 || batch <= 0) return false;
+
+    MemoryPlanLayer* layers = (MemoryPlanLayer*)malloc(net->num_layers * sizeof(MemoryPlanLayer));
+    NetworkMemoryPlan* state = (NetworkMemoryPlan*)calloc(1, sizeof(NetworkMemoryPlan));
+    bool ok = layers && state && neural_network_memory_layers(net, batch, layers);
+
+    if (ok) {
+        state->training = memory_plan_layers(layers, net->num_layers, true);
+        state->inference = memory_plan_layers(layers, net->num_layers, false);
+        ok = state->training && state->inference;
+    }
+    free(layers);
+
+    if (ok) {
+        size_t bytes = state->training->peak_bytes > state->inference->peak_bytes
+                           ? state->training->peak_bytes : state->inference->peak_bytes;
+        state->slab_raw = malloc(bytes + MEMORY_PLAN_ALIGNMENT);
+        ok = state->slab_raw != NULL;
+    }
+
+    if (!ok) {
+        if (state) {
+            memory_plan_destroy(state->training);
+            memory_plan_destroy(state->inference);
+            free(state->slab_raw);
+            free(state);
+        }
+        return false;
+    }
+
+    uintptr_t base = (uintptr_t)state->slab_raw;
+    void* slab = (void*)((base + MEMORY_PLAN_ALIGNMENT - 1) & ~(uintptr_t)(MEMORY_PLAN_ALIGNMENT - 1));
+    state->training->slab = slab;
+    state->inference->slab = slab;
+    state->training->batch = batch;
+    state->inference->batch = batch;
+    state->batch = batch;
+
+    neural_network_release_memory_plan(net);
+    net->memory_plan = state;
+    net->memory_usage = (float)(state->training->peak_bytes / (1024.0 * 1024.0));
+    return true;
+}
+
+const MemoryPlan* neural_network_memory_plan(const NeuralNetwork* net, bool training) {
+    if (!net || !net->memory_plan) return NULL;
+    const NetworkMemoryPlan* state = (const NetworkMemoryPlan*)net->memory_plan;
+    return training ? state->training : state->inference;
+}
+
+Tensor* neural_network_planned_tensor(NeuralNetwork* net, MemoryBufferKind kind, int layer, int which,
+                                      bool training, int* shape, int ndim) {
+    const MemoryPlan* plan = neural_network_memory_plan(net, training);
+    if (!plan || !shape) return NULL;
+
+    int index = memory_plan_find(plan, kind, layer, which);
+    if (index < 0 || shape_floats(shape, ndim) * sizeof(float) > plan->buffers[index].bytes) return NULL;
+
+    return tensor_create_view((float*)memory_plan_buffer(plan, index), shape, ndim);
+}
+
+void neural_network_memory_summary(const NeuralNetwork* net, char* out, int max_length) {
+    if (!out || max_length <= 0) return;
+
+    const MemoryPlan* training = neural_network_memory_plan(net, true);
+    const MemoryPlan* inference = neural_network_memory_plan(net, false);
+    if (!training || !inference) {
+        snprintf(out, max_length, "Memory plan: not built\n");
+        return;
+    }
+
+    char train_line[160], infer_line[160];
+    memory_plan_describe(training, train_line, sizeof(train_line));
+    memory_plan_describe(inference, infer_line, sizeof(infer_line));
+    snprintf(out, max_length, "Memory plan (batch %d):\n  Training:  %s\n  Inference: %s\n",
+             training->batch, train_line, infer_line);
+}
@@ -0,0 +1,298 @@
+/*
+ * Neural Network System - Micro-Batcher Implementation
+ * Request queue with a size-or-deadline dispatch policy; each worker gathers
+ * a batch into its own buffers, runs the callback and scatters the results
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L     // clock_gettime, pthread_condattr_setclock
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../headers/micro_batcher.h"
+#include "../headers/thread_pool.h"
+
+// Deadlines are measured on the monotonic clock where condition variables support it
+#if defined(_WIN32) || !defined(CLOCK_MONOTONIC)
+#define MICRO_BATCH_CLOCK CLOCK_REALTIME
+#else
+#define MICRO_BATCH_CLOCK CLOCK_MONOTONIC
+#define MICRO_BATCH_SET_CLOCK 1
+#endif
+
+// ============================================================================
+// Batcher Structures
+// ============================================================================
+
+/**
+ * @brief One pending request, living on the submitting thread's stack
+ */
+typedef struct MicroBatchRequest {
+    const float* input;             // Caller's input row
+    float* output;                  // Caller's output row
+    struct timespec enqueued;       // Time the request was queued
+    bool done;                      // Set by the worker once output is written
+    bool ok;                        // Batch result
+    pthread_cond_t done_cond;       // Signalled when done is set
+    struct MicroBatchRequest* next; // Queue link
+} MicroBatchRequest;
+
+/**
+ * @brief Per-worker state: gather/scatter buffers and the batch being run
+ */
+typedef struct {
+    struct MicroBatcher* batcher;   // Owning batcher
+    int index;                      // Worker index passed to the callback
+    pthread_t thread;               // Worker thread
+    float* inputs;                  // max_batch x input_size gather buffer
+    float* outputs;                 // max_batch x output_size scatter buffer
+    MicroBatchRequest** batch;      // Requests in the current batch
+} MicroBatchWorker;
+
+struct MicroBatcher {
+    MicroBatchConfig config;        // Batching policy (num_workers resolved)
+    int input_size;                 // Floats per input row
+    int output_size;                // Floats per output row
+    MicroBatchFn fn;                // Batched compute callback
+    void* context;                  // Callback context
+
+    MicroBatchWorker* workers;      // Worker states
+    int num_started;                // Workers whose thread is running
+
+    pthread_mutex_t lock;           // Protects the queue and counters
+    pthread_cond_t pending_cond;    // Signalled when a request is queued
+    MicroBatchRequest* head;        // Oldest queued request
+    MicroBatchRequest* tail;        // Newest queued request
+    int pending;                    // Queued requests
+    bool stopping;                  // Set by micro_batcher_destroy
+
+    MicroBatchStats stats;          // Counters
+};
+
+MicroBatchConfig micro_batch_config_default(void) {
+    MicroBatchConfig config;
+    config.max_batch = 32;
+    config.max_delay_us = 200;
+    config.num_workers = 0;
+    return config;
+}
+
+static struct timespec batcher_deadline(const struct timespec* start, int delay_us) {
+    struct timespec deadline = *start;
+    long nsec = deadline.tv_nsec + (long)delay_us * 1000L;
+    deadline.tv_sec += nsec / 1000000000L;
+    deadline.tv_nsec = nsec % 1000000000L;
+    return deadline;
+}
+
+static bool batcher_before(const struct timespec* a, const struct timespec* b) {
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+// ============================================================================
+// Worker Loop
+// ============================================================================
+
+static void batcher_run(MicroBatcher* batcher, MicroBatchWorker* worker, int count) {
+    size_t in_bytes = (size_t)batcher->input_size * sizeof(float);
+    size_t out_bytes = (size_t)batcher->output_size * sizeof(float);
+
+    for (int i = 0; i < count; i++) {
+        memcpy(worker->inputs + (size_t)i * batcher->input_size, worker->batch[i]->input, in_bytes);
+    }
+
+    bool ok = batcher->fn(batcher->context, worker->index, worker->inputs, count, worker->outputs);
+
+    if (ok) {
+        for (int i = 0; i < count; i++) {
+            memcpy(worker->batch[i]->output, worker->outputs + (size_t)i * batcher->output_size, out_bytes);
+        }
+    }
+
+    pthread_mutex_lock(&batcher->lock);
+    for (int i = 0; i < count; i++) {
+        worker->batch[i]->ok = ok;
+        worker->batch[i]->done = true;
+        pthread_cond_signal(&worker->batch[i]->done_cond);
+    }
+}
+
+static void* batcher_worker(void* arg) {
+    MicroBatchWorker* worker = (MicroBatchWorker*)arg;
+    MicroBatcher* batcher = worker->batcher;
+    int max_batch = batcher->config.max_batch;
+
+    pthread_mutex_lock(&batcher->lock);
+    for (;;) {
+        while (!batcher->stopping && !batcher->head) {
+            pthread_cond_wait(&batcher->pending_cond, &batcher->lock);
+        }
+        if (!batcher->head) break;
+
+        // Hold a partial batch until the oldest request's deadline; shutdown flushes at once
+        if (batcher->pending < max_batch && !batcher->stopping && batcher->config.max_delay_us > 0) {
+            struct timespec now;
+            struct timespec deadline = batcher_deadline(&batcher->head->enqueued,
+                                                        batcher->config.max_delay_us);
+            clock_gettime(MICRO_BATCH_CLOCK, &now);
+            if (batcher_before(&now, &deadline)) {
+                pthread_cond_timedwait(&batcher->pending_cond, &batcher->lock, &deadline);
+                continue;
+            }
+        }
+
+        int count = 0;
+        while (batcher->head && count < max_batch) {
+            worker->batch[count++] = batcher->head;
+            batcher->head = batcher->head->next;
+        }
+        if (!batcher->head) batcher->tail = NULL;
+        batcher->pending -= count;
+
+        batcher->stats.batches++;
+        if (count > batcher->stats.largest_batch) batcher->stats.largest_batch = count;
+
+        // Leftover requests can start forming the next batch on another worker
+        if (batcher->head) pthread_cond_signal(&batcher->pending_cond);
+        pthread_mutex_unlock(&batcher->lock);
+
+        // Returns with the lock held
+        batcher_run(batcher, worker, count);
+    }
+    pthread_mutex_unlock(&batcher->lock);
+    return NULL;
+}
+
+// ============================================================================
+// Batcher Management
+// ============================================================================
+
+MicroBatcher* micro_batcher_create(int input_size, int output_size, MicroBatchConfig config,
+                                   MicroBatchFn fn, void* context) {
+    if (input_size <= 0 || output_size <= 0 || !fn) return NULL;
+    if (config.max_batch <= 0) config.max_batch = 1;
+    if (config.max_delay_us < 0) config.max_delay_us = 0;
+    if (config.num_workers <= 0) config.num_workers = thread_pool_hardware_threads();
+
+    MicroBatcher* batcher = (MicroBatcher*)calloc(1, sizeof(MicroBatcher));
+    if (!batcher) return NULL;
+
+    batcher->config = config;
+    batcher->input_size = input_size;
+    batcher->output_size = output_size;
+    batcher->fn = fn;
+    batcher->context = context;
+
+    pthread_mutex_init(&batcher->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+#ifdef MICRO_BATCH_SET_CLOCK
+    pthread_condattr_setclock(&attr, MICRO_BATCH_CLOCK);
+#endif
+    pthread_cond_init(&batcher->pending_cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    batcher->workers = (MicroBatchWorker*)calloc(config.num_workers, sizeof(MicroBatchWorker));
+    if (!batcher->workers) {
+        micro_batcher_destroy(batcher);
+        return NULL;
+    }
+
+    for (int w = 0; w < config.num_workers; w++) {
+        MicroBatchWorker* worker = &batcher->workers[w];
+        worker->batcher = batcher;
+        worker->index = w;
+        worker->inputs = (float*)malloc((size_t)config.max_batch * input_size * sizeof(float));
+        worker->outputs = (float*)malloc((size_t)config.max_batch * output_size * sizeof(float));
+        worker->batch = (MicroBatchRequest**)malloc(config.max_batch * sizeof(MicroBatchRequest*));
+
+        if (!worker->inputs || !worker->outputs || !worker->batch ||
+            pthread_create(&worker->thread, NULL, batcher_worker, worker) != 0) {
+            micro_batcher_destroy(batcher);
+            return NULL;
+        }
+        batcher->num_started++;
+    }
+
+    return batcher;
+}
+
+void micro_batcher_destroy(MicroBatcher* batcher) {
+    if (!batcher) return;
+
+    pthread_mutex_lock(&batcher->lock);
+    batcher->stopping = true;
+    pthread_cond_broadcast(&batcher->pending_cond);
+    pthread_mutex_unlock(&batcher->lock);
+
+    for (int w = 0; w < batcher->num_started; w++) {
+        pthread_join(batcher->workers[w].thread, NULL);
+    }
+
+    if (batcher->workers) {
+        for (int w = 0; w < batcher->config.num_workers; w++) {
+            free(batcher->workers[w].inputs);
+            free(batcher->workers[w].outputs);
+            free(batcher->workers[w].batch);
+        }
+        free(batcher->workers);
+    }
+
+    pthread_cond_destroy(&batcher->pending_cond);
+    pthread_mutex_destroy(&batcher->lock);
+    free(batcher);
+}
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+bool micro_batcher_submit(MicroBatcher* batcher, const float* input, float* output) {
+    if (!batcher || !input || !output) return false;
+
+    MicroBatchRequest request;
+    request.input = input;
+    request.output = output;
+    request.done = false;
+    request.ok = false;
+    request.next = NULL;
+    clock_gettime(MICRO_BATCH_CLOCK, &request.enqueued);
+    pthread_cond_init(&request.done_cond, NULL);
+
+    pthread_mutex_lock(&batcher->lock);
+    if (batcher->stopping || batcher->num_started == 0) {
+        pthread_mutex_unlock(&batcher->lock);
+        pthread_cond_destroy(&request.done_cond);
+        return false;
+    }
+
+    if (batcher->tail) batcher->tail->next = &request; else batcher->head = &request;
+    batcher->tail = &request;
+    batcher->pending++;
+    batcher->stats.requests++;
+    pthread_cond_signal(&batcher->pending_cond);
+
+    while (!request.done) {
+        pthread_cond_wait(&request.done_cond, &batcher->lock);
+    }
+    pthread_mutex_unlock(&batcher->lock);
+
+    pthread_cond_destroy(&request.done_cond);
+    return request.ok;
+}
+
+int micro_batcher_workers(const MicroBatcher* batcher) {
+    return batcher ? batcher->num_started : 0;
+}
+
+void micro_batcher_get_stats(MicroBatcher* batcher, MicroBatchStats* stats) {
+    if (!batcher || !stats) return;
+
+    pthread_mutex_lock(&batcher->lock);
+    *stats = batcher->stats;
+    pthread_mutex_unlock(&batcher->lock);
+}
@@ -0,0 +1,460 @@
+/*
+ * Neural Network System - Mixed Precision Implementation
+ * bf16 dense forward/backward over packed weights, the shared fp32 output
+ * scratch and dynamic loss scaling
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/mixed_precision.h"
+#include "../headers/dense_kernels.h"
+#include "../headers/layers.h"
+#include "../headers/tensor_arena.h"
+
+LossScaler loss_scaler_default(void) {
+    LossScaler scaler;
+    scaler.scale = 65536.0f;
+    scaler.growth_factor = 2.0f;
+    scaler.backoff_factor = 0.5f;
+    scaler.growth_interval = 1000;
+    scaler.min_scale = 1.0f;
+    scaler.max_scale = 16777216.0f;
+    scaler.good_steps = 0;
+    scaler.skipped_steps = 0;
+    return scaler;
+}
+
+// ============================================================================
+// Buffers
+// ============================================================================
+
+static bool reserve_bf16(bf16** buffer, size_t* capacity, size_t count) {
+    if (*capacity >= count) return true;
+    bf16* grown = (bf16*)realloc(*buffer, count * sizeof(bf16));
+    if (!grown) return false;
+    *buffer = grown;
+    *capacity = count;
+    return true;
+}
+
+static bool reserve_floats(float** buffer, size_t* capacity, size_t count) {
+    if (*capacity >= count) return true;
+    float* grown = (float*)realloc(*buffer, count * sizeof(float));
+    if (!grown) return false;
+    *buffer = grown;
+    *capacity = count;
+    return true;
+}
+
+static bool tensor_has_shape(const Tensor* tensor, const int* shape, int ndim) {
+    if (!tensor || tensor->ndim != ndim) return false;
+    for (int d = 0; d < ndim; d++) {
+        if (tensor->shape[d] != shape[d]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Keep `*tensor` a heap tensor (or a view of `data`) of the given shape
+ *
+ * Layer state outlives the arena a training step may run in, so the
+ * tensors are always created with no arena active.
+ */
+static Tensor* ensure_tensor(Tensor** tensor, float* data, const int* shape, int ndim) {
+    if (tensor_has_shape(*tensor, shape, ndim) && (!data || (*tensor)->data == data)) {
+        return *tensor;
+    }
+
+    TensorArena* previous = tensor_arena_activate(NULL);
+    tensor_destroy(*tensor);
+    *tensor = data ? tensor_create_view(data, (int*)shape, ndim)
+                   : tensor_create(NULL, (int*)shape, ndim);
+    tensor_arena_activate(previous);
+    return *tensor;
+}
+
+// ============================================================================
+// bf16 Dense Layer
+// ============================================================================
+
+static Tensor* mixed_dense_forward(Layer* layer, Tensor* input) {
+    MixedPrecisionLayer* state = (MixedPrecisionLayer*)layer->mixed_precision_data;
+    DenseData* data = (DenseData*)layer->layer_data;
+    if (!state || !data || !input) return NULL;
+
+    MixedPrecisionState* net_state = (MixedPrecisionState*)state->network;
+    int in_features = data->params.input_size;
+    int out_features = data->params.output_size;
+    if (input->size % in_features != 0) return NULL;
+
+    int rows = input->size / in_features;
+    size_t out_count = (size_t)rows * out_features;
+    if (!reserve_bf16(&state->output, &state->output_capacity, out_count)) return NULL;
+
+    // A converted previous layer already rounded this activation
+    const MixedPrecisionLayer* previous = state->previous;
+    if (previous && previous->output_tensor == input && previous->rows == rows) {
+        state->saved_input = previous->output;
+    } else {
+        if (!reserve_bf16(&state->input, &state->input_capacity, (size_t)input->size)) return NULL;
+        bf16_from_float_array(input->data, state->input, (size_t)input->size);
+        state->saved_input = state->input;
+    }
+
+    float* scratch = NULL;
+    if (state->scratch_output) {
+        int slot = state->slot;
+        if (!reserve_floats(&net_state->scratch[slot], &net_state->scratch_capacity[slot], out_count)) {
+            return NULL;
+        }
+        scratch = net_state->scratch[slot];
+    }
+
+    int shape[2] = { rows, out_features };
+    Tensor* output = input->ndim == 1 ? ensure_tensor(&state->output_tensor, scratch, &out_features, 1)
+                                      : ensure_tensor(&state->output_tensor, scratch, shape, 2);
+    if (!output) return NULL;
+
+    GemmEpilogue epilogue = { data->biases ? data->biases->data : NULL, state->activation, NULL };
+    Bf16Operand a = { state->saved_input, NULL, in_features, GEMM_NO_TRANS };
+    if (!bf16_gemm_packed(rows, &a, &state->forward_weights, 0.0f, output->data, out_features, &epilogue)) {
+        return NULL;
+    }
+    bf16_from_float_array(output->data, state->output, out_count);
+
+    state->rows = rows;
+    state->input_ndim = input->ndim;
+    layer->input_cache = input;
+    layer->output_cache = output;
+    return output;
+}
+
+static Tensor* mixed_dense_backward(Layer* layer, Tensor* grad_output) {
+    MixedPrecisionLayer* state = (MixedPrecisionLayer*)layer->mixed_precision_data;
+    DenseData* data = (DenseData*)layer->layer_data;
+    if (!state || !data || !grad_output || !state->saved_input) return NULL;
+
+    MixedPrecisionState* net_state = (MixedPrecisionState*)state->network;
+    int in_features = data->params.input_size;
+    int out_features = data->params.output_size;
+    int rows = state->rows;
+    size_t out_count = (size_t)rows * out_features;
+    if ((size_t)grad_output->size != out_count || !data->weight_gradients) return NULL;
+
+    // delta = grad * act'(y) from the rounded output; bias gradient accumulates here
+    if (!reserve_floats(&net_state->widened, &net_state->widened_capacity, out_count)) return NULL;
+    bf16_to_float_array(state->output, net_state->widened, out_count);
+    dense_activation_delta(state->activation, net_state->widened, grad_output->data,
+                           data->bias_gradients ? data->bias_gradients->data : NULL,
+                           rows, out_features);
+
+    // dW += delta^T * X  (out x batch) * (batch x in)
+    Bf16Operand delta_t = { NULL, grad_output->data, out_features, GEMM_TRANS };
+    Bf16Operand x = { state->saved_input, NULL, in_features, GEMM_NO_TRANS };
+    if (!bf16_gemm(out_features, in_features, rows, &delta_t, &x, 1.0f,
+                   data->weight_gradients->data, in_features, NULL)) {
+        return NULL;
+    }
+
+    // dX = delta * W  (batch x out) * (out x in)
+    int shape[2] = { rows, in_features };
+    Tensor* grad_input = state->input_ndim == 1 ? ensure_tensor(&state->grad_input, NULL, &in_features, 1)
+                                                : ensure_tensor(&state->grad_input, NULL, shape, 2);
+    if (!grad_input) return NULL;
+
+    Bf16Operand delta = { NULL, grad_output->data, out_features, GEMM_NO_TRANS };
+    if (!bf16_gemm_packed(rows, &delta, &state->backward_weights, 0.0f, grad_input->data,
+                          in_features, NULL)) {
+        return NULL;
+    }
+    return grad_input;
+}
+
+static void pack_weights(MixedPrecisionLayer* state, const DenseData* data, bool allocate) {
+    int in_features = data->params.input_size;
+    int out_features = data->params.output_size;
+    Bf16Operand w_t = { NULL, data->weights->data, in_features, GEMM_TRANS };
+    Bf16Operand w = { NULL, data->weights->data, in_features, GEMM_NO_TRANS };
+
+    if (allocate) {
+        bf16_pack_b(&state->forward_weights, &w_t, in_features, out_features);
+        bf16_pack_b(&state->backward_weights, &w, out_features, in_features);
+    } else {
+        bf16_repack_b(&state->forward_weights, &w_t);
+        bf16_repack_b(&state->backward_weights, &w);
+    }
+}
+
+static void release_layer(Layer* layer) {
+    MixedPrecisionLayer* state = (MixedPrecisionLayer*)layer->mixed_precision_data;
+    if (!state) return;
+
+    layer->forward = state->float_forward;
+    layer->backward = state->float_backward;
+    layer->input_cache = NULL;
+    layer->output_cache = NULL;
+
+    if (!state->shared_weights) {
+        bf16_packed_free(&state->forward_weights);
+        bf16_packed_free(&state->backward_weights);
+    }
+    free(state->input);
+    free(state->output);
+    tensor_destroy(state->output_tensor);
+    tensor_destroy(state->grad_input);
+    free(state);
+    layer->mixed_precision_data = NULL;
+}
+
+/**
+ * @brief Convert one dense layer
+ * @param source Same layer of the network to share packed weights with (NULL = pack own)
+ * @return Layer state, or NULL if the layer stays fp32
+ */
+static MixedPrecisionLayer* convert_layer(Layer* layer, const Layer* source,
+                                          MixedPrecisionState* net_state, bool* failed) {
+    if (!layer || layer->type != LAYER_DENSE || !layer->layer_data || layer->mixed_precision_data) {
+        return NULL;
+    }
+
+    DenseData* data = (DenseData*)layer->layer_data;
+    GemmActivation kind;
+    if (data->params.dropout_rate > 0.0f || !dense_activation_kind(data->params.activation, &kind)) {
+        return NULL;
+    }
+
+    Tensor* w = data->weights;
+    if (!w || w->ndim != 2 || w->shape[0] != data->params.output_size ||
+        w->shape[1] != data->params.input_size) {
+        return NULL;
+    }
+
+    const MixedPrecisionLayer* shared = source ? (const MixedPrecisionLayer*)source->mixed_precision_data : NULL;
+    if (source && !shared) {
+        *failed = true;
+        return NULL;
+    }
+
+    MixedPrecisionLayer* state = (MixedPrecisionLayer*)calloc(1, sizeof(MixedPrecisionLayer));
+    if (!state) {
+        *failed = true;
+        return NULL;
+    }
+
+    if (shared) {
+        state->forward_weights = shared->forward_weights;
+        state->backward_weights = shared->backward_weights;
+        state->shared_weights = true;
+    } else {
+        pack_weights(state, data, true);
+    }
+    if (!state->forward_weights.data || !state->backward_weights.data) {
+        if (!shared) {
+            bf16_packed_free(&state->forward_weights);
+            bf16_packed_free(&state->backward_weights);
+        }
+        free(state);
+        *failed = true;
+        return NULL;
+    }
+
+    state->activation = kind;
+    state->network = net_state;
+    state->float_forward = layer->forward;
+    state->float_backward = layer->backward;
+    layer->mixed_precision_data = state;
+    layer->forward = mixed_dense_forward;
+    layer->backward = mixed_dense_backward;
+    return state;
+}
+
+// ============================================================================
+// Network Functions
+// ============================================================================
+
+void neural_network_disable_mixed_precision(NeuralNetwork* net) {
+    if (!net || !net->mixed_precision) return;
+
+    MixedPrecisionState* state = (MixedPrecisionState*)net->mixed_precision;
+    for (int l = 0; l < net->num_layers; l++) {
+        if (net->layers[l]) release_layer(net->layers[l]);
+    }
+
+    free(state->scratch[0]);
+    free(state->scratch[1]);
+    free(state->widened);
+    free(state);
+    net->mixed_precision = NULL;
+}
+
+/**
+ * @brief Convert the network's eligible layers, packing weights or sharing source's
+ */
+static bool enable_mixed_precision(NeuralNetwork* net, const NeuralNetwork* source, LossScaler scaler) {
+    if (!net) return false;
+    if (net->checkpoint) {
+        fprintf(stderr, "Mixed precision: not supported together with checkpointing\n");
+        return false;
+    }
+    if (source && (!source->mixed_precision || source->num_layers != net->num_layers)) return false;
+
+    if (net->mixed_precision) {
+        ((MixedPrecisionState*)net->mixed_precision)->scaler = scaler;
+        return true;
+    }
+
+    MixedPrecisionState* state = (MixedPrecisionState*)calloc(1, sizeof(MixedPrecisionState));
+    if (!state) return false;
+    state->scaler = scaler;
+    state->num_layers = net->num_layers;
+    net->mixed_precision = state;
+
+    bool failed = false;
+    MixedPrecisionLayer* previous = NULL;
+    for (int l = 0; l < net->num_layers && !failed; l++) {
+        MixedPrecisionLayer* layer = convert_layer(net->layers[l], source ? source->layers[l] : NULL,
+                                                   state, &failed);
+        if (layer) {
+            state->converted_layers++;
+
+            // Only a converted layer reads the previous output straight into bf16,
+            // so only then may that fp32 output share a scratch slot
+            if (previous) {
+                layer->previous = previous;
+                previous->scratch_output = true;
+            }
+            layer->slot = l % 2;
+        }
+        previous = layer;
+    }
+
+    if (failed) {
+        neural_network_disable_mixed_precision(net);
+        return false;
+    }
+    return true;
+}
+
+bool neural_network_enable_mixed_precision(NeuralNetwork* net, LossScaler scaler) {
+    return enable_mixed_precision(net, NULL, scaler);
+}
+
+bool neural_network_share_mixed_precision(NeuralNetwork* replica, const NeuralNetwork* master) {
+    if (!replica || !master || !master->mixed_precision || replica->mixed_precision) return false;
+    return enable_mixed_precision(replica, master,
+                                  ((const MixedPrecisionState*)master->mixed_precision)->scaler);
+}
+
+void neural_network_refresh_mixed_precision(NeuralNetwork* net) {
+    if (!net || !net->mixed_precision) return;
+
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        MixedPrecisionLayer* state = layer ? (MixedPrecisionLayer*)layer->mixed_precision_data : NULL;
+        if (state && !state->shared_weights) {
+            pack_weights(state, (const DenseData*)layer->layer_data, false);
+        }
+    }
+}
+
+float neural_network_loss_scale(const NeuralNetwork* net) {
+    if (!net || !net->mixed_precision) return 1.0f;
+    return ((const MixedPrecisionState*)net->mixed_precision)->scaler.scale;
+}
+
+static bool gradients_finite(const Tensor* grad) {
+    if (!grad) return true;
+    for (int i = 0; i < grad->size; i++) {
+        if (!isfinite(grad->data[i])) return false;
+    }
+    return true;
+}
+
+static void scale_gradients(Tensor* grad, float factor) {
+    if (!grad) return;
+    if (factor == 0.0f) {
+        memset(grad->data, 0, (size_t)grad->size * sizeof(float));
+        return;
+    }
+    for (int i = 0; i < grad->size; i++) grad->data[i] *= factor;
+}
+
+/**
+ * @brief Apply `factor` to every parameter gradient (0 clears them)
+ */
+static void scale_network_gradients(NeuralNetwork* net, float factor) {
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (!layer->trainable) continue;
+        for (int i = 0; i < layer->num_weights && layer->weight_gradients; i++) {
+            scale_gradients(layer->weight_gradients[i], factor);
+        }
+        for (int i = 0; i < layer->num_biases && layer->bias_gradients; i++) {
+            scale_gradients(layer->bias_gradients[i], factor);
+        }
+    }
+}
+
+bool neural_network_unscale_gradients(NeuralNetwork* net) {
+    if (!net) return false;
+    if (!net->mixed_precision) return true;
+
+    LossScaler* scaler = &((MixedPrecisionState*)net->mixed_precision)->scaler;
+
+    bool finite = true;
+    for (int l = 0; l < net->num_layers && finite; l++) {
+        Layer* layer = net->layers[l];
+        if (!layer->trainable) continue;
+        for (int i = 0; i < layer->num_weights && layer->weight_gradients && finite; i++) {
+            finite = gradients_finite(layer->weight_gradients[i]);
+        }
+        for (int i = 0; i < layer->num_biases && layer->bias_gradients && finite; i++) {
+            finite = gradients_finite(layer->bias_gradients[i]);
+        }
+    }
+
+    if (!finite) {
+        scale_network_gradients(net, 0.0f);
+        scaler->scale *= scaler->backoff_factor;
+        if (scaler->scale < scaler->min_scale) scaler->scale = scaler->min_scale;
+        scaler->good_steps = 0;
+        scaler->skipped_steps++;
+        return false;
+    }
+
+    scale_network_gradients(net, 1.0f / scaler->scale);
+    if (++scaler->good_steps >= scaler->growth_interval) {
+        scaler->scale *= scaler->growth_factor;
+        if (scaler->scale > scaler->max_scale) scaler->scale = scaler->max_scale;
+        scaler->good_steps = 0;
+    }
+    return true;
+}
+
+size_t neural_network_saved_activation_bytes(const NeuralNetwork* net) {
+    if (!net) return 0;
+
+    size_t bytes = 0;
+    for (int l = 0; l < net->num_layers; l++) {
+        const Layer* layer = net->layers[l];
+        const MixedPrecisionLayer* state = (const MixedPrecisionLayer*)layer->mixed_precision_data;
+
+        if (state) {
+            const DenseData* data = (const DenseData*)layer->layer_data;
+            bytes += (size_t)state->rows * data->params.output_size * sizeof(bf16);
+            if (state->saved_input == state->input) {
+                bytes += (size_t)state->rows * data->params.input_size * sizeof(bf16);
+            }
+            // An fp32 consumer (or the loss) holds on to the unshared output
+            if (!state->scratch_output && state->output_tensor) {
+                bytes += (size_t)state->output_tensor->size * sizeof(float);
+            }
+        } else {
+            if (layer->output_cache) bytes += (size_t)layer->output_cache->size * sizeof(float);
+            if (l == 0 && layer->input_cache) bytes += (size_t)layer->input_cache->size * sizeof(float);
+        }
+    }
+    return bytes;
+}
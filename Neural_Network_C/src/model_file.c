@@ -0,0 +1,418 @@
+/*
+ * Neural Network System - Binary Model File Implementation
+ * Writer for the aligned model format and a validating reader that maps the
+ * file read-only (or copies it when mapping is unavailable)
+ */
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE             // MAP_POPULATE, fileno and fsync alongside strict C99
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/model_file.h"
+
+#ifndef _WIN32
+#define MODEL_FILE_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Layout checks: the on-disk records must not depend on compiler padding
+typedef char model_file_header_is_256_bytes[sizeof(ModelFileHeader) == 256 ? 1 : -1];
+typedef char model_layer_record_is_128_bytes[sizeof(ModelLayerRecord) == 128 ? 1 : -1];
+typedef char model_tensor_record_is_64_bytes[sizeof(ModelTensorRecord) == 64 ? 1 : -1];
+
+#define MODEL_FNV_OFFSET 2166136261u
+#define MODEL_FNV_PRIME 16777619u
+
+static uint64_t model_align(uint64_t value) {
+    return (value + MODEL_FILE_ALIGNMENT - 1) & ~(uint64_t)(MODEL_FILE_ALIGNMENT - 1);
+}
+
+/**
+ * @brief FNV-1a over 32-bit words (all hashed sections are multiples of 4 bytes)
+ */
+static uint32_t model_checksum(uint32_t hash, const void* data, size_t bytes) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i + 4 <= bytes; i += 4) {
+        uint32_t word;
+        memcpy(&word, p + i, 4);
+        hash = (hash ^ word) * MODEL_FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t model_table_checksum(const ModelLayerRecord* layers, uint32_t num_layers,
+                                     const ModelTensorRecord* tensors, uint32_t num_tensors) {
+    uint32_t hash = model_checksum(MODEL_FNV_OFFSET, layers, (size_t)num_layers * sizeof(ModelLayerRecord));
+    return model_checksum(hash, tensors, (size_t)num_tensors * sizeof(ModelTensorRecord));
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+void model_writer_init(ModelWriter* writer, const char* name,
+                       const int* input_shape, int input_ndim) {
+    memset(writer, 0, sizeof(ModelWriter));
+    memcpy(writer->header.magic, MODEL_FILE_MAGIC, sizeof(MODEL_FILE_MAGIC));
+    writer->header.version = MODEL_FILE_VERSION;
+    writer->header.byte_order = MODEL_FILE_BYTE_ORDER;
+    writer->header.header_size = sizeof(ModelFileHeader);
+
+    if (name) {
+        strncpy(writer->header.name, name, sizeof(writer->header.name) - 1);
+    }
+    if (input_shape && input_ndim > 0 && input_ndim <= MODEL_FILE_MAX_DIMS) {
+        writer->header.input_ndim = input_ndim;
+        for (int i = 0; i < input_ndim; i++) writer->header.input_shape[i] = input_shape[i];
+    }
+}
+
+bool model_writer_add_layer(ModelWriter* writer, const ModelLayerRecord* record) {
+    if (!writer || !record) return false;
+
+    if (writer->header.num_layers == writer->layer_capacity) {
+        uint32_t capacity = writer->layer_capacity ? writer->layer_capacity * 2 : 16;
+        ModelLayerRecord* layers = (ModelLayerRecord*)realloc(writer->layers,
+                                                              capacity * sizeof(ModelLayerRecord));
+        if (!layers) return false;
+        writer->layers = layers;
+        writer->layer_capacity = capacity;
+    }
+
+    ModelLayerRecord* entry = &writer->layers[writer->header.num_layers++];
+    *entry = *record;
+    entry->first_tensor = writer->header.num_tensors;
+    return true;
+}
+
+bool model_writer_add_tensor(ModelWriter* writer, const float* data,
+                             const int* shape, int ndim) {
+    if (!writer || !data || !shape || ndim <= 0 || ndim > MODEL_FILE_MAX_DIMS ||
+        writer->header.num_layers == 0) {
+        return false;
+    }
+
+    if (writer->header.num_tensors == writer->tensor_capacity) {
+        uint32_t capacity = writer->tensor_capacity ? writer->tensor_capacity * 2 : 32;
+        ModelTensorRecord* tensors = (ModelTensorRecord*)realloc(writer->tensors,
+                                                                 capacity * sizeof(ModelTensorRecord));
+        if (!tensors) return false;
+        writer->tensors = tensors;
+
+        const float** sources = (const float**)realloc((void*)writer->sources,
+                                                       capacity * sizeof(const float*));
+        if (!sources) return false;
+        writer->sources = sources;
+        writer->tensor_capacity = capacity;
+    }
+
+    ModelTensorRecord* entry = &writer->tensors[writer->header.num_tensors];
+    memset(entry, 0, sizeof(ModelTensorRecord));
+    entry->ndim = (uint32_t)ndim;
+    entry->size = 1;
+    for (int i = 0; i < ndim; i++) {
+        if (shape[i] <= 0) return false;
+        entry->shape[i] = shape[i];
+        entry->size *= (uint64_t)shape[i];
+    }
+
+    writer->sources[writer->header.num_tensors++] = data;
+    return true;
+}
+
+static bool model_write_padding(FILE* file, uint64_t from, uint64_t to) {
+    static const unsigned char zeros[MODEL_FILE_ALIGNMENT] = { 0 };
+    size_t count = (size_t)(to - from);
+    return count == 0 || fwrite(zeros, 1, count, file) == count;
+}
+
+bool model_writer_write(ModelWriter* writer, const char* filename) {
+    if (!writer || !filename) return false;
+
+    ModelFileHeader* header = &writer->header;
+
+    // Every layer must own exactly the tensors that were added after it
+    for (uint32_t l = 0; l < header->num_layers; l++) {
+        uint32_t end = (l + 1 < header->num_layers) ? writer->layers[l + 1].first_tensor
+                                                     : header->num_tensors;
+        if (writer->layers[l].first_tensor + writer->layers[l].num_weights +
+            writer->layers[l].num_biases != end) {
+            fprintf(stderr, "Model file: layer %u declares a different tensor count than was added\n", l);
+            return false;
+        }
+    }
+
+    // Section layout
+    header->layer_table_offset = model_align(sizeof(ModelFileHeader));
+    header->tensor_table_offset = model_align(header->layer_table_offset +
+                                              (uint64_t)header->num_layers * sizeof(ModelLayerRecord));
+    header->blob_offset = model_align(header->tensor_table_offset +
+                                      (uint64_t)header->num_tensors * sizeof(ModelTensorRecord));
+
+    uint64_t cursor = 0;
+    for (uint32_t t = 0; t < header->num_tensors; t++) {
+        ModelTensorRecord* entry = &writer->tensors[t];
+        entry->offset = cursor;
+        entry->checksum = model_checksum(MODEL_FNV_OFFSET, writer->sources[t],
+                                         (size_t)entry->size * sizeof(float));
+        cursor = model_align(cursor + entry->size * sizeof(float));
+    }
+    header->blob_size = cursor;
+    header->file_size = header->blob_offset + header->blob_size;
+    header->table_checksum = model_table_checksum(writer->layers, header->num_layers,
+                                                  writer->tensors, header->num_tensors);
+
+    // Write beside the target and rename, so mapped readers of the old file are unaffected
+    size_t path_length = strlen(filename) + 5;
+    char* temp_path = (char*)malloc(path_length);
+    if (!temp_path) return false;
+    snprintf(temp_path, path_length, "%s.tmp", filename);
+
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) {
+        fprintf(stderr, "Model file: cannot create %s\n", temp_path);
+        free(temp_path);
+        return false;
+    }
+
+    uint64_t position = sizeof(ModelFileHeader);
+    bool ok = fwrite(header, sizeof(ModelFileHeader), 1, file) == 1;
+
+    ok = ok && model_write_padding(file, position, header->layer_table_offset);
+    position = header->layer_table_offset + (uint64_t)header->num_layers * sizeof(ModelLayerRecord);
+    ok = ok && (header->num_layers == 0 ||
+                fwrite(writer->layers, sizeof(ModelLayerRecord), header->num_layers, file) == header->num_layers);
+
+    ok = ok && model_write_padding(file, position, header->tensor_table_offset);
+    position = header->tensor_table_offset + (uint64_t)header->num_tensors * sizeof(ModelTensorRecord);
+    ok = ok && (header->num_tensors == 0 ||
+                fwrite(writer->tensors, sizeof(ModelTensorRecord), header->num_tensors, file) == header->num_tensors);
+
+    ok = ok && model_write_padding(file, position, header->blob_offset);
+    for (uint32_t t = 0; t < header->num_tensors && ok; t++) {
+        const ModelTensorRecord* entry = &writer->tensors[t];
+        size_t count = (size_t)entry->size;
+        uint64_t start = header->blob_offset + entry->offset;
+        uint64_t end = start + entry->size * sizeof(float);
+
+        ok = fwrite(writer->sources[t], sizeof(float), count, file) == count;
+        uint64_t next = (t + 1 < header->num_tensors)
+                            ? header->blob_offset + writer->tensors[t + 1].offset
+                            : header->file_size;
+        ok = ok && model_write_padding(file, end, next);
+    }
+
+    ok = (fflush(file) == 0) && ok;
+#ifdef MODEL_FILE_HAVE_MMAP
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = (fclose(file) == 0) && ok;
+
+#ifdef _WIN32
+    if (ok) remove(filename);
+#endif
+    ok = ok && rename(temp_path, filename) == 0;
+
+    if (!ok) {
+        fprintf(stderr, "Model file: failed to write %s\n", filename);
+        remove(temp_path);
+    }
+    free(temp_path);
+    return ok;
+}
+
+void model_writer_free(ModelWriter* writer) {
+    if (!writer) return;
+    free(writer->layers);
+    free(writer->tensors);
+    free((void*)writer->sources);
+    memset(writer, 0, sizeof(ModelWriter));
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+/**
+ * @brief Check the header and tables of a file image without reading the blob
+ */
+static bool model_file_validate(ModelFile* file, const char* filename) {
+    const unsigned char* base = (const unsigned char*)file->base;
+    const ModelFileHeader* header = (const ModelFileHeader*)base;
+    const char* problem = NULL;
+
+    if (file->length < sizeof(ModelFileHeader) ||
+        memcmp(header->magic, MODEL_FILE_MAGIC, sizeof(MODEL_FILE_MAGIC)) != 0) {
+        problem = "not a model file";
+    } else if (header->byte_order != MODEL_FILE_BYTE_ORDER) {
+        problem = "written on a host with different byte order";
+    } else if (header->version != MODEL_FILE_VERSION) {
+        problem = "unsupported format version";
+    } else if (header->header_size != sizeof(ModelFileHeader) ||
+               header->file_size != file->length) {
+        problem = "truncated or resized";
+    } else if (header->layer_table_offset % MODEL_FILE_ALIGNMENT ||
+               header->tensor_table_offset % MODEL_FILE_ALIGNMENT ||
+               header->blob_offset % MODEL_FILE_ALIGNMENT ||
+               header->layer_table_offset < sizeof(ModelFileHeader) ||
+               header->layer_table_offset + (uint64_t)header->num_layers * sizeof(ModelLayerRecord) >
+                   header->tensor_table_offset ||
+               header->tensor_table_offset + (uint64_t)header->num_tensors * sizeof(ModelTensorRecord) >
+                   header->blob_offset ||
+               header->blob_offset + header->blob_size != header->file_size) {
+        problem = "corrupt section table";
+    }
+
+    if (!problem) {
+        file->header = header;
+        file->layers = (const ModelLayerRecord*)(base + header->layer_table_offset);
+        file->tensors = (const ModelTensorRecord*)(base + header->tensor_table_offset);
+        file->blob = base + header->blob_offset;
+
+        if (model_table_checksum(file->layers, header->num_layers,
+                                 file->tensors, header->num_tensors) != header->table_checksum) {
+            problem = "layer or tensor table checksum mismatch";
+        }
+    }
+
+    for (uint32_t l = 0; !problem && l < header->num_layers; l++) {
+        const ModelLayerRecord* layer = &file->layers[l];
+        if ((uint64_t)layer->first_tensor + layer->num_weights + layer->num_biases > header->num_tensors) {
+            problem = "layer refers past the tensor table";
+        }
+    }
+
+    for (uint32_t t = 0; !problem && t < header->num_tensors; t++) {
+        const ModelTensorRecord* tensor = &file->tensors[t];
+        if (tensor->offset % MODEL_FILE_ALIGNMENT || tensor->ndim == 0 ||
+            tensor->ndim > MODEL_FILE_MAX_DIMS || tensor->size > header->blob_size / sizeof(float) ||
+            tensor->offset > header->blob_size - tensor->size * sizeof(float)) {
+            problem = "tensor lies outside the weight blob";
+        }
+    }
+
+    if (problem) {
+        fprintf(stderr, "Model file %s: %s\n", filename, problem);
+        return false;
+    }
+    return true;
+}
+
+static bool model_file_read(ModelFile* file, const char* filename) {
+    FILE* stream = fopen(filename, "rb");
+    if (!stream) return false;
+
+    bool ok = fseek(stream, 0, SEEK_END) == 0;
+    long length = ok ? ftell(stream) : -1;
+    ok = ok && length > 0 && fseek(stream, 0, SEEK_SET) == 0;
+
+    if (ok) {
+        file->raw = malloc((size_t)length + MODEL_FILE_ALIGNMENT);
+        ok = file->raw != NULL;
+    }
+    if (ok) {
+        uintptr_t addr = (uintptr_t)file->raw;
+        addr = (addr + MODEL_FILE_ALIGNMENT - 1) & ~(uintptr_t)(MODEL_FILE_ALIGNMENT - 1);
+        file->base = (void*)addr;
+        file->length = (size_t)length;
+        ok = fread(file->base, 1, file->length, stream) == file->length;
+    }
+
+    fclose(stream);
+    return ok;
+}
+
+#ifdef MODEL_FILE_HAVE_MMAP
+static bool model_file_map(ModelFile* file, const char* filename, bool populate) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    if (populate) flags |= MAP_POPULATE;
+#endif
+
+    // Read-only shared pages come straight from the page cache, so every
+    // process serving the same model shares one physical copy
+    void* base = mmap(NULL, (size_t)info.st_size, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return false;
+
+#ifndef MAP_POPULATE
+    if (populate) posix_madvise(base, (size_t)info.st_size, POSIX_MADV_WILLNEED);
+#endif
+
+    file->base = base;
+    file->length = (size_t)info.st_size;
+    file->mapped = true;
+    return true;
+}
+#endif
+
+bool model_file_open(ModelFile* file, const char* filename, ModelLoadMode mode) {
+    if (!file || !filename) return false;
+    memset(file, 0, sizeof(ModelFile));
+
+    bool ok;
+#ifdef MODEL_FILE_HAVE_MMAP
+    if (mode == MODEL_LOAD_READ) {
+        ok = model_file_read(file, filename);
+    } else {
+        ok = model_file_map(file, filename, mode == MODEL_LOAD_MMAP_POPULATE);
+    }
+#else
+    (void)mode;
+    ok = model_file_read(file, filename);
+#endif
+
+    if (!ok) {
+        fprintf(stderr, "Model file %s: cannot open\n", filename);
+        model_file_close(file);
+        return false;
+    }
+
+    if (!model_file_validate(file, filename)) {
+        model_file_close(file);
+        return false;
+    }
+    return true;
+}
+
+void model_file_close(ModelFile* file) {
+    if (!file) return;
+
+#ifdef MODEL_FILE_HAVE_MMAP
+    if (file->mapped && file->base) munmap(file->base, file->length);
+#endif
+    free(file->raw);
+    memset(file, 0, sizeof(ModelFile));
+}
+
+const float* model_file_tensor_data(const ModelFile* file, uint32_t index) {
+    if (!file || !file->header || index >= file->header->num_tensors) return NULL;
+    return (const float*)(file->blob + file->tensors[index].offset);
+}
+
+bool model_file_verify(const ModelFile* file) {
+    if (!file || !file->header) return false;
+
+    for (uint32_t t = 0; t < file->header->num_tensors; t++) {
+        const ModelTensorRecord* tensor = &file->tensors[t];
+        uint32_t hash = model_checksum(MODEL_FNV_OFFSET, file->blob + tensor->offset,
+                                       (size_t)tensor->size * sizeof(float));
+        if (hash != tensor->checksum) return false;
+    }
+    return true;
+}
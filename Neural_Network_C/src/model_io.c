@@ -0,0 +1,331 @@
+/*
+ * Neural Network System - Model Save/Load Implementation
+ * Converts networks to and from the binary model format; loaded parameter
+ * tensors borrow their data from the model file instead of copying it
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/model_io.h"
+#include "../headers/layers.h"
+#include "../headers/activations.h"
+
+/**
+ * @brief Activations that can be stored by name
+ */
+static const char* const model_activation_names[] = {
+    "linear", "relu", "leaky_relu", "sigmoid", "tanh", "softmax",
+    "elu", "swish", "gelu", "selu", "mish"
+};
+
+#define MODEL_NUM_ACTIVATIONS (int)(sizeof(model_activation_names) / sizeof(model_activation_names[0]))
+
+static bool model_activation_name(ActivationFunction activation, char* name, size_t capacity) {
+    name[0] = '\0';
+    if (!activation) return true;
+
+    for (int i = 0; i < MODEL_NUM_ACTIVATIONS; i++) {
+        if (activation_get_function(model_activation_names[i]) == activation) {
+            strncpy(name, model_activation_names[i], capacity - 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// Saving
+// ============================================================================
+
+/**
+ * @brief Fill a layer record from a layer's type-specific data
+ */
+static bool model_describe_layer(const Layer* layer, ModelLayerRecord* record) {
+    memset(record, 0, sizeof(ModelLayerRecord));
+    memcpy(record->name, layer->name, sizeof(record->name));
+    record->name[sizeof(record->name) - 1] = '\0';
+    record->type = (uint32_t)layer->type;
+    record->num_weights = (uint32_t)layer->num_weights;
+    record->num_biases = (uint32_t)layer->num_biases;
+    record->trainable = layer->trainable ? 1u : 0u;
+
+    ActivationFunction activation = NULL;
+
+    switch (layer->type) {
+        case LAYER_DENSE: {
+            const DenseData* data = (const DenseData*)layer->layer_data;
+            record->params[0] = data->params.input_size;
+            record->params[1] = data->params.output_size;
+            activation = data->params.activation;
+            break;
+        }
+        case LAYER_CONV2D: {
+            const Conv2DData* data = (const Conv2DData*)layer->layer_data;
+            record->params[0] = data->params.input_channels;
+            record->params[1] = data->params.output_channels;
+            record->params[2] = data->params.kernel_size;
+            record->params[3] = data->params.stride;
+            record->params[4] = data->params.padding;
+            activation = data->params.activation;
+            break;
+        }
+        case LAYER_MAXPOOL2D:
+        case LAYER_AVGPOOL2D: {
+            // Both pooling layers keep their PoolParams first
+            const PoolParams* params = (const PoolParams*)layer->layer_data;
+            record->params[0] = params->pool_size;
+            record->params[1] = params->stride;
+            break;
+        }
+        case LAYER_DROPOUT:
+            record->rate = ((const DropoutData*)layer->layer_data)->dropout_rate;
+            break;
+        case LAYER_LSTM: {
+            const LSTMParams* params = &((const LSTMData*)layer->layer_data)->params;
+            record->params[0] = params->input_size;
+            record->params[1] = params->hidden_size;
+            record->params[2] = params->return_sequences ? 1 : 0;
+            record->params[3] = params->bptt_steps;
+            break;
+        }
+        case LAYER_GRU: {
+            const GRUParams* params = &((const GRUData*)layer->layer_data)->params;
+            record->params[0] = params->input_size;
+            record->params[1] = params->hidden_size;
+            record->params[2] = params->return_sequences ? 1 : 0;
+            record->params[3] = params->bptt_steps;
+            break;
+        }
+        case LAYER_FLATTEN:
+            break;
+        default:
+            fprintf(stderr, "Cannot save layer '%s': no constructor for its type\n", layer->name);
+            return false;
+    }
+
+    if (!model_activation_name(activation, record->activation, sizeof(record->activation))) {
+        fprintf(stderr, "Cannot save layer '%s': unknown activation function\n", layer->name);
+        return false;
+    }
+    return true;
+}
+
+static bool model_add_tensors(ModelWriter* writer, Tensor** tensors, int count) {
+    for (int i = 0; i < count; i++) {
+        const Tensor* tensor = tensors[i];
+        if (!tensor || !tensor->data || !model_writer_add_tensor(writer, tensor->data, tensor->shape,
+                                                                 tensor->ndim)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool neural_network_save(NeuralNetwork* net, const char* filename) {
+    if (!net || !filename) return false;
+
+    // The input shape is recorded so load can rebuild without the caller's help
+    const int* input_shape = NULL;
+    int input_ndim = 0;
+    if (net->num_layers > 0 && net->layers[0]->input_shape) {
+        input_shape = net->layers[0]->input_shape;
+        input_ndim = net->layers[0]->input_ndim;
+    }
+
+    ModelWriter writer;
+    model_writer_init(&writer, net->name, input_shape, input_ndim);
+
+    bool ok = true;
+    for (int l = 0; l < net->num_layers && ok; l++) {
+        Layer* layer = net->layers[l];
+        ModelLayerRecord record;
+
+        // Int8 state is derived data; quantized layers are saved from their float parameters
+        ok = layer && model_describe_layer(layer, &record) &&
+             model_writer_add_layer(&writer, &record) &&
+             model_add_tensors(&writer, layer->weights, layer->num_weights) &&
+             model_add_tensors(&writer, layer->biases, layer->num_biases);
+    }
+
+    ok = ok && model_writer_write(&writer, filename);
+    model_writer_free(&writer);
+    return ok;
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+static Layer* model_create_layer(const ModelLayerRecord* record) {
+    char name[sizeof(record->activation) + 1];
+    memcpy(name, record->activation, sizeof(record->activation));
+    name[sizeof(record->activation)] = '\0';
+
+    ActivationFunction activation = NULL;
+    if (name[0] != '\0') {
+        activation = activation_get_function(name);
+        if (!activation) {
+            fprintf(stderr, "Model file: unknown activation '%s'\n", name);
+            return NULL;
+        }
+    }
+
+    const int32_t* p = record->params;
+    Layer* layer = NULL;
+
+    switch ((LayerType)record->type) {
+        case LAYER_DENSE:     layer = layer_dense_create(p[0], p[1], activation); break;
+        case LAYER_CONV2D:    layer = layer_conv2d_create(p[0], p[1], p[2], p[3], p[4], activation); break;
+        case LAYER_MAXPOOL2D: layer = layer_maxpool2d_create(p[0], p[1]); break;
+        case LAYER_AVGPOOL2D: layer = layer_avgpool2d_create(p[0], p[1]); break;
+        case LAYER_FLATTEN:   layer = layer_flatten_create(); break;
+        case LAYER_DROPOUT:   layer = layer_dropout_create(record->rate); break;
+        case LAYER_LSTM:      layer = layer_lstm_create(p[0], p[1], p[2] != 0); break;
+        case LAYER_GRU:       layer = layer_gru_create(p[0], p[1], p[2] != 0); break;
+        default:
+            fprintf(stderr, "Model file: unsupported layer type %u\n", record->type);
+            return NULL;
+    }
+
+    if (layer) {
+        memcpy(layer->name, record->name, sizeof(layer->name));
+        layer->name[sizeof(layer->name) - 1] = '\0';
+        layer->trainable = record->trainable != 0;
+        if (record->type == LAYER_LSTM || record->type == LAYER_GRU) layer_recurrent_set_bptt(layer, p[3]);
+    }
+    return layer;
+}
+
+/**
+ * @brief Point a parameter tensor at its data inside the model file
+ */
+static bool model_bind_tensor(Tensor* tensor, const ModelFile* file, uint32_t index) {
+    if (!tensor || (uint64_t)tensor->size != file->tensors[index].size) return false;
+
+    tensor_alias_data(tensor, (float*)model_file_tensor_data(file, index));
+    return true;
+}
+
+static bool model_bind_layer(Layer* layer, const ModelLayerRecord* record, const ModelFile* file) {
+    if ((uint32_t)layer->num_weights != record->num_weights ||
+        (uint32_t)layer->num_biases != record->num_biases) {
+        return false;
+    }
+
+    uint32_t index = record->first_tensor;
+    for (int i = 0; i < layer->num_weights; i++) {
+        if (!model_bind_tensor(layer->weights[i], file, index++)) return false;
+    }
+    for (int i = 0; i < layer->num_biases; i++) {
+        if (!model_bind_tensor(layer->biases[i], file, index++)) return false;
+    }
+    return true;
+}
+
+NeuralNetwork* neural_network_load_with_mode(const char* filename, ModelLoadMode mode) {
+    ModelFile* file = (ModelFile*)malloc(sizeof(ModelFile));
+    if (!file) return NULL;
+    if (!model_file_open(file, filename, mode)) {
+        free(file);
+        return NULL;
+    }
+
+    const ModelFileHeader* header = file->header;
+    char name[sizeof(header->name) + 1];
+    memcpy(name, header->name, sizeof(header->name));
+    name[sizeof(header->name)] = '\0';
+
+    NeuralNetwork* net = neural_network_create(name);
+    bool ok = net != NULL;
+
+    for (uint32_t l = 0; l < header->num_layers && ok; l++) {
+        Layer* layer = model_create_layer(&file->layers[l]);
+        ok = layer != NULL;
+        if (ok && !neural_network_add_layer(net, layer)) {
+            layer_destroy(layer);
+            ok = false;
+        }
+    }
+
+    if (ok && header->input_ndim > 0) {
+        int shape[MODEL_FILE_MAX_DIMS];
+        for (int i = 0; i < header->input_ndim; i++) shape[i] = header->input_shape[i];
+        ok = neural_network_build(net, shape, header->input_ndim);
+    }
+
+    // Bind after building so any parameters allocated along the way are replaced
+    for (uint32_t l = 0; l < header->num_layers && ok; l++) {
+        ok = model_bind_layer(net->layers[l], &file->layers[l], file);
+        if (!ok) fprintf(stderr, "Model file %s: parameters of layer %u do not match\n", filename, l);
+    }
+
+    if (!ok) {
+        if (net) neural_network_destroy(net);
+        model_file_close(file);
+        free(file);
+        return NULL;
+    }
+
+    net->model_file = file;
+    return net;
+}
+
+NeuralNetwork* neural_network_load(const char* filename) {
+    return neural_network_load_with_mode(filename, MODEL_LOAD_MMAP);
+}
+
+// ============================================================================
+// Releasing
+// ============================================================================
+
+static bool model_tensor_in_file(const Tensor* tensor, const ModelFile* file) {
+    const unsigned char* data = (const unsigned char*)tensor->data;
+    const unsigned char* base = (const unsigned char*)file->base;
+    return !tensor->owns_data && data >= base && data < base + file->length;
+}
+
+static bool model_detach_tensors(Tensor** tensors, int count, const ModelFile* file) {
+    for (int i = 0; i < count; i++) {
+        Tensor* tensor = tensors[i];
+        if (!tensor || !model_tensor_in_file(tensor, file)) continue;
+
+        float* copy = (float*)malloc((size_t)tensor->size * sizeof(float));
+        if (!copy) return false;
+        memcpy(copy, tensor->data, (size_t)tensor->size * sizeof(float));
+        tensor->data = copy;
+        tensor->owns_data = true;
+    }
+    return true;
+}
+
+bool neural_network_detach_model_file(NeuralNetwork* net) {
+    if (!net || !net->model_file) return true;
+
+    ModelFile* file = (ModelFile*)net->model_file;
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (!model_detach_tensors(layer->weights, layer->num_weights, file) ||
+            !model_detach_tensors(layer->biases, layer->num_biases, file)) {
+            return false;
+        }
+    }
+
+    model_file_close(file);
+    free(file);
+    net->model_file = NULL;
+    return true;
+}
+
+void neural_network_unload(NeuralNetwork* net) {
+    if (!net) return;
+
+    // Parameters never own mapped data, so destroying first leaves the file intact
+    ModelFile* file = (ModelFile*)net->model_file;
+    neural_network_destroy(net);
+
+    if (file) {
+        model_file_close(file);
+        free(file);
+    }
+}
@@ -8,6 +8,461 @@
 #include <string.h>
 #include <math.h>
 #include "../headers/optimizers.h"
+#include "../headers/tensor_arena.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OPTIMIZER_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// Update Kernels
+// ============================================================================
+
+/**
+ * @brief Per-tensor constants, computed once per update instead of per element
+ */
+typedef struct {
+    float lr;                   // Learning rate
+    float beta1, beta2;         // Moment decay rates
+    float epsilon;              // Denominator stabilizer
+    float weight_decay;         // L2 coefficient added to the gradient
+    float momentum;             // Velocity decay (SGD with momentum)
+    float step_size;            // Bias-corrected learning rate (Adam, Adamax)
+    float eps_hat;              // Epsilon in the uncorrected v domain (Adam)
+    float m_coef, g_coef;       // Nesterov blend of moment and gradient (NAdam)
+    float v_scale;              // Second moment bias correction (NAdam)
+} OptimizerCoefficients;
+
+/**
+ * @brief Update kernel: w, m, v updated in place from g over n elements
+ */
+typedef void (*OptimizerKernel)(float* w, const float* g, float* m, float* v, int n,
+                                const OptimizerCoefficients* c);
+
+static void optimizer_coefficients(OptimizerType type, const Optimizer* optimizer,
+                                   float learning_rate, int t, OptimizerCoefficients* c) {
+    c->lr = learning_rate;
+    c->beta1 = optimizer ? optimizer->beta1 : 0.9f;
+    c->beta2 = optimizer ? optimizer->beta2 : 0.999f;
+    c->epsilon = optimizer ? optimizer->epsilon : 1e-8f;
+    c->weight_decay = optimizer ? optimizer->weight_decay : 0.0f;
+    c->momentum = (optimizer && optimizer->momentum > 0.0f) ? optimizer->momentum : 0.9f;
+
+    if (t < 1) t = 1;
+    float bias1 = 1.0f - powf(c->beta1, (float)t);
+    float bias2 = 1.0f - powf(c->beta2, (float)t);
+
+    switch (type) {
+        case OPTIMIZER_ADAM:
+            // lr * m_hat / (sqrt(v_hat) + eps) rewritten on the raw moments
+            c->step_size = learning_rate * sqrtf(bias2) / bias1;
+            c->eps_hat = c->epsilon * sqrtf(bias2);
+            break;
+        case OPTIMIZER_ADAMAX:
+            c->step_size = learning_rate / bias1;
+            break;
+        case OPTIMIZER_NADAM:
+            c->m_coef = c->beta1 / (1.0f - powf(c->beta1, (float)(t + 1)));
+            c->g_coef = (1.0f - c->beta1) / bias1;
+            c->v_scale = 1.0f / bias2;
+            break;
+        default:
+            break;
+    }
+}
+
+static void kernel_sgd_scalar(float* w, const float* g, float* m, float* v, int n,
+                              const OptimizerCoefficients* c) {
+    (void)m; (void)v;
+    for (int i = 0; i < n; i++) {
+        w[i] -= c->lr * (g[i] + c->weight_decay * w[i]);
+    }
+}
+
+static void kernel_momentum_scalar(float* w, const float* g, float* m, float* v, int n,
+                                   const OptimizerCoefficients* c) {
+    (void)v;
+    for (int i = 0; i < n; i++) {
+        float grad = g[i] + c->weight_decay * w[i];
+        m[i] = c->momentum * m[i] - c->lr * grad;
+        w[i] += m[i];
+    }
+}
+
+static void kernel_adagrad_scalar(float* w, const float* g, float* m, float* v, int n,
+                                  const OptimizerCoefficients* c) {
+    (void)v;
+    for (int i = 0; i < n; i++) {
+        float grad = g[i] + c->weight_decay * w[i];
+        m[i] += grad * grad;
+        w[i] -= c->lr * grad / (sqrtf(m[i]) + c->epsilon);
+    }
+}
+
+static void kernel_rmsprop_scalar(float* w, const float* g, float* m, float* v, int n,
+                                  const OptimizerCoefficients* c) {
+    (void)m;
+    for (int i = 0; i < n; i++) {
+        float grad = g[i] + c->weight_decay * w[i];
+        v[i] = c->beta2 * v[i] + (1.0f - c->beta2) * grad * grad;
+        w[i] -= c->lr * grad / (sqrtf(v[i]) + c->epsilon);
+    }
+}
+
+static void kernel_adam_scalar(float* w, const float* g, float* m, float* v, int n,
+                               const OptimizerCoefficients* c) {
+    for (int i = 0; i < n; i++) {
+        float grad = g[i] + c->weight_decay * w[i];
+        m[i] = c->beta1 * m[i] + (1.0f - c->beta1) * grad;
+        v[i] = c->beta2 * v[i] + (1.0f - c->beta2) * grad * grad;
+        w[i] -= c->step_size * m[i] / (sqrtf(v[i]) + c->eps_hat);
+    }
+}
+
+static void kernel_adamax_scalar(float* w, const float* g, float* m, float* v, int n,
+                                 const OptimizerCoefficients* c) {
+    for (int i = 0; i < n; i++) {
+        float grad = g[i] + c->weight_decay * w[i];
+        float decayed = c->beta2 * v[i];
+        float magnitude = fabsf(grad);
+        m[i] = c->beta1 * m[i] + (1.0f - c->beta1) * grad;
+        v[i] = decayed > magnitude ? decayed : magnitude;
+        w[i] -= c->step_size * m[i] / (v[i] + c->epsilon);
+    }
+}
+
+static void kernel_nadam_scalar(float* w, const float* g, float* m, float* v, int n,
+                                const OptimizerCoefficients* c) {
+    for (int i = 0; i < n; i++) {
+        float grad = g[i] + c->weight_decay * w[i];
+        m[i] = c->beta1 * m[i] + (1.0f - c->beta1) * grad;
+        v[i] = c->beta2 * v[i] + (1.0f - c->beta2) * grad * grad;
+        float nesterov = c->m_coef * m[i] + c->g_coef * grad;
+        w[i] -= c->lr * nesterov / (sqrtf(v[i] * c->v_scale) + c->epsilon);
+    }
+}
+
+#ifdef OPTIMIZER_HAVE_X86
+
+#define AVX512_TAIL_MASK(n, i) \
+    (((n) - (i) >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << ((n) - (i))) - 1))
+
+__attribute__((target("avx512f")))
+static void kernel_sgd_avx512(float* w, const float* g, float* m, float* v, int n,
+                              const OptimizerCoefficients* c) {
+    (void)m; (void)v;
+    const __m512 lr = _mm512_set1_ps(c->lr);
+    const __m512 wd = _mm512_set1_ps(c->weight_decay);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(n, i);
+        __m512 wv = _mm512_maskz_loadu_ps(k, w + i);
+        __m512 gv = _mm512_fmadd_ps(wd, wv, _mm512_maskz_loadu_ps(k, g + i));
+        _mm512_mask_storeu_ps(w + i, k, _mm512_fnmadd_ps(lr, gv, wv));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void kernel_momentum_avx512(float* w, const float* g, float* m, float* v, int n,
+                                   const OptimizerCoefficients* c) {
+    (void)v;
+    const __m512 lr = _mm512_set1_ps(c->lr);
+    const __m512 wd = _mm512_set1_ps(c->weight_decay);
+    const __m512 mu = _mm512_set1_ps(c->momentum);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(n, i);
+        __m512 wv = _mm512_maskz_loadu_ps(k, w + i);
+        __m512 gv = _mm512_fmadd_ps(wd, wv, _mm512_maskz_loadu_ps(k, g + i));
+        __m512 mv = _mm512_fnmadd_ps(lr, gv, _mm512_mul_ps(mu, _mm512_maskz_loadu_ps(k, m + i)));
+        _mm512_mask_storeu_ps(m + i, k, mv);
+        _mm512_mask_storeu_ps(w + i, k, _mm512_add_ps(wv, mv));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void kernel_adagrad_avx512(float* w, const float* g, float* m, float* v, int n,
+                                  const OptimizerCoefficients* c) {
+    (void)v;
+    const __m512 lr = _mm512_set1_ps(c->lr);
+    const __m512 wd = _mm512_set1_ps(c->weight_decay);
+    const __m512 eps = _mm512_set1_ps(c->epsilon);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(n, i);
+        __m512 wv = _mm512_maskz_loadu_ps(k, w + i);
+        __m512 gv = _mm512_fmadd_ps(wd, wv, _mm512_maskz_loadu_ps(k, g + i));
+        __m512 mv = _mm512_fmadd_ps(gv, gv, _mm512_maskz_loadu_ps(k, m + i));
+        __m512 denom = _mm512_add_ps(_mm512_sqrt_ps(mv), eps);
+        _mm512_mask_storeu_ps(m + i, k, mv);
+        _mm512_mask_storeu_ps(w + i, k, _mm512_fnmadd_ps(lr, _mm512_div_ps(gv, denom), wv));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void kernel_rmsprop_avx512(float* w, const float* g, float* m, float* v, int n,
+                                  const OptimizerCoefficients* c) {
+    (void)m;
+    const __m512 lr = _mm512_set1_ps(c->lr);
+    const __m512 wd = _mm512_set1_ps(c->weight_decay);
+    const __m512 eps = _mm512_set1_ps(c->epsilon);
+    const __m512 b2 = _mm512_set1_ps(c->beta2);
+    const __m512 one_b2 = _mm512_set1_ps(1.0f - c->beta2);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(n, i);
+        __m512 wv = _mm512_maskz_loadu_ps(k, w + i);
+        __m512 gv = _mm512_fmadd_ps(wd, wv, _mm512_maskz_loadu_ps(k, g + i));
+        __m512 vv = _mm512_fmadd_ps(one_b2, _mm512_mul_ps(gv, gv),
+                                    _mm512_mul_ps(b2, _mm512_maskz_loadu_ps(k, v + i)));
+        __m512 denom = _mm512_add_ps(_mm512_sqrt_ps(vv), eps);
+        _mm512_mask_storeu_ps(v + i, k, vv);
+        _mm512_mask_storeu_ps(w + i, k, _mm512_fnmadd_ps(lr, _mm512_div_ps(gv, denom), wv));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void kernel_adam_avx512(float* w, const float* g, float* m, float* v, int n,
+                               const OptimizerCoefficients* c) {
+    const __m512 wd = _mm512_set1_ps(c->weight_decay);
+    const __m512 b1 = _mm512_set1_ps(c->beta1);
+    const __m512 one_b1 = _mm512_set1_ps(1.0f - c->beta1);
+    const __m512 b2 = _mm512_set1_ps(c->beta2);
+    const __m512 one_b2 = _mm512_set1_ps(1.0f - c->beta2);
+    const __m512 step = _mm512_set1_ps(c->step_size);
+    const __m512 eps = _mm512_set1_ps(c->eps_hat);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(n, i);
+        __m512 wv = _mm512_maskz_loadu_ps(k, w + i);
+        __m512 gv = _mm512_fmadd_ps(wd, wv, _mm512_maskz_loadu_ps(k, g + i));
+        __m512 mv = _mm512_fmadd_ps(one_b1, gv, _mm512_mul_ps(b1, _mm512_maskz_loadu_ps(k, m + i)));
+        __m512 vv = _mm512_fmadd_ps(one_b2, _mm512_mul_ps(gv, gv),
+                                    _mm512_mul_ps(b2, _mm512_maskz_loadu_ps(k, v + i)));
+        __m512 denom = _mm512_add_ps(_mm512_sqrt_ps(vv), eps);
+        _mm512_mask_storeu_ps(m + i, k, mv);
+        _mm512_mask_storeu_ps(v + i, k, vv);
+        _mm512_mask_storeu_ps(w + i, k, _mm512_fnmadd_ps(step, _mm512_div_ps(mv, denom), wv));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void kernel_adamax_avx512(float* w, const float* g, float* m, float* v, int n,
+                                 const OptimizerCoefficients* c) {
+    const __m512 wd = _mm512_set1_ps(c->weight_decay);
+    const __m512 b1 = _mm512_set1_ps(c->beta1);
+    const __m512 one_b1 = _mm512_set1_ps(1.0f - c->beta1);
+    const __m512 b2 = _mm512_set1_ps(c->beta2);
+    const __m512 step = _mm512_set1_ps(c->step_size);
+    const __m512 eps = _mm512_set1_ps(c->epsilon);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(n, i);
+        __m512 wv = _mm512_maskz_loadu_ps(k, w + i);
+        __m512 gv = _mm512_fmadd_ps(wd, wv, _mm512_maskz_loadu_ps(k, g + i));
+        __m512 mv = _mm512_fmadd_ps(one_b1, gv, _mm512_mul_ps(b1, _mm512_maskz_loadu_ps(k, m + i)));
+        __m512 uv = _mm512_max_ps(_mm512_mul_ps(b2, _mm512_maskz_loadu_ps(k, v + i)),
+                                  _mm512_abs_ps(gv));
+        __m512 denom = _mm512_add_ps(uv, eps);
+        _mm512_mask_storeu_ps(m + i, k, mv);
+        _mm512_mask_storeu_ps(v + i, k, uv);
+        _mm512_mask_storeu_ps(w + i, k, _mm512_fnmadd_ps(step, _mm512_div_ps(mv, denom), wv));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void kernel_nadam_avx512(float* w, const float* g, float* m, float* v, int n,
+                                const OptimizerCoefficients* c) {
+    const __m512 lr = _mm512_set1_ps(c->lr);
+    const __m512 wd = _mm512_set1_ps(c->weight_decay);
+    const __m512 b1 = _mm512_set1_ps(c->beta1);
+    const __m512 one_b1 = _mm512_set1_ps(1.0f - c->beta1);
+    const __m512 b2 = _mm512_set1_ps(c->beta2);
+    const __m512 one_b2 = _mm512_set1_ps(1.0f - c->beta2);
+    const __m512 mc = _mm512_set1_ps(c->m_coef);
+    const __m512 gc = _mm512_set1_ps(c->g_coef);
+    const __m512 vs = _mm512_set1_ps(c->v_scale);
+    const __m512 eps = _mm512_set1_ps(c->epsilon);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 k = AVX512_TAIL_MASK(n, i);
+        __m512 wv = _mm512_maskz_loadu_ps(k, w + i);
+        __m512 gv = _mm512_fmadd_ps(wd, wv, _mm512_maskz_loadu_ps(k, g + i));
+        __m512 mv = _mm512_fmadd_ps(one_b1, gv, _mm512_mul_ps(b1, _mm512_maskz_loadu_ps(k, m + i)));
+        __m512 vv = _mm512_fmadd_ps(one_b2, _mm512_mul_ps(gv, gv),
+                                    _mm512_mul_ps(b2, _mm512_maskz_loadu_ps(k, v + i)));
+        __m512 nesterov = _mm512_fmadd_ps(mc, mv, _mm512_mul_ps(gc, gv));
+        __m512 denom = _mm512_add_ps(_mm512_sqrt_ps(_mm512_mul_ps(vv, vs)), eps);
+        _mm512_mask_storeu_ps(m + i, k, mv);
+        _mm512_mask_storeu_ps(v + i, k, vv);
+        _mm512_mask_storeu_ps(w + i, k, _mm512_fnmadd_ps(lr, _mm512_div_ps(nesterov, denom), wv));
+    }
+}
+
+// AVX2 kernels cover the Adam family, the hot path in practice; the
+// simpler optimizers are memory-bound and fall back to the scalar loops
+
+__attribute__((target("avx2,fma")))
+static void kernel_adam_avx2(float* w, const float* g, float* m, float* v, int n,
+                             const OptimizerCoefficients* c) {
+    const __m256 wd = _mm256_set1_ps(c->weight_decay);
+    const __m256 b1 = _mm256_set1_ps(c->beta1);
+    const __m256 one_b1 = _mm256_set1_ps(1.0f - c->beta1);
+    const __m256 b2 = _mm256_set1_ps(c->beta2);
+    const __m256 one_b2 = _mm256_set1_ps(1.0f - c->beta2);
+    const __m256 step = _mm256_set1_ps(c->step_size);
+    const __m256 eps = _mm256_set1_ps(c->eps_hat);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 wv = _mm256_loadu_ps(w + i);
+        __m256 gv = _mm256_fmadd_ps(wd, wv, _mm256_loadu_ps(g + i));
+        __m256 mv = _mm256_fmadd_ps(one_b1, gv, _mm256_mul_ps(b1, _mm256_loadu_ps(m + i)));
+        __m256 vv = _mm256_fmadd_ps(one_b2, _mm256_mul_ps(gv, gv),
+                                    _mm256_mul_ps(b2, _mm256_loadu_ps(v + i)));
+        __m256 denom = _mm256_add_ps(_mm256_sqrt_ps(vv), eps);
+        _mm256_storeu_ps(m + i, mv);
+        _mm256_storeu_ps(v + i, vv);
+        _mm256_storeu_ps(w + i, _mm256_fnmadd_ps(step, _mm256_div_ps(mv, denom), wv));
+    }
+
+    kernel_adam_scalar(w + i, g + i, m + i, v + i, n - i, c);
+}
+
+__attribute__((target("avx2,fma")))
+static void kernel_nadam_avx2(float* w, const float* g, float* m, float* v, int n,
+                              const OptimizerCoefficients* c) {
+    const __m256 lr = _mm256_set1_ps(c->lr);
+    const __m256 wd = _mm256_set1_ps(c->weight_decay);
+    const __m256 b1 = _mm256_set1_ps(c->beta1);
+    const __m256 one_b1 = _mm256_set1_ps(1.0f - c->beta1);
+    const __m256 b2 = _mm256_set1_ps(c->beta2);
+    const __m256 one_b2 = _mm256_set1_ps(1.0f - c->beta2);
+    const __m256 mc = _mm256_set1_ps(c->m_coef);
+    const __m256 gc = _mm256_set1_ps(c->g_coef);
+    const __m256 vs = _mm256_set1_ps(c->v_scale);
+    const __m256 eps = _mm256_set1_ps(c->epsilon);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 wv = _mm256_loadu_ps(w + i);
+        __m256 gv = _mm256_fmadd_ps(wd, wv, _mm256_loadu_ps(g + i));
+        __m256 mv = _mm256_fmadd_ps(one_b1, gv, _mm256_mul_ps(b1, _mm256_loadu_ps(m + i)));
+        __m256 vv = _mm256_fmadd_ps(one_b2, _mm256_mul_ps(gv, gv),
+                                    _mm256_mul_ps(b2, _mm256_loadu_ps(v + i)));
+        __m256 nesterov = _mm256_fmadd_ps(mc, mv, _mm256_mul_ps(gc, gv));
+        __m256 denom = _mm256_add_ps(_mm256_sqrt_ps(_mm256_mul_ps(vv, vs)), eps);
+        _mm256_storeu_ps(m + i, mv);
+        _mm256_storeu_ps(v + i, vv);
+        _mm256_storeu_ps(w + i, _mm256_fnmadd_ps(lr, _mm256_div_ps(nesterov, denom), wv));
+    }
+
+    kernel_nadam_scalar(w + i, g + i, m + i, v + i, n - i, c);
+}
+
+__attribute__((target("avx2,fma")))
+static void kernel_adamax_avx2(float* w, const float* g, float* m, float* v, int n,
+                               const OptimizerCoefficients* c) {
+    const __m256 wd = _mm256_set1_ps(c->weight_decay);
+    const __m256 b1 = _mm256_set1_ps(c->beta1);
+    const __m256 one_b1 = _mm256_set1_ps(1.0f - c->beta1);
+    const __m256 b2 = _mm256_set1_ps(c->beta2);
+    const __m256 step = _mm256_set1_ps(c->step_size);
+    const __m256 eps = _mm256_set1_ps(c->epsilon);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 wv = _mm256_loadu_ps(w + i);
+        __m256 gv = _mm256_fmadd_ps(wd, wv, _mm256_loadu_ps(g + i));
+        __m256 mv = _mm256_fmadd_ps(one_b1, gv, _mm256_mul_ps(b1, _mm256_loadu_ps(m + i)));
+        __m256 uv = _mm256_max_ps(_mm256_mul_ps(b2, _mm256_loadu_ps(v + i)),
+                                  _mm256_andnot_ps(sign, gv));
+        __m256 denom = _mm256_add_ps(uv, eps);
+        _mm256_storeu_ps(m + i, mv);
+        _mm256_storeu_ps(v + i, uv);
+        _mm256_storeu_ps(w + i, _mm256_fnmadd_ps(step, _mm256_div_ps(mv, denom), wv));
+    }
+
+    kernel_adamax_scalar(w + i, g + i, m + i, v + i, n - i, c);
+}
+
+#endif
+
+static OptimizerKernel optimizer_select_kernel(OptimizerType type) {
+#ifdef OPTIMIZER_HAVE_X86
+    static int level = -1;
+    if (level < 0) {
+        __builtin_cpu_init();
+        level = __builtin_cpu_supports("avx512f") ? 2
+              : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? 1 : 0;
+    }
+
+    if (level == 2) {
+        switch (type) {
+            case OPTIMIZER_SGD: return kernel_sgd_avx512;
+            case OPTIMIZER_SGD_MOMENTUM: return kernel_momentum_avx512;
+            case OPTIMIZER_ADAGRAD: return kernel_adagrad_avx512;
+            case OPTIMIZER_RMSPROP: return kernel_rmsprop_avx512;
+            case OPTIMIZER_ADAM: return kernel_adam_avx512;
+            case OPTIMIZER_ADAMAX: return kernel_adamax_avx512;
+            case OPTIMIZER_NADAM: return kernel_nadam_avx512;
+            default: break;
+        }
+    } else if (level == 1) {
+        switch (type) {
+            case OPTIMIZER_ADAM: return kernel_adam_avx2;
+            case OPTIMIZER_ADAMAX: return kernel_adamax_avx2;
+            case OPTIMIZER_NADAM: return kernel_nadam_avx2;
+            default: break;
+        }
+    }
+#endif
+
+    switch (type) {
+        case OPTIMIZER_SGD_MOMENTUM: return kernel_momentum_scalar;
+        case OPTIMIZER_ADAGRAD: return kernel_adagrad_scalar;
+        case OPTIMIZER_RMSPROP: return kernel_rmsprop_scalar;
+        case OPTIMIZER_ADAM: return kernel_adam_scalar;
+        case OPTIMIZER_ADAMAX: return kernel_adamax_scalar;
+        case OPTIMIZER_NADAM: return kernel_nadam_scalar;
+        case OPTIMIZER_SGD:
+        default: return kernel_sgd_scalar;
+    }
+}
+
+static bool optimizer_needs_m(OptimizerType type) {
+    return type == OPTIMIZER_SGD_MOMENTUM || type == OPTIMIZER_ADAGRAD ||
+           type == OPTIMIZER_ADAM || type == OPTIMIZER_ADAMAX || type == OPTIMIZER_NADAM;
+}
+
+static bool optimizer_needs_v(OptimizerType type) {
+    return type == OPTIMIZER_RMSPROP || type == OPTIMIZER_ADAM ||
+           type == OPTIMIZER_ADAMAX || type == OPTIMIZER_NADAM;
+}
+
+/**
+ * @brief Run one optimizer kernel on a tensor given an explicit state view
+ */
+static void optimizer_apply(OptimizerType type, Tensor* weights, Tensor* gradients,
+                            float learning_rate, OptimizerUpdateState* state) {
+    if (!weights || !gradients || weights->size != gradients->size) return;
+
+    if (type != OPTIMIZER_SGD &&
+        (!state || (optimizer_needs_m(type) && !state->m) || (optimizer_needs_v(type) && !state->v))) {
+        // No state to carry between steps: plain gradient descent
+        type = OPTIMIZER_SGD;
+    }
+
+    OptimizerCoefficients coefficients;
+    optimizer_coefficients(type, state ? state->optimizer : NULL, learning_rate,
+                           state ? state->t : 1, &coefficients);
+
+    optimizer_select_kernel(type)(weights->data, gradients->data,
+                                  state ? state->m : NULL, state ? state->v : NULL,
+                                  weights->size, &coefficients);
+}
 
 // ============================================================================
 // Optimizer Creation and Management
@@ -28,9 +483,14 @@ Optimizer* optimizer_create(OptimizerType type, float learning_rate) {
     optimizer->weight_decay = 0.0f; // L2 regularization
     optimizer->momentum = 0.0f;   // Momentum factor
 
-    // Initialize state
-    optimizer->m = NULL;  // First moment (Adam)
-    optimizer->v = NULL;  // Second moment (Adam)
+    // Initialize state (slots are created on each parameter's first update)
+    optimizer->params = NULL;
+    optimizer->m = NULL;
+    optimizer->v = NULL;
+    optimizer->steps = NULL;
+    optimizer->num_slots = 0;
+    optimizer->slot_capacity = 0;
+    optimizer->slot_cursor = 0;
     optimizer->t = 0;     // Time step
 
     // Set function pointers based on type
@@ -82,280 +542,207 @@ Optimizer* optimizer_create(OptimizerType type, float learning_rate) {
 void optimizer_destroy(Optimizer* optimizer) {
     if (!optimizer) return;
 
-    // Free moment estimates if they exist
-    if (optimizer->m) {
-        // Would need to free each tensor in the array
-        free(optimizer->m);
-    }
-    if (optimizer->v) {
-        free(optimizer->v);
+    for (int i = 0; i < optimizer->num_slots; i++) {
+        tensor_destroy(optimizer->m[i]);
+        tensor_destroy(optimizer->v[i]);
     }
+    free(optimizer->params);
+    free(optimizer->m);
+    free(optimizer->v);
+    free(optimizer->steps);
 
     free(optimizer);
 }
 
-void optimizer_update_layer(Optimizer* optimizer, Layer* layer, int layer_index) {
-    if (!optimizer || !layer || !optimizer->update) return;
-
-    // Update weights if they exist
-    if (layer->weights && layer->num_weights > 0) {
-        for (int i = 0; i < layer->num_weights; i++) {
-            if (layer->weights[i] && layer->weight_gradients && layer->weight_gradients[i]) {
-                // Use appropriate update function based on optimizer type
-                switch (optimizer->type) {
-                    case OPTIMIZER_SGD:
-                        optimizer_sgd_update(layer->weights[i], layer->weight_gradients[i],
-                                           optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_SGD_MOMENTUM:
-                        optimizer_sgd_momentum_update(layer->weights[i], layer->weight_gradients[i],
-                                                    optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_ADAGRAD:
-                        optimizer_adagrad_update(layer->weights[i], layer->weight_gradients[i],
-                                               optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_RMSPROP:
-                        optimizer_rmsprop_update(layer->weights[i], layer->weight_gradients[i],
-                                               optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_ADAM:
-                        optimizer_adam_update(layer->weights[i], layer->weight_gradients[i],
-                                            optimizer->learning_rate, NULL);
-                        break;
-                    default:
-                        optimizer_sgd_update(layer->weights[i], layer->weight_gradients[i],
-                                           optimizer->learning_rate, NULL);
-                        break;
-                }
-            }
-        }
-    }
+// ============================================================================
+// Per-parameter State
+// ============================================================================
 
-    // Update biases if they exist
-    if (layer->biases && layer->num_biases > 0) {
-        for (int i = 0; i < layer->num_biases; i++) {
-            if (layer->biases[i] && layer->bias_gradients && layer->bias_gradients[i]) {
-                // Use appropriate update function based on optimizer type
-                switch (optimizer->type) {
-                    case OPTIMIZER_SGD:
-                        optimizer_sgd_update(layer->biases[i], layer->bias_gradients[i],
-                                           optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_SGD_MOMENTUM:
-                        optimizer_sgd_momentum_update(layer->biases[i], layer->bias_gradients[i],
-                                                    optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_ADAGRAD:
-                        optimizer_adagrad_update(layer->biases[i], layer->bias_gradients[i],
-                                               optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_RMSPROP:
-                        optimizer_rmsprop_update(layer->biases[i], layer->bias_gradients[i],
-                                               optimizer->learning_rate, NULL);
-                        break;
-                    case OPTIMIZER_ADAM:
-                        optimizer_adam_update(layer->biases[i], layer->bias_gradients[i],
-                                            optimizer->learning_rate, NULL);
-                        break;
-                    default:
-                        optimizer_sgd_update(layer->biases[i], layer->bias_gradients[i],
-                                           optimizer->learning_rate, NULL);
-                        break;
-                }
-            }
-        }
-    }
+static Tensor* optimizer_state_tensor(const Tensor* param) {
+    int shape[1] = { param->size };
+    return tensor_create(NULL, shape, 1);
 }
 
-void optimizer_reset(Optimizer* optimizer) {
-    if (!optimizer) return;
+static bool optimizer_grow_slots(Optimizer* optimizer) {
+    int capacity = optimizer->slot_capacity ? optimizer->slot_capacity * 2 : 16;
 
-    optimizer->t = 0;
+    Tensor** params = (Tensor**)realloc(optimizer->params, capacity * sizeof(Tensor*));
+    if (!params) return false;
+    optimizer->params = params;
+
+    Tensor** m = (Tensor**)realloc(optimizer->m, capacity * sizeof(Tensor*));
+    if (!m) return false;
+    optimizer->m = m;
+
+    Tensor** v = (Tensor**)realloc(optimizer->v, capacity * sizeof(Tensor*));
+    if (!v) return false;
+    optimizer->v = v;
 
-    // Reset moment estimates (would need to zero out tensors)
-    // This is a simplified version
+    int* steps = (int*)realloc(optimizer->steps, capacity * sizeof(int));
+    if (!steps) return false;
+    optimizer->steps = steps;
+
+    optimizer->slot_capacity = capacity;
+    return true;
 }
 
-// ============================================================================
-// SGD Implementation
-// ============================================================================
+int optimizer_find_slot(Optimizer* optimizer, const Tensor* param) {
+    if (!optimizer || !param) return -1;
 
-void optimizer_sgd_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
-    if (!weights || !gradients || weights->size != gradients->size) return;
+    // Parameters are visited in the same order every step
+    int cursor = optimizer->slot_cursor;
+    if (cursor < optimizer->num_slots && optimizer->params[cursor] == param) {
+        return cursor;
+    }
 
-    for (int i = 0; i < weights->size; i++) {
-        weights->data[i] -= learning_rate * gradients->data[i];
+    for (int i = 0; i < optimizer->num_slots; i++) {
+        if (optimizer->params[i] == param) return i;
     }
+    return -1;
 }
 
-// ============================================================================
-// SGD with Momentum Implementation
-// ============================================================================
-
-void optimizer_sgd_momentum_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
-    // Simplified momentum implementation
-    // In a full implementation, this would store velocity per parameter
-    static float* velocity = NULL;
-    static int velocity_size = 0;
+/**
+ * @brief Get the slot of a parameter, creating zeroed state on first use
+ */
+static int optimizer_acquire_slot(Optimizer* optimizer, Tensor* param) {
+    int slot = optimizer_find_slot(optimizer, param);
 
-    if (!weights || !gradients || weights->size != gradients->size) return;
+    if (slot >= 0) {
+        bool stale = (optimizer->m[slot] && optimizer->m[slot]->size != param->size) ||
+                     (optimizer->v[slot] && optimizer->v[slot]->size != param->size);
+        if (!stale) return slot;
 
-    // Allocate velocity if needed
-    if (velocity_size != weights->size) {
-        free(velocity);
-        velocity = (float*)malloc(weights->size * sizeof(float));
-        if (velocity) {
-            memset(velocity, 0, weights->size * sizeof(float));
-            velocity_size = weights->size;
+        // Parameter was resized: restart its state
+        tensor_destroy(optimizer->m[slot]);
+        tensor_destroy(optimizer->v[slot]);
+    } else {
+        if (optimizer->num_slots == optimizer->slot_capacity && !optimizer_grow_slots(optimizer)) {
+            return -1;
         }
+        slot = optimizer->num_slots++;
+        optimizer->params[slot] = param;
     }
 
-    if (velocity) {
-        float momentum = 0.9f; // Default momentum
-        for (int i = 0; i < weights->size; i++) {
-            velocity[i] = momentum * velocity[i] - learning_rate * gradients->data[i];
-            weights->data[i] += velocity[i];
-        }
-    } else {
-        // Fallback to regular SGD
-        optimizer_sgd_update(weights, gradients, learning_rate, user_data);
-    }
-}
+    // State outlives the training step, so never take it from a step arena
+    TensorArena* previous = tensor_arena_activate(NULL);
+    optimizer->m[slot] = optimizer_needs_m(optimizer->type) ? optimizer_state_tensor(param) : NULL;
+    optimizer->v[slot] = optimizer_needs_v(optimizer->type) ? optimizer_state_tensor(param) : NULL;
+    tensor_arena_activate(previous);
 
-// ============================================================================
-// AdaGrad Implementation
-// ============================================================================
+    optimizer->steps[slot] = 0;
+    return slot;
+}
 
-void optimizer_adagrad_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
-    // Simplified AdaGrad implementation
-    // In a full implementation, this would accumulate squared gradients
-    static float* accumulated = NULL;
-    static int accumulated_size = 0;
+/**
+ * @brief Update one parameter with its own state slot
+ */
+static void optimizer_update_param(Optimizer* optimizer, Tensor* param, Tensor* gradient) {
+    if (!param || !gradient || param->size != gradient->size) return;
 
-    if (!weights || !gradients || weights->size != gradients->size) return;
+    int slot = optimizer_acquire_slot(optimizer, param);
+    if (slot < 0) {
+        optimizer_sgd_update(param, gradient, optimizer->learning_rate, NULL);
+        return;
+    }
+    optimizer->slot_cursor = slot + 1;
+
+    int t = ++optimizer->steps[slot];
+    if (t > optimizer->t) optimizer->t = t;
+
+    OptimizerUpdateState state = {
+        optimizer,
+        optimizer->m[slot] ? optimizer->m[slot]->data : NULL,
+        optimizer->v[slot] ? optimizer->v[slot]->data : NULL,
+        t
+    };
+    optimizer_apply(optimizer->type, param, gradient, optimizer->learning_rate, &state);
+}
 
-    // Allocate accumulated if needed
-    if (accumulated_size != weights->size) {
-        free(accumulated);
-        accumulated = (float*)malloc(weights->size * sizeof(float));
-        if (accumulated) {
-            memset(accumulated, 0, weights->size * sizeof(float));
-            accumulated_size = weights->size;
+static void optimizer_update_layer_params(Optimizer* optimizer, Layer* layer) {
+    if (layer->weights && layer->weight_gradients) {
+        for (int i = 0; i < layer->num_weights; i++) {
+            optimizer_update_param(optimizer, layer->weights[i], layer->weight_gradients[i]);
         }
     }
 
-    if (accumulated) {
-        float epsilon = 1e-8f;
-        for (int i = 0; i < weights->size; i++) {
-            accumulated[i] += gradients->data[i] * gradients->data[i];
-            float adaptive_lr = learning_rate / (sqrtf(accumulated[i]) + epsilon);
-            weights->data[i] -= adaptive_lr * gradients->data[i];
+    if (layer->biases && layer->bias_gradients) {
+        for (int i = 0; i < layer->num_biases; i++) {
+            optimizer_update_param(optimizer, layer->biases[i], layer->bias_gradients[i]);
         }
-    } else {
-        optimizer_sgd_update(weights, gradients, learning_rate, user_data);
     }
 }
 
-// ============================================================================
-// RMSProp Implementation
-// ============================================================================
-
-void optimizer_rmsprop_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
-    // Simplified RMSProp implementation
-    static float* v = NULL;
-    static int v_size = 0;
+void optimizer_update_layer(Optimizer* optimizer, Layer* layer, int layer_index) {
+    if (!optimizer || !layer) return;
 
-    if (!weights || !gradients || weights->size != gradients->size) return;
+    // A new pass over the network restarts the slot cursor
+    if (layer_index == 0) optimizer->slot_cursor = 0;
 
-    // Allocate v if needed
-    if (v_size != weights->size) {
-        free(v);
-        v = (float*)malloc(weights->size * sizeof(float));
-        if (v) {
-            memset(v, 0, weights->size * sizeof(float));
-            v_size = weights->size;
-        }
-    }
+    optimizer_update_layer_params(optimizer, layer);
+}
 
-    if (v) {
-        float beta2 = 0.999f;
-        float epsilon = 1e-8f;
+void optimizer_step(Optimizer* optimizer, Layer** layers, int num_layers) {
+    if (!optimizer || !layers) return;
 
-        for (int i = 0; i < weights->size; i++) {
-            v[i] = beta2 * v[i] + (1.0f - beta2) * gradients->data[i] * gradients->data[i];
-            float adaptive_lr = learning_rate / (sqrtf(v[i]) + epsilon);
-            weights->data[i] -= adaptive_lr * gradients->data[i];
-        }
-    } else {
-        optimizer_sgd_update(weights, gradients, learning_rate, user_data);
+    optimizer->slot_cursor = 0;
+    for (int l = 0; l < num_layers; l++) {
+        if (!layers[l] || !layers[l]->trainable) continue;
+        optimizer_update_layer_params(optimizer, layers[l]);
     }
 }
 
-// ============================================================================
-// Adam Implementation
-// ============================================================================
-
-void optimizer_adam_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
-    // Simplified Adam implementation
-    static float* m = NULL;
-    static float* v = NULL;
-    static int state_size = 0;
-    static int t = 0;
+void optimizer_reset(Optimizer* optimizer) {
+    if (!optimizer) return;
 
-    if (!weights || !gradients || weights->size != gradients->size) return;
+    optimizer->t = 0;
+    optimizer->slot_cursor = 0;
 
-    // Allocate state if needed
-    if (state_size != weights->size) {
-        free(m);
-        free(v);
-        m = (float*)malloc(weights->size * sizeof(float));
-        v = (float*)malloc(weights->size * sizeof(float));
-        if (m && v) {
-            memset(m, 0, weights->size * sizeof(float));
-            memset(v, 0, weights->size * sizeof(float));
-            state_size = weights->size;
-            t = 0;
-        }
+    for (int i = 0; i < optimizer->num_slots; i++) {
+        tensor_zero(optimizer->m[i]);
+        tensor_zero(optimizer->v[i]);
+        optimizer->steps[i] = 0;
     }
+}
 
-    if (m && v) {
-        t++;
-        float beta1 = 0.9f;
-        float beta2 = 0.999f;
-        float epsilon = 1e-8f;
+// ============================================================================
+// Per-tensor Update Functions
+// ============================================================================
 
-        for (int i = 0; i < weights->size; i++) {
-            // Update biased first moment estimate
-            m[i] = beta1 * m[i] + (1.0f - beta1) * gradients->data[i];
+void optimizer_sgd_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
+    optimizer_apply(OPTIMIZER_SGD, weights, gradients, learning_rate,
+                    (OptimizerUpdateState*)user_data);
+}
 
-            // Update biased second moment estimate
-            v[i] = beta2 * v[i] + (1.0f - beta2) * gradients->data[i] * gradients->data[i];
+void optimizer_sgd_momentum_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
+    optimizer_apply(OPTIMIZER_SGD_MOMENTUM, weights, gradients, learning_rate,
+                    (OptimizerUpdateState*)user_data);
+}
 
-            // Compute bias-corrected estimates
-            float m_hat = m[i] / (1.0f - powf(beta1, t));
-            float v_hat = v[i] / (1.0f - powf(beta2, t));
+void optimizer_adagrad_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
+    optimizer_apply(OPTIMIZER_ADAGRAD, weights, gradients, learning_rate,
+                    (OptimizerUpdateState*)user_data);
+}
 
-            // Update parameters
-            weights->data[i] -= learning_rate * m_hat / (sqrtf(v_hat) + epsilon);
-        }
-    } else {
-        optimizer_sgd_update(weights, gradients, learning_rate, user_data);
-    }
+void optimizer_rmsprop_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
+    optimizer_apply(OPTIMIZER_RMSPROP, weights, gradients, learning_rate,
+                    (OptimizerUpdateState*)user_data);
 }
 
-// ============================================================================
-// Adamax and NAdam (Stub Implementations)
-// ============================================================================
+void optimizer_adam_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
+    optimizer_apply(OPTIMIZER_ADAM, weights, gradients, learning_rate,
+                    (OptimizerUpdateState*)user_data);
+}
 
 void optimizer_adamax_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
-    // Placeholder: would implement Adamax
-    optimizer_adam_update(weights, gradients, learning_rate, user_data);
+    // Adam with the second moment replaced by an exponentially weighted infinity norm
+    optimizer_apply(OPTIMIZER_ADAMAX, weights, gradients, learning_rate,
+                    (OptimizerUpdateState*)user_data);
 }
 
 void optimizer_nadam_update(Tensor* weights, Tensor* gradients, float learning_rate, void* user_data) {
-    // Placeholder: would implement NAdam
-    optimizer_adam_update(weights, gradients, learning_rate, user_data);
+    // Adam with a Nesterov look-ahead on the first moment (Dozat, 2016)
+    optimizer_apply(OPTIMIZER_NADAM, weights, gradients, learning_rate,
+                    (OptimizerUpdateState*)user_data);
 }
 
 // ============================================================================
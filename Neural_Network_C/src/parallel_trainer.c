@@ -0,0 +1,429 @@
+/*
+ * Neural Network System - Parallel Trainer Implementation
+ * Data parallelism with per-replica gradient buffers and a chunked
+ * gradient all-reduce before the optimizer step, and the streaming
+ * training loop over a DataLoader
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L     // clock_gettime
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headers/parallel_trainer.h"
+#include "../headers/checkpointing.h"
+#include "../headers/mixed_precision.h"
+#include "../headers/profiler.h"
+#include "../headers/pruning.h"
+#include "../headers/data_loader.h"
+#include "../headers/layers.h"
+#include "../headers/losses.h"
+#include "../headers/gemm.h"
+
+// ============================================================================
+// Replica Setup
+// ============================================================================
+
+/**
+ * @brief Point a replica parameter at the master's storage
+ */
+static bool share_parameter(Tensor* replica, Tensor* master) {
+    if (!replica || !master || replica->size != master->size) return false;
+
+    tensor_alias_data(replica, master->data);
+    return true;
+}
+
+static bool share_network_parameters(NeuralNetwork* replica, NeuralNetwork* master) {
+    if (replica->num_layers != master->num_layers) return false;
+
+    for (int l = 0; l < master->num_layers; l++) {
+        Layer* src = master->layers[l];
+        Layer* dst = replica->layers[l];
+        if (src->num_weights != dst->num_weights || src->num_biases != dst->num_biases) {
+            return false;
+        }
+
+        for (int i = 0; i < src->num_weights; i++) {
+            if (!share_parameter(dst->weights[i], src->weights[i])) return false;
+        }
+        for (int i = 0; i < src->num_biases; i++) {
+            if (!share_parameter(dst->biases[i], src->biases[i])) return false;
+        }
+    }
+
+    replica->loss_function = master->loss_function;
+    replica->optimizer = NULL;
+    replica->compiled = true;
+    return true;
+}
+
+NeuralNetwork* neural_network_replicate(NeuralNetwork* net) {
+    if (!net) return NULL;
+
+    NeuralNetwork* replica = neural_network_copy(net);
+    if (replica && !share_network_parameters(replica, net)) {
+        neural_network_destroy(replica);
+        return NULL;
+    }
+    return replica;
+}
+
+static bool add_reduction(ParallelTrainer* trainer, int* capacity, Tensor* target,
+                          int layer_index, int param_index, bool is_weight) {
+    if (!target) return true;
+
+    if (trainer->num_reductions == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 16;
+        GradientReduction* grown = (GradientReduction*)realloc(trainer->reductions,
+            new_capacity * sizeof(GradientReduction));
+        if (!grown) return false;
+        trainer->reductions = grown;
+        *capacity = new_capacity;
+    }
+
+    GradientReduction* r = &trainer->reductions[trainer->num_reductions];
+    r->target = target;
+    r->sources = (Tensor**)calloc(trainer->num_replicas, sizeof(Tensor*));
+    if (!r->sources) return false;
+
+    for (int t = 1; t < trainer->num_replicas; t++) {
+        Layer* layer = trainer->replicas[t]->layers[layer_index];
+        r->sources[t] = is_weight ? layer->weight_gradients[param_index]
+                                  : layer->bias_gradients[param_index];
+        if (!r->sources[t] || r->sources[t]->size != target->size) {
+            free(r->sources);
+            return false;
+        }
+    }
+
+    r->first_task = trainer->num_reduce_tasks;
+    r->num_tasks = (target->size + PARALLEL_TRAINER_REDUCE_CHUNK - 1) / PARALLEL_TRAINER_REDUCE_CHUNK;
+    trainer->num_reduce_tasks += r->num_tasks;
+    trainer->num_reductions++;
+    return true;
+}
+
+static bool build_reductions(ParallelTrainer* trainer) {
+    NeuralNetwork* net = trainer->master;
+    int capacity = 0;
+
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (!layer->trainable) continue;
+
+        for (int i = 0; i < layer->num_weights && layer->weight_gradients; i++) {
+            if (!add_reduction(trainer, &capacity, layer->weight_gradients[i], l, i, true)) {
+                return false;
+            }
+        }
+        for (int i = 0; i < layer->num_biases && layer->bias_gradients; i++) {
+            if (!add_reduction(trainer, &capacity, layer->bias_gradients[i], l, i, false)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int training_config_get_threads(const TrainingConfig* config) {
+    if (!config || config->num_threads < 0) return 1;
+    return config->num_threads == 0 ? thread_pool_hardware_threads() : config->num_threads;
+}
+
+ParallelTrainer* parallel_trainer_create(NeuralNetwork* net, int num_threads) {
+    if (!net || !net->compiled) return NULL;
+
+    ParallelTrainer* trainer = (ParallelTrainer*)calloc(1, sizeof(ParallelTrainer));
+    if (!trainer) return NULL;
+
+    trainer->master = net;
+    trainer->pool = thread_pool_create(num_threads);
+    if (!trainer->pool) {
+        free(trainer);
+        return NULL;
+    }
+
+    trainer->num_replicas = thread_pool_size(trainer->pool);
+    trainer->replicas = (NeuralNetwork**)calloc(trainer->num_replicas, sizeof(NeuralNetwork*));
+    trainer->shard_loss = (float*)calloc(trainer->num_replicas, sizeof(float));
+    trainer->shard_weight = (float*)calloc(trainer->num_replicas, sizeof(float));
+    trainer->arenas = (TensorArena**)calloc(trainer->num_replicas, sizeof(TensorArena*));
+    if (!trainer->replicas || !trainer->shard_loss || !trainer->shard_weight || !trainer->arenas) {
+        parallel_trainer_destroy(trainer);
+        return NULL;
+    }
+
+    for (int t = 0; t < trainer->num_replicas; t++) {
+        trainer->arenas[t] = tensor_arena_create(0);
+        if (!trainer->arenas[t]) {
+            parallel_trainer_destroy(trainer);
+            return NULL;
+        }
+    }
+
+    trainer->replicas[0] = net;
+    for (int t = 1; t < trainer->num_replicas; t++) {
+        trainer->replicas[t] = neural_network_replicate(net);
+        if (!trainer->replicas[t] ||
+            !neural_network_set_checkpointing(trainer->replicas[t], neural_network_get_checkpointing(net)) ||
+            (net->mixed_precision && !neural_network_share_mixed_precision(trainer->replicas[t], net)) ||
+            (net->profiler && !neural_network_attach_profiler(trainer->replicas[t], net))) {
+            parallel_trainer_destroy(trainer);
+            return NULL;
+        }
+    }
+
+    if (!build_reductions(trainer)) {
+        parallel_trainer_destroy(trainer);
+        return NULL;
+    }
+
+    // Large GEMMs outside the data-parallel region (e.g. evaluation) use the pool too
+    trainer->previous_pool = gemm_set_thread_pool(trainer->pool);
+    trainer->attached = true;
+
+    return trainer;
+}
+
+void parallel_trainer_destroy(ParallelTrainer* trainer) {
+    if (!trainer) return;
+
+    if (trainer->attached) {
+        gemm_set_thread_pool(trainer->previous_pool);
+    }
+
+    for (int i = 0; i < trainer->num_reductions; i++) {
+        free(trainer->reductions[i].sources);
+    }
+    free(trainer->reductions);
+
+    if (trainer->replicas) {
+        // Replica 0 is the caller's network
+        for (int t = 1; t < trainer->num_replicas; t++) {
+            neural_network_destroy(trainer->replicas[t]);
+        }
+        free(trainer->replicas);
+    }
+
+    if (trainer->arenas) {
+        for (int t = 0; t < trainer->num_replicas; t++) {
+            tensor_arena_destroy(trainer->arenas[t]);
+        }
+        free(trainer->arenas);
+    }
+
+    thread_pool_destroy(trainer->pool);
+    free(trainer->shard_loss);
+    free(trainer->shard_weight);
+    free(trainer);
+}
+
+// ============================================================================
+// Training Step
+// ============================================================================
+
+static void shard_rows(int rows, int shards, int shard, int* begin, int* end) {
+    int base = rows / shards;
+    int extra = rows % shards;
+    *begin = shard * base + (shard < extra ? shard : extra);
+    *end = *begin + base + (shard < extra ? 1 : 0);
+}
+
+static Tensor* shard_view(Tensor* batch, int begin, int end) {
+    int shape[8];
+    int ndim = batch->ndim < 8 ? batch->ndim : 8;
+    memcpy(shape, batch->shape, ndim * sizeof(int));
+
+    int row_size = batch->size / batch->shape[0];
+    shape[0] = end - begin;
+    return tensor_create_view(batch->data + (size_t)begin * row_size, shape, ndim);
+}
+
+static void forward_backward_task(void* context, int shard, int thread_id) {
+    ParallelTrainer* trainer = (ParallelTrainer*)context;
+    (void)thread_id;
+
+    // Shard i always runs on replica i, whichever thread picks it up
+    NeuralNetwork* replica = trainer->replicas[shard];
+    int rows = trainer->x_batch->shape[0];
+    int begin, end;
+
+    shard_rows(rows, trainer->num_shards, shard, &begin, &end);
+    if (end <= begin) return;
+
+    // Every temporary of this shard's step lives in the replica's arena
+    TensorArena* previous = tensor_arena_activate(trainer->arenas[shard]);
+
+    Tensor* x = shard_view(trainer->x_batch, begin, end);
+    Tensor* y = shard_view(trainer->y_batch, begin, end);
+
+    if (x && y) {
+        // The forward output is owned by the last layer's output cache
+        bool checkpointed = replica->checkpoint != NULL;
+        Tensor* output = checkpointed ? neural_network_checkpoint_forward(replica, x)
+                                      : neural_network_forward(replica, x);
+        if (output) {
+            for (int l = 0; l < replica->num_layers; l++) {
+                layer_zero_gradients(replica->layers[l]);
+            }
+            Loss* loss = replica->loss_function;
+            if (checkpointed || loss->compute_with_gradient || replica->mixed_precision) {
+                // Fused losses, checkpointed segments and scaled bf16 gradients start
+                // from the loss gradient, scaled by the loss scale replicas share
+                float scale = neural_network_loss_scale(trainer->master);
+                Tensor* grad = tensor_create(NULL, output->shape, output->ndim);
+                trainer->shard_loss[shard] = grad ? loss_compute_with_gradient(loss, output, y, grad) : 0.0f;
+                if (grad && scale != 1.0f) {
+                    for (int i = 0; i < grad->size; i++) grad->data[i] *= scale;
+                }
+                if (grad && checkpointed) {
+                    neural_network_checkpoint_backward(replica, grad);
+                }
+                for (int l = replica->num_layers - 1; grad && !checkpointed && l >= 0; l--) {
+                    Layer* layer = replica->layers[l];
+                    grad = layer->backward ? layer->backward(layer, grad) : grad;
+                }
+            } else {
+                trainer->shard_loss[shard] = loss_compute(loss, output, y);
+                neural_network_backward(replica, output, y);
+            }
+            trainer->shard_weight[shard] = (float)(end - begin) / rows;
+        }
+    }
+
+    tensor_destroy(x);
+    tensor_destroy(y);
+    tensor_arena_activate(previous);
+}
+
+static void reduce_task(void* context, int task, int thread_id) {
+    ParallelTrainer* trainer = (ParallelTrainer*)context;
+    (void)thread_id;
+
+    // Locate the gradient tensor owning this chunk
+    int lo = 0, hi = trainer->num_reductions - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (trainer->reductions[mid].first_task <= task) lo = mid; else hi = mid - 1;
+    }
+
+    GradientReduction* r = &trainer->reductions[lo];
+    int begin = (task - r->first_task) * PARALLEL_TRAINER_REDUCE_CHUNK;
+    int end = begin + PARALLEL_TRAINER_REDUCE_CHUNK;
+    if (end > r->target->size) end = r->target->size;
+
+    float* dst = r->target->data;
+    float w0 = trainer->shard_weight[0];
+    for (int i = begin; i < end; i++) dst[i] *= w0;
+
+    for (int t = 1; t < trainer->num_replicas; t++) {
+        float w = trainer->shard_weight[t];
+        if (w == 0.0f) continue;
+        const float* src = r->sources[t]->data;
+        for (int i = begin; i < end; i++) dst[i] += w * src[i];
+    }
+}
+
+float parallel_trainer_train_step(ParallelTrainer* trainer, Tensor* x_batch, Tensor* y_batch) {
+    if (!trainer || !x_batch || !y_batch || x_batch->ndim < 1 || y_batch->ndim < 1) return 0.0f;
+
+    int rows = x_batch->shape[0];
+    if (rows <= 0 || y_batch->shape[0] != rows) return 0.0f;
+
+    neural_network_profile_step_begin(trainer->master);
+    trainer->x_batch = x_batch;
+    trainer->y_batch = y_batch;
+    trainer->num_shards = rows < trainer->num_replicas ? rows : trainer->num_replicas;
+    for (int t = 0; t < trainer->num_replicas; t++) {
+        trainer->shard_weight[t] = 0.0f;
+        trainer->shard_loss[t] = 0.0f;
+    }
+
+    // One shard per replica; replicas never share gradient buffers
+    thread_pool_parallel_for(trainer->pool, trainer->num_shards, forward_backward_task, trainer);
+
+    thread_pool_parallel_for(trainer->pool, trainer->num_reduce_tasks, reduce_task, trainer);
+
+    // Optimizer state is long-lived, so the update runs with no arena active.
+    // A scaled backward that overflowed skips the update. Pruning masks the
+    // updated weights before the bf16 copies, which every replica reads, are
+    // refreshed from them
+    if (neural_network_unscale_gradients(trainer->master)) {
+        if (trainer->master->profiler) {
+            neural_network_profile_update(trainer->master);
+        } else {
+            neural_network_update(trainer->master);
+        }
+        neural_network_prune_step(trainer->master);
+        neural_network_refresh_mixed_precision(trainer->master);
+    }
+
+    float loss = 0.0f;
+    for (int t = 0; t < trainer->num_replicas; t++) {
+        loss += trainer->shard_weight[t] * trainer->shard_loss[t];
+        tensor_arena_reset(trainer->arenas[t]);
+    }
+    neural_network_profile_step_end(trainer->master);
+    return loss;
+}
+
+// ============================================================================
+// Streaming Training
+// ============================================================================
+
+static double trainer_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+bool neural_network_fit_loader(NeuralNetwork* net, DataLoader* loader, TrainingConfig config) {
+    if (!net || !loader || !net->compiled || config.epochs <= 0) return false;
+
+    ParallelTrainer* trainer = parallel_trainer_create(net, training_config_get_threads(&config));
+    if (!trainer) return false;
+
+    bool ok = true;
+    double start = trainer_now();
+
+    for (int epoch = 0; epoch < config.epochs; epoch++) {
+        data_loader_begin_epoch(loader);
+
+        Tensor* x_batch;
+        Tensor* y_batch;
+        double loss_sum = 0.0;
+        int seen = 0;
+
+        // With prefetch on, the loader assembles batch b+1 while batch b trains
+        while (data_loader_next(loader, &x_batch, &y_batch)) {
+            int rows = x_batch->shape[0];
+            loss_sum += (double)parallel_trainer_train_step(trainer, x_batch, y_batch) * rows;
+            seen += rows;
+        }
+
+        if (data_loader_failed(loader) || seen == 0) {
+            fprintf(stderr, "Training stopped: dataset read failed in epoch %d\n", epoch + 1);
+            ok = false;
+            break;
+        }
+
+        float epoch_loss = (float)(loss_sum / seen);
+        net->current_epoch = epoch + 1;
+        if (config.verbose > 0) {
+            print_training_progress(epoch + 1, config.epochs, epoch_loss, 0.0f, 0.0f, 0.0f);
+        }
+        if (config.early_stopping && neural_network_check_early_stopping(net, epoch_loss)) {
+            break;
+        }
+    }
+
+    net->training_time += trainer_now() - start;
+    net->trained = net->trained || ok;
+    parallel_trainer_destroy(trainer);
+    return ok;
+}
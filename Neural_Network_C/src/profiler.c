@@ -0,0 +1,618 @@
+/*
+ * Neural Network System - Profiler Implementation
+ * Layer forward/backward wrappers and a per-layer update loop feeding
+ * atomic counters and a fixed-size event timeline, Chrome trace export
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L     // clock_gettime
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headers/profiler.h"
+#include "../headers/layers.h"
+#include "../headers/optimizers.h"
+#include "../headers/tensor_arena.h"
+
+#if defined(_MSC_VER)
+#define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILER_THREAD_LOCAL __thread
+#endif
+
+#define PROFILE_ADD(target, value) __atomic_fetch_add(&(target), (value), __ATOMIC_RELAXED)
+#define PROFILE_LOAD(source) __atomic_load_n(&(source), __ATOMIC_RELAXED)
+
+/**
+ * @brief Profiler shared by a network and its replicas
+ */
+typedef struct {
+    int references;                 // Networks recording into this profiler
+    int num_layers;                 // Layers profiled
+    LayerStats* layers;             // Live counters (updated atomically)
+    LayerStats* snapshot;           // Copy handed out by neural_network_get_stats
+
+    ProfileEvent* events;           // Timeline
+    uint64_t capacity;              // Events allocated
+    uint64_t reserved;              // Events claimed (may exceed capacity)
+
+    uint64_t origin_ns;             // Clock value at profiling start
+    int64_t steps;                  // Completed steps
+    uint64_t step_time_ns;          // Total step wall time
+    uint64_t last_step_ns;          // Latest step wall time
+    uint64_t step_start_ns;         // Start of the running step
+} Profiler;
+
+/**
+ * @brief Per-layer wrapper state (layer->profile_data)
+ */
+typedef struct {
+    Profiler* profiler;                         // Where calls are recorded
+    int index;                                  // Layer index
+    Tensor* (*forward)(Layer*, Tensor*);        // Wrapped forward
+    Tensor* (*backward)(Layer*, Tensor*);       // Wrapped backward
+} ProfileHook;
+
+/**
+ * @brief Start of a span: clock and the thread's allocation count
+ */
+typedef struct {
+    uint64_t start_ns;
+    uint64_t allocations;
+} ProfileSpan;
+
+static int profile_next_thread = 0;
+static PROFILER_THREAD_LOCAL int profile_thread = -1;
+
+// ============================================================================
+// Clock and Recording
+// ============================================================================
+
+static uint64_t profile_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int profile_thread_id(void) {
+    if (profile_thread < 0) profile_thread = PROFILE_ADD(profile_next_thread, 1);
+    return profile_thread;
+}
+
+static uint64_t thread_allocations(void) {
+    TensorAllocStats stats;
+    tensor_get_thread_alloc_stats(&stats);
+    return stats.heap_allocations + stats.arena_allocations;
+}
+
+static void span_begin(ProfileSpan* span) {
+    span->allocations = thread_allocations();
+    span->start_ns = profile_now_ns();
+}
+
+static void record_event(Profiler* profiler, int layer, ProfilePhase phase, uint64_t start_ns,
+                         uint64_t duration_ns, uint64_t flops, uint64_t bytes, uint64_t allocations) {
+    uint64_t slot = PROFILE_ADD(profiler->reserved, 1);
+    if (slot >= profiler->capacity) return;
+
+    ProfileEvent* event = &profiler->events[slot];
+    event->layer = layer;
+    event->phase = phase;
+    event->thread = profile_thread_id();
+    event->step = PROFILE_LOAD(profiler->steps);
+    event->start_ns = start_ns >= profiler->origin_ns ? start_ns - profiler->origin_ns : 0;
+    event->duration_ns = duration_ns;
+    event->flops = flops;
+    event->bytes = bytes;
+    event->allocations = allocations;
+}
+
+static void span_end(Profiler* profiler, int layer, ProfilePhase phase, const ProfileSpan* span,
+                     uint64_t flops, uint64_t bytes) {
+    uint64_t duration = profile_now_ns() - span->start_ns;
+    uint64_t allocations = thread_allocations() - span->allocations;
+
+    LayerStats* stats = &profiler->layers[layer];
+    PROFILE_ADD(stats->calls[phase], 1);
+    PROFILE_ADD(stats->time_ns[phase], duration);
+    PROFILE_ADD(stats->flops[phase], flops);
+    PROFILE_ADD(stats->bytes[phase], bytes);
+    PROFILE_ADD(stats->allocations[phase], allocations);
+
+    record_event(profiler, layer, phase, span->start_ns, duration, flops, bytes, allocations);
+}
+
+// ============================================================================
+// Cost Model
+// ============================================================================
+
+static uint64_t parameter_elements(const Layer* layer) {
+    uint64_t count = 0;
+    for (int i = 0; layer->weights && i < layer->num_weights; i++) {
+        if (layer->weights[i]) count += (uint64_t)layer->weights[i]->size;
+    }
+    for (int i = 0; layer->biases && i < layer->num_biases; i++) {
+        if (layer->biases[i]) count += (uint64_t)layer->biases[i]->size;
+    }
+    return count;
+}
+
+static uint64_t tensor_elements(const Tensor* tensor) {
+    return tensor ? (uint64_t)tensor->size : 0;
+}
+
+/**
+ * @brief FLOPs of the layer's main product (2 per multiply-add)
+ *
+ * `input` is the layer input (for recurrent sequence length), `output` the
+ * layer output or the gradient flowing into backward (same shape).
+ * Returns 0 for layers without a product.
+ */
+static uint64_t product_flops(const Layer* layer, const Tensor* input, const Tensor* output) {
+    if (!layer->layer_data || !output) return 0;
+
+    switch (layer->type) {
+        case LAYER_DENSE: {
+            const DenseParams* p = &((const DenseData*)layer->layer_data)->params;
+            if (p->output_size <= 0) return 0;
+            uint64_t rows = (uint64_t)output->size / (uint64_t)p->output_size;
+            return 2ull * rows * (uint64_t)p->input_size * (uint64_t)p->output_size;
+        }
+        case LAYER_CONV2D: {
+            const Conv2DParams* p = &((const Conv2DData*)layer->layer_data)->params;
+            uint64_t window = (uint64_t)p->input_channels * p->kernel_size * p->kernel_size;
+            return 2ull * (uint64_t)output->size * window;
+        }
+        case LAYER_LSTM:
+        case LAYER_GRU: {
+            int input_size, hidden_size, gates;
+            if (layer->type == LAYER_LSTM) {
+                const LSTMParams* p = &((const LSTMData*)layer->layer_data)->params;
+                input_size = p->input_size;
+                hidden_size = p->hidden_size;
+                gates = 4;
+            } else {
+                const GRUParams* p = &((const GRUData*)layer->layer_data)->params;
+                input_size = p->input_size;
+                hidden_size = p->hidden_size;
+                gates = 3;
+            }
+            if (!input || input_size <= 0) return 0;
+            uint64_t row_steps = (uint64_t)input->size / (uint64_t)input_size;
+            return 2ull * row_steps * gates * (uint64_t)hidden_size * (uint64_t)(input_size + hidden_size);
+        }
+        default:
+            return 0;
+    }
+}
+
+static uint64_t forward_flops(const Layer* layer, const Tensor* input, const Tensor* output) {
+    uint64_t flops = product_flops(layer, input, output);
+    if (flops) return flops + tensor_elements(output);   // Bias and activation
+
+    if (layer->type == LAYER_MAXPOOL2D && layer->layer_data && output) {
+        int pool = ((const MaxPoolData*)layer->layer_data)->params.pool_size;
+        return (uint64_t)output->size * pool * pool;
+    }
+    return tensor_elements(input) > tensor_elements(output) ? tensor_elements(input)
+                                                            : tensor_elements(output);
+}
+
+static uint64_t backward_flops(const Layer* layer, const Tensor* grad_output, const Tensor* grad_input) {
+    const Tensor* input = layer->input_cache ? layer->input_cache : grad_input;
+
+    // Weight and input gradients are one product each
+    uint64_t flops = product_flops(layer, input, grad_output);
+    if (flops) return 2 * flops + tensor_elements(grad_output);
+
+    return tensor_elements(grad_input) > tensor_elements(grad_output) ? tensor_elements(grad_input)
+                                                                      : tensor_elements(grad_output);
+}
+
+/**
+ * @brief Optimizer FLOPs per parameter and state tensors it reads and writes
+ */
+static void update_cost(OptimizerType type, uint64_t* flops, uint64_t* states) {
+    switch (type) {
+        case OPTIMIZER_SGD:          *flops = 2;  *states = 0; break;
+        case OPTIMIZER_SGD_MOMENTUM: *flops = 4;  *states = 1; break;
+        case OPTIMIZER_ADAGRAD:      *flops = 6;  *states = 1; break;
+        case OPTIMIZER_RMSPROP:      *flops = 7;  *states = 1; break;
+        case OPTIMIZER_ADAM:         *flops = 12; *states = 2; break;
+        case OPTIMIZER_ADAMAX:       *flops = 10; *states = 2; break;
+        case OPTIMIZER_NADAM:        *flops = 15; *states = 2; break;
+        default:                     *flops = 2;  *states = 0; break;
+    }
+}
+
+// ============================================================================
+// Layer Wrappers
+// ============================================================================
+
+static Tensor* profiled_forward(Layer* layer, Tensor* input) {
+    ProfileHook* hook = (ProfileHook*)layer->profile_data;
+
+    ProfileSpan span;
+    span_begin(&span);
+    Tensor* output = hook->forward(layer, input);
+
+    uint64_t bytes = (tensor_elements(input) + tensor_elements(output) + parameter_elements(layer)) * sizeof(float);
+    span_end(hook->profiler, hook->index, PROFILE_FORWARD, &span,
+             forward_flops(layer, input, output), bytes);
+    return output;
+}
+
+static Tensor* profiled_backward(Layer* layer, Tensor* grad_output) {
+    ProfileHook* hook = (ProfileHook*)layer->profile_data;
+
+    ProfileSpan span;
+    span_begin(&span);
+    Tensor* grad_input = hook->backward(layer, grad_output);
+
+    // Parameters are read, their gradients read and written
+    uint64_t elements = tensor_elements(grad_output) + tensor_elements(grad_input)
+                      + tensor_elements(layer->input_cache) + 3 * parameter_elements(layer);
+    span_end(hook->profiler, hook->index, PROFILE_BACKWARD, &span,
+             backward_flops(layer, grad_output, grad_input), elements * sizeof(float));
+    return grad_input;
+}
+
+static bool wrap_layer(Layer* layer, Profiler* profiler, int index) {
+    ProfileHook* hook = (ProfileHook*)calloc(1, sizeof(ProfileHook));
+    if (!hook) return false;
+
+    hook->profiler = profiler;
+    hook->index = index;
+    hook->forward = layer->forward;
+    hook->backward = layer->backward;
+    layer->profile_data = hook;
+
+    if (layer->forward) layer->forward = profiled_forward;
+    if (layer->backward) layer->backward = profiled_backward;
+    return true;
+}
+
+static void unwrap_layer(Layer* layer) {
+    ProfileHook* hook = (ProfileHook*)layer->profile_data;
+    if (!hook) return;
+
+    // A conversion enabled after profiling may have replaced the wrapper already
+    if (layer->forward == profiled_forward) layer->forward = hook->forward;
+    if (layer->backward == profiled_backward) layer->backward = hook->backward;
+
+    free(hook);
+    layer->profile_data = NULL;
+}
+
+// ============================================================================
+// Network Functions
+// ============================================================================
+
+static void profiler_release(Profiler* profiler) {
+    if (--profiler->references > 0) return;
+
+    free(profiler->layers);
+    free(profiler->snapshot);
+    free(profiler->events);
+    free(profiler);
+}
+
+/**
+ * @brief Point a network's layers at a profiler (takes one reference)
+ */
+static bool attach(NeuralNetwork* net, Profiler* profiler) {
+    net->profiler = profiler;
+    profiler->references++;
+
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (layer && !wrap_layer(layer, profiler, l)) {
+            neural_network_disable_profiling(net);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool neural_network_enable_profiling(NeuralNetwork* net, int max_events) {
+    if (!net) return false;
+    if (net->profiler) return true;
+
+    Profiler* profiler = (Profiler*)calloc(1, sizeof(Profiler));
+    if (!profiler) return false;
+
+    profiler->num_layers = net->num_layers;
+    profiler->capacity = max_events > 0 ? (uint64_t)max_events : PROFILER_DEFAULT_EVENTS;
+    profiler->layers = (LayerStats*)calloc(net->num_layers > 0 ? net->num_layers : 1, sizeof(LayerStats));
+    profiler->snapshot = (LayerStats*)calloc(net->num_layers > 0 ? net->num_layers : 1, sizeof(LayerStats));
+    profiler->events = (ProfileEvent*)malloc(profiler->capacity * sizeof(ProfileEvent));
+    if (!profiler->layers || !profiler->snapshot || !profiler->events) {
+        profiler_release(profiler);
+        return false;
+    }
+
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (!layer) continue;
+        memcpy(profiler->layers[l].name, layer->name, sizeof(profiler->layers[l].name));
+        profiler->layers[l].name[sizeof(profiler->layers[l].name) - 1] = '\0';
+        profiler->layers[l].type = layer->type;
+    }
+    profiler->origin_ns = profile_now_ns();
+
+    return attach(net, profiler);
+}
+
+bool neural_network_attach_profiler(NeuralNetwork* replica, NeuralNetwork* source) {
+    if (!replica || !source || !source->profiler || replica->profiler) return false;
+
+    Profiler* profiler = (Profiler*)source->profiler;
+    if (replica->num_layers != profiler->num_layers) return false;
+    return attach(replica, profiler);
+}
+
+void neural_network_disable_profiling(NeuralNetwork* net) {
+    if (!net || !net->profiler) return;
+
+    for (int l = 0; l < net->num_layers; l++) {
+        if (net->layers[l]) unwrap_layer(net->layers[l]);
+    }
+    profiler_release((Profiler*)net->profiler);
+    net->profiler = NULL;
+}
+
+void neural_network_reset_profile(NeuralNetwork* net) {
+    if (!net || !net->profiler) return;
+
+    Profiler* profiler = (Profiler*)net->profiler;
+    for (int l = 0; l < profiler->num_layers; l++) {
+        LayerStats* stats = &profiler->layers[l];
+        memset(stats->calls, 0, sizeof(stats->calls));
+        memset(stats->time_ns, 0, sizeof(stats->time_ns));
+        memset(stats->flops, 0, sizeof(stats->flops));
+        memset(stats->bytes, 0, sizeof(stats->bytes));
+        memset(stats->allocations, 0, sizeof(stats->allocations));
+    }
+    profiler->reserved = 0;
+    profiler->steps = 0;
+    profiler->step_time_ns = 0;
+    profiler->last_step_ns = 0;
+    profiler->origin_ns = profile_now_ns();
+}
+
+void neural_network_profile_step_begin(NeuralNetwork* net) {
+    if (!net || !net->profiler) return;
+    ((Profiler*)net->profiler)->step_start_ns = profile_now_ns();
+}
+
+void neural_network_profile_step_end(NeuralNetwork* net) {
+    if (!net || !net->profiler) return;
+
+    Profiler* profiler = (Profiler*)net->profiler;
+    uint64_t duration = profile_now_ns() - profiler->step_start_ns;
+    record_event(profiler, -1, PROFILE_STEP, profiler->step_start_ns, duration, 0, 0, 0);
+
+    profiler->step_time_ns += duration;
+    profiler->last_step_ns = duration;
+    PROFILE_ADD(profiler->steps, 1);
+}
+
+void neural_network_profile_update(NeuralNetwork* net) {
+    if (!net || !net->optimizer) return;
+
+    Optimizer* optimizer = net->optimizer;
+    Profiler* profiler = (Profiler*)net->profiler;
+    if (!profiler) {
+        optimizer_step(optimizer, net->layers, net->num_layers);
+        return;
+    }
+
+    uint64_t flops_per_param, states;
+    update_cost(optimizer->type, &flops_per_param, &states);
+
+    // Same walk as optimizer_step, one span per layer
+    optimizer->slot_cursor = 0;
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (!layer || !layer->trainable) continue;
+
+        uint64_t params = parameter_elements(layer);
+        ProfileSpan span;
+        span_begin(&span);
+        optimizer_update_layer(optimizer, layer, l);
+
+        // Parameters read and written, gradients read, each state tensor read and written
+        span_end(profiler, l, PROFILE_UPDATE, &span, params * flops_per_param,
+                 params * (3 + 2 * states) * sizeof(float));
+    }
+}
+
+void neural_network_get_stats(NeuralNetwork* net, void* stats) {
+    NetworkStats* out = (NetworkStats*)stats;
+    if (!out) return;
+
+    memset(out, 0, sizeof(*out));
+    out->slowest_layer = -1;
+    if (!net) return;
+
+    out->num_layers = net->num_layers;
+    out->memory_usage = net->memory_usage;
+    out->training_time = net->training_time;
+    out->parameters_count = net->parameters_count;
+    if (out->parameters_count == 0) {
+        for (int l = 0; l < net->num_layers; l++) {
+            if (net->layers[l]) out->parameters_count += (int)parameter_elements(net->layers[l]);
+        }
+    }
+
+    Profiler* profiler = (Profiler*)net->profiler;
+    if (!profiler) return;
+
+    out->profiling = true;
+    out->steps = PROFILE_LOAD(profiler->steps);
+    out->step_time_ns = profiler->step_time_ns;
+    out->last_step_ns = profiler->last_step_ns;
+    uint64_t reserved = PROFILE_LOAD(profiler->reserved);
+    out->events = reserved < profiler->capacity ? reserved : profiler->capacity;
+    out->dropped_events = reserved - out->events;
+
+    uint64_t slowest = 0;
+    for (int l = 0; l < profiler->num_layers; l++) {
+        const LayerStats* live = &profiler->layers[l];
+        LayerStats* copy = &profiler->snapshot[l];
+        memcpy(copy->name, live->name, sizeof(copy->name));
+        copy->type = live->type;
+
+        uint64_t total = 0;
+        for (int phase = 0; phase < PROFILER_LAYER_PHASES; phase++) {
+            copy->calls[phase] = PROFILE_LOAD(live->calls[phase]);
+            copy->time_ns[phase] = PROFILE_LOAD(live->time_ns[phase]);
+            copy->flops[phase] = PROFILE_LOAD(live->flops[phase]);
+            copy->bytes[phase] = PROFILE_LOAD(live->bytes[phase]);
+            copy->allocations[phase] = PROFILE_LOAD(live->allocations[phase]);
+            total += copy->time_ns[phase];
+        }
+        if (total > slowest) {
+            slowest = total;
+            out->slowest_layer = l;
+        }
+    }
+    out->layers = profiler->snapshot;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static const char* phase_name(ProfilePhase phase) {
+    switch (phase) {
+        case PROFILE_FORWARD:  return "forward";
+        case PROFILE_BACKWARD: return "backward";
+        case PROFILE_UPDATE:   return "update";
+        case PROFILE_STEP:     return "step";
+        default:               return "unknown";
+    }
+}
+
+static void write_json_string(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(file, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(file, "\\u%04x", *c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+bool neural_network_export_trace(const NeuralNetwork* net, const char* filename) {
+    if (!net || !net->profiler || !filename) return false;
+
+    const Profiler* profiler = (const Profiler*)net->profiler;
+    uint64_t reserved = PROFILE_LOAD(profiler->reserved);
+    uint64_t count = reserved < profiler->capacity ? reserved : profiler->capacity;
+
+    FILE* file = fopen(filename, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":");
+    write_json_string(file, net->name[0] ? net->name : "neural_network");
+    fprintf(file, "}}");
+
+    // Name each thread track once
+    int max_thread = -1;
+    for (uint64_t i = 0; i < count; i++) {
+        if (profiler->events[i].thread > max_thread) max_thread = profiler->events[i].thread;
+    }
+    bool* named = max_thread >= 0 ? (bool*)calloc((size_t)max_thread + 1, sizeof(bool)) : NULL;
+    for (uint64_t i = 0; named && i < count; i++) {
+        int thread = profiler->events[i].thread;
+        if (named[thread]) continue;
+        named[thread] = true;
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                      "\"args\":{\"name\":\"thread %d\"}}", thread, thread);
+    }
+    free(named);
+
+    for (uint64_t i = 0; i < count; i++) {
+        const ProfileEvent* event = &profiler->events[i];
+        fprintf(file, ",\n{\"name\":");
+        if (event->phase == PROFILE_STEP) {
+            write_json_string(file, "train_step");
+        } else {
+            write_json_string(file, profiler->layers[event->layer].name);
+        }
+        fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+                      "\"args\":{\"layer\":%d,\"step\":%lld,\"flops\":%llu,\"bytes\":%llu,\"allocations\":%llu}}",
+                phase_name(event->phase), event->thread, event->start_ns / 1000.0, event->duration_ns / 1000.0,
+                event->layer, (long long)event->step, (unsigned long long)event->flops,
+                (unsigned long long)event->bytes, (unsigned long long)event->allocations);
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ok = !ferror(file);
+    if (fclose(file) != 0) ok = false;
+    return ok;
+}
+
+void neural_network_profile_summary(const NeuralNetwork* net, char* out, int max_length) {
+    if (!out || max_length <= 0) return;
+    if (!net || !net->profiler) {
+        snprintf(out, max_length, "Profile: off\n");
+        return;
+    }
+
+    NetworkStats stats;
+    neural_network_get_stats((NeuralNetwork*)net, &stats);
+
+    // Per-step figures once steps are marked, per forward call otherwise (inference)
+    uint64_t grand_total = 0;
+    for (int l = 0; l < stats.num_layers; l++) {
+        for (int phase = 0; phase < PROFILER_LAYER_PHASES; phase++) grand_total += stats.layers[l].time_ns[phase];
+    }
+
+    int written;
+    if (stats.steps > 0) {
+        written = snprintf(out, max_length, "Profile (%lld steps, %.3f ms/step):\n", (long long)stats.steps,
+                           stats.step_time_ns / 1e6 / stats.steps);
+    } else {
+        written = snprintf(out, max_length, "Profile (per forward call):\n");
+    }
+    if (written >= 0 && written < max_length) {
+        written += snprintf(out + written, max_length - written, "  %-20s %9s %9s %9s %7s %9s %8s %8s\n",
+                            "Layer", "Fwd ms", "Bwd ms", "Upd ms", "Share", "GFLOP/s", "GB/s", "Allocs");
+    }
+
+    for (int l = 0; l < stats.num_layers && written >= 0 && written < max_length; l++) {
+        const LayerStats* layer = &stats.layers[l];
+        uint64_t per = stats.steps > 0 ? (uint64_t)stats.steps
+                                       : (layer->calls[PROFILE_FORWARD] ? layer->calls[PROFILE_FORWARD] : 1);
+
+        uint64_t time = 0, flops = 0, bytes = 0, allocations = 0;
+        for (int phase = 0; phase < PROFILER_LAYER_PHASES; phase++) {
+            time += layer->time_ns[phase];
+            flops += layer->flops[phase];
+            bytes += layer->bytes[phase];
+            allocations += layer->allocations[phase];
+        }
+
+        written += snprintf(out + written, max_length - written,
+                            "  %-20.20s %9.3f %9.3f %9.3f %6.1f%% %9.2f %8.2f %8.1f%s\n",
+                            layer->name,
+                            layer->time_ns[PROFILE_FORWARD] / 1e6 / per,
+                            layer->time_ns[PROFILE_BACKWARD] / 1e6 / per,
+                            layer->time_ns[PROFILE_UPDATE] / 1e6 / per,
+                            grand_total ? 100.0 * time / grand_total : 0.0,
+                            time ? (double)flops / time : 0.0,
+                            time ? (double)bytes / time : 0.0,
+                            (double)allocations / per,
+                            l == stats.slowest_layer ? "  <- slowest" : "");
+    }
+}
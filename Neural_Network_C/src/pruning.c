@@ -0,0 +1,476 @@
+/*
+ * Neural Network System - Pruning Implementation
+ * Magnitude masks on a gradual schedule, N:M and block selection, and the
+ * sparse dense-layer forward used after training
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/pruning.h"
+#include "../headers/dense_kernels.h"
+#include "../headers/layers.h"
+
+/**
+ * @brief Mask of one dense layer
+ */
+typedef struct {
+    DenseData* data;                // Layer parameters
+    int rows;                       // Output rows
+    int cols;                       // Input columns
+    uint8_t* mask;                  // 1 = kept (rows x cols)
+} PrunedLayer;
+
+/**
+ * @brief Network pruning state (net->pruning)
+ */
+typedef struct {
+    PruningConfig config;           // Schedule
+    int64_t step;                   // Optimizer updates seen
+    bool masked;                    // Whether any mask removes weights yet
+    int num_layers;                 // Pruned dense layers
+    PrunedLayer* layers;            // One entry per dense layer
+} PruningState;
+
+/**
+ * @brief Sparse inference state attached to a sparsified layer
+ */
+typedef struct {
+    SparseMatrix weights;                       // Compressed weights
+    GemmActivation activation;                  // Epilogue activation
+    bool fused;                                 // Whether the activation runs in the epilogue
+    Tensor* (*dense_forward)(Layer*, Tensor*);  // Forward restored by neural_network_densify
+} SparseLayer;
+
+PruningConfig pruning_config_default(void) {
+    PruningConfig config;
+    config.method = PRUNE_UNSTRUCTURED;
+    config.target_sparsity = 0.8f;
+    config.n = 2;
+    config.m = 4;
+    config.begin_step = 0;
+    config.end_step = 1000;
+    config.frequency = 100;
+    return config;
+}
+
+static float final_sparsity(const PruningConfig* config) {
+    if (config->method == PRUNE_N_M) return 1.0f - (float)config->n / (float)config->m;
+    return config->target_sparsity;
+}
+
+float pruning_schedule_sparsity(const PruningConfig* config, int64_t step) {
+    if (!config || step < config->begin_step) return 0.0f;
+
+    float target = final_sparsity(config);
+    if (step >= config->end_step) return target;
+
+    float progress = (float)(step - config->begin_step) / (float)(config->end_step - config->begin_step);
+    float remaining = 1.0f - progress;
+    return target * (1.0f - remaining * remaining * remaining);
+}
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+static void swap_floats(float* a, float* b) {
+    float t = *a;
+    *a = *b;
+    *b = t;
+}
+
+/**
+ * @brief k-th smallest value (0-based), reordering the array
+ */
+static float select_kth(float* values, size_t count, size_t k) {
+    size_t lo = 0, hi = count - 1;
+    while (lo < hi) {
+        // Median of three as pivot, then Hoare partition
+        size_t mid = lo + (hi - lo) / 2;
+        if (values[mid] < values[lo]) swap_floats(&values[mid], &values[lo]);
+        if (values[hi] < values[lo]) swap_floats(&values[hi], &values[lo]);
+        if (values[hi] < values[mid]) swap_floats(&values[hi], &values[mid]);
+        float pivot = values[mid];
+
+        size_t i = lo, j = hi;
+        while (i <= j) {
+            while (values[i] < pivot) i++;
+            while (values[j] > pivot) j--;
+            if (i <= j) {
+                swap_floats(&values[i], &values[j]);
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
+
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return values[k];
+        }
+    }
+    return values[k];
+}
+
+/**
+ * @brief Mark the `prune` lowest scores as removed (keep[i] = 0)
+ *
+ * Scores below the threshold go first, ties at the threshold in index
+ * order, so exactly `prune` entries are removed.
+ */
+static bool select_lowest(const float* scores, size_t count, size_t prune, uint8_t* keep) {
+    if (prune == 0) {
+        memset(keep, 1, count);
+        return true;
+    }
+    if (prune >= count) {
+        memset(keep, 0, count);
+        return true;
+    }
+
+    float* sorted = (float*)malloc(count * sizeof(float));
+    if (!sorted) return false;
+    memcpy(sorted, scores, count * sizeof(float));
+    float threshold = select_kth(sorted, count, prune - 1);
+    free(sorted);
+
+    size_t removed = 0;
+    for (size_t i = 0; i < count; i++) {
+        keep[i] = scores[i] >= threshold;
+        removed += !keep[i];
+    }
+    for (size_t i = 0; i < count && removed < prune; i++) {
+        if (keep[i] && scores[i] == threshold) {
+            keep[i] = 0;
+            removed++;
+        }
+    }
+    return true;
+}
+
+static bool mask_unstructured(const float* weights, size_t count, float sparsity, uint8_t* mask) {
+    float* scores = (float*)malloc(count * sizeof(float));
+    if (!scores) return false;
+    for (size_t i = 0; i < count; i++) scores[i] = fabsf(weights[i]);
+
+    bool ok = select_lowest(scores, count, (size_t)(sparsity * count + 0.5f), mask);
+    free(scores);
+    return ok;
+}
+
+static void mask_n_m(const float* weights, int rows, int cols, int keep, int m, uint8_t* mask) {
+    for (int r = 0; r < rows; r++) {
+        const float* row = weights + (size_t)r * cols;
+        uint8_t* row_mask = mask + (size_t)r * cols;
+
+        for (int start = 0; start < cols; start += m) {
+            int length = cols - start < m ? cols - start : m;
+            // A short tail group keeps the same share of its weights, rounded up
+            int kept = length == m ? keep : (length * keep + m - 1) / m;
+
+            memset(row_mask + start, 1, length);
+            for (int removed = 0; removed < length - kept; removed++) {
+                int smallest = -1;
+                for (int j = start; j < start + length; j++) {
+                    if (row_mask[j] && (smallest < 0 || fabsf(row[j]) < fabsf(row[smallest]))) smallest = j;
+                }
+                row_mask[smallest] = 0;
+            }
+        }
+    }
+}
+
+static bool mask_blocks(const float* weights, int rows, int cols, float sparsity, uint8_t* mask) {
+    int groups = (rows + SPARSE_BLOCK_ROWS - 1) / SPARSE_BLOCK_ROWS;
+    size_t blocks = (size_t)groups * cols;
+    float* scores = (float*)calloc(blocks, sizeof(float));
+    uint8_t* keep = (uint8_t*)malloc(blocks);
+    if (!scores || !keep) {
+        free(scores);
+        free(keep);
+        return false;
+    }
+
+    for (int r = 0; r < rows; r++) {
+        float* group = scores + (size_t)(r / SPARSE_BLOCK_ROWS) * cols;
+        const float* row = weights + (size_t)r * cols;
+        for (int j = 0; j < cols; j++) group[j] += row[j] * row[j];
+    }
+
+    bool ok = select_lowest(scores, blocks, (size_t)(sparsity * blocks + 0.5f), keep);
+    if (ok) {
+        for (int r = 0; r < rows; r++) {
+            memcpy(mask + (size_t)r * cols, keep + (size_t)(r / SPARSE_BLOCK_ROWS) * cols, cols);
+        }
+    }
+
+    free(scores);
+    free(keep);
+    return ok;
+}
+
+static void apply_mask(float* weights, const uint8_t* mask, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!mask[i]) weights[i] = 0.0f;
+    }
+}
+
+/**
+ * @brief Fill a keep mask for the given method and sparsity
+ */
+static bool compute_mask(const float* weights, int rows, int cols, PruningMethod method, float sparsity,
+                         int n, int m, uint8_t* mask) {
+    size_t count = (size_t)rows * cols;
+    switch (method) {
+        case PRUNE_UNSTRUCTURED:
+            return mask_unstructured(weights, count, sparsity, mask);
+        case PRUNE_N_M: {
+            int keep = m - (int)(sparsity * m + 0.5f);
+            mask_n_m(weights, rows, cols, keep < n ? n : keep, m, mask);
+            return true;
+        }
+        case PRUNE_BLOCK:
+            return mask_blocks(weights, rows, cols, sparsity, mask);
+    }
+    return false;
+}
+
+static bool method_valid(PruningMethod method, int n, int m) {
+    if (method == PRUNE_N_M) return n >= 1 && n <= m && m <= PRUNING_MAX_GROUP;
+    return method == PRUNE_UNSTRUCTURED || method == PRUNE_BLOCK;
+}
+
+bool prune_weights(float* weights, int rows, int cols, PruningMethod method, float sparsity,
+                   int n, int m, uint8_t* mask) {
+    if (!weights || rows <= 0 || cols <= 0 || !(sparsity >= 0.0f && sparsity <= 1.0f) ||
+        !method_valid(method, n, m)) {
+        return false;
+    }
+
+    size_t count = (size_t)rows * cols;
+    uint8_t* keep = mask ? mask : (uint8_t*)malloc(count);
+    if (!keep) return false;
+
+    bool ok = compute_mask(weights, rows, cols, method, sparsity, n, m, keep);
+    if (ok) apply_mask(weights, keep, count);
+
+    if (!mask) free(keep);
+    return ok;
+}
+
+// ============================================================================
+// Training
+// ============================================================================
+
+static DenseData* prunable_dense(const Layer* layer) {
+    if (!layer || layer->type != LAYER_DENSE || !layer->trainable || !layer->layer_data) return NULL;
+
+    DenseData* data = (DenseData*)layer->layer_data;
+    Tensor* w = data->weights;
+    if (!w || w->ndim != 2 || w->shape[0] != data->params.output_size ||
+        w->shape[1] != data->params.input_size) {
+        return NULL;
+    }
+    return data;
+}
+
+void neural_network_disable_pruning(NeuralNetwork* net) {
+    if (!net || !net->pruning) return;
+
+    PruningState* state = (PruningState*)net->pruning;
+    for (int l = 0; l < state->num_layers; l++) free(state->layers[l].mask);
+    free(state->layers);
+    free(state);
+    net->pruning = NULL;
+}
+
+bool neural_network_enable_pruning(NeuralNetwork* net, PruningConfig config) {
+    if (!net || !method_valid(config.method, config.n, config.m) || config.frequency < 1 ||
+        config.end_step < config.begin_step ||
+        !(config.target_sparsity >= 0.0f && config.target_sparsity < 1.0f)) {
+        return false;
+    }
+    neural_network_disable_pruning(net);
+
+    PruningState* state = (PruningState*)calloc(1, sizeof(PruningState));
+    if (!state) return false;
+    state->config = config;
+    net->pruning = state;
+
+    int dense = 0;
+    for (int l = 0; l < net->num_layers; l++) dense += prunable_dense(net->layers[l]) != NULL;
+    state->layers = dense ? (PrunedLayer*)calloc(dense, sizeof(PrunedLayer)) : NULL;
+    if (!state->layers) {
+        neural_network_disable_pruning(net);
+        return false;
+    }
+
+    for (int l = 0; l < net->num_layers; l++) {
+        DenseData* data = prunable_dense(net->layers[l]);
+        if (!data) continue;
+
+        PrunedLayer* pruned = &state->layers[state->num_layers++];
+        pruned->data = data;
+        pruned->rows = data->params.output_size;
+        pruned->cols = data->params.input_size;
+        pruned->mask = (uint8_t*)malloc((size_t)pruned->rows * pruned->cols);
+        if (!pruned->mask) {
+            neural_network_disable_pruning(net);
+            return false;
+        }
+        memset(pruned->mask, 1, (size_t)pruned->rows * pruned->cols);
+    }
+    return true;
+}
+
+bool neural_network_prune_step(NeuralNetwork* net) {
+    if (!net || !net->pruning) return true;
+
+    PruningState* state = (PruningState*)net->pruning;
+    const PruningConfig* config = &state->config;
+    int64_t step = state->step++;
+
+    bool due = step >= config->begin_step && step <= config->end_step &&
+               ((step - config->begin_step) % config->frequency == 0 || step == config->end_step);
+    float sparsity = pruning_schedule_sparsity(config, step);
+
+    if (due && sparsity > 0.0f) {
+        for (int l = 0; l < state->num_layers; l++) {
+            PrunedLayer* pruned = &state->layers[l];
+            if (!compute_mask(pruned->data->weights->data, pruned->rows, pruned->cols, config->method,
+                              sparsity, config->n, config->m, pruned->mask)) {
+                return false;
+            }
+        }
+        state->masked = true;
+    }
+
+    if (state->masked) {
+        for (int l = 0; l < state->num_layers; l++) {
+            PrunedLayer* pruned = &state->layers[l];
+            apply_mask(pruned->data->weights->data, pruned->mask, (size_t)pruned->rows * pruned->cols);
+        }
+    }
+    return true;
+}
+
+int64_t neural_network_pruning_step(const NeuralNetwork* net) {
+    return net && net->pruning ? ((const PruningState*)net->pruning)->step : 0;
+}
+
+float neural_network_sparsity(const NeuralNetwork* net) {
+    if (!net) return 0.0f;
+
+    size_t zeros = 0, total = 0;
+    for (int l = 0; l < net->num_layers; l++) {
+        const Layer* layer = net->layers[l];
+        if (!layer || layer->type != LAYER_DENSE || !layer->layer_data) continue;
+
+        const Tensor* w = ((const DenseData*)layer->layer_data)->weights;
+        if (!w) continue;
+        for (int i = 0; i < w->size; i++) zeros += w->data[i] == 0.0f;
+        total += (size_t)w->size;
+    }
+    return total ? (float)zeros / (float)total : 0.0f;
+}
+
+// ============================================================================
+// Sparse Inference
+// ============================================================================
+
+static Tensor* sparse_dense_forward(Layer* layer, Tensor* input) {
+    SparseLayer* state = (SparseLayer*)layer->sparse_data;
+    DenseData* data = (DenseData*)layer->layer_data;
+    if (!state || !data || !input) return NULL;
+
+    int in_features = state->weights.cols;
+    int out_features = state->weights.rows;
+    if (input->size % in_features != 0) return NULL;
+
+    int batch = input->size / in_features;
+    int shape[2] = { batch, out_features };
+    Tensor* output = (input->ndim == 1) ? tensor_create(NULL, &out_features, 1)
+                                        : tensor_create(NULL, shape, 2);
+    if (!output) return NULL;
+
+    GemmEpilogue epilogue = { data->biases ? data->biases->data : NULL, state->activation, NULL };
+    if (!sparse_matmul(input->data, batch, &state->weights, output->data, out_features, &epilogue)) {
+        tensor_destroy(output);
+        return NULL;
+    }
+
+    // Row-wise activations (softmax) run per sample, as in dense_forward_fused
+    if (!state->fused) {
+        for (int i = 0; i < batch; i++) {
+            data->params.activation(output->data + (size_t)i * out_features, out_features);
+        }
+    }
+    return output;
+}
+
+static void sparse_layer_release(Layer* layer) {
+    SparseLayer* state = (SparseLayer*)layer->sparse_data;
+    layer->forward = state->dense_forward;
+    sparse_matrix_free(&state->weights);
+    free(state);
+    layer->sparse_data = NULL;
+}
+
+void neural_network_densify(NeuralNetwork* net) {
+    if (!net) return;
+    for (int l = 0; l < net->num_layers; l++) {
+        if (net->layers[l] && net->layers[l]->sparse_data) sparse_layer_release(net->layers[l]);
+    }
+}
+
+int neural_network_sparsify(NeuralNetwork* net, float min_sparsity) {
+    if (!net) return -1;
+
+    int converted = 0;
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (!layer || layer->type != LAYER_DENSE || !layer->layer_data) continue;
+
+        // Layers already running another forward keep it
+        if (layer->quantized_data || layer->mixed_precision_data || layer->profile_data) continue;
+
+        DenseData* data = (DenseData*)layer->layer_data;
+        Tensor* w = data->weights;
+        int rows = data->params.output_size;
+        int cols = data->params.input_size;
+        if (!w || w->size != rows * cols || (data->biases && data->biases->size != rows)) continue;
+        if (layer->sparse_data) sparse_layer_release(layer);
+        if (sparse_dense_sparsity(w->data, rows, cols) < min_sparsity) continue;
+
+        SparseLayer* state = (SparseLayer*)calloc(1, sizeof(SparseLayer));
+        SparseFormat format = sparse_block_fill(w->data, rows, cols) >= PRUNING_BLOCKED_MIN_FILL
+                                  ? SPARSE_FORMAT_BLOCKED : SPARSE_FORMAT_CSR;
+        if (!state || !sparse_matrix_from_dense(&state->weights, w->data, rows, cols, format)) {
+            free(state);
+            return -1;
+        }
+
+        state->fused = dense_activation_kind(data->params.activation, &state->activation);
+        if (!state->fused) state->activation = GEMM_ACTIVATION_NONE;
+        state->dense_forward = layer->forward;
+        layer->sparse_data = state;
+        layer->forward = sparse_dense_forward;
+        converted++;
+    }
+    return converted;
+}
+
+size_t neural_network_sparse_bytes(const NeuralNetwork* net) {
+    if (!net) return 0;
+
+    size_t bytes = 0;
+    for (int l = 0; l < net->num_layers; l++) {
+        const Layer* layer = net->layers[l];
+        if (layer && layer->sparse_data) bytes += sparse_matrix_bytes(&((SparseLayer*)layer->sparse_data)->weights);
+    }
+    return bytes;
+}
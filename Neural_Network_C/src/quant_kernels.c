@@ -0,0 +1,930 @@
+/*
+ * Neural Network System - Int8 Kernels Implementation
+ * Calibration ranges, per-channel weight packing, int8 GEMM micro-kernels
+ * (scalar, AVX2, AVX-512 VNNI) and the int8 dense/conv operators
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../headers/quant_kernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QUANT_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define QUANT_THREAD_LOCAL __declspec(thread)
+#else
+#define QUANT_THREAD_LOCAL __thread
+#endif
+
+// ============================================================================
+// Scratch Buffers
+// ============================================================================
+
+static QUANT_THREAD_LOCAL GemmScratch quant_codes_buffer;   // Quantized input batch (conv)
+static QUANT_THREAD_LOCAL GemmScratch quant_tile_buffer;    // uint8 rows of one tile
+static QUANT_THREAD_LOCAL GemmScratch quant_acc_buffer;     // int32 GEMM output of one tile
+static QUANT_THREAD_LOCAL GemmScratch quant_float_buffer;   // Dequantized tile before transpose
+
+static ThreadPool* quant_parallel_pool(long long work) {
+    ThreadPool* pool = gemm_get_thread_pool();
+    if (pool && work >= GEMM_PARALLEL_THRESHOLD && !thread_pool_in_parallel_region()) {
+        return pool;
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Calibration
+// ============================================================================
+
+void quant_range_reset(QuantRange* range) {
+    if (!range) return;
+    range->min = INFINITY;
+    range->max = -INFINITY;
+    range->percentile_min_sum = 0.0;
+    range->percentile_max_sum = 0.0;
+    range->batches = 0;
+}
+
+static int quant_compare_floats(const void* a, const void* b) {
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+void quant_range_observe(QuantRange* range, const float* values, size_t count,
+                         QuantCalibration method, float percentile) {
+    if (!range || !values || count == 0) return;
+
+    float lo = values[0];
+    float hi = values[0];
+    for (size_t i = 1; i < count; i++) {
+        lo = values[i] < lo ? values[i] : lo;
+        hi = values[i] > hi ? values[i] : hi;
+    }
+    range->min = lo < range->min ? lo : range->min;
+    range->max = hi > range->max ? hi : range->max;
+
+    // Percentiles clip rare outliers that would otherwise waste most of the 256 levels
+    if (method == QUANT_CALIBRATION_PERCENTILE) {
+        float* sorted = (float*)malloc(count * sizeof(float));
+        if (sorted) {
+            memcpy(sorted, values, count * sizeof(float));
+            qsort(sorted, count, sizeof(float), quant_compare_floats);
+
+            float p = percentile;
+            p = p < 0.5f ? 0.5f : (p > 1.0f ? 1.0f : p);
+            size_t last = count - 1;
+            lo = sorted[(size_t)((1.0f - p) * last)];
+            hi = sorted[(size_t)(p * last + 0.5f)];
+            free(sorted);
+        }
+    }
+
+    range->percentile_min_sum += lo;
+    range->percentile_max_sum += hi;
+    range->batches++;
+}
+
+bool quant_range_get(const QuantRange* range, QuantCalibration method,
+                     float* min_value, float* max_value) {
+    if (!range || range->batches <= 0) return false;
+
+    float lo = range->min;
+    float hi = range->max;
+    if (method == QUANT_CALIBRATION_PERCENTILE) {
+        lo = (float)(range->percentile_min_sum / range->batches);
+        hi = (float)(range->percentile_max_sum / range->batches);
+    }
+
+    if (min_value) *min_value = lo;
+    if (max_value) *max_value = hi;
+    return true;
+}
+
+// ============================================================================
+// Quantization Primitives
+// ============================================================================
+
+static int quant_panel_count(int rows) {
+    return (rows + QUANT_PANEL_ROWS - 1) / QUANT_PANEL_ROWS;
+}
+
+static size_t quant_panel_bytes(const QuantizedWeights* weights) {
+    return (size_t)weights->padded_cols * QUANT_PANEL_ROWS;
+}
+
+bool quant_weights_init(QuantizedWeights* weights, const float* data, int rows, int cols) {
+    if (!weights) return false;
+    memset(weights, 0, sizeof(*weights));
+    if (!data || rows <= 0 || cols <= 0) return false;
+
+    weights->rows = rows;
+    weights->cols = cols;
+    weights->padded_cols = (cols + QUANT_GROUP - 1) / QUANT_GROUP * QUANT_GROUP;
+
+    size_t panel_bytes = quant_panel_bytes(weights);
+    size_t bytes = (size_t)quant_panel_count(rows) * panel_bytes;
+    weights->raw = malloc(bytes + QUANT_ALIGNMENT);
+    weights->scales = (float*)malloc((size_t)rows * sizeof(float));
+    weights->row_sums = (int32_t*)malloc((size_t)rows * sizeof(int32_t));
+    if (!weights->raw || !weights->scales || !weights->row_sums) {
+        quant_weights_free(weights);
+        return false;
+    }
+
+    uintptr_t addr = (uintptr_t)weights->raw;
+    addr = (addr + QUANT_ALIGNMENT - 1) & ~(uintptr_t)(QUANT_ALIGNMENT - 1);
+    weights->data = (int8_t*)addr;
+
+    // Padding rows and columns stay zero so they never contribute to a dot product
+    memset(weights->data, 0, bytes);
+
+    for (int r = 0; r < rows; r++) {
+        const float* row = data + (size_t)r * cols;
+
+        float absmax = 0.0f;
+        for (int c = 0; c < cols; c++) {
+            float v = fabsf(row[c]);
+            absmax = v > absmax ? v : absmax;
+        }
+
+        // Symmetric [-127, 127]: no zero point, so the kernel needs no weight correction
+        float scale = absmax > 0.0f ? absmax / 127.0f : 1.0f;
+        float inv_scale = 1.0f / scale;
+
+        int8_t* panel = weights->data + (size_t)(r / QUANT_PANEL_ROWS) * panel_bytes;
+        int lane = r % QUANT_PANEL_ROWS;
+        int32_t sum = 0;
+
+        for (int c = 0; c < cols; c++) {
+            long q = lrintf(row[c] * inv_scale);
+            q = q > 127 ? 127 : (q < -127 ? -127 : q);
+            size_t offset = (size_t)(c / QUANT_GROUP) * QUANT_PANEL_ROWS * QUANT_GROUP +
+                            (size_t)lane * QUANT_GROUP + c % QUANT_GROUP;
+            panel[offset] = (int8_t)q;
+            sum += (int32_t)q;
+        }
+
+        weights->scales[r] = scale;
+        weights->row_sums[r] = sum;
+    }
+
+    return true;
+}
+
+void quant_weights_free(QuantizedWeights* weights) {
+    if (!weights) return;
+    free(weights->raw);
+    free(weights->scales);
+    free(weights->row_sums);
+    memset(weights, 0, sizeof(*weights));
+}
+
+void quant_choose_params(float min_value, float max_value, float* scale, int* zero_point) {
+    if (!(min_value < 0.0f)) min_value = 0.0f;
+    if (!(max_value > 0.0f)) max_value = 0.0f;
+
+    float range = max_value - min_value;
+    float s = range > 0.0f ? range / 255.0f : 1.0f;
+    long zp = lrintf(-min_value / s);
+    zp = zp < 0 ? 0 : (zp > 255 ? 255 : zp);
+
+    if (scale) *scale = s;
+    if (zero_point) *zero_point = (int)zp;
+}
+
+#ifdef QUANT_HAVE_X86
+
+static bool quant_has_avx512(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx512f") ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+__attribute__((target("avx512f")))
+static void quant_quantize_avx512(const float* x, uint8_t* q, size_t count,
+                                  float inv_scale, int zero_point) {
+    const __m512 vinv = _mm512_set1_ps(inv_scale);
+    const __m512 vzp = _mm512_set1_ps((float)zero_point);
+    const __m512 lo = _mm512_setzero_ps();
+    const __m512 hi = _mm512_set1_ps(255.0f);
+
+    for (size_t i = 0; i < count; i += 16) {
+        size_t left = count - i;
+        __mmask16 mask = left >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << left) - 1);
+        __m512 v = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, x + i), vinv, vzp);
+        // Clamp before converting: out-of-range floats convert to INT_MIN
+        v = _mm512_min_ps(_mm512_max_ps(v, lo), hi);
+        _mm512_mask_cvtepi32_storeu_epi8(q + i, mask, _mm512_cvtps_epi32(v));
+    }
+}
+
+/**
+ * @brief y = max(v, slope * v) with v = acc * scale + offset, over a rows x cols block
+ *
+ * slope 0 is ReLU, GEMM_LEAKY_RELU_SLOPE leaky ReLU and 1 the identity.
+ */
+__attribute__((target("avx512f")))
+static void quant_dequantize_avx512(const int32_t* acc, int ldacc, const float* scales,
+                                    const float* offsets, float* y, int ldy,
+                                    int rows, int cols, float slope) {
+    const __m512 vslope = _mm512_set1_ps(slope);
+
+    for (int j = 0; j < cols; j += 16) {
+        __mmask16 mask = (cols - j >= 16) ? (__mmask16)0xFFFF
+                                          : (__mmask16)((1u << (cols - j)) - 1);
+        __m512 scale = _mm512_maskz_loadu_ps(mask, scales + j);
+        __m512 offset = _mm512_maskz_loadu_ps(mask, offsets + j);
+
+        for (int r = 0; r < rows; r++) {
+            __m512 a = _mm512_cvtepi32_ps(_mm512_maskz_loadu_epi32(mask, acc + (size_t)r * ldacc + j));
+            __m512 v = _mm512_fmadd_ps(a, scale, offset);
+            _mm512_mask_storeu_ps(y + (size_t)r * ldy + j, mask,
+                                  _mm512_max_ps(v, _mm512_mul_ps(v, vslope)));
+        }
+    }
+}
+
+#endif
+
+void quant_quantize_u8(const float* x, uint8_t* q, size_t count, float scale, int zero_point) {
+    if (!x || !q || count == 0) return;
+    float inv_scale = scale > 0.0f ? 1.0f / scale : 1.0f;
+
+#ifdef QUANT_HAVE_X86
+    if (quant_has_avx512()) {
+        quant_quantize_avx512(x, q, count, inv_scale, zero_point);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < count; i++) {
+        float v = x[i] * inv_scale + (float)zero_point;
+        v = v > 0.0f ? v : 0.0f;
+        v = v < 255.0f ? v : 255.0f;
+        q[i] = (uint8_t)lrintf(v);
+    }
+}
+
+static void quant_dequantize(const int32_t* acc, int ldacc, const float* scales,
+                             const float* offsets, float* y, int ldy,
+                             int rows, int cols, float slope) {
+#ifdef QUANT_HAVE_X86
+    if (quant_has_avx512()) {
+        quant_dequantize_avx512(acc, ldacc, scales, offsets, y, ldy, rows, cols, slope);
+        return;
+    }
+#endif
+
+    for (int r = 0; r < rows; r++) {
+        const int32_t* ar = acc + (size_t)r * ldacc;
+        float* yr = y + (size_t)r * ldy;
+        for (int j = 0; j < cols; j++) {
+            float v = (float)ar[j] * scales[j] + offsets[j];
+            yr[j] = v > slope * v ? v : slope * v;
+        }
+    }
+}
+
+// ============================================================================
+// Int8 GEMM Kernels
+// ============================================================================
+
+/**
+ * @brief Portable kernel, one row of A against one weight panel at a time
+ */
+static void quant_kernel_scalar(int m, const uint8_t* a, int lda,
+                                const QuantizedWeights* weights, int32_t* c, int ldc) {
+    const int groups = weights->padded_cols / QUANT_GROUP;
+    const int panels = quant_panel_count(weights->rows);
+    const size_t panel_bytes = quant_panel_bytes(weights);
+
+    for (int i = 0; i < m; i++) {
+        const uint8_t* arow = a + (size_t)i * lda;
+        int32_t* crow = c + (size_t)i * ldc;
+
+        for (int p = 0; p < panels; p++) {
+            int32_t acc[QUANT_PANEL_ROWS] = { 0 };
+            const int8_t* bp = weights->data + (size_t)p * panel_bytes;
+
+            for (int g = 0; g < groups; g++) {
+                const uint8_t* ag = arow + g * QUANT_GROUP;
+                for (int r = 0; r < QUANT_PANEL_ROWS; r++) {
+                    const int8_t* b = bp + r * QUANT_GROUP;
+                    acc[r] += ag[0] * b[0] + ag[1] * b[1] + ag[2] * b[2] + ag[3] * b[3];
+                }
+                bp += QUANT_PANEL_ROWS * QUANT_GROUP;
+            }
+
+            int col0 = p * QUANT_PANEL_ROWS;
+            int valid = weights->rows - col0 < QUANT_PANEL_ROWS ? weights->rows - col0
+                                                                : QUANT_PANEL_ROWS;
+            for (int r = 0; r < valid; r++) crow[col0 + r] = acc[r];
+        }
+    }
+}
+
+#ifdef QUANT_HAVE_X86
+
+/**
+ * @brief AVX2 panel kernel for two rows of A
+ *
+ * Without VNNI, u8 x s8 products are widened to int16 and summed pairwise
+ * with pmaddwd (vpmaddubsw would saturate at 2 * 255 * 127). Each
+ * accumulator holds two partial sums per channel for four channels; they
+ * are folded with a horizontal add at the end.
+ */
+__attribute__((target("avx2")))
+static void quant_panel_avx2(int groups, const uint8_t* a0, const uint8_t* a1,
+                             const int8_t* bp, int32_t* c0, int32_t* c1, int valid) {
+    __m256i s00 = _mm256_setzero_si256(), s01 = _mm256_setzero_si256();
+    __m256i s02 = _mm256_setzero_si256(), s03 = _mm256_setzero_si256();
+    __m256i s10 = _mm256_setzero_si256(), s11 = _mm256_setzero_si256();
+    __m256i s12 = _mm256_setzero_si256(), s13 = _mm256_setzero_si256();
+
+    for (int g = 0; g < groups; g++) {
+        const int8_t* bg = bp + (size_t)g * QUANT_PANEL_ROWS * QUANT_GROUP;
+        __m256i w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(bg + 0)));
+        __m256i w1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(bg + 16)));
+        __m256i w2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(bg + 32)));
+        __m256i w3 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(bg + 48)));
+
+        int32_t bytes;
+        memcpy(&bytes, a0 + g * QUANT_GROUP, sizeof(bytes));
+        __m256i x = _mm256_cvtepu8_epi16(_mm_set1_epi32(bytes));
+        s00 = _mm256_add_epi32(s00, _mm256_madd_epi16(w0, x));
+        s01 = _mm256_add_epi32(s01, _mm256_madd_epi16(w1, x));
+        s02 = _mm256_add_epi32(s02, _mm256_madd_epi16(w2, x));
+        s03 = _mm256_add_epi32(s03, _mm256_madd_epi16(w3, x));
+
+        memcpy(&bytes, a1 + g * QUANT_GROUP, sizeof(bytes));
+        x = _mm256_cvtepu8_epi16(_mm_set1_epi32(bytes));
+        s10 = _mm256_add_epi32(s10, _mm256_madd_epi16(w0, x));
+        s11 = _mm256_add_epi32(s11, _mm256_madd_epi16(w1, x));
+        s12 = _mm256_add_epi32(s12, _mm256_madd_epi16(w2, x));
+        s13 = _mm256_add_epi32(s13, _mm256_madd_epi16(w3, x));
+    }
+
+    // hadd leaves channels as [0 1 4 5 | 2 3 6 7]; the permute restores order
+    int32_t out[2][QUANT_PANEL_ROWS];
+    _mm256_storeu_si256((__m256i*)out[0], _mm256_permute4x64_epi64(_mm256_hadd_epi32(s00, s01), 0xD8));
+    _mm256_storeu_si256((__m256i*)(out[0] + 8), _mm256_permute4x64_epi64(_mm256_hadd_epi32(s02, s03), 0xD8));
+    _mm256_storeu_si256((__m256i*)out[1], _mm256_permute4x64_epi64(_mm256_hadd_epi32(s10, s11), 0xD8));
+    _mm256_storeu_si256((__m256i*)(out[1] + 8), _mm256_permute4x64_epi64(_mm256_hadd_epi32(s12, s13), 0xD8));
+
+    for (int r = 0; r < valid; r++) c0[r] = out[0][r];
+    if (c1) {
+        for (int r = 0; r < valid; r++) c1[r] = out[1][r];
+    }
+}
+
+static void quant_kernel_avx2(int m, const uint8_t* a, int lda,
+                              const QuantizedWeights* weights, int32_t* c, int ldc) {
+    const int groups = weights->padded_cols / QUANT_GROUP;
+    const int panels = quant_panel_count(weights->rows);
+    const size_t panel_bytes = quant_panel_bytes(weights);
+
+    for (int i = 0; i < m; i += 2) {
+        bool pair = i + 1 < m;
+        const uint8_t* a0 = a + (size_t)i * lda;
+        const uint8_t* a1 = pair ? a0 + lda : a0;
+
+        for (int p = 0; p < panels; p++) {
+            int col0 = p * QUANT_PANEL_ROWS;
+            int valid = weights->rows - col0 < QUANT_PANEL_ROWS ? weights->rows - col0
+                                                                : QUANT_PANEL_ROWS;
+            int32_t* c0 = c + (size_t)i * ldc + col0;
+            quant_panel_avx2(groups, a0, a1, weights->data + (size_t)p * panel_bytes,
+                             c0, pair ? c0 + ldc : NULL, valid);
+        }
+    }
+}
+
+static inline __mmask16 quant_store_mask(int valid) {
+    return valid >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << valid) - 1);
+}
+
+/**
+ * @brief VNNI kernel: 6 rows of A x 2 panels (32 channels)
+ *
+ * One vpdpbusd multiplies four broadcast uint8 inputs by four int8 weights
+ * for each of 16 channels and adds the sums into int32 lanes; valid limits
+ * the stored channels.
+ */
+__attribute__((target("avx512f,avx512vnni")))
+static void quant_vnni_6x32(int groups, const uint8_t* a, int lda,
+                            const int8_t* b0, const int8_t* b1,
+                            int32_t* c, int ldc, int valid) {
+    __m512i c00 = _mm512_setzero_si512(), c01 = _mm512_setzero_si512();
+    __m512i c10 = _mm512_setzero_si512(), c11 = _mm512_setzero_si512();
+    __m512i c20 = _mm512_setzero_si512(), c21 = _mm512_setzero_si512();
+    __m512i c30 = _mm512_setzero_si512(), c31 = _mm512_setzero_si512();
+    __m512i c40 = _mm512_setzero_si512(), c41 = _mm512_setzero_si512();
+    __m512i c50 = _mm512_setzero_si512(), c51 = _mm512_setzero_si512();
+
+    const uint8_t* a0 = a;
+    const uint8_t* a1 = a0 + lda;
+    const uint8_t* a2 = a1 + lda;
+    const uint8_t* a3 = a2 + lda;
+    const uint8_t* a4 = a3 + lda;
+    const uint8_t* a5 = a4 + lda;
+
+    for (int g = 0; g < groups; g++) {
+        __m512i w0 = _mm512_load_si512((const void*)(b0 + (size_t)g * 64));
+        __m512i w1 = _mm512_load_si512((const void*)(b1 + (size_t)g * 64));
+        int32_t bytes;
+        __m512i x;
+
+        memcpy(&bytes, a0 + g * 4, 4); x = _mm512_set1_epi32(bytes);
+        c00 = _mm512_dpbusd_epi32(c00, x, w0); c01 = _mm512_dpbusd_epi32(c01, x, w1);
+        memcpy(&bytes, a1 + g * 4, 4); x = _mm512_set1_epi32(bytes);
+        c10 = _mm512_dpbusd_epi32(c10, x, w0); c11 = _mm512_dpbusd_epi32(c11, x, w1);
+        memcpy(&bytes, a2 + g * 4, 4); x = _mm512_set1_epi32(bytes);
+        c20 = _mm512_dpbusd_epi32(c20, x, w0); c21 = _mm512_dpbusd_epi32(c21, x, w1);
+        memcpy(&bytes, a3 + g * 4, 4); x = _mm512_set1_epi32(bytes);
+        c30 = _mm512_dpbusd_epi32(c30, x, w0); c31 = _mm512_dpbusd_epi32(c31, x, w1);
+        memcpy(&bytes, a4 + g * 4, 4); x = _mm512_set1_epi32(bytes);
+        c40 = _mm512_dpbusd_epi32(c40, x, w0); c41 = _mm512_dpbusd_epi32(c41, x, w1);
+        memcpy(&bytes, a5 + g * 4, 4); x = _mm512_set1_epi32(bytes);
+        c50 = _mm512_dpbusd_epi32(c50, x, w0); c51 = _mm512_dpbusd_epi32(c51, x, w1);
+    }
+
+    __m512i acc[6][2] = {
+        {c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}
+    };
+    __mmask16 m0 = quant_store_mask(valid);
+    __mmask16 m1 = valid > 16 ? quant_store_mask(valid - 16) : 0;
+
+    for (int i = 0; i < 6; i++) {
+        int32_t* row = c + (size_t)i * ldc;
+        _mm512_mask_storeu_epi32(row, m0, acc[i][0]);
+        if (m1) _mm512_mask_storeu_epi32(row + 16, m1, acc[i][1]);
+    }
+}
+
+/**
+ * @brief VNNI kernel: 12 rows of A x 1 panel, for the last odd panel and
+ * layers with 16 or fewer output channels
+ */
+__attribute__((target("avx512f,avx512vnni")))
+static void quant_vnni_12x16(int groups, const uint8_t* a, int lda, const int8_t* b,
+                             int32_t* c, int ldc, int rows, int valid) {
+    // Rows past the end re-read the last row; their sums are never stored
+#define QUANT_ROW_PTR(i) (a + (size_t)((i) < rows ? (i) : rows - 1) * lda)
+    const uint8_t *a0 = QUANT_ROW_PTR(0), *a1 = QUANT_ROW_PTR(1), *a2 = QUANT_ROW_PTR(2);
+    const uint8_t *a3 = QUANT_ROW_PTR(3), *a4 = QUANT_ROW_PTR(4), *a5 = QUANT_ROW_PTR(5);
+    const uint8_t *a6 = QUANT_ROW_PTR(6), *a7 = QUANT_ROW_PTR(7), *a8 = QUANT_ROW_PTR(8);
+    const uint8_t *a9 = QUANT_ROW_PTR(9), *a10 = QUANT_ROW_PTR(10), *a11 = QUANT_ROW_PTR(11);
+#undef QUANT_ROW_PTR
+
+    __m512i c0 = _mm512_setzero_si512(), c1 = _mm512_setzero_si512(), c2 = _mm512_setzero_si512();
+    __m512i c3 = _mm512_setzero_si512(), c4 = _mm512_setzero_si512(), c5 = _mm512_setzero_si512();
+    __m512i c6 = _mm512_setzero_si512(), c7 = _mm512_setzero_si512(), c8 = _mm512_setzero_si512();
+    __m512i c9 = _mm512_setzero_si512(), c10 = _mm512_setzero_si512(), c11 = _mm512_setzero_si512();
+
+    for (int g = 0; g < groups; g++) {
+        __m512i w = _mm512_load_si512((const void*)(b + (size_t)g * 64));
+        int32_t bytes;
+#define QUANT_VNNI_ROW(i) \
+        memcpy(&bytes, a##i + g * 4, 4); \
+        c##i = _mm512_dpbusd_epi32(c##i, _mm512_set1_epi32(bytes), w);
+        QUANT_VNNI_ROW(0) QUANT_VNNI_ROW(1) QUANT_VNNI_ROW(2) QUANT_VNNI_ROW(3)
+        QUANT_VNNI_ROW(4) QUANT_VNNI_ROW(5) QUANT_VNNI_ROW(6) QUANT_VNNI_ROW(7)
+        QUANT_VNNI_ROW(8) QUANT_VNNI_ROW(9) QUANT_VNNI_ROW(10) QUANT_VNNI_ROW(11)
+#undef QUANT_VNNI_ROW
+    }
+
+    __m512i acc[12] = { c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11 };
+    __mmask16 mask = quant_store_mask(valid);
+    for (int i = 0; i < rows; i++) {
+        _mm512_mask_storeu_epi32(c + (size_t)i * ldc, mask, acc[i]);
+    }
+}
+
+/**
+ * @brief VNNI kernel: 1 row of A x up to 4 panels (64 channels)
+ *
+ * Used for leftover rows and single-sample inference, where the weights
+ * stream from memory once and the int8 format cuts that traffic by 4x.
+ */
+__attribute__((target("avx512f,avx512vnni")))
+static void quant_vnni_1x64(int groups, const uint8_t* a, const int8_t* bp, size_t panel_bytes,
+                            int panels, int32_t* c, int valid) {
+    const int8_t* b0 = bp;
+    const int8_t* b1 = panels > 1 ? b0 + panel_bytes : b0;
+    const int8_t* b2 = panels > 2 ? b1 + panel_bytes : b1;
+    const int8_t* b3 = panels > 3 ? b2 + panel_bytes : b2;
+
+    __m512i c0 = _mm512_setzero_si512(), c1 = _mm512_setzero_si512();
+    __m512i c2 = _mm512_setzero_si512(), c3 = _mm512_setzero_si512();
+
+    for (int g = 0; g < groups; g++) {
+        int32_t bytes;
+        memcpy(&bytes, a + g * 4, 4);
+        __m512i x = _mm512_set1_epi32(bytes);
+        size_t offset = (size_t)g * 64;
+        c0 = _mm512_dpbusd_epi32(c0, x, _mm512_load_si512((const void*)(b0 + offset)));
+        c1 = _mm512_dpbusd_epi32(c1, x, _mm512_load_si512((const void*)(b1 + offset)));
+        c2 = _mm512_dpbusd_epi32(c2, x, _mm512_load_si512((const void*)(b2 + offset)));
+        c3 = _mm512_dpbusd_epi32(c3, x, _mm512_load_si512((const void*)(b3 + offset)));
+    }
+
+    __m512i acc[4] = { c0, c1, c2, c3 };
+    for (int p = 0; p < panels && valid > 0; p++, valid -= 16) {
+        _mm512_mask_storeu_epi32(c + p * 16, quant_store_mask(valid), acc[p]);
+    }
+}
+
+static void quant_kernel_avx512_vnni(int m, const uint8_t* a, int lda,
+                                     const QuantizedWeights* weights, int32_t* c, int ldc) {
+    const int groups = weights->padded_cols / QUANT_GROUP;
+    const int panels = quant_panel_count(weights->rows);
+    const size_t panel_bytes = quant_panel_bytes(weights);
+    const int n = weights->rows;
+
+    // Pairs of panels use the 6x32 tile; a trailing single panel the 12x16 one
+    int paired = panels & ~1;
+    int i = 0;
+    for (; i + 6 <= m; i += 6) {
+        for (int p = 0; p < paired; p += 2) {
+            const int8_t* b0 = weights->data + (size_t)p * panel_bytes;
+            int col0 = p * QUANT_PANEL_ROWS;
+            int valid = n - col0 < 2 * QUANT_PANEL_ROWS ? n - col0 : 2 * QUANT_PANEL_ROWS;
+            quant_vnni_6x32(groups, a + (size_t)i * lda, lda, b0, b0 + panel_bytes,
+                            c + (size_t)i * ldc + col0, ldc, valid);
+        }
+    }
+
+    if (paired < panels) {
+        int col0 = paired * QUANT_PANEL_ROWS;
+        const int8_t* b = weights->data + (size_t)paired * panel_bytes;
+        for (int r = 0; r < i; r += 12) {
+            int rows = i - r < 12 ? i - r : 12;
+            quant_vnni_12x16(groups, a + (size_t)r * lda, lda, b, c + (size_t)r * ldc + col0,
+                             ldc, rows, n - col0);
+        }
+    }
+
+    for (; i < m; i++) {
+        for (int p = 0; p < panels; p += 4) {
+            int count = panels - p < 4 ? panels - p : 4;
+            int col0 = p * QUANT_PANEL_ROWS;
+            int valid = n - col0 < 4 * QUANT_PANEL_ROWS ? n - col0 : 4 * QUANT_PANEL_ROWS;
+            quant_vnni_1x64(groups, a + (size_t)i * lda, weights->data + (size_t)p * panel_bytes,
+                            panel_bytes, count, c + (size_t)i * ldc + col0, valid);
+        }
+    }
+}
+
+#endif // QUANT_HAVE_X86
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+typedef void (*QuantKernelFn)(int m, const uint8_t* a, int lda,
+                              const QuantizedWeights* weights, int32_t* c, int ldc);
+
+static int quant_active_kernel = -1;
+
+static bool quant_cpu_supports(QuantKernelType type) {
+    switch (type) {
+        case QUANT_KERNEL_SCALAR:
+            return true;
+#ifdef QUANT_HAVE_X86
+        case QUANT_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case QUANT_KERNEL_AVX512_VNNI:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vnni");
+#endif
+        default:
+            return false;
+    }
+}
+
+QuantKernelType quant_get_kernel(void) {
+    if (quant_active_kernel < 0) {
+        QuantKernelType best = QUANT_KERNEL_SCALAR;
+        if (quant_cpu_supports(QUANT_KERNEL_AVX2)) best = QUANT_KERNEL_AVX2;
+        if (quant_cpu_supports(QUANT_KERNEL_AVX512_VNNI)) best = QUANT_KERNEL_AVX512_VNNI;
+        quant_active_kernel = (int)best;
+    }
+    return (QuantKernelType)quant_active_kernel;
+}
+
+bool quant_set_kernel(QuantKernelType type) {
+    if (!quant_cpu_supports(type)) return false;
+    quant_active_kernel = (int)type;
+    return true;
+}
+
+const char* quant_kernel_name(QuantKernelType type) {
+    switch (type) {
+        case QUANT_KERNEL_SCALAR: return "scalar";
+        case QUANT_KERNEL_AVX2: return "avx2";
+        case QUANT_KERNEL_AVX512_VNNI: return "avx512-vnni";
+        default: return "unknown";
+    }
+}
+
+void quant_gemm_u8s8(int m, const uint8_t* a, int lda, const QuantizedWeights* weights,
+                     int32_t* c, int ldc) {
+    if (m <= 0 || !a || !weights || !weights->data || !c) return;
+
+    QuantKernelFn kernel = quant_kernel_scalar;
+#ifdef QUANT_HAVE_X86
+    switch (quant_get_kernel()) {
+        case QUANT_KERNEL_AVX512_VNNI: kernel = quant_kernel_avx512_vnni; break;
+        case QUANT_KERNEL_AVX2: kernel = quant_kernel_avx2; break;
+        default: break;
+    }
+#endif
+    kernel(m, a, lda, weights, c, ldc);
+}
+
+// ============================================================================
+// Int8 Operators
+// ============================================================================
+
+bool quant_linear_init(QuantizedLinear* linear, const float* weights, int rows, int cols,
+                       const float* biases, float input_min, float input_max,
+                       DenseActivationFn activation) {
+    if (!linear) return false;
+    memset(linear, 0, sizeof(*linear));
+
+    if (!dense_activation_kind(activation, &linear->activation)) {
+        linear->activation = GEMM_ACTIVATION_NONE;
+        linear->row_activation = activation;
+    }
+
+    if (!quant_weights_init(&linear->weights, weights, rows, cols)) return false;
+    quant_choose_params(input_min, input_max, &linear->input_scale, &linear->input_zero_point);
+
+    linear->output_scales = (float*)malloc((size_t)rows * sizeof(float));
+    linear->output_offsets = (float*)malloc((size_t)rows * sizeof(float));
+    if (!linear->output_scales || !linear->output_offsets) {
+        quant_linear_free(linear);
+        return false;
+    }
+
+    // sum_i s_x (q_x - z) s_w q_w = s_x s_w (sum_i q_x q_w - z sum_i q_w)
+    for (int j = 0; j < rows; j++) {
+        double scale = (double)linear->input_scale * linear->weights.scales[j];
+        double correction = (double)linear->input_zero_point * linear->weights.row_sums[j] * scale;
+        linear->output_scales[j] = (float)scale;
+        linear->output_offsets[j] = (float)((biases ? biases[j] : 0.0) - correction);
+    }
+
+    return true;
+}
+
+void quant_linear_free(QuantizedLinear* linear) {
+    if (!linear) return;
+    quant_weights_free(&linear->weights);
+    free(linear->output_scales);
+    free(linear->output_offsets);
+    memset(linear, 0, sizeof(*linear));
+}
+
+size_t quant_linear_bytes(const QuantizedLinear* linear) {
+    if (!linear || !linear->weights.data) return 0;
+    size_t packed = (size_t)linear->weights.rows * linear->weights.padded_cols;
+    return packed + (size_t)linear->weights.rows * 2 * sizeof(float);
+}
+
+/**
+ * @brief Dequantize int32 tile rows, then apply the layer activation
+ */
+static void quant_finish_rows(const QuantizedLinear* linear, const int32_t* acc, int ldacc,
+                              float* out, int ldo, int rows) {
+    int cols = linear->weights.rows;
+    GemmActivation kind = linear->activation;
+
+    // ReLU and leaky ReLU are max(v, slope * v) and fold into the dequantize pass
+    float slope = 1.0f;
+    if (kind == GEMM_ACTIVATION_RELU || kind == GEMM_ACTIVATION_LEAKY_RELU) {
+        slope = (kind == GEMM_ACTIVATION_RELU) ? 0.0f : GEMM_LEAKY_RELU_SLOPE;
+        kind = GEMM_ACTIVATION_NONE;
+    }
+
+    quant_dequantize(acc, ldacc, linear->output_scales, linear->output_offsets,
+                     out, ldo, rows, cols, slope);
+
+    if (kind != GEMM_ACTIVATION_NONE) {
+        GemmEpilogue epilogue = { NULL, kind, NULL };
+        gemm_apply_epilogue(&epilogue, out, ldo, rows, cols, 0, 0);
+    }
+
+    if (linear->row_activation) {
+        for (int r = 0; r < rows; r++) {
+            linear->row_activation(out + (size_t)r * ldo, cols);
+        }
+    }
+}
+
+typedef struct {
+    const QuantizedLinear* linear;
+    const float* input;
+    int batch;
+    float* output;
+} QuantDenseJob;
+
+static void quant_dense_task(void* context, int index, int thread_id) {
+    const QuantDenseJob* job = (const QuantDenseJob*)context;
+    const QuantizedLinear* linear = job->linear;
+    (void)thread_id;
+
+    int row0 = index * QUANT_TILE_ROWS;
+    int rows = job->batch - row0 < QUANT_TILE_ROWS ? job->batch - row0 : QUANT_TILE_ROWS;
+    int cols = linear->weights.cols;
+    int ld = linear->weights.padded_cols;
+    int n = linear->weights.rows;
+
+    uint8_t* codes = (uint8_t*)gemm_scratch_reserve(&quant_tile_buffer, (size_t)rows * ld);
+    int32_t* acc = (int32_t*)gemm_scratch_reserve(&quant_acc_buffer,
+                                                  (size_t)rows * n * sizeof(int32_t));
+    if (!codes || !acc) return;
+
+    for (int r = 0; r < rows; r++) {
+        uint8_t* row = codes + (size_t)r * ld;
+        quant_quantize_u8(job->input + (size_t)(row0 + r) * cols, row, (size_t)cols,
+                          linear->input_scale, linear->input_zero_point);
+        for (int c = cols; c < ld; c++) row[c] = 0;
+    }
+
+    quant_gemm_u8s8(rows, codes, ld, &linear->weights, acc, n);
+    quant_finish_rows(linear, acc, n, job->output + (size_t)row0 * n, n, rows);
+}
+
+bool quant_dense_forward(const QuantizedLinear* linear, const float* input, int batch,
+                         float* output) {
+    if (!linear || !linear->weights.data || !input || !output || batch <= 0) return false;
+
+    QuantDenseJob job = { linear, input, batch, output };
+    int tiles = (batch + QUANT_TILE_ROWS - 1) / QUANT_TILE_ROWS;
+    long long work = (long long)batch * linear->weights.rows * linear->weights.cols;
+    thread_pool_parallel_for(quant_parallel_pool(work), tiles, quant_dense_task, &job);
+    return true;
+}
+
+typedef struct {
+    const QuantizedLinear* linear;
+    const ConvShape* shape;
+    const uint8_t* codes;       // Quantized input batch
+    float* output;
+    int out_width;
+    int pixels;                 // Output pixels per image
+    int tiles;                  // Pixel tiles per image
+} QuantConvJob;
+
+/**
+ * @brief Gather uint8 patches for output pixels [p0, p0 + rows) of one image
+ *
+ * Columns follow the (channel, ky, kx) order of the float kernels; taps in
+ * the padding read the zero point, which dequantizes to exactly 0.0. The
+ * tile is filled one patch column at a time per output row, so the inner
+ * loop is a plain strided copy with the padding ranges split off up front.
+ */
+static void quant_im2col_u8(const ConvShape* shape, const uint8_t* image, int p0, int rows,
+                            int out_width, uint8_t zero, uint8_t* dst, int ld) {
+    const int channels = shape->in_channels;
+    const int height = shape->in_height;
+    const int width = shape->in_width;
+    const int k = shape->kernel_size;
+    const int stride = shape->stride;
+    const int pad = shape->padding;
+    const bool nhwc = shape->layout == CONV_LAYOUT_NHWC;
+    const size_t x_step = nhwc ? (size_t)channels * stride : (size_t)stride;
+    const int depth = channels * k * k;
+
+    for (int r = 0; r < rows; r++) {
+        for (int d = depth; d < ld; d++) dst[(size_t)r * ld + d] = 0;
+    }
+
+    for (int p = p0; p < p0 + rows;) {
+        int oy = p / out_width;
+        int ox_begin = p % out_width;
+        int ox_end = out_width < ox_begin + (p0 + rows - p) ? out_width : ox_begin + (p0 + rows - p);
+        uint8_t* seg = dst + (size_t)(p - p0) * ld;
+
+        for (int c = 0; c < channels; c++) {
+            for (int ky = 0; ky < k; ky++) {
+                int iy = oy * stride - pad + ky;
+                bool row_valid = iy >= 0 && iy < height;
+                const uint8_t* src_row = !row_valid ? NULL
+                                       : nhwc ? image + (size_t)iy * width * channels + c
+                                              : image + ((size_t)c * height + iy) * width;
+
+                for (int kx = 0; kx < k; kx++) {
+                    uint8_t* col = seg + (c * k + ky) * k + kx;
+                    int n = ox_end - ox_begin;
+
+                    if (!row_valid) {
+                        for (int i = 0; i < n; i++) col[(size_t)i * ld] = zero;
+                        continue;
+                    }
+
+                    // Output columns whose tap lands inside the image: 0 <= ox*stride - pad + kx < width
+                    int lo = pad - kx > 0 ? (pad - kx + stride - 1) / stride : 0;
+                    int hi = width - 1 + pad - kx >= 0 ? (width - 1 + pad - kx) / stride + 1 : 0;
+                    lo = lo < ox_begin ? 0 : (lo > ox_end ? n : lo - ox_begin);
+                    hi = hi < ox_begin ? 0 : (hi > ox_end ? n : hi - ox_begin);
+                    if (hi < lo) hi = lo;
+
+                    int i = 0;
+                    for (; i < lo; i++) col[(size_t)i * ld] = zero;
+                    if (i < hi) {
+                        int ix = (ox_begin + i) * stride - pad + kx;
+                        const uint8_t* src = src_row + (size_t)ix * (nhwc ? channels : 1);
+                        for (; i < hi; i++, src += x_step) col[(size_t)i * ld] = *src;
+                    }
+                    for (; i < n; i++) col[(size_t)i * ld] = zero;
+                }
+            }
+        }
+
+        p += ox_end - ox_begin;
+    }
+}
+
+static void quant_conv_task(void* context, int index, int thread_id) {
+    const QuantConvJob* job = (const QuantConvJob*)context;
+    const QuantizedLinear* linear = job->linear;
+    const ConvShape* shape = job->shape;
+    (void)thread_id;
+
+    int image = index / job->tiles;
+    int p0 = (index % job->tiles) * QUANT_TILE_ROWS;
+    int rows = job->pixels - p0 < QUANT_TILE_ROWS ? job->pixels - p0 : QUANT_TILE_ROWS;
+    int ld = linear->weights.padded_cols;
+    int n = linear->weights.rows;
+    size_t image_size = (size_t)shape->in_channels * shape->in_height * shape->in_width;
+    bool nhwc = shape->layout == CONV_LAYOUT_NHWC;
+
+    uint8_t* patches = (uint8_t*)gemm_scratch_reserve(&quant_tile_buffer, (size_t)rows * ld);
+    int32_t* acc = (int32_t*)gemm_scratch_reserve(&quant_acc_buffer,
+                                                  (size_t)rows * n * sizeof(int32_t));
+    float* tile = nhwc ? job->output + ((size_t)image * job->pixels + p0) * n
+                       : (float*)gemm_scratch_reserve(&quant_float_buffer,
+                                                      (size_t)rows * n * sizeof(float));
+    if (!patches || !acc || !tile) return;
+
+    quant_im2col_u8(shape, job->codes + (size_t)image * image_size, p0, rows, job->out_width,
+                    (uint8_t)linear->input_zero_point, patches, ld);
+    quant_gemm_u8s8(rows, patches, ld, &linear->weights, acc, n);
+    quant_finish_rows(linear, acc, n, tile, n, rows);
+
+    // NHWC tiles are already in place; NCHW needs the pixel-major tile transposed
+    if (!nhwc) {
+        float* out = job->output + (size_t)image * n * job->pixels + p0;
+        for (int o = 0; o < n; o++) {
+            float* dst = out + (size_t)o * job->pixels;
+            for (int r = 0; r < rows; r++) dst[r] = tile[(size_t)r * n + o];
+        }
+    }
+}
+
+bool quant_conv2d_forward(const QuantizedLinear* linear, const ConvShape* shape,
+                          const float* input, float* output) {
+    if (!linear || !linear->weights.data || !shape || !input || !output) return false;
+    if (shape->pool_size > 0 || linear->row_activation) return false;
+    if (linear->weights.rows != shape->out_channels ||
+        linear->weights.cols != shape->in_channels * shape->kernel_size * shape->kernel_size) {
+        return false;
+    }
+
+    int out_height, out_width;
+    if (!conv_output_dims(shape, &out_height, &out_width)) return false;
+
+    // Quantize the whole batch once; tiles of all images then share the codes
+    size_t count = (size_t)shape->batch * shape->in_channels * shape->in_height * shape->in_width;
+    uint8_t* codes = (uint8_t*)gemm_scratch_reserve(&quant_codes_buffer, count);
+    if (!codes) return false;
+    quant_quantize_u8(input, codes, count, linear->input_scale, linear->input_zero_point);
+
+    QuantConvJob job;
+    job.linear = linear;
+    job.shape = shape;
+    job.codes = codes;
+    job.output = output;
+    job.out_width = out_width;
+    job.pixels = out_height * out_width;
+    job.tiles = (job.pixels + QUANT_TILE_ROWS - 1) / QUANT_TILE_ROWS;
+
+    long long work = (long long)shape->batch * job.pixels * linear->weights.rows * linear->weights.cols;
+    thread_pool_parallel_for(quant_parallel_pool(work), shape->batch * job.tiles,
+                             quant_conv_task, &job);
+    return true;
+}
@@ -0,0 +1,253 @@
+/*
+ * Neural Network System - Int8 Quantization Implementation
+ * Calibration pass over sample data and int8 forward passes for dense and
+ * Conv2D layers of a copied network
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/quantize.h"
+#include "../headers/tensor_arena.h"
+
+/**
+ * @brief Int8 state attached to a quantized layer
+ */
+typedef struct {
+    QuantizedLinear linear;                     // Int8 operator
+    Tensor* (*float_forward)(Layer*, Tensor*);  // Forward restored on release
+} QuantizedLayer;
+
+QuantizationConfig quantization_config_default(void) {
+    QuantizationConfig config;
+    config.method = QUANT_CALIBRATION_MINMAX;
+    config.percentile = 0.9999f;
+    config.batch_size = 64;
+    config.quantize_conv = true;
+    return config;
+}
+
+// ============================================================================
+// Quantized Layers
+// ============================================================================
+
+static Tensor* quantized_dense_forward(Layer* layer, Tensor* input) {
+    QuantizedLayer* state = (QuantizedLayer*)layer->quantized_data;
+    if (!state || !input) return NULL;
+
+    int in_features = state->linear.weights.cols;
+    int out_features = state->linear.weights.rows;
+    if (input->size % in_features != 0) return NULL;
+
+    int batch = input->size / in_features;
+    int shape[2] = { batch, out_features };
+    Tensor* output = (input->ndim == 1) ? tensor_create(NULL, &out_features, 1)
+                                        : tensor_create(NULL, shape, 2);
+    if (!output) return NULL;
+
+    if (!quant_dense_forward(&state->linear, input->data, batch, output->data)) {
+        tensor_destroy(output);
+        return NULL;
+    }
+    return output;
+}
+
+static Tensor* quantized_conv2d_forward(Layer* layer, Tensor* input) {
+    QuantizedLayer* state = (QuantizedLayer*)layer->quantized_data;
+    Conv2DData* data = (Conv2DData*)layer->layer_data;
+    if (!state || !data || !input || input->ndim < 3) return NULL;
+
+    // Layers run in NCHW: (batch, channels, height, width) or a single (C, H, W) image
+    int batch = input->ndim == 4 ? input->shape[0] : 1;
+    int height = input->shape[input->ndim - 2];
+    int width = input->shape[input->ndim - 1];
+
+    ConvShape shape;
+    if (!conv_shape_init(&shape, &data->params, batch, height, width, CONV_LAYOUT_NCHW)) return NULL;
+    if (input->size != batch * shape.in_channels * height * width) return NULL;
+
+    int out_height, out_width;
+    conv_output_dims(&shape, &out_height, &out_width);
+    int out_shape[4] = { batch, shape.out_channels, out_height, out_width };
+    Tensor* output = (input->ndim == 4) ? tensor_create(NULL, out_shape, 4)
+                                        : tensor_create(NULL, out_shape + 1, 3);
+    if (!output) return NULL;
+
+    if (!quant_conv2d_forward(&state->linear, &shape, input->data, output->data)) {
+        tensor_destroy(output);
+        return NULL;
+    }
+    return output;
+}
+
+bool quantize_layer(Layer* layer, float input_min, float input_max) {
+    if (!layer || layer->quantized_data || !layer->layer_data) return false;
+
+    QuantizedLayer* state = (QuantizedLayer*)calloc(1, sizeof(QuantizedLayer));
+    if (!state) return false;
+
+    bool ok = false;
+    Tensor* (*forward)(Layer*, Tensor*) = NULL;
+
+    if (layer->type == LAYER_DENSE) {
+        DenseData* data = (DenseData*)layer->layer_data;
+        Tensor* w = data->weights;
+        if (w && w->ndim == 2 && (!data->biases || data->biases->size == w->shape[0])) {
+            ok = quant_linear_init(&state->linear, w->data, w->shape[0], w->shape[1],
+                                   data->biases ? data->biases->data : NULL,
+                                   input_min, input_max, data->params.activation);
+            forward = quantized_dense_forward;
+        }
+    } else if (layer->type == LAYER_CONV2D) {
+        Conv2DData* data = (Conv2DData*)layer->layer_data;
+        const Conv2DParams* p = &data->params;
+        int rows = p->output_channels;
+        int cols = p->input_channels * p->kernel_size * p->kernel_size;
+
+        // Row-wise activations have no meaning per output pixel; keep those in float
+        if (data->kernels && data->kernels->size == rows * cols &&
+            (!data->biases || data->biases->size == rows) &&
+            dense_activation_kind(p->activation, NULL)) {
+            ok = quant_linear_init(&state->linear, data->kernels->data, rows, cols,
+                                   data->biases ? data->biases->data : NULL,
+                                   input_min, input_max, p->activation);
+            forward = quantized_conv2d_forward;
+        }
+    }
+
+    if (!ok) {
+        free(state);
+        return false;
+    }
+
+    state->float_forward = layer->forward;
+    layer->quantized_data = state;
+    layer->forward = forward;
+    return true;
+}
+
+void quantize_layer_release(Layer* layer) {
+    if (!layer || !layer->quantized_data) return;
+
+    QuantizedLayer* state = (QuantizedLayer*)layer->quantized_data;
+    layer->forward = state->float_forward;
+    quant_linear_free(&state->linear);
+    free(state);
+    layer->quantized_data = NULL;
+}
+
+// ============================================================================
+// Network Quantization
+// ============================================================================
+
+static bool quant_layer_candidate(const Layer* layer, const QuantizationConfig* config) {
+    if (!layer || !layer->layer_data) return false;
+    if (layer->type == LAYER_DENSE) return true;
+    return layer->type == LAYER_CONV2D && config->quantize_conv;
+}
+
+/**
+ * @brief Run the float network over the calibration set, recording layer input ranges
+ */
+static bool quant_calibrate(NeuralNetwork* net, Tensor* x, const QuantizationConfig* config,
+                            QuantRange* ranges) {
+    int samples = x->shape[0];
+    int sample_size = x->size / samples;
+    int batch_size = config->batch_size > 0 ? config->batch_size : samples;
+
+    int shape[8];
+    int ndim = x->ndim < 8 ? x->ndim : 8;
+    memcpy(shape, x->shape, ndim * sizeof(int));
+
+    // Intermediate activations of each batch are dropped together
+    TensorArena* arena = tensor_arena_create(0);
+    if (!arena) return false;
+    TensorArena* previous = tensor_arena_activate(arena);
+
+    bool ok = true;
+    for (int begin = 0; begin < samples && ok; begin += batch_size) {
+        shape[0] = samples - begin < batch_size ? samples - begin : batch_size;
+        Tensor* activation = tensor_create_view(x->data + (size_t)begin * sample_size, shape, ndim);
+
+        for (int l = 0; l < net->num_layers && activation; l++) {
+            Layer* layer = net->layers[l];
+            if (quant_layer_candidate(layer, config)) {
+                quant_range_observe(&ranges[l], activation->data, (size_t)activation->size,
+                                    config->method, config->percentile);
+            }
+            activation = layer->forward(layer, activation);
+        }
+
+        ok = activation != NULL;
+        tensor_arena_reset(arena);
+    }
+
+    tensor_arena_activate(previous);
+    tensor_arena_destroy(arena);
+    return ok;
+}
+
+NeuralNetwork* neural_network_quantize(NeuralNetwork* net, Tensor* calibration_x,
+                                       QuantizationConfig config) {
+    if (!net || net->num_layers <= 0 || !calibration_x || calibration_x->ndim < 1 ||
+        calibration_x->shape[0] <= 0 || !calibration_x->data) {
+        return NULL;
+    }
+
+    QuantRange* ranges = (QuantRange*)malloc((size_t)net->num_layers * sizeof(QuantRange));
+    if (!ranges) return NULL;
+    for (int l = 0; l < net->num_layers; l++) quant_range_reset(&ranges[l]);
+
+    if (!quant_calibrate(net, calibration_x, &config, ranges)) {
+        fprintf(stderr, "Quantization calibration forward pass failed\n");
+        free(ranges);
+        return NULL;
+    }
+
+    NeuralNetwork* quantized = neural_network_copy(net);
+    if (!quantized) {
+        free(ranges);
+        return NULL;
+    }
+
+    for (int l = 0; l < quantized->num_layers; l++) {
+        float lo, hi;
+        if (quant_range_get(&ranges[l], config.method, &lo, &hi)) {
+            // Layers that cannot be quantized simply keep their float forward
+            quantize_layer(quantized->layers[l], lo, hi);
+        }
+    }
+
+    free(ranges);
+    return quantized;
+}
+
+void neural_network_dequantize(NeuralNetwork* net) {
+    if (!net) return;
+    for (int l = 0; l < net->num_layers; l++) {
+        quantize_layer_release(net->layers[l]);
+    }
+}
+
+size_t neural_network_parameter_bytes(NeuralNetwork* net) {
+    if (!net) return 0;
+
+    size_t bytes = 0;
+    for (int l = 0; l < net->num_layers; l++) {
+        Layer* layer = net->layers[l];
+        if (!layer) continue;
+
+        if (layer->quantized_data) {
+            bytes += quant_linear_bytes(&((QuantizedLayer*)layer->quantized_data)->linear);
+            continue;
+        }
+
+        for (int i = 0; i < layer->num_weights; i++) {
+            if (layer->weights[i]) bytes += (size_t)layer->weights[i]->size * sizeof(float);
+        }
+        for (int i = 0; i < layer->num_biases; i++) {
+            if (layer->biases[i]) bytes += (size_t)layer->biases[i]->size * sizeof(float);
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,601 @@
+/*
+ * Neural Network System - Recurrent Kernels Implementation
+ * Sequence-batched LSTM/GRU forward and truncated BPTT with fused gate passes
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/rnn_kernels.h"
+#include "../headers/gemm.h"
+#include "../headers/vec_math.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RNN_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#define RNN_ROW_GATES 4                 // Gate row width in H units (GRU keeps W_hn h in the 4th)
+#define RNN_TANH_CHUNK 256              // tanh(c) block of the portable LSTM backward
+
+/**
+ * @brief Workspace carve-up shared by the size query and the kernels
+ *
+ * Per-timestep rows are batch-major ([b][t]) so the input projection, the
+ * input gradient and the weight gradients are single GEMMs over all rows,
+ * and each timestep's slice is reached with a row stride of steps.
+ */
+typedef struct {
+    int gates;                  // Gate blocks in the weights (4 or 3)
+    int row;                    // Floats per gate row (4H)
+    float* gate_rows;           // batch x steps x 4H: activated gates, then gate deltas
+    float* hidden;              // batch x (steps + 1) x H: h_0 .. h_T
+    float* cell;                // batch x (steps + 1) x H: c_0 .. c_T (LSTM only)
+    float* recurrent;           // batch x 4H: recurrent projection of one timestep
+    float* grad_hidden;         // batch x H: gradient carried to the previous timestep
+    float* grad_cell;           // batch x H: cell gradient carried back (LSTM only)
+    size_t total;               // Floats in the workspace
+} RnnPlan;
+
+int rnn_gate_count(RnnCell cell) {
+    return cell == RNN_CELL_LSTM ? 4 : 3;
+}
+
+static bool rnn_shape_valid(const RnnShape* shape) {
+    return shape && (shape->cell == RNN_CELL_LSTM || shape->cell == RNN_CELL_GRU) &&
+           shape->batch > 0 && shape->steps > 0 && shape->input_size > 0 &&
+           shape->hidden_size > 0 && shape->bptt_steps >= 0;
+}
+
+/**
+ * @brief Lay out the workspace (base NULL only computes the size)
+ */
+static void rnn_plan(const RnnShape* shape, float* base, RnnPlan* plan) {
+    size_t batch = (size_t)shape->batch;
+    size_t steps = (size_t)shape->steps;
+    size_t hidden = (size_t)shape->hidden_size;
+    bool lstm = shape->cell == RNN_CELL_LSTM;
+    size_t offset = 0;
+
+    plan->gates = rnn_gate_count(shape->cell);
+    plan->row = RNN_ROW_GATES * shape->hidden_size;
+
+    plan->gate_rows = base ? base + offset : NULL;
+    offset += batch * steps * plan->row;
+    plan->hidden = base ? base + offset : NULL;
+    offset += batch * (steps + 1) * hidden;
+    plan->cell = (base && lstm) ? base + offset : NULL;
+    offset += lstm ? batch * (steps + 1) * hidden : 0;
+    plan->recurrent = base ? base + offset : NULL;
+    offset += batch * plan->row;
+    plan->grad_hidden = base ? base + offset : NULL;
+    offset += batch * hidden;
+    plan->grad_cell = (base && lstm) ? base + offset : NULL;
+    offset += lstm ? batch * hidden : 0;
+    plan->total = offset;
+}
+
+size_t rnn_workspace_size(const RnnShape* shape) {
+    if (!rnn_shape_valid(shape)) return 0;
+
+    RnnPlan plan;
+    rnn_plan(shape, NULL, &plan);
+    return plan.total;
+}
+
+static bool rnn_tensors_valid(const RnnShape* shape, const Tensor* input, const Tensor* input_weights,
+                              const Tensor* hidden_weights, const Tensor* biases) {
+    long long gates_h = (long long)rnn_gate_count(shape->cell) * shape->hidden_size;
+
+    return input && input_weights && hidden_weights &&
+           input->size == (long long)shape->batch * shape->steps * shape->input_size &&
+           input_weights->size == gates_h * shape->input_size &&
+           hidden_weights->size == gates_h * shape->hidden_size &&
+           (!biases || biases->size == gates_h);
+}
+
+static int rnn_output_size(const RnnShape* shape, bool return_sequences) {
+    return shape->batch * (return_sequences ? shape->steps : 1) * shape->hidden_size;
+}
+
+// ============================================================================
+// AVX-512 Helpers
+// ============================================================================
+
+#ifdef RNN_HAVE_X86
+
+static inline __mmask16 rnn_lane_mask(int lanes) {
+    return lanes >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << lanes) - 1);
+}
+
+static bool rnn_has_avx512(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx512f") ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+#endif
+
+// ============================================================================
+// Fused Gate Passes
+// ============================================================================
+
+// Each pass handles one batch row of one timestep: gates is that row's
+// 4H gate row, rec its recurrent projection. Forward passes overwrite the
+// pre-activations with the activated gates; backward passes overwrite the
+// activated gates with the pre-activation deltas.
+
+// The portable passes run the nonlinearities block by block through the
+// vec_math array functions (AVX2 where available); the AVX-512 passes below
+// fuse everything into one sweep over the row.
+
+/**
+ * @brief LSTM: i, f, g, o = act(x-projection + rec); c = f c' + i g; h = o tanh(c)
+ */
+static void lstm_forward_row_portable(float* gates, const float* rec, const float* c_prev,
+                                      float* c, float* h, int hidden) {
+    for (int j = 0; j < 4 * hidden; j++) gates[j] += rec[j];
+    vec_math_sigmoid(gates, 2 * hidden);
+    vec_math_tanh(gates + 2 * hidden, hidden);
+    vec_math_sigmoid(gates + 3 * hidden, hidden);
+
+    const float* i = gates;
+    const float* f = gates + hidden;
+    const float* g = gates + 2 * hidden;
+    for (int j = 0; j < hidden; j++) {
+        c[j] = f[j] * c_prev[j] + i[j] * g[j];
+        h[j] = c[j];
+    }
+
+    vec_math_tanh(h, hidden);
+    for (int j = 0; j < hidden; j++) h[j] *= gates[3 * hidden + j];
+}
+
+/**
+ * @brief LSTM deltas from dh (incoming) and dc (carried, updated to dc * f)
+ */
+static void lstm_backward_row_portable(float* gates, const float* c_prev, const float* c,
+                                       const float* dh, float* dc, int hidden) {
+    float tc[RNN_TANH_CHUNK];
+
+    for (int base = 0; base < hidden; base += RNN_TANH_CHUNK) {
+        int count = hidden - base < RNN_TANH_CHUNK ? hidden - base : RNN_TANH_CHUNK;
+        memcpy(tc, c + base, (size_t)count * sizeof(float));
+        vec_math_tanh(tc, count);
+
+        for (int k = 0; k < count; k++) {
+            int j = base + k;
+            float i = gates[j], f = gates[hidden + j], g = gates[2 * hidden + j], o = gates[3 * hidden + j];
+            float dct = dc[j] + dh[j] * o * (1.0f - tc[k] * tc[k]);
+
+            gates[j] = dct * g * i * (1.0f - i);
+            gates[hidden + j] = dct * c_prev[j] * f * (1.0f - f);
+            gates[2 * hidden + j] = dct * i * (1.0f - g * g);
+            gates[3 * hidden + j] = dh[j] * tc[k] * o * (1.0f - o);
+            dc[j] = dct * f;
+        }
+    }
+}
+
+/**
+ * @brief GRU: z, r = sigmoid; n = tanh(x_n + r * (W_hn h')); h = (1 - z) n + z h'
+ *
+ * Saves z, r, n and W_hn h' in the four blocks of the gate row.
+ */
+static void gru_forward_row_portable(float* gates, const float* rec, const float* h_prev,
+                                     float* h, int hidden) {
+    for (int j = 0; j < 2 * hidden; j++) gates[j] += rec[j];
+    vec_math_sigmoid(gates, 2 * hidden);
+
+    for (int j = 0; j < hidden; j++) {
+        float hn = rec[2 * hidden + j];
+        gates[2 * hidden + j] += gates[hidden + j] * hn;
+        gates[3 * hidden + j] = hn;
+    }
+    vec_math_tanh(gates + 2 * hidden, hidden);
+
+    for (int j = 0; j < hidden; j++) {
+        float z = gates[j];
+        h[j] = (1.0f - z) * gates[2 * hidden + j] + z * h_prev[j];
+    }
+}
+
+/**
+ * @brief GRU deltas dz, dr, dn and d(W_hn h'); dh becomes the direct term dh * z
+ */
+static void gru_backward_row_portable(float* gates, const float* h_prev, float* dh, int hidden) {
+    for (int j = 0; j < hidden; j++) {
+        float z = gates[j], r = gates[hidden + j], n = gates[2 * hidden + j], hn = gates[3 * hidden + j];
+        float dn = dh[j] * (1.0f - z) * (1.0f - n * n);
+
+        gates[j] = dh[j] * (h_prev[j] - n) * z * (1.0f - z);
+        gates[hidden + j] = dn * hn * r * (1.0f - r);
+        gates[2 * hidden + j] = dn;
+        gates[3 * hidden + j] = dn * r;
+        dh[j] *= z;
+    }
+}
+
+#ifdef RNN_HAVE_X86
+
+__attribute__((target("avx512f")))
+static void lstm_forward_row_avx512(float* gates, const float* rec, const float* c_prev,
+                                    float* c, float* h, int hidden) {
+    for (int j = 0; j < hidden; j += 16) {
+        __mmask16 m = rnn_lane_mask(hidden - j);
+        float* gi = gates + j;
+        float* gf = gi + hidden;
+        float* gg = gf + hidden;
+        float* go = gg + hidden;
+        const float* ri = rec + j;
+
+        __m512 i = vec_math_sigmoid_zmm(_mm512_add_ps(_mm512_maskz_loadu_ps(m, gi), _mm512_maskz_loadu_ps(m, ri)));
+        __m512 f = vec_math_sigmoid_zmm(_mm512_add_ps(_mm512_maskz_loadu_ps(m, gf),
+                                                 _mm512_maskz_loadu_ps(m, ri + hidden)));
+        __m512 g = vec_math_tanh_zmm(_mm512_add_ps(_mm512_maskz_loadu_ps(m, gg),
+                                              _mm512_maskz_loadu_ps(m, ri + 2 * hidden)));
+        __m512 o = vec_math_sigmoid_zmm(_mm512_add_ps(_mm512_maskz_loadu_ps(m, go),
+                                                 _mm512_maskz_loadu_ps(m, ri + 3 * hidden)));
+        __m512 cell = _mm512_fmadd_ps(f, _mm512_maskz_loadu_ps(m, c_prev + j), _mm512_mul_ps(i, g));
+
+        _mm512_mask_storeu_ps(gi, m, i);
+        _mm512_mask_storeu_ps(gf, m, f);
+        _mm512_mask_storeu_ps(gg, m, g);
+        _mm512_mask_storeu_ps(go, m, o);
+        _mm512_mask_storeu_ps(c + j, m, cell);
+        _mm512_mask_storeu_ps(h + j, m, _mm512_mul_ps(o, vec_math_tanh_zmm(cell)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void lstm_backward_row_avx512(float* gates, const float* c_prev, const float* c,
+                                     const float* dh, float* dc, int hidden) {
+    __m512 one = _mm512_set1_ps(1.0f);
+
+    for (int j = 0; j < hidden; j += 16) {
+        __mmask16 m = rnn_lane_mask(hidden - j);
+        float* gi = gates + j;
+        float* gf = gi + hidden;
+        float* gg = gf + hidden;
+        float* go = gg + hidden;
+
+        __m512 i = _mm512_maskz_loadu_ps(m, gi);
+        __m512 f = _mm512_maskz_loadu_ps(m, gf);
+        __m512 g = _mm512_maskz_loadu_ps(m, gg);
+        __m512 o = _mm512_maskz_loadu_ps(m, go);
+        __m512 d_h = _mm512_maskz_loadu_ps(m, dh + j);
+        __m512 tc = vec_math_tanh_zmm(_mm512_maskz_loadu_ps(m, c + j));
+
+        __m512 dct = _mm512_fmadd_ps(_mm512_mul_ps(d_h, o), _mm512_fnmadd_ps(tc, tc, one),
+                                     _mm512_maskz_loadu_ps(m, dc + j));
+        __m512 di = _mm512_mul_ps(_mm512_mul_ps(dct, g), _mm512_mul_ps(i, _mm512_sub_ps(one, i)));
+        __m512 df = _mm512_mul_ps(_mm512_mul_ps(dct, _mm512_maskz_loadu_ps(m, c_prev + j)),
+                                  _mm512_mul_ps(f, _mm512_sub_ps(one, f)));
+        __m512 dg = _mm512_mul_ps(_mm512_mul_ps(dct, i), _mm512_fnmadd_ps(g, g, one));
+        __m512 d_o = _mm512_mul_ps(_mm512_mul_ps(d_h, tc), _mm512_mul_ps(o, _mm512_sub_ps(one, o)));
+
+        _mm512_mask_storeu_ps(gi, m, di);
+        _mm512_mask_storeu_ps(gf, m, df);
+        _mm512_mask_storeu_ps(gg, m, dg);
+        _mm512_mask_storeu_ps(go, m, d_o);
+        _mm512_mask_storeu_ps(dc + j, m, _mm512_mul_ps(dct, f));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void gru_forward_row_avx512(float* gates, const float* rec, const float* h_prev,
+                                   float* h, int hidden) {
+    __m512 one = _mm512_set1_ps(1.0f);
+
+    for (int j = 0; j < hidden; j += 16) {
+        __mmask16 m = rnn_lane_mask(hidden - j);
+        float* gz = gates + j;
+        float* gr = gz + hidden;
+        float* gn = gr + hidden;
+        const float* rz = rec + j;
+
+        __m512 z = vec_math_sigmoid_zmm(_mm512_add_ps(_mm512_maskz_loadu_ps(m, gz), _mm512_maskz_loadu_ps(m, rz)));
+        __m512 r = vec_math_sigmoid_zmm(_mm512_add_ps(_mm512_maskz_loadu_ps(m, gr),
+                                                 _mm512_maskz_loadu_ps(m, rz + hidden)));
+        __m512 hn = _mm512_maskz_loadu_ps(m, rz + 2 * hidden);
+        __m512 n = vec_math_tanh_zmm(_mm512_fmadd_ps(r, hn, _mm512_maskz_loadu_ps(m, gn)));
+        __m512 hp = _mm512_maskz_loadu_ps(m, h_prev + j);
+
+        _mm512_mask_storeu_ps(gz, m, z);
+        _mm512_mask_storeu_ps(gr, m, r);
+        _mm512_mask_storeu_ps(gn, m, n);
+        _mm512_mask_storeu_ps(gn + hidden, m, hn);
+        _mm512_mask_storeu_ps(h + j, m, _mm512_fmadd_ps(z, hp, _mm512_mul_ps(_mm512_sub_ps(one, z), n)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void gru_backward_row_avx512(float* gates, const float* h_prev, float* dh, int hidden) {
+    __m512 one = _mm512_set1_ps(1.0f);
+
+    for (int j = 0; j < hidden; j += 16) {
+        __mmask16 m = rnn_lane_mask(hidden - j);
+        float* gz = gates + j;
+        float* gr = gz + hidden;
+        float* gn = gr + hidden;
+        float* ghn = gn + hidden;
+
+        __m512 z = _mm512_maskz_loadu_ps(m, gz);
+        __m512 r = _mm512_maskz_loadu_ps(m, gr);
+        __m512 n = _mm512_maskz_loadu_ps(m, gn);
+        __m512 hn = _mm512_maskz_loadu_ps(m, ghn);
+        __m512 d_h = _mm512_maskz_loadu_ps(m, dh + j);
+
+        __m512 dn = _mm512_mul_ps(_mm512_mul_ps(d_h, _mm512_sub_ps(one, z)), _mm512_fnmadd_ps(n, n, one));
+        __m512 dz = _mm512_mul_ps(_mm512_mul_ps(d_h, _mm512_sub_ps(_mm512_maskz_loadu_ps(m, h_prev + j), n)),
+                                  _mm512_mul_ps(z, _mm512_sub_ps(one, z)));
+        __m512 dr = _mm512_mul_ps(_mm512_mul_ps(dn, hn), _mm512_mul_ps(r, _mm512_sub_ps(one, r)));
+
+        _mm512_mask_storeu_ps(gz, m, dz);
+        _mm512_mask_storeu_ps(gr, m, dr);
+        _mm512_mask_storeu_ps(gn, m, dn);
+        _mm512_mask_storeu_ps(ghn, m, _mm512_mul_ps(dn, r));
+        _mm512_mask_storeu_ps(dh + j, m, _mm512_mul_ps(d_h, z));
+    }
+}
+
+#endif
+
+/**
+ * @brief Gate pass implementations chosen once per call
+ */
+typedef struct {
+    void (*lstm_forward)(float*, const float*, const float*, float*, float*, int);
+    void (*lstm_backward)(float*, const float*, const float*, const float*, float*, int);
+    void (*gru_forward)(float*, const float*, const float*, float*, int);
+    void (*gru_backward)(float*, const float*, float*, int);
+} RnnGatePasses;
+
+static RnnGatePasses rnn_gate_passes(void) {
+    RnnGatePasses passes = { lstm_forward_row_portable, lstm_backward_row_portable,
+                             gru_forward_row_portable, gru_backward_row_portable };
+#ifdef RNN_HAVE_X86
+    if (rnn_has_avx512()) {
+        passes.lstm_forward = lstm_forward_row_avx512;
+        passes.lstm_backward = lstm_backward_row_avx512;
+        passes.gru_forward = gru_forward_row_avx512;
+        passes.gru_backward = gru_backward_row_avx512;
+    }
+#endif
+    return passes;
+}
+
+// ============================================================================
+// Forward
+// ============================================================================
+
+bool rnn_forward(const RnnShape* shape, const Tensor* input, const Tensor* input_weights,
+                 const Tensor* hidden_weights, const Tensor* biases,
+                 const float* initial_hidden, const float* initial_cell,
+                 bool return_sequences, Tensor* output, float* workspace) {
+    if (!rnn_shape_valid(shape) || !workspace || !output ||
+        !rnn_tensors_valid(shape, input, input_weights, hidden_weights, biases) ||
+        output->size != rnn_output_size(shape, return_sequences)) {
+        return false;
+    }
+
+    RnnPlan plan;
+    rnn_plan(shape, workspace, &plan);
+    RnnGatePasses passes = rnn_gate_passes();
+
+    int batch = shape->batch, steps = shape->steps, hidden = shape->hidden_size;
+    int gates_h = plan.gates * hidden;
+    size_t state_stride = (size_t)(steps + 1) * hidden;     // One sequence of h (or c)
+    size_t gate_stride = (size_t)steps * plan.row;          // One sequence of gate rows
+    bool lstm = shape->cell == RNN_CELL_LSTM;
+
+    for (int b = 0; b < batch; b++) {
+        float* h0 = plan.hidden + b * state_stride;
+        if (initial_hidden) memcpy(h0, initial_hidden + (size_t)b * hidden, hidden * sizeof(float));
+        else memset(h0, 0, hidden * sizeof(float));
+        if (lstm) {
+            float* c0 = plan.cell + b * state_stride;
+            if (initial_cell) memcpy(c0, initial_cell + (size_t)b * hidden, hidden * sizeof(float));
+            else memset(c0, 0, hidden * sizeof(float));
+        }
+    }
+
+    // Input projection and bias for every timestep at once
+    GemmEpilogue bias = { biases ? biases->data : NULL, GEMM_ACTIVATION_NONE, NULL };
+    if (!gemm_sgemm_epilogue(GEMM_NO_TRANS, GEMM_TRANS, batch * steps, gates_h, shape->input_size, 1.0f,
+                             input->data, shape->input_size, input_weights->data, shape->input_size,
+                             0.0f, plan.gate_rows, plan.row, &bias)) {
+        return false;
+    }
+
+    for (int t = 0; t < steps; t++) {
+        // h_{t-1} of every sequence, strided by one sequence of states
+        if (!gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, batch, gates_h, hidden, 1.0f,
+                        plan.hidden + (size_t)t * hidden, (int)state_stride, hidden_weights->data, hidden,
+                        0.0f, plan.recurrent, plan.row)) {
+            return false;
+        }
+
+        for (int b = 0; b < batch; b++) {
+            float* gates = plan.gate_rows + b * gate_stride + (size_t)t * plan.row;
+            const float* rec = plan.recurrent + (size_t)b * plan.row;
+            float* h_prev = plan.hidden + b * state_stride + (size_t)t * hidden;
+
+            if (lstm) {
+                float* c_prev = plan.cell + b * state_stride + (size_t)t * hidden;
+                passes.lstm_forward(gates, rec, c_prev, c_prev + hidden, h_prev + hidden, hidden);
+            } else {
+                passes.gru_forward(gates, rec, h_prev, h_prev + hidden, hidden);
+            }
+        }
+    }
+
+    for (int b = 0; b < batch; b++) {
+        const float* h = plan.hidden + b * state_stride;
+        if (return_sequences) {
+            memcpy(output->data + (size_t)b * steps * hidden, h + hidden, (size_t)steps * hidden * sizeof(float));
+        } else {
+            memcpy(output->data + (size_t)b * hidden, h + (size_t)steps * hidden, hidden * sizeof(float));
+        }
+    }
+    return true;
+}
+
+void rnn_final_state(const RnnShape* shape, const float* workspace, float* hidden, float* cell) {
+    if (!rnn_shape_valid(shape) || !workspace) return;
+
+    RnnPlan plan;
+    rnn_plan(shape, (float*)workspace, &plan);
+    size_t state_stride = (size_t)(shape->steps + 1) * shape->hidden_size;
+    size_t last = (size_t)shape->steps * shape->hidden_size;
+
+    for (int b = 0; b < shape->batch; b++) {
+        size_t bytes = shape->hidden_size * sizeof(float);
+        if (hidden) memcpy(hidden + (size_t)b * shape->hidden_size, plan.hidden + b * state_stride + last, bytes);
+        if (cell && plan.cell) memcpy(cell + (size_t)b * shape->hidden_size, plan.cell + b * state_stride + last, bytes);
+    }
+}
+
+// ============================================================================
+// Backward
+// ============================================================================
+
+/**
+ * @brief Carry the gradient of timestep t's deltas to h_{t-1}
+ *
+ * LSTM: dh = D_t W_h. GRU: dh (already holding the direct term z * dh)
+ * += [dz dr] W_h[z,r] + d(W_hn h) W_hn, as the n block's recurrent delta
+ * sits in the fourth block of the row.
+ */
+static bool rnn_carry_hidden(const RnnShape* shape, const RnnPlan* plan, const float* hidden_weights, int t) {
+    int batch = shape->batch, hidden = shape->hidden_size;
+    int lda = shape->steps * plan->row;
+    const float* deltas = plan->gate_rows + (size_t)t * plan->row;
+
+    if (shape->cell == RNN_CELL_LSTM) {
+        return gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, batch, hidden, 4 * hidden, 1.0f,
+                          deltas, lda, hidden_weights, hidden, 0.0f, plan->grad_hidden, hidden);
+    }
+    return gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, batch, hidden, 2 * hidden, 1.0f,
+                      deltas, lda, hidden_weights, hidden, 1.0f, plan->grad_hidden, hidden) &&
+           gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, batch, hidden, hidden, 1.0f,
+                      deltas + 3 * hidden, lda, hidden_weights + (size_t)2 * hidden * hidden, hidden,
+                      1.0f, plan->grad_hidden, hidden);
+}
+
+/**
+ * @brief dW_h = sum over timesteps of D_t^T h_{t-1}, one GEMM per sequence
+ */
+static bool rnn_hidden_weight_gradients(const RnnShape* shape, const RnnPlan* plan, float* grad, bool accumulate) {
+    int steps = shape->steps, hidden = shape->hidden_size;
+    size_t state_stride = (size_t)(steps + 1) * hidden;
+    size_t gate_stride = (size_t)steps * plan->row;
+
+    for (int b = 0; b < shape->batch; b++) {
+        const float* deltas = plan->gate_rows + b * gate_stride;
+        const float* h_prev = plan->hidden + b * state_stride;
+        float beta = (accumulate || b > 0) ? 1.0f : 0.0f;
+
+        bool ok;
+        if (shape->cell == RNN_CELL_LSTM) {
+            ok = gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, 4 * hidden, hidden, steps, 1.0f,
+                            deltas, plan->row, h_prev, hidden, beta, grad, hidden);
+        } else {
+            ok = gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, 2 * hidden, hidden, steps, 1.0f,
+                            deltas, plan->row, h_prev, hidden, beta, grad, hidden) &&
+                 gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, hidden, hidden, steps, 1.0f,
+                            deltas + 3 * hidden, plan->row, h_prev, hidden, beta,
+                            grad + (size_t)2 * hidden * hidden, hidden);
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+bool rnn_backward(const RnnShape* shape, const Tensor* input, const Tensor* input_weights,
+                  const Tensor* hidden_weights, const Tensor* grad_output, bool return_sequences,
+                  Tensor* input_weight_gradients, Tensor* hidden_weight_gradients,
+                  Tensor* bias_gradients, Tensor* grad_input, bool accumulate, float* workspace) {
+    if (!rnn_shape_valid(shape) || !workspace || !grad_output ||
+        !input_weight_gradients || !hidden_weight_gradients ||
+        !rnn_tensors_valid(shape, input, input_weights, hidden_weights, bias_gradients) ||
+        grad_output->size != rnn_output_size(shape, return_sequences) ||
+        input_weight_gradients->size != input_weights->size ||
+        hidden_weight_gradients->size != hidden_weights->size ||
+        (grad_input && grad_input->size != input->size)) {
+        return false;
+    }
+
+    RnnPlan plan;
+    rnn_plan(shape, workspace, &plan);
+    RnnGatePasses passes = rnn_gate_passes();
+
+    int batch = shape->batch, steps = shape->steps, hidden = shape->hidden_size;
+    int gates_h = plan.gates * hidden;
+    size_t state_stride = (size_t)(steps + 1) * hidden;
+    size_t gate_stride = (size_t)steps * plan.row;
+    size_t hidden_bytes = (size_t)batch * hidden * sizeof(float);
+    bool lstm = shape->cell == RNN_CELL_LSTM;
+
+    memset(plan.grad_hidden, 0, hidden_bytes);
+    if (lstm) memset(plan.grad_cell, 0, hidden_bytes);
+
+    for (int t = steps - 1; t >= 0; t--) {
+        for (int b = 0; b < batch; b++) {
+            float* dh = plan.grad_hidden + (size_t)b * hidden;
+            const float* g_out = NULL;
+            if (return_sequences) g_out = grad_output->data + ((size_t)b * steps + t) * hidden;
+            else if (t == steps - 1) g_out = grad_output->data + (size_t)b * hidden;
+            if (g_out) {
+                for (int j = 0; j < hidden; j++) dh[j] += g_out[j];
+            }
+
+            float* gates = plan.gate_rows + b * gate_stride + (size_t)t * plan.row;
+            if (lstm) {
+                const float* c_prev = plan.cell + b * state_stride + (size_t)t * hidden;
+                passes.lstm_backward(gates, c_prev, c_prev + hidden, dh,
+                                     plan.grad_cell + (size_t)b * hidden, hidden);
+            } else {
+                passes.gru_backward(gates, plan.hidden + b * state_stride + (size_t)t * hidden, dh, hidden);
+            }
+        }
+
+        // Truncation: nothing flows into the window before this timestep
+        bool window_start = t == 0 || (shape->bptt_steps > 0 && t % shape->bptt_steps == 0);
+        if (window_start) {
+            memset(plan.grad_hidden, 0, hidden_bytes);
+            if (lstm) memset(plan.grad_cell, 0, hidden_bytes);
+        } else if (!rnn_carry_hidden(shape, &plan, hidden_weights->data, t)) {
+            return false;
+        }
+    }
+
+    // Parameter and input gradients over all batch * steps rows at once
+    int rows = batch * steps;
+    float beta = accumulate ? 1.0f : 0.0f;
+    if (!gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, gates_h, shape->input_size, rows, 1.0f,
+                    plan.gate_rows, plan.row, input->data, shape->input_size,
+                    beta, input_weight_gradients->data, shape->input_size) ||
+        !rnn_hidden_weight_gradients(shape, &plan, hidden_weight_gradients->data, accumulate)) {
+        return false;
+    }
+
+    if (bias_gradients) {
+        if (!accumulate) memset(bias_gradients->data, 0, gates_h * sizeof(float));
+        for (int r = 0; r < rows; r++) {
+            const float* deltas = plan.gate_rows + (size_t)r * plan.row;
+            for (int j = 0; j < gates_h; j++) bias_gradients->data[j] += deltas[j];
+        }
+    }
+
+    if (grad_input) {
+        return gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, rows, shape->input_size, gates_h, 1.0f,
+                          plan.gate_rows, plan.row, input_weights->data, shape->input_size,
+                          0.0f, grad_input->data, shape->input_size);
+    }
+    return true;
+}
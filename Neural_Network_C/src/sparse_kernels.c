@@ -0,0 +1,550 @@
+/*
+ * Neural Network System - Sparse Kernels Implementation
+ * Chunk-ordered CSR/blocked compression and the sparse x dense products:
+ * broadcast-FMA over transposed batch tiles, row gathers for small batches
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../headers/sparse_kernels.h"
+#include "../headers/thread_pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SPARSE_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define SPARSE_THREAD_LOCAL __declspec(thread)
+#else
+#define SPARSE_THREAD_LOCAL __thread
+#endif
+
+// ============================================================================
+// Scratch Buffers
+// ============================================================================
+
+static SPARSE_THREAD_LOCAL GemmScratch sparse_x_tile;     // Transposed activations (cols x tile)
+static SPARSE_THREAD_LOCAL GemmScratch sparse_y_tile;     // Transposed outputs (rows x tile)
+
+// ============================================================================
+// Sparse Matrices
+// ============================================================================
+
+static int format_block_rows(SparseFormat format) {
+    return format == SPARSE_FORMAT_BLOCKED ? SPARSE_BLOCK_ROWS : 1;
+}
+
+/**
+ * @brief Whether column j of a row group holds any nonzero (and how many)
+ */
+static int group_column_nonzeros(const float* dense, int rows, int cols, int row0, int block, int j) {
+    int count = 0;
+    for (int r = row0; r < row0 + block && r < rows; r++) {
+        count += dense[(size_t)r * cols + j] != 0.0f;
+    }
+    return count;
+}
+
+bool sparse_matrix_from_dense(SparseMatrix* matrix, const float* dense, int rows, int cols,
+                              SparseFormat format) {
+    if (!matrix) return false;
+    memset(matrix, 0, sizeof(*matrix));
+    if (!dense || rows <= 0 || cols <= 0) return false;
+
+    int block = format_block_rows(format);
+    matrix->format = format;
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->chunks = (cols + SPARSE_CHUNK_COLS - 1) / SPARSE_CHUNK_COLS;
+    matrix->groups = (rows + block - 1) / block;
+
+    size_t slots = (size_t)matrix->chunks * matrix->groups;
+    matrix->group_ptr = (int*)malloc((slots + 1) * sizeof(int));
+    if (!matrix->group_ptr) return false;
+
+    // Count entries per (chunk, group), then fill in the same order
+    int entries = 0;
+    matrix->group_ptr[0] = 0;
+    for (int c = 0; c < matrix->chunks; c++) {
+        int j1 = (c + 1) * SPARSE_CHUNK_COLS < cols ? (c + 1) * SPARSE_CHUNK_COLS : cols;
+        for (int g = 0; g < matrix->groups; g++) {
+            for (int j = c * SPARSE_CHUNK_COLS; j < j1; j++) {
+                int count = group_column_nonzeros(dense, rows, cols, g * block, block, j);
+                entries += count > 0;
+                matrix->nonzeros += count;
+            }
+            matrix->group_ptr[(size_t)c * matrix->groups + g + 1] = entries;
+        }
+    }
+
+    matrix->entries = entries;
+    matrix->col_index = (int*)malloc((entries > 0 ? entries : 1) * sizeof(int));
+    matrix->values = (float*)calloc((size_t)(entries > 0 ? entries : 1) * block, sizeof(float));
+    if (!matrix->col_index || !matrix->values) {
+        sparse_matrix_free(matrix);
+        return false;
+    }
+
+    int e = 0;
+    for (int c = 0; c < matrix->chunks; c++) {
+        int j1 = (c + 1) * SPARSE_CHUNK_COLS < cols ? (c + 1) * SPARSE_CHUNK_COLS : cols;
+        for (int g = 0; g < matrix->groups; g++) {
+            for (int j = c * SPARSE_CHUNK_COLS; j < j1; j++) {
+                if (!group_column_nonzeros(dense, rows, cols, g * block, block, j)) continue;
+                matrix->col_index[e] = j;
+                for (int b = 0; b < block && g * block + b < rows; b++) {
+                    matrix->values[(size_t)e * block + b] = dense[(size_t)(g * block + b) * cols + j];
+                }
+                e++;
+            }
+        }
+    }
+    return true;
+}
+
+void sparse_matrix_free(SparseMatrix* matrix) {
+    if (!matrix) return;
+    free(matrix->group_ptr);
+    free(matrix->col_index);
+    free(matrix->values);
+    memset(matrix, 0, sizeof(*matrix));
+}
+
+size_t sparse_matrix_bytes(const SparseMatrix* matrix) {
+    if (!matrix || !matrix->group_ptr) return 0;
+    size_t slots = (size_t)matrix->chunks * matrix->groups + 1;
+    return slots * sizeof(int) + (size_t)matrix->entries * sizeof(int) +
+           (size_t)matrix->entries * format_block_rows(matrix->format) * sizeof(float);
+}
+
+float sparse_dense_sparsity(const float* dense, int rows, int cols) {
+    if (!dense || rows <= 0 || cols <= 0) return 0.0f;
+    size_t total = (size_t)rows * cols, zeros = 0;
+    for (size_t i = 0; i < total; i++) zeros += dense[i] == 0.0f;
+    return (float)zeros / (float)total;
+}
+
+float sparse_block_fill(const float* dense, int rows, int cols) {
+    if (!dense || rows <= 0 || cols <= 0) return 0.0f;
+
+    size_t stored = 0, nonzeros = 0;
+    for (int r0 = 0; r0 < rows; r0 += SPARSE_BLOCK_ROWS) {
+        for (int j = 0; j < cols; j++) {
+            int count = group_column_nonzeros(dense, rows, cols, r0, SPARSE_BLOCK_ROWS, j);
+            stored += count > 0 ? SPARSE_BLOCK_ROWS : 0;
+            nonzeros += count;
+        }
+    }
+    return stored ? (float)nonzeros / (float)stored : 1.0f;
+}
+
+// ============================================================================
+// Scalar Kernels
+// ============================================================================
+
+/**
+ * @brief One column chunk of a transposed tile: yt (+)= W[:, chunk] * xt[chunk]
+ *
+ * xt is cols x SPARSE_BATCH_TILE, yt is (groups * block rows) x SPARSE_BATCH_TILE;
+ * the first chunk overwrites yt, later chunks accumulate.
+ */
+typedef void (*SparseTileFn)(const SparseMatrix* w, int chunk, const float* xt, float* yt, bool first);
+
+/**
+ * @brief y = W * x for one sample (y has w->rows entries)
+ */
+typedef void (*SparseRowFn)(const SparseMatrix* w, const float* x, float* y);
+
+/**
+ * @brief xt[j][t] = x[t][j] for count samples, zero lanes past count
+ */
+typedef void (*SparseTransposeInFn)(const float* x, int cols, int count, float* xt);
+
+/**
+ * @brief y[t][o] = yt[o][t] for count samples
+ */
+typedef void (*SparseTransposeOutFn)(const float* yt, int rows, int count, float* y, int ldy);
+
+static void sparse_transpose_in_scalar(const float* x, int cols, int count, float* xt) {
+    for (int j = 0; j < cols; j++) {
+        float* lanes = xt + (size_t)j * SPARSE_BATCH_TILE;
+        for (int t = 0; t < count; t++) lanes[t] = x[(size_t)t * cols + j];
+        for (int t = count; t < SPARSE_BATCH_TILE; t++) lanes[t] = 0.0f;
+    }
+}
+
+static void sparse_transpose_out_scalar(const float* yt, int rows, int count, float* y, int ldy) {
+    for (int t = 0; t < count; t++) {
+        float* row = y + (size_t)t * ldy;
+        for (int o = 0; o < rows; o++) row[o] = yt[(size_t)o * SPARSE_BATCH_TILE + t];
+    }
+}
+
+static void sparse_tile_csr_scalar(const SparseMatrix* w, int chunk, const float* xt, float* yt, bool first) {
+    const int* ptr = w->group_ptr + (size_t)chunk * w->groups;
+    for (int g = 0; g < w->groups; g++) {
+        float acc[SPARSE_BATCH_TILE];
+        float* out = yt + (size_t)g * SPARSE_BATCH_TILE;
+        for (int t = 0; t < SPARSE_BATCH_TILE; t++) acc[t] = first ? 0.0f : out[t];
+
+        for (int e = ptr[g]; e < ptr[g + 1]; e++) {
+            float v = w->values[e];
+            const float* x = xt + (size_t)w->col_index[e] * SPARSE_BATCH_TILE;
+            for (int t = 0; t < SPARSE_BATCH_TILE; t++) acc[t] += v * x[t];
+        }
+        memcpy(out, acc, sizeof(acc));
+    }
+}
+
+static void sparse_tile_blocked_scalar(const SparseMatrix* w, int chunk, const float* xt, float* yt, bool first) {
+    const int* ptr = w->group_ptr + (size_t)chunk * w->groups;
+    for (int g = 0; g < w->groups; g++) {
+        float acc[SPARSE_BLOCK_ROWS][SPARSE_BATCH_TILE];
+        float* out = yt + (size_t)g * SPARSE_BLOCK_ROWS * SPARSE_BATCH_TILE;
+        if (first) {
+            memset(acc, 0, sizeof(acc));
+        } else {
+            memcpy(acc, out, sizeof(acc));
+        }
+
+        for (int e = ptr[g]; e < ptr[g + 1]; e++) {
+            const float* v = w->values + (size_t)e * SPARSE_BLOCK_ROWS;
+            const float* x = xt + (size_t)w->col_index[e] * SPARSE_BATCH_TILE;
+            for (int b = 0; b < SPARSE_BLOCK_ROWS; b++) {
+                for (int t = 0; t < SPARSE_BATCH_TILE; t++) acc[b][t] += v[b] * x[t];
+            }
+        }
+        memcpy(out, acc, sizeof(acc));
+    }
+}
+
+static void sparse_row_csr_scalar(const SparseMatrix* w, const float* x, float* y) {
+    memset(y, 0, (size_t)w->rows * sizeof(float));
+    for (int c = 0; c < w->chunks; c++) {
+        const int* ptr = w->group_ptr + (size_t)c * w->groups;
+        for (int g = 0; g < w->groups; g++) {
+            float sum = 0.0f;
+            for (int e = ptr[g]; e < ptr[g + 1]; e++) sum += w->values[e] * x[w->col_index[e]];
+            y[g] += sum;
+        }
+    }
+}
+
+static void sparse_row_blocked_scalar(const SparseMatrix* w, const float* x, float* y) {
+    memset(y, 0, (size_t)w->rows * sizeof(float));
+    for (int c = 0; c < w->chunks; c++) {
+        const int* ptr = w->group_ptr + (size_t)c * w->groups;
+        for (int g = 0; g < w->groups; g++) {
+            float sum[SPARSE_BLOCK_ROWS] = { 0.0f };
+            for (int e = ptr[g]; e < ptr[g + 1]; e++) {
+                const float* v = w->values + (size_t)e * SPARSE_BLOCK_ROWS;
+                float xv = x[w->col_index[e]];
+                for (int b = 0; b < SPARSE_BLOCK_ROWS; b++) sum[b] += v[b] * xv;
+            }
+            for (int b = 0; b < SPARSE_BLOCK_ROWS && g * SPARSE_BLOCK_ROWS + b < w->rows; b++) {
+                y[g * SPARSE_BLOCK_ROWS + b] += sum[b];
+            }
+        }
+    }
+}
+
+// ============================================================================
+// AVX-512 Kernels
+// ============================================================================
+
+#ifdef SPARSE_HAVE_X86
+
+static int sparse_cpu_avx512 = -1;
+
+static bool sparse_has_avx512(void) {
+    if (sparse_cpu_avx512 < 0) {
+        __builtin_cpu_init();
+        sparse_cpu_avx512 = __builtin_cpu_supports("avx512f") ? 1 : 0;
+    }
+    return sparse_cpu_avx512 == 1;
+}
+
+/**
+ * @brief CSR tile: four independent accumulator pairs hide the FMA latency
+ */
+__attribute__((target("avx512f")))
+static void sparse_tile_csr_avx512(const SparseMatrix* w, int chunk, const float* xt, float* yt, bool first) {
+    const int* ptr = w->group_ptr + (size_t)chunk * w->groups;
+    const int* cols = w->col_index;
+    const float* values = w->values;
+
+    for (int g = 0; g < w->groups; g++) {
+        float* out = yt + (size_t)g * SPARSE_BATCH_TILE;
+        __m512 a0 = first ? _mm512_setzero_ps() : _mm512_load_ps(out);
+        __m512 a1 = first ? _mm512_setzero_ps() : _mm512_load_ps(out + 16);
+        __m512 b0 = _mm512_setzero_ps(), b1 = _mm512_setzero_ps();
+        __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps();
+        __m512 d0 = _mm512_setzero_ps(), d1 = _mm512_setzero_ps();
+
+        int e = ptr[g], end = ptr[g + 1];
+        for (; e + 4 <= end; e += 4) {
+            const float* x0 = xt + (size_t)cols[e] * SPARSE_BATCH_TILE;
+            const float* x1 = xt + (size_t)cols[e + 1] * SPARSE_BATCH_TILE;
+            const float* x2 = xt + (size_t)cols[e + 2] * SPARSE_BATCH_TILE;
+            const float* x3 = xt + (size_t)cols[e + 3] * SPARSE_BATCH_TILE;
+            __m512 v0 = _mm512_set1_ps(values[e]);
+            __m512 v1 = _mm512_set1_ps(values[e + 1]);
+            __m512 v2 = _mm512_set1_ps(values[e + 2]);
+            __m512 v3 = _mm512_set1_ps(values[e + 3]);
+            a0 = _mm512_fmadd_ps(v0, _mm512_load_ps(x0), a0);
+            a1 = _mm512_fmadd_ps(v0, _mm512_load_ps(x0 + 16), a1);
+            b0 = _mm512_fmadd_ps(v1, _mm512_load_ps(x1), b0);
+            b1 = _mm512_fmadd_ps(v1, _mm512_load_ps(x1 + 16), b1);
+            c0 = _mm512_fmadd_ps(v2, _mm512_load_ps(x2), c0);
+            c1 = _mm512_fmadd_ps(v2, _mm512_load_ps(x2 + 16), c1);
+            d0 = _mm512_fmadd_ps(v3, _mm512_load_ps(x3), d0);
+            d1 = _mm512_fmadd_ps(v3, _mm512_load_ps(x3 + 16), d1);
+        }
+        for (; e < end; e++) {
+            const float* x0 = xt + (size_t)cols[e] * SPARSE_BATCH_TILE;
+            __m512 v0 = _mm512_set1_ps(values[e]);
+            a0 = _mm512_fmadd_ps(v0, _mm512_load_ps(x0), a0);
+            a1 = _mm512_fmadd_ps(v0, _mm512_load_ps(x0 + 16), a1);
+        }
+
+        a0 = _mm512_add_ps(_mm512_add_ps(a0, b0), _mm512_add_ps(c0, d0));
+        a1 = _mm512_add_ps(_mm512_add_ps(a1, b1), _mm512_add_ps(c1, d1));
+        _mm512_store_ps(out, a0);
+        _mm512_store_ps(out + 16, a1);
+    }
+}
+
+/**
+ * @brief Blocked tile: each activation load feeds SPARSE_BLOCK_ROWS independent rows
+ */
+__attribute__((target("avx512f")))
+static void sparse_tile_blocked_avx512(const SparseMatrix* w, int chunk, const float* xt, float* yt, bool first) {
+    const int* ptr = w->group_ptr + (size_t)chunk * w->groups;
+
+    for (int g = 0; g < w->groups; g++) {
+        float* out = yt + (size_t)g * SPARSE_BLOCK_ROWS * SPARSE_BATCH_TILE;
+        __m512 acc[SPARSE_BLOCK_ROWS][2];
+        for (int b = 0; b < SPARSE_BLOCK_ROWS; b++) {
+            acc[b][0] = first ? _mm512_setzero_ps() : _mm512_load_ps(out + b * SPARSE_BATCH_TILE);
+            acc[b][1] = first ? _mm512_setzero_ps() : _mm512_load_ps(out + b * SPARSE_BATCH_TILE + 16);
+        }
+
+        for (int e = ptr[g]; e < ptr[g + 1]; e++) {
+            const float* v = w->values + (size_t)e * SPARSE_BLOCK_ROWS;
+            const float* x = xt + (size_t)w->col_index[e] * SPARSE_BATCH_TILE;
+            __m512 x0 = _mm512_load_ps(x);
+            __m512 x1 = _mm512_load_ps(x + 16);
+            for (int b = 0; b < SPARSE_BLOCK_ROWS; b++) {
+                __m512 vb = _mm512_set1_ps(v[b]);
+                acc[b][0] = _mm512_fmadd_ps(vb, x0, acc[b][0]);
+                acc[b][1] = _mm512_fmadd_ps(vb, x1, acc[b][1]);
+            }
+        }
+
+        for (int b = 0; b < SPARSE_BLOCK_ROWS; b++) {
+            _mm512_store_ps(out + b * SPARSE_BATCH_TILE, acc[b][0]);
+            _mm512_store_ps(out + b * SPARSE_BATCH_TILE + 16, acc[b][1]);
+        }
+    }
+}
+
+/**
+ * @brief Tile transposes with one 16-lane gather per vector
+ */
+__attribute__((target("avx512f")))
+static void sparse_transpose_in_avx512(const float* x, int cols, int count, float* xt) {
+    const __m512i lane = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i stride = _mm512_mullo_epi32(lane, _mm512_set1_epi32(cols));
+    __mmask16 lo = count >= 16 ? 0xffff : (__mmask16)((1u << count) - 1);
+    __mmask16 hi = count >= 32 ? 0xffff : count > 16 ? (__mmask16)((1u << (count - 16)) - 1) : 0;
+    const float* x_hi = x + (size_t)16 * cols;
+
+    for (int j = 0; j < cols; j++) {
+        float* lanes = xt + (size_t)j * SPARSE_BATCH_TILE;
+        _mm512_store_ps(lanes, _mm512_mask_i32gather_ps(_mm512_setzero_ps(), lo, stride, x + j, 4));
+        __m512 upper = hi ? _mm512_mask_i32gather_ps(_mm512_setzero_ps(), hi, stride, x_hi + j, 4)
+                          : _mm512_setzero_ps();
+        _mm512_store_ps(lanes + 16, upper);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void sparse_transpose_out_avx512(const float* yt, int rows, int count, float* y, int ldy) {
+    const __m512i lane = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i stride = _mm512_mullo_epi32(lane, _mm512_set1_epi32(SPARSE_BATCH_TILE));
+
+    for (int t = 0; t < count; t++) {
+        float* row = y + (size_t)t * ldy;
+        int o = 0;
+        for (; o + 16 <= rows; o += 16) {
+            _mm512_storeu_ps(row + o, _mm512_i32gather_ps(stride, yt + (size_t)o * SPARSE_BATCH_TILE + t, 4));
+        }
+        for (; o < rows; o++) row[o] = yt[(size_t)o * SPARSE_BATCH_TILE + t];
+    }
+}
+
+/**
+ * @brief CSR row: 16 inputs per gather
+ */
+__attribute__((target("avx512f")))
+static void sparse_row_csr_avx512(const SparseMatrix* w, const float* x, float* y) {
+    memset(y, 0, (size_t)w->rows * sizeof(float));
+    for (int c = 0; c < w->chunks; c++) {
+        const int* ptr = w->group_ptr + (size_t)c * w->groups;
+        for (int g = 0; g < w->groups; g++) {
+            int e = ptr[g], end = ptr[g + 1];
+            __m512 acc = _mm512_setzero_ps();
+            for (; e + 16 <= end; e += 16) {
+                __m512i index = _mm512_loadu_si512((const void*)(w->col_index + e));
+                acc = _mm512_fmadd_ps(_mm512_loadu_ps(w->values + e), _mm512_i32gather_ps(index, x, 4), acc);
+            }
+            if (e < end) {
+                __mmask16 mask = (__mmask16)((1u << (end - e)) - 1);
+                __m512i index = _mm512_maskz_loadu_epi32(mask, w->col_index + e);
+                __m512 xv = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, index, x, 4);
+                acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, w->values + e), xv, acc);
+            }
+            y[g] += _mm512_reduce_add_ps(acc);
+        }
+    }
+}
+
+#endif
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+static int sparse_active_kernel = -1;
+
+static bool sparse_cpu_supports(SparseKernelType type) {
+    switch (type) {
+        case SPARSE_KERNEL_SCALAR:
+            return true;
+#ifdef SPARSE_HAVE_X86
+        case SPARSE_KERNEL_AVX512:
+            return sparse_has_avx512();
+#endif
+        default:
+            return false;
+    }
+}
+
+SparseKernelType sparse_get_kernel(void) {
+    if (sparse_active_kernel < 0) {
+        sparse_active_kernel = sparse_cpu_supports(SPARSE_KERNEL_AVX512) ? (int)SPARSE_KERNEL_AVX512
+                                                                         : (int)SPARSE_KERNEL_SCALAR;
+    }
+    return (SparseKernelType)sparse_active_kernel;
+}
+
+bool sparse_set_kernel(SparseKernelType type) {
+    if (!sparse_cpu_supports(type)) return false;
+    sparse_active_kernel = (int)type;
+    return true;
+}
+
+const char* sparse_kernel_name(SparseKernelType type) {
+    switch (type) {
+        case SPARSE_KERNEL_SCALAR: return "scalar";
+        case SPARSE_KERNEL_AVX512: return "avx512";
+        default: return "unknown";
+    }
+}
+
+static SparseTileFn sparse_select_tile(SparseFormat format) {
+#ifdef SPARSE_HAVE_X86
+    if (sparse_get_kernel() == SPARSE_KERNEL_AVX512) {
+        return format == SPARSE_FORMAT_BLOCKED ? sparse_tile_blocked_avx512 : sparse_tile_csr_avx512;
+    }
+#endif
+    return format == SPARSE_FORMAT_BLOCKED ? sparse_tile_blocked_scalar : sparse_tile_csr_scalar;
+}
+
+static SparseRowFn sparse_select_row(SparseFormat format) {
+    if (format == SPARSE_FORMAT_BLOCKED) return sparse_row_blocked_scalar;
+#ifdef SPARSE_HAVE_X86
+    if (sparse_get_kernel() == SPARSE_KERNEL_AVX512) return sparse_row_csr_avx512;
+#endif
+    return sparse_row_csr_scalar;
+}
+
+// ============================================================================
+// Sparse Products
+// ============================================================================
+
+/**
+ * @brief Shared arguments of the per-tile tasks
+ */
+typedef struct {
+    SparseTileFn kernel;
+    SparseTransposeInFn transpose_in;
+    SparseTransposeOutFn transpose_out;
+    const float* x;
+    int m;
+    const SparseMatrix* w;
+    float* y;
+    int ldy;
+    const GemmEpilogue* epilogue;
+    int failed;
+} SparseTileTask;
+
+static void sparse_tile_task(void* context, int tile, int thread_id) {
+    SparseTileTask* task = (SparseTileTask*)context;
+    (void)thread_id;
+
+    const SparseMatrix* w = task->w;
+    int r0 = tile * SPARSE_BATCH_TILE;
+    int count = task->m - r0 < SPARSE_BATCH_TILE ? task->m - r0 : SPARSE_BATCH_TILE;
+    int padded_rows = w->groups * format_block_rows(w->format);
+
+    size_t lane_bytes = SPARSE_BATCH_TILE * sizeof(float);
+    float* xt = (float*)gemm_scratch_reserve(&sparse_x_tile, (size_t)w->cols * lane_bytes);
+    float* yt = (float*)gemm_scratch_reserve(&sparse_y_tile, (size_t)padded_rows * lane_bytes);
+    if (!xt || !yt) {
+        __atomic_store_n(&task->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    // Samples become lanes; missing samples of the last tile are zero
+    task->transpose_in(task->x + (size_t)r0 * w->cols, w->cols, count, xt);
+    for (int c = 0; c < w->chunks; c++) task->kernel(w, c, xt, yt, c == 0);
+    task->transpose_out(yt, w->rows, count, task->y + (size_t)r0 * task->ldy, task->ldy);
+    if (task->epilogue) {
+        gemm_apply_epilogue(task->epilogue, task->y + (size_t)r0 * task->ldy, task->ldy, count, w->rows, r0, 0);
+    }
+}
+
+bool sparse_matmul(const float* x, int m, const SparseMatrix* w, float* y, int ldy,
+                   const GemmEpilogue* epilogue) {
+    if (!x || !w || !w->group_ptr || !y || m <= 0 || ldy < w->rows) return false;
+
+    if (m <= SPARSE_GATHER_MAX_ROWS) {
+        SparseRowFn kernel = sparse_select_row(w->format);
+        for (int r = 0; r < m; r++) kernel(w, x + (size_t)r * w->cols, y + (size_t)r * ldy);
+        if (epilogue) gemm_apply_epilogue(epilogue, y, ldy, m, w->rows, 0, 0);
+        return true;
+    }
+
+    int tiles = (m + SPARSE_BATCH_TILE - 1) / SPARSE_BATCH_TILE;
+    SparseTileTask task = { sparse_select_tile(w->format), sparse_transpose_in_scalar, sparse_transpose_out_scalar,
+                            x, m, w, y, ldy, epilogue, 0 };
+#ifdef SPARSE_HAVE_X86
+    if (sparse_get_kernel() == SPARSE_KERNEL_AVX512) {
+        task.transpose_in = sparse_transpose_in_avx512;
+        task.transpose_out = sparse_transpose_out_avx512;
+    }
+#endif
+
+    ThreadPool* pool = gemm_get_thread_pool();
+    long long work = (long long)m * w->entries * format_block_rows(w->format);
+    if (pool && work >= GEMM_PARALLEL_THRESHOLD && tiles > 1 && !thread_pool_in_parallel_region()) {
+        thread_pool_parallel_for(pool, tiles, sparse_tile_task, &task);
+    } else {
+        for (int tile = 0; tile < tiles; tile++) sparse_tile_task(&task, tile, 0);
+    }
+    return task.failed == 0;
+}
@@ -8,64 +8,130 @@
 #include <string.h>
 #include <math.h>
 #include "../headers/neural_net.h"
+#include "../headers/gemm.h"
+#include "../headers/tensor_arena.h"
 
 // ============================================================================
 // Tensor Creation and Destruction
 // ============================================================================
 
-Tensor* tensor_create(float* data, int* shape, int ndim) {
-    if (!shape || ndim <= 0) return NULL;
+/**
+ * @brief Allocate tensor storage from the active arena or the heap
+ */
+static void* tensor_alloc(TensorArena* arena, size_t bytes) {
+    if (arena) return tensor_arena_alloc(arena, bytes);
+
+    tensor_stats_heap_alloc(bytes);
+    return malloc(bytes);
+}
 
-    Tensor* tensor = (Tensor*)malloc(sizeof(Tensor));
+static void tensor_release(void* ptr) {
+    if (!ptr) return;
+    tensor_stats_heap_free();
+    free(ptr);
+}
+
+/**
+ * @brief Allocate a tensor header and attach its shape
+ */
+static Tensor* tensor_alloc_header(TensorArena* arena, int* shape, int ndim) {
+    Tensor* tensor = (Tensor*)tensor_alloc(arena, sizeof(Tensor));
     if (!tensor) return NULL;
 
-    // Calculate total size
+    if (ndim <= TENSOR_INLINE_DIMS) {
+        tensor->shape = tensor->shape_inline;
+    } else {
+        tensor->shape = (int*)tensor_alloc(arena, ndim * sizeof(int));
+        if (!tensor->shape) {
+            if (!arena) tensor_release(tensor);
+            return NULL;
+        }
+    }
+    memcpy(tensor->shape, shape, ndim * sizeof(int));
+
     tensor->size = 1;
     for (int i = 0; i < ndim; i++) {
         tensor->size *= shape[i];
     }
 
+    tensor->ndim = ndim;
+    tensor->requires_grad = false;
+    tensor->grad = NULL;
+    tensor->arena_owned = arena != NULL;
+    return tensor;
+}
+
+static void tensor_release_header(Tensor* tensor) {
+    if (tensor->shape != tensor->shape_inline) {
+        tensor_release(tensor->shape);
+    }
+    tensor_release(tensor);
+}
+
+Tensor* tensor_create(float* data, int* shape, int ndim) {
+    if (!shape || ndim <= 0) return NULL;
+
+    TensorArena* arena = tensor_arena_active();
+    Tensor* tensor = tensor_alloc_header(arena, shape, ndim);
+    if (!tensor) return NULL;
+
     // Allocate data
+    size_t bytes = (size_t)tensor->size * sizeof(float);
+    tensor->data = (float*)tensor_alloc(arena, bytes);
+    if (!tensor->data) {
+        if (!arena) tensor_release_header(tensor);
+        return NULL;
+    }
+
     if (data) {
-        tensor->data = (float*)malloc(tensor->size * sizeof(float));
-        if (!tensor->data) {
-            free(tensor);
-            return NULL;
-        }
-        memcpy(tensor->data, data, tensor->size * sizeof(float));
+        memcpy(tensor->data, data, bytes);
     } else {
-        tensor->data = (float*)calloc(tensor->size, sizeof(float));
-        if (!tensor->data) {
-            free(tensor);
-            return NULL;
-        }
+        memset(tensor->data, 0, bytes);
     }
 
-    // Copy shape
-    tensor->shape = (int*)malloc(ndim * sizeof(int));
-    if (!tensor->shape) {
-        free(tensor->data);
-        free(tensor);
-        return NULL;
-    }
-    memcpy(tensor->shape, shape, ndim * sizeof(int));
+    tensor->owns_data = arena == NULL;
+    tensor_stats_tensor_created();
 
-    tensor->ndim = ndim;
-    tensor->requires_grad = false;
-    tensor->grad = NULL;
+    return tensor;
+}
+
+Tensor* tensor_create_view(float* data, int* shape, int ndim) {
+    if (!data || !shape || ndim <= 0) return NULL;
+
+    TensorArena* arena = tensor_arena_active();
+    Tensor* tensor = tensor_alloc_header(arena, shape, ndim);
+    if (!tensor) return NULL;
+
+    tensor->data = data;
+    tensor->owns_data = false;
+    tensor_stats_tensor_created();
 
     return tensor;
 }
 
+void tensor_alias_data(Tensor* tensor, float* data) {
+    if (!tensor || !data) return;
+
+    if (tensor->owns_data && !tensor->arena_owned) {
+        tensor_release(tensor->data);
+    }
+    tensor->data = data;
+    tensor->owns_data = false;
+}
+
 void tensor_destroy(Tensor* tensor) {
     if (!tensor) return;
 
-    free(tensor->data);
-    free(tensor->shape);
+    // Arena tensors are released together by tensor_arena_reset
+    if (tensor->arena_owned) return;
+
+    if (tensor->owns_data) {
+        tensor_release(tensor->data);
+    }
     if (tensor->grad) {
         free(tensor->grad);
     }
-    free(tensor);
+    tensor_release_header(tensor);
 }
 
 // ============================================================================
@@ -78,10 +144,7 @@ Tensor* tensor_add(Tensor* a, Tensor* b) {
     Tensor* result = tensor_create(NULL, a->shape, a->ndim);
     if (!result) return NULL;
 
-    for (int i = 0; i < a->size; i++) {
-        result->data[i] = a->data[i] + b->data[i];
-    }
-
+    tensor_add_into(result, a, b);
     return result;
 }
 
@@ -91,10 +154,7 @@ Tensor* tensor_multiply(Tensor* a, Tensor* b) {
     Tensor* result = tensor_create(NULL, a->shape, a->ndim);
     if (!result) return NULL;
 
-    for (int i = 0; i < a->size; i++) {
-        result->data[i] = a->data[i] * b->data[i];
-    }
-
+    tensor_multiply_into(result, a, b);
     return result;
 }
 
@@ -104,11 +164,109 @@ Tensor* tensor_scalar_multiply(Tensor* tensor, float scalar) {
     Tensor* result = tensor_create(NULL, tensor->shape, tensor->ndim);
     if (!result) return NULL;
 
-    for (int i = 0; i < tensor->size; i++) {
-        result->data[i] = tensor->data[i] * scalar;
+    tensor_scalar_multiply_into(result, tensor, scalar);
+    return result;
+}
+
+// ============================================================================
+// Output-buffer and In-place Operations
+// ============================================================================
+
+bool tensor_add_into(Tensor* out, const Tensor* a, const Tensor* b) {
+    if (!out || !a || !b || a->size != b->size || out->size != a->size) return false;
+
+    float* o = out->data;
+    const float* x = a->data;
+    const float* y = b->data;
+    for (int i = 0; i < out->size; i++) {
+        o[i] = x[i] + y[i];
     }
 
-    return result;
+    return true;
+}
+
+bool tensor_multiply_into(Tensor* out, const Tensor* a, const Tensor* b) {
+    if (!out || !a || !b || a->size != b->size || out->size != a->size) return false;
+
+    float* o = out->data;
+    const float* x = a->data;
+    const float* y = b->data;
+    for (int i = 0; i < out->size; i++) {
+        o[i] = x[i] * y[i];
+    }
+
+    return true;
+}
+
+bool tensor_scalar_multiply_into(Tensor* out, const Tensor* tensor, float scalar) {
+    if (!out || !tensor || out->size != tensor->size) return false;
+
+    float* o = out->data;
+    const float* x = tensor->data;
+    for (int i = 0; i < out->size; i++) {
+        o[i] = x[i] * scalar;
+    }
+
+    return true;
+}
+
+bool tensor_fma_into(Tensor* out, const Tensor* a, const Tensor* b, const Tensor* c) {
+    if (!out || !a || !b || !c) return false;
+    if (a->size != out->size || b->size != out->size || c->size != out->size) return false;
+
+    float* o = out->data;
+    const float* x = a->data;
+    const float* y = b->data;
+    const float* z = c->data;
+    for (int i = 0; i < out->size; i++) {
+        o[i] = x[i] * y[i] + z[i];
+    }
+
+    return true;
+}
+
+bool tensor_copy_into(Tensor* out, const Tensor* tensor) {
+    if (!out || !tensor || out->size != tensor->size) return false;
+    if (out->data != tensor->data) {
+        memcpy(out->data, tensor->data, (size_t)out->size * sizeof(float));
+    }
+    return true;
+}
+
+bool tensor_add_inplace(Tensor* a, const Tensor* b) {
+    return tensor_add_into(a, a, b);
+}
+
+bool tensor_multiply_inplace(Tensor* a, const Tensor* b) {
+    return tensor_multiply_into(a, a, b);
+}
+
+bool tensor_scale_inplace(Tensor* tensor, float scalar) {
+    return tensor_scalar_multiply_into(tensor, tensor, scalar);
+}
+
+bool tensor_axpy(Tensor* y, float alpha, const Tensor* x) {
+    if (!y || !x || y->size != x->size) return false;
+
+    float* dst = y->data;
+    const float* src = x->data;
+    for (int i = 0; i < y->size; i++) {
+        dst[i] += alpha * src[i];
+    }
+
+    return true;
+}
+
+bool tensor_axpby(Tensor* y, float alpha, const Tensor* x, float beta) {
+    if (!y || !x || y->size != x->size) return false;
+
+    float* dst = y->data;
+    const float* src = x->data;
+    for (int i = 0; i < y->size; i++) {
+        dst[i] = alpha * src[i] + beta * dst[i];
+    }
+
+    return true;
 }
 
 float tensor_sum(Tensor* tensor) {
@@ -167,30 +325,84 @@ void tensor_print(Tensor* tensor, const char* name) {
 // Matrix Operations (for dense layers)
 // ============================================================================
 
-Tensor* matrix_multiply(Tensor* a, Tensor* b) {
-    if (!a || !b || a->ndim != 2 || b->ndim != 2 || a->shape[1] != b->shape[0]) {
-        return NULL;
+bool matrix_multiply_into(Tensor* out, const Tensor* a, const Tensor* b) {
+    if (!out || !a || !b || a->ndim != 2 || b->ndim != 2 || a->shape[1] != b->shape[0]) {
+        return false;
     }
 
     int m = a->shape[0]; // rows of a
     int n = b->shape[1]; // cols of b
     int p = a->shape[1]; // cols of a / rows of b
+    if (out->size != m * n) return false;
 
-    int result_shape[2] = {m, n};
+    return gemm_sgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, m, n, p, 1.0f,
+                      a->data, p, b->data, n, 0.0f, out->data, n);
+}
+
+bool matrix_multiply_transpose_b_into(Tensor* out, const Tensor* a, const Tensor* b) {
+    if (!out || !a || !b || a->ndim != 2 || b->ndim != 2 || a->shape[1] != b->shape[1]) {
+        return false;
+    }
+
+    int m = a->shape[0]; // rows of a
+    int n = b->shape[0]; // rows of b (cols of b^T)
+    int p = a->shape[1]; // shared inner dimension
+    if (out->size != m * n) return false;
+
+    return gemm_sgemm(GEMM_NO_TRANS, GEMM_TRANS, m, n, p, 1.0f,
+                      a->data, p, b->data, p, 0.0f, out->data, n);
+}
+
+bool matrix_multiply_transpose_a_into(Tensor* out, const Tensor* a, const Tensor* b) {
+    if (!out || !a || !b || a->ndim != 2 || b->ndim != 2 || a->shape[0] != b->shape[0]) {
+        return false;
+    }
+
+    int m = a->shape[1]; // cols of a (rows of a^T)
+    int n = b->shape[1]; // cols of b
+    int p = a->shape[0]; // shared inner dimension
+    if (out->size != m * n) return false;
+
+    return gemm_sgemm(GEMM_TRANS, GEMM_NO_TRANS, m, n, p, 1.0f,
+                      a->data, m, b->data, n, 0.0f, out->data, n);
+}
+
+Tensor* matrix_multiply(Tensor* a, Tensor* b) {
+    if (!a || !b || a->ndim != 2 || b->ndim != 2 || a->shape[1] != b->shape[0]) {
+        return NULL;
+    }
+
+    int result_shape[2] = {a->shape[0], b->shape[1]};
     Tensor* result = tensor_create(NULL, result_shape, 2);
     if (!result) return NULL;
 
-    // Matrix multiplication
-    for (int i = 0; i < m; i++) {
-        for (int j = 0; j < n; j++) {
-            float sum = 0.0f;
-            for (int k = 0; k < p; k++) {
-                sum += a->data[i * p + k] * b->data[k * n + j];
-            }
-            result->data[i * n + j] = sum;
-        }
+    matrix_multiply_into(result, a, b);
+    return result;
+}
+
+Tensor* matrix_multiply_transpose_b(Tensor* a, Tensor* b) {
+    if (!a || !b || a->ndim != 2 || b->ndim != 2 || a->shape[1] != b->shape[1]) {
+        return NULL;
+    }
+
+    int result_shape[2] = {a->shape[0], b->shape[0]};
+    Tensor* result = tensor_create(NULL, result_shape, 2);
+    if (!result) return NULL;
+
+    matrix_multiply_transpose_b_into(result, a, b);
+    return result;
+}
+
+Tensor* matrix_multiply_transpose_a(Tensor* a, Tensor* b) {
+    if (!a || !b || a->ndim != 2 || b->ndim != 2 || a->shape[0] != b->shape[0]) {
+        return NULL;
     }
 
+    int result_shape[2] = {a->shape[1], b->shape[1]};
+    Tensor* result = tensor_create(NULL, result_shape, 2);
+    if (!result) return NULL;
+
+    matrix_multiply_transpose_a_into(result, a, b);
     return result;
 }
 
@@ -0,0 +1,169 @@
+/*
+ * Neural Network System - Tensor Arena Implementation
+ * Chunked bump allocator for per-step tensor temporaries
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/tensor_arena.h"
+
+#if defined(_MSC_VER)
+#define ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define ARENA_THREAD_LOCAL __thread
+#endif
+
+#if defined(__GNUC__)
+#define STATS_ADD(field, value) (__atomic_fetch_add(&alloc_stats.field, (value), __ATOMIC_RELAXED), \
+                                 thread_alloc_stats.field += (value))
+#else
+#define STATS_ADD(field, value) (alloc_stats.field += (value), thread_alloc_stats.field += (value))
+#endif
+
+static TensorAllocStats alloc_stats;
+static ARENA_THREAD_LOCAL TensorAllocStats thread_alloc_stats;
+static ARENA_THREAD_LOCAL TensorArena* active_arena = NULL;
+
+// ============================================================================
+// Allocation Counters
+// ============================================================================
+
+void tensor_get_alloc_stats(TensorAllocStats* stats) {
+    if (!stats) return;
+    *stats = alloc_stats;
+}
+
+void tensor_get_thread_alloc_stats(TensorAllocStats* stats) {
+    if (!stats) return;
+    *stats = thread_alloc_stats;
+}
+
+void tensor_reset_alloc_stats(void) {
+    memset(&alloc_stats, 0, sizeof(alloc_stats));
+}
+
+void tensor_stats_heap_alloc(size_t bytes) {
+    STATS_ADD(heap_allocations, 1);
+    STATS_ADD(heap_bytes, bytes);
+}
+
+void tensor_stats_heap_free(void) {
+    STATS_ADD(heap_frees, 1);
+}
+
+void tensor_stats_tensor_created(void) {
+    STATS_ADD(tensors_created, 1);
+}
+
+// ============================================================================
+// Chunk Management
+// ============================================================================
+
+static TensorArenaChunk* arena_chunk_create(size_t capacity) {
+    TensorArenaChunk* chunk = (TensorArenaChunk*)malloc(sizeof(TensorArenaChunk));
+    if (!chunk) return NULL;
+
+    chunk->raw = malloc(capacity + TENSOR_ARENA_ALIGNMENT);
+    if (!chunk->raw) {
+        free(chunk);
+        return NULL;
+    }
+    tensor_stats_heap_alloc(capacity + TENSOR_ARENA_ALIGNMENT);
+
+    uintptr_t addr = (uintptr_t)chunk->raw;
+    addr = (addr + TENSOR_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(TENSOR_ARENA_ALIGNMENT - 1);
+    chunk->base = (char*)addr;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->next = NULL;
+    return chunk;
+}
+
+// ============================================================================
+// Arena Management
+// ============================================================================
+
+TensorArena* tensor_arena_create(size_t initial_bytes) {
+    TensorArena* arena = (TensorArena*)calloc(1, sizeof(TensorArena));
+    if (!arena) return NULL;
+
+    arena->chunk_size = initial_bytes > TENSOR_ARENA_DEFAULT_CHUNK ? initial_bytes
+                                                                  : TENSOR_ARENA_DEFAULT_CHUNK;
+    arena->chunks = arena_chunk_create(arena->chunk_size);
+    if (!arena->chunks) {
+        free(arena);
+        return NULL;
+    }
+    arena->current = arena->chunks;
+    return arena;
+}
+
+void tensor_arena_destroy(TensorArena* arena) {
+    if (!arena) return;
+
+    if (active_arena == arena) active_arena = NULL;
+
+    TensorArenaChunk* chunk = arena->chunks;
+    while (chunk) {
+        TensorArenaChunk* next = chunk->next;
+        free(chunk->raw);
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+void* tensor_arena_alloc(TensorArena* arena, size_t bytes) {
+    if (!arena) return NULL;
+
+    size_t rounded = (bytes + TENSOR_ARENA_ALIGNMENT - 1) & ~(size_t)(TENSOR_ARENA_ALIGNMENT - 1);
+    if (rounded == 0) rounded = TENSOR_ARENA_ALIGNMENT;
+
+    // Bump within the current chunk, then try the chunks kept from earlier steps
+    TensorArenaChunk* chunk = arena->current;
+    while (chunk && chunk->capacity - chunk->used < rounded) {
+        chunk = chunk->next;
+    }
+
+    if (!chunk) {
+        size_t capacity = rounded > arena->chunk_size ? rounded : arena->chunk_size;
+        chunk = arena_chunk_create(capacity);
+        if (!chunk) return NULL;
+
+        // Append so that older (already warmed) chunks are tried first
+        TensorArenaChunk* tail = arena->current;
+        while (tail->next) tail = tail->next;
+        tail->next = chunk;
+    }
+
+    void* block = chunk->base + chunk->used;
+    chunk->used += rounded;
+    arena->current = chunk;
+    arena->used += rounded;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+
+    STATS_ADD(arena_allocations, 1);
+    STATS_ADD(arena_bytes, rounded);
+    return block;
+}
+
+void tensor_arena_reset(TensorArena* arena) {
+    if (!arena) return;
+
+    for (TensorArenaChunk* chunk = arena->chunks; chunk; chunk = chunk->next) {
+        chunk->used = 0;
+    }
+    arena->current = arena->chunks;
+    arena->used = 0;
+}
+
+TensorArena* tensor_arena_activate(TensorArena* arena) {
+    TensorArena* previous = active_arena;
+    active_arena = arena;
+    return previous;
+}
+
+TensorArena* tensor_arena_active(void) {
+    return active_arena;
+}
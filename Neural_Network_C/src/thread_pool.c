@@ -0,0 +1,241 @@
+/*
+ * Neural Network System - Thread Pool Implementation
+ * Persistent pthread workers with a blocking parallel-for
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE                 // pthread_setaffinity_np
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../headers/thread_pool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+#define POOL_THREAD_LOCAL __declspec(thread)
+#else
+#define POOL_THREAD_LOCAL __thread
+#endif
+
+// ============================================================================
+// Pool Structures
+// ============================================================================
+
+struct ThreadPool {
+    pthread_t* workers;         // Worker threads (caller is thread 0)
+    int num_workers;            // Number of worker threads
+
+    pthread_mutex_t lock;       // Protects all fields below
+    pthread_cond_t work_ready;  // Signalled when a new job is posted
+    pthread_cond_t work_done;   // Signalled when the last worker finishes
+    pthread_mutex_t submit;     // Serializes concurrent submitters
+
+    ThreadPoolTask task;        // Current job body
+    void* context;              // Current job context
+    int count;                  // Number of tasks in current job
+    int next;                   // Next unclaimed task index
+    int pending;                // Workers still attached to current job
+    unsigned long generation;   // Incremented for every posted job
+    bool shutdown;              // Set when the pool is being destroyed
+};
+
+typedef struct {
+    ThreadPool* pool;
+    int thread_id;
+} WorkerArgs;
+
+static POOL_THREAD_LOCAL bool pool_in_region = false;
+
+// ============================================================================
+// Worker Loop
+// ============================================================================
+
+static void thread_pool_run_tasks(ThreadPool* pool, int thread_id) {
+    pool_in_region = true;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        int index = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (index >= pool->count) break;
+        pool->task(pool->context, index, thread_id);
+    }
+
+    pool_in_region = false;
+}
+
+static void* thread_pool_worker(void* arg) {
+    WorkerArgs args = *(WorkerArgs*)arg;
+    ThreadPool* pool = args.pool;
+    free(arg);
+
+    unsigned long seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        thread_pool_run_tasks(pool, args.thread_id);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->work_done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// Pool Management
+// ============================================================================
+
+int thread_pool_hardware_threads(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+bool thread_pool_pin_current_thread(int first_core, int count) {
+#ifdef __linux__
+    int cores = thread_pool_hardware_threads();
+    if (count <= 0 || first_core < 0) return false;
+    if (count > cores) count = cores;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c = 0; c < count; c++) CPU_SET((first_core + c) % cores, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)first_core;
+    (void)count;
+    return false;
+#endif
+}
+
+ThreadPool* thread_pool_create(int num_threads) {
+    if (num_threads <= 0) num_threads = thread_pool_hardware_threads();
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_mutex_init(&pool->submit, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+
+    pool->num_workers = num_threads - 1;
+    if (pool->num_workers > 0) {
+        pool->workers = (pthread_t*)malloc(pool->num_workers * sizeof(pthread_t));
+        if (!pool->workers) {
+            pool->num_workers = 0;
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    for (int i = 0; i < pool->num_workers; i++) {
+        WorkerArgs* args = (WorkerArgs*)malloc(sizeof(WorkerArgs));
+        if (args) {
+            args->pool = pool;
+            args->thread_id = i + 1;
+        }
+        if (!args || pthread_create(&pool->workers[i], NULL, thread_pool_worker, args) != 0) {
+            free(args);
+            pool->num_workers = i;
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void thread_pool_destroy(ThreadPool* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->work_done);
+    pthread_mutex_destroy(&pool->submit);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+int thread_pool_size(ThreadPool* pool) {
+    return pool ? pool->num_workers + 1 : 1;
+}
+
+bool thread_pool_in_parallel_region(void) {
+    return pool_in_region;
+}
+
+// ============================================================================
+// Parallel Execution
+// ============================================================================
+
+void thread_pool_parallel_for(ThreadPool* pool, int count, ThreadPoolTask task, void* context) {
+    if (count <= 0 || !task) return;
+
+    // Serial fallback: no pool, nothing to split, or nested parallel region
+    if (!pool || pool->num_workers == 0 || count == 1 || pool_in_region) {
+        for (int i = 0; i < count; i++) {
+            task(context, i, 0);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->submit);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->context = context;
+    pool->count = count;
+    pool->next = 0;
+    pool->pending = pool->num_workers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    // The caller participates as thread 0
+    thread_pool_run_tasks(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&pool->submit);
+}
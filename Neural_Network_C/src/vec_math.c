@@ -0,0 +1,467 @@
+/*
+ * Neural Network System - Vectorized Math Implementation
+ * Scalar reference algorithms and the AVX2 / AVX-512 array kernels built
+ * from the inline primitives in vec_math.h
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "../headers/vec_math.h"
+
+// ============================================================================
+// Scalar Algorithms
+// ============================================================================
+
+static inline float vec_math_bits_to_float(uint32_t bits) {
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static inline uint32_t vec_math_float_to_bits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static inline float vec_math_exp_scalar(float x) {
+    if (x != x) return x;
+    if (x < VEC_MATH_EXP_LO) return 0.0f;
+    if (x > VEC_MATH_EXP_HI) return INFINITY;
+
+    float t = x * VEC_MATH_LOG2E;
+    float n = (float)(int)(t < 0.0f ? t - 0.5f : t + 0.5f);
+    float r = x - n * VEC_MATH_LN2_HI;
+    r = r - n * VEC_MATH_LN2_LO;
+
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * (r * r) + r + 1.0f;
+
+    // 2^n in two halves keeps both exponent fields normal down to 2^-150
+    int ni = (int)n;
+    int half = ni / 2;
+    float a = vec_math_bits_to_float((uint32_t)(half + 127) << 23);
+    float b = vec_math_bits_to_float((uint32_t)(ni - half + 127) << 23);
+    return p * a * b;
+}
+
+static inline float vec_math_log_scalar(float x) {
+    if (x != x || x == INFINITY) return x;
+    if (x == 0.0f) return -INFINITY;
+    if (x < 0.0f) return NAN;
+
+    float scale = 0.0f;
+    if (x < 1.17549435e-38f) {
+        x *= 8388608.0f;
+        scale = 23.0f;
+    }
+
+    uint32_t bits = vec_math_float_to_bits(x);
+    float e = (float)((int)(bits >> 23) - 126) - scale;
+    float m = vec_math_bits_to_float((bits & 0x007FFFFFu) | 0x3F000000u);
+
+    if (m < VEC_MATH_SQRT_HALF) {
+        e -= 1.0f;
+        m += m;
+    }
+    float f = m - 1.0f;
+    float z = f * f;
+
+    float y = 7.0376836292e-2f;
+    y = y * f - 1.1514610310e-1f;
+    y = y * f + 1.1676998740e-1f;
+    y = y * f - 1.2420140846e-1f;
+    y = y * f + 1.4249322787e-1f;
+    y = y * f - 1.6668057665e-1f;
+    y = y * f + 2.0000714765e-1f;
+    y = y * f - 2.4999993993e-1f;
+    y = y * f + 3.3333331174e-1f;
+    y = y * f * z;
+    y += e * VEC_MATH_LN2_LO;
+    y -= 0.5f * z;
+    return (f + y) + e * VEC_MATH_LN2_HI;
+}
+
+static inline float vec_math_tanh_scalar(float x) {
+    float ax = fabsf(x);
+    float t;
+
+    if (ax < VEC_MATH_TANH_SMALL) {
+        float z = x * x;
+        float p = -5.70498872745e-3f;
+        p = p * z + 2.06390887954e-2f;
+        p = p * z - 5.37397155531e-2f;
+        p = p * z + 1.33314422036e-1f;
+        p = p * z - 3.33332819422e-1f;
+        t = p * z * ax + ax;
+    } else {
+        t = 1.0f - 2.0f / (vec_math_exp_scalar(ax + ax) + 1.0f);
+    }
+    return copysignf(t, x);
+}
+
+static inline float vec_math_sigmoid_scalar(float x) {
+    float e = vec_math_exp_scalar(-fabsf(x));
+    float s = 1.0f / (1.0f + e);
+    return x < 0.0f ? s * e : s;
+}
+
+/**
+ * @brief GELU argument 2u, so gelu(x) = x * sigmoid(2u)
+ */
+static inline float vec_math_gelu_arg(float x) {
+    return 1.59576912160573071f * (x + 0.044715f * x * x * x);
+}
+
+#define VEC_MATH_MISH_LINEAR 20.0f      // mish(x) == x in float beyond this
+
+static inline float vec_math_mish_scalar(float x) {
+    if (x > VEC_MATH_MISH_LINEAR) return x;
+    float e = vec_math_exp_scalar(x);
+    float n = e * (e + 2.0f);
+    return x * n / (n + 2.0f);
+}
+
+float vec_math_expf(float x) {
+    return vec_math_exp_scalar(x);
+}
+
+float vec_math_logf(float x) {
+    return vec_math_log_scalar(x);
+}
+
+float vec_math_tanhf(float x) {
+    return vec_math_tanh_scalar(x);
+}
+
+float vec_math_sigmoidf(float x) {
+    return vec_math_sigmoid_scalar(x);
+}
+
+static void vec_math_exp_array_scalar(float* x, int size) {
+    for (int i = 0; i < size; i++) x[i] = vec_math_exp_scalar(x[i]);
+}
+
+static void vec_math_log_array_scalar(float* x, int size) {
+    for (int i = 0; i < size; i++) x[i] = vec_math_log_scalar(x[i]);
+}
+
+static void vec_math_tanh_array_scalar(float* x, int size) {
+    for (int i = 0; i < size; i++) x[i] = vec_math_tanh_scalar(x[i]);
+}
+
+static void vec_math_sigmoid_array_scalar(float* x, int size) {
+    for (int i = 0; i < size; i++) x[i] = vec_math_sigmoid_scalar(x[i]);
+}
+
+static void vec_math_swish_array_scalar(float* x, int size) {
+    for (int i = 0; i < size; i++) x[i] *= vec_math_sigmoid_scalar(x[i]);
+}
+
+static void vec_math_gelu_array_scalar(float* x, int size) {
+    for (int i = 0; i < size; i++) x[i] *= vec_math_sigmoid_scalar(vec_math_gelu_arg(x[i]));
+}
+
+static void vec_math_mish_array_scalar(float* x, int size) {
+    for (int i = 0; i < size; i++) x[i] = vec_math_mish_scalar(x[i]);
+}
+
+static void vec_math_softmax_scalar(float* x, int size) {
+    float max = x[0];
+    for (int i = 1; i < size; i++) max = x[i] > max ? x[i] : max;
+
+    float sum = 0.0f;
+    for (int i = 0; i < size; i++) {
+        x[i] = vec_math_exp_scalar(x[i] - max);
+        sum += x[i];
+    }
+
+    float inv = 1.0f / sum;
+    for (int i = 0; i < size; i++) x[i] *= inv;
+}
+
+// ============================================================================
+// AVX2 Kernels
+// ============================================================================
+
+#ifdef VEC_MATH_HAVE_X86
+
+// Elementwise ops as one-register functions; the map macros supply the loop
+// and handle the tail through a padded copy (AVX2) or a lane mask (AVX-512).
+
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_swish_ymm(__m256 x) {
+    return _mm256_mul_ps(x, vec_math_sigmoid_ymm(x));
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_gelu_ymm(__m256 x) {
+    __m256 cube = _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+    __m256 u = _mm256_mul_ps(_mm256_set1_ps(1.59576912160573071f),
+                             _mm256_fmadd_ps(_mm256_set1_ps(0.044715f), cube, x));
+    return _mm256_mul_ps(x, vec_math_sigmoid_ymm(u));
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256 vec_math_mish_ymm(__m256 x) {
+    __m256 two = _mm256_set1_ps(2.0f);
+    __m256 e = vec_math_exp_ymm(_mm256_min_ps(x, _mm256_set1_ps(VEC_MATH_MISH_LINEAR)));
+    __m256 n = _mm256_mul_ps(e, _mm256_add_ps(e, two));
+    __m256 y = _mm256_div_ps(_mm256_mul_ps(x, n), _mm256_add_ps(n, two));
+    return _mm256_blendv_ps(y, x, _mm256_cmp_ps(x, _mm256_set1_ps(VEC_MATH_MISH_LINEAR), _CMP_GT_OQ));
+}
+
+#define VEC_MATH_MAP_AVX2(name, op)                                          \
+    __attribute__((target("avx2,fma")))                                      \
+    static void name(float* x, int size) {                                   \
+        int i = 0;                                                           \
+        for (; i + 8 <= size; i += 8) {                                      \
+            _mm256_storeu_ps(x + i, op(_mm256_loadu_ps(x + i)));             \
+        }                                                                    \
+        if (i < size) {                                                      \
+            float tail[8] = { 0 };                                           \
+            memcpy(tail, x + i, (size_t)(size - i) * sizeof(float));         \
+            _mm256_storeu_ps(tail, op(_mm256_loadu_ps(tail)));               \
+            memcpy(x + i, tail, (size_t)(size - i) * sizeof(float));         \
+        }                                                                    \
+    }
+
+VEC_MATH_MAP_AVX2(vec_math_exp_avx2, vec_math_exp_ymm)
+VEC_MATH_MAP_AVX2(vec_math_log_avx2, vec_math_log_ymm)
+VEC_MATH_MAP_AVX2(vec_math_tanh_avx2, vec_math_tanh_ymm)
+VEC_MATH_MAP_AVX2(vec_math_sigmoid_avx2, vec_math_sigmoid_ymm)
+VEC_MATH_MAP_AVX2(vec_math_swish_avx2, vec_math_swish_ymm)
+VEC_MATH_MAP_AVX2(vec_math_gelu_avx2, vec_math_gelu_ymm)
+VEC_MATH_MAP_AVX2(vec_math_mish_avx2, vec_math_mish_ymm)
+
+__attribute__((target("avx2,fma")))
+static float vec_math_hsum_ymm(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+__attribute__((target("avx2,fma")))
+static void vec_math_softmax_avx2(float* x, int size) {
+    float max = x[0];
+    for (int i = 1; i < size; i++) max = x[i] > max ? x[i] : max;
+
+    __m256 shift = _mm256_set1_ps(max);
+    __m256 acc = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m256 e = vec_math_exp_ymm(_mm256_sub_ps(_mm256_loadu_ps(x + i), shift));
+        _mm256_storeu_ps(x + i, e);
+        acc = _mm256_add_ps(acc, e);
+    }
+    float sum = vec_math_hsum_ymm(acc);
+    for (; i < size; i++) {
+        x[i] = vec_math_exp_scalar(x[i] - max);
+        sum += x[i];
+    }
+
+    __m256 inv = _mm256_set1_ps(1.0f / sum);
+    for (i = 0; i + 8 <= size; i += 8) _mm256_storeu_ps(x + i, _mm256_mul_ps(_mm256_loadu_ps(x + i), inv));
+    for (; i < size; i++) x[i] *= 1.0f / sum;
+}
+
+// ============================================================================
+// AVX-512 Kernels
+// ============================================================================
+
+__attribute__((target("avx512f")))
+static inline __m512 vec_math_swish_zmm(__m512 x) {
+    return _mm512_mul_ps(x, vec_math_sigmoid_zmm(x));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 vec_math_gelu_zmm(__m512 x) {
+    __m512 cube = _mm512_mul_ps(_mm512_mul_ps(x, x), x);
+    __m512 u = _mm512_mul_ps(_mm512_set1_ps(1.59576912160573071f),
+                             _mm512_fmadd_ps(_mm512_set1_ps(0.044715f), cube, x));
+    return _mm512_mul_ps(x, vec_math_sigmoid_zmm(u));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 vec_math_mish_zmm(__m512 x) {
+    __m512 two = _mm512_set1_ps(2.0f);
+    __m512 e = vec_math_exp_zmm(_mm512_min_ps(x, _mm512_set1_ps(VEC_MATH_MISH_LINEAR)));
+    __m512 n = _mm512_mul_ps(e, _mm512_add_ps(e, two));
+    __m512 y = _mm512_div_ps(_mm512_mul_ps(x, n), _mm512_add_ps(n, two));
+    return _mm512_mask_mov_ps(y, _mm512_cmp_ps_mask(x, _mm512_set1_ps(VEC_MATH_MISH_LINEAR), _CMP_GT_OQ), x);
+}
+
+#define VEC_MATH_MAP_AVX512(name, op)                                        \
+    __attribute__((target("avx512f")))                                       \
+    static void name(float* x, int size) {                                   \
+        int i = 0;                                                           \
+        for (; i + 16 <= size; i += 16) {                                    \
+            _mm512_storeu_ps(x + i, op(_mm512_loadu_ps(x + i)));             \
+        }                                                                    \
+        if (i < size) {                                                      \
+            __mmask16 m = (__mmask16)((1u << (size - i)) - 1);               \
+            _mm512_mask_storeu_ps(x + i, m, op(_mm512_maskz_loadu_ps(m, x + i))); \
+        }                                                                    \
+    }
+
+VEC_MATH_MAP_AVX512(vec_math_exp_avx512, vec_math_exp_zmm)
+VEC_MATH_MAP_AVX512(vec_math_log_avx512, vec_math_log_zmm)
+VEC_MATH_MAP_AVX512(vec_math_tanh_avx512, vec_math_tanh_zmm)
+VEC_MATH_MAP_AVX512(vec_math_sigmoid_avx512, vec_math_sigmoid_zmm)
+VEC_MATH_MAP_AVX512(vec_math_swish_avx512, vec_math_swish_zmm)
+VEC_MATH_MAP_AVX512(vec_math_gelu_avx512, vec_math_gelu_zmm)
+VEC_MATH_MAP_AVX512(vec_math_mish_avx512, vec_math_mish_zmm)
+
+__attribute__((target("avx512f")))
+static void vec_math_softmax_avx512(float* x, int size) {
+    __m512 vmax = _mm512_set1_ps(-INFINITY);
+    int i = 0;
+    for (; i + 16 <= size; i += 16) vmax = _mm512_max_ps(vmax, _mm512_loadu_ps(x + i));
+    __mmask16 tail = (__mmask16)((1u << (size - i)) - 1);
+    if (tail) vmax = _mm512_mask_max_ps(vmax, tail, vmax, _mm512_maskz_loadu_ps(tail, x + i));
+    __m512 shift = _mm512_set1_ps(_mm512_reduce_max_ps(vmax));
+
+    __m512 acc = _mm512_setzero_ps();
+    for (i = 0; i + 16 <= size; i += 16) {
+        __m512 e = vec_math_exp_zmm(_mm512_sub_ps(_mm512_loadu_ps(x + i), shift));
+        _mm512_storeu_ps(x + i, e);
+        acc = _mm512_add_ps(acc, e);
+    }
+    if (tail) {
+        __m512 e = vec_math_exp_zmm(_mm512_sub_ps(_mm512_maskz_loadu_ps(tail, x + i), shift));
+        _mm512_mask_storeu_ps(x + i, tail, e);
+        acc = _mm512_mask_add_ps(acc, tail, acc, e);
+    }
+
+    __m512 inv = _mm512_set1_ps(1.0f / _mm512_reduce_add_ps(acc));
+    for (i = 0; i + 16 <= size; i += 16) _mm512_storeu_ps(x + i, _mm512_mul_ps(_mm512_loadu_ps(x + i), inv));
+    if (tail) _mm512_mask_storeu_ps(x + i, tail, _mm512_mul_ps(_mm512_maskz_loadu_ps(tail, x + i), inv));
+}
+
+#endif // VEC_MATH_HAVE_X86
+
+// ============================================================================
+// Kernel Selection
+// ============================================================================
+
+typedef void (*VecMathArrayFn)(float*, int);
+
+/**
+ * @brief Array implementations of one instruction set
+ */
+typedef struct {
+    VecMathKernel kernel;
+    VecMathArrayFn exp, log, tanh, sigmoid, swish, gelu, mish, softmax;
+} VecMathKernelInfo;
+
+static const VecMathKernelInfo vec_math_kernels[] = {
+    { VEC_MATH_SCALAR, vec_math_exp_array_scalar, vec_math_log_array_scalar, vec_math_tanh_array_scalar,
+      vec_math_sigmoid_array_scalar, vec_math_swish_array_scalar, vec_math_gelu_array_scalar,
+      vec_math_mish_array_scalar, vec_math_softmax_scalar },
+#ifdef VEC_MATH_HAVE_X86
+    { VEC_MATH_AVX2, vec_math_exp_avx2, vec_math_log_avx2, vec_math_tanh_avx2, vec_math_sigmoid_avx2,
+      vec_math_swish_avx2, vec_math_gelu_avx2, vec_math_mish_avx2, vec_math_softmax_avx2 },
+    { VEC_MATH_AVX512, vec_math_exp_avx512, vec_math_log_avx512, vec_math_tanh_avx512,
+      vec_math_sigmoid_avx512, vec_math_swish_avx512, vec_math_gelu_avx512, vec_math_mish_avx512,
+      vec_math_softmax_avx512 },
+#endif
+};
+
+static const VecMathKernelInfo* vec_math_active = NULL;
+
+static bool vec_math_cpu_supports(VecMathKernel kernel) {
+    switch (kernel) {
+        case VEC_MATH_SCALAR:
+            return true;
+#ifdef VEC_MATH_HAVE_X86
+        case VEC_MATH_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case VEC_MATH_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+static const VecMathKernelInfo* vec_math_select(void) {
+    if (vec_math_active) return vec_math_active;
+
+    const VecMathKernelInfo* best = &vec_math_kernels[0];
+    for (size_t i = 0; i < sizeof(vec_math_kernels) / sizeof(vec_math_kernels[0]); i++) {
+        if (vec_math_cpu_supports(vec_math_kernels[i].kernel) && vec_math_kernels[i].kernel > best->kernel) {
+            best = &vec_math_kernels[i];
+        }
+    }
+
+    vec_math_active = best;
+    return best;
+}
+
+VecMathKernel vec_math_get_kernel(void) {
+    return vec_math_select()->kernel;
+}
+
+bool vec_math_set_kernel(VecMathKernel kernel) {
+    for (size_t i = 0; i < sizeof(vec_math_kernels) / sizeof(vec_math_kernels[0]); i++) {
+        if (vec_math_kernels[i].kernel == kernel && vec_math_cpu_supports(kernel)) {
+            vec_math_active = &vec_math_kernels[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* vec_math_kernel_name(VecMathKernel kernel) {
+    switch (kernel) {
+        case VEC_MATH_SCALAR: return "scalar";
+        case VEC_MATH_AVX2: return "avx2";
+        case VEC_MATH_AVX512: return "avx512";
+        default: return "unknown";
+    }
+}
+
+// ============================================================================
+// Array Functions
+// ============================================================================
+
+void vec_math_exp(float* x, int size) {
+    if (x && size > 0) vec_math_select()->exp(x, size);
+}
+
+void vec_math_log(float* x, int size) {
+    if (x && size > 0) vec_math_select()->log(x, size);
+}
+
+void vec_math_tanh(float* x, int size) {
+    if (x && size > 0) vec_math_select()->tanh(x, size);
+}
+
+void vec_math_sigmoid(float* x, int size) {
+    if (x && size > 0) vec_math_select()->sigmoid(x, size);
+}
+
+void vec_math_swish(float* x, int size) {
+    if (x && size > 0) vec_math_select()->swish(x, size);
+}
+
+void vec_math_gelu(float* x, int size) {
+    if (x && size > 0) vec_math_select()->gelu(x, size);
+}
+
+void vec_math_mish(float* x, int size) {
+    if (x && size > 0) vec_math_select()->mish(x, size);
+}
+
+void vec_math_softmax(float* x, int size) {
+    if (x && size > 0) vec_math_select()->softmax(x, size);
+}